@@ -128,6 +128,7 @@ LOCAL_SRC_FILES := \
 	../../../../src/compositor/visual_manager.c \
 	../../../../src/compositor/x3d_geometry.c \
 	../../../../src/crypto/g_crypt.c \
+	../../../../src/crypto/g_crypt_hw.c \
 	../../../../src/crypto/g_crypt_openssl.c \
 	../../../../src/crypto/g_crypt_tinyaes.c \
 	../../../../src/crypto/tiny_aes.c \
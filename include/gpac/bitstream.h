@@ -161,6 +161,22 @@ Reads a large integer coded on a number of bit bigger than 32.
  */
 u64 gf_bs_read_long_int(GF_BitStream *bs, u32 nBits);
 /*!
+\brief unsigned exp-Golomb reading
+
+Reads an unsigned exp-Golomb coded integer (ue(v) in ISO/IEC 14496-10 and related specifications)
+\param bs the target bitstream
+\return the integer value read, or 0 if more than 31 leading zero bits are found
+ */
+u32 gf_bs_read_ue(GF_BitStream *bs);
+/*!
+\brief signed exp-Golomb reading
+
+Reads a signed exp-Golomb coded integer (se(v) in ISO/IEC 14496-10 and related specifications)
+\param bs the target bitstream
+\return the integer value read
+ */
+s32 gf_bs_read_se(GF_BitStream *bs);
+/*!
 \brief float reading
 
 Reads a float coded as IEEE 32 bit format.
@@ -274,6 +274,78 @@ Mark the entry as "headers processed"
  */
 GF_Err gf_cache_set_headers_processed(const DownloadedCacheEntry entry);
 
+/*! cache index, hashing entries by URL and keeping them in least recently used order*/
+typedef struct __CacheIndexStruct * GF_CacheIndex;
+
+/*!
+Creates a new cache index
+\return the new index or NULL if error
+ */
+GF_CacheIndex gf_cache_index_new();
+/*!
+Destroys a cache index - entries are removed from the index but not destroyed
+\param idx the cache index
+ */
+void gf_cache_index_del(GF_CacheIndex idx);
+/*!
+Adds an entry to the index as most recently used entry
+\param idx the cache index
+\param entry the entry to add, shall not belong to an index
+\return error if any
+ */
+GF_Err gf_cache_index_add(GF_CacheIndex idx, DownloadedCacheEntry entry);
+/*!
+Removes an entry from the index
+\param idx the cache index
+\param entry the entry to remove
+\return GF_TRUE if the entry was in the index, GF_FALSE otherwise
+ */
+Bool gf_cache_index_remove(GF_CacheIndex idx, DownloadedCacheEntry entry);
+/*!
+Finds an entry in the index and marks it as most recently used. If several entries match, the oldest inserted one is returned
+\param idx the cache index
+\param url the URL to look for
+\param mcast_match if set, entries with a gmcast URL match any URL with the same path after the first component
+\param check_range if set, start and end range of the entry must match
+\param start_range start range to match
+\param end_range end range to match
+\return the entry found or NULL
+ */
+DownloadedCacheEntry gf_cache_index_find(GF_CacheIndex idx, const char *url, Bool mcast_match, Bool check_range, u64 start_range, u64 end_range);
+/*!
+Gets the number of entries in the index
+\param idx the cache index
+\return number of entries
+ */
+u32 gf_cache_index_count(GF_CacheIndex idx);
+/*!
+Gets the least recently used entry of the index
+\param idx the cache index
+\return the entry or NULL if empty
+ */
+DownloadedCacheEntry gf_cache_index_get_oldest(GF_CacheIndex idx);
+/*!
+Updates the memory and disk size accounted for an entry, to call once the entry content has changed
+\param idx the cache index
+\param entry the entry to update
+ */
+void gf_cache_index_update_size(GF_CacheIndex idx, DownloadedCacheEntry entry);
+/*!
+Gets the memory and disk size of all entries in the index
+\param idx the cache index
+\param mem_size set to the memory size of entries - may be NULL
+\param disk_size set to the disk size of entries - may be NULL
+ */
+void gf_cache_index_get_size(GF_CacheIndex idx, u64 *mem_size, u64 *disk_size);
+/*!
+Destroys least recently used entries, including their files, until memory and disk sizes are within budget. Entries in use, persistent or pushed by a producer and not yet marked as deleted are never evicted
+\param idx the cache index
+\param max_mem_size maximum memory size, 0 means no limit
+\param max_disk_size maximum disk size, 0 means no limit
+\return number of evicted entries
+ */
+u32 gf_cache_index_evict(GF_CacheIndex idx, u64 max_mem_size, u64 max_disk_size);
+
 /*! @} */
 
 #ifdef __cplusplus
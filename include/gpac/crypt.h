@@ -24,7 +24,7 @@
 */
 
 /*
-The GPAC crypto lib uses either openSSL 1.x or tiny-AES (https://github.com/kokke/tiny-AES-c) when not available
+The GPAC crypto lib uses AES CPU instructions (AES-NI, ARMv8 crypto extensions) when available, otherwise openSSL 1.x, or tiny-AES (https://github.com/kokke/tiny-AES-c) when openSSL is not available
 The crypto lib only supports AES 128 bits in CBC and CTR modes
 */
 
@@ -143,6 +143,29 @@ GF_Err gf_crypt_encrypt(GF_Crypt *gfc, void *plaintext, u32 size);
 */
 GF_Err gf_crypt_decrypt(GF_Crypt *gfc, void *ciphertext, u32 size);
 
+/*! encrypts a payload using a pattern of encrypted and clear 16-byte blocks, as used by CENC cens and cbcs schemes.
+The pattern is applied from the start of the buffer and the state (IV or counter) only progresses on encrypted blocks. If the last pattern
+has less than crypt_blocks blocks, all remaining bytes are encrypted.
+If crypt_blocks or skip_blocks is 0, this is the same as \ref gf_crypt_encrypt
+\param gfc the target crytpo context
+\param plaintext the clear buffer
+\param size the size of the clear buffer
+\param crypt_blocks number of encrypted 16-byte blocks in the pattern
+\param skip_blocks number of clear 16-byte blocks in the pattern
+\return error if any
+*/
+GF_Err gf_crypt_encrypt_pattern(GF_Crypt *gfc, void *plaintext, u32 size, u32 crypt_blocks, u32 skip_blocks);
+
+/*! decrypts a payload using a pattern of encrypted and clear 16-byte blocks, see \ref gf_crypt_encrypt_pattern
+\param gfc the target crytpo context
+\param ciphertext the encrypted buffer
+\param size the size of the encrypted buffer
+\param crypt_blocks number of encrypted 16-byte blocks in the pattern
+\param skip_blocks number of clear 16-byte blocks in the pattern
+\return error if any
+*/
+GF_Err gf_crypt_decrypt_pattern(GF_Crypt *gfc, void *ciphertext, u32 size, u32 crypt_blocks, u32 skip_blocks);
+
 
 /*! @} */
 
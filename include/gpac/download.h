@@ -564,6 +564,32 @@ Forces HTTP headers for a given cache entry
 */
 GF_Err gf_dm_force_headers(GF_DownloadManager *dm, const DownloadedCacheEntry entry, const char *headers);
 
+/*! HTTP cache statistics*/
+typedef struct
+{
+	/*! number of session requests found in cache*/
+	u64 hits;
+	/*! number of session requests not found in cache*/
+	u64 misses;
+	/*! number of entries removed because the cache exceeded its memory or disk budget*/
+	u64 evictions;
+	/*! number of entries in cache*/
+	u32 nb_entries;
+	/*! memory used by cache entries in bytes*/
+	u64 mem_size;
+	/*! size of cache files written by this download manager in bytes*/
+	u64 disk_size;
+} GF_DownloadCacheStats;
+
+/*!
+Gets statistics of the HTTP cache
+
+\param dm the download manager
+\param stats filled with cache statistics
+\return error code if any
+*/
+GF_Err gf_dm_get_cache_stats(GF_DownloadManager *dm, GF_DownloadCacheStats *stats);
+
 /*! HTTP methods*/
 enum
 {
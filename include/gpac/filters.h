@@ -200,7 +200,9 @@ typedef enum
 	/*! In this mode, the scheduler uses locks for packet and property queues even if single-threaded (test mode) */
 	GF_FS_SCHEDULER_LOCK_FORCE,
 	/*! In this mode, the scheduler uses direct dispatch and no threads, trying to nest task calls within task calls */
-	GF_FS_SCHEDULER_DIRECT
+	GF_FS_SCHEDULER_DIRECT,
+	/*! In this mode, the scheduler does not use locks for packet and property queues and each thread has its own task list. Tasks are posted to the list of the thread which last processed the filter, and idle threads steal tasks from other threads lists. Defaults to lock-free if no threads are used */
+	GF_FS_SCHEDULER_WORK_STEAL
 } GF_FilterSchedulerType;
 
 /*! Filter session flags */
@@ -4347,6 +4349,35 @@ The packet has by default no DTS, no CTS, no duration framing set to full frame
 */
 GF_FilterPacket *gf_filter_pck_new_ref(GF_FilterPid *PID, u32 data_offset, u32 data_size, GF_FilterPacket *source_packet);
 
+/*! Allocates a new segmented packet on the output PID. The data of a segmented packet is an ordered list of data ranges in other packets (usually input packets) or of bytes copied in the packet (typically small headers such as NAL unit size fields). This avoids copying these ranges in a new packet.
+
+Segments are added using \ref gf_filter_pck_append_segment and \ref gf_filter_pck_append_segment_data. The data of a segmented packet cannot be modified, expanded or truncated.
+
+Consumers can get the segments using \ref gf_filter_pck_get_segment; \ref gf_filter_pck_get_data copies the segments in a single buffer upon first call.
+
+The packet has by default no DTS, no CTS, no duration framing set to full frame (start=end=1) and all other flags set to 0 (including SAP type).
+\param PID the target output PID
+\return new packet or NULL if allocation error or not an output PID
+*/
+GF_FilterPacket *gf_filter_pck_new_segmented(GF_FilterPid *PID);
+
+/*! Appends a data range of a source packet to a segmented packet. The source packet is kept alive until the segmented packet is destroyed.
+\param pck the target segmented packet, created by \ref gf_filter_pck_new_segmented and not yet sent
+\param source_packet the source packet holding the data
+\param data_offset offset in the source data block
+\param data_size the size of the data range - if 0, the entire data of the source packet beginning at offset is used
+\return error if any
+*/
+GF_Err gf_filter_pck_append_segment(GF_FilterPacket *pck, GF_FilterPacket *source_packet, u32 data_offset, u32 data_size);
+
+/*! Appends bytes to a segmented packet. The bytes are copied in the packet.
+\param pck the target segmented packet, created by \ref gf_filter_pck_new_segmented and not yet sent
+\param data the bytes to append
+\param data_size the number of bytes to append
+\return error if any
+*/
+GF_Err gf_filter_pck_append_segment_data(GF_FilterPacket *pck, const u8 *data, u32 data_size);
+
 /*! Same as  \ref gf_filter_pck_new_ref with packet destructor callbacl
 
 \param PID the target output PID
@@ -4453,6 +4484,26 @@ GF_Err gf_filter_pck_forward(GF_FilterPacket *reference, GF_FilterPid *PID);
 */
 const u8 *gf_filter_pck_get_data(GF_FilterPacket *pck, u32 *size);
 
+/*! Gets the data size of the packet, without copying segments of segmented packets
+\param pck the target packet
+\return data size in bytes
+*/
+u32 gf_filter_pck_get_data_size(GF_FilterPacket *pck);
+
+/*! Gets the number of data segments of the packet, see \ref gf_filter_pck_new_segmented.
+\param pck the target packet
+\return number of segments, 1 for non-segmented packets, 0 if the packet has no data
+*/
+u32 gf_filter_pck_get_segment_count(GF_FilterPacket *pck);
+
+/*! Gets a data segment of the packet, without copying segments of segmented packets. For non-segmented packets, segment 0 is the packet data.
+\param pck the target packet
+\param idx 0-based index of the segment
+\param size set to the segment size
+\return segment data, NULL if no such segment
+*/
+const u8 *gf_filter_pck_get_segment(GF_FilterPacket *pck, u32 idx, u32 *size);
+
 /*! Sets a built-in property of a packet
 \param pck the target packet
 \param prop_4cc the code of the built-in property to set
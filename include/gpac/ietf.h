@@ -854,6 +854,19 @@ void gf_rtp_reset_ssrc(GF_RTPChannel *ch);
 */
 u32 gf_rtp_read_rtp(GF_RTPChannel *ch, u8 *buffer, u32 buffer_size);
 
+/*! sets RTP packet batched reception. When enabled, \ref gf_rtp_read_rtp fetches all pending datagrams in a single system call and returns them one by one, using kernel reception time for jitter computation when available
+\param ch the target RTP channel
+\param nb_packets maximum number of packets to fetch at once, 0 or 1 disables batching
+\return error if any
+*/
+GF_Err gf_rtp_set_recv_batch(GF_RTPChannel *ch, u32 nb_packets);
+
+/*! gets the number of RTP packets already received and not yet returned by \ref gf_rtp_read_rtp
+\param ch the target RTP channel
+\return number of pending packets
+*/
+u32 gf_rtp_read_pending(GF_RTPChannel *ch);
+
 /*! flushes any pending data in packet reorderer, but does not flush packet reorderer if reorderer timeout is not exceeded
 \param ch the target RTP channel
 \param buffer the buffer where to store the data
@@ -908,6 +921,15 @@ this function at regular times
 */
 GF_Err gf_rtp_send_rtcp_report(GF_RTPChannel *ch);
 
+/*! forces sending a Sender Report mapping an RTP timestamp to an NTP time, regardless of the report interval. This is typically used before the first packet of a channel is sent
+\param ch the target RTP channel
+\param rtp_ts the RTP timestamp at the given NTP time
+\param ntp_sec the NTP seconds of the report
+\param ntp_frac the NTP fraction of the report
+\return error if any
+*/
+GF_Err gf_rtp_send_rtcp_sr(GF_RTPChannel *ch, u32 rtp_ts, u32 ntp_sec, u32 ntp_frac);
+
 /*! forces loss rate for next Receiver report
 \param ch the target RTP channel
 \param loss_rate loss rate in per-thousand
@@ -931,6 +953,19 @@ GF_Err gf_rtp_send_bye(GF_RTPChannel *ch);
 */
 GF_Err gf_rtp_send_packet(GF_RTPChannel *ch, GF_RTPHeader *rtp_hdr, u8 *pck, u32 pck_size, Bool fast_send);
 
+/*! sets RTP packet batching. When enabled, packets sent through \ref gf_rtp_send_packet are queued and sent in a single system call once the batch is full or when \ref gf_rtp_flush_send_batch is called. Batching is ignored for interleaved (RTSP over TCP) channels
+\param ch the target RTP channel
+\param nb_packets maximum number of packets to queue, 0 or 1 disables batching
+\return error if any
+*/
+GF_Err gf_rtp_set_send_batch(GF_RTPChannel *ch, u32 nb_packets);
+
+/*! sends all RTP packets pending in the batch
+\param ch the target RTP channel
+\return error if any
+*/
+GF_Err gf_rtp_flush_send_batch(GF_RTPChannel *ch);
+
 
 /*! callback used for writing rtp over TCP
 \param cbk1 opaque user data
@@ -1216,6 +1216,19 @@ void gf_mixer_remove_input(GF_AudioMixer *am, GF_AudioInterface *src);
 void gf_mixer_lock(GF_AudioMixer *am, Bool lockIt);
 void gf_mixer_set_max_speed(GF_AudioMixer *am, Double max_speed);
 
+/*resampling modes of the mixer*/
+enum
+{
+	/*linear interpolation between input samples*/
+	GF_MIXER_RESAMPLE_LINEAR = 0,
+	/*windowed-sinc polyphase filters, 16, 32 or 64 taps at unity ratio (more when downsampling)*/
+	GF_MIXER_RESAMPLE_LOW,
+	GF_MIXER_RESAMPLE_MEDIUM,
+	GF_MIXER_RESAMPLE_HIGH,
+};
+/*sets resampling mode of the mixer, GF_MIXER_RESAMPLE_MEDIUM by default - if max_latency_ms is not 0, polyphase filters are shortened so that their delay does not exceed this value*/
+void gf_mixer_set_resampler(GF_AudioMixer *am, u32 mode, u32 max_latency_ms);
+
 /*mix inputs in buffer, return number of bytes written to output*/
 u32 gf_mixer_get_output(GF_AudioMixer *am, void *buffer, u32 buffer_size, u32 delay_ms);
 /*reconfig all sources if needed - returns TRUE if main audio config changed
@@ -38,7 +38,7 @@ struct _gf_crypt_context
 	GF_CRYPTO_ALGO algo; //single value for now
 	GF_CRYPTO_MODE mode; //CBC or CTR
 
-	/* Internal context for openSSL or tiny AES*/
+	/* Internal context for hardware AES, openSSL or tiny AES*/
 	void *context;
 
 	//ptr to encryption function
@@ -52,6 +52,8 @@ struct _gf_crypt_context
 	GF_Err(*_get_state) (GF_Crypt*, u8 *IV, u32 *IV_size);
 };
 
+//returns GF_NOT_SUPPORTED if AES instructions are not available
+GF_Err gf_crypt_open_open_hw(GF_Crypt* td, GF_CRYPTO_MODE mode);
 #ifdef GPAC_HAS_SSL
 GF_Err gf_crypt_open_open_openssl(GF_Crypt* td, GF_CRYPTO_MODE mode);
 #else
@@ -140,6 +140,18 @@ struct __tag_rtp_channel
 	/*static buffer for RTP sending*/
 	u8 *send_buffer;
 	u32 send_buffer_size;
+	/*batched RTP sending, packets are formatted in consecutive slots of batch_slot_size bytes*/
+	u8 *batch_buf;
+	const u8 **batch_ptrs;
+	u32 *batch_sizes;
+	u32 batch_max, nb_batch, batch_slot_size;
+	/*batched RTP reception, datagrams are received in consecutive slots of GF_SK_BATCH_SLOT_SIZE bytes*/
+	u8 *rx_buf;
+	u32 *rx_sizes;
+	u64 *rx_ntps;
+	u32 rx_max, rx_nb, rx_idx;
+	/*kernel reception time (NTP) of the last packet read, 0 if unknown*/
+	u64 rx_ntp;
 	u32 pck_sent_since_last_sr;
 	u32 last_pck_ts;
 	u32 last_pck_ntp_sec, last_pck_ntp_frac;
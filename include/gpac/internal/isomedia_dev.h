@@ -1158,6 +1158,26 @@ typedef struct
 	char *nameURN;
 } GF_DataEntryURNBox;
 
+/*sparse index of a run-length sample table, one checkpoint every GF_ISOM_STBL_INDEX_STRIDE entries
+checkpoint N describes the state of the table at entry N*GF_ISOM_STBL_INDEX_STRIDE*/
+typedef struct
+{
+	/*first sample number in checkpoint entries*/
+	u32 *samples;
+	/*decoding time of checkpoint entries, for stts only*/
+	u64 *times;
+	u32 nb_points, alloc_points;
+	/*only set when the table can only be appended to (read mode)*/
+	Bool enabled;
+} GF_SampleTableIndex;
+
+#define GF_ISOM_STBL_INDEX_STRIDE	32
+/*tables with less entries are always scanned linearly*/
+#define GF_ISOM_STBL_INDEX_MIN_ENTRIES	256
+
+void stbl_index_reset(GF_SampleTableIndex *idx);
+void stbl_index_del(GF_SampleTableIndex *idx);
+
 typedef struct
 {
 	u32 sampleCount;
@@ -1181,6 +1201,7 @@ typedef struct
 	u64 r_CurrentDTS;
 	//when removing samples, this is the DTS of first sample after all removed samples
 	u64 cumulated_start_dts;
+	GF_SampleTableIndex r_index;
 
 	//stats for read
 	u32 max_ts_delta;
@@ -1208,6 +1229,7 @@ typedef struct
 	/*Cache for read*/
 	u32 r_currentEntryIndex;
 	u32 r_FirstSampleInEntry;
+	GF_SampleTableIndex r_index;
 
 	s32 max_cts_delta;
 	s32 min_neg_cts_offset;
@@ -1620,6 +1642,7 @@ static const u8 GF_ISOM_IPOD_EXT[][16] = { { 0x6B, 0x68, 0x40, 0xF2, 0x5F, 0x24,
 
 Bool gf_isom_is_nalu_based_entry(GF_MediaBox *mdia, GF_SampleEntryBox *_entry);
 GF_Err gf_isom_nalu_sample_rewrite(GF_MediaBox *mdia, GF_ISOSample *sample, u32 sampleNumber, GF_MPEGVisualSampleEntryBox *entry);
+Bool gf_isom_nalu_sample_rewrite_needed(GF_MediaBox *mdia, GF_MPEGVisualSampleEntryBox *entry);
 
 typedef struct __full_video_sample_entry GF_GenericVisualSampleEntryBox;
 
@@ -1955,6 +1978,7 @@ typedef struct
 	u32 firstSampleInCurrentChunk;
 	u32 currentChunk;
 	u32 ghostNumber;
+	GF_SampleTableIndex r_index;
 
 	u32 w_lastSampleNumber;
 	u32 w_lastChunkNumber;
@@ -3223,6 +3247,15 @@ typedef struct __sidx_box
 	s32 compressed_diff;
 } GF_SegmentIndexBox;
 
+/*byte range of one or more movie fragments, used for lazy loading*/
+typedef struct
+{
+	/*start and end (exclusive) offset of the range*/
+	u64 start, end;
+	/*decode time in seconds of the first fragment, -1 if not known yet, -2 if it cannot be determined*/
+	Double time;
+} GF_ISOFragmentRange;
+
 GF_Err gf_isom_set_fragment_template(GF_ISOFile *movie, u8 *tpl_data, u32 tpl_size, Bool *has_tfdt, GF_SegmentIndexBox **out_sidx);
 
 typedef struct
@@ -4037,7 +4070,9 @@ enum
 	u8 use_blob;		\
 	GF_BitStream *bs;\
 	u64 last_read_offset;\
-	char *szName;
+	char *szName;\
+	u8 *sample_map;\
+	u64 sample_map_size;
 
 typedef struct __tag_data_map
 {
@@ -4235,6 +4270,15 @@ struct __tag_isom {
 	u64 main_sidx_end_pos;
 
 	Bool has_pssh_moof;
+
+	/*lazy fragment loading: 1 until the first moof is found, 2 once fragments are indexed*/
+	u32 lazy_frags;
+	GF_ISOFragmentRange *frag_ranges;
+	u32 nb_frag_ranges, alloc_frag_ranges, next_frag_range;
+	/*end of the fragment range being loaded, 0 if none*/
+	u64 lazy_parse_end;
+	/*duration in seconds as indicated by the fragment index, 0 if unknown*/
+	Double lazy_duration;
 #endif
 	GF_ProducerReferenceTimeBox *last_producer_ref_time;
 
@@ -4270,6 +4314,10 @@ u64 gf_isom_get_mp4time();
 /*set the last error of the file. if file is NULL, set the static error (used for IO errors*/
 void gf_isom_set_last_error(GF_ISOFile *the_file, GF_Err error);
 GF_Err gf_isom_parse_movie_boxes(GF_ISOFile *mov, u32 *boxType, u64 *bytesMissing, Bool progressive_mode);
+#ifndef GPAC_DISABLE_ISOM_FRAGMENTS
+/*builds the fragment index in lazy mode, starting from the first moof at mov->current_top_box_start*/
+GF_Err gf_isom_lazy_index_fragments(GF_ISOFile *mov);
+#endif
 GF_ISOFile *gf_isom_new_movie();
 /*Movie and Track access functions*/
 GF_TrackBox *gf_isom_get_track_from_file(GF_ISOFile *the_file, u32 trackNumber);
@@ -51,8 +51,6 @@ typedef struct
 	Bool full_range;
 } COLR;
 
-u32 gf_bs_read_ue(GF_BitStream *bs);
-s32 gf_bs_read_se(GF_BitStream *bs);
 void gf_bs_write_ue(GF_BitStream *bs, u32 num);
 void gf_bs_write_se(GF_BitStream *bs, s32 num);
 
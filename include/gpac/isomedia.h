@@ -4206,6 +4206,37 @@ GF_Err gf_isom_get_file_offset_for_time(GF_ISOFile *isom_file, Double start_time
 */
 GF_Err gf_isom_get_sidx_duration(GF_ISOFile *isom_file, u64 *sidx_dur, u32 *sidx_timescale);
 
+/*! opens a local fragmented file in lazy mode. Only the boxes before the first movie fragment are parsed, and the byte ranges of the movie fragments are indexed using the segment index (sidx), the movie fragment random access box (mfra) or a scan of top-level box headers.
+The first fragment range is then loaded; following ranges are only loaded through \ref gf_isom_lazy_load_next and \ref gf_isom_lazy_seek.
+A file with no movie fragment is fully loaded as with \ref gf_isom_open_progressive.
+\param fileName the name of the local file to open, gmem:// or gfio://
+\param isom_file pointer set to the opened file if success
+\return error if any
+*/
+GF_Err gf_isom_open_lazy(const char *fileName, GF_ISOFile **isom_file);
+
+/*! gets the fragment loading state of a file opened with \ref gf_isom_open_lazy
+\param isom_file the target ISO file
+\param next_range set to the 0-based index of the next fragment range to load - may be NULL
+\param next_time set to the decode time in seconds of the next fragment range to load, or -1 if unknown - may be NULL
+\param duration set to the duration in seconds indicated by the fragment index, 0 if unknown - may be NULL
+\return the number of fragment ranges indexed, 0 if the file is not loaded in lazy mode
+*/
+u32 gf_isom_get_lazy_fragments(GF_ISOFile *isom_file, u32 *next_range, Double *next_time, Double *duration);
+
+/*! loads the next fragment range of a file opened with \ref gf_isom_open_lazy, appending its samples to the sample tables
+\param isom_file the target ISO file
+\return GF_EOS if all fragment ranges are loaded, error if any
+*/
+GF_Err gf_isom_lazy_load_next(GF_ISOFile *isom_file);
+
+/*! resets sample tables of a file opened with \ref gf_isom_open_lazy and loads the fragment range containing the given time. If the decode time of fragments cannot be determined (no tfdt), loading restarts from the first fragment range
+\param isom_file the target ISO file
+\param start_time the target decode time in seconds
+\return error if any
+*/
+GF_Err gf_isom_lazy_seek(GF_ISOFile *isom_file, Double start_time);
+
 
 /*! refreshes a fragmented file
 A file being downloaded may be a fragmented file. In this case only partial info
@@ -142,11 +142,16 @@ typedef struct
 	u32 repeat_count;
 } GF_MPD_SegmentTimelineEntry;
 
+/*! rendered text cache for manifest generation, internal to GPAC*/
+typedef struct __gf_mpd_print_cache GF_MPD_PrintCache;
+
 /*! Segment Timeline*/
 typedef struct
 {
 	/*! list of entries*/
 	GF_List *entries;
+	/*! internal, rendered S elements cache*/
+	GF_MPD_PrintCache *print_cache;
 } GF_MPD_SegmentTimeline;
 
 /*! Byte range info*/
@@ -652,8 +657,10 @@ typedef struct {
 	const char *m3u8_name;
 	/*! generated m3u8 name if no user-assigned one*/
 	char *m3u8_var_name;
-	/*! temp file for m3u8 generation*/
+	/*! memory file for m3u8 generation*/
 	FILE *m3u8_var_file;
+	/*! internal, rendered m3u8 segment entries cache*/
+	GF_MPD_PrintCache *m3u8_cache;
 
 	/*! for m3u8: 0: not encrypted, 1: full segment, 2: CENC*/
 	u8 crypto_type;
@@ -1856,8 +1856,6 @@ struct __m2ts_mux {
 	/*! state for forced injection of PAT/PMT/PCR*/
 	u32 force_pat_pmt_state;
 
-	/*! static write bitstream object for formatting packets*/
-	GF_BitStream *pck_bs;
 	/*! PID to watch for SAP insertions*/
 	u32 ref_pid;
 	/* if the packet output starts (first PES) with the first packet of a SAP AU (used when dashing), set to TRUE*/
@@ -1971,6 +1969,18 @@ typedef enum
 \return packet produced or NULL if error or idle
 */
 const u8 *gf_m2ts_mux_process(GF_M2TS_Mux *muxer, GF_M2TSMuxState *status, u32 *usec_till_next);
+/*! produces several consecutive packets of the multiplex in a caller-provided buffer
+
+The batch stops early when the multiplexer has nothing to send, after a padding packet, at end of stream, and after a packet carrying a SAP or starting a new PES on the reference PID, so that the sap_inserted and last_pts fields of the multiplexer describe the last packet of the batch.
+\param muxer the target MPEG-2 TS multiplexer
+\param dst destination buffer, at least 188*max_pck bytes
+\param max_pck maximum number of packets to produce
+\param max_dur_us maximum multiplex duration of the batch in microseconds, 0 for no limit
+\param status set to the state of the multiplexer after the last packet
+\param usec_till_next set to the time to wait before the next packet can be produced (real-time mux only)
+\return number of packets written to dst
+*/
+u32 gf_m2ts_mux_process_batch(GF_M2TS_Mux *muxer, u8 *dst, u32 max_pck, u32 max_dur_us, GF_M2TSMuxState *status, u32 *usec_till_next);
 /*! gets the system clock of the multiplexer (time elapsed since start)
 \param muxer the target MPEG-2 TS multiplexer
 \return system clock of the multiplexer in milliseconds
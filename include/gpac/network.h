@@ -503,6 +503,42 @@ Sends a buffer on the socket. The socket must be in a bound or connected mode. T
  */
 GF_Err gf_sk_send_ex(GF_Socket *sock, const u8 *buffer, u32 length, u32 *written);
 
+/*!
+\brief zero-copy file emission
+
+Sends a file range on a connected TCP socket without copying file data to user space (Linux sendfile). Data is read from the file descriptor at the given offset, the position of the stdio file handle is not modified.
+\param sock the socket object
+\param file the file to send from - gfio-wrapped files are not supported
+\param offset the offset in the file of the first byte to send
+\param length the number of bytes to send
+\param written set to number of written bytes - may be NULL
+\return error if any, GF_NOT_SUPPORTED if zero-copy is not available for this socket or file, GF_IP_NETWORK_EMPTY if the socket would block
+ */
+GF_Err gf_sk_send_file(GF_Socket *sock, FILE *file, u64 offset, u32 length, u32 *written);
+
+/*!
+\brief batched datagram emission
+
+Sends a set of datagrams on a UDP socket using as few system calls as possible (sendmmsg, and UDP segmentation offload for consecutive datagrams of the same size contiguous in memory). For other socket types or if not supported by the system, datagrams are sent one by one.
+\param sock the socket object
+\param buffers the datagram buffers to send
+\param sizes the size of each datagram
+\param nb_buffers the number of datagrams to send
+\param nb_sent set to number of datagrams sent - may be NULL
+\return error if any
+ */
+GF_Err gf_sk_send_batch(GF_Socket *sock, const u8 **buffers, const u32 *sizes, u32 nb_buffers, u32 *nb_sent);
+
+/*!
+\brief kernel pacing rate
+
+Sets the maximum rate at which the kernel will emit data on the socket (SO_MAX_PACING_RATE). Pacing of UDP sockets requires the fq queuing discipline on the output interface.
+\param sock the socket object
+\param rate pacing rate in bits per second, 0 disables pacing
+\return error if any, GF_NOT_SUPPORTED if not supported by the system
+ */
+GF_Err gf_sk_set_pacing_rate(GF_Socket *sock, u64 rate);
+
 
 /*!
 \brief data reception
@@ -653,6 +689,20 @@ Sets the socket wait time in microseconds. Default wait time is 500 microseconds
  */
 void gf_sk_set_usec_wait(GF_Socket *sock, u32 usec_wait);
 
+/*!
+Sets the user data of a socket, for example to find the object owning a socket returned by \ref gf_sk_group_enum_ready
+\param sock the socket object
+\param udta user data
+ */
+void gf_sk_set_udta(GF_Socket *sock, void *udta);
+
+/*!
+Gets the user data of a socket
+\param sock the socket object
+\return user data, NULL if none
+ */
+void *gf_sk_get_udta(GF_Socket *sock);
+
 /*!
 Fetches data on a socket without performing any select (wait), to be used with socket group on sockets that are set in the selected socket group
 \param sock the socket object
@@ -663,6 +713,24 @@ Fetches data on a socket without performing any select (wait), to be used with s
  */
 GF_Err gf_sk_receive_no_select(GF_Socket *sock, u8 *buffer, u32 length, u32 *read);
 
+/*! datagram slot size used by network inputs when receiving datagrams in batch, large enough for jumbo frames*/
+#define GF_SK_BATCH_SLOT_SIZE	9216
+
+/*!
+\brief batched datagram reception
+
+Fetches all datagrams pending on a UDP socket, up to a maximum number, in as few system calls as possible (recvmmsg) and without performing any select (wait). Datagrams are written in consecutive slots of fixed size in the reception buffer, datagrams larger than the slot size are truncated. For other socket types or if not supported by the system, datagrams are received one by one.
+\param sock the socket object
+\param buffer the reception buffer, of at least slot_size*nb_slots bytes
+\param slot_size the size of each datagram slot in the reception buffer
+\param nb_slots the maximum number of datagrams to receive
+\param sizes set to the size of each received datagram, must hold nb_slots values
+\param timestamps set to the reception time of each datagram as a 64 bit NTP timestamp, taken by the kernel when supported - may be NULL, otherwise must hold nb_slots values
+\param nb_read set to the number of received datagrams
+\return error if any, GF_IP_NETWORK_EMPTY if nothing to read
+ */
+GF_Err gf_sk_receive_batch(GF_Socket *sock, u8 *buffer, u32 slot_size, u32 nb_slots, u32 *sizes, u64 *timestamps, u32 *nb_read);
+
 /*!
 Checks if connection has been closed by remote peer
 \param sock the socket object
@@ -739,6 +807,23 @@ Checks if given socket is selected and can be read. This shall be called after g
  */
 Bool gf_sk_group_sock_is_set(GF_SockGroup *sg, GF_Socket *sk, GF_SockSelectMode mode);
 
+/*!
+Enumerates sockets ready after the last call to gf_sk_group_select. When epoll is used, only sockets signaled as ready are browsed, otherwise all sockets of the group are checked
+\param sg socket group object
+\param idx index of the enumeration, shall be set to 0 before the first call
+\param mode the operation mode desired
+\return the next ready socket, or NULL if no more sockets
+ */
+GF_Socket *gf_sk_group_enum_ready(GF_SockGroup *sg, u32 *idx, GF_SockSelectMode mode);
+
+/*!
+Signals if the owner of a socket has output pending. When epoll is used, a socket without pending output is not polled for write, so that idle writable sockets do not wake up \ref gf_sk_group_select. Sockets are polled for write by default when registered. Ignored with poll or select.
+\param sg socket group object
+\param sk socket object registered with the group
+\param write_pending if GF_FALSE, the socket is no longer reported as ready to write
+ */
+void gf_sk_group_set_write_pending(GF_SockGroup *sg, GF_Socket *sk, Bool write_pending);
+
 /*! @} */
 #endif //GPAC_DISABLE_NETWORK
 
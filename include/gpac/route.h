@@ -235,6 +235,13 @@ GF_Err gf_route_set_reorder(GF_ROUTEDmx *routedmx, Bool reorder_needed, u32 time
  */
 GF_Err gf_route_set_allow_progressive_dispatch(GF_ROUTEDmx *routedmx, Bool allow_progressive);
 
+/*! Sets batched reception. When enabled, all datagrams pending on a socket are fetched in a single system call and processed in one go
+\param routedmx the ROUTE demultiplexer
+\param nb_packets maximum number of datagrams to fetch at once, 0 or 1 disables batching
+\return error code if any
+ */
+GF_Err gf_route_set_recv_batch(GF_ROUTEDmx *routedmx, u32 nb_packets);
+
 /*! Sets the service ID to tune into for ATSC 3.0
 \param routedmx the ROUTE demultiplexer
 \param service_id ID of the service to tune in. 0 means no service, 0xFFFFFFFF means all services and 0xFFFFFFFE means first service found
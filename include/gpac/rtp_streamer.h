@@ -261,6 +261,19 @@ char *gf_rtp_streamer_format_sdp_header(char *app_name, char *ip_dest, char *ses
 */
 void gf_rtp_streamer_disable_auto_rtcp(GF_RTPStreamer *streamer);
 
+/*! sets RTP packet batching, see \ref gf_rtp_set_send_batch
+\param streamer the target RTP streamer
+\param nb_packets maximum number of packets to queue, 0 or 1 disables batching
+\return error if any
+*/
+GF_Err gf_rtp_streamer_set_send_batch(GF_RTPStreamer *streamer, u32 nb_packets);
+
+/*! sends all RTP packets pending in the batch
+\param streamer the target RTP streamer
+\return error if any
+*/
+GF_Err gf_rtp_streamer_flush(GF_RTPStreamer *streamer);
+
 /*! sends RTCP bye packet
 \param streamer the target RTP streamer
 \return error if any
@@ -308,6 +321,32 @@ u16 gf_rtp_streamer_get_next_rtp_sn(GF_RTPStreamer *streamer);
 */
 GF_Err gf_rtp_streamer_set_interleave_callbacks(GF_RTPStreamer *streamer, GF_Err (*RTP_TCPCallback)(void *cbk1, void *cbk2, Bool is_rtcp, u8 *pck, u32 pck_size), void *cbk1, void *cbk2);
 
+/*! callback function for RTP packets produced by the streamer
+\param udta user data passed to \ref gf_rtp_streamer_set_packet_callback
+\param hdr RTP header of the packet, or NULL when the streamer is flushed at the end of an access unit
+\param payload RTP payload of the packet. The 12 bytes before the payload are available for writing the RTP header (fast send mode of \ref gf_rtp_send_packet)
+\param payload_size size of the payload in bytes
+\return GF_TRUE if the packet shall not be sent on the streamer channel, GF_FALSE otherwise
+*/
+typedef Bool (*gf_rtp_packet_callback)(void *udta, GF_RTPHeader *hdr, u8 *payload, u32 payload_size);
+
+/*! sets the callback function called for each RTP packet before it is sent on the streamer channel, typically used to forward packets to other RTP channels
+\param streamer the target RTP streamer
+\param on_packet the callback function, NULL to disable
+\param udta opaque data passed to callback function
+*/
+void gf_rtp_streamer_set_packet_callback(GF_RTPStreamer *streamer, gf_rtp_packet_callback on_packet, void *udta);
+
+/*! creates a new RTP channel for RTSP setup, using the same clock rate as the streamer channel
+\param streamer the target RTP streamer
+\param path_mtu MTU path size in bytes
+\param tr the RTSP transport description
+\param ifce_addr IP address of network interface to use
+\param e set to error if any, may be NULL
+\return the new channel, to destroy with \ref gf_rtp_del, or NULL if error
+*/
+GF_RTPChannel *gf_rtp_streamer_new_channel(GF_RTPStreamer *streamer, u32 path_mtu, GF_RTSPTransport *tr, const char *ifce_addr, GF_Err *e);
+
 
 /*! callback function for procesing RTCP  receiver reports
 \param cbk user data passed to \ref  gf_rtp_streamer_read_rtcp
@@ -277,6 +277,40 @@ Sets the thread execution priority level.
 \note this should be used with caution, especially use of real-time priorities.
  */
 void gf_th_set_priority(GF_Thread *th, s32 priority);
+
+/*!
+\brief thread CPU affinity
+
+Restricts execution of a thread to a set of CPUs.
+\param th the thread object, or NULL for the calling thread
+\param cpus list of CPU indexes the thread may run on
+\param nb_cpus number of CPU indexes in the list
+\return error if any, GF_NOT_SUPPORTED if the platform does not support thread affinity
+ */
+GF_Err gf_th_set_affinity(GF_Thread *th, const u32 *cpus, u32 nb_cpus);
+
+/*!
+\brief NUMA node CPUs query
+
+Gets the list of CPUs attached to a NUMA node.
+\param node_idx index of the NUMA node
+\param cpus list of CPU indexes to fill, may be NULL
+\param max_cpus maximum number of CPU indexes in the list
+\return number of CPUs in the node, 0 if the node does not exist or if NUMA information is not available
+ */
+u32 gf_th_get_numa_cpus(u32 node_idx, u32 *cpus, u32 max_cpus);
+
+/*!
+\brief CPU list parsing
+
+Parses a comma-separated list of CPU indexes or ranges, e.g. "0-3,8,10-11". Ranges are clamped to the number of cores of the system, and ranges with a last index lower than the first one are ignored.
+\param list the CPU list to parse
+\param cpus list of CPU indexes to fill, may be NULL
+\param max_cpus maximum number of CPU indexes in the list
+\return number of CPUs in the parsed list, which may be greater than max_cpus
+ */
+u32 gf_th_parse_cpu_list(const char *list, u32 *cpus, u32 max_cpus);
+
 /*!
 \brief current thread ID
 
@@ -432,6 +466,9 @@ typedef void * GF_Thread;
 #define gf_th_stop(_th)
 #define gf_th_status(_th) GF_THREAD_STATUS_DEAD
 #define gf_th_set_priority(_th, _priority)
+#define gf_th_set_affinity(_th, _cpus, _nb_cpus) GF_NOT_SUPPORTED
+#define gf_th_get_numa_cpus(_node, _cpus, _max) 0
+#define gf_th_parse_cpu_list(_list, _cpus, _max) 0
 #define gf_th_id() 0
 
 #ifdef GPAC_CONFIG_ANDROID
@@ -1471,6 +1471,25 @@ Reads a local file into memory, in binary open mode.
  */
 GF_Err gf_file_load_data_filep(FILE *file, u8 **out_data, u32 *out_size);
 
+/*!
+\brief maps a file into memory
+
+Maps a local file into memory using a read-only mapping: the returned memory shall not be modified, writing to it will crash. Wrapped IOs (gfio:// and gmem://) and empty files cannot be mapped.
+\param file_name path on disk of the file to map
+\param out_size set to the size of the mapping
+\return mapped address, or NULL if error or not supported on this platform
+ */
+u8 *gf_file_mmap(const char *file_name, u64 *out_size);
+
+/*!
+\brief unmaps a file
+
+Unmaps a file mapped through \ref gf_file_mmap
+\param data mapped address
+\param size size of the mapping
+ */
+void gf_file_munmap(u8 *data, u64 size);
+
 /*!
 \brief Delete Directory
 
@@ -1634,6 +1653,155 @@ Gets the file size given a FILE object. The FILE object position will be reset t
 */
 u64 gf_fsize(FILE *fp);
 
+/*!
+\brief file system block size
+
+Gets the allocation block size of the file system holding a native file
+\param fp FILE object to check
+\return block size in bytes, or 0 if unknown or if the FILE object is a GF_FileIO wrapper
+*/
+u32 gf_file_block_size(FILE *fp);
+
+/*!
+\brief file range insertion
+
+Inserts a range of zero bytes in a native file without moving data through memory, all data after the insertion point being shifted. This is currently only supported on Linux for file systems supporting FALLOC_FL_INSERT_RANGE (ext4, XFS)
+\param fp FILE object to modify
+\param offset insertion point, must be a multiple of the file system block size
+\param size number of bytes to insert, must be a multiple of the file system block size
+\return error if any, GF_NOT_SUPPORTED if range insertion is not supported for this file
+*/
+GF_Err gf_file_insert_range(FILE *fp, u64 offset, u64 size);
+
+/*!
+\brief file range copy
+
+Copies a byte range within a native file without moving data through user memory, using reflinks or server-side copy when the file system supports them. The source and destination ranges may overlap. This is currently only supported on Linux (copy_file_range)
+\param fp FILE object to modify
+\param src_offset offset of the range to copy
+\param dst_offset offset of the destination range
+\param size size of the range to copy
+\return error if any, GF_NOT_SUPPORTED if nothing was copied because the platform or file system cannot copy ranges
+*/
+GF_Err gf_file_copy_range(FILE *fp, u64 src_offset, u64 dst_offset, u64 size);
+
+#ifdef GPAC_HAS_FD
+/*!
+\brief file descriptor range copy
+
+Same as \ref gf_file_copy_range for a native file descriptor
+\param fd file descriptor to modify
+\param src_offset offset of the range to copy
+\param dst_offset offset of the destination range
+\param size size of the range to copy
+\return error if any, GF_NOT_SUPPORTED if nothing was copied because the platform or file system cannot copy ranges
+*/
+GF_Err gf_fd_copy_range(int fd, u64 src_offset, u64 dst_offset, u64 size);
+#endif
+
+/*! asynchronous file I/O engine*/
+typedef struct __gf_file_aio GF_FileAIO;
+
+/*!
+\brief asynchronous file I/O engine constructor
+
+Creates an engine running read, write, data sync and close operations on file descriptors in the background. Operations are run through io_uring on Linux when available, or by a dedicated I/O thread otherwise. Completions are collected by the caller using \ref gf_file_aio_get_done, so that completion handling always happens on the caller thread.
+
+Reads and writes complete either when the full range has been processed or when an error or end of file occurs. Data sync and close operations only start once all previously submitted operations on the engine are done.
+
+An operation slot is only released when its completion is collected: submitting more than queue_depth operations without collecting completions fails with GF_BUFFER_TOO_SMALL.
+\param queue_depth maximum number of pending operations
+\param force_thread if GF_TRUE, io_uring is not used
+\return new engine, or NULL if file descriptors are not supported on this platform
+*/
+GF_FileAIO *gf_file_aio_new(u32 queue_depth, Bool force_thread);
+
+/*!
+\brief asynchronous file I/O engine destructor
+
+Waits for all pending operations and destroys the engine
+\param aio the target engine
+*/
+void gf_file_aio_del(GF_FileAIO *aio);
+
+/*!
+\brief asynchronous file I/O backend name
+
+\param aio the target engine
+\return name of the backend used, "io_uring", "thread" or "sync" (operations performed at submission time when threads are disabled)
+*/
+const char *gf_file_aio_backend(GF_FileAIO *aio);
+
+/*!
+\brief asynchronous write
+
+Submits a write operation. The buffer must stay valid until the operation completes.
+\param aio the target engine
+\param fd file descriptor to write to
+\param buf data to write
+\param size size of data to write
+\param offset file offset to write at
+\param udta user data passed back at completion
+\return error if any, GF_BUFFER_TOO_SMALL if the queue is full
+*/
+GF_Err gf_file_aio_write(GF_FileAIO *aio, s32 fd, const u8 *buf, u32 size, u64 offset, void *udta);
+
+/*!
+\brief asynchronous read
+
+Submits a read operation. The buffer must stay valid until the operation completes.
+\param aio the target engine
+\param fd file descriptor to read from
+\param buf buffer to read into
+\param size number of bytes to read
+\param offset file offset to read at
+\param udta user data passed back at completion
+\return error if any, GF_BUFFER_TOO_SMALL if the queue is full
+*/
+GF_Err gf_file_aio_read(GF_FileAIO *aio, s32 fd, u8 *buf, u32 size, u64 offset, void *udta);
+
+/*!
+\brief asynchronous data sync
+
+Submits a data sync (fdatasync) of a file descriptor, run once all previously submitted operations are done
+\param aio the target engine
+\param fd file descriptor to sync
+\param udta user data passed back at completion
+\return error if any
+*/
+GF_Err gf_file_aio_sync(GF_FileAIO *aio, s32 fd, void *udta);
+
+/*!
+\brief asynchronous close
+
+Submits the closing of a file descriptor, run once all previously submitted operations are done. The descriptor shall not be used by the caller after this call.
+\param aio the target engine
+\param fd file descriptor to close
+\param udta user data passed back at completion
+\return error if any
+*/
+GF_Err gf_file_aio_close(GF_FileAIO *aio, s32 fd, void *udta);
+
+/*!
+\brief asynchronous operation completion
+
+Gets the next completed operation
+\param aio the target engine
+\param wait if GF_TRUE and operations are pending, waits for the next completion
+\param udta set to the user data of the completed operation
+\param res set to the number of bytes read or written (0 for sync and close), or to a negated errno value on error
+\return GF_TRUE if an operation was completed, GF_FALSE otherwise
+*/
+Bool gf_file_aio_get_done(GF_FileAIO *aio, Bool wait, void **udta, s32 *res);
+
+/*!
+\brief asynchronous operations pending
+
+\param aio the target engine
+\return number of submitted operations not yet collected through \ref gf_file_aio_get_done
+*/
+u32 gf_file_aio_pending(GF_FileAIO *aio);
+
 /*!
 \brief file IO checker
 
@@ -1804,6 +1972,32 @@ Creates a new temporary file in binary mode
  */
 FILE *gf_file_temp(char ** const fileName);
 
+/*!
+\brief Memory File Creation
+
+Creates a new growable memory-backed file, usable with gf_fwrite, gf_fprintf, gf_fread, gf_fseek and gf_ftell
+\return stream handle to the new file ressource - use gf_fclose() on this object to close it
+ */
+FILE *gf_file_mem_new();
+
+/*!
+\brief Memory File Content
+
+Gets the content of a memory file created with \ref gf_file_mem_new
+\param file the target memory file
+\param size set to the size of the file
+\return content of the file, NULL if empty or not a memory file. The content is owned by the file and valid until the next write or gf_fclose
+ */
+u8 *gf_file_mem_get_data(FILE *file, u32 *size);
+
+/*!
+\brief Memory File Reset
+
+Truncates a memory file created with \ref gf_file_mem_new, keeping its allocated memory
+\param file the target memory file
+ */
+void gf_file_mem_reset(FILE *file);
+
 
 /*!
 \brief File Modification Time
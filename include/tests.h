@@ -4,6 +4,11 @@
 
 #define unittest(suffix) void test_##suffix(void)
 
+//not defined by glibc when NDEBUG is set
+#ifndef __ASSERT_FUNCTION
+#define __ASSERT_FUNCTION __func__
+#endif
+
 extern int checks_passed;
 extern int checks_failed;
 
@@ -27,6 +27,19 @@
 
 #if !defined(GPAC_DISABLE_COMPOSITOR) &&  !defined(GPAC_DISABLE_RESAMPLE)
 
+#ifdef __AVX2__
+# include <immintrin.h>
+# define GPAC_HAS_AVX2
+#endif
+#if defined(__SSE2__) || (defined(WIN32) && defined(GPAC_64_BITS) && !defined(__GNUC__))
+# include <emmintrin.h>
+# define GPAC_HAS_SSE2
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+# include <arm_neon.h>
+# define GPAC_HAS_NEON
+#endif
+
 /*
 	Notes about the mixer:
 	1- spatialization is out of scope for the mixer (eg that's the sound node responsibility)
@@ -58,6 +71,17 @@ typedef struct
 	s32 (*get_sample)(u8 *data, u32 nb_ch, u32 sample_offset, u32 channel, u32 planar_stride);
 	Bool is_planar;
 	Bool muted;
+
+	/*polyphase resampler, used if rs_taps is not 0*/
+	u32 rs_taps, rs_phases, rs_step_int, rs_step_frac;
+	Bool rs_s16, rs_flushed;
+	/*filter bank, rs_phases filters of rs_taps coefficients*/
+	Float *rs_coefs;
+	s16 *rs_coefs16;
+	/*per-channel input history of rs_len samples, next output sample is computed from samples starting at rs_pos*/
+	Float *rs_fbuf[GF_AUDIO_MIXER_MAX_CHANNELS];
+	s16 *rs_sbuf[GF_AUDIO_MIXER_MAX_CHANNELS];
+	u32 rs_alloc, rs_len, rs_pos, rs_frac, rs_out_sr;
 } MixerInput;
 
 struct __audiomix
@@ -81,11 +105,28 @@ struct __audiomix
 	struct _audio_render *ar;
 
 	Fixed max_speed;
+	u32 rs_mode, rs_max_lat;
 
 	s32 *output;
 	u32 output_size;
 };
 
+static void gf_mixer_rs_del(MixerInput *in)
+{
+	u32 j;
+	for (j=0; j<GF_AUDIO_MIXER_MAX_CHANNELS; j++) {
+		if (in->rs_fbuf[j]) gf_free(in->rs_fbuf[j]);
+		if (in->rs_sbuf[j]) gf_free(in->rs_sbuf[j]);
+		in->rs_fbuf[j] = NULL;
+		in->rs_sbuf[j] = NULL;
+	}
+	if (in->rs_coefs) gf_free(in->rs_coefs);
+	if (in->rs_coefs16) gf_free(in->rs_coefs16);
+	in->rs_coefs = NULL;
+	in->rs_coefs16 = NULL;
+	in->rs_taps = in->rs_alloc = in->rs_len = 0;
+}
+
 #define swap_16(x) (( (x) << 8 & 0xff00) | ((x) >> 8 & 0x00ff))
 #define swap_32(x) (swap_16(x) << 16 | swap_16((x) >> 16))
 #define swap_64(x) ( swap_32(x) << 32 | swap_32((x) >> 32))
@@ -112,6 +153,7 @@ GF_AudioMixer *gf_mixer_new(struct _audio_render *ar)
 	am->output = NULL;
 	am->output_size = 0;
 	am->max_speed = FIX_MAX;
+	am->rs_mode = GF_MIXER_RESAMPLE_MEDIUM;
 	return am;
 }
 
@@ -125,6 +167,21 @@ void gf_mixer_set_max_speed(GF_AudioMixer *am, Double max_speed)
 	am->max_speed = FLT2FIX(max_speed);
 }
 
+GF_EXPORT
+void gf_mixer_set_resampler(GF_AudioMixer *am, u32 mode, u32 max_latency_ms)
+{
+	u32 i=0;
+	MixerInput *in;
+	gf_mixer_lock(am, GF_TRUE);
+	am->rs_mode = mode;
+	am->rs_max_lat = max_latency_ms;
+	//force recomputing resampling setup
+	while ((in = (MixerInput *)gf_list_enum(am->sources, &i))) {
+		in->ratio_aligned = 0;
+	}
+	gf_mixer_lock(am, GF_FALSE);
+}
+
 GF_EXPORT
 void gf_mixer_del(GF_AudioMixer *am)
 {
@@ -145,6 +202,7 @@ void gf_mixer_remove_all(GF_AudioMixer *am)
 		for (j=0; j<GF_AUDIO_MIXER_MAX_CHANNELS; j++) {
 			if (in->ch_buf[j]) gf_free(in->ch_buf[j]);
 		}
+		gf_mixer_rs_del(in);
 		gf_free(in);
 	}
 	am->isEmpty = GF_TRUE;
@@ -242,6 +300,7 @@ void gf_mixer_remove_input(GF_AudioMixer *am, GF_AudioInterface *src)
 		for (j=0; j<GF_AUDIO_MIXER_MAX_CHANNELS; j++) {
 			if (in->ch_buf[j]) gf_free(in->ch_buf[j]);
 		}
+		gf_mixer_rs_del(in);
 		gf_free(in);
 		break;
 	}
@@ -785,18 +844,464 @@ static GFINLINE void gf_mixer_map_channels(s32 *inChan, u32 nb_in, u64 in_ch_lay
 	}
 }
 
+/*fractional bits of s16 polyphase filter coefficients*/
+#define RS_S16_BITS	14
+/*max number of filter phases, ratios requiring more phases use the nearest lower phase*/
+#define RS_MAX_PHASES	512
+#define RS_PI	3.14159265358979323846
+
+/*dot product of n input samples and filter coefficients, n is a multiple of 16*/
+static GFINLINE Float rs_dot_flt(const Float *x, const Float *h, u32 n)
+{
+	u32 i;
+#if defined(GPAC_HAS_AVX2)
+	__m128 acc4;
+	__m256 acc = _mm256_setzero_ps();
+	for (i=0; i<n; i+=8) {
+#ifdef __FMA__
+		acc = _mm256_fmadd_ps(_mm256_loadu_ps(x+i), _mm256_loadu_ps(h+i), acc);
+#else
+		acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(x+i), _mm256_loadu_ps(h+i)));
+#endif
+	}
+	acc4 = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+	acc4 = _mm_add_ps(acc4, _mm_movehl_ps(acc4, acc4));
+	acc4 = _mm_add_ss(acc4, _mm_shuffle_ps(acc4, acc4, 1));
+	return _mm_cvtss_f32(acc4);
+#elif defined(GPAC_HAS_SSE2)
+	__m128 acc0 = _mm_setzero_ps();
+	__m128 acc1 = _mm_setzero_ps();
+	for (i=0; i<n; i+=8) {
+		acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(x+i), _mm_loadu_ps(h+i)));
+		acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(x+i+4), _mm_loadu_ps(h+i+4)));
+	}
+	acc0 = _mm_add_ps(acc0, acc1);
+	acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+	acc0 = _mm_add_ss(acc0, _mm_shuffle_ps(acc0, acc0, 1));
+	return _mm_cvtss_f32(acc0);
+#elif defined(GPAC_HAS_NEON)
+	float32x2_t acc2;
+	float32x4_t acc0 = vdupq_n_f32(0);
+	float32x4_t acc1 = vdupq_n_f32(0);
+	for (i=0; i<n; i+=8) {
+		acc0 = vmlaq_f32(acc0, vld1q_f32(x+i), vld1q_f32(h+i));
+		acc1 = vmlaq_f32(acc1, vld1q_f32(x+i+4), vld1q_f32(h+i+4));
+	}
+	acc0 = vaddq_f32(acc0, acc1);
+	acc2 = vadd_f32(vget_low_f32(acc0), vget_high_f32(acc0));
+	return vget_lane_f32(vpadd_f32(acc2, acc2), 0);
+#else
+	Float acc[4] = {0, 0, 0, 0};
+	for (i=0; i<n; i+=4) {
+		acc[0] += x[i] * h[i];
+		acc[1] += x[i+1] * h[i+1];
+		acc[2] += x[i+2] * h[i+2];
+		acc[3] += x[i+3] * h[i+3];
+	}
+	return acc[0] + acc[1] + acc[2] + acc[3];
+#endif
+}
+
+static GFINLINE s32 rs_dot_s16(const s16 *x, const s16 *h, u32 n)
+{
+	u32 i;
+#if defined(GPAC_HAS_AVX2)
+	__m128i acc4;
+	__m256i acc = _mm256_setzero_si256();
+	for (i=0; i<n; i+=16) {
+		acc = _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *) (x+i)), _mm256_loadu_si256((const __m256i *) (h+i))));
+	}
+	acc4 = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+	acc4 = _mm_add_epi32(acc4, _mm_shuffle_epi32(acc4, 0x4E));
+	acc4 = _mm_add_epi32(acc4, _mm_shuffle_epi32(acc4, 0xB1));
+	return _mm_cvtsi128_si32(acc4);
+#elif defined(GPAC_HAS_SSE2)
+	__m128i acc0 = _mm_setzero_si128();
+	__m128i acc1 = _mm_setzero_si128();
+	for (i=0; i<n; i+=16) {
+		acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(_mm_loadu_si128((const __m128i *) (x+i)), _mm_loadu_si128((const __m128i *) (h+i))));
+		acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(_mm_loadu_si128((const __m128i *) (x+i+8)), _mm_loadu_si128((const __m128i *) (h+i+8))));
+	}
+	acc0 = _mm_add_epi32(acc0, acc1);
+	acc0 = _mm_add_epi32(acc0, _mm_shuffle_epi32(acc0, 0x4E));
+	acc0 = _mm_add_epi32(acc0, _mm_shuffle_epi32(acc0, 0xB1));
+	return _mm_cvtsi128_si32(acc0);
+#elif defined(GPAC_HAS_NEON)
+	int32x2_t acc2;
+	int32x4_t acc0 = vdupq_n_s32(0);
+	int32x4_t acc1 = vdupq_n_s32(0);
+	for (i=0; i<n; i+=8) {
+		int16x8_t vx = vld1q_s16(x+i);
+		int16x8_t vh = vld1q_s16(h+i);
+		acc0 = vmlal_s16(acc0, vget_low_s16(vx), vget_low_s16(vh));
+		acc1 = vmlal_s16(acc1, vget_high_s16(vx), vget_high_s16(vh));
+	}
+	acc0 = vaddq_s32(acc0, acc1);
+	acc2 = vadd_s32(vget_low_s32(acc0), vget_high_s32(acc0));
+	return vget_lane_s32(vpadd_s32(acc2, acc2), 0);
+#else
+	s32 acc = 0;
+	for (i=0; i<n; i++) {
+		acc += (s32) x[i] * h[i];
+	}
+	return acc;
+#endif
+}
+
+static Double rs_bessel_i0(Double x)
+{
+	u32 k;
+	Double sum = 1, term = 1;
+	for (k=1; k<64; k++) {
+		term *= (x / (2*k)) * (x / (2*k));
+		sum += term;
+		if (term < sum * 1e-12) break;
+	}
+	return sum;
+}
+
+/*make room for nb_samp samples at the end of the input history*/
+static GF_Err gf_mixer_rs_reserve(MixerInput *in, u32 nb_samp)
+{
+	u32 j, drop, alloc;
+	if (in->rs_len + nb_samp <= in->rs_alloc) return GF_OK;
+
+	//drop samples no longer used by the filter
+	drop = MIN(in->rs_pos, in->rs_len);
+	if (drop) {
+		for (j=0; j<in->src->chan; j++) {
+			if (in->rs_s16)
+				memmove(in->rs_sbuf[j], in->rs_sbuf[j] + drop, sizeof(s16) * (in->rs_len - drop));
+			else
+				memmove(in->rs_fbuf[j], in->rs_fbuf[j] + drop, sizeof(Float) * (in->rs_len - drop));
+		}
+		in->rs_len -= drop;
+		in->rs_pos -= drop;
+		if (in->rs_len + nb_samp <= in->rs_alloc) return GF_OK;
+	}
+	alloc = in->rs_len + nb_samp + in->rs_taps;
+	for (j=0; j<in->src->chan; j++) {
+		if (in->rs_s16) {
+			s16 *buf = (s16 *) gf_realloc(in->rs_sbuf[j], sizeof(s16) * alloc);
+			if (!buf) return GF_OUT_OF_MEM;
+			in->rs_sbuf[j] = buf;
+		} else {
+			Float *buf = (Float *) gf_realloc(in->rs_fbuf[j], sizeof(Float) * alloc);
+			if (!buf) return GF_OUT_OF_MEM;
+			in->rs_fbuf[j] = buf;
+		}
+	}
+	in->rs_alloc = alloc;
+	return GF_OK;
+}
+
+/*append nb_samp input samples to the history, silence if data is NULL - on error polyphase resampling is disabled*/
+static GF_Err gf_mixer_rs_append(MixerInput *in, u8 *data, u32 nb_samp, u32 planar_stride)
+{
+	u32 i, j, nb_ch = in->src->chan;
+	if (gf_mixer_rs_reserve(in, nb_samp)) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_AUDIO, ("[AudioMixer] Failed to allocate resampler history, using linear interpolation\n"));
+		gf_mixer_rs_del(in);
+		return GF_OUT_OF_MEM;
+	}
+
+	for (j=0; j<nb_ch; j++) {
+		if (in->rs_s16) {
+			s16 *dst = in->rs_sbuf[j] + in->rs_len;
+			if (!data) {
+				memset(dst, 0, sizeof(s16) * nb_samp);
+				continue;
+			}
+#ifndef GPAC_BIG_ENDIAN
+			if (in->src->afmt == GF_AUDIO_FMT_S16P) {
+				memcpy(dst, data + j*planar_stride, sizeof(s16) * nb_samp);
+				continue;
+			}
+			if (in->src->afmt == GF_AUDIO_FMT_S16) {
+				s16 *src = ((s16 *) data) + j;
+				for (i=0; i<nb_samp; i++) dst[i] = src[i*nb_ch];
+				continue;
+			}
+#endif
+			for (i=0; i<nb_samp; i++)
+				dst[i] = (s16) (in->get_sample(data, nb_ch, i, j, planar_stride) / MIX_S16_SCALE);
+		} else {
+			Float *dst = in->rs_fbuf[j] + in->rs_len;
+			if (!data) {
+				memset(dst, 0, sizeof(Float) * nb_samp);
+				continue;
+			}
+			for (i=0; i<nb_samp; i++)
+				dst[i] = (Float) in->get_sample(data, nb_ch, i, j, planar_stride);
+		}
+	}
+	in->rs_len += nb_samp;
+	return GF_OK;
+}
+
+/*reset input history, the first output sample is aligned on the first input sample*/
+static GF_Err gf_mixer_rs_reset(MixerInput *in)
+{
+	in->rs_len = in->rs_pos = in->rs_frac = 0;
+	in->rs_flushed = GF_FALSE;
+	return gf_mixer_rs_append(in, NULL, in->rs_taps/2 - 1, 0);
+}
+
+/*build polyphase filter bank for the current input and output rates, or disable polyphase resampling*/
+static void gf_mixer_rs_setup(GF_AudioMixer *am, MixerInput *in)
+{
+	u32 i, j, taps, phases, in_sr, out_sr, a, b;
+	Double fc, beta, rolloff, half, i0_beta, *coefs;
+
+	gf_mixer_rs_del(in);
+	in_sr = in->scaled_sr;
+	out_sr = am->sample_rate;
+	in->rs_out_sr = out_sr;
+	if ((am->rs_mode == GF_MIXER_RESAMPLE_LINEAR) || !in_sr || (in_sr == out_sr))
+		return;
+
+	switch (am->rs_mode) {
+	case GF_MIXER_RESAMPLE_LOW:
+		taps = 16;
+		beta = 6;
+		rolloff = 0.85;
+		break;
+	case GF_MIXER_RESAMPLE_HIGH:
+		taps = 64;
+		beta = 10;
+		rolloff = 0.95;
+		break;
+	default:
+		taps = 32;
+		beta = 8;
+		rolloff = 0.91;
+		break;
+	}
+	//cutoff relative to input rate - when downsampling, lower the cutoff and widen the filter accordingly
+	fc = 0.5 * rolloff;
+	if (out_sr < in_sr) {
+		fc = fc * out_sr / in_sr;
+		taps = (u32) ((u64) taps * in_sr / out_sr);
+	}
+	//filter delay is taps/2 input samples
+	if (am->rs_max_lat) {
+		u32 max_taps = (u32) ((u64) 2 * in_sr * am->rs_max_lat / 1000);
+		if (taps > max_taps) taps = max_taps;
+	}
+	taps = (taps + 15) & ~15;
+	if (taps < 16) taps = 16;
+	else if (taps > 1024) taps = 1024;
+
+	//out_sr/in_sr = L/M, one phase per output position in 1/L input sample unit
+	a = out_sr;
+	b = in_sr;
+	while (b) {
+		u32 t = a % b;
+		a = b;
+		b = t;
+	}
+	phases = out_sr / a;
+	if (phases > RS_MAX_PHASES) phases = RS_MAX_PHASES;
+
+	in->rs_s16 = GF_FALSE;
+	switch (in->src->afmt) {
+	case GF_AUDIO_FMT_S16:
+	case GF_AUDIO_FMT_S16P:
+	case GF_AUDIO_FMT_S16_BE:
+		in->rs_s16 = GF_TRUE;
+		break;
+	}
+	coefs = (Double *) gf_malloc(sizeof(Double) * taps);
+	if (in->rs_s16)
+		in->rs_coefs16 = (s16 *) gf_malloc(sizeof(s16) * taps * phases);
+	else
+		in->rs_coefs = (Float *) gf_malloc(sizeof(Float) * taps * phases);
+	if (!coefs || (!in->rs_coefs16 && !in->rs_coefs)) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_AUDIO, ("[AudioMixer] Failed to allocate polyphase filters, using linear interpolation\n"));
+		if (coefs) gf_free(coefs);
+		gf_mixer_rs_del(in);
+		return;
+	}
+
+	//Kaiser-windowed sinc, each phase normalized to unity gain
+	half = taps / 2;
+	i0_beta = rs_bessel_i0(beta);
+	for (i=0; i<phases; i++) {
+		Double sum = 0;
+		for (j=0; j<taps; j++) {
+			Double d = (Double) j - half + 1 - (Double) i / phases;
+			Double x = 2 * fc * d;
+			Double w = d / half;
+			Double c = (x==0) ? 1 : sin(RS_PI * x) / (RS_PI * x);
+			w = 1 - w*w;
+			c *= (w>0) ? rs_bessel_i0(beta * sqrt(w)) / i0_beta : 0;
+			coefs[j] = c;
+			sum += c;
+		}
+		if (in->rs_s16) {
+			s32 isum = 0;
+			u32 max_j = 0;
+			s16 *h = in->rs_coefs16 + i*taps;
+			for (j=0; j<taps; j++) {
+				h[j] = (s16) floor(coefs[j] * (1<<RS_S16_BITS) / sum + 0.5);
+				isum += h[j];
+				if (h[j] > h[max_j]) max_j = j;
+			}
+			//keep unity gain after rounding
+			h[max_j] += (1<<RS_S16_BITS) - isum;
+		} else {
+			Float *h = in->rs_coefs + i*taps;
+			for (j=0; j<taps; j++)
+				h[j] = (Float) (coefs[j] / sum);
+		}
+	}
+	gf_free(coefs);
+
+	in->rs_taps = taps;
+	in->rs_phases = phases;
+	in->rs_step_int = in_sr / out_sr;
+	in->rs_step_frac = in_sr % out_sr;
+	gf_mixer_rs_reset(in);
+}
+
+/*map input channels to output and store sample*/
+static GFINLINE void gf_mixer_write_sample(GF_AudioMixer *am, MixerInput *in, s32 *inChan)
+{
+	u32 j;
+	if (in->speed <= am->max_speed) {
+		//map inChannel to the output channel config
+		gf_mixer_map_channels(inChan, in->src->chan, in->src->ch_layout, in->src->forced_layout, am->nb_channels, am->channel_layout);
+
+		for (j=0; j<am->nb_channels; j++) {
+			*(in->ch_buf[j] + in->out_samples_written) = (s32) inChan[j];
+		}
+	} else {
+		for (j=0; j<am->nb_channels; j++) {
+			*(in->ch_buf[j] + in->out_samples_written) = 0;
+		}
+	}
+	in->out_samples_written ++;
+}
+
+/*compute output samples from input history*/
+static void gf_mixer_rs_output(GF_AudioMixer *am, MixerInput *in)
+{
+	u32 j, in_ch = in->src->chan;
+	s32 inChan[GF_AUDIO_MIXER_MAX_CHANNELS];
+
+	memset(inChan, 0, sizeof(s32)*GF_AUDIO_MIXER_MAX_CHANNELS);
+	while ((in->out_samples_written < in->out_samples_to_write) && (in->rs_pos + in->rs_taps <= in->rs_len)) {
+		u32 phase = (u32) ((u64) in->rs_frac * in->rs_phases / am->sample_rate);
+
+		for (j=0; j<in_ch; j++) {
+			if (in->rs_s16) {
+				s32 samp = rs_dot_s16(in->rs_sbuf[j] + in->rs_pos, in->rs_coefs16 + phase*in->rs_taps, in->rs_taps);
+				samp = (samp + (1<<(RS_S16_BITS-1))) >> RS_S16_BITS;
+				if (samp > GF_SHORT_MAX) samp = GF_SHORT_MAX;
+				else if (samp < GF_SHORT_MIN) samp = GF_SHORT_MIN;
+				inChan[j] = samp * MIX_S16_SCALE;
+			} else {
+				Float samp = rs_dot_flt(in->rs_fbuf[j] + in->rs_pos, in->rs_coefs + phase*in->rs_taps, in->rs_taps);
+				if (samp >= (Float) GF_INT_MAX) inChan[j] = GF_INT_MAX;
+				else if (samp <= (Float) GF_INT_MIN) inChan[j] = GF_INT_MIN;
+				else inChan[j] = (s32) samp;
+			}
+			//don't apply pan when forced layout is used
+			if (!in->src->forced_layout && (in->pan[j]!=FIX_ONE) ) {
+				inChan[j] = (s32) ( ((s64) inChan[j]) * FIX2INT(100 * in->pan[j]) / 100);
+			}
+		}
+		gf_mixer_write_sample(am, in, inChan);
+
+		in->rs_pos += in->rs_step_int;
+		in->rs_frac += in->rs_step_frac;
+		if (in->rs_frac >= am->sample_rate) {
+			in->rs_frac -= am->sample_rate;
+			in->rs_pos ++;
+		}
+	}
+}
+
+static void gf_mixer_fetch_input_polyphase(GF_AudioMixer *am, MixerInput *in, u32 audio_delay)
+{
+	u32 src_size=0, planar_stride=0, src_samp, nb_out;
+	u64 last_pos;
+	u8 *in_data;
+
+	//output what can be computed from history
+	gf_mixer_rs_output(am, in);
+	if (in->out_samples_written == in->out_samples_to_write)
+		return;
+
+	in_data = (u8 *) in->src->FetchFrame(in->src->callback, &src_size, &planar_stride, audio_delay);
+	if (!in_data || !src_size) {
+		if (in->src->is_eos)
+			am->nb_eos++;
+		else if (in->src->is_buffering)
+			am->source_buffering = GF_TRUE;
+
+		//end of stream, flush filter with half a filter of silence
+		if (in->src->is_eos && !in->rs_flushed && !gf_mixer_rs_append(in, NULL, in->rs_taps/2, 0)) {
+			in->rs_flushed = GF_TRUE;
+			gf_mixer_rs_output(am, in);
+		}
+		/*done, stop fill*/
+		in->out_samples_to_write = 0;
+		return;
+	}
+	//new data after end of stream flush
+	if (in->rs_flushed && gf_mixer_rs_reset(in))
+		return;
+
+	src_samp = src_size / in->bytes_p_samp;
+	if (!src_samp) {
+		in->in_bytes_used = src_size + 1;
+		return;
+	}
+	//only consume what is needed for the remaining output samples
+	nb_out = in->out_samples_to_write - in->out_samples_written;
+	last_pos = in->rs_frac + (u64) (nb_out-1) * in->rs_step_frac;
+	last_pos = in->rs_pos + (u64) (nb_out-1) * in->rs_step_int + last_pos / am->sample_rate;
+	last_pos += in->rs_taps;
+	if (last_pos - in->rs_len < src_samp)
+		src_samp = (u32) (last_pos - in->rs_len);
+
+	//input not consumed, next fetch uses linear interpolation
+	if (gf_mixer_rs_append(in, (u8 *) in_data, src_samp, planar_stride))
+		return;
+	in->in_bytes_used = src_samp * in->bytes_p_samp + 1;
+
+	gf_mixer_rs_output(am, in);
+}
+
 #define RESAMPLE_SCALER	1000
 
 static void gf_mixer_fetch_input(GF_AudioMixer *am, MixerInput *in, u32 audio_delay)
 {
-	u32 j, in_ch, out_ch, prev, next, src_samp, src_size;
+	u32 j, in_ch, prev, next, src_samp, src_size;
 	Bool use_prev;
 	u32 planar_stride=0;
 	s8 *in_data;
 	s32 frac, inChan[GF_AUDIO_MIXER_MAX_CHANNELS], inChanNext[GF_AUDIO_MIXER_MAX_CHANNELS];
 
+	//config changed, recompute our values
+	if (!in->ratio_aligned || (in->rs_taps && (in->rs_out_sr != am->sample_rate))) {
+		u32 ratio = (u32) (in->src->samplerate * FIX2INT(255*in->speed) / am->sample_rate);
+		if (ratio % 255) in->ratio_aligned = 2;
+		else in->ratio_aligned = 1;
+
+		in->in_samples_pos = in->out_samples_pos = 0;
+		in->scaled_sr = FIX2INT(in->src->samplerate * in->speed);
+
+		in->bytes_p_samp = in->bit_depth * in->src->chan / 8;
+		gf_mixer_rs_setup(am, in);
+	}
+	if (in->rs_taps) {
+		gf_mixer_fetch_input_polyphase(am, in, audio_delay);
+		return;
+	}
+
 	in_ch = in->src->chan;
-	out_ch = am->nb_channels;
 	use_prev = in->has_prev;
 
 	in_data = (s8 *) in->src->FetchFrame(in->src->callback, &src_size, &planar_stride, audio_delay);
@@ -815,17 +1320,6 @@ static void gf_mixer_fetch_input(GF_AudioMixer *am, MixerInput *in, u32 audio_de
 		}
 	}
 
-	//config changed, recompute our values
-	if (!in->ratio_aligned) {
-		u32 ratio = (u32) (in->src->samplerate * FIX2INT(255*in->speed) / am->sample_rate);
-		if (ratio % 255) in->ratio_aligned = 2;
-		else in->ratio_aligned = 1;
-
-		in->in_samples_pos = in->out_samples_pos = 0;
-		in->scaled_sr = FIX2INT(in->src->samplerate * in->speed);
-
-		in->bytes_p_samp = in->bit_depth * in->src->chan / 8;
-	}
 	src_samp = (u32) (src_size / in->bytes_p_samp);
 
 
@@ -886,20 +1380,7 @@ static void gf_mixer_fetch_input(GF_AudioMixer *am, MixerInput *in, u32 audio_de
 			}
 		}
 
-		if (in->speed <= am->max_speed) {
-			//map inChannel to the output channel config
-			gf_mixer_map_channels(inChan, in_ch, in->src->ch_layout, in->src->forced_layout, out_ch, am->channel_layout);
-
-			for (j=0; j<out_ch ; j++) {
-				*(in->ch_buf[j] + in->out_samples_written) = (s32) inChan[j];
-			}
-		} else {
-			for (j=0; j<out_ch ; j++) {
-				*(in->ch_buf[j] + in->out_samples_written) = 0;
-			}
-		}
-
-		in->out_samples_written ++;
+		gf_mixer_write_sample(am, in, inChan);
 		in->out_samples_pos ++;
 		if (in->out_samples_written == in->out_samples_to_write)
 			break;
@@ -0,0 +1,175 @@
+#include "tests.h"
+#include <gpac/internal/compositor_dev.h>
+
+#include <stdio.h>
+
+#if !defined(GPAC_DISABLE_COMPOSITOR) && !defined(GPAC_DISABLE_RESAMPLE)
+
+#define UTM_IN_SR	48000
+#define UTM_OUT_SR	44100
+#define UTM_AMP	16000.0
+#define UTM_PI	3.14159265358979323846
+
+typedef struct
+{
+	GF_AudioInterface ai;
+	u8 *data;
+	u32 size, pos;
+} UTMSource;
+
+static u8 *utm_fetch_frame(void *callback, u32 *size, u32 *planar_stride, u32 audio_delay_ms)
+{
+	UTMSource *src = (UTMSource *) callback;
+	*size = src->size - src->pos;
+	*planar_stride = src->size / src->ai.chan;
+	if (!*size) {
+		src->ai.is_eos = GF_TRUE;
+		return NULL;
+	}
+	return src->data + src->pos;
+}
+static void utm_release_frame(void *callback, u32 nb_bytes)
+{
+	UTMSource *src = (UTMSource *) callback;
+	src->pos += nb_bytes;
+}
+static Bool utm_get_config(struct _audiointerface *ai, Bool for_reconf)
+{
+	return GF_TRUE;
+}
+static Bool utm_is_muted(void *callback)
+{
+	return GF_FALSE;
+}
+static Fixed utm_get_speed(void *callback)
+{
+	return FIX_ONE;
+}
+static Bool utm_get_channel_volume(void *callback, Fixed *vol)
+{
+	u32 i;
+	for (i=0; i<GF_AUDIO_MIXER_MAX_CHANNELS; i++) vol[i] = FIX_ONE;
+	return GF_FALSE;
+}
+
+//interleaved sine of nb_samp samples per channel
+static void utm_source_init(UTMSource *src, u32 afmt, u32 nb_ch, Double freq, u32 nb_samp)
+{
+	u32 i, j;
+	memset(src, 0, sizeof(UTMSource));
+	src->ai.callback = src;
+	src->ai.FetchFrame = utm_fetch_frame;
+	src->ai.ReleaseFrame = utm_release_frame;
+	src->ai.GetConfig = utm_get_config;
+	src->ai.IsMuted = utm_is_muted;
+	src->ai.GetSpeed = utm_get_speed;
+	src->ai.GetChannelVolume = utm_get_channel_volume;
+	src->ai.samplerate = UTM_IN_SR;
+	src->ai.chan = nb_ch;
+	src->ai.afmt = afmt;
+	src->ai.ch_layout = (nb_ch==1) ? GF_AUDIO_CH_FRONT_CENTER : (GF_AUDIO_CH_FRONT_LEFT|GF_AUDIO_CH_FRONT_RIGHT);
+	src->size = nb_samp * nb_ch * gf_audio_fmt_bit_depth(afmt) / 8;
+	src->data = gf_malloc(src->size);
+	for (i=0; i<nb_samp; i++) {
+		Double v = UTM_AMP * sin(2 * UTM_PI * freq * i / UTM_IN_SR);
+		for (j=0; j<nb_ch; j++) {
+			if (afmt==GF_AUDIO_FMT_FLT) ((Float *) src->data)[i*nb_ch + j] = (Float) (v / 32768);
+			else ((s16 *) src->data)[i*nb_ch + j] = (s16) v;
+		}
+	}
+}
+
+//resample source to s16 at UTM_OUT_SR, return number of output samples per channel
+static u32 utm_resample(UTMSource *src, u32 mode, s16 **out)
+{
+	u32 written, nb_out=0, alloc=0;
+	GF_AudioMixer *am = gf_mixer_new(NULL);
+	gf_mixer_set_resampler(am, mode, 0);
+	gf_mixer_add_input(am, &src->ai);
+	gf_mixer_set_config(am, UTM_OUT_SR, src->ai.chan, GF_AUDIO_FMT_S16, src->ai.ch_layout);
+	*out = NULL;
+	while (1) {
+		if (alloc < nb_out + 1024) {
+			alloc += 1<<16;
+			*out = gf_realloc(*out, sizeof(s16) * alloc * src->ai.chan);
+		}
+		written = gf_mixer_get_output(am, *out + nb_out*src->ai.chan, 1024 * 2 * src->ai.chan, 0);
+		if (!written) break;
+		nb_out += written / (2 * src->ai.chan);
+	}
+	gf_mixer_del(am);
+	return nb_out;
+}
+
+//RMS of output minus a sine of given amplitude at freq, ignoring first and last ms
+static Double utm_rms_error(s16 *out, u32 nb_ch, u32 nb_samp, Double freq, Double amp)
+{
+	u32 i, count=0;
+	Double err = 0;
+	for (i=UTM_OUT_SR/1000; i+UTM_OUT_SR/1000<nb_samp; i++) {
+		Double d = out[i*nb_ch] - amp * sin(2 * UTM_PI * freq * i / UTM_OUT_SR);
+		err += d*d;
+		count++;
+	}
+	return count ? sqrt(err / count) : UTM_AMP;
+}
+
+unittest(mixer_resample_polyphase)
+{
+	u32 afmt, nb_out;
+	s16 *out;
+	UTMSource src;
+	Double err_lin, err_poly;
+
+	for (afmt=0; afmt<2; afmt++) {
+		//in-band tone is preserved with the expected number of samples
+		utm_source_init(&src, afmt ? GF_AUDIO_FMT_FLT : GF_AUDIO_FMT_S16, 2, 1000, UTM_IN_SR);
+		nb_out = utm_resample(&src, GF_MIXER_RESAMPLE_MEDIUM, &out);
+		assert_true((nb_out + 2 >= UTM_OUT_SR) && (nb_out <= UTM_OUT_SR + 2));
+		err_poly = utm_rms_error(out, 2, nb_out, 1000, UTM_AMP);
+		assert_less(err_poly, UTM_AMP / 100);
+		gf_free(out);
+		gf_free(src.data);
+
+		//tone above output Nyquist frequency is removed by polyphase filters, aliased by linear interpolation
+		utm_source_init(&src, afmt ? GF_AUDIO_FMT_FLT : GF_AUDIO_FMT_S16, 2, 23000, UTM_IN_SR);
+		nb_out = utm_resample(&src, GF_MIXER_RESAMPLE_LINEAR, &out);
+		err_lin = utm_rms_error(out, 2, nb_out, 0, 0);
+		gf_free(out);
+		src.pos = 0;
+		src.ai.is_eos = GF_FALSE;
+		nb_out = utm_resample(&src, GF_MIXER_RESAMPLE_MEDIUM, &out);
+		err_poly = utm_rms_error(out, 2, nb_out, 0, 0);
+		gf_free(out);
+		gf_free(src.data);
+		assert_less(err_poly, UTM_AMP / 100);
+		assert_less(err_poly * 10, err_lin);
+	}
+}
+
+unittest(mixer_resample_bench)
+{
+	u32 mode, afmt;
+	const char *names[] = {"lin", "low", "med", "high"};
+	printf("\nmode\ts16 (samples/s/ch)\tflt (samples/s/ch)\n");
+	for (mode=GF_MIXER_RESAMPLE_LINEAR; mode<=GF_MIXER_RESAMPLE_HIGH; mode++) {
+		u64 rate[2];
+		for (afmt=0; afmt<2; afmt++) {
+			u64 dur;
+			s16 *out;
+			UTMSource src;
+			//10 seconds of stereo
+			utm_source_init(&src, afmt ? GF_AUDIO_FMT_FLT : GF_AUDIO_FMT_S16, 2, 1000, 10*UTM_IN_SR);
+			dur = gf_sys_clock_high_res();
+			assert_greater(utm_resample(&src, mode, &out), 0);
+			dur = gf_sys_clock_high_res() - dur;
+			gf_free(out);
+			gf_free(src.data);
+			if (!dur) dur = 1;
+			rate[afmt] = (u64) 10 * UTM_IN_SR * 1000000 / dur;
+		}
+		printf("%s\t"LLU"\t\t"LLU"\n", names[mode], rate[0], rate[1]);
+	}
+}
+
+#endif //!defined(GPAC_DISABLE_COMPOSITOR) && !defined(GPAC_DISABLE_RESAMPLE)
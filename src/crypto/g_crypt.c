@@ -34,11 +34,17 @@ GF_Crypt *gf_crypt_open(GF_CRYPTO_ALGO algorithm, GF_CRYPTO_MODE mode)
 	GF_SAFEALLOC(td, GF_Crypt);
 	if (td == NULL) return NULL;
 
+	e = GF_NOT_SUPPORTED;
+	if (!gf_opts_get_bool("core", "no-hwaes"))
+		e = gf_crypt_open_open_hw(td, mode);
+
+	if (e != GF_OK) {
 #ifdef GPAC_HAS_SSL
-	e = gf_crypt_open_open_openssl(td, mode);
+		e = gf_crypt_open_open_openssl(td, mode);
 #else
-	e = gf_crypt_open_open_tinyaes(td, mode);
+		e = gf_crypt_open_open_tinyaes(td, mode);
 #endif
+	}
 
 	if (e != GF_OK) {
 		gf_free(td);
@@ -104,3 +110,35 @@ GF_Err gf_crypt_decrypt(GF_Crypt *td, void *ciphertext, u32 len)
 	if (!len) return GF_OK;
 	return td->_decrypt(td, ciphertext, len);
 }
+
+static GF_Err gf_crypt_pattern(GF_Crypt *td, u8 *data, u32 len, u32 crypt_blocks, u32 skip_blocks, Bool decrypt)
+{
+	if (!td) return GF_BAD_PARAM;
+	if (!crypt_blocks || !skip_blocks) {
+		if (!len) return GF_OK;
+		return decrypt ? td->_decrypt(td, data, len) : td->_crypt(td, data, len);
+	}
+	while (len) {
+		GF_Err e;
+		u32 size = 16*crypt_blocks;
+		if (size > len) size = len;
+		e = decrypt ? td->_decrypt(td, data, size) : td->_crypt(td, data, size);
+		if (e) return e;
+		if (len < 16*(crypt_blocks+skip_blocks)) break;
+		data += 16*(crypt_blocks+skip_blocks);
+		len -= 16*(crypt_blocks+skip_blocks);
+	}
+	return GF_OK;
+}
+
+GF_EXPORT
+GF_Err gf_crypt_encrypt_pattern(GF_Crypt *td, void *plaintext, u32 len, u32 crypt_blocks, u32 skip_blocks)
+{
+	return gf_crypt_pattern(td, plaintext, len, crypt_blocks, skip_blocks, GF_FALSE);
+}
+
+GF_EXPORT
+GF_Err gf_crypt_decrypt_pattern(GF_Crypt *td, void *ciphertext, u32 len, u32 crypt_blocks, u32 skip_blocks)
+{
+	return gf_crypt_pattern(td, ciphertext, len, crypt_blocks, skip_blocks, GF_TRUE);
+}
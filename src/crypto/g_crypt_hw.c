@@ -0,0 +1,572 @@
+/*
+*			GPAC - Multimedia Framework C SDK
+*
+*			Authors: Jean Le Feuvre
+*			Copyright (c) Telecom ParisTech 2018-2024
+*					All rights reserved
+*
+*  This file is part of GPAC / crypto lib sub-project
+*
+*  GPAC is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU Lesser General Public License as published by
+*  the Free Software Foundation; either version 2, or (at your option)
+*  any later version.
+*
+*  GPAC is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; see the file COPYING.  If not, write to
+*  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+*
+*/
+
+#include <gpac/internal/crypt_dev.h>
+
+/*
+AES-128 using CPU instructions (AES-NI on x86, cryptographic extensions on ARMv8), used in priority over openSSL and tiny-AES
+when supported by the CPU, unless -no-hwaes is set.
+
+Only the block kernels are architecture-specific, mode state is handled as in the tiny-AES wrapper:
+- CBC: 16-byte IV, only full blocks are processed
+- CTR: the state is the next counter block, and the number of unused keystream bytes of the last generated block is exported
+as the first byte of the 17-byte IV
+*/
+
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) \
+	&& (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)) && !defined(GPAC_CONFIG_EMSCRIPTEN)
+
+#define GPAC_HAS_AESNI
+# include <wmmintrin.h>
+# if defined(__GNUC__) || defined(__clang__)
+#  include <cpuid.h>
+#  define HWAES_FUNC	__attribute__((target("aes,sse2")))
+# else
+#  include <intrin.h>
+#  define HWAES_FUNC
+# endif
+
+#elif defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES)
+
+#define GPAC_HAS_ARMV8_AES
+# include <arm_neon.h>
+# define HWAES_FUNC
+
+#endif
+
+#if defined(GPAC_HAS_AESNI) || defined(GPAC_HAS_ARMV8_AES)
+
+#define HWAES_BLOCK	16
+#define HWAES_ROUNDS	10
+
+typedef struct
+{
+	//encryption and equivalent inverse cipher round keys
+	u8 rk[(HWAES_ROUNDS+1)*HWAES_BLOCK];
+	u8 dk[(HWAES_ROUNDS+1)*HWAES_BLOCK];
+	//CBC: chaining IV - CTR: next counter block
+	u8 iv[HWAES_BLOCK];
+	//CTR: keystream of last generated block and number of unused bytes in it
+	u8 ks[HWAES_BLOCK];
+	u32 counter_pos;
+} HWAESCtx;
+
+static void hwaes_ctr_inc(u8 *ctr)
+{
+	s32 i;
+	for (i=HWAES_BLOCK-1; i>=0; i--) {
+		ctr[i]++;
+		if (ctr[i]) break;
+	}
+}
+
+#ifdef GPAC_HAS_AESNI
+
+static Bool hwaes_cpu_supported(void)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	unsigned int a, b, c, d;
+	if (!__get_cpuid(1, &a, &b, &c, &d)) return GF_FALSE;
+	//AES and SSE2
+	return ((c & (1<<25)) && (d & (1<<26))) ? GF_TRUE : GF_FALSE;
+#else
+	int info[4];
+	__cpuid(info, 1);
+	return ((info[2] & (1<<25)) && (info[3] & (1<<26))) ? GF_TRUE : GF_FALSE;
+#endif
+}
+
+HWAES_FUNC
+static u32 hwaes_sub_word(u32 w)
+{
+	//keygen assist returns SubWord(X1) in the lowest dword
+	return (u32) _mm_cvtsi128_si32(_mm_aeskeygenassist_si128(_mm_set_epi32(0, 0, (int) w, 0), 0));
+}
+
+HWAES_FUNC
+static void hwaes_inv_mix_columns(u8 *dst, const u8 *src)
+{
+	_mm_storeu_si128((__m128i *) dst, _mm_aesimc_si128(_mm_loadu_si128((const __m128i *) src)));
+}
+
+#define HWAES_LOAD_KEYS(_k, _src) \
+	for (i=0; i<=HWAES_ROUNDS; i++) _k[i] = _mm_loadu_si128((const __m128i *) (_src + i*HWAES_BLOCK));
+
+#define HWAES_ROUND8(_op, _k) \
+	b0 = _op(b0, _k); b1 = _op(b1, _k); b2 = _op(b2, _k); b3 = _op(b3, _k); \
+	b4 = _op(b4, _k); b5 = _op(b5, _k); b6 = _op(b6, _k); b7 = _op(b7, _k);
+
+#define HWAES_CIPHER8(_op, _oplast, _k) \
+	HWAES_ROUND8(_mm_xor_si128, _k[0]) \
+	for (r=1; r<HWAES_ROUNDS; r++) { HWAES_ROUND8(_op, _k[r]) } \
+	HWAES_ROUND8(_oplast, _k[HWAES_ROUNDS])
+
+#define HWAES_LOAD8(_src) \
+	b0 = _mm_loadu_si128((const __m128i *) (_src)); b1 = _mm_loadu_si128((const __m128i *) (_src+16)); \
+	b2 = _mm_loadu_si128((const __m128i *) (_src+32)); b3 = _mm_loadu_si128((const __m128i *) (_src+48)); \
+	b4 = _mm_loadu_si128((const __m128i *) (_src+64)); b5 = _mm_loadu_si128((const __m128i *) (_src+80)); \
+	b6 = _mm_loadu_si128((const __m128i *) (_src+96)); b7 = _mm_loadu_si128((const __m128i *) (_src+112));
+
+#define HWAES_XOR_STORE8(_dst, _src) \
+	_mm_storeu_si128((__m128i *) (_dst), _mm_xor_si128(b0, _mm_loadu_si128((const __m128i *) (_src)))); \
+	_mm_storeu_si128((__m128i *) (_dst+16), _mm_xor_si128(b1, _mm_loadu_si128((const __m128i *) (_src+16)))); \
+	_mm_storeu_si128((__m128i *) (_dst+32), _mm_xor_si128(b2, _mm_loadu_si128((const __m128i *) (_src+32)))); \
+	_mm_storeu_si128((__m128i *) (_dst+48), _mm_xor_si128(b3, _mm_loadu_si128((const __m128i *) (_src+48)))); \
+	_mm_storeu_si128((__m128i *) (_dst+64), _mm_xor_si128(b4, _mm_loadu_si128((const __m128i *) (_src+64)))); \
+	_mm_storeu_si128((__m128i *) (_dst+80), _mm_xor_si128(b5, _mm_loadu_si128((const __m128i *) (_src+80)))); \
+	_mm_storeu_si128((__m128i *) (_dst+96), _mm_xor_si128(b6, _mm_loadu_si128((const __m128i *) (_src+96)))); \
+	_mm_storeu_si128((__m128i *) (_dst+112), _mm_xor_si128(b7, _mm_loadu_si128((const __m128i *) (_src+112))));
+
+HWAES_FUNC
+static GFINLINE __m128i hwaes_enc1(__m128i b, const __m128i *k)
+{
+	u32 r;
+	b = _mm_xor_si128(b, k[0]);
+	for (r=1; r<HWAES_ROUNDS; r++) b = _mm_aesenc_si128(b, k[r]);
+	return _mm_aesenclast_si128(b, k[HWAES_ROUNDS]);
+}
+
+HWAES_FUNC
+static GFINLINE __m128i hwaes_dec1(__m128i b, const __m128i *k)
+{
+	u32 r;
+	b = _mm_xor_si128(b, k[0]);
+	for (r=1; r<HWAES_ROUNDS; r++) b = _mm_aesdec_si128(b, k[r]);
+	return _mm_aesdeclast_si128(b, k[HWAES_ROUNDS]);
+}
+
+//in-place ECB on nb_blocks, 8 blocks interleaved
+HWAES_FUNC
+static void hwaes_ecb(const u8 *keys, u8 *buf, u32 nb_blocks, Bool decrypt)
+{
+	u32 i, r;
+	__m128i k[HWAES_ROUNDS+1];
+	HWAES_LOAD_KEYS(k, keys)
+	for (; nb_blocks>=8; nb_blocks-=8, buf+=8*HWAES_BLOCK) {
+		__m128i b0, b1, b2, b3, b4, b5, b6, b7;
+		HWAES_LOAD8(buf)
+		if (decrypt) {
+			HWAES_CIPHER8(_mm_aesdec_si128, _mm_aesdeclast_si128, k)
+		} else {
+			HWAES_CIPHER8(_mm_aesenc_si128, _mm_aesenclast_si128, k)
+		}
+		_mm_storeu_si128((__m128i *) buf, b0); _mm_storeu_si128((__m128i *) (buf+16), b1);
+		_mm_storeu_si128((__m128i *) (buf+32), b2); _mm_storeu_si128((__m128i *) (buf+48), b3);
+		_mm_storeu_si128((__m128i *) (buf+64), b4); _mm_storeu_si128((__m128i *) (buf+80), b5);
+		_mm_storeu_si128((__m128i *) (buf+96), b6); _mm_storeu_si128((__m128i *) (buf+112), b7);
+	}
+	for (; nb_blocks; nb_blocks--, buf+=HWAES_BLOCK) {
+		__m128i b = _mm_loadu_si128((const __m128i *) buf);
+		b = decrypt ? hwaes_dec1(b, k) : hwaes_enc1(b, k);
+		_mm_storeu_si128((__m128i *) buf, b);
+	}
+}
+
+//xor nb_blocks with keystream starting at counter block ctr, ctr is updated
+HWAES_FUNC
+static void hwaes_ctr(const u8 *keys, u8 *buf, u32 nb_blocks, u8 *ctr)
+{
+	u32 i, r;
+	u8 c[8*HWAES_BLOCK];
+	__m128i k[HWAES_ROUNDS+1];
+	HWAES_LOAD_KEYS(k, keys)
+	for (; nb_blocks>=8; nb_blocks-=8, buf+=8*HWAES_BLOCK) {
+		__m128i b0, b1, b2, b3, b4, b5, b6, b7;
+		//no carry out of the last byte, add block index to it
+		if (ctr[HWAES_BLOCK-1] < 0xF8) {
+			b0 = _mm_loadu_si128((const __m128i *) ctr);
+			b1 = _mm_add_epi8(b0, _mm_set_epi8(1, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0));
+			b2 = _mm_add_epi8(b0, _mm_set_epi8(2, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0));
+			b3 = _mm_add_epi8(b0, _mm_set_epi8(3, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0));
+			b4 = _mm_add_epi8(b0, _mm_set_epi8(4, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0));
+			b5 = _mm_add_epi8(b0, _mm_set_epi8(5, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0));
+			b6 = _mm_add_epi8(b0, _mm_set_epi8(6, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0));
+			b7 = _mm_add_epi8(b0, _mm_set_epi8(7, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0));
+			ctr[HWAES_BLOCK-1] += 8;
+		} else {
+			for (i=0; i<8; i++) {
+				memcpy(c + i*HWAES_BLOCK, ctr, HWAES_BLOCK);
+				hwaes_ctr_inc(ctr);
+			}
+			HWAES_LOAD8(c)
+		}
+		HWAES_CIPHER8(_mm_aesenc_si128, _mm_aesenclast_si128, k)
+		HWAES_XOR_STORE8(buf, buf)
+	}
+	for (; nb_blocks; nb_blocks--, buf+=HWAES_BLOCK) {
+		__m128i b = hwaes_enc1(_mm_loadu_si128((const __m128i *) ctr), k);
+		hwaes_ctr_inc(ctr);
+		_mm_storeu_si128((__m128i *) buf, _mm_xor_si128(b, _mm_loadu_si128((const __m128i *) buf)));
+	}
+}
+
+HWAES_FUNC
+static void hwaes_cbc_enc(const u8 *keys, u8 *buf, u32 nb_blocks, u8 *iv)
+{
+	u32 i;
+	__m128i k[HWAES_ROUNDS+1];
+	__m128i c = _mm_loadu_si128((const __m128i *) iv);
+	HWAES_LOAD_KEYS(k, keys)
+	for (; nb_blocks; nb_blocks--, buf+=HWAES_BLOCK) {
+		c = hwaes_enc1(_mm_xor_si128(c, _mm_loadu_si128((const __m128i *) buf)), k);
+		_mm_storeu_si128((__m128i *) buf, c);
+	}
+	_mm_storeu_si128((__m128i *) iv, c);
+}
+
+//CBC decryption is parallel, each block is xored with the previous ciphertext block
+HWAES_FUNC
+static void hwaes_cbc_dec(const u8 *keys, u8 *buf, u32 nb_blocks, u8 *iv)
+{
+	u32 i, r;
+	u8 prev[8*HWAES_BLOCK+HWAES_BLOCK];
+	__m128i k[HWAES_ROUNDS+1];
+	HWAES_LOAD_KEYS(k, keys)
+	memcpy(prev, iv, HWAES_BLOCK);
+	for (; nb_blocks>=8; nb_blocks-=8, buf+=8*HWAES_BLOCK) {
+		__m128i b0, b1, b2, b3, b4, b5, b6, b7;
+		memcpy(prev+HWAES_BLOCK, buf, 8*HWAES_BLOCK);
+		HWAES_LOAD8(buf)
+		HWAES_CIPHER8(_mm_aesdec_si128, _mm_aesdeclast_si128, k)
+		HWAES_XOR_STORE8(buf, prev)
+		memcpy(prev, prev + 8*HWAES_BLOCK, HWAES_BLOCK);
+	}
+	for (; nb_blocks; nb_blocks--, buf+=HWAES_BLOCK) {
+		__m128i c = _mm_loadu_si128((const __m128i *) buf);
+		__m128i b = hwaes_dec1(c, k);
+		_mm_storeu_si128((__m128i *) buf, _mm_xor_si128(b, _mm_loadu_si128((const __m128i *) prev)));
+		_mm_storeu_si128((__m128i *) prev, c);
+	}
+	memcpy(iv, prev, HWAES_BLOCK);
+}
+
+#else //GPAC_HAS_ARMV8_AES
+
+static Bool hwaes_cpu_supported(void)
+{
+	return GF_TRUE;
+}
+
+static u32 hwaes_sub_word(u32 w)
+{
+	//all lanes hold the word so that ShiftRows has no effect, zero round key
+	uint8x16_t b = vaeseq_u8(vreinterpretq_u8_u32(vdupq_n_u32(w)), vdupq_n_u8(0));
+	return vgetq_lane_u32(vreinterpretq_u32_u8(b), 0);
+}
+
+static void hwaes_inv_mix_columns(u8 *dst, const u8 *src)
+{
+	vst1q_u8(dst, vaesimcq_u8(vld1q_u8(src)));
+}
+
+static GFINLINE uint8x16_t hwaes_enc1(uint8x16_t b, const uint8x16_t *k)
+{
+	u32 r;
+	for (r=0; r<HWAES_ROUNDS-1; r++) b = vaesmcq_u8(vaeseq_u8(b, k[r]));
+	b = vaeseq_u8(b, k[HWAES_ROUNDS-1]);
+	return veorq_u8(b, k[HWAES_ROUNDS]);
+}
+
+static GFINLINE uint8x16_t hwaes_dec1(uint8x16_t b, const uint8x16_t *k)
+{
+	u32 r;
+	for (r=0; r<HWAES_ROUNDS-1; r++) b = vaesimcq_u8(vaesdq_u8(b, k[r]));
+	b = vaesdq_u8(b, k[HWAES_ROUNDS-1]);
+	return veorq_u8(b, k[HWAES_ROUNDS]);
+}
+
+static GFINLINE void hwaes_load_keys(uint8x16_t *k, const u8 *keys)
+{
+	u32 i;
+	for (i=0; i<=HWAES_ROUNDS; i++) k[i] = vld1q_u8(keys + i*HWAES_BLOCK);
+}
+
+static void hwaes_ecb(const u8 *keys, u8 *buf, u32 nb_blocks, Bool decrypt)
+{
+	uint8x16_t k[HWAES_ROUNDS+1];
+	hwaes_load_keys(k, keys);
+	for (; nb_blocks; nb_blocks--, buf+=HWAES_BLOCK) {
+		uint8x16_t b = vld1q_u8(buf);
+		vst1q_u8(buf, decrypt ? hwaes_dec1(b, k) : hwaes_enc1(b, k));
+	}
+}
+
+//4 blocks interleaved
+static void hwaes_ctr(const u8 *keys, u8 *buf, u32 nb_blocks, u8 *ctr)
+{
+	uint8x16_t k[HWAES_ROUNDS+1];
+	hwaes_load_keys(k, keys);
+	for (; nb_blocks>=4; nb_blocks-=4, buf+=4*HWAES_BLOCK) {
+		uint8x16_t b0, b1, b2, b3;
+		b0 = vld1q_u8(ctr); hwaes_ctr_inc(ctr);
+		b1 = vld1q_u8(ctr); hwaes_ctr_inc(ctr);
+		b2 = vld1q_u8(ctr); hwaes_ctr_inc(ctr);
+		b3 = vld1q_u8(ctr); hwaes_ctr_inc(ctr);
+		b0 = hwaes_enc1(b0, k);
+		b1 = hwaes_enc1(b1, k);
+		b2 = hwaes_enc1(b2, k);
+		b3 = hwaes_enc1(b3, k);
+		vst1q_u8(buf, veorq_u8(b0, vld1q_u8(buf)));
+		vst1q_u8(buf+16, veorq_u8(b1, vld1q_u8(buf+16)));
+		vst1q_u8(buf+32, veorq_u8(b2, vld1q_u8(buf+32)));
+		vst1q_u8(buf+48, veorq_u8(b3, vld1q_u8(buf+48)));
+	}
+	for (; nb_blocks; nb_blocks--, buf+=HWAES_BLOCK) {
+		uint8x16_t b = hwaes_enc1(vld1q_u8(ctr), k);
+		hwaes_ctr_inc(ctr);
+		vst1q_u8(buf, veorq_u8(b, vld1q_u8(buf)));
+	}
+}
+
+static void hwaes_cbc_enc(const u8 *keys, u8 *buf, u32 nb_blocks, u8 *iv)
+{
+	uint8x16_t k[HWAES_ROUNDS+1];
+	uint8x16_t c = vld1q_u8(iv);
+	hwaes_load_keys(k, keys);
+	for (; nb_blocks; nb_blocks--, buf+=HWAES_BLOCK) {
+		c = hwaes_enc1(veorq_u8(c, vld1q_u8(buf)), k);
+		vst1q_u8(buf, c);
+	}
+	vst1q_u8(iv, c);
+}
+
+static void hwaes_cbc_dec(const u8 *keys, u8 *buf, u32 nb_blocks, u8 *iv)
+{
+	uint8x16_t k[HWAES_ROUNDS+1];
+	uint8x16_t prev = vld1q_u8(iv);
+	hwaes_load_keys(k, keys);
+	for (; nb_blocks; nb_blocks--, buf+=HWAES_BLOCK) {
+		uint8x16_t c = vld1q_u8(buf);
+		vst1q_u8(buf, veorq_u8(hwaes_dec1(c, k), prev));
+		prev = c;
+	}
+	vst1q_u8(iv, prev);
+}
+
+#endif //GPAC_HAS_ARMV8_AES
+
+
+static void hwaes_set_key(GF_Crypt *td, void *key)
+{
+	u32 i;
+	u8 *w;
+	u8 rcon = 1;
+	HWAESCtx *ctx = (HWAESCtx *)td->context;
+	if (!ctx || !key) return;
+
+	//FIPS-197 key expansion, 4-byte words
+	w = ctx->rk;
+	memcpy(w, key, HWAES_BLOCK);
+	for (i=4; i<4*(HWAES_ROUNDS+1); i++) {
+		u32 j;
+		u8 t[4];
+		memcpy(t, w + 4*(i-1), 4);
+		if (!(i%4)) {
+			u32 v;
+			//RotWord then SubWord
+			u8 rot[4];
+			rot[0] = t[1];
+			rot[1] = t[2];
+			rot[2] = t[3];
+			rot[3] = t[0];
+			memcpy(&v, rot, 4);
+			v = hwaes_sub_word(v);
+			memcpy(t, &v, 4);
+			t[0] ^= rcon;
+			rcon = (rcon<<1) ^ ((rcon & 0x80) ? 0x1B : 0);
+		}
+		for (j=0; j<4; j++)
+			w[4*i+j] = w[4*(i-4)+j] ^ t[j];
+	}
+	if (td->mode == GF_CTR) return;
+
+	memcpy(ctx->dk, ctx->rk + HWAES_ROUNDS*HWAES_BLOCK, HWAES_BLOCK);
+	for (i=1; i<HWAES_ROUNDS; i++)
+		hwaes_inv_mix_columns(ctx->dk + i*HWAES_BLOCK, ctx->rk + (HWAES_ROUNDS-i)*HWAES_BLOCK);
+	memcpy(ctx->dk + HWAES_ROUNDS*HWAES_BLOCK, ctx->rk, HWAES_BLOCK);
+}
+
+static GF_Err hwaes_init(GF_Crypt *td, void *key, const void *iv)
+{
+	HWAESCtx *ctx = (HWAESCtx *)td->context;
+	if (!ctx) {
+		GF_SAFEALLOC(ctx, HWAESCtx);
+		if (ctx == NULL) return GF_OUT_OF_MEM;
+		td->context = ctx;
+	}
+	ctx->counter_pos = 0;
+	if (iv) memcpy(ctx->iv, iv, HWAES_BLOCK);
+	hwaes_set_key(td, key);
+	return GF_OK;
+}
+
+static void hwaes_deinit(GF_Crypt *td)
+{
+}
+
+static GF_Err hwaes_get_state(GF_Crypt *td, u8 *iv, u32 *iv_size)
+{
+	HWAESCtx *ctx = (HWAESCtx *)td->context;
+	if (td->mode == GF_CTR) {
+		*iv_size = HWAES_BLOCK + 1;
+		iv[0] = ctx->counter_pos;
+		memcpy(iv+1, ctx->iv, HWAES_BLOCK);
+	} else if (td->mode == GF_CBC) {
+		*iv_size = HWAES_BLOCK;
+		memcpy(iv, ctx->iv, HWAES_BLOCK);
+	} else {
+		*iv_size = HWAES_BLOCK;
+		memset(iv, 0, HWAES_BLOCK);
+	}
+	return GF_OK;
+}
+
+static GF_Err hwaes_set_state(GF_Crypt *td, const u8 *iv, u32 iv_size)
+{
+	HWAESCtx *ctx = (HWAESCtx *)td->context;
+	if (td->mode == GF_ECB) return GF_OK;
+	if (iv_size > HWAES_BLOCK) {
+		s32 i;
+		if ((td->mode != GF_CTR) || (iv[0] >= HWAES_BLOCK)) return GF_BAD_PARAM;
+		ctx->counter_pos = iv[0];
+		memcpy(ctx->iv, iv+1, HWAES_BLOCK);
+		if (!ctx->counter_pos) return GF_OK;
+		//regenerate keystream of the block preceding the counter
+		memcpy(ctx->ks, ctx->iv, HWAES_BLOCK);
+		for (i=HWAES_BLOCK-1; i>=0; i--) {
+			ctx->ks[i]--;
+			if (ctx->ks[i] != 0xFF) break;
+		}
+		hwaes_ecb(ctx->rk, ctx->ks, 1, GF_FALSE);
+		return GF_OK;
+	}
+	if (iv_size < HWAES_BLOCK) return GF_BAD_PARAM;
+	memcpy(ctx->iv, iv, HWAES_BLOCK);
+	ctx->counter_pos = 0;
+	return GF_OK;
+}
+
+static GF_Err hwaes_crypt_ctr(GF_Crypt *td, u8 *buf, u32 len)
+{
+	u32 nb_blocks;
+	HWAESCtx *ctx = (HWAESCtx *)td->context;
+
+	while (len && ctx->counter_pos) {
+		*buf++ ^= ctx->ks[HWAES_BLOCK - ctx->counter_pos];
+		ctx->counter_pos--;
+		len--;
+	}
+	nb_blocks = len / HWAES_BLOCK;
+	if (nb_blocks) {
+		hwaes_ctr(ctx->rk, buf, nb_blocks, ctx->iv);
+		buf += nb_blocks * HWAES_BLOCK;
+		len -= nb_blocks * HWAES_BLOCK;
+	}
+	if (len) {
+		u32 i;
+		memcpy(ctx->ks, ctx->iv, HWAES_BLOCK);
+		hwaes_ctr_inc(ctx->iv);
+		hwaes_ecb(ctx->rk, ctx->ks, 1, GF_FALSE);
+		for (i=0; i<len; i++) buf[i] ^= ctx->ks[i];
+		ctx->counter_pos = HWAES_BLOCK - len;
+	}
+	return GF_OK;
+}
+
+static GF_Err hwaes_encrypt_cbc(GF_Crypt *td, u8 *buf, u32 len)
+{
+	HWAESCtx *ctx = (HWAESCtx *)td->context;
+	hwaes_cbc_enc(ctx->rk, buf, len / HWAES_BLOCK, ctx->iv);
+	return GF_OK;
+}
+
+static GF_Err hwaes_decrypt_cbc(GF_Crypt *td, u8 *buf, u32 len)
+{
+	HWAESCtx *ctx = (HWAESCtx *)td->context;
+	hwaes_cbc_dec(ctx->dk, buf, len / HWAES_BLOCK, ctx->iv);
+	return GF_OK;
+}
+
+static GF_Err hwaes_encrypt_ecb(GF_Crypt *td, u8 *buf, u32 len)
+{
+	HWAESCtx *ctx = (HWAESCtx *)td->context;
+	if (len % HWAES_BLOCK) return GF_BAD_PARAM;
+	hwaes_ecb(ctx->rk, buf, len / HWAES_BLOCK, GF_FALSE);
+	return GF_OK;
+}
+
+static GF_Err hwaes_decrypt_ecb(GF_Crypt *td, u8 *buf, u32 len)
+{
+	HWAESCtx *ctx = (HWAESCtx *)td->context;
+	if (len % HWAES_BLOCK) return GF_BAD_PARAM;
+	hwaes_ecb(ctx->dk, buf, len / HWAES_BLOCK, GF_TRUE);
+	return GF_OK;
+}
+
+GF_Err gf_crypt_open_open_hw(GF_Crypt* td, GF_CRYPTO_MODE mode)
+{
+	static s32 cpu_ok = -1;
+	if (cpu_ok<0) {
+		cpu_ok = hwaes_cpu_supported() ? 1 : 0;
+		if (cpu_ok) {
+			GF_LOG(GF_LOG_DEBUG, GF_LOG_CORE, ("[Crypto] Using hardware AES\n"));
+		}
+	}
+	if (!cpu_ok) return GF_NOT_SUPPORTED;
+
+	td->mode = mode;
+	td->_init_crypt = hwaes_init;
+	td->_deinit_crypt = hwaes_deinit;
+	td->_set_key = hwaes_set_key;
+	td->_get_state = hwaes_get_state;
+	td->_set_state = hwaes_set_state;
+	switch (mode) {
+	case GF_CBC:
+		td->_crypt = hwaes_encrypt_cbc;
+		td->_decrypt = hwaes_decrypt_cbc;
+		break;
+	case GF_CTR:
+		td->_crypt = hwaes_crypt_ctr;
+		td->_decrypt = hwaes_crypt_ctr;
+		break;
+	case GF_ECB:
+		td->_crypt = hwaes_encrypt_ecb;
+		td->_decrypt = hwaes_decrypt_ecb;
+		break;
+	default:
+		return GF_BAD_PARAM;
+	}
+	td->algo = GF_AES_128;
+	return GF_OK;
+}
+
+#else
+
+GF_Err gf_crypt_open_open_hw(GF_Crypt* td, GF_CRYPTO_MODE mode)
+{
+	return GF_NOT_SUPPORTED;
+}
+
+#endif //defined(GPAC_HAS_AESNI) || defined(GPAC_HAS_ARMV8_AES)
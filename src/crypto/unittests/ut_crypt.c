@@ -0,0 +1,170 @@
+#include "tests.h"
+#include <gpac/crypt.h>
+
+#ifndef GPAC_DISABLE_CRYPTO
+
+#define UTC_SIZE	(1<<16)
+
+static GF_Crypt *utc_open(GF_CRYPTO_MODE mode, Bool sw, u8 *key, u8 *iv)
+{
+	GF_Crypt *gc;
+	gf_opts_set_key("temp", "no-hwaes", sw ? "yes" : NULL);
+	gc = gf_crypt_open(GF_AES_128, mode);
+	gf_opts_set_key("temp", "no-hwaes", NULL);
+	if (gc) gf_crypt_init(gc, key, iv);
+	return gc;
+}
+
+unittest(crypt_aes_fips197)
+{
+	u32 i;
+	u8 key[16], block[16];
+	const u8 pt[16] = {0x00,0x11,0x22,0x33,0x44,0x55,0x66,0x77,0x88,0x99,0xaa,0xbb,0xcc,0xdd,0xee,0xff};
+	const u8 ct[16] = {0x69,0xc4,0xe0,0xd8,0x6a,0x7b,0x04,0x30,0xd8,0xcd,0xb7,0x80,0x70,0xb4,0xc5,0x5a};
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	for (i=0; i<16; i++) key[i] = i;
+	//hardware (if available) then software AES
+	for (i=0; i<2; i++) {
+		GF_Crypt *gc = utc_open(GF_ECB, i ? GF_TRUE : GF_FALSE, key, NULL);
+		assert_not_null(gc);
+		memcpy(block, pt, 16);
+		assert_equal(gf_crypt_encrypt(gc, block, 16), GF_OK);
+		assert_equal_mem(block, ct, 16);
+		assert_equal(gf_crypt_decrypt(gc, block, 16), GF_OK);
+		assert_equal_mem(block, pt, 16);
+		gf_crypt_close(gc);
+	}
+	gf_sys_close();
+}
+
+//encrypt in random chunks with both implementations, compare output and state
+static Bool utc_compare(GF_CRYPTO_MODE mode, u8 *key, u8 *iv, u8 *data, u32 size, u32 pattern_crypt, u32 pattern_skip)
+{
+	u32 i, pos=0;
+	Bool same = GF_TRUE;
+	u8 *buf[2];
+	GF_Crypt *gc[2];
+	for (i=0; i<2; i++) {
+		gc[i] = utc_open(mode, i ? GF_TRUE : GF_FALSE, key, iv);
+		buf[i] = gf_malloc(size);
+		memcpy(buf[i], data, size);
+	}
+	while (pos<size) {
+		u32 len = 1 + gf_rand() % 4000;
+		if (mode!=GF_CTR) len = 16 * (1 + len/16);
+		//patterns restart at each call
+		if (pattern_crypt) len = size;
+		if (pos+len > size) len = size-pos;
+		for (i=0; i<2; i++) {
+			if (pattern_crypt)
+				gf_crypt_encrypt_pattern(gc[i], buf[i]+pos, len, pattern_crypt, pattern_skip);
+			else
+				gf_crypt_encrypt(gc[i], buf[i]+pos, len);
+		}
+		pos += len;
+		if (mode!=GF_ECB) {
+			u8 state[2][17];
+			u32 state_size[2] = {17, 17};
+			for (i=0; i<2; i++) gf_crypt_get_IV(gc[i], state[i], &state_size[i]);
+			if (state_size[0] != state_size[1]) same = GF_FALSE;
+			//CTR: next counter block, counter position semantics differ between openSSL and tiny-AES
+			else if (mode==GF_CTR) {
+				if (memcmp(state[0]+1, state[1]+1, 16) || (!state[0][0] != !state[1][0])) same = GF_FALSE;
+			} else if (memcmp(state[0], state[1], state_size[0])) same = GF_FALSE;
+		}
+	}
+	if (memcmp(buf[0], buf[1], size)) same = GF_FALSE;
+	if (!memcmp(buf[0], data, size)) same = GF_FALSE;
+
+	//decrypt with reset state
+	for (i=0; i<2; i++) {
+		if (mode==GF_CTR) {
+			u8 ctr_iv[17];
+			ctr_iv[0] = 0;
+			memcpy(ctr_iv+1, iv, 16);
+			gf_crypt_set_IV(gc[i], ctr_iv, 17);
+		} else if (iv) {
+			gf_crypt_set_IV(gc[i], iv, 16);
+		}
+		if (pattern_crypt)
+			gf_crypt_decrypt_pattern(gc[i], buf[i], size, pattern_crypt, pattern_skip);
+		else
+			gf_crypt_decrypt(gc[i], buf[i], size);
+		if (memcmp(buf[i], data, size)) same = GF_FALSE;
+		gf_crypt_close(gc[i]);
+		gf_free(buf[i]);
+	}
+	return same;
+}
+
+unittest(crypt_aes_hw_exact)
+{
+	u32 i, j;
+	u8 key[16], iv[16];
+	u8 *data;
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	data = gf_malloc(UTC_SIZE);
+	for (i=0; i<UTC_SIZE; i++) data[i] = gf_rand();
+	for (j=0; j<4; j++) {
+		for (i=0; i<16; i++) {
+			key[i] = gf_rand();
+			iv[i] = gf_rand();
+		}
+		//counter wrapping over several bytes
+		if (j==1) memset(iv+12, 0xFF, 4);
+		if (j==2) memset(iv, 0xFF, 16);
+
+		assert_true(utc_compare(GF_CTR, key, iv, data, UTC_SIZE - j, 0, 0));
+		assert_true(utc_compare(GF_CBC, key, iv, data, UTC_SIZE, 0, 0));
+		assert_true(utc_compare(GF_ECB, key, NULL, data, UTC_SIZE, 0, 0));
+		//cbcs and cens patterns
+		assert_true(utc_compare(GF_CBC, key, iv, data, UTC_SIZE, 1, 9));
+		assert_true(utc_compare(GF_CTR, key, iv, data, UTC_SIZE, 5, 5));
+	}
+	gf_free(data);
+	gf_sys_close();
+}
+
+unittest(crypt_aes_ctr_state)
+{
+	u32 i, j, size=17;
+	u8 key[16], iv[16], state[17];
+	u8 ref[100], buf[100], dummy[16];
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	for (i=0; i<16; i++) {
+		key[i] = gf_rand();
+		iv[i] = gf_rand();
+	}
+	//no carry when seeking
+	iv[15] &= 0x7F;
+	for (j=0; j<2; j++) {
+		GF_Crypt *gc = utc_open(GF_CTR, j ? GF_TRUE : GF_FALSE, key, iv);
+		assert_not_null(gc);
+		memset(ref, 0, 100);
+		memset(buf, 0, 100);
+		gf_crypt_encrypt(gc, ref, 100);
+
+		//in the middle of a block, the counter is the next block
+		gf_crypt_init(gc, key, iv);
+		gf_crypt_encrypt(gc, buf, 37);
+		gf_crypt_get_IV(gc, state, &size);
+		assert_equal(size, 17);
+		assert_true(state[0] != 0);
+		//seek to byte 37 as done for ISMA: counter of block 2 and skip 5 bytes
+		state[0] = 0;
+		memcpy(state+1, iv, 16);
+		state[16] += 2;
+		gf_crypt_init(gc, key, iv);
+		assert_equal(gf_crypt_set_IV(gc, state, 17), GF_OK);
+		gf_crypt_encrypt(gc, dummy, 5);
+		gf_crypt_encrypt(gc, buf+37, 63);
+		assert_equal_mem(buf, ref, 100);
+		gf_crypt_close(gc);
+	}
+	gf_sys_close();
+}
+
+#endif //GPAC_DISABLE_CRYPTO
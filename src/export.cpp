@@ -98,6 +98,8 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_get_user_name) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_enum_directory) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_file_load_data) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_mmap) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_munmap) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dynstrcat) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_parse_lfrac) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_parse_frac) )
@@ -127,6 +129,19 @@
 #endif
 
 #pragma comment (linker, EXPORT_SYMBOL(gf_fsize) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_block_size) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_insert_range) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_copy_range) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_fd_copy_range) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_aio_new) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_aio_del) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_aio_backend) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_aio_write) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_aio_read) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_aio_sync) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_aio_close) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_aio_get_done) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_aio_pending) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fileio_new) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fileio_del) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fileio_get_udta) )
@@ -137,6 +152,9 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_fileio_tag_main_thread) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fileio_is_main_thread) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_fileio_set_write_state) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_mem_new) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_mem_get_data) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_file_mem_reset) )
 
 #pragma comment (linker, EXPORT_SYMBOL(gf_set_progress) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_set_progress_callback) )
@@ -207,6 +225,7 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_mixer_lock) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_mixer_add_input) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_mixer_get_output) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_mixer_set_resampler) )
 #endif
 
 
@@ -273,6 +292,8 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_bs_get_bit_position) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_bs_get_content_no_truncate) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_bs_read_vluimsbf5) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_bs_read_ue) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_bs_read_se) )
 
 #pragma comment (linker, EXPORT_SYMBOL(gf_bs_read_u16_le) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_bs_read_u32_le) )
@@ -294,6 +315,9 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_th_status) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_th_set_priority) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_th_id) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_th_set_affinity) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_th_get_numa_cpus) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_th_parse_cpu_list) )
 
 /* Lock */
 #pragma comment (linker, EXPORT_SYMBOL(gf_mx_new) )
@@ -331,6 +355,20 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_sk_is_multicast_address) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_sk_receive_no_select) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_sk_set_usec_wait) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sk_group_new) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sk_group_del) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sk_group_register) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sk_group_unregister) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sk_group_select) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sk_group_sock_is_set) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sk_group_enum_ready) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sk_group_set_write_pending) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sk_set_udta) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sk_get_udta) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sk_send_file) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sk_send_batch) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sk_set_pacing_rate) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_sk_receive_batch) )
 
 #pragma comment (linker, EXPORT_SYMBOL(gf_url_is_local) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_url_get_absolute_path) )
@@ -454,6 +492,7 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_sess_get_stats) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_sess_get_utc_start) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_sess_fetch_data) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_dm_sess_send_file) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_sess_last_error) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_sess_get_resource_name) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_sess_mime_type) )
@@ -789,6 +828,10 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_new_xml_subtitle_description) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_xml_subtitle_get_description) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_open_progressive) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_isom_open_lazy) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_isom_get_lazy_fragments) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_isom_lazy_load_next) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_isom_lazy_seek) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_get_missing_bytes) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_freeze_order) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_set_inplace_padding) )
@@ -1239,6 +1282,7 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_start_segment) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_close_segment) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_set_traf_base_media_decode_time) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_isom_enable_mfra) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_set_next_moof_number) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_isom_get_next_moof_number) )
 #endif
@@ -1258,11 +1302,15 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_send_au) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_send_au_with_sn) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_send_data) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_set_send_batch) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_flush) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_format_sdp_header) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_disable_auto_rtcp) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_send_rtcp) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_get_payload_type) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_set_interleave_callbacks) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_set_packet_callback) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_rtp_streamer_new_channel) )
 
 #endif
 
@@ -1384,12 +1432,17 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_reset_buffers) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_read_rtp) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_read_rtcp) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_rtp_set_recv_batch) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_rtp_read_pending) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_decode_rtp) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_decode_rtcp) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_send_rtcp_report) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_rtp_send_rtcp_sr) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_set_loss_rate) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_send_bye) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_send_packet) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_rtp_set_send_batch) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_rtp_flush_send_batch) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_is_unicast) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_is_interleaved) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_rtp_get_clockrate) )
@@ -1548,6 +1601,8 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_crypt_set_key) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_crypt_set_IV) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_crypt_get_IV) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_crypt_encrypt_pattern) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_crypt_decrypt_pattern) )
 #endif GPAC_DISABLE_CRYPTO
 
 #pragma comment (linker, EXPORT_SYMBOL(gf_sha1_csum) )
@@ -2085,6 +2140,7 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_program_stream_add) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_mux_update_config) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_mux_process) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_mux_process_batch) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_get_sys_clock) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_get_ts_clock) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_m2ts_mux_use_single_au_pes_mode) )
@@ -2308,6 +2364,7 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_route_dmx_del) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_route_atsc3_tune_in) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_route_dmx_process) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_route_set_recv_batch) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_route_dmx_get_object_count) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_route_dmx_remove_object_by_name) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_route_dmx_remove_first_object) )
@@ -2323,6 +2380,7 @@
 
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_add_cache_entry) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_force_headers) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_dm_get_cache_stats) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_dm_set_localcache_provider) )
 
 /*filter session exports*/
@@ -2556,6 +2614,9 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_pck_ref_props ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_pck_unref ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_pck_get_data ) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_filter_pck_get_data_size ) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_filter_pck_get_segment_count ) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_filter_pck_get_segment ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_pck_set_property ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_pck_set_property_str ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_pck_set_property_dyn ) )
@@ -2604,6 +2665,9 @@
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_pck_new_shared_internal ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_pck_new_shared ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_pck_new_ref ) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_filter_pck_new_segmented ) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_filter_pck_append_segment ) )
+#pragma comment (linker, EXPORT_SYMBOL(gf_filter_pck_append_segment_data ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_pck_new_ref_destructor ) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_pck_new_frame_interface) )
 #pragma comment (linker, EXPORT_SYMBOL(gf_filter_pck_forward ) )
@@ -36,6 +36,152 @@ static void gf_filter_pck_reset_props(GF_FilterPacket *pck, GF_FilterPid *pid)
 	pck->session = pid->filter->session;
 }
 
+//copy segments into the packet data buffer
+static void gf_filter_pck_flatten(GF_FilterPacket *pck)
+{
+	u32 i, pos=0;
+	if (pck->seg_flat) return;
+	if (pck->alloc_size < pck->data_length) {
+		u8 *data = gf_realloc(pck->data, pck->data_length);
+		if (!data) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Failed to allocate %d bytes for segmented packet data\n", pck->data_length));
+			pck->data_length = 0;
+			return;
+		}
+		pck->data = data;
+		pck->alloc_size = pck->data_length;
+	}
+	for (i=0; i<pck->nb_segs; i++) {
+		GF_FilterPacketSegment *seg = &pck->segs[i];
+		const u8 *src = seg->ref ? (const u8 *) seg->ref->data : pck->seg_inline;
+		memcpy(pck->data + pos, src + seg->offset, seg->size);
+		pos += seg->size;
+	}
+	pck->seg_flat = 1;
+}
+
+static void gf_filter_pck_reset_segments(GF_FilterPacket *pck)
+{
+	u32 i;
+	for (i=0; i<pck->nb_segs; i++) {
+		GF_FilterPacket *ref = pck->segs[i].ref;
+		if (!ref) continue;
+		//cf gf_filter_packet_destroy for references
+		safe_int_dec(&ref->pid->nb_shared_packets_out);
+		safe_int_dec(&ref->pid->filter->nb_shared_packets_out);
+		gf_assert(ref->reference_count);
+		if (safe_int_dec(&ref->reference_count) == 0) {
+			gf_filter_packet_destroy(ref);
+		}
+	}
+	gf_free(pck->segs);
+	pck->segs = NULL;
+	pck->nb_segs = pck->alloc_segs = 0;
+	if (pck->seg_inline) gf_free(pck->seg_inline);
+	pck->seg_inline = NULL;
+	pck->seg_inline_size = pck->seg_inline_alloc = 0;
+	pck->seg_flat = 0;
+}
+
+static GF_FilterPacketSegment *gf_filter_pck_push_segment(GF_FilterPacket *pck)
+{
+	if (pck->nb_segs == pck->alloc_segs) {
+		u32 alloc_segs = pck->alloc_segs ? 2*pck->alloc_segs : 8;
+		GF_FilterPacketSegment *segs = gf_realloc(pck->segs, sizeof(GF_FilterPacketSegment) * alloc_segs);
+		if (!segs) return NULL;
+		pck->segs = segs;
+		pck->alloc_segs = alloc_segs;
+	}
+	pck->nb_segs++;
+	return &pck->segs[pck->nb_segs-1];
+}
+
+static GF_Err gf_filter_pck_add_segment_data(GF_FilterPacket *pck, const u8 *data, u32 size)
+{
+	GF_FilterPacketSegment *seg;
+	if (!size) return GF_OK;
+	if (pck->seg_inline_size + size > pck->seg_inline_alloc) {
+		u32 alloc = MAX(2*pck->seg_inline_alloc, pck->seg_inline_size + size);
+		u8 *seg_inline = gf_realloc(pck->seg_inline, alloc);
+		if (!seg_inline) return GF_OUT_OF_MEM;
+		pck->seg_inline = seg_inline;
+		pck->seg_inline_alloc = alloc;
+	}
+	memcpy(pck->seg_inline + pck->seg_inline_size, data, size);
+	seg = pck->nb_segs ? &pck->segs[pck->nb_segs-1] : NULL;
+	//merge with previous inline bytes
+	if (!seg || seg->ref || (seg->offset + seg->size != pck->seg_inline_size)) {
+		seg = gf_filter_pck_push_segment(pck);
+		if (!seg) return GF_OUT_OF_MEM;
+		seg->ref = NULL;
+		seg->offset = pck->seg_inline_size;
+		seg->size = 0;
+	}
+	seg->size += size;
+	pck->seg_inline_size += size;
+	pck->data_length += size;
+	return GF_OK;
+}
+
+static GF_Err gf_filter_pck_add_segment(GF_FilterPacket *pck, GF_FilterPacket *reference, u32 data_offset, u32 data_size)
+{
+	GF_FilterPacketSegment *seg;
+	reference = reference->pck;
+	if (data_offset > reference->data_length) return GF_BAD_PARAM;
+	if (!data_size) data_size = reference->data_length - data_offset;
+	if (data_offset + data_size > reference->data_length) return GF_BAD_PARAM;
+	if (!data_size) return GF_OK;
+
+	//reference the segments of a segmented packet
+	if (reference->segs) {
+		u32 i, pos=0;
+		for (i=0; (i<reference->nb_segs) && data_size; i++) {
+			GF_Err e;
+			u32 start, len;
+			GF_FilterPacketSegment *rseg = &reference->segs[i];
+			if (pos + rseg->size <= data_offset) {
+				pos += rseg->size;
+				continue;
+			}
+			start = (data_offset > pos) ? data_offset - pos : 0;
+			len = MIN(rseg->size - start, data_size);
+			if (rseg->ref)
+				e = gf_filter_pck_add_segment(pck, rseg->ref, rseg->offset + start, len);
+			else
+				e = gf_filter_pck_add_segment_data(pck, reference->seg_inline + rseg->offset + start, len);
+			if (e) return e;
+			data_offset += len;
+			data_size -= len;
+			pos += rseg->size;
+		}
+		return GF_OK;
+	}
+	if (!reference->data) return GF_BAD_PARAM;
+
+	seg = pck->nb_segs ? &pck->segs[pck->nb_segs-1] : NULL;
+	//contiguous range in the same packet
+	if (seg && (seg->ref == reference) && (seg->offset + seg->size == data_offset)) {
+		seg->size += data_size;
+		pck->data_length += data_size;
+		return GF_OK;
+	}
+	seg = gf_filter_pck_push_segment(pck);
+	if (!seg) return GF_OUT_OF_MEM;
+	seg->ref = reference;
+	seg->offset = data_offset;
+	seg->size = data_size;
+	pck->data_length += data_size;
+
+	//cf gf_filter_pck_new_ref for these
+	gf_assert(reference->reference_count);
+	safe_int_inc(&reference->reference_count);
+	safe_int_inc(&reference->pid->nb_shared_packets_out);
+	safe_int_inc(&reference->pid->filter->nb_shared_packets_out);
+	if (reference->info.flags & GF_PCKF_FORCE_MAIN)
+		pck->info.flags |= GF_PCKF_FORCE_MAIN;
+	return GF_OK;
+}
+
 GF_EXPORT
 GF_Err gf_filter_pck_merge_properties_filter(GF_FilterPacket *pck_src, GF_FilterPacket *pck_dst, gf_filter_prop_filter filter_prop, void *cbk)
 {
@@ -197,6 +343,50 @@ GF_FilterPacket *gf_filter_pck_new_alloc(GF_FilterPid *pid, u32 data_size, u8 **
 	return gf_filter_pck_new_alloc_internal(pid, data_size, data);
 }
 
+static GF_FilterPacket *gf_filter_pck_new_segmented_internal(GF_FilterPid *pid, u32 nb_segs_hint)
+{
+	GF_FilterPacket *pck = gf_filter_pck_new_alloc_internal(pid, 0, NULL);
+	if (!pck) return NULL;
+	pck->alloc_segs = MAX(nb_segs_hint, 1);
+	pck->segs = gf_malloc(sizeof(GF_FilterPacketSegment) * pck->alloc_segs);
+	if (!pck->segs) {
+		gf_filter_pck_discard(pck);
+		return NULL;
+	}
+	return pck;
+}
+
+GF_EXPORT
+GF_FilterPacket *gf_filter_pck_new_segmented(GF_FilterPid *pid)
+{
+	return gf_filter_pck_new_segmented_internal(pid, 0);
+}
+
+static Bool gf_filter_pck_check_segmented(GF_FilterPacket *pck)
+{
+	if (PCK_IS_INPUT(pck) || !pck->src_filter || !pck->segs) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Attempt to add segment to a packet not created by gf_filter_pck_new_segmented or already sent\n"));
+		return GF_FALSE;
+	}
+	return GF_TRUE;
+}
+
+GF_EXPORT
+GF_Err gf_filter_pck_append_segment(GF_FilterPacket *pck, GF_FilterPacket *source_packet, u32 data_offset, u32 data_size)
+{
+	if (!pck || !source_packet) return GF_BAD_PARAM;
+	if (!gf_filter_pck_check_segmented(pck)) return GF_BAD_PARAM;
+	return gf_filter_pck_add_segment(pck, source_packet, data_offset, data_size);
+}
+
+GF_EXPORT
+GF_Err gf_filter_pck_append_segment_data(GF_FilterPacket *pck, const u8 *data, u32 data_size)
+{
+	if (!pck || (!data && data_size)) return GF_BAD_PARAM;
+	if (!gf_filter_pck_check_segmented(pck)) return GF_BAD_PARAM;
+	return gf_filter_pck_add_segment_data(pck, data, data_size);
+}
+
 static GF_FilterPacket *gf_filter_pck_new_dangling_packet(GF_FilterPacket *cached_pck, u32 data_length)
 {
 	GF_FilterPacket *dst;
@@ -328,6 +518,8 @@ static GF_FilterPacket *gf_filter_pck_new_clone_internal(GF_FilterPid *pid, GF_F
 	pcki = (GF_FilterPacketInstance *) pck_source;
 	if (pcki->pck->frame_ifce)
 		return gf_filter_pck_clone_frame_interface(pid, pck_source, data, dangling_packet, cached_pck);
+	if (pcki->pck->segs)
+		gf_filter_pck_flatten(pcki->pck);
 
 	if (force_copy) {
 		max_ref = 2;
@@ -474,6 +666,17 @@ GF_FilterPacket *gf_filter_pck_new_ref_destructor(GF_FilterPid *pid, u32 data_of
 	GF_FilterPacket *pck;
 	if (!reference) return NULL;
 	reference=reference->pck;
+	//reference the segments rather than gathering them
+	if (reference->segs && !reference->seg_flat) {
+		pck = gf_filter_pck_new_segmented_internal(pid, reference->nb_segs);
+		if (!pck) return NULL;
+		if (gf_filter_pck_add_segment(pck, reference, data_offset, data_size) != GF_OK) {
+			gf_filter_pck_discard(pck);
+			return NULL;
+		}
+		pck->destructor = destruct;
+		return pck;
+	}
 
 	if (reference->data) {
 		if (data_offset > reference->data_length)
@@ -546,6 +749,8 @@ GF_Err gf_filter_pck_forward(GF_FilterPacket *reference, GF_FilterPid *pid)
 	GF_FilterPacket *pck;
 	if (!reference) return GF_OUT_OF_MEM;
 	reference=reference->pck;
+	if (reference->segs)
+		gf_filter_pck_flatten(reference);
 	pck = gf_filter_pck_new_shared(pid, NULL, 0, NULL);
 	if (!pck) return GF_OUT_OF_MEM;
 	pck->reference = reference;
@@ -605,6 +810,8 @@ void gf_filter_packet_destroy(GF_FilterPacket *pck)
 	//never set for dangling packets
 	if (pck->destructor) pck->destructor(pid->filter, pid, pck);
 
+	if (pck->segs) gf_filter_pck_reset_segments(pck);
+
 	//never set for dangling packets (theyr are never sent)
 	if (pck->pid_props) {
 		GF_PropertyMap *props = pck->pid_props;
@@ -704,6 +911,7 @@ Bool gf_filter_aggregate_packets(GF_FilterPidInst *dst)
 	u8 *data;
 	GF_FilterPacket *final;
 	u32 i, count;
+	Bool use_segs;
 	GF_FilterPckInfo info;
 
 	//no need to lock the packet list since only the dispatch thread operates on it
@@ -742,7 +950,20 @@ Bool gf_filter_aggregate_packets(GF_FilterPidInst *dst)
 		}
 	}
 
-	final = gf_filter_pck_new_alloc(dst->pid, size, &data);
+	//reference fragments rather than copying them, unless some have no data (frame interface)
+	use_segs = GF_TRUE;
+	for (i=0; i<count; i++) {
+		GF_FilterPacketInstance *pcki = gf_list_get(dst->pck_reassembly, i);
+		if (!pcki->pck->data && !pcki->pck->segs && pcki->pck->data_length) {
+			use_segs = GF_FALSE;
+			break;
+		}
+	}
+	data = NULL;
+	if (use_segs)
+		final = gf_filter_pck_new_segmented_internal(dst->pid, count);
+	else
+		final = gf_filter_pck_new_alloc(dst->pid, size, &data);
 	pos=0;
 
 	for (i=0; i<count; i++) {
@@ -765,8 +986,13 @@ Bool gf_filter_aggregate_packets(GF_FilterPidInst *dst)
 			if (pcki->pck->info.carousel_version_number > info.carousel_version_number)
 				info.carousel_version_number = pcki->pck->info.carousel_version_number;
 		}
-		if (final)
+		if (final && use_segs) {
+			if (gf_filter_pck_add_segment(final, pck, 0, 0)) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Failed to reference packet for fragment aggregation\n"));
+			}
+		} else if (final) {
 			memcpy(data+pos, pcki->pck->data, pcki->pck->data_length);
+		}
 
 		pos += pcki->pck->data_length;
 
@@ -868,6 +1094,9 @@ GF_Err gf_filter_pck_send_internal(GF_FilterPacket *pck, Bool from_filter)
 		GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Attempt to dispatch input packet on output PID in filter %s\n", pck->pid->filter->name));
 		return GF_BAD_PARAM;
 	}
+	//segments are copied upon request by consumers, do it now if several consumers may request it concurrently
+	if (pck->segs && (pid->num_destinations>1))
+		gf_filter_pck_flatten(pck);
 
 	is_cmd_pck = (pck->info.flags & GF_PCK_CMD_MASK);
 
@@ -1470,13 +1699,51 @@ const u8 *gf_filter_pck_get_data(GF_FilterPacket *pck, u32 *size)
 	gf_assert(size);
 	//get true packet pointer
 	pck=pck->pck;
+	if (pck->segs && !pck->seg_flat)
+		gf_filter_pck_flatten(pck);
 	*size = pck->data_length;
 	return (const char *)pck->data;
 }
 
+GF_EXPORT
+u32 gf_filter_pck_get_data_size(GF_FilterPacket *pck)
+{
+	gf_assert(pck);
+	pck=pck->pck;
+	return pck->data_length;
+}
+
+GF_EXPORT
+u32 gf_filter_pck_get_segment_count(GF_FilterPacket *pck)
+{
+	gf_assert(pck);
+	pck=pck->pck;
+	if (pck->segs) return pck->nb_segs;
+	return pck->data ? 1 : 0;
+}
+
+GF_EXPORT
+const u8 *gf_filter_pck_get_segment(GF_FilterPacket *pck, u32 idx, u32 *size)
+{
+	gf_assert(pck);
+	gf_assert(size);
+	pck=pck->pck;
+	*size = 0;
+	if (pck->segs) {
+		GF_FilterPacketSegment *seg;
+		if (idx >= pck->nb_segs) return NULL;
+		seg = &pck->segs[idx];
+		*size = seg->size;
+		if (!seg->ref) return pck->seg_inline + seg->offset;
+		return (const u8 *) seg->ref->data + seg->offset;
+	}
+	if (idx || !pck->data) return NULL;
+	*size = pck->data_length;
+	return (const u8 *) pck->data;
+}
+
 static GF_Err gf_filter_pck_set_property_full(GF_FilterPacket *pck, u32 prop_4cc, const char *prop_name, char *dyn_name, const GF_PropertyValue *value)
 {
-	u32 hash;
 	gf_assert(pck);
 	gf_assert(pck->pid);
 	if (PCK_IS_INPUT(pck)) {
@@ -1485,16 +1752,15 @@ static GF_Err gf_filter_pck_set_property_full(GF_FilterPacket *pck, u32 prop_4cc
 	}
 	//get true packet pointer
 	pck=pck->pck;
-	hash = gf_props_hash_djb2(prop_4cc, prop_name ? prop_name : dyn_name);
 
 	if (!pck->props) {
 		pck->props = gf_props_new(pck->pid->filter);
 	} else {
-		gf_props_remove_property(pck->props, hash, prop_4cc, prop_name ? prop_name : dyn_name);
+		gf_props_remove_property(pck->props, prop_4cc, prop_name ? prop_name : dyn_name);
 	}
 	if (!value) return GF_OK;
 	
-	return gf_props_insert_property(pck->props, hash, prop_4cc, prop_name, dyn_name, value);
+	return gf_props_insert_property(pck->props, prop_4cc, prop_name, dyn_name, value);
 }
 
 GF_EXPORT
@@ -1875,8 +2141,8 @@ GF_Err gf_filter_pck_expand(GF_FilterPacket *pck, u32 nb_bytes_to_add, u8 **data
 		GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Attempt to reallocate an already sent packet in filter %s\n", pck->pid->filter->name));
 		return GF_BAD_PARAM;
 	}
-	if (pck->filter_owns_mem) {
-		GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Attempt to reallocate a shared memory packet in filter %s\n", pck->pid->filter->name));
+	if (pck->filter_owns_mem || pck->segs) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Attempt to reallocate a %s packet in filter %s\n", pck->segs ? "segmented" : "shared memory", pck->pid->filter->name));
 		return GF_BAD_PARAM;
 	}
 	if (!data_start && !new_range_start)
@@ -1910,6 +2176,10 @@ GF_Err gf_filter_pck_truncate(GF_FilterPacket *pck, u32 size)
 		GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Attempt to truncate an already sent packet in filter %s\n", pck->pid->filter->name));
 		return GF_BAD_PARAM;
 	}
+	if (pck->segs) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Attempt to truncate a segmented packet in filter %s\n", pck->pid->filter->name));
+		return GF_BAD_PARAM;
+	}
 	if (pck->data_length > size) pck->data_length = size;
 	return GF_OK;
 }
@@ -1920,6 +2190,7 @@ Bool gf_filter_pck_is_blocking_ref(GF_FilterPacket *pck)
 	pck = pck->pck;
 
 	while (pck) {
+		u32 i;
 		if (pck->frame_ifce) {
 			if (pck->frame_ifce->flags & GF_FRAME_IFCE_BLOCKING)
 				return GF_TRUE;
@@ -1927,6 +2198,11 @@ Bool gf_filter_pck_is_blocking_ref(GF_FilterPacket *pck)
 			if (pck->destructor && pck->filter_owns_mem)
 				return GF_TRUE;
 		}
+		//segments hold references to their source packets
+		for (i=0; i<pck->nb_segs; i++) {
+			if (pck->segs[i].ref && gf_filter_pck_is_blocking_ref(pck->segs[i].ref))
+				return GF_TRUE;
+		}
 		pck = pck->reference;
 	}
 	return GF_FALSE;
@@ -874,6 +874,9 @@ static GF_Err gf_filter_pid_configure(GF_Filter *filter, GF_FilterPid *pid, GF_P
 		} else if (filter->single_source != pidinst->pid->filter) {
 			filter->single_source = NULL;
 		}
+		//keep filters of a connected chain on the NUMA node of the source
+		if (!filter->numa_node && pid->filter->numa_node && !(filter->freg->flags & GF_FS_REG_MAIN_THREAD))
+			filter->numa_node = pid->filter->numa_node;
 		gf_mx_v(filter->tasks_mx);
 
 		//new connection, update caps in case we have events using caps (buffer req) being sent
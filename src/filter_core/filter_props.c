@@ -910,25 +910,34 @@ Bool gf_props_equal_strict(const GF_PropertyValue *p1, const GF_PropertyValue *p
 	return gf_props_equal_internal(p1, p2, GF_TRUE);
 }
 
-#if GF_PROPS_HASHTABLE_SIZE
-GFINLINE u32 gf_props_hash_djb2(u32 p4cc, const char *str)
+static u32 gf_props_builtin_count();
+
+//hash key of a property, 4CC for 4CC properties and djb2 of the name otherwise, mixed so that low bits can be used as index
+static GFINLINE u32 gf_props_hash_key(u32 p4cc, const char *str)
 {
 	u32 hash = 5381;
 
 	if (p4cc) {
-		hash = ((hash << 5) + hash) + ((p4cc>>24)&0xFF);
-		hash = ((hash << 5) + hash) + ((p4cc>>16)&0xFF);
-		hash = ((hash << 5) + hash) + ((p4cc>>8)&0xFF);
-		hash = ((hash << 5) + hash) + (p4cc&0xFF);
-	} else {
+		hash = p4cc;
+	} else if (str) {
 		int c;
 		while ( (c = *str++) )
 			hash = ((hash << 5) + hash) + c; /* hash * 33 + c */
-
 	}
-	return (hash % GF_PROPS_HASHTABLE_SIZE);
+	hash ^= hash >> 16;
+	hash *= 0x85EBCA6B;
+	hash ^= hash >> 13;
+	hash *= 0xC2B2AE35;
+	hash ^= hash >> 16;
+	return hash;
+}
+
+static GFINLINE Bool gf_props_entry_match(const GF_PropertyEntry *p, u32 p4cc, const char *name)
+{
+	if (p4cc) return (p->p4cc==p4cc) ? GF_TRUE : GF_FALSE;
+	if (name && p->pname && !strcmp(p->pname, name)) return GF_TRUE;
+	return GF_FALSE;
 }
-#endif
 
 GF_PropertyMap * gf_props_new(GF_Filter *filter)
 {
@@ -941,10 +950,7 @@ GF_PropertyMap * gf_props_new(GF_Filter *filter)
 		if (!map) return NULL;
 
 		map->session = filter->session;
-#if GF_PROPS_HASHTABLE_SIZE
-#else
 		map->properties = gf_list_new();
-#endif
 	}
 	gf_assert(!map->reference_count);
 	map->reference_count = 1;
@@ -1032,36 +1038,26 @@ void gf_props_del_property(GF_PropertyEntry *it)
 
 void gf_propmap_del(void *pmap)
 {
-#if GF_PROPS_HASHTABLE_SIZE
-	gf_free(pamp);
-#else
 	GF_PropertyMap *map = pmap;
 	gf_list_del(map->properties);
+	if (map->idx_builtin) gf_free(map->idx_builtin);
+	if (map->idx_other) gf_free(map->idx_other);
 	gf_free(map);
-#endif
-
 }
+
 void gf_props_reset(GF_PropertyMap *prop)
 {
-#if GF_PROPS_HASHTABLE_SIZE
-	u32 i;
-	for (i=0; i<GF_PROPS_HASHTABLE_SIZE; i++) {
-		if (prop->hash_table[i]) {
-			GF_List *l = prop->hash_table[i];
-			while (gf_list_count(l)) {
-				gf_props_del_property((GF_PropertyEntry *) gf_list_pop_back(l) );
-			}
-			prop->hash_table[i] = NULL;
-			if (gf_fq_res_add(prop->session->prop_maps_list_reservoir, l)) {
-				gf_list_del(l);
-			}
-		}
-	}
-#else
 	while (gf_list_count(prop->properties)) {
-		gf_props_del_property( (GF_PropertyEntry *) gf_list_pop_back(prop->properties) );
-	}
-#endif
+		GF_PropertyEntry *p = gf_list_pop_back(prop->properties);
+		//builtin index is not reset when rebuilt, clear its slots
+		if (prop->indexed && p->bslot && (prop->idx_builtin[p->bslot-1] == p))
+			prop->idx_builtin[p->bslot-1] = NULL;
+		gf_props_del_property(p);
+	}
+	//index tables are kept for when the map is reused from the reservoir
+	prop->indexed = GF_FALSE;
+	prop->has_dups = GF_FALSE;
+	prop->nb_other = 0;
 }
 
 void gf_props_del(GF_PropertyMap *map)
@@ -1074,53 +1070,138 @@ void gf_props_del(GF_PropertyMap *map)
 	map->reference_count = 0;
 	map->timescale = 0;
 	if (!map->session || gf_fq_res_add(map->session->prop_maps_reservoir, map)) {
-		gf_list_del(map->properties);
-		gf_free(map);
+		gf_propmap_del(map);
 	}
 }
 
+static void gf_props_index_add(GF_PropertyMap *map, GF_PropertyEntry *prop)
+{
+	u32 pos, mask;
+	if (prop->bslot) {
+		//same property added twice, lookup returns the first one as done by list lookup
+		if (map->idx_builtin[prop->bslot-1]) map->has_dups = GF_TRUE;
+		else map->idx_builtin[prop->bslot-1] = prop;
+		return;
+	}
+	mask = map->idx_other_size - 1;
+	pos = prop->hkey & mask;
+	while (map->idx_other[pos]) {
+		GF_PropertyEntry *p = map->idx_other[pos];
+		if ((p->hkey==prop->hkey) && gf_props_entry_match(p, prop->p4cc, prop->pname)) {
+			map->has_dups = GF_TRUE;
+			return;
+		}
+		pos = (pos+1) & mask;
+	}
+	map->idx_other[pos] = prop;
+	map->nb_other++;
+}
 
-
-//purge existing property of same name
-void gf_props_remove_property(GF_PropertyMap *map, u32 hash, u32 p4cc, const char *name)
+//(re)builds index from property list, on failure the map is left unindexed and uses list lookup
+static void gf_props_index_build(GF_PropertyMap *map)
 {
-#if GF_PROPS_HASHTABLE_SIZE
-	if (map->hash_table[hash]) {
-		u32 i, count = gf_list_count(map->hash_table[hash]);
-		for (i=0; i<count; i++) {
-			GF_PropertyEntry *prop = gf_list_get(map->hash_table[hash], i);
-			if ((p4cc && (p4cc==prop->p4cc)) || (name && prop->pname && !strcmp(prop->pname, name)) ) {
-				gf_list_rem(map->hash_table[hash], i);
-				gf_props_del_property(prop);
-				break;
-			}
-		}
-	}
-#else
-	u32 i, count = gf_list_count(map->properties);
+	u32 i, count, nb_other=0, size=16;
+	u32 nb_builtin = gf_props_builtin_count();
+
+	count = gf_list_count(map->properties);
 	for (i=0; i<count; i++) {
-		GF_PropertyEntry *prop = gf_list_get(map->properties, i);
-		if ((p4cc && (p4cc==prop->p4cc)) || (name && prop->pname && !strcmp(prop->pname, name)) ) {
-			gf_list_rem(map->properties, i);
-			gf_props_del_property(prop);
-			break;
-		}
+		GF_PropertyEntry *p = gf_list_get(map->properties, i);
+		if (!p->bslot) nb_other++;
+		//the builtin table only references properties of the list: clear their slots rather than the whole table
+		else if (map->indexed) map->idx_builtin[p->bslot-1] = NULL;
+	}
+	//prevent lookups during rebuild
+	map->indexed = GF_FALSE;
+	//keep secondary table at most half full, including next insertion
+	while (size < 2*(nb_other+1)) size *= 2;
+
+	if (!map->idx_builtin) {
+		map->idx_builtin = gf_malloc(sizeof(GF_PropertyEntry *) * nb_builtin);
+		if (!map->idx_builtin) return;
+		memset(map->idx_builtin, 0, sizeof(GF_PropertyEntry *) * nb_builtin);
+	}
+	if (size > map->idx_other_size) {
+		if (map->idx_other) gf_free(map->idx_other);
+		map->idx_other = gf_malloc(sizeof(GF_PropertyEntry *) * size);
+		if (!map->idx_other) {
+			map->idx_other_size = 0;
+			return;
+		}
+		map->idx_other_size = size;
+	}
+	memset(map->idx_other, 0, sizeof(GF_PropertyEntry *) * map->idx_other_size);
+	map->nb_other = 0;
+	map->has_dups = GF_FALSE;
+	for (i=0; i<count; i++) {
+		gf_props_index_add(map, gf_list_get(map->properties, i));
 	}
-#endif
+	map->indexed = GF_TRUE;
 }
 
+static void gf_props_index_remove(GF_PropertyMap *map, GF_PropertyEntry *prop)
+{
+	u32 pos, next, mask;
+	if (prop->bslot && (map->idx_builtin[prop->bslot-1] == prop))
+		map->idx_builtin[prop->bslot-1] = NULL;
+	//a shadowed duplicate may now be visible
+	if (map->has_dups) {
+		gf_props_index_build(map);
+		return;
+	}
+	if (prop->bslot) return;
+	mask = map->idx_other_size - 1;
+	pos = prop->hkey & mask;
+	while (map->idx_other[pos] && (map->idx_other[pos] != prop))
+		pos = (pos+1) & mask;
+	if (!map->idx_other[pos]) return;
+
+	map->idx_other[pos] = NULL;
+	map->nb_other--;
+	//backward shift of the following entries of the probe sequence
+	next = (pos+1) & mask;
+	while (map->idx_other[next]) {
+		GF_PropertyEntry *p = map->idx_other[next];
+		u32 home = p->hkey & mask;
+		Bool move;
+		//entry can fill the hole if its home slot is not cyclically in ]pos, next]
+		if (pos <= next) move = ((home <= pos) || (home > next)) ? GF_TRUE : GF_FALSE;
+		else move = ((home <= pos) && (home > next)) ? GF_TRUE : GF_FALSE;
+		if (move) {
+			map->idx_other[pos] = p;
+			map->idx_other[next] = NULL;
+			pos = next;
+		}
+		next = (next+1) & mask;
+	}
+}
 
-#if GF_PROPS_HASHTABLE_SIZE
-GF_List *gf_props_get_list(GF_PropertyMap *map)
+static GF_Err gf_props_add_entry(GF_PropertyMap *map, GF_PropertyEntry *prop)
 {
-	GF_List *l;
+	GF_Err e = gf_list_add(map->properties, prop);
+	if (e) return e;
 
-	l = gf_fq_pop(map->session->prop_maps_list_reservoir);
+	if (map->indexed) {
+		if (!prop->bslot && (2*(map->nb_other+1) > map->idx_other_size))
+			gf_props_index_build(map);
+		else
+			gf_props_index_add(map, prop);
+	} else if (gf_list_count(map->properties) > GF_PROPS_INDEX_MIN) {
+		gf_props_index_build(map);
+	}
+	return GF_OK;
+}
+
+//purge existing property of same name
+void gf_props_remove_property(GF_PropertyMap *map, u32 p4cc, const char *name)
+{
+	GF_PropertyEntry *prop = (GF_PropertyEntry *) gf_props_get_property_entry(map, p4cc, name);
+	if (!prop) return;
 
-	if (!l) l = gf_list_new();
-	return l;
+	gf_list_del_item(map->properties, prop);
+	if (map->indexed)
+		gf_props_index_remove(map, prop);
+	gf_props_del_property(prop);
 }
-#endif
 
 static GF_Err gf_props_assign_value(GF_PropertyEntry *prop, const GF_PropertyValue *value, Bool is_old_prop)
 {
@@ -1188,35 +1269,17 @@ static GF_Err gf_props_assign_value(GF_PropertyEntry *prop, const GF_PropertyVal
 	return GF_OK;
 }
 
-GF_Err gf_props_insert_property(GF_PropertyMap *map, u32 hash, u32 p4cc, const char *name, char *dyn_name, const GF_PropertyValue *value)
+GF_Err gf_props_insert_property(GF_PropertyMap *map, u32 p4cc, const char *name, char *dyn_name, const GF_PropertyValue *value)
 {
 	GF_PropertyEntry *prop;
 	GF_Err e;
-#if GF_PROPS_HASHTABLE_SIZE
-	u32 i, count;
-#endif
+
 	if ((value->type == GF_PROP_DATA) || (value->type == GF_PROP_DATA_NO_COPY)) {
 		if (!value->value.data.ptr) {
 			GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Attempt at defining data property %s with NULL pointer, not allowed\n", p4cc ? gf_4cc_to_str(p4cc) : name ? name : dyn_name ));
 			return GF_BAD_PARAM;
 		}
 	}
-#if GF_PROPS_HASHTABLE_SIZE
-	if (! map->hash_table[hash] ) {
-		map->hash_table[hash] = gf_props_get_list(map);
-		if (!map->hash_table[hash]) return GF_OUT_OF_MEM;
-	} else {
-		count = gf_list_count(map->hash_table[hash]);
-		if (count) {
-			GF_LOG(GF_LOG_DEBUG, GF_LOG_FILTER, ("PropertyMap hash collision for %s - %d entries before insertion:\n", p4cc ? gf_4cc_to_str(p4cc) : name ? name : dyn_name, gf_list_count(map->hash_table[hash]) ));
-			for (i=0; i<count; i++) {
-				GF_PropertyEntry *prop_c = gf_list_get(map->hash_table[hash], i);
-				GF_LOG(GF_LOG_DEBUG, GF_LOG_FILTER, ("\t%s\n\n", prop_c->pname ? prop_c->pname : gf_4cc_to_str(prop_c->p4cc)  ));
-				gf_assert(!prop_c->p4cc || (prop_c->p4cc != p4cc));
-			}
-		}
-	}
-#endif
 	if ((value->type == GF_PROP_DATA) && value->value.data.ptr) {
 		prop = gf_fq_pop(map->session->prop_maps_entry_data_alloc_reservoir);
 	} else {
@@ -1236,89 +1299,64 @@ GF_Err gf_props_insert_property(GF_PropertyMap *map, u32 hash, u32 p4cc, const c
 		prop->pname = gf_strdup(dyn_name);
 		prop->name_alloc=GF_TRUE;
 	}
+	prop->bslot = p4cc ? gf_props_builtin_slot(p4cc) : 0;
+	prop->hkey = prop->bslot ? 0 : gf_props_hash_key(p4cc, prop->pname);
 
 	e = gf_props_assign_value(prop, value, GF_FALSE);
 	if (e) {
 		gf_props_del_property(prop);
 		return e;
 	}
-
-#if GF_PROPS_HASHTABLE_SIZE
-	return gf_list_add(map->hash_table[hash], prop);
-#else
-	return gf_list_add(map->properties, prop);
-#endif
-
+	return gf_props_add_entry(map, prop);
 }
 
 GF_Err gf_props_set_property(GF_PropertyMap *map, u32 p4cc, const char *name, char *dyn_name, const GF_PropertyValue *value)
 {
 	GF_Err e;
-	u32 hash = gf_props_hash_djb2(p4cc, name ? name : dyn_name);
 	gf_mx_p(map->session->info_mx);
-	gf_props_remove_property(map, hash, p4cc, name ? name : dyn_name);
+	gf_props_remove_property(map, p4cc, name ? name : dyn_name);
 	if (!value)
 		e = GF_OK;
 	else
-		e = gf_props_insert_property(map, hash, p4cc, name, dyn_name, value);
+		e = gf_props_insert_property(map, p4cc, name, dyn_name, value);
 	gf_mx_v(map->session->info_mx);
 	return e;
 }
 
 const GF_PropertyEntry *gf_props_get_property_entry(GF_PropertyMap *map, u32 prop_4cc, const char *name)
 {
-	u32 i, count, len;
-	const GF_PropertyEntry *res=NULL;
-#if GF_PROPS_HASHTABLE_SIZE
-	u32 hash = gf_props_hash_djb2(prop_4cc, name);
-	if (map->hash_table[hash] ) {
-		count = gf_list_count(map->hash_table[hash]);
-		for (i=0; i<count; i++) {
-			GF_PropertyEntry *p = gf_list_get(map->hash_table[hash], i);
-
-			if ((prop_4cc && (p->p4cc==prop_4cc)) || (p->pname && name && !strcmp(p->pname, name)) ) {
-				res = p;
-				break;
-			}
+	u32 i, count;
+	if (!prop_4cc && !name) return NULL;
+
+	if (map->indexed) {
+		u32 hkey, pos, mask;
+		GF_PropertyEntry *p;
+		u32 bslot = prop_4cc ? gf_props_builtin_slot(prop_4cc) : 0;
+		if (bslot)
+			return map->idx_builtin[bslot-1];
+
+		hkey = gf_props_hash_key(prop_4cc, name);
+		mask = map->idx_other_size - 1;
+		pos = hkey & mask;
+		while ((p = map->idx_other[pos]) ) {
+			if ((p->hkey==hkey) && gf_props_entry_match(p, prop_4cc, name))
+				return p;
+			pos = (pos+1) & mask;
 		}
+		return NULL;
 	}
-#else
+
 	count = gf_list_count(map->properties);
-	if (name) {
-		len = (u32) strlen(name);
-	} else {
-		if (!prop_4cc) return NULL;
-		len = 0;
-	}
 	for (i=0; i<count; i++) {
 		GF_PropertyEntry *p = gf_list_get(map->properties, i);
 		if (!p) {
 			GF_LOG(GF_LOG_WARNING, GF_LOG_FILTER, ("Concurrent read/write access to property map, cannot query property now\n"));
 			return NULL;
 		}
-
-		if (prop_4cc) {
-			if (p->p4cc==prop_4cc) {
-				res = p;
-				break;
-			}
-		} else if (p->pname) {
-			u32 j;
-			for (j=0; j<=len; j++) {
-				char c = p->pname[j];
-				if (!c)
-					break;
-				if (c != name[j])
-					break;
-			}
-			if (j==len) {
-				res = p;
-				break;
-			}
-		}
+		if (gf_props_entry_match(p, prop_4cc, name))
+			return p;
 	}
-#endif
-	return res;
+	return NULL;
 }
 
 const GF_PropertyValue *gf_props_get_property(GF_PropertyMap *map, u32 prop_4cc, const char *name)
@@ -1332,52 +1370,25 @@ GF_Err gf_props_merge_property(GF_PropertyMap *dst_props, GF_PropertyMap *src_pr
 {
 	GF_Err e;
 	u32 i, count;
-#if GF_PROPS_HASHTABLE_SIZE
-	u32 idx;
-#endif
-	GF_List *list;
 	if (src_props->timescale)
 		dst_props->timescale = src_props->timescale;
 
-#if GF_PROPS_HASHTABLE_SIZE
-	for (idx=0; idx<GF_PROPS_HASHTABLE_SIZE; idx++) {
-		if (src_props->hash_table[idx]) {
-			list = src_props->hash_table[idx];
-#else
-			list = src_props->properties;
-#endif
-			count = gf_list_count(list);
-			for (i=0; i<count; i++) {
-				GF_PropertyEntry *prop = gf_list_get(list, i);
-				gf_assert(prop->reference_count);
-				if (!filter_prop || filter_prop(cbk, prop->p4cc, prop->pname, &prop->prop)) {
-					safe_int_inc(&prop->reference_count);
-
-#if GF_PROPS_HASHTABLE_SIZE
-					if (!dst_props->hash_table[idx]) {
-						dst_props->hash_table[idx] = gf_props_get_list(dst_props);
-						if (!dst_props->hash_table[idx]) return GF_OUT_OF_MEM;
-					}
-					e = gf_list_add(dst_props->hash_table[idx], prop);
-					if (e) return e;
-#else
-					e = gf_list_add(dst_props->properties, prop);
-					if (e) return e;
-#endif
-				}
-			}
-#if GF_PROPS_HASHTABLE_SIZE
+	count = gf_list_count(src_props->properties);
+	for (i=0; i<count; i++) {
+		GF_PropertyEntry *prop = gf_list_get(src_props->properties, i);
+		gf_assert(prop->reference_count);
+		if (!filter_prop || filter_prop(cbk, prop->p4cc, prop->pname, &prop->prop)) {
+			safe_int_inc(&prop->reference_count);
+
+			e = gf_props_add_entry(dst_props, prop);
+			if (e) return e;
 		}
 	}
-#endif
 	return GF_OK;
 }
 
 const GF_PropertyValue *gf_props_enum_property(GF_PropertyMap *props, u32 *io_idx, u32 *prop_4cc, const char **prop_name)
 {
-#if GF_PROPS_HASHTABLE_SIZE
-	u32 i, nb_items = 0;
-#endif
 	u32 idx, count;
 
 	const GF_PropertyEntry *pe;
@@ -1386,29 +1397,6 @@ const GF_PropertyValue *gf_props_enum_property(GF_PropertyMap *props, u32 *io_id
 	idx = *io_idx;
 	if (idx == 0xFFFFFFFF) return NULL;
 
-#if GF_PROPS_HASHTABLE_SIZE
-	for (i=0; i<GF_PROPS_HASHTABLE_SIZE; i++) {
-		if (props->hash_table[i]) {
-			count = gf_list_count(props->hash_table[i]);
-			nb_items+=count;
-			if (idx >= count) {
-				idx -= count;
-				continue;
-			}
-			pe = gf_list_get(props->hash_table[i], idx);
-			if (!pe) {
-				*io_idx = nb_items;
-				return NULL;
-			}
-			if (prop_4cc) *prop_4cc = pe->p4cc;
-			if (prop_name) *prop_name = pe->pname;
-			*io_idx = (*io_idx) + 1;
-			return &pe->prop;
-		}
-	}
-	*io_idx = nb_items;
-	return NULL;
-#else
 	count = gf_list_count(props->properties);
 	if (idx >= count) {
 		*io_idx = count;
@@ -1423,7 +1411,6 @@ const GF_PropertyValue *gf_props_enum_property(GF_PropertyMap *props, u32 *io_id
 	if (prop_name) *prop_name = pe->pname;
 	*io_idx = (*io_idx) + 1;
 	return &pe->prop;
-#endif
 }
 
 typedef struct
@@ -1804,6 +1791,126 @@ GF_BuiltInProperty GF_BuiltInProps [] =
 
 static u32 gf_num_props = sizeof(GF_BuiltInProps) / sizeof(GF_BuiltInProperty);
 
+static u32 gf_props_builtin_count()
+{
+	return gf_num_props;
+}
+
+//perfect hash of builtin property 4CCs (hash and displace), used for 4CC to description lookups and to give
+//each builtin property a dense slot in property map indexes
+#define GF_PROPS_PHF_BUCKETS	256
+#define GF_PROPS_PHF_SLOTS	1024
+#define GF_PROPS_PHF_BUCKET(_k)	( ((u32) ((_k) * 0x9E3779B1U)) >> 24)
+#define GF_PROPS_PHF_SLOT(_k, _d)	( ((u32) ( ((_k) ^ ((_d) * 0x85EBCA6BU)) * 0xC2B2AE35U)) >> 22)
+
+static u16 props_phf_disp[GF_PROPS_PHF_BUCKETS];
+static u32 props_phf_keys[GF_PROPS_PHF_SLOTS];
+static u16 props_phf_idx[GF_PROPS_PHF_SLOTS];
+//0: not initialized, 1: ready, 2: failed, builtin properties are then handled as custom ones
+static volatile u32 props_phf_state = 0;
+//number of callers of gf_props_builtin_init, only the first one builds the hash
+static volatile u32 props_phf_init = 0;
+
+static void gf_props_builtin_build();
+
+void gf_props_builtin_init()
+{
+	if (props_phf_state) return;
+	if (safe_int_inc(&props_phf_init) != 1) {
+		//built by another thread
+		while (!props_phf_state) gf_sleep(0);
+		return;
+	}
+	gf_props_builtin_build();
+}
+
+//state is only set through atomic operations once the tables are complete
+static void gf_props_builtin_build()
+{
+	u32 i, j, b, d, size, max_size=0;
+	u8 bucket_size[GF_PROPS_PHF_BUCKETS];
+	u8 used[GF_PROPS_PHF_SLOTS];
+	u32 keys[16], slots[16];
+	u16 idx[16];
+
+	memset(bucket_size, 0, sizeof(bucket_size));
+	memset(used, 0, sizeof(used));
+	for (i=0; i<gf_num_props; i++) {
+		b = GF_PROPS_PHF_BUCKET(GF_BuiltInProps[i].type);
+		bucket_size[b]++;
+		if (bucket_size[b] > max_size) max_size = bucket_size[b];
+	}
+	if (max_size>16) {
+		safe_int_add(&props_phf_state, 2);
+		return;
+	}
+	//place largest buckets first
+	for (size=max_size; size; size--) {
+		for (b=0; b<GF_PROPS_PHF_BUCKETS; b++) {
+			u32 nb_keys = 0;
+			if (bucket_size[b] != size) continue;
+
+			for (i=0; i<gf_num_props; i++) {
+				if (GF_PROPS_PHF_BUCKET(GF_BuiltInProps[i].type) != b) continue;
+				keys[nb_keys] = GF_BuiltInProps[i].type;
+				idx[nb_keys] = i;
+				nb_keys++;
+			}
+			for (d=0; d<0xFFFF; d++) {
+				for (j=0; j<nb_keys; j++) {
+					u32 s = GF_PROPS_PHF_SLOT(keys[j], d);
+					if (used[s]) break;
+					used[s] = 1;
+					slots[j] = s;
+				}
+				if (j==nb_keys) break;
+				while (j) {
+					j--;
+					used[slots[j]] = 0;
+				}
+			}
+			//duplicated 4CC
+			if (d==0xFFFF) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_FILTER, ("Failed to build builtin properties hash, using slow lookup\n"));
+				safe_int_add(&props_phf_state, 2);
+				return;
+			}
+			props_phf_disp[b] = d;
+			for (j=0; j<nb_keys; j++) {
+				props_phf_keys[slots[j]] = keys[j];
+				props_phf_idx[slots[j]] = idx[j];
+			}
+		}
+	}
+	safe_int_inc(&props_phf_state);
+}
+
+u32 gf_props_builtin_slot(u32 p4cc)
+{
+	u32 s;
+	if (props_phf_state != 1) {
+		if (props_phf_state) return 0;
+		gf_props_builtin_init();
+		if (props_phf_state != 1) return 0;
+	}
+	if (!p4cc) return 0;
+	s = GF_PROPS_PHF_SLOT(p4cc, props_phf_disp[GF_PROPS_PHF_BUCKET(p4cc)]);
+	if (props_phf_keys[s] != p4cc) return 0;
+	return props_phf_idx[s] + 1;
+}
+
+static const GF_BuiltInProperty *gf_props_4cc_get_builtin(u32 prop_4cc)
+{
+	u32 i = gf_props_builtin_slot(prop_4cc);
+	if (i) return &GF_BuiltInProps[i-1];
+	if (props_phf_state==1) return NULL;
+
+	for (i=0; i<gf_num_props; i++) {
+		if (GF_BuiltInProps[i].type==prop_4cc) return &GF_BuiltInProps[i];
+	}
+	return NULL;
+}
+
 GF_EXPORT
 u32 gf_props_get_id(const char *name)
 {
@@ -1846,31 +1953,22 @@ const GF_BuiltInProperty *gf_props_get_description(u32 prop_idx)
 GF_EXPORT
 const char *gf_props_4cc_get_name(u32 prop_4cc)
 {
-	u32 i;
-	for (i=0; i<gf_num_props; i++) {
-		if (GF_BuiltInProps[i].type==prop_4cc) return GF_BuiltInProps[i].name;
-	}
-	return NULL;
+	const GF_BuiltInProperty *prop = gf_props_4cc_get_builtin(prop_4cc);
+	return prop ? prop->name : NULL;
 }
 
 GF_EXPORT
 u8 gf_props_4cc_get_flags(u32 prop_4cc)
 {
-	u32 i;
-	for (i=0; i<gf_num_props; i++) {
-		if (GF_BuiltInProps[i].type==prop_4cc) return GF_BuiltInProps[i].flags;
-	}
-	return 0;
+	const GF_BuiltInProperty *prop = gf_props_4cc_get_builtin(prop_4cc);
+	return prop ? prop->flags : 0;
 }
 
 GF_EXPORT
 u32 gf_props_4cc_get_type(u32 prop_4cc)
 {
-	u32 i;
-	for (i=0; i<gf_num_props; i++) {
-		if (GF_BuiltInProps[i].type==prop_4cc) return GF_BuiltInProps[i].data_type;
-	}
-	return GF_PROP_FORBIDDEN;
+	const GF_BuiltInProperty *prop = gf_props_4cc_get_builtin(prop_4cc);
+	return prop ? prop->data_type : GF_PROP_FORBIDDEN;
 }
 
 Bool gf_props_4cc_check_props()
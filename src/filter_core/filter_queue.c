@@ -44,6 +44,46 @@ typedef struct __lf_item
 	void *data;
 } GF_LFQItem;
 
+//array ring mode (Vyukov bounded MPMC queue), a full ring is closed and a new ring twice as large is appended
+#define FQ_CACHE_LINE	64
+#define FQ_RING_MIN_SIZE	16
+//closed flag of enqueue position - no more items can be added to the ring
+#define FQ_RING_CLOSED	0x80000000
+//positions are 31 bits, close the ring before wrapping
+#define FQ_RING_MAX_POS	0x40000000
+
+#if defined(__GNUC__)
+#define fq_load_acquire(_ptr)	__atomic_load_n(_ptr, __ATOMIC_ACQUIRE)
+#define fq_store_release(_ptr, _val)	__atomic_store_n(_ptr, _val, __ATOMIC_RELEASE)
+#else
+//volatile accesses have acquire/release semantics with MSVC
+#define fq_load_acquire(_ptr)	(*(_ptr))
+#define fq_store_release(_ptr, _val)	*(_ptr) = _val
+#endif
+
+typedef struct
+{
+	volatile u32 seq;
+	void *data;
+} GF_LFQCell;
+
+typedef struct __lf_ring
+{
+	GF_LFQCell *cells;
+	u32 mask;
+	//next ring, set once this ring is closed
+	struct __lf_ring * volatile next;
+	//next retired ring, retired rings are only destroyed with the queue since other threads may still access them
+	struct __lf_ring *next_retired;
+
+	//producer and consumer positions on their own cache lines
+	u8 _pad1[FQ_CACHE_LINE];
+	volatile u32 enq_pos;
+	u8 _pad2[FQ_CACHE_LINE - sizeof(u32)];
+	volatile u32 deq_pos;
+	u8 _pad3[FQ_CACHE_LINE - sizeof(u32)];
+} GF_LFQRing;
+
 struct __gf_filter_queue
 {
 	//head element is dummy, never swaped
@@ -57,12 +97,166 @@ struct __gf_filter_queue
 
 	GF_Mutex *mx;
 	u8 use_mx;
+
+	//array ring mode
+	GF_LFQRing * volatile r_head;
+	GF_LFQRing * volatile r_tail;
+	GF_LFQRing * volatile r_retired;
 };
 
+static GF_LFQRing *gf_fq_ring_new(u32 size, u32 start_pos)
+{
+	u32 i;
+	GF_LFQRing *r;
+	GF_SAFEALLOC(r, GF_LFQRing);
+	if (!r) return NULL;
+	r->cells = gf_malloc(sizeof(GF_LFQCell) * size);
+	if (!r->cells) {
+		gf_free(r);
+		return NULL;
+	}
+	for (i=0; i<size; i++) {
+		r->cells[i].seq = start_pos + i;
+		r->cells[i].data = NULL;
+	}
+	r->mask = size-1;
+	r->enq_pos = r->deq_pos = start_pos;
+	return r;
+}
+
+static void gf_fq_ring_del(GF_LFQRing *r)
+{
+	gf_free(r->cells);
+	gf_free(r);
+}
+
+//append a new ring to a closed ring and move tail
+static Bool gf_fq_ring_grow(GF_FilterQueue *q, GF_LFQRing *r)
+{
+	if (!r->next) {
+		u32 size = r->mask+1;
+		u32 enq_pos = r->enq_pos & ~FQ_RING_CLOSED;
+		GF_LFQRing *nr;
+		//closed because full, double size, otherwise closed because of position wrap, keep size and restart from 0
+		if (enq_pos - r->deq_pos >= size) size *= 2;
+
+		nr = gf_fq_ring_new(size, 0);
+		//cannot allocate a larger ring, try a minimal one
+		if (!nr && (size>FQ_RING_MIN_SIZE)) nr = gf_fq_ring_new(FQ_RING_MIN_SIZE, 0);
+		if (!nr) return GF_FALSE;
+		if (!atomic_compare_and_swap(&r->next, NULL, nr))
+			gf_fq_ring_del(nr);
+	}
+	atomic_compare_and_swap(&q->r_tail, r, r->next);
+	return GF_TRUE;
+}
 
+static GF_Err gf_fq_ring_enqueue(GF_FilterQueue *q, void *item)
+{
+	while (1) {
+		GF_LFQRing *r = q->r_tail;
+		u32 pos = r->enq_pos;
+		if (!(pos & FQ_RING_CLOSED)) {
+			GF_LFQCell *cell = &r->cells[pos & r->mask];
+			s32 diff = (s32) (fq_load_acquire(&cell->seq) - pos);
+			//cell is free
+			if (!diff && (pos < FQ_RING_MAX_POS)) {
+				if (atomic_compare_and_swap(&r->enq_pos, pos, pos+1)) {
+					cell->data = item;
+					fq_store_release(&cell->seq, pos+1);
+					return GF_OK;
+				}
+				continue;
+			}
+			//another producer got this cell, retry
+			if (diff>0) continue;
+			//ring is full or position wraps, close it
+			if (!atomic_compare_and_swap(&r->enq_pos, pos, pos | FQ_RING_CLOSED))
+				continue;
+		}
+		if (!gf_fq_ring_grow(q, r)) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_SCHEDULER, ("Failed to grow filter queue, cannot add item\n"));
+			return GF_OUT_OF_MEM;
+		}
+	}
+	return GF_OK;
+}
 
+static void *gf_fq_ring_dequeue(GF_FilterQueue *q)
+{
+	while (1) {
+		u32 enq_pos;
+		GF_LFQRing *r = q->r_head;
+		u32 pos = r->deq_pos;
+		GF_LFQCell *cell = &r->cells[pos & r->mask];
+		s32 diff = (s32) (fq_load_acquire(&cell->seq) - (pos+1));
+		//cell is ready
+		if (!diff) {
+			if (atomic_compare_and_swap(&r->deq_pos, pos, pos+1)) {
+				void *data = cell->data;
+				fq_store_release(&cell->seq, pos + r->mask + 1);
+				return data;
+			}
+			continue;
+		}
+		//another consumer got this cell, retry
+		if (diff>0) continue;
+
+		//empty ring or item being written
+		enq_pos = r->enq_pos;
+		if (!(enq_pos & FQ_RING_CLOSED)) return NULL;
+		if ((enq_pos & ~FQ_RING_CLOSED) != pos) return NULL;
+		if (!r->next) return NULL;
+		//closed and empty ring, move to next one
+		if (atomic_compare_and_swap(&q->r_head, r, r->next)) {
+			GF_LFQRing *ret;
+			do {
+				ret = q->r_retired;
+				r->next_retired = ret;
+			} while (!atomic_compare_and_swap(&q->r_retired, ret, r));
+		}
+	}
+	return NULL;
+}
 
-GF_FilterQueue *gf_fq_new(const GF_Mutex *mx)
+static u32 gf_fq_ring_count(GF_FilterQueue *q)
+{
+	u32 count = 0;
+	GF_LFQRing *r = q->r_head;
+	while (r) {
+		//read consumer position first, producer position is always greater or equal
+		u32 deq_pos = r->deq_pos;
+		u32 enq_pos = r->enq_pos & ~FQ_RING_CLOSED;
+		count += enq_pos - deq_pos;
+		r = r->next;
+	}
+	return count;
+}
+
+//enumerate published items, stops when fct returns GF_TRUE
+static void *gf_fq_ring_browse(GF_FilterQueue *q, Bool (*fct)(void *udta, void *item), void *udta)
+{
+	GF_LFQRing *r = q->r_head;
+	while (r) {
+		u32 pos = r->deq_pos;
+		u32 enq_pos = r->enq_pos & ~FQ_RING_CLOSED;
+		while ((s32) (enq_pos - pos) > 0) {
+			GF_LFQCell *cell = &r->cells[pos & r->mask];
+			void *data;
+			if (fq_load_acquire(&cell->seq) != pos+1) return NULL;
+			data = cell->data;
+			if (fct(udta, data)) return data;
+			pos++;
+		}
+		r = r->next;
+	}
+	return NULL;
+}
+
+
+
+
+static GF_FilterQueue *gf_fq_new_internal(const GF_Mutex *mx, Bool use_ring)
 {
 	GF_FilterQueue *q;
 	GF_SAFEALLOC(q, GF_FilterQueue);
@@ -72,6 +266,15 @@ GF_FilterQueue *gf_fq_new(const GF_Mutex *mx)
 	if (mx || gf_opts_get_bool("core", "no-mx")) q->use_mx = 1;
 	if (q->use_mx) return q;
 
+	if (use_ring) {
+		q->r_head = q->r_tail = gf_fq_ring_new(FQ_RING_MIN_SIZE, 0);
+		if (!q->r_head) {
+			gf_free(q);
+			return NULL;
+		}
+		return q;
+	}
+
 
 	//lock-free mode, create dummuy slot for head
 	GF_SAFEALLOC(q->head, GF_LFQItem);
@@ -92,10 +295,38 @@ GF_FilterQueue *gf_fq_new(const GF_Mutex *mx)
 	return q;
 }
 
+GF_FilterQueue *gf_fq_new(const GF_Mutex *mx)
+{
+	return gf_fq_new_internal(mx, gf_opts_get_bool("core", "fq-ring"));
+}
+
 
 void gf_fq_del(GF_FilterQueue *q, void (*item_delete)(void *) )
 {
-	GF_LFQItem *it = q->head;
+	GF_LFQItem *it;
+	if (q->r_head) {
+		GF_LFQRing *r;
+		void *data;
+		while ((data = gf_fq_ring_dequeue(q)) ) {
+			if (item_delete) item_delete(data);
+		}
+		r = q->r_head;
+		while (r) {
+			GF_LFQRing *next = r->next;
+			gf_fq_ring_del(r);
+			r = next;
+		}
+		r = q->r_retired;
+		while (r) {
+			GF_LFQRing *next = r->next_retired;
+			gf_fq_ring_del(r);
+			r = next;
+		}
+		gf_free(q);
+		return;
+	}
+
+	it = q->head;
 	//first item is dummy if lock-free mode, doesn't hold a valid pointer
 	if (! q->use_mx) it->data=NULL;
 
@@ -172,7 +403,7 @@ static void *gf_fq_lockfree_dequeue(GF_LFQItem **head_ptr, GF_LFQItem **tail_ptr
 	return data;
 }
 
-void gf_lfq_add(GF_FilterQueue *q, void *item)
+GF_Err gf_lfq_add(GF_FilterQueue *q, void *item)
 {
 	GF_LFQItem *it=NULL;
 	gf_assert(q);
@@ -180,13 +411,14 @@ void gf_lfq_add(GF_FilterQueue *q, void *item)
 	gf_fq_lockfree_dequeue( &q->res_head, &q->res_tail, &it);
 	if (!it) {
 		GF_SAFEALLOC(it, GF_LFQItem);
-		if (!it) return;
+		if (!it) return GF_OUT_OF_MEM;
 	} else {
 		it->next = NULL;
 	}
 	it->data=item;
 	gf_fq_lockfree_enqueue(it, &q->tail);
 	safe_int_inc(&q->nb_items);
+	return GF_OK;
 }
 
 void *gf_lfq_pop(GF_FilterQueue *q)
@@ -208,17 +440,21 @@ void *gf_lfq_pop(GF_FilterQueue *q)
 
 u32 gf_fq_count(GF_FilterQueue *q)
 {
-	return q ? q->nb_items : 0;
+	if (!q) return 0;
+	if (q->r_head) return gf_fq_ring_count(q);
+	return q->nb_items;
 }
 
 //TODO - check performances vs function pointer
-void gf_fq_add(GF_FilterQueue *fq, void *item)
+GF_Err gf_fq_add(GF_FilterQueue *fq, void *item)
 {
 	GF_LFQItem *it;
 	gf_assert(fq);
 
-	if (! fq->use_mx) {
-		gf_lfq_add(fq, item);
+	if (fq->r_head) {
+		return gf_fq_ring_enqueue(fq, item);
+	} else if (! fq->use_mx) {
+		return gf_lfq_add(fq, item);
 	} else {
 		gf_mx_p(fq->mx);
 
@@ -228,7 +464,10 @@ void gf_fq_add(GF_FilterQueue *fq, void *item)
 			it->next = NULL;
 		} else {
 			GF_SAFEALLOC(it, GF_LFQItem);
-			if (!it) return;
+			if (!it) {
+				gf_mx_v(fq->mx);
+				return GF_OUT_OF_MEM;
+			}
 		}
 		if (! fq->res_head) fq->res_tail = NULL;
 
@@ -242,6 +481,7 @@ void gf_fq_add(GF_FilterQueue *fq, void *item)
 		fq->nb_items++;
 		gf_mx_v(fq->mx);
 	}
+	return GF_OK;
 }
 
 void *gf_fq_pop(GF_FilterQueue *fq)
@@ -251,6 +491,9 @@ void *gf_fq_pop(GF_FilterQueue *fq)
 		return NULL;
 
 	void *data=NULL;
+	if (fq->r_head) {
+		return gf_fq_ring_dequeue(fq);
+	}
 	if (! fq->use_mx) {
 		return gf_lfq_pop(fq);
 	}
@@ -281,15 +524,26 @@ void *gf_fq_pop(GF_FilterQueue *fq)
 }
 
 
+static Bool fq_ring_get_idx(void *udta, void *item)
+{
+	u32 *idx = (u32 *)udta;
+	if (! *idx) return GF_TRUE;
+	(*idx)--;
+	return GF_FALSE;
+}
+
 void *gf_fq_head(GF_FilterQueue *fq)
 {
 	void *data;
+	u32 idx = 0;
 	if (!fq) return NULL;
 
 	if (fq->use_mx) {
 		gf_mx_p(fq->mx);
 		data = fq->head ? fq->head->data : NULL;
 		gf_mx_v(fq->mx);
+	} else if (fq->r_head) {
+		data = gf_fq_ring_browse(fq, fq_ring_get_idx, &idx);
 	} else {
 		data = fq->head->next ? fq->head->next->data : NULL;
 	}
@@ -314,6 +568,8 @@ void *gf_fq_get(GF_FilterQueue *fq, u32 idx)
 		}
 		data = it ? it->data : NULL;
 		gf_mx_v(fq->mx);
+	} else if (fq->r_head) {
+		data = gf_fq_ring_browse(fq, fq_ring_get_idx, &idx);
 	} else {
 		it = fq->head->next;
 		while (it && idx) {
@@ -327,6 +583,19 @@ void *gf_fq_get(GF_FilterQueue *fq, u32 idx)
 	return data;
 }
 
+typedef struct
+{
+	void (*enum_func)(void *udta1, void *item);
+	void *udta;
+} GF_FQRingEnum;
+
+static Bool fq_ring_enum(void *udta, void *item)
+{
+	GF_FQRingEnum *e = (GF_FQRingEnum *)udta;
+	e->enum_func(e->udta, item);
+	return GF_FALSE;
+}
+
 void gf_fq_enum(GF_FilterQueue *fq, void (*enum_func)(void *udta1, void *item), void *udta)
 {
 	GF_LFQItem *it;
@@ -342,6 +611,11 @@ void gf_fq_enum(GF_FilterQueue *fq, void (*enum_func)(void *udta1, void *item),
 			it = it->next;
 		}
 		gf_mx_v(fq->mx);
+	} else if (fq->r_head) {
+		GF_FQRingEnum e;
+		e.enum_func = enum_func;
+		e.udta = udta;
+		gf_fq_ring_browse(fq, fq_ring_enum, &e);
 	} else {
 		it = fq->head->next;
 		while (it) {
@@ -356,7 +630,8 @@ Bool gf_fq_res_add(GF_FilterQueue *fq, void *item)
 	if (!fq) return GF_TRUE;
 	//avoid queuing up too many entries in a reservoir queue, this could grow memory
 	//way too much when packet bursts happen
-	if (fq->nb_items>=50) return GF_TRUE;
-	gf_fq_add(fq, item);
+	if (gf_fq_count(fq)>=50) return GF_TRUE;
+	//could not add the item, let caller destroy it
+	if (gf_fq_add(fq, item)) return GF_TRUE;
 	return GF_FALSE;
 }
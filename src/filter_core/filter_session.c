@@ -37,11 +37,104 @@ struct _gf_ft_mgr *gf_font_manager_new();
 void gf_font_manager_del(struct _gf_ft_mgr *fm);
 #endif
 
-static GFINLINE void gf_fs_sema_io(GF_FilterSession *fsess, Bool notify, Bool main)
+//get the secondary task list on which a task for the given filter shall be posted
+//in work-stealing mode, this is the list of the thread the filter is restricted to, or of the thread which last processed the filter
+//numa_node is set to the 1-based NUMA node of the threads allowed to run the task, 0 if any
+static GFINLINE GF_FilterQueue *fs_secondary_task_list(GF_FilterSession *fsess, GF_Filter *filter, u32 *numa_node)
+{
+	if (numa_node) *numa_node = filter ? filter->numa_node : 0;
+#ifndef GPAC_DISABLE_THREADS
+	if (fsess->work_steal && filter) {
+		u32 idx = filter->restrict_th_idx ? filter->restrict_th_idx : filter->last_th_idx;
+		//filter bound to a NUMA node but not yet processed by a thread of that node, use the first thread of the node
+		if (!idx && filter->numa_node && (filter->numa_node <= fsess->nb_numa_nodes))
+			idx = fsess->numa_first_th[filter->numa_node-1];
+		if (idx) {
+			GF_SessionThread *sth = gf_list_get(fsess->threads, idx-1);
+			if (sth && sth->tasks) {
+				if (numa_node) *numa_node = sth->numa_node;
+				return sth->tasks;
+			}
+		}
+	}
+#endif
+	return fsess->tasks;
+}
+
+//get number of tasks pending in secondary task lists
+static u32 fs_secondary_tasks_count(GF_FilterSession *fsess)
+{
+	u32 count = gf_fq_count(fsess->tasks);
+#ifndef GPAC_DISABLE_THREADS
+	if (fsess->work_steal) {
+		u32 i, nb_th = gf_list_count(fsess->threads);
+		for (i=0; i<nb_th; i++) {
+			GF_SessionThread *sth = gf_list_get(fsess->threads, i);
+			if (sth->tasks) count += gf_fq_count(sth->tasks);
+		}
+	}
+#endif
+	return count;
+}
+
+//pop a task from the secondary task lists
+//in work-stealing mode, check the local list of the thread first, then the global list, then steal from other threads lists
+static GF_FSTask *fs_pop_secondary_task(GF_FilterSession *fsess, GF_SessionThread *sess_thread, u32 thid)
+{
+#ifndef GPAC_DISABLE_THREADS
+	u32 i, nb_th;
+	GF_FSTask *task;
+	u32 remote_node = 0;
+	if (!fsess->work_steal)
+		return gf_fq_pop(fsess->tasks);
+
+	if (sess_thread->tasks) {
+		task = gf_fq_pop(sess_thread->tasks);
+		if (task) return task;
+	}
+	task = gf_fq_pop(fsess->tasks);
+	if (task) return task;
+
+	//start with the thread following this one to spread the stealing load
+	nb_th = gf_list_count(fsess->threads);
+	for (i=0; i<nb_th; i++) {
+		GF_SessionThread *victim = gf_list_get(fsess->threads, (thid + i) % nb_th);
+		if ((victim == sess_thread) || !victim->tasks) continue;
+		//don't steal tasks across NUMA nodes
+		if (sess_thread->numa_node && (victim->numa_node != sess_thread->numa_node)) {
+			if (!remote_node && gf_fq_count(victim->tasks)) remote_node = victim->numa_node;
+			continue;
+		}
+		task = gf_fq_pop(victim->tasks);
+		if (task) {
+			sess_thread->nb_steals++;
+			return task;
+		}
+	}
+	//we consumed a wake-up not targeting a node (these are dispatched in round-robin)
+	//but tasks are pending for another node, pass the wake-up to the threads of that node
+	if (remote_node && (remote_node <= fsess->nb_numa_nodes))
+		gf_sema_notify(fsess->numa_semas[remote_node-1], 1);
+	return NULL;
+#else
+	return gf_fq_pop(fsess->tasks);
+#endif
+}
+
+//notify or wait on the main or secondary semaphore
+//for secondary semaphore, numa_node is the 1-based NUMA node of the waiting thread or of the threads to wake up, 0 if none
+static void gf_fs_sema_io_node(GF_FilterSession *fsess, Bool notify, Bool main, u32 numa_node)
 {
 	//we don't use sema on emscripten, we always give control back to main caller or pthread
 #ifndef GPAC_CONFIG_EMSCRIPTEN
 	GF_Semaphore *sem = main ? fsess->semaphore_main : fsess->semaphore_other;
+	if (!main && fsess->numa_semas) {
+		//wake-up not targeting a node, dispatch in round-robin
+		if (notify && (!numa_node || (numa_node > fsess->nb_numa_nodes)))
+			numa_node = 1 + (safe_int_inc(&fsess->numa_next_node) % fsess->nb_numa_nodes);
+		if (numa_node && (numa_node <= fsess->nb_numa_nodes))
+			sem = fsess->numa_semas[numa_node-1];
+	}
 	if (sem) {
 		if (notify) {
 			GF_LOG(GF_LOG_DEBUG, GF_LOG_SCHEDULER, ("Thread %u notify scheduler %s semaphore\n", gf_th_id(), main ? "main" : "secondary"));
@@ -55,12 +148,12 @@ static GFINLINE void gf_fs_sema_io(GF_FilterSession *fsess, Bool notify, Bool ma
 			//this also ensures that the main thread will process tasks from secondary task lists if no
 			//dedicated main thread tasks are present (eg no GL filters)
 			if (!main && fsess->in_main_sem_wait && !gf_fq_count(fsess->main_thread_tasks)) {
-				gf_fs_sema_io(fsess, GF_TRUE, GF_TRUE);
+				gf_fs_sema_io_node(fsess, GF_TRUE, GF_TRUE, 0);
 			}
 			nb_tasks = 1;
 			//no active threads, count number of tasks. If no posted tasks we are likely at the end of the session, don't block, rather use a sem_wait 
 			if (!fsess->active_threads)
-			 	nb_tasks = gf_fq_count(fsess->main_thread_tasks) + gf_fq_count(fsess->tasks);
+			 	nb_tasks = gf_fq_count(fsess->main_thread_tasks) + fs_secondary_tasks_count(fsess);
 
 			//if main semaphore, keep track that we are going to sleep
 			if (main) {
@@ -89,6 +182,25 @@ static GFINLINE void gf_fs_sema_io(GF_FilterSession *fsess, Bool notify, Bool ma
 #endif // GPAC_CONFIG_EMSCRIPTEN
 }
 
+static GFINLINE void gf_fs_sema_io(GF_FilterSession *fsess, Bool notify, Bool main)
+{
+	gf_fs_sema_io_node(fsess, notify, main, 0);
+}
+
+//notify the secondary semaphore, or the semaphores of all NUMA nodes
+static Bool fs_sema_notify_secondary(GF_FilterSession *fsess, u32 count)
+{
+	if (fsess->numa_semas) {
+		u32 i;
+		Bool res = GF_TRUE;
+		for (i=0; i<fsess->nb_numa_nodes; i++) {
+			if (!gf_sema_notify(fsess->numa_semas[i], count)) res = GF_FALSE;
+		}
+		return res;
+	}
+	return gf_sema_notify(fsess->semaphore_other, count);
+}
+
 
 GF_EXPORT
 void gf_fs_add_filter_register(GF_FilterSession *fsess, const GF_FilterRegister *freg)
@@ -204,6 +316,98 @@ static Bool fs_check_locales(void *__self, const char *locales_parent_path, cons
 #include <emscripten/threading.h>
 #endif
 
+#ifndef GPAC_DISABLE_THREADS
+#define FS_MAX_PIN_CPUS	1024
+
+static void gf_fs_setup_thread_pinning(GF_FilterSession *fsess)
+{
+	u32 i, nb_th, nb_cpus;
+	u32 cpus[FS_MAX_PIN_CPUS];
+	const char *opt = gf_opts_get_key("core", "th-pin");
+	if (!opt || !strcmp(opt, "no")) return;
+	nb_th = gf_list_count(fsess->threads);
+	if (!nb_th) return;
+
+	if (!strcmp(opt, "node")) {
+		u32 nb_nodes = 0;
+		while (gf_th_get_numa_cpus(nb_nodes, NULL, 0)) nb_nodes++;
+		if (!nb_nodes) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_SCHEDULER, ("No NUMA information available, session threads will not be pinned\n"));
+			return;
+		}
+		//nodes with no thread assigned are not used
+		if (nb_nodes>nb_th) nb_nodes = nb_th;
+		//only bind filter chains to nodes if more than one node
+		if (nb_nodes>1) {
+			fsess->numa_semas = gf_malloc(sizeof(GF_Semaphore *)*nb_nodes);
+			fsess->numa_first_th = gf_malloc(sizeof(u32)*nb_nodes);
+			if (fsess->numa_semas && fsess->numa_first_th) {
+				for (i=0; i<nb_nodes; i++) {
+					fsess->numa_semas[i] = gf_sema_new(GF_INT_MAX, 0);
+					if (!fsess->numa_semas[i]) break;
+					fsess->numa_first_th[i] = 0;
+				}
+				fsess->nb_numa_nodes = i;
+			}
+			if (fsess->nb_numa_nodes != nb_nodes) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_SCHEDULER, ("Failed to allocate NUMA node semaphores, filters will not be bound to nodes\n"));
+				for (i=0; i<fsess->nb_numa_nodes; i++)
+					gf_sema_del(fsess->numa_semas[i]);
+				if (fsess->numa_semas) gf_free(fsess->numa_semas);
+				fsess->numa_semas = NULL;
+				if (fsess->numa_first_th) gf_free(fsess->numa_first_th);
+				fsess->numa_first_th = NULL;
+				fsess->nb_numa_nodes = 0;
+			}
+		}
+		//threads are assigned to nodes in round-robin
+		for (i=0; i<nb_th; i++) {
+			GF_SessionThread *sth = gf_list_get(fsess->threads, i);
+			u32 node = i % nb_nodes;
+			if (fsess->nb_numa_nodes) {
+				sth->numa_node = node+1;
+				if (!fsess->numa_first_th[node]) fsess->numa_first_th[node] = i+1;
+			}
+			nb_cpus = gf_th_get_numa_cpus(node, cpus, FS_MAX_PIN_CPUS);
+			if (nb_cpus>FS_MAX_PIN_CPUS) nb_cpus = FS_MAX_PIN_CPUS;
+			sth->cpus = gf_malloc(sizeof(u32)*nb_cpus);
+			if (!sth->cpus) continue;
+			memcpy(sth->cpus, cpus, sizeof(u32)*nb_cpus);
+			sth->nb_cpus = nb_cpus;
+			GF_LOG(GF_LOG_INFO, GF_LOG_SCHEDULER, ("Thread %u pinned to NUMA node %u (%u CPUs)\n", i+1, node, nb_cpus));
+		}
+		return;
+	}
+	if (strcmp(opt, "core")) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_SCHEDULER, ("Unrecognized thread pinning mode %s, threads will not be pinned\n", opt));
+		return;
+	}
+
+	opt = gf_opts_get_key("core", "th-cpus");
+	nb_cpus = opt ? gf_th_parse_cpu_list(opt, cpus, FS_MAX_PIN_CPUS) : 0;
+	if (nb_cpus>FS_MAX_PIN_CPUS) nb_cpus = FS_MAX_PIN_CPUS;
+	if (!nb_cpus) {
+		GF_SystemRTInfo rti;
+		memset(&rti, 0, sizeof(GF_SystemRTInfo));
+		if (!gf_sys_get_rti(0, &rti, 0) || !rti.nb_cores) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_SCHEDULER, ("Failed to query number of cores, session threads will not be pinned\n"));
+			return;
+		}
+		for (i=0; (i<rti.nb_cores) && (i<FS_MAX_PIN_CPUS); i++)
+			cpus[i] = i;
+		nb_cpus = i;
+	}
+	for (i=0; i<nb_th; i++) {
+		GF_SessionThread *sth = gf_list_get(fsess->threads, i);
+		sth->cpus = gf_malloc(sizeof(u32));
+		if (!sth->cpus) continue;
+		sth->cpus[0] = cpus[i % nb_cpus];
+		sth->nb_cpus = 1;
+		GF_LOG(GF_LOG_INFO, GF_LOG_SCHEDULER, ("Thread %u pinned to CPU %u\n", i+1, sth->cpus[0]));
+	}
+}
+#endif
+
 GF_EXPORT
 GF_FilterSession *gf_fs_new(s32 nb_threads, GF_FilterSchedulerType sched_type, GF_FilterSessionFlags flags, const char *blacklist)
 {
@@ -217,6 +421,8 @@ GF_FilterSession *gf_fs_new(s32 nb_threads, GF_FilterSchedulerType sched_type, G
 	if (gf_sys_is_test_mode() && ! gf_props_4cc_check_props())
 		return NULL;
 
+	gf_props_builtin_init();
+
 	GF_SAFEALLOC(fsess, GF_FilterSession);
 	if (!fsess) {
 		GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Failed to alloc media session\n"));
@@ -325,9 +531,6 @@ GF_FilterSession *gf_fs_new(s32 nb_threads, GF_FilterSchedulerType sched_type, G
 		fsess->props_mx = gf_mx_new("FilterSessionProps");
 
 	if (!(flags & GF_FS_FLAG_NO_RESERVOIR)) {
-#if GF_PROPS_HASHTABLE_SIZE
-		fsess->prop_maps_list_reservoir = gf_fq_new(fsess->props_mx);
-#endif
 		fsess->prop_maps_reservoir = gf_fq_new(fsess->props_mx);
 		fsess->prop_maps_entry_reservoir = gf_fq_new(fsess->props_mx);
 		fsess->prop_maps_entry_data_alloc_reservoir = gf_fq_new(fsess->props_mx);
@@ -368,8 +571,18 @@ GF_FilterSession *gf_fs_new(s32 nb_threads, GF_FilterSchedulerType sched_type, G
 			continue;
 		}
 		sess_thread->fsess = fsess;
+		if (sched_type==GF_FS_SCHEDULER_WORK_STEAL) {
+			sess_thread->tasks_mx = gf_mx_new(szName);
+			sess_thread->tasks = gf_fq_new(sess_thread->tasks_mx);
+		}
 		gf_list_add(fsess->threads, sess_thread);
 	}
+	if ((sched_type==GF_FS_SCHEDULER_WORK_STEAL) && fsess->threads && gf_list_count(fsess->threads)) {
+		fsess->work_steal = GF_TRUE;
+		GF_LOG(GF_LOG_INFO, GF_LOG_SCHEDULER, ("Session using per-thread task lists with work stealing\n"));
+	}
+	if (fsess->threads)
+		gf_fs_setup_thread_pinning(fsess);
 #endif
 
 	gf_fs_set_separators(fsess, NULL);
@@ -542,6 +755,7 @@ GF_FilterSession *gf_fs_new_defaults(GF_FilterSessionFlags inflags)
 	else if (!strcmp(opt, "direct")) sched_type = GF_FS_SCHEDULER_DIRECT;
 	else if (!strcmp(opt, "free")) sched_type = GF_FS_SCHEDULER_LOCK_FREE;
 	else if (!strcmp(opt, "freex")) sched_type = GF_FS_SCHEDULER_LOCK_FREE_X;
+	else if (!strcmp(opt, "steal")) sched_type = GF_FS_SCHEDULER_WORK_STEAL;
 	else {
 		GF_LOG(GF_LOG_ERROR, GF_LOG_FILTER, ("Unrecognized scheduler type %s\n", opt));
 		return NULL;
@@ -828,6 +1042,12 @@ void gf_fs_del(GF_FilterSession *fsess)
 		while (gf_list_count(fsess->threads)) {
 			GF_SessionThread *sess_th = gf_list_pop_back(fsess->threads);
 			gf_th_del(sess_th->th);
+			if (sess_th->tasks)
+				gf_fq_del(sess_th->tasks, gf_task_del);
+			if (sess_th->tasks_mx)
+				gf_mx_del(sess_th->tasks_mx);
+			if (sess_th->cpus)
+				gf_free(sess_th->cpus);
 			gf_free(sess_th);
 		}
 		gf_list_del(fsess->threads);
@@ -836,10 +1056,6 @@ void gf_fs_del(GF_FilterSession *fsess)
 
 	if (fsess->prop_maps_reservoir)
 		gf_fq_del(fsess->prop_maps_reservoir, gf_propmap_del);
-#if GF_PROPS_HASHTABLE_SIZE
-	if (fsess->prop_maps_list_reservoir)
-		gf_fq_del(fsess->prop_maps_list_reservoir, (gf_destruct_fun) gf_list_del);
-#endif
 	if (fsess->prop_maps_entry_reservoir)
 		gf_fq_del(fsess->prop_maps_entry_reservoir, gf_void_del);
 	if (fsess->prop_maps_entry_data_alloc_reservoir)
@@ -860,6 +1076,16 @@ void gf_fs_del(GF_FilterSession *fsess)
 	if (fsess->semaphore_other && (fsess->semaphore_other != fsess->semaphore_main) )
 		gf_sema_del(fsess->semaphore_other);
 
+	if (fsess->numa_semas) {
+		u32 i;
+		for (i=0; i<fsess->nb_numa_nodes; i++) {
+			if (fsess->numa_semas[i]) gf_sema_del(fsess->numa_semas[i]);
+		}
+		gf_free(fsess->numa_semas);
+	}
+	if (fsess->numa_first_th)
+		gf_free(fsess->numa_first_th);
+
 	if (fsess->semaphore_main)
 		gf_sema_del(fsess->semaphore_main);
 
@@ -1062,9 +1288,16 @@ void gf_fs_post_task_ex(GF_FilterSession *fsess, gf_fs_task_callback task_fun, G
 			gf_fq_add(fsess->main_thread_tasks, task);
 			gf_fs_sema_io(fsess, GF_TRUE, GF_TRUE);
 		} else {
+			u32 numa_node;
 			gf_assert(task->run_task);
-			gf_fq_add(fsess->tasks, task);
-			gf_fs_sema_io(fsess, GF_TRUE, GF_FALSE);
+			if (gf_fq_add(fs_secondary_task_list(fsess, filter, &numa_node), task)) {
+				//secondary list could not grow, fallback to main task list rather than losing the task
+				task->force_main = GF_TRUE;
+				gf_fq_add(fsess->main_thread_tasks, task);
+				gf_fs_sema_io(fsess, GF_TRUE, GF_TRUE);
+			} else {
+				gf_fs_sema_io_node(fsess, GF_TRUE, GF_FALSE, numa_node);
+			}
 		}
 	}
 }
@@ -1531,6 +1764,17 @@ void gf_fs_print_debug_info(GF_FilterSession *fsess, GF_SessionDebugFlag dbg_fla
 			i=0;
 			gf_fq_enum(fsess->tasks, print_task_list, &i);
 		}
+#ifndef GPAC_DISABLE_THREADS
+		if (fsess->work_steal) {
+			u32 k, nb_th = gf_list_count(fsess->threads);
+			for (k=0; k<nb_th; k++) {
+				GF_SessionThread *sth = gf_list_get(fsess->threads, k);
+				fprintf(stderr, "Thread %u tasks:\n", k+1);
+				i=0;
+				gf_fq_enum(sth->tasks, print_task_list, &i);
+			}
+		}
+#endif
 	}
 
 	if (dbg_flags & GF_FS_DEBUG_FILTERS) {
@@ -1653,6 +1897,8 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 	//first time we enter the thread proc
 	if (!sess_thread->th_id) {
 		sess_thread->th_id = gf_th_id();
+		if (sess_thread->nb_cpus)
+			gf_th_set_affinity(NULL, sess_thread->cpus, sess_thread->nb_cpus);
 #ifdef GPAC_CONFIG_EMSCRIPTEN
 		if (fsess->non_blocking && thid) {
 			sess_thread->run_time = 0;
@@ -1708,7 +1954,7 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 			gf_rmt_begin(sema_wait, GF_RMT_AGGREGATE);
 			GF_LOG(GF_LOG_DEBUG, GF_LOG_SCHEDULER, ("Thread %s Waiting scheduler %s semaphore\n", sys_thid, use_main_sema ? "main" : "secondary"));
 			//wait for something to be done
-			gf_fs_sema_io(fsess, GF_FALSE, use_main_sema);
+			gf_fs_sema_io_node(fsess, GF_FALSE, use_main_sema, sess_thread->numa_node);
 			consecutive_filter_tasks = 0;
 			gf_rmt_end();
 		}
@@ -1724,12 +1970,13 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 					task = gf_fq_pop(fsess->main_thread_tasks);
 				}
 				if (!task) {
-					task = gf_fq_pop(fsess->tasks);
+					task = fs_pop_secondary_task(fsess, sess_thread, thid);
 					//if task is blocking, don't use it, let a secondary thread deal with it
 					if (task && task->blocking) {
-						gf_fq_add(fsess->tasks, task);
+						u32 numa_node;
+						gf_fq_add(fs_secondary_task_list(fsess, task->filter, &numa_node), task);
 						task = NULL;
-						gf_fs_sema_io(fsess, GF_TRUE, GF_FALSE);
+						gf_fs_sema_io_node(fsess, GF_TRUE, GF_FALSE, numa_node);
 					}
 				}
 				force_secondary_tasks = GF_FALSE;
@@ -1742,7 +1989,7 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 				}
 #endif
 			} else {
-				task = gf_fq_pop(fsess->tasks);
+				task = fs_pop_secondary_task(fsess, sess_thread, thid);
 				if (task && (task->force_main || (task->filter && task->filter->nb_main_thread_forced) ) ) {
 					//post to main
 					gf_fq_add(fsess->main_thread_tasks, task);
@@ -1816,7 +2063,7 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 
 			//no pending tasks and first time main task queue is empty, flush to detect if we
 			//are indeed done
-			if (!fsess->tasks_pending && !fsess->tasks_in_process && !sess_thread->has_seen_eot && !gf_fq_count(fsess->tasks)) {
+			if (!fsess->tasks_pending && !fsess->tasks_in_process && !sess_thread->has_seen_eot && !fs_secondary_tasks_count(fsess)) {
 				//maybe last task, force a notify to check if we are truly done
 				sess_thread->has_seen_eot = GF_TRUE;
 				//not main thread and some tasks pending on main, notify only ourselves
@@ -1828,7 +2075,7 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 					GF_LOG(GF_LOG_DEBUG, GF_LOG_SCHEDULER, ("Thread %u notify scheduler main semaphore\n", gf_th_id()));
 					gf_sema_notify(fsess->semaphore_main, 1);
 					GF_LOG(GF_LOG_DEBUG, GF_LOG_SCHEDULER, ("Thread %u notify scheduler secondary semaphore %d\n", gf_th_id(), th_count));
-					gf_sema_notify(fsess->semaphore_other, th_count);
+					fs_sema_notify_secondary(fsess, th_count);
 				}
 			}
 			//this thread and the main thread are done but we still have unfinished threads, re-notify everyone
@@ -1836,7 +2083,7 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 				GF_LOG(GF_LOG_DEBUG, GF_LOG_SCHEDULER, ("Thread %u notify scheduler main semaphore\n", gf_th_id()));
 				gf_sema_notify(fsess->semaphore_main, 1);
 				GF_LOG(GF_LOG_DEBUG, GF_LOG_SCHEDULER, ("Thread %u notify scheduler secondary semaphore %d\n", gf_th_id(), th_count));
-				gf_sema_notify(fsess->semaphore_other, th_count);
+				fs_sema_notify_secondary(fsess, th_count);
 			}
 
 			//no main thread, return
@@ -1872,24 +2119,34 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 #endif
 		current_filter = task->filter;
 
-		//unless task was explicitly forced to main (pid init mostly), reschedule if filter is not on desired thread
+		//unless task was explicitly forced to main (pid init mostly), reschedule if filter is not on desired thread or NUMA node
 		if (current_filter && !task->force_main
-			&& current_filter->restrict_th_idx
-			&& (thid != current_filter->restrict_th_idx)
+			&& ((current_filter->restrict_th_idx && (thid != current_filter->restrict_th_idx))
+				//only check NUMA node when starting to process the filter
+				|| (task->notified && !current_filter->restrict_th_idx && sess_thread->numa_node && current_filter->numa_node && (current_filter->numa_node != sess_thread->numa_node))
+			)
 		) {
+			u32 numa_node;
 			//reschedule task to secondary list
 			if (!task->notified) {
 				task->notified = GF_TRUE;
 				safe_int_inc(&fsess->tasks_pending);
 			}
-			gf_fq_add(fsess->tasks, task);
-			gf_fs_sema_io(fsess, GF_TRUE, GF_FALSE);
+			gf_fq_add(fs_secondary_task_list(fsess, current_filter, &numa_node), task);
+			gf_fs_sema_io_node(fsess, GF_TRUE, GF_FALSE, numa_node);
 #ifndef GPAC_DISABLE_LOG
 			gf_log_pop_extra(current_filter->logs);
 #endif
 			current_filter = NULL;
 			continue;
 		}
+		//remember last thread processing this filter for task affinity
+		if (current_filter) {
+			current_filter->last_th_idx = thid;
+			//first processing of a source filter on a NUMA-pinned thread, bind the filter (and its chain) to the node
+			if (!current_filter->numa_node && sess_thread->numa_node && !(current_filter->freg->flags & GF_FS_REG_MAIN_THREAD))
+				current_filter->numa_node = sess_thread->numa_node;
+		}
 
 		//this is a crude way of scheduling the next task, we should
 		//1- have a way to make sure we will not repost after a time-consuming task
@@ -2081,15 +2338,17 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 								gf_fs_sema_io(fsess, GF_TRUE, GF_TRUE);
 							}
 						} else {
+							u32 numa_node;
 							pending_tasks = gf_fq_count(fsess->main_thread_tasks);
-							gf_fq_add(fsess->tasks, task);
+							gf_fq_add(fs_secondary_task_list(fsess, task->filter, &numa_node), task);
 							//we are not the main thread and we are reposting to the secondary task list, don't notify/wait for the sema, just retry
 							//we are not sure to get a task from secondary list at next iteration, but the end of thread check will make
 							//sure we renotify secondary sema if some tasks are still pending
-							if (!use_main_sema) {
+							//if the task is bound to another NUMA node, we cannot run it, notify threads of that node
+							if (!use_main_sema && (!numa_node || (numa_node==sess_thread->numa_node))) {
 								skip_next_sema_wait = GF_TRUE;
 							} else {
-								gf_fs_sema_io(fsess, GF_TRUE, GF_FALSE);
+								gf_fs_sema_io_node(fsess, GF_TRUE, GF_FALSE, numa_node);
 							}
 						}
 						//we temporary force the main thread to fetch a task from the secondary list
@@ -2285,6 +2544,7 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 				task->notified = GF_FALSE;
 				//keep this thread running on the current filter no signaling of semaphore
 			} else {
+				u32 numa_node = 0;
 				GF_LOG(GF_LOG_DEBUG, GF_LOG_SCHEDULER, ("Thread %s re-posted task Filter %s::%s in %s tasks (%d pending)\n", sys_thid, task->filter ? task->filter->name : "none", task->log_name, (task->filter && (task->filter->freg->flags & GF_FS_REG_MAIN_THREAD)) ? "main" : "secondary", fsess->tasks_pending));
 
 				task->notified = GF_TRUE;
@@ -2304,14 +2564,14 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 #ifndef GPAC_DISABLE_THREADS
 					//FIXME, we sometimes miss a sema notfiy resulting in secondary tasks being locked
 					//until we find the cause, notify secondary sema if non-main-thread tasks are scheduled and we are the only task in main
-					if (use_main_sema && (thid==0) && fsess->threads && (gf_fq_count(fsess->main_thread_tasks)==1) && gf_fq_count(fsess->tasks)) {
+					if (use_main_sema && (thid==0) && fsess->threads && (gf_fq_count(fsess->main_thread_tasks)==1) && fs_secondary_tasks_count(fsess)) {
 						gf_fs_sema_io(fsess, GF_TRUE, GF_FALSE);
 					}
 #endif
 				} else {
-					gf_fq_add(fsess->tasks, task);
+					gf_fq_add(fs_secondary_task_list(fsess, task->filter, &numa_node), task);
 				}
-				gf_fs_sema_io(fsess, GF_TRUE, use_main_sema);
+				gf_fs_sema_io_node(fsess, GF_TRUE, use_main_sema, numa_node);
 			}
 		} else {
 #ifdef CHECK_TASK_LIST_INTEGRITY
@@ -2348,7 +2608,7 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 			current_filter->in_process = GF_FALSE;
 		}
 		//not requeuing and first time we have an empty task queue, flush to detect if we are indeed done
-		if (!current_filter && !fsess->tasks_pending && !sess_thread->has_seen_eot && !gf_fq_count(fsess->tasks)) {
+		if (!current_filter && !fsess->tasks_pending && !sess_thread->has_seen_eot && !fs_secondary_tasks_count(fsess)) {
 			//if not the main thread, or if main thread and task list is empty, enter end of session probing mode
 			if (thid || !gf_fq_count(fsess->main_thread_tasks) ) {
 				//maybe last task, force a notify to check if we are truly done. We only tag "session done" for the non-main
@@ -2395,7 +2655,7 @@ static u32 gf_fs_thread_proc(GF_SessionThread *sess_thread)
 	if (fsess->semaphore_main && ! gf_sema_notify(fsess->semaphore_main, 1)) {
 		GF_LOG(GF_LOG_ERROR, GF_LOG_SCHEDULER, ("Failed to notify main semaphore, might hang up !!\n"));
 	}
-	if (fsess->semaphore_other && ! gf_sema_notify(fsess->semaphore_other, th_count)) {
+	if (fsess->semaphore_other && ! fs_sema_notify_secondary(fsess, th_count)) {
 		GF_LOG(GF_LOG_ERROR, GF_LOG_SCHEDULER, ("Failed to notify secondary semaphore, might hang up !!\n"));
 	}
 
@@ -2639,7 +2899,7 @@ GF_Err gf_fs_stop(GF_FilterSession *fsess)
 		if (gf_fq_count(fsess->main_thread_tasks))
 			continue;
 
-		if (count && (count == fsess->nb_threads_stopped) && gf_fq_count(fsess->tasks) ) {
+		if (count && (count == fsess->nb_threads_stopped) && fs_secondary_tasks_count(fsess) ) {
 			continue;
 		}
 		break;
@@ -2794,7 +3054,11 @@ void gf_fs_print_stats(GF_FilterSession *fsess)
 	for (i=0; i<count; i++) {
 		GF_SessionThread *s = gf_list_get(fsess->threads, i);
 
-		GF_LOG(GF_LOG_INFO, GF_LOG_APP, ("\tThread %u: run_time "LLU" us active_time "LLU" us nb_tasks "LLU"\n", i+2, s->run_time, s->active_time, s->nb_tasks));
+		if (fsess->work_steal) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_APP, ("\tThread %u: run_time "LLU" us active_time "LLU" us nb_tasks "LLU" nb_steals "LLU"\n", i+2, s->run_time, s->active_time, s->nb_tasks, s->nb_steals));
+		} else {
+			GF_LOG(GF_LOG_INFO, GF_LOG_APP, ("\tThread %u: run_time "LLU" us active_time "LLU" us nb_tasks "LLU"\n", i+2, s->run_time, s->active_time, s->nb_tasks));
+		}
 
 		run_time+=s->run_time;
 		active_time+=s->active_time;
@@ -4227,7 +4491,7 @@ Bool gf_fs_is_last_task(GF_FilterSession *fsess)
 	if (!fsess) return GF_TRUE;
 	if (fsess->tasks_pending>1) return GF_FALSE;
 	if (gf_fq_count(fsess->main_thread_tasks)) return GF_FALSE;
-	if (gf_fq_count(fsess->tasks)) return GF_FALSE;
+	if (fs_secondary_tasks_count(fsess)) return GF_FALSE;
 	if (fsess->non_blocking && fsess->tasks_in_process) return GF_FALSE;
 	return GF_TRUE;
 }
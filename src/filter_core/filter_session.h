@@ -52,6 +52,10 @@ struct __gf_prop_entry
 	u32 p4cc;
 	Bool name_alloc;
 	char *pname;
+	//builtin property slot + 1 for builtin 4CCs, 0 otherwise
+	u32 bslot;
+	//hash key of the property for secondary index
+	u32 hkey;
 
 	GF_PropertyValue prop;
 	u32 alloc_size;
@@ -62,19 +66,24 @@ struct __gf_prop_entry
 
 #define GF_FS_FLAG_FORCE_DEBUG	(1<<30)
 
-#ifndef GF_PROPS_HASHTABLE_SIZE
-#define GF_PROPS_HASHTABLE_SIZE 0
-#endif
+//number of properties in a map above which lookups use the map index
+#define GF_PROPS_INDEX_MIN	8
 
 void gf_propmap_del(void *pmap);
 
 typedef struct
 {
-#if GF_PROPS_HASHTABLE_SIZE
-	GF_List *hash_table[GF_PROPS_HASHTABLE_SIZE];
-#else
+	//properties in insertion order
 	GF_List *properties;
-#endif
+	//index of builtin properties, one dense slot per builtin property (cf gf_props_builtin_slot)
+	GF_PropertyEntry **idx_builtin;
+	//open-addressing index of other properties (custom 4CCs, names), linear probing on entry hkey
+	GF_PropertyEntry **idx_other;
+	u32 idx_other_size, nb_other;
+	//set when index is valid, index is only built for maps with more than GF_PROPS_INDEX_MIN properties
+	Bool indexed;
+	//set when the same property was added twice (merge), removal rebuilds the index
+	Bool has_dups;
 	volatile u32 reference_count;
 	//number of references hold by packet references - since these may be destroyed at the end of the referring filter
 	//the pid might be dead. This is only used for pid props maps
@@ -89,19 +98,18 @@ void gf_props_del(GF_PropertyMap *prop);
 void gf_props_reset(GF_PropertyMap *prop);
 
 GF_Err gf_props_set_property(GF_PropertyMap *map, u32 p4cc, const char *name, char *dyn_name, const GF_PropertyValue *value);
-GF_Err gf_props_insert_property(GF_PropertyMap *map, u32 hash, u32 p4cc, const char *name, char *dyn_name, const GF_PropertyValue *value);
+GF_Err gf_props_insert_property(GF_PropertyMap *map, u32 p4cc, const char *name, char *dyn_name, const GF_PropertyValue *value);
 
-void gf_props_remove_property(GF_PropertyMap *map, u32 hash, u32 p4cc, const char *name);
+void gf_props_remove_property(GF_PropertyMap *map, u32 p4cc, const char *name);
 
 const GF_PropertyValue *gf_props_get_property(GF_PropertyMap *map, u32 prop_4cc, const char *name);
 
 const GF_PropertyEntry *gf_props_get_property_entry(GF_PropertyMap *map, u32 prop_4cc, const char *name);
 
-#if GF_PROPS_HASHTABLE_SIZE
-u32 gf_props_hash_djb2(u32 p4cc, const char *str);
-#else
-#define gf_props_hash_djb2(_a, _b) 0
-#endif
+//returns builtin property slot + 1 for the given 4CC, or 0 if not a builtin property
+u32 gf_props_builtin_slot(u32 p4cc);
+//builds builtin property hash, called at session creation
+void gf_props_builtin_init();
 
 GF_Err gf_props_merge_property(GF_PropertyMap *dst_props, GF_PropertyMap *src_props, gf_filter_prop_filter filter_prop, void *cbk);
 
@@ -117,7 +125,8 @@ typedef struct __gf_filter_queue GF_FilterQueue;
 //otherwise, a lock-free version of the fifo is used
 GF_FilterQueue *gf_fq_new(const GF_Mutex *mx);
 void gf_fq_del(GF_FilterQueue *fq, void (*item_delete)(void *) );
-void gf_fq_add(GF_FilterQueue *fq, void *item);
+//adds an item to the queue, returns GF_OUT_OF_MEM if the item could not be added
+GF_Err gf_fq_add(GF_FilterQueue *fq, void *item);
 void *gf_fq_pop(GF_FilterQueue *fq);
 void *gf_fq_head(GF_FilterQueue *fq);
 u32 gf_fq_count(GF_FilterQueue *fq);
@@ -232,6 +241,13 @@ typedef struct __gf_filter_pck_info
 
 } GF_FilterPckInfo;
 
+typedef struct
+{
+	//packet holding the data, NULL for bytes stored in the segmented packet itself
+	struct __gf_filter_pck *ref;
+	u32 offset, size;
+} GF_FilterPacketSegment;
+
 struct __gf_filter_pck
 {
 	struct __gf_filter_pck *pck; //this object
@@ -258,7 +274,14 @@ struct __gf_filter_pck
 	struct __gf_filter_pck *reference;
 
 	GF_FilterFrameInterface *frame_ifce;
-	
+
+	//for segmented packets, data ranges in other packets or in seg_inline. The data buffer is only filled upon request
+	GF_FilterPacketSegment *segs;
+	u32 nb_segs, alloc_segs;
+	u8 *seg_inline;
+	u32 seg_inline_size, seg_inline_alloc;
+	u8 seg_flat;
+
 	//properties applying to this packet
 	GF_PropertyMap *props;
 	//pid properties applying to this packet
@@ -335,7 +358,19 @@ typedef struct __gf_fs_thread
 
 	Bool has_seen_eot; //set when no more tasks in global queue
 
+	//local task list in work-stealing mode, NULL otherwise or for main thread
+	GF_FilterQueue *tasks;
+	GF_Mutex *tasks_mx;
+
+	//CPUs the thread is pinned to, NULL if not pinned
+	u32 *cpus;
+	u32 nb_cpus;
+	//1-based NUMA node the thread is pinned to, 0 if not pinned to a node
+	u32 numa_node;
+
 	u64 nb_tasks;
+	//number of tasks stolen from other threads
+	u64 nb_steals;
 	u64 run_time;
 	u64 active_time;
 
@@ -379,6 +414,8 @@ struct __gf_filter_session
 	u32 flags;
 	Bool use_locks;
 	Bool direct_mode;
+	//per-thread task lists with work stealing
+	Bool work_steal;
 	volatile u32 tasks_in_process;
 	Bool requires_solved_graph;
 	//non blocking session mode:
@@ -407,10 +444,6 @@ struct __gf_filter_session
 	GF_FilterQueue *prop_maps_entry_reservoir;
 	//reservoir for property entries with allocated data buffers - properties may be inherited between packets
 	GF_FilterQueue *prop_maps_entry_data_alloc_reservoir;
-#if GF_PROPS_HASHTABLE_SIZE
-	//reservoir for property maps hash table entries (GF_Lists) for PID and packets properties
-	GF_FilterQueue *prop_maps_list_reservoir;
-#endif
 	//reservoir for reference property packets - we mutualize at session level to collect them
 	//it is not possible to do so at filter or pid level because a prop ref packet may be destroyed after the source
 	//pid/packet is destroyed, and we don't want to track them per pid/filter
@@ -438,6 +471,14 @@ struct __gf_filter_session
 	GF_Semaphore *semaphore_main;
 	//semaphore for tasks posted in other task list
 	GF_Semaphore *semaphore_other;
+	//when threads are pinned to several NUMA nodes, secondary threads wait on the semaphore of their node
+	//instead of semaphore_other, so that a wake-up is never consumed by a thread not allowed to run the task
+	GF_Semaphore **numa_semas;
+	//1-based index of the first thread of each NUMA node
+	u32 *numa_first_th;
+	u32 nb_numa_nodes;
+	//round-robin counter for wake-ups not targeting a given node
+	volatile u32 numa_next_node;
 
 	volatile u32 tasks_pending;
 
@@ -637,6 +678,10 @@ struct __gf_filter
 	//set to true when the filter is being processed by a thread
 	volatile Bool in_process;
 	u32 process_th_id, restrict_th_idx;
+	//index of the last thread (0 being main thread) which processed the filter, used for task affinity in work-stealing mode
+	u32 last_th_idx;
+	//1-based NUMA node the filter chain is bound to, 0 if none
+	u32 numa_node;
 	//user data for the filter implementation
 	void *filter_udta;
 
@@ -0,0 +1,116 @@
+#include "tests.h"
+#include <gpac/filters.h>
+
+#define UFP_SIZE	100000
+
+static void ufp_shared_del(GF_Filter *filter, GF_FilterPid *pid, GF_FilterPacket *pck) { }
+
+static GF_FilterPid *ufp_new_pid(GF_FilterSession **fs)
+{
+	GF_Err e;
+	GF_Filter *f;
+	*fs = gf_fs_new_defaults(0);
+	if (! *fs) return NULL;
+	f = gf_fs_new_filter(*fs, "pck_test", 0, &e);
+	if (!f) return NULL;
+	return gf_filter_pid_new(f);
+}
+
+//source packet kept alive by a reference, as done for stores in reframers
+static GF_FilterPacket *ufp_new_source(GF_FilterPid *pid, u32 size, u8 **data)
+{
+	u32 i;
+	GF_FilterPacket *pck = gf_filter_pck_new_alloc(pid, size, data);
+	if (!pck) return NULL;
+	for (i=0; i<size; i++) (*data)[i] = (u8) gf_rand();
+	gf_filter_pck_ref(&pck);
+	return pck;
+}
+
+//gather segments and compare with ref
+static Bool ufp_check(GF_FilterPacket *pck, const u8 *ref, u32 size)
+{
+	u32 i, pos=0, seg_size;
+	u32 nb_segs = gf_filter_pck_get_segment_count(pck);
+	for (i=0; i<nb_segs; i++) {
+		const u8 *seg = gf_filter_pck_get_segment(pck, i, &seg_size);
+		if (!seg || (pos + seg_size > size) || memcmp(seg, ref + pos, seg_size)) return GF_FALSE;
+		pos += seg_size;
+	}
+	return (pos==size) ? GF_TRUE : GF_FALSE;
+}
+
+unittest(filter_pck_segments)
+{
+	u32 size;
+	u8 *src1, *src2, *ref;
+	const u8 *data;
+	u8 hdr[4] = {0, 0, 0x12, 0x34};
+	GF_FilterPacket *s1, *s2, *pck, *sub, *shared, *blocking;
+	GF_FilterSession *fs;
+	GF_FilterPid *pid = ufp_new_pid(&fs);
+	assert_not_null(pid);
+	if (!pid) {
+		if (fs) gf_fs_del(fs);
+		return;
+	}
+	s1 = ufp_new_source(pid, UFP_SIZE, &src1);
+	s2 = ufp_new_source(pid, UFP_SIZE, &src2);
+	assert_true(s1 && s2);
+	ref = gf_malloc(4*UFP_SIZE);
+
+	//header, contiguous ranges merged, rest of packet, then trailing bytes
+	pck = gf_filter_pck_new_segmented(pid);
+	assert_not_null(pck);
+	assert_equal(gf_filter_pck_append_segment_data(pck, hdr, 4), GF_OK);
+	assert_equal(gf_filter_pck_append_segment(pck, s1, 10, 1000), GF_OK);
+	assert_equal(gf_filter_pck_append_segment(pck, s1, 1010, 500), GF_OK);
+	assert_equal(gf_filter_pck_append_segment(pck, s2, UFP_SIZE-100, 0), GF_OK);
+	assert_equal(gf_filter_pck_append_segment_data(pck, hdr, 2), GF_OK);
+	assert_equal(gf_filter_pck_append_segment_data(pck, hdr+2, 2), GF_OK);
+	//out of range
+	assert_equal(gf_filter_pck_append_segment(pck, s1, UFP_SIZE-10, 11), GF_BAD_PARAM);
+	assert_equal(gf_filter_pck_get_segment_count(pck), 4);
+
+	memcpy(ref, hdr, 4);
+	memcpy(ref+4, src1+10, 1500);
+	memcpy(ref+1504, src2+UFP_SIZE-100, 100);
+	memcpy(ref+1604, hdr, 4);
+	assert_true(ufp_check(pck, ref, 1608));
+
+	//sub-range of a segmented packet references the original segments
+	sub = gf_filter_pck_new_ref(pid, 2, 1600, pck);
+	assert_not_null(sub);
+	assert_equal(gf_filter_pck_get_segment_count(sub), 3);
+	assert_true(ufp_check(sub, ref+2, 1600));
+
+	//flattened on demand
+	data = gf_filter_pck_get_data(pck, &size);
+	assert_equal(size, 1608);
+	assert_equal_mem(data, ref, 1608);
+	assert_equal(gf_filter_pck_get_segment_count(pck), 4);
+
+	//segmented packets cannot be resized
+	assert_equal(gf_filter_pck_truncate(pck, 10), GF_BAD_PARAM);
+
+	//segments of packets whose memory is owned by their filter block that filter
+	assert_false(gf_filter_pck_is_blocking_ref(pck));
+	shared = gf_filter_pck_new_shared(pid, src2, UFP_SIZE, ufp_shared_del);
+	assert_not_null(shared);
+	gf_filter_pck_ref(&shared);
+	blocking = gf_filter_pck_new_segmented(pid);
+	assert_equal(gf_filter_pck_append_segment(blocking, s1, 0, 10), GF_OK);
+	assert_equal(gf_filter_pck_append_segment(blocking, shared, 10, 10), GF_OK);
+	assert_true(gf_filter_pck_is_blocking_ref(blocking));
+	gf_filter_pck_discard(blocking);
+	gf_filter_pck_unref(shared);
+
+	gf_filter_pck_discard(sub);
+	gf_filter_pck_discard(pck);
+	//sources are still valid until released
+	assert_equal(gf_filter_pck_get_segment_count(s1), 1);
+	gf_filter_pck_unref(s1);
+	gf_filter_pck_unref(s2);
+	gf_free(ref);
+	gf_fs_del(fs);
+}
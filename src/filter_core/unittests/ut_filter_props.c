@@ -0,0 +1,97 @@
+#include "tests.h"
+#include <gpac/filters.h>
+
+static GF_FilterPid *fpt_new_pid(GF_FilterSession **fs)
+{
+	GF_Err e;
+	GF_Filter *f;
+	*fs = gf_fs_new_defaults(0);
+	if (! *fs) return NULL;
+	f = gf_fs_new_filter(*fs, "props_test", 0, &e);
+	if (!f) return NULL;
+	return gf_filter_pid_new(f);
+}
+
+//set the nb_props first builtin uint properties, return number of properties set
+static u32 fpt_set_builtins(GF_FilterPid *pid, u32 *p4ccs, u32 nb_props)
+{
+	u32 i=0, nb=0;
+	const GF_BuiltInProperty *desc;
+	while ((nb<nb_props) && (desc = gf_props_get_description(i))) {
+		i++;
+		if ((desc->data_type != GF_PROP_UINT) || (desc->type==GF_PROP_PID_ID) || (desc->type==GF_PROP_PID_CODECID))
+			continue;
+		if (gf_filter_pid_set_property(pid, desc->type, &PROP_UINT(nb+1)) == GF_OK)
+			p4ccs[nb++] = desc->type;
+	}
+	return nb;
+}
+
+unittest(filter_props_index)
+{
+	u32 i, nb_builtin, nb_ok=0;
+	u32 p4ccs[40];
+	char szName[20];
+	const GF_PropertyValue *p;
+	GF_FilterSession *fs;
+	GF_FilterPid *pid = fpt_new_pid(&fs);
+	assert_not_null(pid);
+	if (!pid) {
+		if (fs) gf_fs_del(fs);
+		return;
+	}
+
+	nb_builtin = fpt_set_builtins(pid, p4ccs, 40);
+	assert_equal(nb_builtin, 40);
+	for (i=0; i<20; i++) {
+		sprintf(szName, "prop_%u", i);
+		gf_filter_pid_set_property_dyn(pid, szName, &PROP_UINT(100+i));
+	}
+	//custom 4CC
+	gf_filter_pid_set_property(pid, GF_4CC('u','t','f','p'), &PROP_UINT(1000));
+
+	for (i=0; i<nb_builtin; i++) {
+		p = gf_filter_pid_get_property(pid, p4ccs[i]);
+		if (p && (p->value.uint == i+1)) nb_ok++;
+	}
+	for (i=0; i<20; i++) {
+		sprintf(szName, "prop_%u", i);
+		p = gf_filter_pid_get_property_str(pid, szName);
+		if (p && (p->value.uint == 100+i)) nb_ok++;
+	}
+	p = gf_filter_pid_get_property(pid, GF_4CC('u','t','f','p'));
+	if (p && (p->value.uint == 1000)) nb_ok++;
+	assert_equal(nb_ok, nb_builtin+21);
+
+	//names are matched exactly, not by prefix
+	assert_true(gf_filter_pid_get_property_str(pid, "prop_") == NULL);
+	assert_true(gf_filter_pid_get_property_str(pid, "prop_10x") == NULL);
+
+	//remove every other property then replace the remaining ones
+	for (i=0; i<nb_builtin; i+=2)
+		gf_filter_pid_set_property(pid, p4ccs[i], NULL);
+	for (i=0; i<20; i+=2) {
+		sprintf(szName, "prop_%u", i);
+		gf_filter_pid_set_property_dyn(pid, szName, NULL);
+	}
+	for (i=1; i<nb_builtin; i+=2)
+		gf_filter_pid_set_property(pid, p4ccs[i], &PROP_UINT(2*i));
+	for (i=1; i<20; i+=2) {
+		sprintf(szName, "prop_%u", i);
+		gf_filter_pid_set_property_dyn(pid, szName, &PROP_UINT(200+i));
+	}
+
+	nb_ok = 0;
+	for (i=0; i<nb_builtin; i++) {
+		p = gf_filter_pid_get_property(pid, p4ccs[i]);
+		if ((i%2) ? (p && (p->value.uint == 2*i)) : !p) nb_ok++;
+	}
+	for (i=0; i<20; i++) {
+		sprintf(szName, "prop_%u", i);
+		p = gf_filter_pid_get_property_str(pid, szName);
+		if ((i%2) ? (p && (p->value.uint == 200+i)) : !p) nb_ok++;
+	}
+	assert_equal(nb_ok, nb_builtin+20);
+
+	gf_fs_del(fs);
+}
@@ -0,0 +1,127 @@
+#include "tests.h"
+#include "../filter_queue.c"
+
+#include <stdio.h>
+
+//items pushed per run, split across producers
+#define FQB_NB_ITEMS	(1<<14)
+#define FQB_NB_BENCH_ITEMS	(1<<17)
+#define FQB_MAX_THREADS	64
+
+typedef struct
+{
+	GF_FilterQueue *fq;
+	u32 nb_items, total;
+	volatile u32 nb_popped;
+	u64 sum;
+} FQTest;
+
+typedef struct
+{
+	FQTest *b;
+	u32 idx;
+	u64 sum;
+} FQTestThread;
+
+static u32 fqb_produce(void *par)
+{
+	u32 i;
+	FQTestThread *t = (FQTestThread *)par;
+	for (i=0; i<t->b->nb_items; i++) {
+		//never push NULL
+		gf_fq_add(t->b->fq, (void *) (uintptr_t) (t->idx * t->b->nb_items + i + 1));
+	}
+	return 0;
+}
+
+static u32 fqb_consume(void *par)
+{
+	FQTestThread *t = (FQTestThread *)par;
+	while (t->b->nb_popped < t->b->total) {
+		void *data = gf_fq_pop(t->b->fq);
+		if (!data) {
+			gf_sleep(0);
+			continue;
+		}
+		t->sum += (uintptr_t) data;
+		safe_int_inc(&t->b->nb_popped);
+	}
+	return 0;
+}
+
+//run one producers/consumers configuration, returns GF_FALSE if items were lost or duplicated
+static Bool fqb_run(Bool use_ring, u32 nb_prod, u32 nb_cons, u32 nb_items, u64 *elapsed_us)
+{
+	u32 i;
+	u64 start, sum=0, expected;
+	GF_Thread *th[2*FQB_MAX_THREADS];
+	FQTestThread args[2*FQB_MAX_THREADS];
+	FQTest b;
+	memset(&b, 0, sizeof(FQTest));
+	memset(args, 0, sizeof(args));
+	b.fq = gf_fq_new_internal(NULL, use_ring);
+	b.nb_items = nb_items / nb_prod;
+	b.total = b.nb_items * nb_prod;
+	expected = (u64) b.total * (b.total + 1) / 2;
+
+	start = gf_sys_clock_high_res();
+	for (i=0; i<nb_prod+nb_cons; i++) {
+		args[i].b = &b;
+		args[i].idx = (i<nb_prod) ? i : 0;
+		th[i] = gf_th_new("FQTest");
+		gf_th_run(th[i], (i<nb_prod) ? fqb_produce : fqb_consume, &args[i]);
+	}
+	for (i=0; i<nb_prod+nb_cons; i++) {
+		gf_th_stop(th[i]);
+		gf_th_del(th[i]);
+		sum += args[i].sum;
+	}
+	if (elapsed_us) *elapsed_us = gf_sys_clock_high_res() - start;
+
+	assert_equal(gf_fq_count(b.fq), 0);
+	assert_true(gf_fq_pop(b.fq) == NULL);
+	gf_fq_del(b.fq, NULL);
+	return (sum == expected) ? GF_TRUE : GF_FALSE;
+}
+
+unittest(filter_queue_ring)
+{
+	u32 i;
+	GF_FilterQueue *fq = gf_fq_new_internal(NULL, GF_TRUE);
+	//fill beyond initial size to force ring growth, check order is preserved
+	for (i=1; i<=1000; i++)
+		gf_fq_add(fq, (void *) (uintptr_t) i);
+	assert_equal(gf_fq_count(fq), 1000);
+	assert_true(gf_fq_head(fq) == (void *) 1);
+	assert_true(gf_fq_get(fq, 999) == (void *) 1000);
+	assert_true(gf_fq_get(fq, 1000) == NULL);
+	for (i=1; i<=500; i++) {
+		if (gf_fq_pop(fq) != (void *) (uintptr_t) i) break;
+	}
+	assert_equal(i, 501);
+	assert_equal(gf_fq_count(fq), 500);
+	gf_fq_del(fq, NULL);
+}
+
+unittest(filter_queue_concurrent)
+{
+	u32 i;
+	for (i=1; i<=4; i*=2) {
+		assert_true(fqb_run(GF_FALSE, i, i, FQB_NB_ITEMS, NULL));
+		assert_true(fqb_run(GF_TRUE, i, i, FQB_NB_ITEMS, NULL));
+	}
+}
+
+//list backend versus ring backend (-fq-ring), same number of producers and consumers
+unittest(filter_queue_bench)
+{
+	u32 i;
+	printf("\nproducers/consumers\tlist (ops/s)\tring (ops/s)\n");
+	for (i=1; i<=FQB_MAX_THREADS; i*=2) {
+		u64 t_list=0, t_ring=0;
+		u32 total = (FQB_NB_BENCH_ITEMS / i) * i;
+		assert_true(fqb_run(GF_FALSE, i, i, FQB_NB_BENCH_ITEMS, &t_list));
+		assert_true(fqb_run(GF_TRUE, i, i, FQB_NB_BENCH_ITEMS, &t_ring));
+		printf("%u/%u\t\t\t"LLU"\t\t"LLU"\n", i, i, (u64) total * 1000000 / MAX(t_list, 1), (u64) total * 1000000 / MAX(t_ring, 1));
+	}
+}
@@ -289,6 +289,8 @@ typedef struct
 	u32 forward_mode;
 
 	u8 last_hls_signature[GF_SHA1_DIGEST_SIZE], last_mpd_signature[GF_SHA1_DIGEST_SIZE], last_hls2_signature[GF_SHA1_DIGEST_SIZE];
+	//memory file for manifest serialization, reused across updates
+	FILE *manifest_mem;
 
 	GF_CryptInfo *cinfo;
 
@@ -4806,18 +4808,19 @@ static void dasher_update_period_duration(GF_DasherCtx *ctx, Bool is_period_swit
 static void dasher_transfer_file(FILE *f, GF_FilterPid *opid, const char *name, GF_DashStream *ds, Bool is_rel_url)
 {
 	GF_FilterPacket *pck;
-	u32 size, nb_read;
-	u8 *output;
+	u32 size;
+	u8 *output, *data;
 
-	size = (u32) gf_fsize(f);
+	//manifests are serialized in memory files
+	data = gf_file_mem_get_data(f, &size);
+	if (!data) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[Dasher] Empty manifest file, not sending\n"));
+		return;
+	}
 
 	pck = gf_filter_pck_new_alloc(opid, size, &output);
 	if (!pck) return;
-
-	nb_read = (u32) gf_fread(output, size, f);
-	if (nb_read != size) {
-		GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[Dasher] Error reading temp MPD file, read %d bytes but file size is %d\n", nb_read, size ));
-	}
+	memcpy(output, data, size);
 
 	gf_filter_pck_set_framing(pck, GF_TRUE, GF_TRUE);
 	gf_filter_pck_set_seek_flag(pck, GF_TRUE);
@@ -5028,7 +5031,7 @@ static void dasher_forward_mpd(GF_DasherCtx *ctx, const char *manifest)
 
 
 	//and send
-	tmp = gf_file_temp(NULL);
+	tmp = gf_file_mem_new();
 	mpd->xml_namespace = ctx->mpd->xml_namespace;
 	mpd->publishTime = dasher_get_utc(ctx);
 	e = gf_mpd_write(mpd, tmp, ctx->cmpd);
@@ -5317,6 +5320,8 @@ static GF_Err dasher_write_and_send_manifest(GF_DasherCtx *ctx, u64 last_period_
 	u8 sig[GF_SHA1_DIGEST_SIZE];
 	GF_Err e;
 	FILE *tmp;
+	u8 *data;
+	u32 size;
 
 	ctx->mpd->segment_template = ctx->template;
 	if (ctx->do_index==1) {
@@ -5325,7 +5330,12 @@ static GF_Err dasher_write_and_send_manifest(GF_DasherCtx *ctx, u64 last_period_
 	if (ctx->from_index)
 		ctx->mpd->m3u8_use_repid = GF_TRUE;
 
-	tmp = gf_file_temp(NULL);
+	if (!ctx->manifest_mem) {
+		ctx->manifest_mem = gf_file_mem_new();
+		if (!ctx->manifest_mem) return GF_OUT_OF_MEM;
+	}
+	tmp = ctx->manifest_mem;
+	gf_file_mem_reset(tmp);
 	if (do_m3u8) {
 		GF_M3U8WriteMode mode = GF_M3U8_WRITE_ALL;
 		if (ctx->from_index==IDXMODE_MANIFEST) mode = GF_M3U8_WRITE_MASTER;
@@ -5354,18 +5364,18 @@ static GF_Err dasher_write_and_send_manifest(GF_DasherCtx *ctx, u64 last_period_
 
 	if (e) {
 		GF_LOG(GF_LOG_ERROR, GF_LOG_DASH, ("[Dasher] failed to write %s file: %s\n", do_m3u8 ? "M3U8" : "MPD", gf_error_to_string(e) ));
-		gf_fclose(tmp);
 		if (ctx->current_period->period)
 			ctx->current_period->period->duration = last_period_dur;
 		return e;
 	}
 
+	data = gf_file_mem_get_data(tmp, &size);
 	if (ctx->profile == GF_DASH_PROFILE_HBBTV_1_5_ISOBMF_LIVE) {
-		if (gf_ftell(tmp) > 100 * 1024)
-			GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[Dasher] manifest MPD is too big for HbbTV 1.5. Limit is 100kB, current size is "LLU"kB\n", gf_ftell(tmp) / 1024));
+		if (size > 100 * 1024)
+			GF_LOG(GF_LOG_WARNING, GF_LOG_DASH, ("[Dasher] manifest MPD is too big for HbbTV 1.5. Limit is 100kB, current size is %ukB\n", size / 1024));
 	}
 
-	gf_sha1_file_ptr(tmp, sig);
+	gf_sha1_csum(data, size, sig);
 	if (do_m3u8) {
 		last_signature = (void *) m3u8_second_pass ? ctx->last_hls2_signature : ctx->last_hls_signature;
 	} else {
@@ -5378,7 +5388,6 @@ static GF_Err dasher_write_and_send_manifest(GF_DasherCtx *ctx, u64 last_period_
 		if (ctx->from_index!=IDXMODE_CHILD)
 			dasher_transfer_file(tmp, opid, alt_name, NULL, GF_FALSE);
 	}
-	gf_fclose(tmp);
 	return GF_OK;
 }
 
@@ -10521,6 +10530,7 @@ static void dasher_finalize(GF_Filter *filter)
 	}
 	gf_list_del(ctx->pids);
 	if (ctx->mpd) gf_mpd_del(ctx->mpd);
+	if (ctx->manifest_mem) gf_fclose(ctx->manifest_mem);
 
 	while (gf_list_count(ctx->tpl_records)) {
 		DashTemplateRecord *tr = gf_list_pop_back(ctx->tpl_records);
@@ -30,6 +30,7 @@
 #include <gpac/base_coding.h>
 #include <gpac/download.h>
 #include <gpac/xml.h>
+#include <gpac/thread.h>
 #include <gpac/internal/isomedia_dev.h>
 
 #include <gpac/internal/media_dev.h>
@@ -62,6 +63,8 @@ typedef struct
 	char IV[16];
 	bin128 key;
 	u32 IV_size;
+	//CTR keystream bytes used by deferred encryption in current sample
+	u32 ctr_bytes;
 } CENC_MKey;
 
 typedef struct
@@ -126,20 +129,62 @@ typedef struct
 	GF_List *pssh_templates;
 
 	u64 num_block_crypted;
+	//encryption of current sample is done by workers
+	Bool defer_crypt;
 } GF_CENCStream;
 
+//encryption of a byte range, run by the worker pool
 typedef struct
+{
+	u8 *data;
+	u32 size;
+	bin128 key;
+	//CBC: IV - CTR: counter block at start of data
+	u8 IV[16];
+	//CTR: number of keystream bytes to discard before data
+	u32 ctr_skip;
+	u32 crypt_block, skip_block;
+	Bool ctr_mode;
+} CENCCryptJob;
+
+typedef struct _cenc_enc_ctx GF_CENCEncCtx;
+
+typedef struct
+{
+	GF_CENCEncCtx *ctx;
+	GF_Thread *th;
+	GF_Semaphore *start_sem;
+	//CBC and CTR contexts and their current keys
+	GF_Crypt *crypt[2];
+	bin128 key[2];
+	Bool key_set[2];
+} CENCWorker;
+
+struct _cenc_enc_ctx
 {
 	//options
 	const char *cfile;
 	Bool allc, bk_stats;
+	s32 nbth;
 
 	//internal
 	GF_CryptInfo *cinfo;
 
 	GF_List *streams;
 	GF_BitStream *bs_w, *bs_r;
-} GF_CENCEncCtx;
+
+	//worker 0 runs in the filter thread
+	CENCWorker *workers;
+	u32 nb_workers;
+	GF_Semaphore *done_sem;
+	Bool workers_exit;
+	CENCCryptJob *jobs;
+	u32 nb_jobs, nb_alloc_jobs;
+	//index of next job to pick, shared by workers
+	u32 next_job;
+	//packets sent once all jobs are done, in process order
+	GF_List *pending;
+};
 
 
 static GF_Err isma_enc_configure(GF_CENCEncCtx *ctx, GF_CENCStream *cstr, Bool is_isma, const char *scheme_uri, const char *kms_uri)
@@ -1664,6 +1709,109 @@ static u32 cenc_get_clear_bytes(GF_CENCStream *cstr, GF_BitStream *plaintext_bs,
 }
 #endif
 
+//with workers, output packets are sent once all pending jobs are done
+static void cenc_enc_send(GF_CENCEncCtx *ctx, GF_FilterPacket *pck)
+{
+	if (ctx->nb_workers)
+		gf_list_add(ctx->pending, pck);
+	else
+		gf_filter_pck_send(pck);
+}
+
+//CTR ranges larger than this are split across workers
+#define CENC_JOB_SIZE	(1<<15)
+
+//number of bytes encrypted in a range using a pattern
+static u32 cenc_pattern_crypt_size(u32 size, u32 crypt_block, u32 skip_block)
+{
+	u32 nb_patterns, remain;
+	if (!crypt_block || !skip_block) return size;
+	nb_patterns = size / (16*(crypt_block+skip_block));
+	remain = size - nb_patterns * 16*(crypt_block+skip_block);
+	if (remain > 16*crypt_block) remain = 16*crypt_block;
+	return nb_patterns * 16*crypt_block + remain;
+}
+
+//adds nb_blocks to a 128-bit big-endian counter
+static void cenc_ctr_add(u8 *counter, u32 nb_blocks)
+{
+	s32 i;
+	u64 carry = nb_blocks;
+	for (i=15; (i>=0) && carry; i--) {
+		carry += counter[i];
+		counter[i] = (u8) carry;
+		carry >>= 8;
+	}
+}
+
+//encrypts a range of the sample, or queues it for the workers if encryption of the sample is deferred
+static GF_Err cenc_crypt_range(GF_CENCEncCtx *ctx, GF_CENCStream *cstr, u32 key_idx, u8 *data, u32 size, Bool use_pattern)
+{
+	CENC_MKey *mkey = &cstr->keys[key_idx];
+	u32 crypt_block = use_pattern ? cstr->crypt_byte_block : 0;
+	u32 skip_block = use_pattern ? cstr->skip_byte_block : 0;
+	u32 crypt_size = cenc_pattern_crypt_size(size, crypt_block, skip_block);
+
+	cstr->num_block_crypted += crypt_size/16;
+	if (!cstr->defer_crypt)
+		return gf_crypt_encrypt_pattern(mkey->crypt, data, size, crypt_block, skip_block);
+
+	if (!crypt_block || !skip_block) crypt_block = skip_block = 0;
+	while (size) {
+		CENCCryptJob *job;
+		u32 len = size;
+		//keystream position is known for any CTR byte, split large ranges without pattern
+		if (cstr->ctr_mode && !crypt_block && (len > CENC_JOB_SIZE))
+			len = CENC_JOB_SIZE;
+
+		if (ctx->nb_jobs == ctx->nb_alloc_jobs) {
+			CENCCryptJob *jobs = gf_realloc(ctx->jobs, sizeof(CENCCryptJob) * (ctx->nb_alloc_jobs + 32));
+			//keep jobs of pending packets, the caller drops the jobs of this packet
+			if (!jobs) return GF_OUT_OF_MEM;
+			ctx->jobs = jobs;
+			ctx->nb_alloc_jobs += 32;
+		}
+		job = &ctx->jobs[ctx->nb_jobs];
+		ctx->nb_jobs++;
+		job->data = data;
+		job->size = len;
+		job->crypt_block = crypt_block;
+		job->skip_block = skip_block;
+		job->ctr_mode = cstr->ctr_mode;
+		job->ctr_skip = 0;
+		memcpy(job->key, mkey->key, 16);
+		memcpy(job->IV, mkey->IV, 16);
+		if (cstr->ctr_mode) {
+			cenc_ctr_add(job->IV, mkey->ctr_bytes / 16);
+			job->ctr_skip = mkey->ctr_bytes % 16;
+			mkey->ctr_bytes += crypt_block ? crypt_size : len;
+		}
+		data += len;
+		size -= len;
+	}
+	return GF_OK;
+}
+
+//sets CTR state of the stream keys as if the sample had been encrypted by these contexts
+static void cenc_ctr_sync_state(GF_CENCStream *cstr, u32 nb_keys)
+{
+	u32 i;
+	for (i=0; i<nb_keys; i++) {
+		u8 state[17];
+		CENC_MKey *mkey = &cstr->keys[i];
+		if (!mkey->ctr_bytes) continue;
+		state[0] = 0;
+		memcpy(state+1, mkey->IV, 16);
+		cenc_ctr_add(state+1, mkey->ctr_bytes / 16);
+		gf_crypt_set_IV(mkey->crypt, state, 17);
+		if (mkey->ctr_bytes % 16) {
+			u8 dummy[16];
+			gf_crypt_encrypt(mkey->crypt, dummy, mkey->ctr_bytes % 16);
+		}
+		mkey->ctr_bytes = 0;
+	}
+}
+
 static GF_Err cenc_encrypt_packet(GF_CENCEncCtx *ctx, GF_CENCStream *cstr, GF_FilterPacket *pck)
 {
 	GF_BitStream *sai_bs;
@@ -1693,12 +1841,16 @@ static GF_Err cenc_encrypt_packet(GF_CENCEncCtx *ctx, GF_CENCStream *cstr, GF_Fi
 		nb_subsamples_bits = 16;
 		sai_size_sub = 6;
 	}
+	//SAES adds emulation prevention bytes after encryption, and CBC with per-sample IV chains samples
+	cstr->defer_crypt = (ctx->nb_workers && !cstr->is_saes) ? GF_TRUE : GF_FALSE;
 	for (i=0; i<nb_keys; i++) {
+		cstr->keys[i].ctr_bytes = 0;
 		if (cstr->tci->keys[i].IV_size) {
 			//in cbcs scheme, if Per_Sample_IV_size is not 0 (no constant IV), fetch current IV
 			if (!cstr->ctr_mode) {
 				u32 IV_size = 16;
 				gf_crypt_get_IV(cstr->keys[i].crypt, cstr->keys[i].IV, &IV_size);
+				cstr->defer_crypt = GF_FALSE;
 			}
 			nb_iv_init++;
 		}
@@ -2018,31 +2170,16 @@ static GF_Err cenc_encrypt_packet(GF_CENCEncCtx *ctx, GF_CENCStream *cstr, GF_Fi
 					//pattern encryption
 					if (cstr->crypt_byte_block && cstr->skip_byte_block) {
 						u32 res = nalu_size - clear_bytes - clear_bytes_at_end;
-						pos = cur_pos;
 						//don't use modulo in case we use fatal_assert
 						gf_assert((res / 16) * 16 == res);
-
-						while (res) {
-							u32 to_crypt = (res >= (u32) (16*cstr->crypt_byte_block)) ? 16*cstr->crypt_byte_block : res;
-
-							e = gf_crypt_encrypt(cstr->keys[key_idx].crypt, output+pos, to_crypt);
-							cstr->num_block_crypted += to_crypt/16;
-
-							if (res >= (u32) (16 * (cstr->crypt_byte_block + cstr->skip_byte_block))) {
-								pos += 16 * (cstr->crypt_byte_block + cstr->skip_byte_block);
-								res -= 16 * (cstr->crypt_byte_block + cstr->skip_byte_block);
-							} else {
-								res = 0;
-							}
-						}
+						e = cenc_crypt_range(ctx, cstr, key_idx, output+cur_pos, res, GF_TRUE);
 					}
 					//full subsample encryption
 					else {
 						//clear_bytes_at_end is 0 unless NALU-based cbcs without pattern (not defined in CENC)
 						//in this case, we must only encrypt a multiple of 16-byte blocks
 						u32 to_crypt = nalu_size - clear_bytes - clear_bytes_at_end;
-						e = gf_crypt_encrypt(cstr->keys[key_idx].crypt, output+cur_pos, to_crypt);
-						cstr->num_block_crypted += to_crypt/16;
+						e = cenc_crypt_range(ctx, cstr, key_idx, output+cur_pos, to_crypt, GF_FALSE);
 					}
 				}
 
@@ -2135,8 +2272,7 @@ static GF_Err cenc_encrypt_packet(GF_CENCEncCtx *ctx, GF_CENCStream *cstr, GF_Fi
 		//CTR full sample
 		else if (cstr->ctr_mode) {
 			gf_bs_skip_bytes(ctx->bs_r, pck_size);
-			e = gf_crypt_encrypt(cstr->keys[0].crypt, output, pck_size);
-			cstr->num_block_crypted += pck_size/16;
+			e = cenc_crypt_range(ctx, cstr, 0, output, pck_size, GF_FALSE);
 		}
 		//CBC full sample with padding
 		else {
@@ -2153,8 +2289,7 @@ static GF_Err cenc_encrypt_packet(GF_CENCEncCtx *ctx, GF_CENCStream *cstr, GF_Fi
 
 			if (pck_size >= 16) {
 				u32 to_crypt = pck_size - clear_header - clear_trailing;
-				gf_crypt_encrypt(cstr->keys[0].crypt, output+clear_header, to_crypt);
-				cstr->num_block_crypted += to_crypt/16;
+				cenc_crypt_range(ctx, cstr, 0, output+clear_header, to_crypt, GF_FALSE);
 			}
 			gf_bs_skip_bytes(ctx->bs_r, pck_size);
 		}
@@ -2175,6 +2310,8 @@ static GF_Err cenc_encrypt_packet(GF_CENCEncCtx *ctx, GF_CENCStream *cstr, GF_Fi
 		sai_size += sai_size_sub;
 	}
 	if (cstr->ctr_mode) {
+		if (cstr->defer_crypt)
+			cenc_ctr_sync_state(cstr, nb_keys);
 		for (i=0; i<nb_keys; i++) {
 			cenc_resync_IV(cstr->keys[i].crypt, cstr->keys[i].IV, cstr->tci->keys[i].IV_size);
 		}
@@ -2393,10 +2530,12 @@ static GF_Err cenc_encrypt_packet(GF_CENCEncCtx *ctx, GF_CENCStream *cstr, GF_Fi
 		}
 	}
 
-	gf_filter_pck_send(dst_pck);
+	cenc_enc_send(ctx, dst_pck);
 	return GF_OK;
 }
 
+static void cenc_enc_flush(GF_CENCEncCtx *ctx);
+
 static GF_Err cenc_process(GF_CENCEncCtx *ctx, GF_CENCStream *cstr, GF_FilterPacket *pck)
 {
 	Bool is_encrypted = GF_TRUE;
@@ -2405,6 +2544,7 @@ static GF_Err cenc_process(GF_CENCEncCtx *ctx, GF_CENCStream *cstr, GF_FilterPac
 	Bool all_rap=GF_FALSE;
 	u32 pck_size;
 	Bool force_clear = GF_FALSE;
+	u32 nb_jobs;
 	u8 sap = gf_filter_pck_get_sap(pck);
 
 	data = gf_filter_pck_get_data(pck, &pck_size);
@@ -2488,7 +2628,7 @@ static GF_Err cenc_process(GF_CENCEncCtx *ctx, GF_CENCStream *cstr, GF_FilterPac
 			gf_filter_pck_set_property(dst_pck, GF_PROP_PCK_CENC_SAI, &PROP_DATA_NO_COPY(sai, sai_size) );
 
 		gf_filter_pck_set_crypt_flags(dst_pck, signal_sai ? GF_FILTER_PCK_CRYPT : 0);
-		gf_filter_pck_send(dst_pck);
+		cenc_enc_send(ctx, dst_pck);
 		return GF_OK;
 	}
 
@@ -2578,6 +2718,11 @@ static GF_Err cenc_process(GF_CENCEncCtx *ctx, GF_CENCStream *cstr, GF_FilterPac
 			GF_CryptKeyInfo *ki = &cstr->tci->keys[cstr->kidx];
 			u8 key_info[40];
 			u32 key_info_size = 20;
+
+			//pending packets were encrypted with the previous key, send them before updating the key info on the PID
+			if (ctx->nb_workers)
+				cenc_enc_flush(ctx);
+
 			key_info[0] = 0;
 			key_info[1] = 0;
 			key_info[2] = 0;
@@ -2596,8 +2741,11 @@ static GF_Err cenc_process(GF_CENCEncCtx *ctx, GF_CENCStream *cstr, GF_FilterPac
 		}
 	}
 
+	nb_jobs = ctx->nb_jobs;
 	e = cenc_encrypt_packet(ctx, cstr, pck);
 	if (e) {
+		//drop jobs of the discarded packet
+		ctx->nb_jobs = nb_jobs;
 		GF_LOG(GF_LOG_ERROR, GF_LOG_MEDIA, ("[CENC] Error encrypting packet %d in PID %s: %s\n", cstr->nb_pck, gf_filter_pid_get_name(cstr->ipid), gf_error_to_string(e)) );
 		return e;
 	}
@@ -2606,39 +2754,193 @@ static GF_Err cenc_process(GF_CENCEncCtx *ctx, GF_CENCStream *cstr, GF_FilterPac
 	return GF_OK;
 }
 
+static void cenc_run_job(CENCWorker *wk, CENCCryptJob *job)
+{
+	u32 idx = job->ctr_mode ? 1 : 0;
+	GF_Crypt *gc = wk->crypt[idx];
+	if (!wk->key_set[idx] || memcmp(wk->key[idx], job->key, 16)) {
+		memcpy(wk->key[idx], job->key, 16);
+		wk->key_set[idx] = GF_TRUE;
+		gf_crypt_set_key(gc, wk->key[idx]);
+	}
+	if (job->ctr_mode) {
+		u8 state[17];
+		state[0] = 0;
+		memcpy(state+1, job->IV, 16);
+		gf_crypt_set_IV(gc, state, 17);
+		if (job->ctr_skip) {
+			u8 dummy[16];
+			gf_crypt_encrypt(gc, dummy, job->ctr_skip);
+		}
+	} else {
+		gf_crypt_set_IV(gc, job->IV, 16);
+	}
+	gf_crypt_encrypt_pattern(gc, job->data, job->size, job->crypt_block, job->skip_block);
+}
+
+static void cenc_run_jobs(GF_CENCEncCtx *ctx, CENCWorker *wk)
+{
+	while (1) {
+		u32 idx = (u32) safe_int_inc(&ctx->next_job) - 1;
+		if (idx >= ctx->nb_jobs) break;
+		cenc_run_job(wk, &ctx->jobs[idx]);
+	}
+}
+
+static u32 cenc_worker_thread(void *par)
+{
+	CENCWorker *wk = (CENCWorker *) par;
+	GF_CENCEncCtx *ctx = wk->ctx;
+	while (1) {
+		gf_sema_wait(wk->start_sem);
+		if (ctx->workers_exit) break;
+		cenc_run_jobs(ctx, wk);
+		gf_sema_notify(ctx->done_sem, 1);
+	}
+	return 0;
+}
+
+static void cenc_workers_del(GF_CENCEncCtx *ctx)
+{
+	u32 i;
+	if (!ctx->workers) return;
+	ctx->workers_exit = GF_TRUE;
+	for (i=1; i<ctx->nb_workers+1; i++) {
+		gf_sema_notify(ctx->workers[i].start_sem, 1);
+		gf_th_del(ctx->workers[i].th);
+	}
+	for (i=0; i<ctx->nb_workers+1; i++) {
+		if (ctx->workers[i].start_sem) gf_sema_del(ctx->workers[i].start_sem);
+		if (ctx->workers[i].crypt[0]) gf_crypt_close(ctx->workers[i].crypt[0]);
+		if (ctx->workers[i].crypt[1]) gf_crypt_close(ctx->workers[i].crypt[1]);
+	}
+	gf_free(ctx->workers);
+	ctx->workers = NULL;
+	ctx->nb_workers = 0;
+	if (ctx->done_sem) gf_sema_del(ctx->done_sem);
+	ctx->done_sem = NULL;
+}
+
+/*setup worker contexts, worker 0 runs in the filter thread - crypto contexts are created here since opening them reads the config*/
+static GF_Err cenc_workers_setup(GF_CENCEncCtx *ctx)
+{
+	u32 i;
+	s32 nb_threads = ctx->nbth;
+	if (nb_threads<0) {
+		GF_SystemRTInfo rti;
+		gf_sys_get_rti(0, &rti, 0);
+		nb_threads = (rti.nb_cores>1) ? rti.nb_cores-1 : 0;
+	}
+#ifdef GPAC_DISABLE_THREADS
+	nb_threads = 0;
+#endif
+	if (!nb_threads) return GF_OK;
+
+	ctx->workers = gf_malloc(sizeof(CENCWorker) * (nb_threads+1));
+	if (!ctx->workers) return GF_OUT_OF_MEM;
+	memset(ctx->workers, 0, sizeof(CENCWorker) * (nb_threads+1));
+	ctx->done_sem = gf_sema_new(nb_threads, 0);
+	if (!ctx->done_sem) return GF_OUT_OF_MEM;
+
+	for (i=0; i<(u32) nb_threads+1; i++) {
+		CENCWorker *wk = &ctx->workers[i];
+		wk->ctx = ctx;
+		wk->crypt[0] = gf_crypt_open(GF_AES_128, GF_CBC);
+		wk->crypt[1] = gf_crypt_open(GF_AES_128, GF_CTR);
+		if (!wk->crypt[0] || !wk->crypt[1]) return GF_IO_ERR;
+		//no key yet
+		gf_crypt_init(wk->crypt[0], wk->key[0], wk->key[0]);
+		gf_crypt_init(wk->crypt[1], wk->key[1], wk->key[1]);
+		if (!i) continue;
+
+		wk->start_sem = gf_sema_new(1, 0);
+		wk->th = gf_th_new("cenc_crypt");
+		if (!wk->start_sem || !wk->th || (gf_th_run(wk->th, cenc_worker_thread, wk) != GF_OK)) {
+			if (wk->th) gf_th_del(wk->th);
+			if (wk->start_sem) gf_sema_del(wk->start_sem);
+			wk->th = NULL;
+			wk->start_sem = NULL;
+			break;
+		}
+		ctx->nb_workers++;
+	}
+	GF_LOG(GF_LOG_INFO, GF_LOG_MEDIA, ("[CENC] Using %d threads for sample encryption\n", ctx->nb_workers+1));
+	return GF_OK;
+}
+
+//run all jobs, then send pending packets in order
+static void cenc_enc_flush(GF_CENCEncCtx *ctx)
+{
+	if (ctx->nb_jobs) {
+		u32 i;
+		ctx->next_job = 0;
+		for (i=0; i<ctx->nb_workers; i++)
+			gf_sema_notify(ctx->workers[i+1].start_sem, 1);
+		cenc_run_jobs(ctx, &ctx->workers[0]);
+		for (i=0; i<ctx->nb_workers; i++)
+			gf_sema_wait(ctx->done_sem);
+		ctx->nb_jobs = 0;
+	}
+	while (gf_list_count(ctx->pending)) {
+		GF_FilterPacket *pck = gf_list_pop_front(ctx->pending);
+		gf_filter_pck_send(pck);
+	}
+}
+
 static GF_Err cenc_enc_process(GF_Filter *filter)
 {
 	GF_CENCEncCtx *ctx = (GF_CENCEncCtx *)gf_filter_get_udta(filter);
 	u32 i, nb_eos, count = gf_list_count(ctx->streams);
 
+	if (ctx->nbth && !ctx->workers) {
+		GF_Err e = cenc_workers_setup(ctx);
+		if (e) {
+			cenc_workers_del(ctx);
+			ctx->nbth = 0;
+			return e;
+		}
+		if (!ctx->workers) ctx->nbth = 0;
+	}
+
 	nb_eos = 0;
 	for (i=0; i<count; i++) {
 		GF_Err e = GF_OK;
+		u32 nb_pck = 0;
 		GF_CENCStream *cstr = gf_list_get(ctx->streams, i);
-		GF_FilterPacket *pck = gf_filter_pid_get_packet(cstr->ipid);
-		if (!pck) {
-			if (gf_filter_pid_is_eos(cstr->ipid)) {
-				gf_filter_pid_set_eos(cstr->opid);
-				nb_eos++;
+		while (1) {
+			GF_FilterPacket *pck = gf_filter_pid_get_packet(cstr->ipid);
+			if (!pck) {
+				if (!nb_pck && gf_filter_pid_is_eos(cstr->ipid)) {
+					gf_filter_pid_set_eos(cstr->opid);
+					nb_eos++;
+				}
+				break;
 			}
-			continue;
-		}
 
-		if (cstr->passthrough) {
-			gf_filter_pck_forward(pck, cstr->opid);
-		}
-		else if (cstr->isma_oma) {
-			e = isma_process(ctx, cstr, pck);
-		} else if (cstr->is_adobe) {
-	 		e = adobe_process(ctx, cstr, pck);
-		} else {
-			e = cenc_process(ctx, cstr, pck);
-		}
-		gf_filter_pid_drop_packet(cstr->ipid);
-		cstr->nb_pck++;
+			if (cstr->passthrough) {
+				gf_filter_pck_forward(pck, cstr->opid);
+			}
+			else if (cstr->isma_oma) {
+				e = isma_process(ctx, cstr, pck);
+			} else if (cstr->is_adobe) {
+				e = adobe_process(ctx, cstr, pck);
+			} else {
+				e = cenc_process(ctx, cstr, pck);
+			}
+			gf_filter_pid_drop_packet(cstr->ipid);
+			cstr->nb_pck++;
+			nb_pck++;
 
-		if (e) return e;
+			if (e) {
+				cenc_enc_flush(ctx);
+				return e;
+			}
+			//with workers, gather several CENC packets per PID so that small samples are also encrypted in parallel
+			if (!ctx->nb_workers || cstr->passthrough || cstr->isma_oma || cstr->is_adobe || (nb_pck > ctx->nb_workers))
+				break;
+		}
 	}
+	cenc_enc_flush(ctx);
 	if (nb_eos==count) return GF_EOS;
 
 	return GF_OK;
@@ -2658,6 +2960,7 @@ static GF_Err cenc_enc_initialize(GF_Filter *filter)
 	}
 
 	ctx->streams = gf_list_new();
+	ctx->pending = gf_list_new();
 	return GF_OK;
 }
 
@@ -2674,6 +2977,9 @@ static void cenc_enc_finalize(GF_Filter *filter)
 	gf_list_del(ctx->streams);
 	if (ctx->bs_w) gf_bs_del(ctx->bs_w);
 	if (ctx->bs_r) gf_bs_del(ctx->bs_r);
+	cenc_workers_del(ctx);
+	if (ctx->jobs) gf_free(ctx->jobs);
+	gf_list_del(ctx->pending);
 	if (ctx->bk_stats) {
 		fprintf(stdout, "16-byte Blocks encrypted "LLU"\n", num_block_crypted);
 	}
@@ -2696,6 +3002,7 @@ static const GF_FilterArgs GF_CENCEncArgs[] =
 	{ OFFS(cfile), "crypt file location", GF_PROP_STRING, NULL, NULL, 0},
 	{ OFFS(allc), "throw error if no DRM config file is found for a PID", GF_PROP_BOOL, NULL, NULL, 0},
 	{ OFFS(bk_stats), "print number of encrypted blocks to stdout upon exit", GF_PROP_BOOL, NULL, NULL, 0},
+	{ OFFS(nbth), "number of additional threads for CENC sample encryption, -1 means all cores", GF_PROP_SINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
 
@@ -2708,6 +3015,10 @@ GF_FilterRegister CENCEncRegister = {
 	"When the DRM config file is set per PID, the first `CrypTrack` in the DRM config file with the same ID is used, otherwise the first `CrypTrack` is used (regardless of the `CrypTrack` ID).\n"
 	"When the DRM config file is set globally (not per PID), the first `CrypTrack` in the DRM config file with the same ID is used, otherwise the first `CrypTrack` with ID 0 or not set is used.\n"
 	"If no DRM config file is defined for a given PID, this PID will not be encrypted, or an error will be thrown if [-allc]() is specified.\n"
+	"\n"
+	"When [-nbth]() is set, CENC samples of all PIDs are parsed in the filter thread and their encrypted ranges are processed by a pool of threads. "
+	"CTR ranges are split in 32 kB jobs, CBC ranges with constant IV are processed as one job per subsample, and CBC with per-sample IV or SAES samples are encrypted in the filter thread. "
+	"Output is identical to single-threaded encryption, and packets are sent in the input order of each PID.\n"
 	)
 	.private_size = sizeof(GF_CENCEncCtx),
 	.max_extra_pids=-1,
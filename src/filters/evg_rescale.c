@@ -27,6 +27,7 @@
 
 #ifndef GPAC_DISABLE_EVG
 #include <gpac/evg.h>
+#include <gpac/thread.h>
 
 enum
 {
@@ -35,6 +36,39 @@ enum
 	EVGS_KEEPAR_NOSRC,
 };
 
+enum
+{
+	EVGS_ALGO_EVG=0,
+	EVGS_ALGO_BICUBIC,
+	EVGS_ALGO_LANCZOS,
+};
+
+/*separable scaler filter for one dimension*/
+typedef struct
+{
+	u32 taps;
+	//first source sample of each output sample
+	u32 *pos;
+	//taps coefficients of each output sample, EVGS_COEF_BITS fixed point
+	s16 *coefs;
+	//taps is a multiple of 8 and windows never exceed the source
+	Bool simd;
+} EVGSFilter;
+
+typedef struct
+{
+	const u8 *src;
+	u8 *dst;
+	u32 src_stride, dst_stride;
+	u32 src_w, src_h, dst_w, dst_h;
+	//1 for planar data, 2 for interleaved UV
+	u32 nb_comp;
+	EVGSFilter *fh, *fv;
+} EVGSPlane;
+
+typedef struct _evgs_worker EVGSWorker;
+
+
 typedef struct
 {
 	//options
@@ -44,6 +78,7 @@ typedef struct
 	char *padclr;
 	u32 keepar;
 	GF_Fraction osar;
+	u32 algo;
 
 	//internal data
 	GF_FilterPid *ipid;
@@ -60,11 +95,564 @@ typedef struct
 	GF_EVGSurface *surf;
 	GF_EVGStencil *tx;
 	GF_Path *path;
+
+	//separable scaler
+	Bool use_sep;
+	u32 sep_bits, nb_planes;
+	EVGSPlane planes[3];
+	//luma horizontal and vertical, chroma horizontal and vertical
+	EVGSFilter filters[4];
+	EVGSWorker *workers;
+	u32 nb_workers;
+	GF_Semaphore *done_sem;
+	Bool workers_exit;
 } EVGScaleCtx;
 
 u32 gf_evg_stencil_get_pixel_fast(GF_EVGStencil *st, s32 x, s32 y);
 u64 gf_evg_stencil_get_pixel_wide_fast(GF_EVGStencil *st, s32 x, s32 y);
 
+#ifdef __AVX2__
+# include <immintrin.h>
+# define GPAC_HAS_AVX2
+#endif
+#if defined(__SSE2__) || (defined(WIN32) && defined(GPAC_64_BITS) && !defined(__GNUC__))
+# include <emmintrin.h>
+# define GPAC_HAS_SSE2
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+# include <arm_neon.h>
+# define GPAC_HAS_NEON
+#endif
+
+#define EVGS_COEF_BITS	14
+#define EVGS_PI	3.14159265358979323846
+
+struct _evgs_worker
+{
+	EVGScaleCtx *ctx;
+	GF_Thread *th;
+	//each worker has its own start semaphore so that a fast worker never processes a slice twice
+	GF_Semaphore *start_sem;
+	u32 idx;
+	//horizontally scaled rows of the current slice
+	s16 *tmp;
+	u32 tmp_size;
+	//deinterleaved or to-be-interleaved row
+	u8 *row;
+	u32 row_size;
+	//error of the last frame processed
+	GF_Err error;
+};
+
+static Double evgs_kernel(u32 algo, Double x)
+{
+	if (x<0) x = -x;
+	if (algo==EVGS_ALGO_LANCZOS) {
+		if (x >= 3) return 0;
+		if (x < 1e-8) return 1;
+		return 3 * sin(EVGS_PI * x) * sin(EVGS_PI * x / 3) / (EVGS_PI * EVGS_PI * x * x);
+	}
+	//bicubic, a=-0.5
+	if (x < 1) return (1.5*x - 2.5)*x*x + 1;
+	if (x < 2) return ((-0.5*x + 2.5)*x - 4)*x + 2;
+	return 0;
+}
+
+static void evgs_filter_reset(EVGSFilter *f)
+{
+	if (f->pos) gf_free(f->pos);
+	if (f->coefs) gf_free(f->coefs);
+	memset(f, 0, sizeof(EVGSFilter));
+}
+
+/*compute coefficients for scaling src_size samples to dst_size samples, with number of taps rounded to a multiple of align*/
+static GF_Err evgs_filter_setup(EVGSFilter *f, u32 algo, u32 src_size, u32 dst_size, u32 align)
+{
+	u32 i, k, taps;
+	Double scale = (Double) src_size / dst_size;
+	Double fscale = (scale > 1) ? scale : 1;
+	Double support = ((algo==EVGS_ALGO_LANCZOS) ? 3 : 2) * fscale;
+	Double *w;
+
+	evgs_filter_reset(f);
+	taps = (u32) ceil(2*support);
+	taps = (taps + align - 1) / align * align;
+	f->simd = (align>1) ? GF_TRUE : GF_FALSE;
+	if (taps > src_size) {
+		taps = src_size;
+		f->simd = GF_FALSE;
+	}
+	f->taps = taps;
+	f->pos = gf_malloc(sizeof(u32) * dst_size);
+	f->coefs = gf_malloc(sizeof(s16) * dst_size * taps);
+	w = gf_malloc(sizeof(Double) * taps);
+	if (!f->pos || !f->coefs || !w) {
+		if (w) gf_free(w);
+		evgs_filter_reset(f);
+		return GF_OUT_OF_MEM;
+	}
+
+	for (i=0; i<dst_size; i++) {
+		Double sum = 0;
+		s32 isum = 0, max_k = 0;
+		s16 *c = f->coefs + i*taps;
+		Double center = (i + 0.5) * scale - 0.5;
+		s32 first = (s32) floor(center - support) + 1;
+		s32 start = first;
+		//keep the window inside the source, out of range samples are clamped to the edges
+		if (start + (s32) taps > (s32) src_size) start = src_size - taps;
+		if (start < 0) start = 0;
+		f->pos[i] = start;
+
+		memset(w, 0, sizeof(Double) * taps);
+		for (k=0; k < (u32) ceil(2*support); k++) {
+			s32 x = first + k;
+			Double v = evgs_kernel(algo, (x - center) / fscale);
+			if (x < 0) x = 0;
+			else if (x >= (s32) src_size) x = src_size-1;
+			x -= start;
+			if ((x<0) || (x >= (s32) taps)) continue;
+			w[x] += v;
+			sum += v;
+		}
+		for (k=0; k<taps; k++) {
+			c[k] = (s16) floor(w[k] * (1<<EVGS_COEF_BITS) / sum + 0.5);
+			isum += c[k];
+			if (c[k] > c[max_k]) max_k = k;
+		}
+		//keep unity gain after rounding
+		c[max_k] += (1<<EVGS_COEF_BITS) - isum;
+	}
+	gf_free(w);
+	return GF_OK;
+}
+
+/*horizontal pass, output is source scaled by 1<<(EVGS_COEF_BITS - shift)*/
+static void evgs_hscale(const u8 *src, Bool is_10bit, s16 *dst, u32 dst_w, EVGSFilter *f, u32 shift)
+{
+	u32 i, k, taps = f->taps;
+	s32 round = 1 << (shift-1);
+	const s16 *c = f->coefs;
+
+	for (i=0; i<dst_w; i++, c += taps) {
+		s32 acc;
+#if defined(GPAC_HAS_SSE2)
+		if (f->simd) {
+			__m128i vacc = _mm_setzero_si128();
+			if (is_10bit) {
+				const u16 *s = ((const u16 *) src) + f->pos[i];
+				for (k=0; k<taps; k+=8)
+					vacc = _mm_add_epi32(vacc, _mm_madd_epi16(_mm_loadu_si128((const __m128i *) (s+k)), _mm_loadu_si128((const __m128i *) (c+k))));
+			} else {
+				const __m128i zero = _mm_setzero_si128();
+				const u8 *s = src + f->pos[i];
+				for (k=0; k<taps; k+=8)
+					vacc = _mm_add_epi32(vacc, _mm_madd_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (s+k)), zero), _mm_loadu_si128((const __m128i *) (c+k))));
+			}
+			vacc = _mm_add_epi32(vacc, _mm_shuffle_epi32(vacc, 0x4E));
+			vacc = _mm_add_epi32(vacc, _mm_shuffle_epi32(vacc, 0xB1));
+			acc = _mm_cvtsi128_si32(vacc);
+		} else
+#elif defined(GPAC_HAS_NEON)
+		if (f->simd) {
+			int32x2_t acc2;
+			int32x4_t vacc = vdupq_n_s32(0);
+			for (k=0; k<taps; k+=8) {
+				int16x8_t vc = vld1q_s16(c+k);
+				int16x8_t vs;
+				if (is_10bit) vs = vreinterpretq_s16_u16(vld1q_u16(((const u16 *) src) + f->pos[i] + k));
+				else vs = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(src + f->pos[i] + k)));
+				vacc = vmlal_s16(vacc, vget_low_s16(vs), vget_low_s16(vc));
+				vacc = vmlal_s16(vacc, vget_high_s16(vs), vget_high_s16(vc));
+			}
+			acc2 = vadd_s32(vget_low_s32(vacc), vget_high_s32(vacc));
+			acc = vget_lane_s32(vpadd_s32(acc2, acc2), 0);
+		} else
+#endif
+		{
+			acc = 0;
+			if (is_10bit) {
+				const u16 *s = ((const u16 *) src) + f->pos[i];
+				for (k=0; k<taps; k++) acc += s[k] * c[k];
+			} else {
+				const u8 *s = src + f->pos[i];
+				for (k=0; k<taps; k++) acc += s[k] * c[k];
+			}
+		}
+		dst[i] = (s16) ((acc + round) >> shift);
+	}
+}
+
+/*vertical pass on taps rows of width samples, rows[k] starting at tmp + k*width*/
+static void evgs_vscale(const s16 *tmp, u32 width, const s16 *c, u32 taps, u8 *dst, Bool is_10bit, u32 shift)
+{
+	u32 i=0, k;
+	s32 round = 1 << (shift-1);
+	s32 max_val = is_10bit ? 1023 : 255;
+
+#if defined(GPAC_HAS_AVX2)
+	for (; i+16<=width; i+=16) {
+		__m256i v, acc_lo = _mm256_set1_epi32(round), acc_hi = acc_lo;
+		for (k=0; k<taps; k+=2) {
+			__m256i r0 = _mm256_loadu_si256((const __m256i *) (tmp + k*width + i));
+			__m256i r1 = (k+1<taps) ? _mm256_loadu_si256((const __m256i *) (tmp + (k+1)*width + i)) : _mm256_setzero_si256();
+			__m256i cc = _mm256_set1_epi32( (u16) c[k] | ((u32) ((k+1<taps) ? (u16) c[k+1] : 0) << 16) );
+			acc_lo = _mm256_add_epi32(acc_lo, _mm256_madd_epi16(_mm256_unpacklo_epi16(r0, r1), cc));
+			acc_hi = _mm256_add_epi32(acc_hi, _mm256_madd_epi16(_mm256_unpackhi_epi16(r0, r1), cc));
+		}
+		//unpack and pack are per 128-bit lane, pixel order is restored by packs
+		v = _mm256_packs_epi32(_mm256_srai_epi32(acc_lo, shift), _mm256_srai_epi32(acc_hi, shift));
+		if (is_10bit) {
+			v = _mm256_min_epi16(_mm256_max_epi16(v, _mm256_setzero_si256()), _mm256_set1_epi16(1023));
+			_mm256_storeu_si256((__m256i *) (((u16 *) dst) + i), v);
+		} else {
+			v = _mm256_permute4x64_epi64(_mm256_packus_epi16(v, v), 0x08);
+			_mm_storeu_si128((__m128i *) (dst + i), _mm256_castsi256_si128(v));
+		}
+	}
+#endif
+#if defined(GPAC_HAS_SSE2)
+	for (; i+8<=width; i+=8) {
+		__m128i v, acc_lo = _mm_set1_epi32(round), acc_hi = acc_lo;
+		for (k=0; k<taps; k+=2) {
+			__m128i r0 = _mm_loadu_si128((const __m128i *) (tmp + k*width + i));
+			__m128i r1 = (k+1<taps) ? _mm_loadu_si128((const __m128i *) (tmp + (k+1)*width + i)) : _mm_setzero_si128();
+			__m128i cc = _mm_set1_epi32( (u16) c[k] | ((u32) ((k+1<taps) ? (u16) c[k+1] : 0) << 16) );
+			acc_lo = _mm_add_epi32(acc_lo, _mm_madd_epi16(_mm_unpacklo_epi16(r0, r1), cc));
+			acc_hi = _mm_add_epi32(acc_hi, _mm_madd_epi16(_mm_unpackhi_epi16(r0, r1), cc));
+		}
+		v = _mm_packs_epi32(_mm_srai_epi32(acc_lo, shift), _mm_srai_epi32(acc_hi, shift));
+		if (is_10bit) {
+			v = _mm_min_epi16(_mm_max_epi16(v, _mm_setzero_si128()), _mm_set1_epi16(1023));
+			_mm_storeu_si128((__m128i *) (((u16 *) dst) + i), v);
+		} else {
+			_mm_storel_epi64((__m128i *) (dst + i), _mm_packus_epi16(v, v));
+		}
+	}
+#elif defined(GPAC_HAS_NEON)
+	{
+	int32x4_t vshift = vdupq_n_s32(-(s32) shift);
+	for (; i+8<=width; i+=8) {
+		uint16x8_t v;
+		int32x4_t acc_lo = vdupq_n_s32(round), acc_hi = acc_lo;
+		for (k=0; k<taps; k++) {
+			int16x8_t r = vld1q_s16(tmp + k*width + i);
+			acc_lo = vmlal_n_s16(acc_lo, vget_low_s16(r), c[k]);
+			acc_hi = vmlal_n_s16(acc_hi, vget_high_s16(r), c[k]);
+		}
+		v = vcombine_u16(vqmovun_s32(vshlq_s32(acc_lo, vshift)), vqmovun_s32(vshlq_s32(acc_hi, vshift)));
+		if (is_10bit) {
+			vst1q_u16(((u16 *) dst) + i, vminq_u16(v, vdupq_n_u16(1023)));
+		} else {
+			vst1_u8(dst + i, vqmovn_u16(v));
+		}
+	}
+	}
+#endif
+	for (; i<width; i++) {
+		s32 acc = round;
+		for (k=0; k<taps; k++) acc += tmp[k*width + i] * c[k];
+		acc >>= shift;
+		if (acc < 0) acc = 0;
+		else if (acc > max_val) acc = max_val;
+		if (is_10bit) ((u16 *) dst)[i] = (u16) acc;
+		else dst[i] = (u8) acc;
+	}
+}
+
+/*scale output rows [y_start, y_end[ of a plane*/
+static GF_Err evgs_scale_slice(EVGScaleCtx *ctx, EVGSWorker *wk, EVGSPlane *pl, u32 y_start, u32 y_end)
+{
+	u32 y, r, comp, first, nb_rows, size;
+	Bool is_10bit = (ctx->sep_bits>8) ? GF_TRUE : GF_FALSE;
+	u32 bps = is_10bit ? 2 : 1;
+	//intermediate values keep 6 bits of precision for 8-bit and 4 bits for 10-bit
+	u32 h_shift = EVGS_COEF_BITS - (is_10bit ? 4 : 6);
+	u32 v_shift = EVGS_COEF_BITS + (is_10bit ? 4 : 6);
+
+	if (y_start>=y_end) return GF_OK;
+	first = pl->fv->pos[y_start];
+	nb_rows = pl->fv->pos[y_end-1] + pl->fv->taps - first;
+
+	size = sizeof(s16) * nb_rows * pl->dst_w;
+	if (wk->tmp_size < size) {
+		s16 *tmp = gf_realloc(wk->tmp, size);
+		if (!tmp) return GF_OUT_OF_MEM;
+		wk->tmp = tmp;
+		wk->tmp_size = size;
+	}
+	size = bps * MAX(pl->src_w, pl->dst_w);
+	if ((pl->nb_comp>1) && (wk->row_size < size)) {
+		u8 *row = gf_realloc(wk->row, size);
+		if (!row) return GF_OUT_OF_MEM;
+		wk->row = row;
+		wk->row_size = size;
+	}
+
+	for (comp=0; comp<pl->nb_comp; comp++) {
+		for (r=0; r<nb_rows; r++) {
+			const u8 *src = pl->src + (first + r) * pl->src_stride;
+			//deinterleave UV
+			if (pl->nb_comp>1) {
+				u32 i;
+				if (is_10bit) {
+					for (i=0; i<pl->src_w; i++) ((u16 *) wk->row)[i] = ((const u16 *) src)[2*i + comp];
+				} else {
+					for (i=0; i<pl->src_w; i++) wk->row[i] = src[2*i + comp];
+				}
+				src = wk->row;
+			}
+			evgs_hscale(src, is_10bit, wk->tmp + r * pl->dst_w, pl->dst_w, pl->fh, h_shift);
+		}
+		for (y=y_start; y<y_end; y++) {
+			u8 *dst = pl->dst + y * pl->dst_stride;
+			const s16 *rows = wk->tmp + (pl->fv->pos[y] - first) * pl->dst_w;
+			const s16 *c = pl->fv->coefs + y * pl->fv->taps;
+			if (pl->nb_comp>1) {
+				u32 i;
+				evgs_vscale(rows, pl->dst_w, c, pl->fv->taps, wk->row, is_10bit, v_shift);
+				//interleave UV
+				if (is_10bit) {
+					for (i=0; i<pl->dst_w; i++) ((u16 *) dst)[2*i + comp] = ((u16 *) wk->row)[i];
+				} else {
+					for (i=0; i<pl->dst_w; i++) dst[2*i + comp] = wk->row[i];
+				}
+			} else {
+				evgs_vscale(rows, pl->dst_w, c, pl->fv->taps, dst, is_10bit, v_shift);
+			}
+		}
+	}
+	return GF_OK;
+}
+
+static void evgs_scale_worker_run(EVGScaleCtx *ctx, EVGSWorker *wk)
+{
+	u32 i, nb_slices = ctx->nb_workers + 1;
+	wk->error = GF_OK;
+	for (i=0; i<ctx->nb_planes; i++) {
+		EVGSPlane *pl = &ctx->planes[i];
+		GF_Err e = evgs_scale_slice(ctx, wk, pl, pl->dst_h * wk->idx / nb_slices, pl->dst_h * (wk->idx+1) / nb_slices);
+		if (e) wk->error = e;
+	}
+}
+
+static u32 evgs_scale_thread(void *par)
+{
+	EVGSWorker *wk = (EVGSWorker *) par;
+	EVGScaleCtx *ctx = wk->ctx;
+	while (1) {
+		gf_sema_wait(wk->start_sem);
+		if (ctx->workers_exit) break;
+		evgs_scale_worker_run(ctx, wk);
+		gf_sema_notify(ctx->done_sem, 1);
+	}
+	return 0;
+}
+
+static void evgs_scale_threads_del(EVGScaleCtx *ctx)
+{
+	u32 i;
+	if (!ctx->workers) return;
+	if (ctx->nb_workers) {
+		ctx->workers_exit = GF_TRUE;
+		for (i=0; i<ctx->nb_workers; i++) {
+			gf_sema_notify(ctx->workers[i+1].start_sem, 1);
+			gf_th_del(ctx->workers[i+1].th);
+		}
+	}
+	for (i=0; i<ctx->nb_workers+1; i++) {
+		if (ctx->workers[i].tmp) gf_free(ctx->workers[i].tmp);
+		if (ctx->workers[i].row) gf_free(ctx->workers[i].row);
+		if (ctx->workers[i].start_sem) gf_sema_del(ctx->workers[i].start_sem);
+	}
+	gf_free(ctx->workers);
+	ctx->workers = NULL;
+	ctx->nb_workers = 0;
+	if (ctx->done_sem) gf_sema_del(ctx->done_sem);
+	ctx->done_sem = NULL;
+	ctx->workers_exit = GF_FALSE;
+}
+
+/*setup worker contexts, worker 0 runs in the filter thread*/
+static GF_Err evgs_scale_threads_setup(EVGScaleCtx *ctx)
+{
+	u32 i;
+	s32 nb_threads = ctx->nbth;
+	if (ctx->workers) return GF_OK;
+
+	if (nb_threads<0) {
+		GF_SystemRTInfo rti;
+		gf_sys_get_rti(0, &rti, 0);
+		nb_threads = (rti.nb_cores>1) ? rti.nb_cores-1 : 0;
+	}
+#ifdef GPAC_DISABLE_THREADS
+	nb_threads = 0;
+#endif
+	ctx->workers = gf_malloc(sizeof(EVGSWorker) * (nb_threads+1));
+	if (!ctx->workers) return GF_OUT_OF_MEM;
+	memset(ctx->workers, 0, sizeof(EVGSWorker) * (nb_threads+1));
+	ctx->workers[0].ctx = ctx;
+	if (!nb_threads) return GF_OK;
+
+	ctx->done_sem = gf_sema_new(nb_threads, 0);
+	if (!ctx->done_sem) return GF_OK;
+
+	for (i=0; i<(u32) nb_threads; i++) {
+		EVGSWorker *wk = &ctx->workers[i+1];
+		wk->ctx = ctx;
+		wk->idx = i+1;
+		wk->start_sem = gf_sema_new(1, 0);
+		wk->th = gf_th_new("evgs_scale");
+		if (!wk->start_sem || !wk->th || (gf_th_run(wk->th, evgs_scale_thread, wk) != GF_OK)) {
+			if (wk->th) gf_th_del(wk->th);
+			if (wk->start_sem) gf_sema_del(wk->start_sem);
+			wk->th = NULL;
+			wk->start_sem = NULL;
+			break;
+		}
+		ctx->nb_workers++;
+	}
+	return GF_OK;
+}
+
+static void evgs_scale_reset(EVGScaleCtx *ctx)
+{
+	u32 i;
+	for (i=0; i<4; i++)
+		evgs_filter_reset(&ctx->filters[i]);
+	ctx->use_sep = GF_FALSE;
+}
+
+/*check if the separable scaler can be used and build filters*/
+static void evgs_scale_setup(EVGScaleCtx *ctx, u32 pfmt, u32 w, u32 h)
+{
+	GF_Err e;
+	u32 i, cw, ch, o_cw, o_ch, o_stride_uv=0;
+	Bool sub_w=GF_FALSE, sub_h=GF_FALSE;
+
+	evgs_scale_reset(ctx);
+	if (ctx->algo==EVGS_ALGO_EVG) return;
+	if ((pfmt != ctx->ofmt) || ctx->offset_w || ctx->offset_h || (ctx->ofr != ctx->fullrange))
+		return;
+
+	ctx->nb_planes = 3;
+	ctx->sep_bits = 8;
+	switch (pfmt) {
+	case GF_PIXEL_GREYSCALE:
+		ctx->nb_planes = 1;
+		break;
+	case GF_PIXEL_YUV_10:
+		ctx->sep_bits = 10;
+		//fallthrough
+	case GF_PIXEL_YUV:
+	case GF_PIXEL_YVU:
+		sub_w = sub_h = GF_TRUE;
+		break;
+	case GF_PIXEL_YUV422_10:
+		ctx->sep_bits = 10;
+		//fallthrough
+	case GF_PIXEL_YUV422:
+		sub_w = GF_TRUE;
+		break;
+	case GF_PIXEL_YUV444_10:
+		ctx->sep_bits = 10;
+		//fallthrough
+	case GF_PIXEL_YUV444:
+		break;
+	case GF_PIXEL_NV12_10:
+	case GF_PIXEL_NV21_10:
+		ctx->sep_bits = 10;
+		//fallthrough
+	case GF_PIXEL_NV12:
+	case GF_PIXEL_NV21:
+		ctx->nb_planes = 2;
+		ctx->planes[1].nb_comp = 2;
+		sub_w = sub_h = GF_TRUE;
+		break;
+	default:
+		return;
+	}
+#ifdef GPAC_BIG_ENDIAN
+	if (ctx->sep_bits>8) return;
+#endif
+	if (!gf_pixel_get_size_info(ctx->ofmt, ctx->o_w, ctx->o_h, NULL, NULL, &o_stride_uv, NULL, NULL))
+		return;
+
+	cw = sub_w ? (w+1)/2 : w;
+	ch = sub_h ? (h+1)/2 : h;
+	o_cw = sub_w ? (ctx->o_w+1)/2 : ctx->o_w;
+	o_ch = sub_h ? (ctx->o_h+1)/2 : ctx->o_h;
+
+	e = evgs_filter_setup(&ctx->filters[0], ctx->algo, w, ctx->o_w, 8);
+	if (!e) e = evgs_filter_setup(&ctx->filters[1], ctx->algo, h, ctx->o_h, 1);
+	if (!e && (ctx->nb_planes>1)) e = evgs_filter_setup(&ctx->filters[2], ctx->algo, cw, o_cw, 8);
+	if (!e && (ctx->nb_planes>1)) e = evgs_filter_setup(&ctx->filters[3], ctx->algo, ch, o_ch, 1);
+	if (!e) e = evgs_scale_threads_setup(ctx);
+	if (e) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_MEDIA, ("[EVGS] Failed to setup separable scaler: %s, using EVG\n", gf_error_to_string(e) ));
+		evgs_scale_reset(ctx);
+		return;
+	}
+
+	for (i=0; i<ctx->nb_planes; i++) {
+		EVGSPlane *pl = &ctx->planes[i];
+		if (!i) {
+			pl->nb_comp = 1;
+			pl->src_w = w;
+			pl->src_h = h;
+			pl->dst_w = ctx->o_w;
+			pl->dst_h = ctx->o_h;
+			pl->dst_stride = ctx->o_stride;
+			pl->fh = &ctx->filters[0];
+			pl->fv = &ctx->filters[1];
+		} else {
+			pl->nb_comp = (ctx->nb_planes==2) ? 2 : 1;
+			pl->src_w = cw;
+			pl->src_h = ch;
+			pl->dst_w = o_cw;
+			pl->dst_h = o_ch;
+			pl->dst_stride = o_stride_uv;
+			pl->fh = &ctx->filters[2];
+			pl->fv = &ctx->filters[3];
+		}
+	}
+	ctx->use_sep = GF_TRUE;
+	GF_LOG(GF_LOG_INFO, GF_LOG_MEDIA, ("[EVGS] Using separable %s scaler with %d threads\n", (ctx->algo==EVGS_ALGO_LANCZOS) ? "lanczos" : "bicubic", ctx->nb_workers+1));
+}
+
+static GF_Err evgs_scale_frame(EVGScaleCtx *ctx, const u8 *data, GF_FilterFrameInterface *frame_ifce, u8 *output)
+{
+	u32 i;
+	if (data) {
+		ctx->planes[0].src = data;
+		ctx->planes[0].src_stride = ctx->i_stride;
+		for (i=1; i<ctx->nb_planes; i++) {
+			ctx->planes[i].src = (i==1) ? data + ctx->i_stride * ctx->planes[0].src_h : ctx->planes[1].src + ctx->i_stride_uv * ctx->planes[1].src_h;
+			ctx->planes[i].src_stride = ctx->i_stride_uv;
+		}
+	} else if (frame_ifce && frame_ifce->get_plane) {
+		for (i=0; i<ctx->nb_planes; i++) {
+			GF_Err e = frame_ifce->get_plane(frame_ifce, i, &ctx->planes[i].src, &ctx->planes[i].src_stride);
+			if (e) return e;
+		}
+	} else {
+		return GF_NOT_SUPPORTED;
+	}
+	for (i=0; i<ctx->nb_planes; i++) {
+		ctx->planes[i].dst = (i==0) ? output : (i==1) ? output + ctx->o_stride * ctx->o_h : ctx->planes[1].dst + ctx->planes[1].dst_stride * ctx->planes[1].dst_h;
+	}
+
+	for (i=0; i<ctx->nb_workers; i++)
+		gf_sema_notify(ctx->workers[i+1].start_sem, 1);
+	evgs_scale_worker_run(ctx, &ctx->workers[0]);
+	for (i=0; i<ctx->nb_workers; i++)
+		gf_sema_wait(ctx->done_sem);
+	for (i=0; i<ctx->nb_workers+1; i++) {
+		if (ctx->workers[i].error) return ctx->workers[i].error;
+	}
+	return GF_OK;
+}
+
 static GF_Err evgs_process(GF_Filter *filter)
 {
 	const char *data;
@@ -121,6 +709,14 @@ static GF_Err evgs_process(GF_Filter *filter)
 		}
 
 	GF_Err e;
+	if (ctx->use_sep) {
+		e = evgs_scale_frame(ctx, data, frame_ifce, output);
+		CHK_EXIT("Failed to scale frame");
+		gf_filter_pck_send(dst_pck);
+		gf_filter_pid_drop_packet(ctx->ipid);
+		return GF_OK;
+	}
+
 	e = gf_evg_surface_attach_to_buffer(ctx->surf, output, ctx->o_w, ctx->o_h, 0, ctx->o_stride, ctx->ofmt);
 	CHK_EXIT("Failed to create output surface");
 	//threading must be enabled once the surface is configured
@@ -382,6 +978,7 @@ static GF_Err evgs_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_r
 		ctx->i_h = h;
 		ctx->i_pfmt = ofmt;
 		ctx->fullrange = fullrange;
+		evgs_scale_setup(ctx, ofmt, w, h);
 		GF_LOG(GF_LOG_INFO, GF_LOG_MEDIA, ("[EVGS] Setup rescaler from %dx%d fmt %s to %dx%d fmt %s\n", w, h, gf_pixel_fmt_name(ofmt), ctx->o_w, ctx->o_h, gf_pixel_fmt_name(ctx->ofmt)));
 	}
 
@@ -437,6 +1034,8 @@ static void evgs_finalize(GF_Filter *filter)
 	gf_evg_surface_delete(ctx->surf);
 	gf_evg_stencil_delete(ctx->tx);
 	gf_path_del(ctx->path);
+	evgs_scale_reset(ctx);
+	evgs_scale_threads_del(ctx);
 	return;
 }
 
@@ -474,6 +1073,11 @@ static GF_FilterArgs EVGSArgs[] =
 	{ OFFS(osar), "force output pixel aspect ratio", GF_PROP_FRACTION, "0/1", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(nbth), "number of threads to use, -1 means all cores", GF_PROP_SINT, "-1", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(hq), "use bilinear interpolation instead of closest pixel", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(algo), "scaling algorithm when input and output formats are the same planar YUV, NV12 or greyscale format\n"
+	"- evg: use EVG rasterizer\n"
+	"- bicubic: use separable bicubic filter\n"
+	"- lanczos: use separable 3-lobe Lanczos filter"
+	, GF_PROP_UINT, "bicubic", "evg|bicubic|lanczos", GF_FS_ARG_HINT_EXPERT},
 
 	{0}
 };
@@ -511,6 +1115,9 @@ GF_FilterRegister EVGSRegister = {
 	"When sample aspect ratio is kept, the filter will:\n"
 	"- center the rescaled input frame on the output frame\n"
 	"- fill extra pixels with [-padclr]()\n"
+	"## Separable scaler\n"
+	"When input and output pixel formats are the same 8 or 10 bit planar YUV, NV12/NV21 or greyscale format, no padding is used and range is not changed, the filter uses separable polyphase filters selected by [-algo]() instead of EVG, unless [-algo=evg]() is set.\n"
+	"Rows are processed in slices by [-nbth]() threads.\n"
 	)
 	.private_size = sizeof(EVGScaleCtx),
 	.args = EVGSArgs,
@@ -26,6 +26,7 @@
 
 #include <gpac/filters.h>
 #include <gpac/constants.h>
+#include <gpac/thread.h>
 
 #ifndef GPAC_DISABLE_FIN
 
@@ -44,6 +45,23 @@ enum{
 	FILE_RAND_SC_AV1
 };
 
+enum
+{
+	FILE_AIO_NO = 0,
+	FILE_AIO_THREAD,
+	FILE_AIO_URING
+};
+
+//read-ahead block, possibly shared by several packets after seeks
+typedef struct
+{
+	u8 *data;
+	u32 alloc_size, size;
+	u64 offset;
+	Bool reading, valid;
+	volatile u32 nb_out;
+} FileInBlock;
+
 typedef struct
 {
 	//options
@@ -53,6 +71,7 @@ typedef struct
 	GF_PropData pck;
 	GF_Fraction64 range;
 	GF_Fraction ptime;
+	u32 async, nbra;
 
 	//only one output pid declared
 	GF_FilterPid *pid;
@@ -71,8 +90,116 @@ typedef struct
 	u32 is_random;
 	Bool cached_set;
 	Bool no_failure;
+
+	//read-ahead
+	GF_FileAIO *aio;
+	FileInBlock *blocks;
+	u32 nb_blocks, ra_win;
+	GF_Err ra_error;
+	u32 nb_seeks, nb_seek_hits;
 } GF_FileInCtx;
 
+static void filein_ra_done(GF_FileInCtx *ctx, FileInBlock *b, s32 res)
+{
+	b->reading = GF_FALSE;
+	b->valid = GF_TRUE;
+	if (res<0) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[FileIn] Failed to read %d bytes at offset "LLU": %s\n", b->size, b->offset, strerror(-res)));
+		ctx->ra_error = GF_IO_ERR;
+		res = 0;
+	}
+	//short read, consider the file ends here
+	else if ((u32) res < b->size) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[FileIn] IO error EOF found after reading "LLU" bytes but file %s size is "LLU"\n", b->offset + res, ctx->src, ctx->file_size));
+		if (b->offset + res < ctx->file_size)
+			ctx->file_size = b->offset + res;
+	}
+	b->size = (u32) res;
+}
+
+static void filein_ra_collect(GF_FileInCtx *ctx, Bool wait_one)
+{
+	void *udta;
+	s32 res;
+	if (wait_one && gf_file_aio_get_done(ctx->aio, GF_TRUE, &udta, &res))
+		filein_ra_done(ctx, udta, res);
+	while (gf_file_aio_get_done(ctx->aio, GF_FALSE, &udta, &res))
+		filein_ra_done(ctx, udta, res);
+}
+
+//wait for all pending reads and forget read data, used when the file changes
+static void filein_ra_reset(GF_FileInCtx *ctx)
+{
+	u32 i;
+	if (!ctx->aio) return;
+	while (gf_file_aio_pending(ctx->aio))
+		filein_ra_collect(ctx, GF_TRUE);
+	for (i=0; i<ctx->nb_blocks; i++)
+		ctx->blocks[i].valid = GF_FALSE;
+	ctx->ra_win = 1;
+	ctx->ra_error = GF_OK;
+}
+
+static FileInBlock *filein_ra_find(GF_FileInCtx *ctx, u64 pos)
+{
+	u32 i;
+	for (i=0; i<ctx->nb_blocks; i++) {
+		FileInBlock *b = &ctx->blocks[i];
+		if (!b->reading && !b->valid) continue;
+		if ((b->offset <= pos) && (pos < b->offset + b->size))
+			return b;
+	}
+	return NULL;
+}
+
+//get a block neither read nor used by a packet, nor holding data within the read-ahead window
+static FileInBlock *filein_ra_get_free(GF_FileInCtx *ctx)
+{
+	u32 i;
+	u64 win_end = ctx->file_pos + (u64) ctx->ra_win * ctx->block_size;
+	for (i=0; i<ctx->nb_blocks; i++) {
+		FileInBlock *b = &ctx->blocks[i];
+		if (b->reading || b->nb_out) continue;
+		if (b->valid && (b->offset + b->size > ctx->file_pos) && (b->offset < win_end)) continue;
+		if (b->alloc_size < ctx->block_size) {
+			u8 *data = gf_realloc(b->data, ctx->block_size);
+			if (!data) return NULL;
+			b->data = data;
+			b->alloc_size = ctx->block_size;
+		}
+		return b;
+	}
+	return NULL;
+}
+
+//issue reads for the blocks of the read-ahead window not yet read
+static void filein_ra_schedule(GF_FileInCtx *ctx, u64 limit)
+{
+	u64 pos = ctx->file_pos;
+	u64 end = MIN(limit, ctx->file_pos + (u64) ctx->ra_win * ctx->block_size);
+	while (pos < end) {
+		FileInBlock *b = filein_ra_find(ctx, pos);
+		if (!b) {
+			b = filein_ra_get_free(ctx);
+			if (!b) break;
+			b->offset = pos;
+			b->size = (u32) MIN(ctx->block_size, limit - pos);
+			b->valid = GF_FALSE;
+			b->reading = GF_TRUE;
+			if (gf_file_aio_read(ctx->aio, ctx->fd, b->data, b->size, pos, b) != GF_OK) {
+				b->reading = GF_FALSE;
+				//retried once pending reads are done, otherwise no progress can be made
+				if (!gf_file_aio_pending(ctx->aio)) {
+					GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[FileIn] Failed to queue read of %d bytes at offset "LLU"\n", b->size, pos));
+					ctx->ra_error = GF_IO_ERR;
+				}
+				break;
+			}
+		}
+		pos = b->offset + b->size;
+	}
+}
+
 
 static GF_Err filein_initialize_ex(GF_Filter *filter)
 {
@@ -164,6 +291,7 @@ static GF_Err filein_initialize_ex(GF_Filter *filter)
 
 #ifdef GPAC_HAS_FD
 		if (ctx->fd>=0) {
+			filein_ra_reset(ctx);
 			close(ctx->fd);
 			ctx->fd = -1;
 		}
@@ -222,6 +350,27 @@ static GF_Err filein_initialize_ex(GF_Filter *filter)
 	ctx->cached_set = GF_FALSE;
 	ctx->full_file_only = GF_FALSE;
 
+#ifdef GPAC_HAS_FD
+	if (ctx->async && (ctx->fd>=0) && !ctx->aio) {
+		ctx->nb_blocks = MAX(ctx->nbra, 1) + 2;
+		ctx->aio = gf_file_aio_new(ctx->nb_blocks, (ctx->async==FILE_AIO_THREAD) ? GF_TRUE : GF_FALSE);
+		if (ctx->aio) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_MMIO, ("[FileIn] Using %s backend for read-ahead\n", gf_file_aio_backend(ctx->aio)));
+			ctx->blocks = gf_malloc(sizeof(FileInBlock) * ctx->nb_blocks);
+			if (ctx->blocks) memset(ctx->blocks, 0, sizeof(FileInBlock) * ctx->nb_blocks);
+			ctx->ra_win = 1;
+			//small blocks defeat read-ahead
+			if (!ctx->block_size) ctx->block_size = 262144;
+		}
+		if (!ctx->blocks) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[FileIn] Asynchronous reads not supported, using synchronous reads\n"));
+			gf_file_aio_del(ctx->aio);
+			ctx->aio = NULL;
+			ctx->async = FILE_AIO_NO;
+		}
+	}
+#endif
+
 	if (ctx->do_reconfigure && gf_fileio_check(ctx->file)) {
 		GF_FileIO *gfio = (GF_FileIO *)ctx->file;
 		gf_free(ctx->src);
@@ -271,6 +420,15 @@ static void filein_finalize(GF_Filter *filter)
 {
 	GF_FileInCtx *ctx = (GF_FileInCtx *) gf_filter_get_udta(filter);
 
+	if (ctx->aio) {
+		u32 i;
+		GF_LOG(GF_LOG_INFO, GF_LOG_MMIO, ("[FileIn] Read-ahead done - %d seeks, %d in read data, window %d blocks\n", ctx->nb_seeks, ctx->nb_seek_hits, ctx->ra_win));
+		gf_file_aio_del(ctx->aio);
+		for (i=0; i<ctx->nb_blocks; i++) {
+			if (ctx->blocks[i].data) gf_free(ctx->blocks[i].data);
+		}
+		gf_free(ctx->blocks);
+	}
 	if (ctx->file) gf_fclose(ctx->file);
 #ifdef GPAC_HAS_FD
 	if (ctx->fd>=0) close(ctx->fd);
@@ -367,6 +525,12 @@ static Bool filein_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 			return GF_TRUE;
 		}
 
+		//jumps outside of read data mean a sparse access pattern, restart with a single block read ahead
+		if (ctx->aio) {
+			ctx->nb_seeks++;
+			if (filein_ra_find(ctx, evt->seek.start_offset)) ctx->nb_seek_hits++;
+			else ctx->ra_win = 1;
+		}
 		ctx->file_pos = evt->seek.start_offset;
 		ctx->end_pos = evt->seek.end_offset;
 		if (ctx->end_pos>ctx->file_size) ctx->end_pos = ctx->file_size;
@@ -400,6 +564,7 @@ static Bool filein_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 		if (ctx->is_end && !strcmp(evt->file_del.url, "__gpac_self__")) {
 #ifdef GPAC_HAS_FD
 			if (ctx->fd>=0) {
+				filein_ra_reset(ctx);
 				close(ctx->fd);
 				ctx->fd = -1;
 			}
@@ -427,6 +592,95 @@ static void filein_pck_destructor(GF_Filter *filter, GF_FilterPid *pid, GF_Filte
 	gf_filter_post_process_task(filter);
 }
 
+static void filein_ra_pck_destructor(GF_Filter *filter, GF_FilterPid *pid, GF_FilterPacket *pck)
+{
+	u32 i, size;
+	GF_FileInCtx *ctx = (GF_FileInCtx *) gf_filter_get_udta(filter);
+	const u8 *data = gf_filter_pck_get_data(pck, &size);
+	for (i=0; i<ctx->nb_blocks; i++) {
+		FileInBlock *b = &ctx->blocks[i];
+		if (b->nb_out && (data >= b->data) && (data < b->data + b->alloc_size)) {
+			safe_int_dec(&b->nb_out);
+			break;
+		}
+	}
+	gf_filter_post_process_task(filter);
+}
+
+//dispatch read-ahead blocks as packets, only waiting when the next block is not yet read and nothing was sent
+static GF_Err filein_process_ra(GF_Filter *filter, GF_FileInCtx *ctx)
+{
+	u32 nb_sent = 0;
+	u64 limit;
+
+	filein_ra_collect(ctx, GF_FALSE);
+	while (1) {
+		u64 end;
+		FileInBlock *b;
+		GF_FilterPacket *pck;
+
+		if (ctx->ra_error) return ctx->ra_error;
+		limit = (ctx->end_pos > ctx->file_pos) ? ctx->end_pos : ctx->file_size;
+		if (ctx->file_pos >= limit) {
+			ctx->is_end = GF_TRUE;
+			gf_filter_pid_set_eos(ctx->pid);
+			return GF_EOS;
+		}
+
+		b = filein_ra_find(ctx, ctx->file_pos);
+		if (!b) {
+			filein_ra_schedule(ctx, limit);
+			b = filein_ra_find(ctx, ctx->file_pos);
+		}
+		if (!b || b->reading) {
+			if (nb_sent) break;
+			if (ctx->ra_error) return ctx->ra_error;
+			//all blocks are used by packets, wait for their release
+			if (!gf_file_aio_pending(ctx->aio)) return GF_EOS;
+			filein_ra_collect(ctx, GF_TRUE);
+			continue;
+		}
+
+		end = MIN(b->offset + b->size, limit);
+		pck = gf_filter_pck_new_shared(ctx->pid, b->data + (ctx->file_pos - b->offset), (u32) (end - ctx->file_pos), filein_ra_pck_destructor);
+		if (!pck) return GF_OUT_OF_MEM;
+		safe_int_inc(&b->nb_out);
+
+		if (end==limit) ctx->is_end = GF_TRUE;
+		gf_filter_pck_set_byte_offset(pck, ctx->file_pos);
+		gf_filter_pck_set_framing(pck, ctx->file_pos ? GF_FALSE : GF_TRUE, ctx->is_end);
+		gf_filter_pck_set_sap(pck, GF_FILTER_SAP_1);
+		//block read ahead fully used, widen the window
+		if (ctx->file_pos == b->offset)
+			ctx->ra_win = MIN(2*ctx->ra_win, MAX(ctx->nbra, 1));
+		ctx->file_pos = end;
+		gf_filter_pck_send(pck);
+		nb_sent++;
+
+		if (ctx->is_end) {
+			if (ctx->file_size && (end==ctx->file_size))
+				gf_filter_pid_set_info(ctx->pid, GF_PROP_PID_DOWN_BYTES, &PROP_LONGUINT(ctx->file_size) );
+			else
+				gf_filter_pid_set_info(ctx->pid, GF_PROP_PID_DOWN_BYTES, &PROP_LONGUINT(ctx->range.den - ctx->range.num) );
+			gf_filter_pid_set_eos(ctx->pid);
+			return GF_EOS;
+		}
+		gf_filter_pid_set_info(ctx->pid, GF_PROP_PID_DOWN_BYTES, &PROP_LONGUINT(ctx->file_pos) );
+		if (gf_filter_pid_would_block(ctx->pid))
+			break;
+	}
+	filein_ra_schedule(ctx, limit);
+
+	if (ctx->file_size && gf_filter_reporting_enabled(filter)) {
+		char szStatus[1024], *szSrc;
+		szSrc = gf_file_basename(ctx->src);
+
+		sprintf(szStatus, "%s: % 16"LLD_SUF" /% 16"LLD_SUF" (%02.02f)", szSrc, (s64) ctx->file_pos, (s64) ctx->file_size, ((Double)ctx->file_pos*100.0)/ctx->file_size);
+		gf_filter_update_status(filter, (u32) (ctx->file_pos*10000/ctx->file_size), szStatus);
+	}
+	return GF_OK;
+}
+
 static GF_Err filein_process(GF_Filter *filter)
 {
 	GF_Err e;
@@ -527,6 +781,10 @@ static GF_Err filein_process(GF_Filter *filter)
 		return GF_OK;
 	}
 
+	//first block is read synchronously for format probing
+	if (ctx->aio && ctx->pid && !ctx->do_reconfigure)
+		return filein_process_ra(filter, ctx);
+
 	//compute size to read as u64 (large file)
 	if (ctx->end_pos > ctx->file_pos)
 		lto_read = ctx->end_pos - ctx->file_pos;
@@ -729,6 +987,11 @@ static const GF_FilterArgs FileInArgs[] =
 	{ OFFS(mime), "set file mime type", GF_PROP_NAME, NULL, NULL, 0},
 	{ OFFS(pck), "data to use instead of file", GF_PROP_DATA, NULL, NULL, 0},
 	{ OFFS(ptime), "timing for data packet, ignored if den is 0", GF_PROP_FRACTION, "0/0", NULL, 0},
+	{ OFFS(async), "read blocks ahead in the background (see filter help)\n"
+	"- no: synchronous reads\n"
+	"- thread: use a dedicated I/O thread\n"
+	"- uring: use io_uring if available, I/O thread otherwise", GF_PROP_UINT, "no", "no|thread|uring", GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(nbra), "maximum number of blocks read ahead in async mode", GF_PROP_UINT, "8", NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
 
@@ -750,6 +1013,13 @@ GF_FilterRegister FileInRegister = {
 	"\n"
 	"The filter handles both files and GF_FileIO objects as input URL.\n"
 	"\n"
+	"## Read-ahead\n"
+	"When [-async]() is set, blocks following the current read position are read in the background, and dispatched as packets without copy once read. "
+	"This mostly helps for high latency storage (network file systems, spinning disks).\n"
+	"Up to [-nbra]() blocks are read ahead. This window is reset to a single block whenever a demuxer seeks outside of the data already read, and doubles for each block read in sequence, "
+	"so that sparse accesses (e.g. MP4 demuxing of non-interleaved files) do not trigger useless reads.\n"
+	"If [-block_size]() is 0, 256k blocks are used in this mode. Async mode only applies to regular files.\n"
+	"\n"
 	"## Packet Injecting\n"
 	"The filter can be used to inject a single packet instead of a file using (-pck)[] option.\n"
 	"No specific properties are attached, except a timescale if (-ptime)[] is set.\n"
@@ -630,6 +630,7 @@ static GF_Err routein_initialize(GF_Filter *filter)
 	gf_route_set_allow_progressive_dispatch(ctx->route_dmx, !ctx->fullseg);
 
 	gf_route_set_reorder(ctx->route_dmx, ctx->reorder, ctx->rtimeout);
+	gf_route_set_recv_batch(ctx->route_dmx, ctx->batch);
 
 	if (ctx->tsidbg) {
 		gf_route_dmx_debug_tsi(ctx->route_dmx, ctx->tsidbg);
@@ -692,6 +693,7 @@ static const GF_FilterArgs ROUTEInArgs[] =
 	{ OFFS(gcache), "indicate the files should populate GPAC HTTP cache", GF_PROP_BOOL, "true", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(tunein), "service ID to bootstrap on for ATSC 3.0 mode (0 means tune to no service, -1 tune all services -2 means tune on first service found)", GF_PROP_SINT, "-2", NULL, 0},
 	{ OFFS(buffer), "receive buffer size to use in bytes", GF_PROP_UINT, "0x80000", NULL, GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(batch), "number of datagrams to fetch in a single system call (0 or 1 disables batching)", GF_PROP_UINT, "32", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(timeout), "timeout in ms after which tunein fails", GF_PROP_UINT, "5000", NULL, 0},
     { OFFS(nbcached), "number of segments to keep in cache per service", GF_PROP_UINT, "8", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(kc), "keep corrupted file", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
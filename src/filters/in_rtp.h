@@ -66,7 +66,7 @@ typedef struct
 	u32 firstport, ttl, satip_port;
 	const char *ifce, *force_mcast, *user_agent, *languages;
 	Bool use_client_ports;
-	u32 bandwidth, reorder_len, reorder_delay, nat_keepalive, block_size;
+	u32 bandwidth, reorder_len, reorder_delay, nat_keepalive, block_size, batch;
 	Bool disable_rtcp;
 	u32 default_port;
 	u32 udp_timeout, rtcp_timeout, stats;
@@ -62,8 +62,10 @@ GF_Err rtpin_stream_init(GF_RTPInStream *stream, Bool ResetOnly)
 		e = gf_rtp_initialize(stream->rtp_ch, stream->rtpin->block_size, GF_FALSE, 0, stream->rtpin->reorder_len, stream->rtpin->reorder_delay, (char *)ip_ifce);
 		if (e) return e;
 
-		if (stream->rtp_ch->rtp)
+		if (stream->rtp_ch->rtp) {
+			gf_rtp_set_recv_batch(stream->rtp_ch, stream->rtpin->batch);
 			gf_sk_group_register(stream->rtpin->sockgroup, stream->rtp_ch->rtp);
+		}
 		if (stream->rtp_ch->rtcp)
 			gf_sk_group_register(stream->rtpin->sockgroup, stream->rtp_ch->rtcp);
 
@@ -756,11 +758,14 @@ u32 rtpin_stream_read(GF_RTPInStream *stream)
 	}
 
 	if (gf_sk_group_sock_is_set(stream->rtpin->sockgroup, stream->rtp_ch->rtp, GF_SK_SELECT_READ)) {
-		size = gf_rtp_read_rtp(stream->rtp_ch, stream->buffer, stream->rtpin->block_size);
-		if (size) {
-			tot_size += size;
-			rtpin_stream_on_rtp_pck(stream, stream->buffer, size);
-		}
+		//process all datagrams fetched by the channel
+		do {
+			size = gf_rtp_read_rtp(stream->rtp_ch, stream->buffer, stream->rtpin->block_size);
+			if (size) {
+				tot_size += size;
+				rtpin_stream_on_rtp_pck(stream, stream->buffer, size);
+			}
+		} while (gf_rtp_read_pending(stream->rtp_ch));
 		stream->rtpin->eos_probe_start = 0;
 	}
 
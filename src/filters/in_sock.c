@@ -63,8 +63,8 @@ typedef struct
 	char *ifce;
 	const char *ext;
 	const char *mime;
-	Bool tsprobe, listen, ka, block;
-	u32 timeout;
+	Bool tsprobe, listen, ka, block, rxts;
+	u32 timeout, batch;
 #ifndef GPAC_DISABLE_STREAMING
 	u32 reorder_pck;
 	u32 reorder_delay;
@@ -78,6 +78,9 @@ typedef struct
 	Bool is_stop;
 
 	char *buffer;
+	//batched UDP reception
+	u32 *rx_sizes;
+	u64 *rx_ntps;
 
 	GF_SockGroup *active_sockets;
 	u32 last_rcv_time;
@@ -195,6 +198,11 @@ static GF_Err sockin_initialize(GF_Filter *filter)
 
 	ctx->buffer = gf_malloc(ctx->block_size + 1);
 	if (!ctx->buffer) return GF_OUT_OF_MEM;
+	if (ctx->is_udp && (ctx->batch>1)) {
+		ctx->rx_sizes = gf_malloc(sizeof(u32) * ctx->batch);
+		ctx->rx_ntps = gf_malloc(sizeof(u64) * ctx->batch);
+		if (!ctx->rx_sizes || !ctx->rx_ntps) return GF_OUT_OF_MEM;
+	}
 	//ext/mime given and not mpeg2, disable probe
 	if (ctx->ext && !strstr("ts|m2t|mts|dmb|trp", ctx->ext)) ctx->tsprobe = GF_FALSE;
 	if (ctx->mime && !strstr(ctx->mime, "mpeg-2") && !strstr(ctx->mime, "mp2t")) ctx->tsprobe = GF_FALSE;
@@ -233,6 +241,8 @@ static void sockin_finalize(GF_Filter *filter)
 	}
 	sockin_client_reset(&ctx->sock_c);
 	if (ctx->buffer) gf_free(ctx->buffer);
+	if (ctx->rx_sizes) gf_free(ctx->rx_sizes);
+	if (ctx->rx_ntps) gf_free(ctx->rx_ntps);
 	if (ctx->active_sockets) gf_sk_group_del(ctx->active_sockets);
 }
 
@@ -283,7 +293,7 @@ static Bool sockin_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 static GF_Err sockin_read_client(GF_Filter *filter, GF_SockInCtx *ctx, GF_SockInClient *sock_c)
 {
 	u32 nb_read, pos;
-	u64 now;
+	u64 now, rx_ntp=0;
 	GF_Err e;
 	GF_FilterPacket *dst_pck;
 	u8 *out_data, *in_data;
@@ -302,7 +312,34 @@ static GF_Err sockin_read_client(GF_Filter *filter, GF_SockInCtx *ctx, GF_SockIn
 	nb_read=0;
 	while (pos < ctx->block_size) {
 		u32 read=0;
-		e = gf_sk_receive_no_select(sock_c->socket, ctx->buffer+pos, ctx->block_size - pos, &read);
+		Bool drained = GF_FALSE;
+		u32 nb_slots = (ctx->block_size - pos) / GF_SK_BATCH_SLOT_SIZE;
+		if (nb_slots > ctx->batch) nb_slots = ctx->batch;
+
+		//raw UDP once probed, fetch all pending datagrams at once and pack them
+		if (ctx->rx_sizes && sock_c->pid && (nb_slots>1)
+#ifndef GPAC_DISABLE_STREAMING
+		 && !sock_c->rtp_reorder
+#else
+		 && !sock_c->is_rtp
+#endif
+		) {
+			u32 i, nb_dgrams=0;
+			e = gf_sk_receive_batch(sock_c->socket, ctx->buffer+pos, GF_SK_BATCH_SLOT_SIZE, nb_slots, ctx->rx_sizes, ctx->rxts ? ctx->rx_ntps : NULL, &nb_dgrams);
+			if (!e) {
+				if (!nb_read && ctx->rxts) rx_ntp = ctx->rx_ntps[0];
+				for (i=0; i<nb_dgrams; i++) {
+					u32 slot_pos = pos + i*GF_SK_BATCH_SLOT_SIZE;
+					if (slot_pos != pos + read)
+						memmove(ctx->buffer + pos + read, ctx->buffer + slot_pos, ctx->rx_sizes[i]);
+					read += ctx->rx_sizes[i];
+				}
+				//no more datagrams pending
+				if (nb_dgrams < nb_slots) drained = GF_TRUE;
+			}
+		} else {
+			e = gf_sk_receive_no_select(sock_c->socket, ctx->buffer+pos, ctx->block_size - pos, &read);
+		}
 		if (e) {
 			if (nb_read) break;
 			switch (e) {
@@ -334,6 +371,7 @@ static GF_Err sockin_read_client(GF_Filter *filter, GF_SockInCtx *ctx, GF_SockIn
 		 )
 			break;
 		pos += read;
+		if (drained) break;
 	}
 	if (!nb_read) return GF_OK;
 
@@ -417,6 +455,8 @@ static GF_Err sockin_read_client(GF_Filter *filter, GF_SockInCtx *ctx, GF_SockIn
 	if (!dst_pck) return GF_OUT_OF_MEM;
 
 	memcpy(out_data, in_data, nb_read);
+	if (rx_ntp)
+		gf_filter_pck_set_property(dst_pck, GF_PROP_PCK_RECEIVER_NTP, &PROP_LONGUINT(rx_ntp));
 
 	gf_filter_pck_set_framing(dst_pck, sock_c->first_pck, GF_FALSE);
 	gf_filter_pck_send(dst_pck);
@@ -612,6 +652,8 @@ static const GF_FilterArgs SockInArgs[] =
 	{ OFFS(mime), "indicate mime type of udp data", GF_PROP_STRING, NULL, NULL, 0},
 	{ OFFS(block), "set blocking mode for socket(s)", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(timeout), "set timeout in ms for UDP socket(s), 0 to disable timeout", GF_PROP_UINT, "10000", NULL, GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(batch), "number of UDP datagrams to fetch in a single system call (0 or 1 disables batching)", GF_PROP_UINT, "32", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(rxts), "set reception time of the first datagram of each block, taken by the kernel when supported, as `ReceiverNTP` packet property (UDP batching only)", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 
 #ifndef GPAC_DISABLE_STREAMING
 	{ OFFS(reorder_pck), "number of packets delay for RTP reordering (M2TS over RTP) ", GF_PROP_UINT, "100", NULL, GF_FS_ARG_HINT_ADVANCED},
@@ -55,6 +55,15 @@ enum
 	MP4DMX_XPS_REMOVE,
 };
 
+//memory mapping of the source file, shared by all packets pointing to it
+typedef struct
+{
+	u8 *data;
+	u64 size;
+	//one ref for the reader as long as the mapping is active, one per packet
+	u32 nb_refs;
+} ISOMFileMap;
+
 typedef struct
 {
 	//options
@@ -75,6 +84,7 @@ typedef struct
 	u32 nodata;
 	u32 mstore_purge, mstore_samples, mstore_size;
 	s32 ctso;
+	Bool mmap, lazy;
 
 	//internal
 
@@ -131,6 +141,16 @@ typedef struct
 	u64 last_min_offset;
 	GF_Err in_error;
 	Bool force_fetch;
+
+	//file opened in lazy mode, fragments loaded on demand
+	Bool lazy_mode;
+	//bytes dispatched since last sample table purge in lazy mode
+	u64 lazy_bytes;
+
+	//active file mapping if any, and list of all mappings still in use by packets
+	ISOMFileMap *fmap;
+	GF_List *fmaps;
+	GF_Mutex *fmap_mx;
 } ISOMReader;
 
 typedef struct
@@ -182,6 +202,8 @@ typedef struct
 	u8 check_avc_ps, check_hevc_ps, check_vvc_ps, check_mhas_pl;
 	u8 needs_pid_reconfig;
 	u8 check_has_rap;
+	//raw samples packed, sample tables are not purged in lazy mode
+	u8 raw_pack;
 	//0: no drop, 1: only keeps sap, 2: only keeps saps until next sap, then regular mode
 	u8 sap_only;
 
@@ -233,6 +255,9 @@ void isor_set_crypt_config(ISOMChannel *ch);
 
 void isor_reader_check_config(ISOMChannel *ch);
 
+Bool isor_is_mapped_data(ISOMReader *read, const u8 *data);
+void isor_reset_mapped_sample(ISOMChannel *ch);
+
 Bool isor_declare_item_properties(ISOMReader *read, ISOMChannel *ch, u32 item_idx);
 
 void isor_declare_pssh(ISOMChannel *ch);
@@ -762,6 +762,16 @@ static void isor_declare_track(ISOMReader *read, ISOMChannel *ch, u32 track, u32
 				sample_count = 0;
 			}
 		}
+		//lazy mode, only the first fragments are loaded
+		else if (read->lazy_mode) {
+			Double dur;
+			gf_isom_get_lazy_fragments(read->mov, NULL, NULL, &dur);
+			if (dur>0) {
+				ch->duration = (u64) (dur * read->timescale);
+				use_sidx_dur = GF_TRUE;
+			}
+			sample_count = 0;
+		}
 #endif
 
 		if (!read->mem_load_mode || ch->duration) {
@@ -810,7 +820,7 @@ static void isor_declare_track(ISOMReader *read, ISOMChannel *ch, u32 track, u32
 		mtype = gf_isom_get_media_type(read->mov, track);
 		gf_filter_pid_set_property(ch->pid, GF_PROP_PID_SUBTYPE, &PROP_4CC(mtype) );
 
-		if (!read->mem_load_mode) {
+		if (!read->mem_load_mode && !read->lazy_mode) {
 			gf_filter_pid_set_property(ch->pid, GF_PROP_PID_MEDIA_DATA_SIZE, &PROP_LONGUINT(gf_isom_get_media_data_size(read->mov, track) ) );
 		}
 		//in no cache mode, depending on fetch speed we may have fetched a fragment or not, resulting in has_rap set
@@ -1262,7 +1272,7 @@ props_done:
 	if (audio_fmt) {
 		gf_filter_pid_set_property(ch->pid, GF_PROP_PID_AUDIO_FORMAT, &PROP_UINT(audio_fmt));
 		if (codec_id == GF_CODECID_RAW) {
-			gf_isom_enable_raw_pack(read->mov, track, read->frame_size);
+			ch->raw_pack = gf_isom_enable_raw_pack(read->mov, track, read->frame_size) ? 1 : 0;
 		}
 	}
 	if (pix_fmt) {
@@ -60,6 +60,96 @@ static GFINLINE Bool isor_is_local(const char *url)
 }
 
 
+GF_Err gf_isom_set_sample_map(GF_ISOFile *the_file, u8 *map, u64 map_size);
+
+Bool isor_is_mapped_data(ISOMReader *read, const u8 *data)
+{
+	if (!read->fmap || !data) return GF_FALSE;
+	if ((data >= read->fmap->data) && (data < read->fmap->data + read->fmap->size)) return GF_TRUE;
+	return GF_FALSE;
+}
+
+//must be called with fmap_mx locked
+static void isor_mmap_unref(ISOMReader *read, ISOMFileMap *fmap)
+{
+	gf_assert(fmap->nb_refs);
+	fmap->nb_refs--;
+	if (fmap->nb_refs) return;
+	gf_list_del_item(read->fmaps, fmap);
+	gf_file_munmap(fmap->data, fmap->size);
+	gf_free(fmap);
+}
+
+static void isor_mmap_pck_destructor(GF_Filter *filter, GF_FilterPid *pid, GF_FilterPacket *pck)
+{
+	u32 i, size;
+	ISOMReader *read = gf_filter_get_udta(filter);
+	const u8 *data = gf_filter_pck_get_data(pck, &size);
+
+	gf_mx_p(read->fmap_mx);
+	for (i=0; i<gf_list_count(read->fmaps); i++) {
+		ISOMFileMap *fmap = gf_list_get(read->fmaps, i);
+		if ((data >= fmap->data) && (data < fmap->data + fmap->size)) {
+			isor_mmap_unref(read, fmap);
+			break;
+		}
+	}
+	gf_mx_v(read->fmap_mx);
+}
+
+static GF_FilterPacket *isor_mmap_new_packet(ISOMReader *read, ISOMChannel *ch)
+{
+	GF_FilterPacket *pck = gf_filter_pck_new_shared(ch->pid, ch->sample->data, ch->sample->dataLength, isor_mmap_pck_destructor);
+	if (!pck) return NULL;
+	gf_mx_p(read->fmap_mx);
+	read->fmap->nb_refs++;
+	gf_mx_v(read->fmap_mx);
+	return pck;
+}
+
+//detach active mapping, unmapped once no more packets use it
+static void isor_mmap_release(ISOMReader *read)
+{
+	if (!read->fmap) return;
+	gf_mx_p(read->fmap_mx);
+	isor_mmap_unref(read, read->fmap);
+	read->fmap = NULL;
+	gf_mx_v(read->fmap_mx);
+}
+
+static void isor_mmap_setup(ISOMReader *read, const char *url)
+{
+	ISOMFileMap *fmap;
+	u64 size;
+	u8 *data;
+
+	isor_mmap_release(read);
+	if (!read->mmap || read->nodata) return;
+	//only map complete local files, loaded without byte range
+	if (!read->input_loaded || read->missing_bytes || read->start_range || read->end_range) return;
+
+	data = gf_file_mmap(url, &size);
+	if (!data) {
+		GF_LOG(GF_LOG_INFO, GF_LOG_CONTAINER, ("[IsoMedia] Cannot map file %s, using regular reads\n", url));
+		return;
+	}
+	if (!read->fmaps) read->fmaps = gf_list_new();
+	if (!read->fmap_mx) read->fmap_mx = gf_mx_new("ISOMFileMap");
+	GF_SAFEALLOC(fmap, ISOMFileMap);
+	if (!fmap || !read->fmaps || !read->fmap_mx || gf_isom_set_sample_map(read->mov, data, size)) {
+		if (fmap) gf_free(fmap);
+		gf_file_munmap(data, size);
+		return;
+	}
+	fmap->data = data;
+	fmap->size = size;
+	fmap->nb_refs = 1;
+	gf_mx_p(read->fmap_mx);
+	gf_list_add(read->fmaps, fmap);
+	read->fmap = fmap;
+	gf_mx_v(read->fmap_mx);
+}
+
 static GF_Err isoffin_setup(GF_Filter *filter, ISOMReader *read, Bool input_is_eos)
 {
 	char *url;
@@ -141,7 +231,21 @@ static GF_Err isoffin_setup(GF_Filter *filter, ISOMReader *read, Bool input_is_e
 	}
 
 	read->missing_bytes = 0;
-	e = gf_isom_open_progressive(url, read->start_range, read->end_range, read->sigfrag, &read->mov, &read->missing_bytes);
+	read->lazy_mode = GF_FALSE;
+#ifndef GPAC_DISABLE_ISOM_FRAGMENTS
+	//lazy loading of fragments, only for complete local files
+	if (read->lazy && !read->sigfrag && !read->start_range && !read->end_range) {
+		prop = read->pid ? gf_filter_pid_get_property(read->pid, GF_PROP_PID_FILE_CACHED) : NULL;
+		if (!read->pid || (prop && prop->value.boolean)) {
+			if (gf_isom_open_lazy(url, &read->mov) == GF_OK)
+				read->lazy_mode = gf_isom_get_lazy_fragments(read->mov, NULL, NULL, NULL) ? GF_TRUE : GF_FALSE;
+		}
+	}
+	if (read->mov)
+		e = GF_OK;
+	else
+#endif
+		e = gf_isom_open_progressive(url, read->start_range, read->end_range, read->sigfrag, &read->mov, &read->missing_bytes);
 
 	if (e == GF_ISOM_INCOMPLETE_FILE) {
 		if (input_is_eos) {
@@ -177,6 +281,8 @@ static GF_Err isoffin_setup(GF_Filter *filter, ISOMReader *read, Bool input_is_e
 	if (read->strtxt)
 		gf_isom_text_set_streaming_mode(read->mov, GF_TRUE);
 
+	isor_mmap_setup(read, url);
+
 	gf_free(url);
 	e = isor_declare_objects(read);
 	if (e && (e!= GF_ISOM_INCOMPLETE_FILE)) {
@@ -208,6 +314,7 @@ static void isoffin_disconnect(ISOMReader *read)
 
 	if (read->mov) gf_isom_close(read->mov);
 	read->mov = NULL;
+	isor_mmap_release(read);
 
 	read->pid = NULL;
 }
@@ -566,6 +673,16 @@ static void isoffin_finalize(GF_Filter *filter)
 	if (!read->extern_mov && read->mov) gf_isom_close(read->mov);
 	read->mov = NULL;
 
+	isor_mmap_release(read);
+	//no more packets pending at this point
+	while (gf_list_count(read->fmaps)) {
+		ISOMFileMap *fmap = gf_list_pop_back(read->fmaps);
+		gf_file_munmap(fmap->data, fmap->size);
+		gf_free(fmap);
+	}
+	gf_list_del(read->fmaps);
+	if (read->fmap_mx) gf_mx_del(read->fmap_mx);
+
 	if (read->mem_blob.data) gf_free(read->mem_blob.data);
 	if (read->mem_url) {
 		gf_blob_unregister(&read->mem_blob);
@@ -877,6 +994,7 @@ u32 isoffin_channel_switch_quality(ISOMChannel *ch, GF_ISOFile *the_file, Bool s
 						GF_Err e;
 						//try to locate sync after current time in base
 						resume_at = base->static_sample ? gf_timestamp_rescale(base->static_sample->DTS, base->timescale, ch->timescale) : 0;
+						isor_reset_mapped_sample(ch);
 						e = gf_isom_get_sample_for_media_time(ch->owner->mov, ch->track, resume_at, &sample_desc_index, GF_ISOM_SEARCH_SYNC_FORWARD, &ch->static_sample, &ch->sample_num, &ch->sample_data_offset);
 						//found, rewind so that next fetch is the sync
 						if (e==GF_OK) {
@@ -1080,7 +1198,19 @@ static Bool isoffin_process_event(GF_Filter *filter, const GF_FilterEvent *evt)
 			read->mem_blob.size = 0;
 			//send play event
 			cancel_event = GF_FALSE;
-		} else if (!read->nb_playing && read->pid && !read->input_loaded) {
+		}
+#ifndef GPAC_DISABLE_ISOM_FRAGMENTS
+		else if (read->lazy_mode && !read->nb_playing) {
+			u32 next_range;
+			gf_isom_get_lazy_fragments(read->mov, &next_range, NULL, NULL);
+			//sample tables no longer start with the first fragment, reload
+			if ((start_range>0) || (next_range>1)) {
+				gf_isom_lazy_seek(read->mov, start_range);
+				read->lazy_bytes = 0;
+			}
+		}
+#endif
+		else if (!read->nb_playing && read->pid && !read->input_loaded) {
 			GF_FilterEvent fevt;
 			Bool is_sidx_seek = GF_FALSE;
 			u64 max_offset = GF_FILTER_NO_BO;
@@ -1344,6 +1474,58 @@ static void isoffin_purge_mem(ISOMReader *read, u64 min_offset)
 	}
 }
 
+#ifndef GPAC_DISABLE_ISOM_FRAGMENTS
+//max time in seconds between the end of a channel and the next fragment range for the channel to trigger a load
+#define ISOR_LAZY_MARGIN	1.0
+
+//loads the next fragment range for a channel with no more samples, return GF_TRUE if loaded
+//the range is not loaded if other channels can still progress and the range starts well after the channel end
+static Bool isoffin_lazy_load(ISOMReader *read, ISOMChannel *for_ch)
+{
+	u32 i, count, nb_samples, next_range, nb_ranges;
+	Double next_time;
+	Bool others_stalled = GF_TRUE;
+
+	nb_ranges = gf_isom_get_lazy_fragments(read->mov, &next_range, &next_time, NULL);
+	if (next_range >= nb_ranges) return GF_FALSE;
+	count = gf_list_count(read->channels);
+	for (i=0; i<count; i++) {
+		ISOMChannel *ch = gf_list_get(read->channels, i);
+		if ((ch==for_ch) || !ch->playing || ch->eos_sent) continue;
+		if ((ch->last_state!=GF_EOS) && !gf_filter_pid_would_block(ch->pid)) {
+			others_stalled = GF_FALSE;
+			break;
+		}
+	}
+	//sparse or shorter track, otherwise all remaining fragments would be loaded for this channel
+	if (!others_stalled) {
+		nb_samples = gf_isom_get_sample_count(read->mov, for_ch->track);
+		if (!nb_samples || !for_ch->timescale) return GF_FALSE;
+		if (next_time>=0) {
+			Double end = (Double) (gf_isom_get_sample_dts(read->mov, for_ch->track, nb_samples) + gf_isom_get_sample_duration(read->mov, for_ch->track, nb_samples));
+			end /= for_ch->timescale;
+			if (next_time > end + ISOR_LAZY_MARGIN) return GF_FALSE;
+		}
+	}
+	//on error the range is skipped
+	if (gf_isom_lazy_load_next(read->mov) != GF_OK) return GF_FALSE;
+
+	//purge samples already dispatched every mstore_purge bytes
+	if (read->mstore_purge && (read->lazy_bytes < read->mstore_purge))
+		return GF_TRUE;
+	read->lazy_bytes = 0;
+	for (i=0; i<count; i++) {
+		ISOMChannel *ch = gf_list_get(read->channels, i);
+		if (!ch->playing || ch->raw_pack || (ch->sample_num<=1)) continue;
+		nb_samples = gf_isom_get_sample_count(read->mov, ch->track);
+		if (ch->sample_num-1 >= nb_samples) continue;
+		if (gf_isom_purge_samples(read->mov, ch->track, ch->sample_num-1) == GF_OK)
+			ch->sample_num = 1;
+	}
+	return GF_TRUE;
+}
+#endif
+
 static GF_Err isoffin_process(GF_Filter *filter)
 {
 	ISOMReader *read = gf_filter_get_udta(filter);
@@ -1497,6 +1679,7 @@ static GF_Err isoffin_process(GF_Filter *filter)
 	for (i=0; i<count; i++) {
 		u8 *data;
 		u32 nb_pck=50;
+		Bool lazy_loaded=GF_FALSE;
 		ISOMChannel *ch;
 		ch = gf_list_get(read->channels, i);
 		if (!ch->playing) {
@@ -1558,7 +1741,19 @@ static GF_Err isoffin_process(GF_Filter *filter)
 				//strip param sets from payload, trigger reconfig if needed
 				isor_reader_check_config(ch);
 
-				if (ch->pck) {
+				if (isor_is_mapped_data(read, ch->sample->data)) {
+					//sample points to the file mapping, send as shared packet
+					if (ch->pck) {
+						gf_filter_pck_discard(ch->pck);
+						ch->pck = NULL;
+					}
+					pck = isor_mmap_new_packet(read, ch);
+					if (!pck) return GF_OUT_OF_MEM;
+					ch->static_sample->data = NULL;
+					ch->static_sample->dataLength = 0;
+					ch->static_sample->alloc_size=0;
+				}
+				else if (ch->pck) {
 					pck = ch->pck;
 					ch->pck = NULL;
 					gf_filter_pck_check_realloc(pck, ch->sample->data, ch->sample->dataLength);
@@ -1685,6 +1880,11 @@ static GF_Err isoffin_process(GF_Filter *filter)
 					ch->set_disc = 0;
 					gf_filter_pck_set_clock_type(pck, GF_FILTER_CLOCK_PCR_DISC);
 				}
+				if (read->lazy_mode) {
+					u32 pck_size;
+					gf_filter_pck_get_data(pck, &pck_size);
+					read->lazy_bytes += pck_size;
+				}
 				gf_filter_pck_send(pck);
 				isor_reader_release_sample(ch);
 
@@ -1692,6 +1892,18 @@ static GF_Err isoffin_process(GF_Filter *filter)
 				if (!in_is_flush)
 					nb_pck--;
 			} else if (ch->last_state==GF_EOS) {
+#ifndef GPAC_DISABLE_ISOM_FRAGMENTS
+				//more fragments to load, at most one range per channel and per call
+				if (read->lazy_mode && !in_is_flush) {
+					u32 next_range, nb_ranges = gf_isom_get_lazy_fragments(read->mov, &next_range, NULL, NULL);
+					if (!lazy_loaded && isoffin_lazy_load(read, ch)) {
+						lazy_loaded = GF_TRUE;
+						ch->last_state = GF_OK;
+						continue;
+					}
+					if (next_range < nb_ranges) break;
+				}
+#endif
 				if (in_is_flush) {
 					gf_filter_pid_send_flush(ch->pid);
 				}
@@ -1810,7 +2022,7 @@ static const GF_FilterArgs ISOFFInArgs[] =
 	{ OFFS(catseg), "append the given segment to the movie at init time (only local file supported)", GF_PROP_STRING, NULL, NULL, GF_FS_ARG_HINT_HIDE},
 	{ OFFS(nocrypt), "signal encrypted tracks as non encrypted (mostly used for export)", GF_PROP_BOOL, NULL, NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(mstore_size), "target buffer size in bytes when reading from memory stream (pipe etc...)", GF_PROP_UINT, "1000000", NULL, GF_FS_ARG_HINT_EXPERT},
-	{ OFFS(mstore_purge), "minimum size in bytes between memory purges when reading from memory stream, 0 means purge as soon as possible", GF_PROP_UINT, "50000", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(mstore_purge), "minimum size in bytes between memory purges when reading from memory stream, or between sample table purges in lazy mode, 0 means purge as soon as possible", GF_PROP_UINT, "50000", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(mstore_samples), "minimum number of samples to be present before purging sample tables when reading from memory stream (pipe etc...), 0 means purge as soon as possible", GF_PROP_UINT, "50", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(strtxt), "load text tracks (apple/tx3g) as MPEG-4 streaming text tracks", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(xps_check), "parameter sets extraction mode from AVC/HEVC/VVC samples\n"
@@ -1823,6 +2035,8 @@ static const GF_FilterArgs ISOFFInArgs[] =
 	"- yes: skip data loading\n"
 	"- fake: allocate sample but no data copy", GF_PROP_UINT, "no", "no|yes|fake", GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(lightp), "load minimal set of properties", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(lazy), "load fragments of local fragmented files on demand, using sidx, mfra or a top-level box scan to locate them (ignored if `sigfrag` is set)", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(mmap), "map complete local files in memory and dispatch samples as shared packets pointing to the mapping when no sample rewrite is needed", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(initseg), "local init segment name when input is a single ISOBMFF segment", GF_PROP_STRING, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(ctso), "value to add to CTS offset for tracks using negative ctts\n"
 	"- set to `-1` to use the `cslg` box info or the minimum cts offset present in the track\n"
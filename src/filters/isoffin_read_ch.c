@@ -39,6 +39,7 @@ void isor_reset_reader(ISOMChannel *ch)
 	isor_reader_release_sample(ch);
 
 	if (ch->static_sample) {
+		isor_reset_mapped_sample(ch);
 		ch->static_sample->dataLength = ch->static_sample->alloc_size;
 		gf_isom_sample_del(&ch->static_sample);
 	}
@@ -324,6 +325,35 @@ u8 *isor_sample_alloc(u32 size, void *udta)
 	return output;
 }
 
+//static sample data pointing to the file mapping is never reused, as the mapping may no longer be attached to the file
+void isor_reset_mapped_sample(ISOMChannel *ch)
+{
+	if (!ch->static_sample || !ch->static_sample->data) return;
+	if (!isor_is_mapped_data(ch->owner, ch->static_sample->data)) return;
+	ch->static_sample->data = NULL;
+	ch->static_sample->dataLength = 0;
+	ch->static_sample->alloc_size = 0;
+}
+
+//copy sample pointing to the file mapping into a regular packet before modifying its payload
+//returns GF_FALSE if the sample still points to the read-only mapping
+static Bool isor_sample_unshare(ISOMChannel *ch)
+{
+	u8 *output;
+	GF_FilterPacket *pck;
+	if (!isor_is_mapped_data(ch->owner, ch->sample->data)) return GF_TRUE;
+
+	pck = gf_filter_pck_new_alloc(ch->pid, ch->sample->dataLength, &output);
+	if (!pck) return GF_FALSE;
+	if (ch->pck) gf_filter_pck_discard(ch->pck);
+	ch->pck = pck;
+	memcpy(output, ch->sample->data, ch->sample->dataLength);
+	ch->alloc_size = ch->sample->dataLength;
+	ch->sample->data = output;
+	ch->sample->alloc_size = ch->sample->dataLength;
+	return GF_TRUE;
+}
+
 void isor_reader_get_sample(ISOMChannel *ch)
 {
 	GF_Err e;
@@ -331,6 +361,8 @@ void isor_reader_get_sample(ISOMChannel *ch)
 	u32 sample_desc_index;
 	if (ch->sample) return;
 
+	isor_reset_mapped_sample(ch);
+
 	if (ch->next_track) {
 		ch->track = ch->next_track;
 		if (!ch->owner->nodata)
@@ -1080,6 +1112,11 @@ void isor_reader_check_config(ISOMChannel *ch)
 
 		if (replace_nal) {
 			u32 move_size = ch->sample->dataLength - size - pos - nalu_len;
+			//cannot modify the mapped payload, send the sample as is
+			if (!isor_sample_unshare(ch)) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_CONTAINER, ("[IsoMedia] Failed to allocate packet, in-band parameter sets not removed\n"));
+				break;
+			}
 			isor_replace_nal(ch, ch->sample->data + pos + nalu_len, size, nal_type, &needs_reset);
 			if (move_size)
 				memmove(ch->sample->data + pos, ch->sample->data + pos + size + nalu_len, ch->sample->dataLength - size - pos - nalu_len);
@@ -4644,6 +4644,40 @@ GF_Err gf_isom_fragment_add_sample_ex(GF_ISOFile *movie, GF_ISOTrackID TrackID,
 GF_Err gf_isom_fragment_append_data_ex(GF_ISOFile *movie, GF_ISOTrackID TrackID, u8 *data, u32 data_size, u8 PaddingBits, void **ref, u32 ref_offset);
 #endif
 
+//writes the data of a segmented packet one segment at a time: the first segment creates the sample unless is_append is set, next ones are appended
+static GF_Err mp4_mux_write_segments(GF_MP4MuxCtx *ctx, TrackWriter *tkw, GF_FilterPacket *pck, u32 sample_desc_index, u32 duration, Bool for_fragment, Bool is_append)
+{
+	GF_Err e = GF_OK;
+	u32 i, count = gf_filter_pck_get_segment_count(pck);
+	for (i=0; (i<count) && !e; i++) {
+		u32 size;
+		u8 *data = (u8 *) gf_filter_pck_get_segment(pck, i, &size);
+		if (!i && !is_append) {
+			GF_ISOSample s = tkw->sample;
+			s.data = data;
+			s.dataLength = size;
+			if (for_fragment) {
+#ifndef GPAC_DISABLE_ISOM_FRAGMENTS
+				e = gf_isom_fragment_add_sample(ctx->file, tkw->track_id, &s, sample_desc_index, duration, 0, 0, 0);
+#else
+				e = GF_NOT_SUPPORTED;
+#endif
+			} else {
+				e = gf_isom_add_sample(ctx->file, tkw->track_num, sample_desc_index, &s);
+			}
+		} else if (for_fragment) {
+#ifndef GPAC_DISABLE_ISOM_FRAGMENTS
+			e = gf_isom_fragment_append_data(ctx->file, tkw->track_id, data, size, 0);
+#else
+			e = GF_NOT_SUPPORTED;
+#endif
+		} else {
+			e = gf_isom_append_sample_data(ctx->file, tkw->track_num, data, size);
+		}
+	}
+	return e;
+}
+
 static GF_Err mp4_mux_process_sample(GF_MP4MuxCtx *ctx, TrackWriter *tkw, GF_FilterPacket *pck, Bool for_fragment)
 {
 	GF_Err e=GF_OK;
@@ -4657,6 +4691,7 @@ static GF_Err mp4_mux_process_sample(GF_MP4MuxCtx *ctx, TrackWriter *tkw, GF_Fil
 	u32 first_nal_is_audelim = GF_FALSE;
 	u32 sample_desc_index = tkw->stsd_idx;
 	Bool sample_timing_ok = GF_TRUE;
+	Bool use_segs = GF_FALSE;
 
 	timescale = gf_filter_pck_get_timescale(pck);
 
@@ -4667,6 +4702,11 @@ static GF_Err mp4_mux_process_sample(GF_MP4MuxCtx *ctx, TrackWriter *tkw, GF_Fil
 		tkw->dgl_copy = gf_filter_pck_dangling_copy(pck, tkw->dgl_copy);
 		if (!tkw->dgl_copy) return GF_IO_ERR;
 		tkw->sample.data = (char *)gf_filter_pck_get_data(tkw->dgl_copy, &tkw->sample.dataLength);
+	} else if (gf_filter_pck_get_segment_count(pck)>1) {
+		//segmented packet, written without gathering the segments
+		tkw->sample.data = NULL;
+		tkw->sample.dataLength = gf_filter_pck_get_data_size(pck);
+		use_segs = GF_TRUE;
 	} else {
 		tkw->sample.data = (char *)gf_filter_pck_get_data(pck, &tkw->sample.dataLength);
 	}
@@ -4877,7 +4917,9 @@ static GF_Err mp4_mux_process_sample(GF_MP4MuxCtx *ctx, TrackWriter *tkw, GF_Fil
 			GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[MP4Mux] Cannot add sample reference at DTS "LLU" , input sample data is not continous in source\n", tkw->sample.DTS ));
 		}
 	} else if (tkw->nb_frames_per_sample && (tkw->nb_samples % tkw->nb_frames_per_sample)) {
-		if (for_fragment) {
+		if (use_segs) {
+			e = mp4_mux_write_segments(ctx, tkw, pck, sample_desc_index, duration, for_fragment, GF_TRUE);
+		} else if (for_fragment) {
 #ifndef GPAC_DISABLE_ISOM_FRAGMENTS
 		 	e = gf_isom_fragment_append_data(ctx->file, tkw->track_id, tkw->sample.data, tkw->sample.dataLength, 0);
 #else
@@ -4903,8 +4945,15 @@ static GF_Err mp4_mux_process_sample(GF_MP4MuxCtx *ctx, TrackWriter *tkw, GF_Fil
 			u32 inband_xps_size;
 			char *au_delim=NULL;
 			u32 au_delim_size=0;
-			char *pck_data = tkw->sample.data;
-			u32 pck_data_len = tkw->sample.dataLength;
+			char *pck_data;
+			u32 pck_data_len;
+			//AU delimiter detection needs contiguous data
+			if (use_segs) {
+				tkw->sample.data = (char *)gf_filter_pck_get_data(pck, &tkw->sample.dataLength);
+				use_segs = GF_FALSE;
+			}
+			pck_data = tkw->sample.data;
+			pck_data_len = tkw->sample.dataLength;
 			if (tkw->sample.IsRAP || tkw->force_inband_inject) {
 				inband_xps = tkw->inband_hdr;
 				inband_xps_size = tkw->inband_hdr_size;
@@ -4976,6 +5025,11 @@ static GF_Err mp4_mux_process_sample(GF_MP4MuxCtx *ctx, TrackWriter *tkw, GF_Fil
 				if (!e) e = gf_isom_append_sample_data(ctx->file, tkw->track_num, pck_data, pck_data_len);
 			}
 			insert_subsample_dsi_size = inband_xps_size;
+		} else if (use_segs) {
+			e = mp4_mux_write_segments(ctx, tkw, pck, sample_desc_index, duration, for_fragment, GF_FALSE);
+			if (!e && !for_fragment && !duration) {
+				gf_isom_set_last_sample_duration(ctx->file, tkw->track_num, 0);
+			}
 		} else if (for_fragment) {
 #ifndef GPAC_DISABLE_ISOM_FRAGMENTS
 			if ((ctx->subs_sidx>0) || gf_filter_pck_is_blocking_ref(pck)) {
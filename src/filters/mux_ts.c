@@ -116,7 +116,6 @@ typedef struct
 
 	Bool check_pcr;
 	Bool update_mux;
-	char *pack_buffer;
 	u64 nb_pck;
 	Bool init_buffering;
 	u32 last_log_time;
@@ -434,6 +433,7 @@ static GF_Err tsmux_esi_ctrl(GF_ESInterface *ifce, u32 act_type, void *param)
 	case GF_ESI_INPUT_DATA_FLUSH:
 	{
 		u64 dts;
+		u32 nb_segs;
 		GF_ESIPacket es_pck;
 		const GF_PropertyValue *p;
 		GF_FilterPacket *pck;
@@ -708,7 +708,14 @@ static GF_Err tsmux_esi_ctrl(GF_ESInterface *ifce, u32 act_type, void *param)
 				es_pck.flags |= GF_ESI_DATA_HAS_DTS;
 			}
 		}
-		es_pck.data = (char *) gf_filter_pck_get_data(pck, &es_pck.data_len);
+		//segmented packets are dispatched one segment at a time and reassembled by the muxer, unless the payload is rewritten
+		nb_segs = gf_filter_pck_get_segment_count(pck);
+		if ((nb_segs>1) && !tspid->rewrite_odf && (tspid->codec_id != GF_CODECID_TX3G) && (tspid->codec_id != GF_CODECID_WEBVTT)) {
+			es_pck.data_len = gf_filter_pck_get_data_size(pck);
+		} else {
+			nb_segs = 1;
+			es_pck.data = (char *) gf_filter_pck_get_data(pck, &es_pck.data_len);
+		}
 		es_pck.duration = gf_filter_pck_get_duration(pck);
 		tspid->last_dur = es_pck.duration;
 
@@ -756,7 +763,18 @@ static GF_Err tsmux_esi_ctrl(GF_ESInterface *ifce, u32 act_type, void *param)
 		//for TTML we keep the entire payload as a PES packet
 
 		tspid->nb_pck++;
-		ifce->output_ctrl(ifce, GF_ESI_OUTPUT_DATA_DISPATCH, &es_pck);
+		if (nb_segs>1) {
+			u32 i, flags = es_pck.flags;
+			for (i=0; i<nb_segs; i++) {
+				es_pck.data = (u8 *) gf_filter_pck_get_segment(pck, i, &es_pck.data_len);
+				es_pck.flags = flags;
+				if (i) es_pck.flags &= ~GF_ESI_DATA_AU_START;
+				if (i+1<nb_segs) es_pck.flags &= ~GF_ESI_DATA_AU_END;
+				ifce->output_ctrl(ifce, GF_ESI_OUTPUT_DATA_DISPATCH, &es_pck);
+			}
+		} else {
+			ifce->output_ctrl(ifce, GF_ESI_OUTPUT_DATA_DISPATCH, &es_pck);
+		}
 		GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[M2TSMux] PID %d: packet %d CTS "LLU"\n", tspid->esi.stream_id, tspid->nb_pck, es_pck.cts));
 
 		//data is copied by muxer for now, should need rewrite to avoid un-needed allocations
@@ -1200,7 +1218,6 @@ static GF_Err tsmux_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_
 			//use large pack buffer for dash unless not default value
 			if (ctx->nb_pack==4) {
 				ctx->nb_pack = 200;
-				ctx->pack_buffer = gf_realloc(ctx->pack_buffer, sizeof(u8)*188*ctx->nb_pack);
 			}
 			//in dash, force singel PES per AU, some demuxers have issues with PES packets with no ADTS headers (middle of a frame)
 			gf_m2ts_mux_use_single_au_pes_mode(ctx->mux, GF_M2TS_PACK_NONE);
@@ -1625,7 +1642,8 @@ static void tsmux_send_seg_event(GF_Filter *filter, GF_TSMuxCtx *ctx)
 	ctx->nb_sidx_entries = 0;
 }
 
-static void tsmux_insert_sidx(GF_TSMuxCtx *ctx, Bool final_flush)
+//nb_pck_pending is the number of packets produced in the segment but not yet sent
+static void tsmux_insert_sidx(GF_TSMuxCtx *ctx, Bool final_flush, u32 nb_pck_pending)
 {
 	TS_SIDX *tsidx = NULL;
 	if (ctx->subs_sidx<0) return;
@@ -1642,7 +1660,7 @@ static void tsmux_insert_sidx(GF_TSMuxCtx *ctx, Bool final_flush)
 
 		if (!final_flush && !ctx->mux->sap_inserted) return;
 
-		tsidx->nb_pck = ctx->nb_pck_in_seg - tsidx->nb_pck;
+		tsidx->nb_pck = ctx->nb_pck_in_seg + nb_pck_pending - tsidx->nb_pck;
 		if (tsidx->nb_pck)
 			tsidx = NULL;
 	}
@@ -1662,7 +1680,7 @@ static void tsmux_insert_sidx(GF_TSMuxCtx *ctx, Bool final_flush)
 	tsidx->sap_type = ctx->mux->sap_type;
 	tsidx->min_pts_plus_one  = ctx->mux->sap_time + 1;
 	tsidx->max_pts = ctx->mux->sap_time;
-	tsidx->nb_pck = (ctx->nb_sidx_entries>1) ? ctx->nb_pck_in_seg : 0;
+	tsidx->nb_pck = (ctx->nb_sidx_entries>1) ? ctx->nb_pck_in_seg + nb_pck_pending : 0;
 	tsidx->offset = (ctx->nb_sidx_entries>1) ? 0 : ctx->nb_pck_first_sidx;
 }
 
@@ -1701,7 +1719,7 @@ static void ts_mux_on_packet_del(GF_Filter *filter, GF_FilterPid *pid, GF_Filter
 
 static GF_Err tsmux_process(GF_Filter *filter)
 {
-	u32 nb_pck_in_pack, nb_pck_in_call;
+	u32 nb_pck_in_call, max_pck;
 	GF_M2TSMuxState status;
 	u32 usec_till_next;
 	GF_FilterPacket *pck;
@@ -1788,7 +1806,7 @@ static GF_Err tsmux_process(GF_Filter *filter)
 				}
 
 				if (ctx->nb_pck_in_seg) {
-					tsmux_insert_sidx(ctx, GF_TRUE);
+					tsmux_insert_sidx(ctx, GF_TRUE, 0);
 					tsmux_send_seg_event(filter, ctx);
 				}
 
@@ -1806,37 +1824,21 @@ static GF_Err tsmux_process(GF_Filter *filter)
 	}
 
 	nb_pck_in_call = 0;
-	nb_pck_in_pack=0;
+	max_pck = ctx->nb_pack ? ctx->nb_pack : 1;
 	while (1) {
 		u64 pck_ts;
 		u8 *output;
-		u32 osize;
+		u8 first_ts[188];
+		u32 osize, nb_pck_in_pack;
 		Bool is_pack_flush = GF_FALSE;
-		const char *ts_pck;
 
-		ts_pck = gf_m2ts_mux_process(ctx->mux, &status, &usec_till_next);
-		if (ts_pck == NULL) {
-			if (!nb_pck_in_pack)
-				break;
-			ts_pck = (const char *) ctx->pack_buffer;
-			is_pack_flush = GF_TRUE;
-		} else {
-
-			tsmux_insert_sidx(ctx, GF_FALSE);
-
-			if (ctx->nb_pack>1) {
-				memcpy(ctx->pack_buffer + 188 * nb_pck_in_pack, ts_pck, 188);
-				nb_pck_in_pack++;
-
-				if (nb_pck_in_pack < ctx->nb_pack)
-					continue;
+		//mux the first TS packet before allocating, so that idle calls do not allocate output packets
+		nb_pck_in_pack = gf_m2ts_mux_process_batch(ctx->mux, first_ts, 1, 0, &status, &usec_till_next);
+		if (!nb_pck_in_pack)
+			break;
 
-				ts_pck = (const char *) ctx->pack_buffer;
-			} else {
-				nb_pck_in_pack = 1;
-			}
-		}
-		osize = nb_pck_in_pack * 188;
+		//next TS packets are written directly in the output packet
+		osize = max_pck * 188;
 		if (ctx->force_seg_sync) {
 			pck = gf_filter_pck_new_alloc_destructor(ctx->opid, osize, &output, ts_mux_on_packet_del);
 			if (pck) ctx->pending_packets++;
@@ -1844,8 +1846,24 @@ static GF_Err tsmux_process(GF_Filter *filter)
 			pck = gf_filter_pck_new_alloc(ctx->opid, osize, &output);
 		}
 		if (!pck) return GF_OUT_OF_MEM;
-		
-		memcpy(output, ts_pck, osize);
+		memcpy(output, first_ts, 188);
+		tsmux_insert_sidx(ctx, GF_FALSE, 0);
+
+		while (nb_pck_in_pack < max_pck) {
+			u32 nb_pck = gf_m2ts_mux_process_batch(ctx->mux, output + 188 * nb_pck_in_pack, max_pck - nb_pck_in_pack, 0, &status, &usec_till_next);
+			if (!nb_pck) {
+				is_pack_flush = GF_TRUE;
+				break;
+			}
+			//SAP and PTS state of the mux apply to the last packet of the batch
+			tsmux_insert_sidx(ctx, GF_FALSE, nb_pck_in_pack + nb_pck - 1);
+			nb_pck_in_pack += nb_pck;
+		}
+		if (nb_pck_in_pack < max_pck) {
+			osize = nb_pck_in_pack * 188;
+			gf_filter_pck_truncate(pck, osize);
+		}
+
 		gf_filter_pck_set_framing(pck, ctx->nb_pck ? ctx->next_is_start : GF_TRUE, (status==GF_M2TS_STATE_EOS) ? GF_TRUE : GF_FALSE);
 
 		if (ctx->next_is_start && ctx->dash_mode) {
@@ -1891,7 +1909,6 @@ static GF_Err tsmux_process(GF_Filter *filter)
 		ctx->nb_pck_in_seg += nb_pck_in_pack;
 		ctx->nb_pck_in_file += nb_pck_in_pack;
 		nb_pck_in_call += nb_pck_in_pack;
-		nb_pck_in_pack = 0;
 		if (ctx->llhls)
 			ctx->frag_size += osize;
 
@@ -1950,7 +1967,7 @@ static GF_Err tsmux_process(GF_Filter *filter)
 	if (status==GF_M2TS_STATE_EOS) {
 		gf_filter_pid_set_eos(ctx->opid);
 		if (ctx->nb_pck_in_seg) {
-			tsmux_insert_sidx(ctx, GF_TRUE);
+			tsmux_insert_sidx(ctx, GF_TRUE, 0);
 			tsmux_send_seg_event(filter, ctx);
 			ctx->nb_pck_in_seg = 0;
 		}
@@ -2017,7 +2034,6 @@ static GF_Err tsmux_initialize(GF_Filter *filter)
 		ctx->init_buffering = GF_TRUE;
 	}
 	ctx->pids = gf_list_new();
-	if (ctx->nb_pack>1) ctx->pack_buffer = gf_malloc(sizeof(u8)*188*ctx->nb_pack);
 
 #ifdef GPAC_ENABLE_COVERAGE
 	if (gf_sys_is_cov_mode()) {
@@ -2047,7 +2063,6 @@ static void tsmux_finalize(GF_Filter *filter)
 	}
 	gf_list_del(ctx->pids);
 	gf_m2ts_mux_del(ctx->mux);
-	if (ctx->pack_buffer) gf_free(ctx->pack_buffer);
 	if (ctx->sidx_entries) gf_free(ctx->sidx_entries);
 	if (ctx->idx_bs) gf_bs_del(ctx->idx_bs);
 	if (ctx->cur_file_suffix) gf_free(ctx->cur_file_suffix);
@@ -23,6 +23,10 @@
  *
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+//for O_DIRECT
+#define _GNU_SOURCE
+#endif
 
 #include <gpac/filters.h>
 #include <gpac/constants.h>
@@ -45,6 +49,21 @@ enum
 	FOUT_OW_ASK
 };
 
+enum
+{
+	FOUT_AIO_NO = 0,
+	FOUT_AIO_THREAD,
+	FOUT_AIO_URING
+};
+
+typedef struct
+{
+	GF_FilterPacket *pck;
+	u8 *mem, *data;
+	u32 size;
+	u64 offset;
+} FOutAIOReq;
+
 typedef struct
 {
 	//options
@@ -54,6 +73,8 @@ typedef struct
 	u32 cat, ow;
 	u32 mvbk;
 	s32 max_cache_segs;
+	u32 async, maxaio, dbuf;
+	Bool direct, fsync;
 
 	//only one input pid
 	GF_FilterPid *pid;
@@ -88,6 +109,13 @@ typedef struct
 	Bool no_fd;
 	s32 fd;
 #endif
+
+	//background writes
+	GF_FileAIO *aio;
+	GF_List *aio_reqs;
+	FOutAIOReq *stage;
+	u64 aio_pos, aio_inflight;
+	Bool dio;
 } GF_FileOutCtx;
 
 #ifdef WIN32
@@ -99,10 +127,268 @@ typedef struct
 #ifdef GPAC_HAS_FD
 #include <unistd.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <fcntl.h>
+#include <errno.h>
+#endif
+
+#endif
+
+#define FOUT_MAX_IOV	64
+
+#define FOUT_AIO_DEPTH	256
+#define FOUT_DIO_ALIGN	4096
+//smaller writes are copied in staging buffers rather than keeping a reference to the packet
+#define FOUT_AIO_MIN_REF	65536
+
+static void fileout_fd_sync(s32 fd)
+{
+#if defined(WIN32)
+	_commit(fd);
+#elif defined(__APPLE__)
+	fsync(fd);
+#else
+	fdatasync(fd);
+#endif
+}
+
+static void fileout_aio_done(GF_FileOutCtx *ctx, FOutAIOReq *req, s32 res)
+{
+	if (res<0) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[FileOut] Background I/O error: %s\n", strerror(-res)));
+		ctx->error = GF_IO_ERR;
+	}
+	//sync and close
+	if (!req) return;
+
+	if ((res>=0) && ((u32) res != req->size)) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[FileOut] Write error, wrote %d bytes but had %d to write\n", res, req->size));
+		ctx->error = GF_IO_ERR;
+	}
+	ctx->aio_inflight -= req->size;
+	if (req->pck) gf_filter_pck_unref(req->pck);
+	req->pck = NULL;
+	req->size = 0;
+	gf_list_add(ctx->aio_reqs, req);
+}
+
+static void fileout_aio_collect(GF_FileOutCtx *ctx, Bool wait_all)
+{
+	void *udta;
+	s32 res;
+	while (gf_file_aio_get_done(ctx->aio, wait_all, &udta, &res))
+		fileout_aio_done(ctx, udta, res);
+}
+
+//make sure a new operation can be queued
+static void fileout_aio_reserve(GF_FileOutCtx *ctx)
+{
+	void *udta;
+	s32 res;
+	if (gf_file_aio_pending(ctx->aio) < FOUT_AIO_DEPTH) return;
+	if (gf_file_aio_get_done(ctx->aio, GF_TRUE, &udta, &res))
+		fileout_aio_done(ctx, udta, res);
+}
+
+static FOutAIOReq *fileout_aio_new_req(GF_FileOutCtx *ctx, Bool with_buf)
+{
+	FOutAIOReq *req = gf_list_pop_back(ctx->aio_reqs);
+	if (!req) {
+		GF_SAFEALLOC(req, FOutAIOReq);
+		if (!req) return NULL;
+	}
+	//staging buffers are aligned for direct I/O
+	if (with_buf && !req->mem) {
+		req->mem = gf_malloc(ctx->dbuf + FOUT_DIO_ALIGN);
+		if (!req->mem) {
+			gf_list_add(ctx->aio_reqs, req);
+			return NULL;
+		}
+		req->data = req->mem + FOUT_DIO_ALIGN - ((uintptr_t) req->mem % FOUT_DIO_ALIGN);
+	}
+	return req;
+}
+
+static GF_Err fileout_aio_submit(GF_FileOutCtx *ctx, FOutAIOReq *req, const u8 *data)
+{
+	GF_Err e;
+	fileout_aio_reserve(ctx);
+	ctx->aio_inflight += req->size;
+	e = gf_file_aio_write(ctx->aio, ctx->fd, data, req->size, req->offset, req);
+	if (e) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[FileOut] Failed to queue write of %d bytes: %s\n", req->size, gf_error_to_string(e)));
+		fileout_aio_done(ctx, req, -EIO);
+	}
+	return e;
+}
+
+static void fileout_aio_flush_stage(GF_FileOutCtx *ctx)
+{
+	FOutAIOReq *req = ctx->stage;
+	if (!req || !req->size) return;
+	ctx->stage = NULL;
+	fileout_aio_submit(ctx, req, req->data);
+}
+
+//queue data for writing at the current position, returns the number of bytes accepted
+static u32 fileout_aio_write(GF_FileOutCtx *ctx, GF_FilterPacket *pck, const u8 *data, u32 size)
+{
+	u32 done = 0;
+	if (!size) return 0;
+
+	//large blocks are written from the packet memory, the packet being kept until the write is done
+	if (!ctx->dio && (size >= FOUT_AIO_MIN_REF) && !gf_filter_pck_is_blocking_ref(pck)) {
+		FOutAIOReq *req = fileout_aio_new_req(ctx, GF_FALSE);
+		if (!req) return 0;
+		//staged data precedes this block, the staging buffer cannot be appended to after it
+		fileout_aio_flush_stage(ctx);
+		req->pck = pck;
+		gf_filter_pck_ref(&req->pck);
+		req->size = size;
+		req->offset = ctx->aio_pos;
+		if (fileout_aio_submit(ctx, req, data) != GF_OK) return 0;
+		ctx->aio_pos += size;
+		return size;
+	}
+
+	while (done<size) {
+		u32 len;
+		if (!ctx->stage) {
+			ctx->stage = fileout_aio_new_req(ctx, GF_TRUE);
+			if (!ctx->stage) break;
+			ctx->stage->offset = ctx->aio_pos;
+		}
+		len = MIN(size - done, ctx->dbuf - ctx->stage->size);
+		memcpy(ctx->stage->data + ctx->stage->size, data + done, len);
+		ctx->stage->size += len;
+		ctx->aio_pos += len;
+		done += len;
+		if (ctx->stage->size == ctx->dbuf)
+			fileout_aio_flush_stage(ctx);
+	}
+	return done;
+}
+
+//leave direct I/O mode, allowing unaligned writes
+static void fileout_aio_end_direct(GF_FileOutCtx *ctx)
+{
+	if (!ctx->dio) return;
+	ctx->dio = GF_FALSE;
+#if defined(GPAC_HAS_FD) && defined(O_DIRECT)
+	fcntl(ctx->fd, F_SETFL, fcntl(ctx->fd, F_GETFL) & ~O_DIRECT);
+#endif
+}
+
+//wait for all background writes of the current file, including the partial staging buffer
+static void fileout_aio_wait(GF_FileOutCtx *ctx)
+{
+#ifdef GPAC_HAS_FD
+	if (!ctx->aio || (ctx->fd<0)) return;
+	fileout_aio_end_direct(ctx);
+	fileout_aio_flush_stage(ctx);
+	fileout_aio_collect(ctx, GF_TRUE);
+#endif
+}
+
+//wait for all background writes before synchronous access to the file
+static void fileout_aio_suspend(GF_FileOutCtx *ctx)
+{
+#ifdef GPAC_HAS_FD
+	if (!ctx->aio || (ctx->fd<0)) return;
+	fileout_aio_wait(ctx);
+	lseek(ctx->fd, ctx->aio_pos, SEEK_SET);
+#endif
+}
+
+static void fileout_aio_resume(GF_FileOutCtx *ctx)
+{
+#ifdef GPAC_HAS_FD
+	if (!ctx->aio || (ctx->fd<0)) return;
+	ctx->aio_pos = lseek(ctx->fd, 0, SEEK_CUR);
+#endif
+}
+
+#ifdef GPAC_HAS_FD
+//the last partial block is written through the page cache, sync and close are queued after all pending writes
+static void fileout_aio_close(GF_FileOutCtx *ctx)
+{
+	fileout_aio_end_direct(ctx);
+	fileout_aio_flush_stage(ctx);
+	if (ctx->fsync) {
+		fileout_aio_reserve(ctx);
+		gf_file_aio_sync(ctx->aio, ctx->fd, NULL);
+	}
+	fileout_aio_reserve(ctx);
+	if (gf_file_aio_close(ctx->aio, ctx->fd, NULL) != GF_OK)
+		close(ctx->fd);
+}
+
+static u64 fileout_fd_pos(GF_FileOutCtx *ctx)
+{
+	if (ctx->aio) return ctx->aio_pos;
+	return lseek(ctx->fd, 0, SEEK_CUR);
+}
 #endif
 
+//write segments of a segmented packet without gathering them, with vectored writes on file descriptors
+static u32 fileout_write_segments(GF_FileOutCtx *ctx, GF_FilterPacket *pck, u32 nb_segs, FILE *file)
+{
+	u32 i, nb_write=0;
+#ifdef GPAC_HAS_FD
+	if (!file) {
+#ifdef WIN32
+		//no vectored writes, write segments one by one
+		for (i=0; i<nb_segs; i++) {
+			s32 res;
+			u32 seg_size;
+			const u8 *seg = gf_filter_pck_get_segment(pck, i, &seg_size);
+			if (!seg || !seg_size) continue;
+			res = write(ctx->fd, seg, seg_size);
+			if (res>0) nb_write += (u32) res;
+			if (res != (s32) seg_size) break;
+		}
+#else
+		struct iovec iov[FOUT_MAX_IOV];
+		i=0;
+		while (i<nb_segs) {
+			u32 nb_iov=0, first=0;
+			while ((i<nb_segs) && (nb_iov<FOUT_MAX_IOV)) {
+				u32 seg_size;
+				const u8 *seg = gf_filter_pck_get_segment(pck, i, &seg_size);
+				i++;
+				if (!seg || !seg_size) continue;
+				iov[nb_iov].iov_base = (void *) seg;
+				iov[nb_iov].iov_len = seg_size;
+				nb_iov++;
+			}
+			//retry partial writes until all vectors are written
+			while (first<nb_iov) {
+				ssize_t res = writev(ctx->fd, iov+first, nb_iov-first);
+				if ((res<0) && (errno==EINTR)) continue;
+				if (res<=0) return nb_write;
+				nb_write += (u32) res;
+				while ((first<nb_iov) && ((size_t) res >= iov[first].iov_len)) {
+					res -= iov[first].iov_len;
+					first++;
+				}
+				if (first<nb_iov) {
+					iov[first].iov_base = (u8 *) iov[first].iov_base + res;
+					iov[first].iov_len -= res;
+				}
+			}
+		}
+#endif
+		return nb_write;
+	}
 #endif
+	for (i=0; i<nb_segs; i++) {
+		u32 seg_size;
+		const u8 *seg = gf_filter_pck_get_segment(pck, i, &seg_size);
+		if (!seg || !seg_size) continue;
+		nb_write += (u32) gf_fwrite(seg, seg_size, file);
+	}
+	return nb_write;
+}
 
 static void fileout_close_hls_chunk(GF_FileOutCtx *ctx, Bool final_flush)
 {
@@ -117,12 +403,23 @@ static GF_Err fileout_open_close(GF_FileOutCtx *ctx, const char *filename, const
 #ifdef GPAC_HAS_FD
 		if (ctx->fd>=0) {
 			GF_LOG(GF_LOG_INFO, GF_LOG_MMIO, ("[FileOut] closing output file %s\n", ctx->szFileName));
-			close(ctx->fd);
+			if (ctx->aio) {
+				fileout_aio_close(ctx);
+			} else {
+				if (ctx->fsync) fileout_fd_sync(ctx->fd);
+				close(ctx->fd);
+			}
 			fileout_close_hls_chunk(ctx, GF_FALSE);
 		} else
 #endif
 		 if (ctx->file) {
 			GF_LOG(GF_LOG_INFO, GF_LOG_MMIO, ("[FileOut] closing output file %s\n", ctx->szFileName));
+#ifdef GPAC_HAS_FD
+			if (ctx->fsync && !gf_fileio_check(ctx->file)) {
+				gf_fflush(ctx->file);
+				fileout_fd_sync(fileno(ctx->file));
+			}
+#endif
 			gf_fclose(ctx->file);
 			fileout_close_hls_chunk(ctx, GF_FALSE);
 		}
@@ -207,14 +504,44 @@ static GF_Err fileout_open_close(GF_FileOutCtx *ctx, const char *filename, const
 			}
 		}
 
+		//pending writes to the same file must be done before reopening it
+		if (ctx->aio && !strcmp(szFinalName, ctx->szFileName))
+			fileout_aio_collect(ctx, GF_TRUE);
+
 		GF_LOG(GF_LOG_INFO, GF_LOG_MMIO, ("[FileOut] opening output file %s\n", szFinalName));
 #ifdef GPAC_HAS_FD
-		if (!ctx->no_fd && !is_gfio && !append && !gf_opts_get_bool("core", "no-fd")
+		//small blocks (mp2t) are gathered in staging buffers in async mode
+		if ((!ctx->no_fd || ctx->async) && !is_gfio && !append && !gf_opts_get_bool("core", "no-fd")
 			&& (!ctx->original_url || strncmp(ctx->original_url, "gfio://", 7))
 		) {
+			int flags = O_RDWR | O_CREAT | O_TRUNC;
+			if (ctx->async && !ctx->aio) {
+				ctx->aio = gf_file_aio_new(FOUT_AIO_DEPTH, (ctx->async==FOUT_AIO_THREAD) ? GF_TRUE : GF_FALSE);
+				if (!ctx->aio) {
+					GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[FileOut] Asynchronous writes not supported, using synchronous writes\n"));
+					ctx->async = FOUT_AIO_NO;
+				} else {
+					GF_LOG(GF_LOG_INFO, GF_LOG_MMIO, ("[FileOut] Using %s backend for asynchronous writes\n", gf_file_aio_backend(ctx->aio)));
+					if (!ctx->aio_reqs) ctx->aio_reqs = gf_list_new();
+				}
+			}
+#ifdef O_DIRECT
+			if (ctx->aio && ctx->direct) flags |= O_DIRECT;
+#endif
 			//make sure output dir exists
 			gf_fopen(szFinalName, "mkdir");
-			ctx->fd = open(szFinalName, O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH );
+			ctx->fd = open(szFinalName, flags, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH );
+#ifdef O_DIRECT
+			if (flags & O_DIRECT) {
+				if (ctx->fd>=0) {
+					ctx->dio = GF_TRUE;
+				} else {
+					GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[FileOut] Direct I/O not supported for %s, using buffered writes\n", szFinalName));
+					ctx->fd = open(szFinalName, flags & ~O_DIRECT, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH );
+				}
+			}
+#endif
+			ctx->aio_pos = 0;
 		} else
 #endif
 			ctx->file = gf_fopen_ex(szFinalName, ctx->original_url, append ? "a+b" : "w+b", GF_FALSE);
@@ -341,6 +668,9 @@ static GF_Err fileout_initialize(GF_Filter *filter)
 
 	if (!ctx->mvbk)
 		ctx->mvbk = 1;
+	ctx->dbuf = (ctx->dbuf + FOUT_DIO_ALIGN - 1) / FOUT_DIO_ALIGN * FOUT_DIO_ALIGN;
+	if (!ctx->dbuf)
+		ctx->dbuf = FOUT_DIO_ALIGN;
 
 #ifdef GPAC_HAS_FD
 	ctx->fd = -1;
@@ -428,6 +758,19 @@ static void fileout_finalize(GF_Filter *filter)
 	if (ctx->gfio_ref)
 		gf_fileio_open_url((GF_FileIO *)ctx->gfio_ref, NULL, "unref", &e);
 
+	if (ctx->aio) {
+		fileout_aio_collect(ctx, GF_TRUE);
+		gf_file_aio_del(ctx->aio);
+	}
+	if (ctx->aio_reqs) {
+		while (gf_list_count(ctx->aio_reqs)) {
+			FOutAIOReq *req = gf_list_pop_back(ctx->aio_reqs);
+			if (req->mem) gf_free(req->mem);
+			gf_free(req);
+		}
+		gf_list_del(ctx->aio_reqs);
+	}
+
 	if (ctx->past_files) {
 		while (gf_list_count(ctx->past_files)) {
 			char *url = gf_list_pop_back(ctx->past_files);
@@ -444,7 +787,7 @@ static GF_Err fileout_process(GF_Filter *filter)
 	const GF_PropertyValue *fname, *p;
 	Bool start, end;
 	const u8 *pck_data;
-	u32 pck_size, nb_write;
+	u32 pck_size, nb_write, nb_segs;
 	GF_FileOutCtx *ctx = (GF_FileOutCtx *) gf_filter_get_udta(filter);
 
 	pck = gf_filter_pid_get_packet(ctx->pid);
@@ -454,6 +797,16 @@ restart:
 	if (ctx->error)
 		return ctx->error;
 
+	if (ctx->aio) {
+		fileout_aio_collect(ctx, GF_FALSE);
+		//keep packets in the input buffer until enough writes are done, blocking the upstream chain
+		if (ctx->aio_inflight >= ctx->maxaio) {
+			GF_LOG(GF_LOG_DEBUG, GF_LOG_MMIO, ("[FileOut] "LLU" bytes pending write, waiting for completions\n", ctx->aio_inflight));
+			gf_filter_ask_rt_reschedule(filter, 1000);
+			return ctx->error;
+		}
+	}
+
 	if (!pck) {
 		if (gf_filter_pid_is_eos(ctx->pid) && !gf_filter_pid_is_flush_eos(ctx->pid)) {
 			if (gf_filter_reporting_enabled(filter)) {
@@ -480,9 +833,11 @@ restart:
 				} else {
 					evt.seg_size.is_init = 0;
 					evt.seg_size.media_range_start = ctx->offset_at_seg_start;
+					//the segment may be referenced as soon as its size is known
+					fileout_aio_wait(ctx);
 #ifdef GPAC_HAS_FD
 					if (ctx->fd>=0) {
-						evt.seg_size.media_range_end = lseek(ctx->fd, 0, SEEK_CUR);
+						evt.seg_size.media_range_end = fileout_fd_pos(ctx);
 					} else
 #endif
 					if (ctx->file) {
@@ -498,6 +853,11 @@ restart:
 				}
 			}
 			fileout_open_close(ctx, NULL, NULL, 0, GF_FALSE, NULL);
+			//report errors of background writes and close
+			if (ctx->aio) {
+				fileout_aio_collect(ctx, GF_TRUE);
+				if (ctx->error) return ctx->error;
+			}
 			return GF_EOS;
 		}
 		return GF_OK;
@@ -566,9 +926,10 @@ restart:
 			} else {
 				evt.seg_size.is_init = 0;
 				evt.seg_size.media_range_start = ctx->offset_at_seg_start;
+				fileout_aio_wait(ctx);
 #ifdef GPAC_HAS_FD
 				if (ctx->fd>=0) {
-					evt.seg_size.media_range_end = lseek(ctx->fd, 0, SEEK_CUR);
+					evt.seg_size.media_range_end = fileout_fd_pos(ctx);
 				} else
 #endif
 				if (ctx->file) {
@@ -688,14 +1049,51 @@ check_gfio:
 	}
 
 
-	pck_data = gf_filter_pck_get_data(pck, &pck_size);
+	//segmented packets are written without copying their segments, except when patching
+	nb_segs = gf_filter_pck_get_segment_count(pck);
+	if ((nb_segs>1) && !(ctx->patch_blocks && gf_filter_pck_get_seek_flag(pck))) {
+		pck_data = NULL;
+		pck_size = gf_filter_pck_get_data_size(pck);
+	} else {
+		nb_segs = 0;
+		pck_data = gf_filter_pck_get_data(pck, &pck_size);
+	}
 	if (ctx->file
 #ifdef GPAC_HAS_FD
 		|| (ctx->fd>=0)
 #endif
 	) {
 		GF_FilterFrameInterface *hwf = gf_filter_pck_get_frame_interface(pck);
-		if (pck_data) {
+		if (nb_segs) {
+#ifdef GPAC_HAS_FD
+			if (ctx->aio && (ctx->fd>=0)) {
+				u32 i;
+				nb_write = 0;
+				for (i=0; i<nb_segs; i++) {
+					u32 seg_size;
+					const u8 *seg = gf_filter_pck_get_segment(pck, i, &seg_size);
+					if (seg) nb_write += fileout_aio_write(ctx, pck, seg, seg_size);
+				}
+			} else if (ctx->fd>=0) {
+				nb_write = fileout_write_segments(ctx, pck, nb_segs, NULL);
+			} else
+#endif
+				nb_write = fileout_write_segments(ctx, pck, nb_segs, ctx->file);
+
+			if (nb_write!=pck_size) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[FileOut] Write error, wrote %d bytes but had %d to write\n", nb_write, pck_size));
+				e = GF_IO_ERR;
+			}
+			ctx->nb_write += nb_write;
+
+			if (ctx->hls_chunk) {
+				nb_write = fileout_write_segments(ctx, pck, nb_segs, ctx->hls_chunk);
+				if (nb_write!=pck_size) {
+					GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[FileOut] Write error, wrote %d bytes but had %d to write\n", nb_write, pck_size));
+					e = GF_IO_ERR;
+				}
+			}
+		} else if (pck_data) {
 			if (ctx->patch_blocks && gf_filter_pck_get_seek_flag(pck)) {
 				u64 bo = gf_filter_pck_get_byte_offset(pck);
 				if (ctx->is_std) {
@@ -706,6 +1104,8 @@ check_gfio:
 					u32 ilaced = gf_filter_pck_get_interlaced(pck);
 					u64 pos = ctx->nb_write;
 
+					fileout_aio_suspend(ctx);
+
 					//we are inserting a block: write dummy bytes at end and move bytes
 					if (ilaced) {
 						u8 *block;
@@ -730,6 +1130,18 @@ check_gfio:
 
 						cur_r = pos;
 						pos = cur_w;
+						//move data in kernel space if supported, the shift is large enough to avoid too many copy calls
+						if (!e && (pck_size >= ctx->mvbk)) {
+#ifdef GPAC_HAS_FD
+							if (ctx->fd>=0) {
+								if (gf_fd_copy_range(ctx->fd, bo, bo + pck_size, cur_r - bo)==GF_OK)
+									cur_r = bo;
+							} else
+#endif
+							if (gf_file_copy_range(ctx->file, bo, bo + pck_size, cur_r - bo)==GF_OK)
+								cur_r = bo;
+						}
+
 						block = gf_malloc(ctx->mvbk);
 						if (!block) {
 							GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[FileOut] unable to allocate block of %d bytes\n", ctx->mvbk));
@@ -795,10 +1207,13 @@ check_gfio:
 						GF_LOG(GF_LOG_ERROR, GF_LOG_MMIO, ("[FileOut] Write error, wrote %d bytes but had %d to write\n", nb_write, pck_size));
 						e = GF_IO_ERR;
 					}
+					fileout_aio_resume(ctx);
 				}
 			} else {
 #ifdef GPAC_HAS_FD
-				if (ctx->fd>=0) {
+				if (ctx->aio && (ctx->fd>=0)) {
+					nb_write = fileout_aio_write(ctx, pck, pck_data, pck_size);
+				} else if (ctx->fd>=0) {
 					nb_write = (u32) write(ctx->fd, pck_data, pck_size);
 				} else
 #endif
@@ -829,6 +1244,7 @@ check_gfio:
 			pf = p ? p->value.uint : 0;
 
 			stride = stride_uv = 0;
+			fileout_aio_suspend(ctx);
 
 			if (gf_pixel_get_size_info(pf, w, h, NULL, &stride, &stride_uv, &nb_planes, &uv_height) == GF_TRUE) {
 				u32 i;
@@ -864,6 +1280,7 @@ check_gfio:
 					}
 				}
 			}
+			fileout_aio_resume(ctx);
 		} else {
 			GF_LOG(GF_LOG_WARNING, GF_LOG_MMIO, ("[FileOut] No data associated with packet, cannot write\n"));
 		}
@@ -875,7 +1292,7 @@ check_gfio:
 		if (ctx->dash_mode) {
 #ifdef GPAC_HAS_FD
 			if (ctx->fd>=0) {
-				ctx->last_file_size = lseek(ctx->fd, 0, SEEK_CUR);
+				ctx->last_file_size = fileout_fd_pos(ctx);
 			} else
 #endif
 				ctx->last_file_size = gf_ftell(ctx->file);
@@ -886,6 +1303,10 @@ check_gfio:
 	if (pck)
 		goto restart;
 
+	//do not keep data in memory between calls, except partial blocks in direct mode
+	if (ctx->aio && !ctx->dio)
+		fileout_aio_flush_stage(ctx);
+
 	if (gf_filter_reporting_enabled(filter)) {
 		char szStatus[1024];
 		snprintf(szStatus, 1024, "%s: wrote % 16"LLD_SUF" bytes", gf_file_basename(ctx->szFileName), (s64) ctx->nb_write);
@@ -956,6 +1377,14 @@ static const GF_FilterArgs FileOutArgs[] =
 	{ OFFS(max_cache_segs), "maximum number of segments cached per HAS quality when recording live sessions (0 means no limit)", GF_PROP_SINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(force_null), "force no output regardless of file name", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(use_rel), "packet filename use relative names (only set by dasher)", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_HIDE},
+	{ OFFS(async), "write data in the background (see filter help)\n"
+	"- no: synchronous writes\n"
+	"- thread: use a dedicated I/O thread\n"
+	"- uring: use io_uring if available, I/O thread otherwise", GF_PROP_UINT, "no", "no|thread|uring", GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(maxaio), "maximum number of bytes pending write before input packets are no longer consumed in async mode", GF_PROP_UINT, "16777216", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(direct), "bypass the page cache (O_DIRECT) in async mode", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(dbuf), "size of staging buffers in async mode, rounded to 4096 bytes", GF_PROP_UINT, "1048576", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(fsync), "sync file data to disk when closing each file or segment", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_ADVANCED},
 	{0}
 };
 
@@ -987,6 +1416,18 @@ GF_FilterRegister FileOutRegister = {
 		"\n"
 		"EX gpac -i LIVE_MPD dashin:forward=file -o rec/$File$:max_cache_segs=3\n"
 		"This will force keeping a maximum of 3 media segments while recording the DASH session.\n"
+		"\n"
+		"# Background writes\n"
+		"When [-async]() is set, writes are performed in the background so that slow disks do not stall the session. "
+		"Large packets are written from the packet memory, smaller ones are gathered in staging buffers of [-dbuf]() bytes.\n"
+		"When more than [-maxaio]() bytes are pending, the filter stops consuming its input until some writes are done, which blocks upstream filters.\n"
+		"Closing a file (or segment) does not wait for pending writes. When [-fsync]() is set, file data is synced once per file, after all its writes.\n"
+		"When writing DASH or HLS segments, pending writes of a segment are completed before its size is reported to the dasher, so that manifests and segment indexes only reference written data. "
+		"The segment file may however still be synced and closed in the background.\n"
+		"Errors of background writes are reported at the latest when the input PID is done, after all pending writes and closes are completed.\n"
+		"The [-direct]() option bypasses the page cache, all data then going through staging buffers. "
+		"This requires file system support and is disabled for a file if it has to be patched (e.g. non-fragmented MP4 muxing).\n"
+		"Async mode only applies to regular files, and is ignored in append mode.\n"
 		""
 	)
 	.private_size = sizeof(GF_FileOutCtx),
@@ -51,6 +51,7 @@ void gf_dm_sess_set_timeout(GF_DownloadSession *sess, u32 timeout);
 
 GF_Socket *gf_dm_sess_get_socket(GF_DownloadSession *);
 GF_Err gf_dm_sess_send(GF_DownloadSession *sess, u8 *data, u32 size);
+GF_Err gf_dm_sess_send_file(GF_DownloadSession *sess, FILE *file, u64 offset, u32 size, u32 *written);
 void gf_dm_sess_clear_headers(GF_DownloadSession *sess);
 void  gf_dm_sess_set_header(GF_DownloadSession *sess, const char *name, const char *value);
 void  gf_dm_sess_set_header_ex(GF_DownloadSession *sess, const char *name, const char *value, Bool allow_overwrite);
@@ -107,7 +108,7 @@ typedef struct
 	char *js;
 #endif
 	GF_PropStringList rdirs;
-	Bool close, hold, quit, post, dlist, ice, reopen, blockio;
+	Bool close, hold, quit, post, dlist, ice, reopen, blockio, zcopy;
 	u32 port, block_size, maxc, maxp, timeout, hmode, sutc, cors, max_client_errors, max_async_buf, ka, zmax;
 	s32 max_cache_segs;
 	GF_PropStringList hdrs;
@@ -116,6 +117,8 @@ typedef struct
 	GF_Filter *filter;
 	GF_Socket *server_sock;
 	GF_List *sessions, *active_sessions;
+	//active sessions not idle, processed at each call to httpout_process
+	GF_List *busy_sessions;
 	GF_List *inputs;
 
 	s32 next_wake_us;
@@ -265,6 +268,8 @@ struct __httpout_session {
 	Bool is_h2;
 	Bool sub_sess_pending;
 	Bool canceled;
+	//waiting for a new request, not in busy sessions
+	Bool idle;
 
 	Bool force_destroy;
 
@@ -272,6 +277,13 @@ struct __httpout_session {
 
 	u8 *comp_data;
 
+	//zero-copy disabled for current request
+	Bool zc_off;
+	//bytes sent using zero-copy for current request
+	u64 nb_bytes_zc;
+	//payload bytes sent zero-copy and copied for the connection
+	u64 conn_bytes_zc, conn_bytes_copied;
+
 #ifdef GPAC_HAS_QJS
 	JSValue obj;
 #endif
@@ -446,11 +458,49 @@ static GF_FileIO *httpio_open(GF_FileIO *fileio_ref, const char *url, const char
 	return gfio;
 }
 
+//session waiting for a new request on a non-h2 connection, only processed once its socket is ready
+static Bool httpout_sess_is_idle(GF_HTTPOutSession *sess)
+{
+	if (!sess->http_sess || sess->is_h2 || sess->headers_done || sess->upload_type) return GF_FALSE;
+	if (sess->flush_close || sess->async_pending || sess->in_source) return GF_FALSE;
+	return GF_TRUE;
+}
+
+static void httpout_sess_set_idle(GF_HTTPOutSession *sess, Bool idle)
+{
+	GF_HTTPOutCtx *ctx = sess->ctx;
+	if (sess->idle == idle) return;
+	sess->idle = idle;
+	if (idle) gf_list_del_item(ctx->busy_sessions, sess);
+	else gf_list_add(ctx->busy_sessions, sess);
+	//idle sessions have nothing to send, do not poll them for write
+	if (sess->socket) gf_sk_group_set_write_pending(ctx->sg, sess->socket, !idle);
+}
+
+static void httpout_sess_activate(GF_HTTPOutSession *sess, Bool register_sock)
+{
+	GF_HTTPOutCtx *ctx = sess->ctx;
+	if (gf_list_find(ctx->active_sessions, sess)>=0) return;
+	gf_list_add(ctx->active_sessions, sess);
+	gf_list_add(ctx->busy_sessions, sess);
+	sess->idle = GF_FALSE;
+	if (register_sock)
+		gf_sk_group_register(ctx->sg, sess->socket);
+	//h2 sub-sessions share the socket of the session owning the connection
+	if (!gf_sk_get_udta(sess->socket))
+		gf_sk_set_udta(sess->socket, sess);
+}
+
 static void httpout_close_session(GF_HTTPOutSession *sess, GF_Err code)
 {
 	Bool last_connection = GF_TRUE;
 	if (!sess->http_sess) return;
 
+	//closed sessions are removed by httpout_process
+	httpout_sess_set_idle(sess, GF_FALSE);
+	if (gf_sk_get_udta(sess->socket) == sess)
+		gf_sk_set_udta(sess->socket, NULL);
+
 	if (sess->is_h2) {
 		u32 nb_sub_sess = gf_dm_sess_subsession_count(sess->http_sess);
 		if (nb_sub_sess > 1) {
@@ -465,6 +515,8 @@ static void httpout_close_session(GF_HTTPOutSession *sess, GF_Err code)
 		gf_assert(sess->ctx->nb_connections);
 		sess->ctx->nb_connections--;
 
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_HTTP, ("[HTTPOut] Connection to %s closed: "LLU" bytes sent zero-copy, "LLU" bytes copied\n", sess->peer_address, sess->conn_bytes_zc, sess->conn_bytes_copied));
+
 		gf_sk_group_unregister(sess->ctx->sg, sess->socket);
 	}
 
@@ -772,6 +824,8 @@ static Bool httpout_sess_parse_range(GF_HTTPOutSession *sess, char *range)
 	u64 known_file_size;
 	sess->nb_ranges = 0;
 	sess->nb_bytes = 0;
+	sess->nb_bytes_zc = 0;
+	sess->zc_off = GF_FALSE;
 	sess->range_idx = 0;
 	if (!range) return GF_TRUE;
 
@@ -994,7 +1048,7 @@ GF_Err httpout_new_subsession(GF_HTTPOutSession *sess, u32 stream_id)
 	}
 	gf_dm_sess_set_timeout(sub_sess->http_sess, sess->ctx->timeout);
 	gf_list_add(sess->ctx->sessions, sub_sess);
-	gf_list_add(sess->ctx->active_sessions, sub_sess);
+	httpout_sess_activate(sub_sess, GF_FALSE);
 	sess->sub_sess_pending = GF_TRUE;
 #ifdef GPAC_HAS_QJS
 	sess->obj = JS_UNDEFINED;
@@ -1544,10 +1598,7 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 		if (!sess->buffer) {
 			sess->buffer = gf_malloc(sizeof(u8)*sess->ctx->block_size);
 		}
-		if (gf_list_find(sess->ctx->active_sessions, sess)<0) {
-			gf_list_add(sess->ctx->active_sessions, sess);
-			gf_sk_group_register(sess->ctx->sg, sess->socket);
-		}
+		httpout_sess_activate(sess, GF_TRUE);
 		sess->last_active_time = gf_sys_clock_high_res();
 
 		if (sess->do_log) {
@@ -1760,6 +1811,8 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 	sess->use_chunk_transfer = GF_FALSE;
 	sess->put_in_progress = 0;
 	sess->nb_bytes = 0;
+	sess->nb_bytes_zc = 0;
+	sess->zc_off = GF_FALSE;
 	sess->upload_type = 0;
 
 	if (parameter->reply==GF_HTTP_DELETE) {
@@ -2165,10 +2218,7 @@ static void httpout_sess_io(void *usr_cbk, GF_NETIO_Parameter *parameter)
 		sess->file_pos = sess->file_size;
 	} else {
 		sess->done = GF_FALSE;
-		if (gf_list_find(sess->ctx->active_sessions, sess)<0) {
-			gf_list_add(sess->ctx->active_sessions, sess);
-			gf_sk_group_register(sess->ctx->sg, sess->socket);
-		}
+		httpout_sess_activate(sess, GF_TRUE);
 		if (not_modified) {
 			sess->done = GF_TRUE;
 		}
@@ -2633,8 +2683,7 @@ check_next_conn:
 		ctx->had_connections = GF_TRUE;
 
 	gf_list_add(ctx->sessions, sess);
-	gf_list_add(ctx->active_sessions, sess);
-	gf_sk_group_register(ctx->sg, sess->socket);
+	httpout_sess_activate(sess, GF_TRUE);
 
 	gf_sk_set_buffer_size(new_conn, GF_FALSE, ctx->block_size);
 	gf_sk_set_buffer_size(new_conn, GF_TRUE, ctx->block_size);
@@ -2853,6 +2902,7 @@ static GF_Err httpout_initialize(GF_Filter *filter)
 
 	ctx->sessions = gf_list_new();
 	ctx->active_sessions = gf_list_new();
+	ctx->busy_sessions = gf_list_new();
 	ctx->inputs = gf_list_new();
 	ctx->filter = filter;
 	//used in both server and push modes
@@ -2995,6 +3045,7 @@ static void httpout_del_session(GF_HTTPOutSession *s)
 	gf_list_del_item(s->ctx->sessions, s);
 	if (s->http_sess)
 		httpout_close_session(s, GF_OK);
+	gf_list_del_item(s->ctx->busy_sessions, s);
 	if (s->buffer) gf_free(s->buffer);
 	if (s->path) gf_free(s->path);
 	if (s->mime) gf_free(s->mime);
@@ -3081,6 +3132,7 @@ static void httpout_finalize(GF_Filter *filter)
 	}
 	gf_list_del(ctx->sessions);
 	gf_list_del(ctx->active_sessions);
+	gf_list_del(ctx->busy_sessions);
 
 	while (gf_list_count(ctx->inputs)) {
 		GF_HTTPOutInput *in = gf_list_pop_back(ctx->inputs);
@@ -3252,7 +3304,11 @@ static void log_request_done(GF_HTTPOutSession *sess)
 			unit = "kbps";
 			bps/=1000;
 		}
-		GF_LOG(GF_LOG_INFO, GF_LOG_ALL, ("[HTTPOut] %sREQ#"LLU" %s done: reply %d - "LLU" bytes in %d ms at %g %s\n", sprefix, sess->req_id, get_method_name(sess->method_type), sess->reply_code, sess->nb_bytes, (u32) (diff_us/1000), bps, unit));
+		if (sess->nb_bytes_zc) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_ALL, ("[HTTPOut] %sREQ#"LLU" %s done: reply %d - "LLU" bytes ("LLU" zero-copy) in %d ms at %g %s\n", sprefix, sess->req_id, get_method_name(sess->method_type), sess->reply_code, sess->nb_bytes, sess->nb_bytes_zc, (u32) (diff_us/1000), bps, unit));
+		} else {
+			GF_LOG(GF_LOG_INFO, GF_LOG_ALL, ("[HTTPOut] %sREQ#"LLU" %s done: reply %d - "LLU" bytes in %d ms at %g %s\n", sprefix, sess->req_id, get_method_name(sess->method_type), sess->reply_code, sess->nb_bytes, (u32) (diff_us/1000), bps, unit));
+		}
 	}
 }
 
@@ -3261,7 +3317,7 @@ static void httpout_process_session(GF_Filter *filter, GF_HTTPOutCtx *ctx, GF_HT
 	u32 read;
 	u64 to_read=0;
 	GF_Err e = GF_OK;
-	Bool file_in_progress, last_range;
+	Bool file_in_progress, last_range, zero_copy;
 	Bool close_session = ctx->close;
 
 	if (sess->force_destroy) {
@@ -3593,37 +3649,68 @@ resend:
 		if (to_read > (u64) sess->ctx->block_size)
 			to_read = (u64) sess->ctx->block_size;
 
-		if (sess->comp_data) {
-			memcpy(sess->buffer, sess->comp_data+sess->file_pos, to_read);
-			read = (u32) to_read;
-		}
-		else if (sess->resource) {
-			read = (u32) gf_fread(sess->buffer, (u32) to_read, sess->resource);
-			//may happen when file writing is in progress
-			if (!read) {
-				sess->last_active_time = gf_sys_clock_high_res();
-				return;
+		//plain HTTP/1.1 file or byte range transfer, send directly from file
+		zero_copy = GF_FALSE;
+		if (ctx->zcopy && !sess->zc_off && sess->resource && !sess->comp_data && !sess->is_h2 && !sess->use_chunk_transfer) {
+			read = 0;
+			e = gf_dm_sess_send_file(sess->http_sess, sess->resource, sess->file_pos, (u32) to_read, &read);
+			if (e==GF_NOT_SUPPORTED) {
+				//TLS, gfio or unsupported file type, use regular send - file position is not modified by zero-copy sends
+				sess->zc_off = GF_TRUE;
+				gf_fseek(sess->resource, sess->file_pos, SEEK_SET);
+				e = GF_OK;
+			} else {
+				//socket would block
+				if (e==GF_IP_NETWORK_EMPTY)
+					return;
+				//may happen when file writing is in progress
+				if (!e && !read) {
+					sess->last_active_time = gf_sys_clock_high_res();
+					return;
+				}
+				zero_copy = GF_TRUE;
 			}
-		} else {
-			read = (u32) to_read;
 		}
-		//transfer of file being uploaded, use chunk transfer
-		if (!sess->is_h2 && sess->use_chunk_transfer) {
-			char szHdr[100];
-			u32 len;
-			sprintf(szHdr, "%X\r\n", read);
-			len = (u32) strlen(szHdr);
-
-			e = gf_dm_sess_send(sess->http_sess, szHdr, len);
-			e |= gf_dm_sess_send(sess->http_sess, sess->buffer, read);
-			e |= gf_dm_sess_send(sess->http_sess, "\r\n", 2);
-		} else {
-			e = gf_dm_sess_send(sess->http_sess, sess->buffer, read);
+
+		if (!zero_copy) {
+			if (sess->comp_data) {
+				memcpy(sess->buffer, sess->comp_data+sess->file_pos, to_read);
+				read = (u32) to_read;
+			}
+			else if (sess->resource) {
+				read = (u32) gf_fread(sess->buffer, (u32) to_read, sess->resource);
+				//may happen when file writing is in progress
+				if (!read) {
+					sess->last_active_time = gf_sys_clock_high_res();
+					return;
+				}
+			} else {
+				read = (u32) to_read;
+			}
+			//transfer of file being uploaded, use chunk transfer
+			if (!sess->is_h2 && sess->use_chunk_transfer) {
+				char szHdr[100];
+				u32 len;
+				sprintf(szHdr, "%X\r\n", read);
+				len = (u32) strlen(szHdr);
+
+				e = gf_dm_sess_send(sess->http_sess, szHdr, len);
+				e |= gf_dm_sess_send(sess->http_sess, sess->buffer, read);
+				e |= gf_dm_sess_send(sess->http_sess, "\r\n", 2);
+			} else {
+				e = gf_dm_sess_send(sess->http_sess, sess->buffer, read);
+			}
 		}
 		sess->last_active_time = gf_sys_clock_high_res();
 
 		sess->file_pos += read;
 		sess->nb_bytes += read;
+		if (zero_copy) {
+			sess->nb_bytes_zc += read;
+			sess->conn_bytes_zc += read;
+		} else {
+			sess->conn_bytes_copied += read;
+		}
 
 		if (e) {
 			if ((e==GF_IP_CONNECTION_CLOSED) || (e==GF_URL_REMOVED)) {
@@ -3641,6 +3728,9 @@ resend:
 			//not in progress and we are done, notify (for chunk-transfer or h2) right away
 			if (!file_in_progress && last_range && (remain==read))
 				goto session_done;
+			//partial zero-copy send, wait for socket to be writable
+			if (zero_copy && (read < to_read))
+				return;
 
 			if (gf_dm_sess_flush_async(sess->http_sess, GF_FALSE)==GF_OK) {
 				goto resend;
@@ -4095,7 +4185,38 @@ static Bool httpout_open_input_llhls(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in, ch
 	return GF_TRUE;
 }
 
-u32 httpout_write_input(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in, const u8 *pck_data, u32 pck_size, Bool file_start)
+//sends data of a packet, without gathering the segments if pck is a segmented packet
+static GF_Err httpout_send_data(GF_DownloadSession *sess, GF_FilterPacket *pck, const u8 *data, u32 size)
+{
+	u32 i, nb_segs = pck ? gf_filter_pck_get_segment_count(pck) : 0;
+	if (nb_segs<=1) return gf_dm_sess_send(sess, (u8 *) data, size);
+	for (i=0; i<nb_segs; i++) {
+		GF_Err e;
+		u32 seg_size;
+		const u8 *seg = gf_filter_pck_get_segment(pck, i, &seg_size);
+		if (!seg || !seg_size) continue;
+		e = gf_dm_sess_send(sess, (u8 *) seg, seg_size);
+		if (e) return e;
+	}
+	return GF_OK;
+}
+
+//writes data of a packet to file, without gathering the segments if pck is a segmented packet
+static u32 httpout_write_data(FILE *file, GF_FilterPacket *pck, const u8 *data, u32 size)
+{
+	u32 i, nb_write=0, nb_segs = pck ? gf_filter_pck_get_segment_count(pck) : 0;
+	if (nb_segs<=1) return (u32) gf_fwrite(data, size, file);
+	for (i=0; i<nb_segs; i++) {
+		u32 seg_size;
+		const u8 *seg = gf_filter_pck_get_segment(pck, i, &seg_size);
+		if (!seg || !seg_size) continue;
+		nb_write += (u32) gf_fwrite(seg, seg_size, file);
+	}
+	return nb_write;
+}
+
+//pck is the source packet of pck_data if any, its segments are used for segmented packets
+u32 httpout_write_input(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in, GF_FilterPacket *pck, const u8 *pck_data, u32 pck_size, Bool file_start)
 {
 	u32 out=0;
 
@@ -4123,10 +4244,10 @@ u32 httpout_write_input(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in, const u8 *pck_d
 retry:
 			if (!in->is_h2) {
 				e = gf_dm_sess_send(up_sess, szChunkHdr, chunk_hdr_len);
-				e |= gf_dm_sess_send(up_sess, (u8 *) pck_data, pck_size);
+				e |= httpout_send_data(up_sess, pck, pck_data, pck_size);
 				e |= gf_dm_sess_send(up_sess, "\r\n", 2);
 			} else {
-				e = gf_dm_sess_send(up_sess, (u8 *) pck_data, pck_size);
+				e = httpout_send_data(up_sess, pck, pck_data, pck_size);
 			}
 			if ((e==GF_IP_CONNECTION_CLOSED) || (e==GF_URL_REMOVED)) {
 				if (file_start && (nb_retry<10) ) {
@@ -4186,11 +4307,11 @@ retry:
 		u32 i, count = gf_list_count(ctx->active_sessions);
 
 		if (in->resource) {
-			out = (u32) gf_fwrite(pck_data, pck_size, in->resource);
+			out = httpout_write_data(in->resource, pck, pck_data, pck_size);
 			gf_fflush(in->resource);
 
 			if (in->hls_chunk) {
-				u32 wb = (u32) gf_fwrite(pck_data, pck_size, in->hls_chunk);
+				u32 wb = httpout_write_data(in->hls_chunk, pck, pck_data, pck_size);
 				if (wb != pck_size) {
 					GF_LOG(GF_LOG_ERROR, GF_LOG_HTTP, ("[HTTPOut] Write error for HLS chunk, wrote %d bytes but had %d to write\n", wb, pck_size));
 					out = 0; //to trigger IO err in process
@@ -4235,10 +4356,10 @@ retry:
 						chunk_hdr_len = (u32) strlen(szChunkHdr);
 					}
 					e = gf_dm_sess_send(sess->http_sess, szChunkHdr, chunk_hdr_len);
-					e |= gf_dm_sess_send(sess->http_sess, (u8*) pck_data, pck_size);
+					e |= httpout_send_data(sess->http_sess, pck, pck_data, pck_size);
 					e |= gf_dm_sess_send(sess->http_sess, "\r\n", 2);
 				} else {
-					e = gf_dm_sess_send(sess->http_sess, (u8*) pck_data, pck_size);
+					e = httpout_send_data(sess->http_sess, pck, pck_data, pck_size);
 				}
 				if ((e==GF_IP_CONNECTION_CLOSED) || (e==GF_URL_REMOVED)) {
 					httpout_close_session(sess, e);
@@ -4277,12 +4398,13 @@ static Bool httpout_input_write_ready(GF_HTTPOutCtx *ctx, GF_HTTPOutInput *in)
 		return GF_TRUE;
 	}
 
-	count = gf_list_count(ctx->active_sessions);
+	//sessions attached to an input are never idle
+	count = gf_list_count(ctx->busy_sessions);
 	if (!count) return GF_FALSE;
 
 	u32 nb_ready=0;
 	for (i=0; i<count; i++) {
-		GF_HTTPOutSession *sess = gf_list_get(ctx->active_sessions, i);
+		GF_HTTPOutSession *sess = gf_list_get(ctx->busy_sessions, i);
 		if (sess->in_source != in) continue;
 		if (sess->done) continue;
 		//file-based upload
@@ -4370,7 +4492,7 @@ static void httpout_process_inputs(GF_HTTPOutCtx *ctx)
 		const GF_PropertyValue *p;
 		const u8 *pck_data;
 		u32 pck_size, nb_write;
-		GF_FilterPacket *pck;
+		GF_FilterPacket *pck, *seg_pck;
 		GF_HTTPOutInput *in = gf_list_get(ctx->inputs, i);
 
 		//prune files (does nothing if waiting for reply
@@ -4634,7 +4756,15 @@ next_pck:
 			continue;
 		}
 
-		pck_data = gf_filter_pck_get_data(pck, &pck_size);
+		//segmented packets are sent without gathering their segments
+		if (gf_filter_pck_get_segment_count(pck)>1) {
+			seg_pck = pck;
+			pck_data = gf_filter_pck_get_segment(pck, 0, &pck_size);
+			pck_size = gf_filter_pck_get_data_size(pck);
+		} else {
+			seg_pck = NULL;
+			pck_data = gf_filter_pck_get_data(pck, &pck_size);
+		}
 		if (in->upload || ctx->single_mode || in->resource) {
 			GF_FilterFrameInterface *hwf = gf_filter_pck_get_frame_interface(pck);
 			if (pck_data && pck_size) {
@@ -4672,7 +4802,7 @@ next_pck:
 								if (in->flush_open) continue;
 							}
 
-							nb_write = httpout_write_input(ctx, in, pck_data, pck_size, start);
+							nb_write = httpout_write_input(ctx, in, seg_pck, pck_data, pck_size, start);
 							if (nb_write!=pck_size) {
 								GF_LOG(GF_LOG_ERROR, GF_LOG_HTTP, ("[HTTPOut] Write error, wrote %d bytes but had %d to write\n", nb_write, pck_size));
 							}
@@ -4700,7 +4830,7 @@ next_pck:
 						}
 					}
 
-					nb_write = httpout_write_input(ctx, in, pck_data, pck_size, start);
+					nb_write = httpout_write_input(ctx, in, seg_pck, pck_data, pck_size, start);
 					if (nb_write!=pck_size) {
 						GF_LOG(GF_LOG_ERROR, GF_LOG_HTTP, ("[HTTPOut] Write error, wrote %d bytes but had %d to write\n", nb_write, pck_size));
 					}
@@ -4737,7 +4867,7 @@ next_pck:
 							lsize = stride;
 						}
 						for (j=0; j<write_h; j++) {
-							nb_write = (u32) httpout_write_input(ctx, in, out_ptr, lsize, start);
+							nb_write = (u32) httpout_write_input(ctx, in, NULL, out_ptr, lsize, start);
 							if (nb_write!=lsize) {
 								GF_LOG(GF_LOG_ERROR, GF_LOG_HTTP, ("[HTTPOut] Write error, wrote %d bytes but had %d to write\n", nb_write, lsize));
 							}
@@ -4806,14 +4936,28 @@ static GF_Err httpout_process(GF_Filter *filter)
 
 	e = gf_sk_group_select(ctx->sg, 10, GF_SK_SELECT_BOTH);
 	if ((e==GF_OK) && ctx->server_sock) {
+		GF_Socket *sk;
+		Bool has_new_conn = GF_FALSE;
+		u32 idx = 0;
+		//only browse ready sockets: wake up idle sessions and check pending connections
+		while ((sk = gf_sk_group_enum_ready(ctx->sg, &idx, GF_SK_SELECT_READ))) {
+			GF_HTTPOutSession *sess;
+			if (sk == ctx->server_sock) {
+				has_new_conn = GF_TRUE;
+				continue;
+			}
+			sess = gf_sk_get_udta(sk);
+			if (sess && sess->idle && (sess->socket==sk))
+				httpout_sess_set_idle(sess, GF_FALSE);
+		}
 		//server mode, check pending connections
-		if (gf_sk_group_sock_is_set(ctx->sg, ctx->server_sock, GF_SK_SELECT_READ)) {
+		if (has_new_conn) {
 			httpout_check_new_session(ctx);
 		}
 
-		count = gf_list_count(ctx->active_sessions);
+		count = gf_list_count(ctx->busy_sessions);
 		for (i=0; i<count; i++) {
-			GF_HTTPOutSession *sess = gf_list_get(ctx->active_sessions, i);
+			GF_HTTPOutSession *sess = gf_list_get(ctx->busy_sessions, i);
 			if ((sess->flush_close && !httpout_sess_flush_close(sess, GF_FALSE))
 #ifdef GPAC_HAS_QJS
 				|| (sess->async_pending==1)
@@ -4845,17 +4989,27 @@ static GF_Err httpout_process(GF_Filter *filter)
 				httpout_del_session(sess);
 				i--;
 				count--;
-				if (!count && ctx->quit)
+				if (!gf_list_count(ctx->active_sessions) && ctx->quit)
 					ctx->done = GF_TRUE;
 				continue;
 			}
 
 			if (sess->sub_sess_pending) {
 				sess->sub_sess_pending = GF_FALSE;
-				count = gf_list_count(ctx->active_sessions);
+				count = gf_list_count(ctx->busy_sessions);
 				i = -1;
+				continue;
+			}
+			//waiting for a new request, no longer processed until its socket is ready
+			if (httpout_sess_is_idle(sess)) {
+				httpout_sess_set_idle(sess, GF_TRUE);
+				i--;
+				count--;
 			}
 		}
+		//keep checking idle sessions at the same pace as when they were processed
+		if ((count < gf_list_count(ctx->active_sessions)) && (ctx->next_wake_us > 100))
+			ctx->next_wake_us = 100;
 	} else if ((e==GF_IP_NETWORK_EMPTY) && gf_list_count(ctx->active_sessions)) {
 		ctx->next_wake_us = 1;
 	}
@@ -5022,6 +5176,7 @@ static const GF_FilterArgs HTTPOutArgs[] =
 	{ OFFS(js), "javascript logic for server", GF_PROP_STRING, NULL, NULL, GF_FS_ARG_HINT_EXPERT},
 #endif
 	{ OFFS(zmax), "maximum uncompressed size allowed for gzip or deflate compression for text files (only enabled if client indicates it), 0 will disable compression", GF_PROP_UINT, "50000", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(zcopy), "use zero-copy transfer (sendfile) of files and byte ranges for non-TLS HTTP/1.1 responses when supported by the system", GF_PROP_BOOL, "true", NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
 
@@ -50,7 +50,7 @@ typedef struct
 {
 	//options
 	char *dst, *ext, *mime, *ifce, *ip;
-	u32 carousel, first_port, bsid, mtu, splitlct, ttl, brinc, runfor;
+	u32 carousel, first_port, bsid, mtu, splitlct, ttl, brinc, runfor, batch;
 	Bool korean, llmode, noreg, nozip, furl;
 	u32 csum;
 
@@ -68,6 +68,12 @@ typedef struct
 	//preallocated buffer for LCT packet formating
 	u8 *lct_buffer;
 	GF_BitStream *lct_bs;
+	//LCT packets pending for batched send, formatted in consecutive slots of mtu bytes of lct_batch
+	u8 *lct_batch;
+	const u8 **lct_batch_ptrs;
+	u32 *lct_batch_sizes;
+	u32 nb_lct_batch;
+	GF_Socket *lct_batch_sock;
 
 	u64 reschedule_us;
 	//TOI for raw files
@@ -357,6 +363,8 @@ fail:
 	return NULL;
 }
 
+static void routeout_lct_flush(GF_ROUTEOutCtx *ctx);
+
 void routeout_remove_pid(ROUTEPid *rpid, Bool is_rem)
 {
 	if (!is_rem) {
@@ -424,6 +432,7 @@ static GF_Err routeout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool
 
 	rpid = gf_filter_pid_get_udta(pid);
 	if (is_remove) {
+		routeout_lct_flush(ctx);
 		if (rpid) routeout_remove_pid(rpid, GF_FALSE);
 		return GF_OK;
 	}
@@ -773,7 +782,16 @@ static GF_Err routeout_initialize(GF_Filter *filter)
 		ctx->dvb_mabr_tsi = 1;
 	}
 
-	ctx->lct_buffer = gf_malloc(sizeof(u8) * ctx->mtu);
+	if (ctx->batch>1) {
+		//LCT packets are formatted directly in the batch slots
+		ctx->lct_batch = gf_malloc(sizeof(u8) * ctx->mtu * ctx->batch);
+		ctx->lct_batch_ptrs = gf_malloc(sizeof(u8 *) * ctx->batch);
+		ctx->lct_batch_sizes = gf_malloc(sizeof(u32) * ctx->batch);
+		if (!ctx->lct_batch || !ctx->lct_batch_ptrs || !ctx->lct_batch_sizes) return GF_OUT_OF_MEM;
+		ctx->lct_buffer = ctx->lct_batch;
+	} else {
+		ctx->lct_buffer = gf_malloc(sizeof(u8) * ctx->mtu);
+	}
 	ctx->clock_init = gf_sys_clock_high_res();
 	ctx->clock_stats = ctx->clock_init;
 	ctx->lct_bs = gf_bs_new(ctx->lct_buffer, ctx->mtu, GF_BITSTREAM_WRITE);
@@ -800,6 +818,7 @@ static void routeout_finalize(GF_Filter *filter)
 
 	ctx = (GF_ROUTEOutCtx *) gf_filter_get_udta(filter);
 
+	routeout_lct_flush(ctx);
 	while (gf_list_count(ctx->services)) {
 		routeout_delete_service(gf_list_pop_back(ctx->services));
 	}
@@ -809,7 +828,10 @@ static void routeout_finalize(GF_Filter *filter)
 	if (ctx->sock_dvb_mabr)
 		gf_sk_del(ctx->sock_dvb_mabr);
 
-	if (ctx->lct_buffer) gf_free(ctx->lct_buffer);
+	if (ctx->lct_batch) gf_free(ctx->lct_batch);
+	else if (ctx->lct_buffer) gf_free(ctx->lct_buffer);
+	if (ctx->lct_batch_ptrs) gf_free((void *) ctx->lct_batch_ptrs);
+	if (ctx->lct_batch_sizes) gf_free(ctx->lct_batch_sizes);
 	if (ctx->lls_slt_table) gf_free(ctx->lls_slt_table);
 	if (ctx->lls_time_table) gf_free(ctx->lls_time_table);
 	if (ctx->dvb_mabr_config) gf_free(ctx->dvb_mabr_config);
@@ -1565,6 +1587,20 @@ static GF_Err routeout_update_dvb_mabr_fdt(GF_ROUTEOutCtx *ctx, ROUTEService *se
 }
 
 
+static void routeout_lct_flush(GF_ROUTEOutCtx *ctx)
+{
+	GF_Err e;
+	u32 nb_sent=0;
+	if (!ctx->nb_lct_batch) return;
+
+	e = gf_sk_send_batch(ctx->lct_batch_sock, ctx->lct_batch_ptrs, ctx->lct_batch_sizes, ctx->nb_lct_batch, &nb_sent);
+	if (e) {
+		GF_LOG(GF_LOG_ERROR, GF_LOG_ROUTE, ("[%s] Failed to send %u LCT packets: %s\n", ctx->log_name, ctx->nb_lct_batch - nb_sent, gf_error_to_string(e) ));
+	}
+	ctx->nb_lct_batch = 0;
+	ctx->lct_batch_sock = NULL;
+}
+
 u32 routeout_lct_send(GF_ROUTEOutCtx *ctx, GF_Socket *sock, u32 tsi, u32 toi, u32 codepoint, u8 *payload, u32 len, u32 offset, ROUTEService *serv, u32 total_size, u32 offset_in_frame, u32 fdt_instance_id)
 {
 	u32 max_size = ctx->mtu;
@@ -1596,6 +1632,13 @@ u32 routeout_lct_send(GF_ROUTEOutCtx *ctx, GF_Socket *sock, u32 tsi, u32 toi, u3
 			else hdr_len += 2;
 		}
 	}
+	//batched mode, format in next slot - batches only contain packets for a single socket
+	if (ctx->lct_batch) {
+		if (ctx->lct_batch_sock && (ctx->lct_batch_sock != sock))
+			routeout_lct_flush(ctx);
+		ctx->lct_buffer = ctx->lct_batch + ctx->nb_lct_batch * ctx->mtu;
+	}
+
 	//start offset is not in header
 	send_payl_size = 4 * (hdr_len+1) + len - offset;
 	if (send_payl_size > max_size) {
@@ -1693,7 +1736,17 @@ u32 routeout_lct_send(GF_ROUTEOutCtx *ctx, GF_Socket *sock, u32 tsi, u32 toi, u3
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_ROUTE, ("[%s] LCT TSI %u TOI %u size %u (frag %u total %u) offset %u (%u in obj)\n", serv ? serv->log_name : ctx->log_name, tsi, toi, send_payl_size, len, total_size, offset, offset_in_frame));
 
 	memcpy(ctx->lct_buffer + hpos, payload + offset, send_payl_size);
-	e = gf_sk_send(sock, ctx->lct_buffer, send_payl_size + hpos);
+	if (ctx->lct_batch) {
+		ctx->lct_batch_ptrs[ctx->nb_lct_batch] = ctx->lct_buffer;
+		ctx->lct_batch_sizes[ctx->nb_lct_batch] = send_payl_size + hpos;
+		ctx->nb_lct_batch++;
+		ctx->lct_batch_sock = sock;
+		if (ctx->nb_lct_batch == ctx->batch)
+			routeout_lct_flush(ctx);
+		e = GF_OK;
+	} else {
+		e = gf_sk_send(sock, ctx->lct_buffer, send_payl_size + hpos);
+	}
 	if (e) {
 		GF_LOG(GF_LOG_ERROR, GF_LOG_ROUTE, ("[%s] Failed to send LCT object TSI %u TOI %u fragment: %s\n", serv ? serv->log_name : ctx->log_name, tsi, toi, gf_error_to_string(e) ));
 	}
@@ -2798,7 +2851,10 @@ static GF_Err routeout_process(GF_Filter *filter)
 		ROUTEService *serv = gf_list_get(ctx->services, i);
 		if (serv->is_done) continue;
 		e = routeout_check_service_updates(ctx, serv);
-		if (!serv->service_ready || (e==GF_NOT_READY)) return GF_OK;
+		if (!serv->service_ready || (e==GF_NOT_READY)) {
+			routeout_lct_flush(ctx);
+			return GF_OK;
+		}
 	}
 	if (ctx->sock_dvb_mabr) {
 		routeout_send_mabr_manifest(ctx);
@@ -2812,6 +2868,7 @@ static GF_Err routeout_process(GF_Filter *filter)
 				all_serv_done = GF_FALSE;
 		}
 	}
+	routeout_lct_flush(ctx);
 
 	if (all_serv_done) {
 		return e ? e : GF_EOS;
@@ -2891,6 +2948,7 @@ static const GF_FilterArgs ROUTEOutArgs[] =
 	{ OFFS(ttl), "time-to-live for multicast packets", GF_PROP_UINT, "0", NULL, 0},
 	{ OFFS(bsid), "ID for ATSC broadcast stream", GF_PROP_UINT, "800", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(mtu), "size of LCT MTU in bytes", GF_PROP_UINT, "1472", NULL, 0},
+	{ OFFS(batch), "maximum number of LCT packets sent in a single system call (0 or 1 disables batching)", GF_PROP_UINT, "32", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(splitlct), "split mode for LCT channels\n"
 		"- off: all streams are in the same LCT channel\n"
 		"- type: each new stream type results in a new LCT channel\n"
@@ -54,6 +54,7 @@ typedef struct
 	char *info, *url, *email;
 	s32 runfor, tso;
 	Bool latm;
+	u32 batch;
 
 	/*timeline origin of our session (all tracks) in microseconds*/
 	u64 sys_clock_at_init;
@@ -741,6 +742,7 @@ static GF_Err rtpout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is
 	//init rtp
 	e = rtpout_init_streamer(stream,  ctx->ip ? ctx->ip : "127.0.0.1", ctx->xps, ctx->mpeg4, ctx->latm, payt, ctx->mtu, ctx->ttl, ctx->ifce, GF_FALSE, &ctx->base_pid_id, ctx->single_stream, gf_filter_get_netcap_id(filter));
 	if (e) return e;
+	gf_rtp_streamer_set_send_batch(stream->rtp, ctx->batch);
 
 	stream->selected = GF_TRUE;
 
@@ -1148,6 +1150,9 @@ GF_Err rtpout_process_rtp(GF_List *streams, GF_RTPOutStream **active_stream, Boo
 	} else {
 		e = gf_rtp_streamer_send_data(stream->rtp, (char *) pck_data, pck_size, pck_size, cts, dts, stream->current_sap ? 1 : 0, 1, 1, stream->pck_num, duration, stream->sample_desc_index);
 	}
+	//send all packets of the AU
+	GF_Err flush_e = gf_rtp_streamer_flush(stream->rtp);
+	if (!e) e = flush_e;
 	gf_filter_pid_drop_packet(stream->pid);
 	stream->has_pck = GF_FALSE;
 
@@ -1242,6 +1247,7 @@ static const GF_FilterArgs RTPOutArgs[] =
 	{ OFFS(dst), "URL for direct RTP mode", GF_PROP_NAME, NULL, NULL, 0},
 	{ OFFS(ext), "file extension for direct RTP mode", GF_PROP_STRING, NULL, NULL, GF_FS_ARG_HINT_ADVANCED},
 	{ OFFS(mime), "set mime type for direct RTP mode", GF_PROP_NAME, NULL, NULL, GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(batch), "maximum number of RTP packets of an access unit sent in a single system call (0 or 1 disables batching)", GF_PROP_UINT, "32", NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
 
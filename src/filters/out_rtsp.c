@@ -97,7 +97,8 @@ typedef struct
 	u32 block_size;
 	Bool close, loop, mpeg4, quit, htun, dynurl;
 	u32 mcast, trp;
-	Bool latm;
+	Bool latm, shared;
+	u32 batch;
 
 	GF_Filter *filter;
 	GF_Socket *server_sock;
@@ -113,12 +114,37 @@ typedef struct
 	u32 ms_timeout;
 } GF_RTSPOutCtx;
 
+//client stream fed by a stream of a shared session
+typedef struct
+{
+	//stream in source session, NULL if removed
+	GF_RTPOutStream *src;
+	GF_RTPChannel *channel;
+	u32 rtp_id, rtcp_id;
+	//rewrite of source sequence numbers and timestamps
+	u16 sn_offset, next_sn;
+	u32 ts_offset;
+	//sender report sent since last PLAY
+	Bool sr_sent;
+} RTSPOutSharedStream;
+
 typedef struct __rtspout_session
 {
 	GF_RTSPOutCtx *ctx;
 
 	struct __rtspout_session *mcast_mirror;
 
+	//source session if packets are shared, and list of RTSPOutSharedStream
+	struct __rtspout_session *shared_src;
+	GF_List *shared_streams;
+	//list of sessions fed by this session
+	GF_List *shared_sessions;
+	//own client has paused or left, only feed shared sessions
+	Bool shared_paused, shared_detached;
+	//packetization and fan-out stats
+	u64 pck_us, fanout_us;
+	u32 nb_pck, nb_fanout;
+
 	GF_RTSPSession *rtsp;
 	GF_RTSPCommand *command;
 	GF_RTSPResponse *response;
@@ -229,6 +255,8 @@ static GF_Err rtspout_send_sdp(GF_RTSPOutSession *sess)
 	if (sess->mcast_mirror) {
 		ip = sess->mcast_mirror->multicast_ip;
  		e = rtpout_create_sdp(sess->mcast_mirror->streams, GF_FALSE, ip, sess->ctx->info, "livesession", sess->ctx->url, sess->ctx->email, sess->mcast_mirror->base_pid_id, &sdp_out, &sess->sdp_id);
+	} else if (sess->shared_src) {
+ 		e = rtpout_create_sdp(sess->shared_src->streams, GF_TRUE, ip, sess->ctx->info, "livesession", sess->ctx->url, sess->ctx->email, sess->shared_src->base_pid_id, &sdp_out, &sess->sdp_id);
 	} else {
  		e = rtpout_create_sdp(sess->streams, GF_TRUE, ip, sess->ctx->info, "livesession", sess->ctx->url, sess->ctx->email, sess->base_pid_id, &sdp_out, &sess->sdp_id);
 	}
@@ -267,8 +295,43 @@ static void rtspout_del_stream(GF_RTPOutStream *st)
 }
 
 
+static void rtspout_log_shared_stats(GF_RTSPOutSession *sess)
+{
+	GF_LOG(GF_LOG_INFO, GF_LOG_RTP, ("[RTSPOut] Session %s: %u shared sessions - %u RTP packets built in "LLU" us - %u RTP packets forwarded in "LLU" us\n",
+		sess->service_name, gf_list_count(sess->shared_sessions), sess->nb_pck, sess->pck_us, sess->nb_fanout, sess->fanout_us));
+}
+
+//detach sessions fed by a stream of this session, or by all streams if stream is NULL
+static void rtspout_shared_unlink(GF_RTSPOutSession *sess, GF_RTPOutStream *stream)
+{
+	u32 i, j;
+	for (i=0; i<gf_list_count(sess->shared_sessions); i++) {
+		GF_RTSPOutSession *a_sess = gf_list_get(sess->shared_sessions, i);
+		for (j=0; j<gf_list_count(a_sess->shared_streams); j++) {
+			RTSPOutSharedStream *ss = gf_list_get(a_sess->shared_streams, j);
+			if (!stream || (ss->src==stream)) ss->src = NULL;
+		}
+		if (!stream) {
+			a_sess->shared_src = NULL;
+			a_sess->play_state = 0;
+		}
+	}
+}
+
 static void rtspout_del_session(GF_Filter *filter, GF_RTSPOutSession *sess)
 {
+	if (sess->nb_fanout) rtspout_log_shared_stats(sess);
+	rtspout_shared_unlink(sess, NULL);
+	gf_list_del(sess->shared_sessions);
+	if (sess->shared_src)
+		gf_list_del_item(sess->shared_src->shared_sessions, sess);
+	while (gf_list_count(sess->shared_streams)) {
+		RTSPOutSharedStream *ss = gf_list_pop_back(sess->shared_streams);
+		if (ss->channel) gf_rtp_del(ss->channel);
+		gf_free(ss);
+	}
+	gf_list_del(sess->shared_streams);
+
 	//server mode, cleanup
 	while (gf_list_count(sess->streams)) {
 		GF_RTPOutStream *stream = gf_list_pop_back(sess->streams);
@@ -332,6 +395,58 @@ static void rtspout_on_rtcp(void *udta)
 	sess->last_active_time = gf_sys_clock();
 }
 
+//forward RTP packets of a stream to all playing sessions sharing it, only patching the RTP header
+static Bool rtspout_on_rtp_packet(void *udta, GF_RTPHeader *hdr, u8 *payload, u32 payload_size)
+{
+	u32 i, j, count;
+	u64 now;
+	GF_RTPOutStream *stream = (GF_RTPOutStream *) udta;
+	GF_RTSPOutSession *sess = (GF_RTSPOutSession *) stream->on_rtcp_udta;
+	Bool mute = (sess->shared_paused || sess->shared_detached) ? GF_TRUE : GF_FALSE;
+
+	if (hdr) sess->nb_pck++;
+	count = gf_list_count(sess->shared_sessions);
+	if (!count) return mute;
+
+	now = gf_sys_clock_high_res();
+	for (i=0; i<count; i++) {
+		GF_RTSPOutSession *a_sess = gf_list_get(sess->shared_sessions, i);
+		if (a_sess->play_state!=1) continue;
+
+		for (j=0; j<gf_list_count(a_sess->shared_streams); j++) {
+			GF_Err e;
+			GF_RTPHeader a_hdr;
+			RTSPOutSharedStream *ss = gf_list_get(a_sess->shared_streams, j);
+			if ((ss->src != stream) || !ss->channel) continue;
+			//end of AU, send pending batch
+			if (!hdr) {
+				gf_rtp_flush_send_batch(ss->channel);
+				continue;
+			}
+			a_hdr = *hdr;
+			a_hdr.SequenceNumber = hdr->SequenceNumber + ss->sn_offset;
+			a_hdr.TimeStamp = hdr->TimeStamp + ss->ts_offset;
+			//the source channel reports are not valid for this client, send our own SR before the first packet
+			if (!ss->sr_sent) {
+				u32 ntp_sec, ntp_frac;
+				gf_net_get_ntp(&ntp_sec, &ntp_frac);
+				gf_rtp_send_rtcp_sr(ss->channel, a_hdr.TimeStamp, ntp_sec, ntp_frac);
+				ss->sr_sent = GF_TRUE;
+			}
+			//SSRC is the one of the client channel
+			e = gf_rtp_send_packet(ss->channel, &a_hdr, payload, payload_size, GF_TRUE);
+			if (e) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_RTP, ("[RTSPOut] Failed to forward RTP packet to %s: %s\n", a_sess->peer_address, gf_error_to_string(e) ));
+				continue;
+			}
+			ss->next_sn = a_hdr.SequenceNumber + 1;
+			sess->nb_fanout++;
+		}
+	}
+	sess->fanout_us += gf_sys_clock_high_res() - now;
+	return mute;
+}
+
 static GF_Err rtspout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
 {
 	GF_RTSPOutCtx *ctx = (GF_RTSPOutCtx *) gf_filter_get_udta(filter);
@@ -347,6 +462,7 @@ static GF_Err rtspout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool i
 		if (!sess) return GF_OK;
 		GF_RTPOutStream *t = gf_filter_pid_get_udta(pid);
 		if (t) {
+			rtspout_shared_unlink(sess, t);
 			if (sess->active_stream==t) sess->active_stream = NULL;
 			gf_list_del_item(sess->streams, t);
 			rtspout_del_stream(t);
@@ -369,6 +485,7 @@ static GF_Err rtspout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool i
 	case GF_STREAM_FILE:
 	case GF_STREAM_UNKNOWN:
 		if (stream) {
+			rtspout_shared_unlink(sess, stream);
 			if (sess->active_stream==stream) sess->active_stream = NULL;
 			gf_list_del_item(sess->streams, stream);
 			rtspout_del_stream(stream);
@@ -401,6 +518,8 @@ static GF_Err rtspout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool i
 
 	e = rtpout_init_streamer(stream, ctx->ifce ? ctx->ifce : "127.0.0.1", ctx->xps, ctx->mpeg4, ctx->latm, payt, ctx->mtu, ctx->ttl, ctx->ifce, GF_TRUE, &sess->base_pid_id, 0, gf_filter_get_netcap_id(filter));
 	if (e) return e;
+	if (ctx->shared)
+		gf_rtp_streamer_set_packet_callback(stream->rtp, rtspout_on_rtp_packet, stream);
 
 	if (ctx->loop) {
 		p = gf_filter_pid_get_property(pid, GF_PROP_PID_PLAYBACK_MODE);
@@ -434,6 +553,8 @@ static GF_Err rtspout_check_new_session(GF_RTSPOutCtx *ctx, Bool single_session)
 	sess->response = gf_rtsp_response_new();
 	sess->streams = gf_list_new();
 	sess->filter_srcs = gf_list_new();
+	sess->shared_streams = gf_list_new();
+	sess->shared_sessions = gf_list_new();
 	if (gf_sys_is_test_mode()) {
 		strcpy(sess->ctrl_name, "trackID");
 	} else {
@@ -784,25 +905,36 @@ static GF_Err rtspout_process_rtp(GF_Filter *filter, GF_RTSPOutCtx *ctx, GF_RTSP
 {
 	GF_Err e = GF_OK;
 	u32 repost_delay_us=0;
+	u64 clock_us, fanout_us;
 
 	/*init session timeline - all sessions are sync'ed for packet scheduling purposes*/
 	if (!sess->sys_clock_at_init) {
 		if (!rtspout_init_clock(ctx, sess)) return GF_OK;
 	}
 
-	if (sess->rtsp && sess->interleave) {
+	if (sess->rtsp && sess->interleave && !sess->shared_detached) {
 		e = gf_rtsp_check_connection(sess->rtsp);
 		if (e==GF_IP_NETWORK_EMPTY) {
 			ctx->next_wake_us = 100;
 			return GF_OK;
+		} else if (e && gf_list_count(sess->shared_sessions)) {
+			sess->shared_detached = GF_TRUE;
 		} else if (e) {
 			return e;
 		}
 	}
 
+	clock_us = gf_sys_clock_high_res();
+	fanout_us = sess->fanout_us;
 	e = rtpout_process_rtp(sess->streams, &sess->active_stream, sess->loop, ctx->delay, &sess->active_stream_idx, sess->sys_clock_at_init, &sess->active_min_ts_microsec, sess->microsec_ts_init, &sess->wait_for_loop, &repost_delay_us, &sess->first_RTCP_sent, sess->base_pid_id);
+	sess->pck_us += gf_sys_clock_high_res() - clock_us - (sess->fanout_us - fanout_us);
 
 	if (e) {
+		if (((e==GF_IP_CONNECTION_CLOSED) || (e==GF_IP_CONNECTION_FAILURE)) && gf_list_count(sess->shared_sessions)) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_RTP, ("[RTSPOut] Session %s: client %s disconnected, keeping session for shared sessions\n", sess->service_name, sess->peer_address));
+			sess->shared_detached = GF_TRUE;
+			return GF_OK;
+		}
 		if ((e==GF_IP_CONNECTION_CLOSED) || (e==GF_IP_CONNECTION_FAILURE)) {
 			sess->play_state = 0;
 			rtspout_send_event(sess, GF_TRUE, GF_FALSE, 0);
@@ -823,11 +955,24 @@ static GF_Err rtspout_interleave_packet(void *cbk1, void *cbk2, Bool is_rtcp, u8
 	GF_RTPOutStream *stream = (GF_RTPOutStream *)cbk2;
 
 	u32 idx = is_rtcp ? stream->rtcp_id : stream->rtp_id;
+	//client is gone but session still feeds shared sessions
+	if (sess->shared_detached)
+		return GF_OK;
 	if (!sess->rtsp)
 		return GF_IP_CONNECTION_CLOSED;
 	return gf_rtsp_session_write_interleaved(sess->rtsp, idx, pck, pck_size);
 }
 
+static GF_Err rtspout_interleave_shared_packet(void *cbk1, void *cbk2, Bool is_rtcp, u8 *pck, u32 pck_size)
+{
+	GF_RTSPOutSession *sess = (GF_RTSPOutSession *)cbk1;
+	RTSPOutSharedStream *ss = (RTSPOutSharedStream *)cbk2;
+
+	if (!sess->rtsp)
+		return GF_IP_CONNECTION_CLOSED;
+	return gf_rtsp_session_write_interleaved(sess->rtsp, is_rtcp ? ss->rtcp_id : ss->rtp_id, pck, pck_size);
+}
+
 Bool rtspout_on_filter_setup_error(GF_Filter *f, void *on_setup_error_udta, GF_Err e)
 {
 	GF_RTSPOutSession *sess = (GF_RTSPOutSession *)on_setup_error_udta;
@@ -960,6 +1105,27 @@ static GF_RTSPOutSession *rtspout_locate_mcast(GF_RTSPOutCtx *ctx, char *res_pat
 	return NULL;
 }
 
+//locate a playing unicast session for this resource, whose packets can be shared
+static GF_RTSPOutSession *rtspout_locate_shared(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess, char *res_path)
+{
+	u32 i, count = gf_list_count(ctx->sessions);
+	for (i=0; i<count; i++) {
+		char *a_sess_path=NULL;
+		GF_RTSPOutSession *a_sess = gf_list_get(ctx->sessions, i);
+		if ((a_sess==sess) || a_sess->shared_src || a_sess->multicast_ip || a_sess->single_session) continue;
+		if ((a_sess->play_state!=1) || (a_sess->sdp_state!=SDP_LOADED) || !a_sess->service_name) continue;
+		//about to be destroyed
+		if (a_sess->shared_detached && !gf_list_count(a_sess->shared_sessions)) continue;
+
+		a_sess_path = strstr(a_sess->service_name, "://");
+		if (a_sess_path) a_sess_path = strchr(a_sess_path+3, '/');
+		if (a_sess_path) a_sess_path++;
+		if (a_sess_path && !strcmp(a_sess_path, res_path))
+			return a_sess;
+	}
+	return NULL;
+}
+
 static char *rtspout_get_local_res_path(GF_RTSPOutCtx *ctx, char *res_path, GF_RTSPCommand *com, u32 *err_code, u32 *mcast_mode)
 {
 	u32 i, count, di_len;
@@ -1082,11 +1248,40 @@ static u32 rtspout_get_ctrl_id(GF_RTSPOutSession *sess, char *ctrl)
 	return stream_ctrl_id;
 }
 
+static GF_Err rtspout_setup_shared_stream(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess, GF_RTPOutStream *stream, GF_RTSPTransport *transport, RTSPOutSharedStream **out_ss)
+{
+	GF_Err e;
+	u32 i, count = gf_list_count(sess->shared_streams);
+	RTSPOutSharedStream *ss = NULL;
+	for (i=0; i<count; i++) {
+		ss = gf_list_get(sess->shared_streams, i);
+		if (ss->src==stream) break;
+		ss = NULL;
+	}
+	if (!ss) {
+		GF_SAFEALLOC(ss, RTSPOutSharedStream);
+		if (!ss) return GF_OUT_OF_MEM;
+		ss->src = stream;
+		ss->next_sn = (u16) gf_rand();
+		if (ctx->tso<0) ss->ts_offset = gf_rand();
+		gf_list_add(sess->shared_streams, ss);
+	}
+	if (ss->channel) gf_rtp_del(ss->channel);
+	ss->channel = gf_rtp_streamer_new_channel(stream->rtp, ctx->mtu, transport, ctx->ifce, &e);
+	if (!ss->channel) return e;
+	gf_rtp_set_send_batch(ss->channel, ctx->batch);
+	*out_ss = ss;
+	return GF_OK;
+}
+
 static GF_Err rtspout_process_setup(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess, char *ctrl)
 {
 	GF_Err e;
 	char remoteIP[GF_MAX_IP_NAME_LEN];
 	GF_RTPOutStream *stream = NULL;
+	RTSPOutSharedStream *ss = NULL;
+	//streams of the source session if shared
+	GF_List *streams = sess->shared_src ? sess->shared_src->streams : sess->streams;
 	GF_RTSPTransport *transport = gf_list_get(sess->command->Transports, 0);
 	u32 rsp_code=NC_RTSP_OK;
 	Bool enable_multicast = GF_FALSE;
@@ -1110,9 +1305,9 @@ static GF_Err rtspout_process_setup(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess,
 	} else if (sess->sessionID && !sess->command->Session) {
 		rsp_code = NC_RTSP_Not_Implemented;
 	} else {
-		u32 i, count = gf_list_count(sess->streams);
+		u32 i, count = gf_list_count(streams);
 		for (i=0; i<count; i++) {
-			stream = gf_list_get(sess->streams, i);
+			stream = gf_list_get(streams, i);
 			if (stream_ctrl_id==stream->ctrl_id)
 				break;
 			stream=NULL;
@@ -1136,13 +1331,14 @@ static GF_Err rtspout_process_setup(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess,
 	gf_rtsp_response_reset(sess->response);
 	sess->response->CSeq = sess->command->CSeq;
 
-	stream->selected = GF_TRUE;
+	if (!sess->shared_src)
+		stream->selected = GF_TRUE;
 	if (transport && (rsp_code==NC_RTSP_OK) ) {
 		if (!transport->IsInterleaved) {
 			if (ctx->trp == TRP_TCP_ONLY) {
 				rsp_code = NC_RTSP_Unsupported_Transport;
 			} else {
-				u32 st_idx = gf_list_find(sess->streams, stream);
+				u32 st_idx = gf_list_find(streams, stream);
 				transport->port_first = ctx->firstport + 2 * st_idx;
 				transport->port_last = transport->port_first + 1;
 				if (sess->interleave)
@@ -1177,7 +1373,9 @@ static GF_Err rtspout_process_setup(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess,
 			}
 		}
 		else {
-			if (transport->destination && !gf_sk_is_multicast_address(transport->destination)) {
+			if (sess->shared_src) {
+				rsp_code = NC_RTSP_Unsupported_Transport;
+			} else if (transport->destination && !gf_sk_is_multicast_address(transport->destination)) {
 				rsp_code = NC_RTSP_Bad_Request;
 			} else {
 				u32 mcast_mode = ctx->mcast;
@@ -1226,7 +1424,12 @@ static GF_Err rtspout_process_setup(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess,
 			rsp_code = NC_RTSP_OK; //do not delete session
 		}
 	} else {
-		e = gf_rtp_streamer_init_rtsp(stream->rtp, ctx->mtu, transport, ctx->ifce);
+		if (sess->shared_src) {
+			e = rtspout_setup_shared_stream(ctx, sess, stream, transport, &ss);
+		} else {
+			e = gf_rtp_streamer_init_rtsp(stream->rtp, ctx->mtu, transport, ctx->ifce);
+			if (!e) gf_rtp_streamer_set_send_batch(stream->rtp, ctx->batch);
+		}
 		if (e) {
 			sess->response->ResponseCode = NC_RTSP_Internal_Server_Error;
 		} else {
@@ -1244,7 +1447,11 @@ static GF_Err rtspout_process_setup(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess,
 			gf_list_add(sess->response->Transports, transport);
 		}
 
-		if (sess->interleave) {
+		if (sess->interleave && ss) {
+			ss->rtp_id = transport->rtpID;
+			ss->rtcp_id = transport->rtcpID;
+			gf_rtp_set_interleave_callbacks(ss->channel, rtspout_interleave_shared_packet, sess, ss);
+		} else if (sess->interleave && !sess->shared_src) {
 			stream->rtp_id = transport->rtpID;
 			stream->rtcp_id = transport->rtcpID;
 			gf_rtp_streamer_set_interleave_callbacks(stream->rtp, rtspout_interleave_packet, sess, stream);
@@ -1268,6 +1475,63 @@ static GF_Err rtspout_process_setup(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess,
 }
 
 
+//join the timeline of the source session, keeping sequence numbers continuous for the client
+static void rtspout_play_shared(GF_RTSPOutCtx *ctx, GF_RTSPOutSession *sess)
+{
+	u32 i, count = gf_list_count(sess->shared_streams);
+
+	gf_rtsp_response_reset(sess->response);
+	sess->response->ResponseCode = NC_RTSP_OK;
+	for (i=0; i<count; i++) {
+		u32 timescale;
+		GF_RTPInfo *rtpi;
+		RTSPOutSharedStream *ss = gf_list_get(sess->shared_streams, i);
+		GF_RTPOutStream *stream = ss->src;
+		if (!stream) continue;
+		ss->sn_offset = ss->next_sn - gf_rtp_streamer_get_next_rtp_sn(stream->rtp);
+		ss->sr_sent = GF_FALSE;
+
+		GF_SAFEALLOC(rtpi, GF_RTPInfo);
+		if (!rtpi) continue;
+		rtpi->url = gf_malloc(sizeof(char) * (strlen(sess->service_name)+50));
+		sprintf(rtpi->url, "%s/%s=%d", sess->service_name, sess->ctrl_name, stream->ctrl_id);
+		rtpi->seq = ss->next_sn;
+		rtpi->rtp_time = (u32) (stream->current_cts + stream->ts_offset + stream->rtp_ts_offset);
+		timescale = gf_rtp_streamer_get_timescale(stream->rtp);
+		if (timescale)
+			rtpi->rtp_time = (u32) gf_timestamp_rescale(rtpi->rtp_time, stream->timescale, timescale);
+		rtpi->rtp_time += ss->ts_offset;
+		gf_list_add(sess->response->RTP_Infos, rtpi);
+	}
+	sess->response->CSeq = sess->command->CSeq;
+	rtspout_send_response(ctx, sess);
+
+	if (sess->play_state!=1)
+		sess->sys_clock_at_init = gf_sys_clock_high_res();
+	sess->play_state = 1;
+	sess->pause_sys_clock = 0;
+}
+
+//packets are pushed by the source session, only monitor client activity
+static void rtspout_process_shared(GF_RTSPOutSession *sess)
+{
+	u32 i, count;
+	u8 rtcp_buf[2048];
+
+	if (sess->interleave) {
+		GF_Err e = sess->rtsp ? gf_rtsp_check_connection(sess->rtsp) : GF_IP_CONNECTION_CLOSED;
+		if (e && (e!=GF_IP_NETWORK_EMPTY)) sess->play_state = 0;
+		else sess->last_active_time = gf_sys_clock();
+		return;
+	}
+	count = gf_list_count(sess->shared_streams);
+	for (i=0; i<count; i++) {
+		RTSPOutSharedStream *ss = gf_list_get(sess->shared_streams, i);
+		if (ss->channel && gf_rtp_read_rtcp(ss->channel, rtcp_buf, 2048))
+			sess->last_active_time = gf_sys_clock();
+	}
+}
+
 static GF_Err rtspout_process_session_signaling(GF_Filter *filter, GF_RTSPOutCtx *ctx, GF_RTSPOutSession **sess_ptr)
 {
 	GF_Err e;
@@ -1434,6 +1698,24 @@ static GF_Err rtspout_process_session_signaling(GF_Filter *filter, GF_RTSPOutCtx
 				return GF_OK;
 			}
 		}
+		//share packets of a running session for this resource
+		if (res_path && ctx->shared && !ctx->dst && !is_setup && !gf_list_count(sess->filter_srcs)) {
+			GF_RTSPOutSession *a_sess = sess->shared_src;
+			if (!a_sess) a_sess = rtspout_locate_shared(ctx, sess, res_path);
+			if (a_sess) {
+				if (!sess->shared_src) {
+					sess->shared_src = a_sess;
+					gf_list_add(a_sess->shared_sessions, sess);
+					strcpy(sess->ctrl_name, a_sess->ctrl_name);
+					sess->sdp_state = SDP_LOADED;
+					rtspout_log_shared_stats(a_sess);
+				}
+				if (sess->service_name) gf_free(sess->service_name);
+				sess->service_name = gf_strdup(sess->command->service_name);
+				rtspout_send_sdp(sess);
+				return GF_OK;
+			}
+		}
 
 		if (!res_path) {
 			rsp_code = NC_RTSP_Not_Found;
@@ -1613,6 +1895,16 @@ static GF_Err rtspout_process_session_signaling(GF_Filter *filter, GF_RTSPOutCtx
 			sess->response->CSeq = sess->command->CSeq;
 			rtspout_send_response(ctx, sess);
 			return GF_OK;
+		} else if (sess->shared_src) {
+			rtspout_play_shared(ctx, sess);
+		} else if (gf_list_count(sess->shared_sessions)) {
+			//no seek nor pause on the shared timeline, resume sending to our client
+			sess->shared_paused = GF_FALSE;
+			sess->shared_detached = GF_FALSE;
+			gf_rtsp_response_reset(sess->response);
+			sess->response->ResponseCode = NC_RTSP_OK;
+			sess->response->CSeq = sess->command->CSeq;
+			rtspout_send_response(ctx, sess);
 		} else {
 			//loop enabled, only if multicast session or single session mode
 			if (ctx->loop && !sess->loop_disabled && (sess->single_session || sess->multicast_ip))
@@ -1642,7 +1934,9 @@ static GF_Err rtspout_process_session_signaling(GF_Filter *filter, GF_RTSPOutCtx
 
 	//process pause (we don't implement range on pause yet)
 	if (!strcmp(sess->command->method, GF_RTSP_PAUSE)) {
-		if (sess->play_state!=2) {
+		if (gf_list_count(sess->shared_sessions)) {
+			sess->shared_paused = GF_TRUE;
+		} else if (sess->play_state!=2) {
 			sess->play_state = 2;
 			sess->pause_sys_clock = gf_sys_clock_high_res();
 		}
@@ -1654,6 +1948,20 @@ static GF_Err rtspout_process_session_signaling(GF_Filter *filter, GF_RTSPOutCtx
 	}
 	//process teardown
 	if (!strcmp(sess->command->method, GF_RTSP_TEARDOWN)) {
+		//keep playing for shared sessions, destroyed once they are all gone
+		if (gf_list_count(sess->shared_sessions)) {
+			sess->shared_detached = GF_TRUE;
+			gf_rtsp_response_reset(sess->response);
+			sess->response->ResponseCode = NC_RTSP_OK;
+			sess->response->CSeq = sess->command->CSeq;
+			rtspout_send_response(ctx, sess);
+			if (sess->sessionID) {
+				gf_free(sess->sessionID);
+				sess->sessionID = NULL;
+			}
+			sess->last_active_time = 0;
+			return GF_OK;
+		}
 		sess->play_state = 0;
 		rtspout_send_event(sess, GF_TRUE, GF_FALSE, 0);
 
@@ -1750,9 +2058,21 @@ static GF_Err rtspout_process(GF_Filter *filter)
 		if (sess_err) e |= sess_err;
 		if (!sess) break;
 
+		if (sess->shared_detached && !gf_list_count(sess->shared_sessions)) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_RTP, ("[RTSP] No more shared sessions for %s, closing\n", sess->service_name));
+			rtspout_del_session(filter, sess);
+			i--;
+			count--;
+			continue;
+		}
+
 		if (sess->play_state==1) {
-			sess_err = rtspout_process_rtp(filter, ctx, sess);
-			if (sess_err) e |= sess_err;
+			if (sess->shared_src) {
+				rtspout_process_shared(sess);
+			} else {
+				sess_err = rtspout_process_rtp(filter, ctx, sess);
+				if (sess_err) e |= sess_err;
+			}
 		}
 
 		if (ctx->runfor>0) {
@@ -1767,7 +2087,12 @@ static GF_Err rtspout_process(GF_Filter *filter)
 			}
 		}
 
-		if (sess->last_active_time && ctx->ms_timeout && (now > sess->last_active_time + ctx->ms_timeout)) {
+		if (sess->last_active_time && ctx->ms_timeout && (now > sess->last_active_time + ctx->ms_timeout) && gf_list_count(sess->shared_sessions)) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_RTP, ("[RTSP] Timeout on session %s after %d ms, keeping session for shared sessions\n", sess->service_name, now-sess->last_active_time));
+			sess->shared_detached = GF_TRUE;
+			sess->last_active_time = 0;
+		}
+		else if (sess->last_active_time && ctx->ms_timeout && (now > sess->last_active_time + ctx->ms_timeout)) {
 			GF_LOG(GF_LOG_INFO, GF_LOG_RTP, ("[RTSP] Timeout on session %s after %d ms, aborting\n", sess->service_name, now-sess->last_active_time));
 			rtspout_del_session(filter, sess);
 			i--;
@@ -1840,6 +2165,8 @@ static const GF_FilterArgs RTSPOutArgs[] =
 				"- on: clients can create multicast sessions\n"
 				"- mirror: clients can create a multicast session. Any later request to the same URL will use that multicast session"
 		, GF_PROP_UINT, "off", "off|on|mirror", GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(shared), "share RTP packetization of a playing unicast session with later clients of the same resource (see filter help)", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(batch), "maximum number of RTP packets of an access unit sent in a single system call per client (0 or 1 disables batching)", GF_PROP_UINT, "32", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(quit), "exit server once first session is over (for test purposes)", GF_PROP_BOOL, "false", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(htun), "enable RTSP over HTTP tunnel", GF_PROP_BOOL, "true", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(trp), "transport mode\n"
@@ -1910,6 +2237,12 @@ GF_FilterRegister RTSPOutRegister = {
 		"\n"
 		"In server mode, multicast can be enabled per read directory using the `mcast` access rule of the directory configuration - see `gpac -h creds`.\n"
 		"\n"
+		"# Shared sessions\n"
+		"In server mode, when [-shared]() is set, a DESCRIBE on a resource already played by a unicast session will reuse that session instead of loading the source again.\n"
+		"RTP packets are built once by the playing session, and forwarded to each client with its own sequence numbers, SSRC, timestamp offset and RTCP sender reports.\n"
+		"Clients of a shared session join the live timeline: PLAY ranges are ignored and PAUSE only stops forwarding to that client.\n"
+		"The playing session is kept alive until all clients sharing it are gone. Packetization and forwarding statistics are logged at `info` level of `rtp` tool.\n"
+		"\n"
 		"# HTTP Tunnel\n"
 		"The server mode supports handling RTSP over HTTP tunnel by default. This can be disabled using [-htun]().\n"
 		"The tunnel conforms to QT specification, and only HTTP 1.0 and 1.1 tunnels are supported.\n"
@@ -45,7 +45,7 @@ typedef struct
 	Double start, speed;
 	char *dst, *mime, *ext, *ifce;
 	Bool listen;
-	u32 maxc, port, sockbuf, ka, kp, rate, ttl;
+	u32 maxc, port, sockbuf, ka, kp, rate, ttl, batch;
 	GF_Fraction pckr, pckd;
 
 	GF_Socket *socket;
@@ -69,8 +69,37 @@ typedef struct
 	GF_FilterPacket *rev_pck;
 	u32 next_pckd_idx, next_pckr_idx;
 	u32 nb_pckd_wnd, nb_pckr_wnd;
+
+	//UDP datagrams pending for batched send, copied back to back in batch_buf
+	u8 *batch_buf;
+	u32 batch_buf_size, batch_buf_alloc;
+	const u8 **batch_ptrs;
+	u32 *batch_sizes;
+	u32 nb_batch;
 } GF_SockOutCtx;
 
+static GF_Err sockout_flush_batch(GF_SockOutCtx *ctx)
+{
+	u32 i, nb_sent=0;
+	GF_Err e = GF_OK;
+	if (!ctx->nb_batch) return GF_OK;
+
+	if (ctx->socket) {
+		const u8 *ptr = ctx->batch_buf;
+		for (i=0; i<ctx->nb_batch; i++) {
+			ctx->batch_ptrs[i] = ptr;
+			ptr += ctx->batch_sizes[i];
+		}
+		e = gf_sk_send_batch(ctx->socket, ctx->batch_ptrs, ctx->batch_sizes, ctx->nb_batch, &nb_sent);
+		if (e) {
+			GF_LOG(GF_LOG_ERROR, GF_LOG_NETWORK, ("[SockOut] Write error: %s - %d datagrams lost\n", gf_error_to_string(e), ctx->nb_batch - nb_sent));
+		}
+	}
+	ctx->nb_batch = 0;
+	ctx->batch_buf_size = 0;
+	return e;
+}
+
 
 static GF_Err sockout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
 {
@@ -78,6 +107,7 @@ static GF_Err sockout_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool i
 	GF_SockOutCtx *ctx = (GF_SockOutCtx *) gf_filter_get_udta(filter);
 	if (is_remove) {
 		ctx->pid = NULL;
+		sockout_flush_batch(ctx);
 		gf_sk_del(ctx->socket);
 		ctx->socket = NULL;
 		return GF_OK;
@@ -235,6 +265,19 @@ static GF_Err sockout_initialize(GF_Filter *filter)
 
 	gf_sk_set_buffer_size(ctx->socket, 0, ctx->sockbuf);
 
+	//datagrams are batched, one filter packet per datagram
+	if ((ctx->batch>1) && !ctx->listen && ((sock_type == GF_SOCK_TYPE_UDP)
+#ifdef GPAC_HAS_SOCK_UN
+		|| (sock_type == GF_SOCK_TYPE_UDP_UN)
+#endif
+	)) {
+		ctx->batch_ptrs = gf_malloc(sizeof(u8 *) * ctx->batch);
+		ctx->batch_sizes = gf_malloc(sizeof(u32) * ctx->batch);
+		if (!ctx->batch_ptrs || !ctx->batch_sizes) return GF_OUT_OF_MEM;
+		//let the kernel smooth out bursts of batched datagrams
+		if (ctx->rate)
+			gf_sk_set_pacing_rate(ctx->socket, ctx->rate);
+	}
 	return GF_OK;
 }
 
@@ -250,6 +293,11 @@ static void sockout_finalize(GF_Filter *filter)
 		gf_list_del(ctx->clients);
 	}
 
+	sockout_flush_batch(ctx);
+	if (ctx->batch_buf) gf_free(ctx->batch_buf);
+	if (ctx->batch_ptrs) gf_free((void *) ctx->batch_ptrs);
+	if (ctx->batch_sizes) gf_free(ctx->batch_sizes);
+
 	if (ctx->socket) gf_sk_del(ctx->socket);
 }
 
@@ -265,6 +313,29 @@ static GF_Err sockout_send_packet(GF_SockOutCtx *ctx, GF_FilterPacket *pck, GF_S
 	if (!dst_sock) return GF_OK;
 
 	pck_data = gf_filter_pck_get_data(pck, &pck_size);
+	//copy datagram rather than keeping a packet reference, so that sources recycling their output buffers are not blocked
+	if (pck_data && ctx->batch_ptrs) {
+		if (ctx->batch_buf_size + pck_size > ctx->batch_buf_alloc) {
+			ctx->batch_buf_alloc = ctx->batch_buf_size + pck_size;
+			ctx->batch_buf = gf_realloc(ctx->batch_buf, ctx->batch_buf_alloc);
+			if (!ctx->batch_buf) {
+				ctx->batch_buf_alloc = ctx->batch_buf_size = ctx->nb_batch = 0;
+				return GF_OUT_OF_MEM;
+			}
+		}
+		memcpy(ctx->batch_buf + ctx->batch_buf_size, pck_data, pck_size);
+		ctx->batch_buf_size += pck_size;
+		ctx->batch_sizes[ctx->nb_batch] = pck_size;
+		ctx->nb_batch++;
+		ctx->nb_bytes_sent += pck_size;
+		//packet is consumed even if the send fails (logged in flush)
+		if (ctx->nb_batch == ctx->batch)
+			sockout_flush_batch(ctx);
+		return GF_OK;
+	}
+	//keep send order
+	sockout_flush_batch(ctx);
+
 	if (pck_data) {
 		e = gf_sk_send(dst_sock, pck_data, pck_size);
 		if ((e==GF_IP_CONNECTION_CLOSED) || (e==GF_URL_REMOVED)) return GF_IP_CONNECTION_CLOSED;
@@ -340,6 +411,7 @@ static GF_Err sockout_process(GF_Filter *filter)
 			u64 now = gf_sys_clock_high_res() - ctx->start_time;
 			if (ctx->nb_bytes_sent*8*1000000 > ctx->rate * now) {
 				u64 diff = ctx->nb_bytes_sent*8*1000000 / ctx->rate - now;
+				sockout_flush_batch(ctx);
 				gf_filter_ask_rt_reschedule(filter, (u32) MAX(diff, 1000) );
 				return GF_OK;
 			} else if (gf_filter_reporting_enabled(filter)) {
@@ -387,6 +459,8 @@ static GF_Err sockout_process(GF_Filter *filter)
 
 	pck = gf_filter_pid_get_packet(ctx->pid);
 	if (!pck) {
+		//no more input for now, send pending datagrams
+		sockout_flush_batch(ctx);
 		if (gf_filter_pid_is_eos(ctx->pid) && !gf_filter_pid_is_flush_eos(ctx->pid) ) {
 			if (ctx->rev_pck) {
 				is_pck_ref = GF_TRUE;
@@ -498,7 +572,8 @@ static GF_Err sockout_process(GF_Filter *filter)
 		if (ctx->pck_pending) return GF_OK;
 
 	} else {
-		if (gf_sk_select(ctx->socket, GF_SK_SELECT_WRITE)==GF_IP_NETWORK_EMPTY) {
+		//batched sends check socket state when flushing
+		if (!ctx->batch_ptrs && (gf_sk_select(ctx->socket, GF_SK_SELECT_WRITE)==GF_IP_NETWORK_EMPTY)) {
 			gf_filter_ask_rt_reschedule(filter, 1000);
 			return GF_OK;
 		}
@@ -564,6 +639,7 @@ static const GF_FilterArgs SockOutArgs[] =
 	{ OFFS(pckr), "reverse packet every N", GF_PROP_FRACTION, "0/0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(pckd), "drop packet every N", GF_PROP_FRACTION, "0/0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{ OFFS(ttl), "multicast TTL", GF_PROP_UINT, "0", "0-127", GF_FS_ARG_HINT_EXPERT},
+	{ OFFS(batch), "number of UDP datagrams to send in a single system call (0 or 1 disables batching)", GF_PROP_UINT, "32", NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
 
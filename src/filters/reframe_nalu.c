@@ -33,6 +33,8 @@
 #if !defined(GPAC_DISABLE_AV_PARSERS) && !defined(GPAC_DISABLE_RFNALU)
 
 #define CTS_POC_OFFSET_SAFETY	1000
+//NALs smaller than this are copied rather than referenced in the NAL store
+#define NALU_REF_MIN_SIZE	512
 
 GF_Err gf_bs_set_logger(GF_BitStream *bs, void (*on_bs_log)(void *udta, const char *field_name, u32 nb_bits, u64 field_val, s32 idx1, s32 idx2, s32 idx3), void *udta);
 
@@ -153,6 +155,10 @@ typedef struct
 
 	u8 *nal_store;
 	u32 nal_store_size, nal_store_alloc;
+	//packet holding nal_store once the output pid is created, so that NALs reference it rather than copying it
+	GF_FilterPacket *store_pck;
+	//set when dispatched NALs reference store_pck, the store can then no longer be modified
+	Bool store_shared;
 
 	//list of param sets found
 	GF_List *sps, *pps, *vps, *sps_ext, *pps_svc, *vvc_aps_pre, *vvc_dci, *vvc_opi;
@@ -253,6 +259,7 @@ typedef struct
 static void naludmx_enqueue_or_dispatch(GF_NALUDmxCtx *ctx, GF_FilterPacket *n_pck, Bool flush_ref);
 static void naludmx_finalize_au_flags(GF_NALUDmxCtx *ctx);
 static void naludmx_reset_param_sets(GF_NALUDmxCtx *ctx, Bool do_free);
+static void naludmx_store_release(GF_NALUDmxCtx *ctx);
 static void naludmx_set_dolby_vision(GF_NALUDmxCtx *ctx);
 
 
@@ -265,6 +272,8 @@ GF_Err naludmx_configure_pid(GF_Filter *filter, GF_FilterPid *pid, Bool is_remov
 	if (is_remove) {
 		ctx->ipid = NULL;
 		if (ctx->opid) {
+			naludmx_store_release(ctx);
+			ctx->nal_store_size = 0;
 			gf_filter_pid_remove(ctx->opid);
 			ctx->opid = NULL;
 		}
@@ -2335,17 +2344,88 @@ static void naludmx_update_nalu_maxsize(GF_NALUDmxCtx *ctx, u32 size)
 }
 
 
-GF_FilterPacket *naludmx_start_nalu(GF_NALUDmxCtx *ctx, u32 nal_size, Bool skip_nal_field, Bool *au_start, u8 **pck_data)
+static void naludmx_store_release(GF_NALUDmxCtx *ctx)
 {
-	GF_FilterPacket *dst_pck = gf_filter_pck_new_alloc(ctx->opid, nal_size + (skip_nal_field ? 0 : ctx->nal_length), pck_data);
-	if (!dst_pck) return NULL;
+	if (ctx->store_pck) gf_filter_pck_unref(ctx->store_pck);
+	else if (ctx->nal_store) gf_free(ctx->nal_store);
+	ctx->store_pck = NULL;
+	ctx->nal_store = NULL;
+	ctx->nal_store_alloc = 0;
+	ctx->store_shared = GF_FALSE;
+}
+
+//move size bytes at offset in the NAL store to the start of a new store of alloc_size bytes
+static GF_Err naludmx_store_realloc(GF_NALUDmxCtx *ctx, u32 offset, u32 size, u32 alloc_size)
+{
+	u8 *data;
+	GF_FilterPacket *store = NULL;
+
+	if (!ctx->opid && !ctx->store_pck) {
+		if (offset) memmove(ctx->nal_store, ctx->nal_store + offset, size);
+		if (ctx->nal_store_alloc < alloc_size) {
+			ctx->nal_store = gf_realloc(ctx->nal_store, alloc_size);
+			if (!ctx->nal_store) {
+				ctx->nal_store_alloc = ctx->nal_store_size = 0;
+				return GF_OUT_OF_MEM;
+			}
+			ctx->nal_store_alloc = alloc_size;
+		}
+		ctx->nal_store_size = size;
+		return GF_OK;
+	}
+	if (ctx->opid) {
+		store = gf_filter_pck_new_alloc(ctx->opid, alloc_size, &data);
+		if (!store) return GF_OUT_OF_MEM;
+		gf_filter_pck_ref(&store);
+	} else {
+		data = gf_malloc(alloc_size);
+		if (!data) return GF_OUT_OF_MEM;
+	}
+	if (size) memcpy(data, ctx->nal_store + offset, size);
+	naludmx_store_release(ctx);
+	ctx->nal_store = data;
+	ctx->nal_store_alloc = alloc_size;
+	ctx->nal_store_size = size;
+	ctx->store_pck = store;
+	return GF_OK;
+}
 
-	if (!skip_nal_field) {
-		if (!ctx->bs_w) ctx->bs_w = gf_bs_new(*pck_data, ctx->nal_length, GF_BITSTREAM_WRITE);
-		else gf_bs_reassign_buffer(ctx->bs_w, *pck_data, ctx->nal_length);
-		gf_bs_write_int(ctx->bs_w, nal_size, 8*ctx->nal_length);
+static GF_Err naludmx_store_append(GF_NALUDmxCtx *ctx, const u8 *data, u32 size)
+{
+	u32 needed = ctx->nal_store_size + size;
+	Bool use_pck = ctx->opid ? GF_TRUE : GF_FALSE;
+	if ((ctx->nal_store_alloc < needed) || ctx->store_shared || (use_pck != (ctx->store_pck ? GF_TRUE : GF_FALSE))) {
+		GF_Err e = naludmx_store_realloc(ctx, 0, ctx->nal_store_size, MAX(needed, ctx->nal_store_alloc));
+		if (e) return e;
 	}
+	memcpy(ctx->nal_store + ctx->nal_store_size, data, size);
+	ctx->nal_store_size += size;
+	return GF_OK;
+}
 
+//keep size bytes at offset in the NAL store for the next call
+static void naludmx_store_shift(GF_NALUDmxCtx *ctx, u32 offset, u32 size)
+{
+	if (!ctx->store_shared) {
+		if (offset) memmove(ctx->nal_store, ctx->nal_store + offset, size);
+		ctx->nal_store_size = size;
+	} else if (!size) {
+		naludmx_store_release(ctx);
+		ctx->nal_store_size = 0;
+	} else if (naludmx_store_realloc(ctx, offset, size, ctx->nal_store_alloc) != GF_OK) {
+		ctx->nal_store_size = 0;
+	}
+}
+
+static void naludmx_write_nal_size(GF_NALUDmxCtx *ctx, u8 *data, u32 nal_size)
+{
+	if (!ctx->bs_w) ctx->bs_w = gf_bs_new(data, ctx->nal_length, GF_BITSTREAM_WRITE);
+	else gf_bs_reassign_buffer(ctx->bs_w, data, ctx->nal_length);
+	gf_bs_write_int(ctx->bs_w, nal_size, 8*ctx->nal_length);
+}
+
+static void naludmx_dispatch_nalu(GF_NALUDmxCtx *ctx, GF_FilterPacket *dst_pck, u32 nal_size, Bool *au_start)
+{
 	if (*au_start) {
 		ctx->first_pck_in_au = dst_pck;
 		if (ctx->src_pck) gf_filter_pck_merge_properties(ctx->src_pck, dst_pck);
@@ -2383,7 +2463,43 @@ GF_FilterPacket *naludmx_start_nalu(GF_NALUDmxCtx *ctx, u32 nal_size, Bool skip_
 	naludmx_update_nalu_maxsize(ctx, nal_size);
 
 	naludmx_enqueue_or_dispatch(ctx, dst_pck, GF_FALSE);
+}
+
+GF_FilterPacket *naludmx_start_nalu(GF_NALUDmxCtx *ctx, u32 nal_size, Bool skip_nal_field, Bool *au_start, u8 **pck_data)
+{
+	GF_FilterPacket *dst_pck = gf_filter_pck_new_alloc(ctx->opid, nal_size + (skip_nal_field ? 0 : ctx->nal_length), pck_data);
+	if (!dst_pck) return NULL;
 
+	if (!skip_nal_field)
+		naludmx_write_nal_size(ctx, *pck_data, nal_size);
+
+	naludmx_dispatch_nalu(ctx, dst_pck, nal_size, au_start);
+	return dst_pck;
+}
+
+//same as naludmx_start_nalu but the NAL payload is referenced in the NAL store, returns NULL if not possible
+static GF_FilterPacket *naludmx_start_nalu_ref(GF_NALUDmxCtx *ctx, u8 *nal_data, u32 nal_size, Bool *au_start)
+{
+	u8 nal_hdr[4];
+	GF_FilterPacket *dst_pck;
+
+	if (!ctx->store_pck || (nal_size < NALU_REF_MIN_SIZE))
+		return NULL;
+	if ((nal_data < ctx->nal_store) || (nal_data + nal_size > ctx->nal_store + ctx->nal_store_size))
+		return NULL;
+
+	dst_pck = gf_filter_pck_new_segmented(ctx->opid);
+	if (!dst_pck) return NULL;
+	naludmx_write_nal_size(ctx, nal_hdr, nal_size);
+	if (gf_filter_pck_append_segment_data(dst_pck, nal_hdr, ctx->nal_length)
+		|| gf_filter_pck_append_segment(dst_pck, ctx->store_pck, (u32) (nal_data - ctx->nal_store), nal_size)
+	) {
+		gf_filter_pck_discard(dst_pck);
+		return NULL;
+	}
+	ctx->store_shared = GF_TRUE;
+
+	naludmx_dispatch_nalu(ctx, dst_pck, nal_size, au_start);
 	return dst_pck;
 }
 
@@ -3147,19 +3263,11 @@ restart:
 	if (!ctx->resume_from && pck) {
 		u32 pck_size;
 		const u8 *data = gf_filter_pck_get_data(pck, &pck_size);
-		if (ctx->nal_store_alloc < ctx->nal_store_size + pck_size) {
-			ctx->nal_store_alloc = ctx->nal_store_size + pck_size;
-			ctx->nal_store = gf_realloc(ctx->nal_store, sizeof(char)*ctx->nal_store_alloc);
-			if (!ctx->nal_store) {
-				ctx->nal_store_alloc = 0;
-				return GF_OUT_OF_MEM;
-			}
-		}
 		byte_offset = gf_filter_pck_get_byte_offset(pck);
 		if (byte_offset != GF_FILTER_NO_BO)
 			byte_offset -= ctx->nal_store_size;
-		memcpy(ctx->nal_store + ctx->nal_store_size, data, sizeof(char)*pck_size);
-		ctx->nal_store_size += pck_size;
+		if (naludmx_store_append(ctx, data, pck_size) != GF_OK)
+			return GF_OUT_OF_MEM;
 		drop_packet = GF_TRUE;
 	}
 	start = ctx->nal_store;
@@ -3209,7 +3317,7 @@ naldmx_flush:
 		u32 is_slice = 0;
 		Bool is_islice = GF_FALSE;
 		u32 field_type = 0;
-		Bool au_start;
+		Bool au_start, nal_ref;
 		u32 avc_svc_subs_reserved = 0;
 		u8 avc_svc_subs_priority = 0;
 		Bool recovery_point_valid = GF_FALSE;
@@ -3895,9 +4003,12 @@ naldmx_flush:
 			ctx->svc_prefix_buffer_size = 0;
 		}
 
-		//nalu size field
-		/*dst_pck = */naludmx_start_nalu(ctx, (u32) nal_size, GF_FALSE, &au_start, &pck_data);
-		pck_data += ctx->nal_length;
+		//nalu size field, payload referenced in the NAL store if possible
+		nal_ref = naludmx_start_nalu_ref(ctx, nal_data, (u32) nal_size, &au_start) ? GF_TRUE : GF_FALSE;
+		if (!nal_ref) {
+			/*dst_pck = */naludmx_start_nalu(ctx, (u32) nal_size, GF_FALSE, &au_start, &pck_data);
+			pck_data += ctx->nal_length;
+		}
 
 		//add subsample info before touching the size
 		if (ctx->subsamples) {
@@ -3906,7 +4017,8 @@ naldmx_flush:
 
 
 		//bytes only come from the data packet
-		memcpy(pck_data, nal_data, (size_t) nal_size);
+		if (!nal_ref)
+			memcpy(pck_data, nal_data, (size_t) nal_size);
 
 		if ((ctx->nb_slices_in_au==1) && ctx->check_prev_sap2) {
 			ctx->prev_sap = ctx->first_pck_in_au;
@@ -3936,10 +4048,9 @@ naldmx_flush:
 			remain = 0;
 		} else {
 			gf_assert((u32) remain<=ctx->nal_store_size);
-			memmove(ctx->nal_store, start, remain);
 		}
 	}
-	ctx->nal_store_size = remain;
+	naludmx_store_shift(ctx, remain ? (u32) (start - ctx->nal_store) : 0, remain);
 
 	if (drop_packet)
 		gf_filter_pid_drop_packet(ctx->ipid);
@@ -4087,7 +4198,7 @@ static void naludmx_finalize(GF_Filter *filter)
 	if (ctx->bs_r) gf_bs_del(ctx->bs_r);
 	if (ctx->bs_w) gf_bs_del(ctx->bs_w);
 	if (ctx->indexes) gf_free(ctx->indexes);
-	if (ctx->nal_store) gf_free(ctx->nal_store);
+	naludmx_store_release(ctx);
 	if (ctx->pck_queue) {
 		while (gf_list_count(ctx->pck_queue)) {
 			GF_FilterPacket *pck = gf_list_pop_back(ctx->pck_queue);
@@ -33,7 +33,7 @@
 typedef struct
 {
 	//opts
-	u32 och, osr, osfmt;
+	u32 och, osr, osfmt, mode, maxlat;
 
 	//internal
 	GF_FilterPid *ipid, *opid;
@@ -55,6 +55,8 @@ typedef struct
 	Fixed speed;
 	GF_FilterPacket *in_pck;
 	Bool cfg_changed;
+	//mixer still has samples to output at end of stream (polyphase filter delay)
+	Bool flush_pending;
 } GF_ResampleCtx;
 
 
@@ -136,6 +138,7 @@ static GF_Err resample_initialize(GF_Filter *filter)
 	GF_ResampleCtx *ctx = gf_filter_get_udta(filter);
 	ctx->mixer = gf_mixer_new(NULL);
 	if (!ctx->mixer) return GF_OUT_OF_MEM;
+	gf_mixer_set_resampler(ctx->mixer, ctx->mode, ctx->maxlat);
 
 	ctx->input_ai.callback = ctx;
 	ctx->input_ai.FetchFrame = resample_fetch_frame;
@@ -279,7 +282,7 @@ static GF_Err resample_process(GF_Filter *filter)
 
 			if (!ctx->in_pck) {
 				if (gf_filter_pid_is_eos(ctx->ipid)) {
-					if (ctx->passthrough || ctx->input_ai.is_eos) {
+					if (ctx->passthrough || (ctx->input_ai.is_eos && !ctx->flush_pending)) {
 						if (ctx->opid)
 							gf_filter_pid_set_eos(ctx->opid);
 						return GF_EOS;
@@ -338,6 +341,7 @@ static GF_Err resample_process(GF_Filter *filter)
 			gf_filter_pck_merge_properties(ctx->in_pck, dstpck);
 
 		written = gf_mixer_get_output(ctx->mixer, output, osize, 0);
+		ctx->flush_pending = (!ctx->in_pck && (written == osize)) ? GF_TRUE : GF_FALSE;
 		if (!written) {
 			gf_filter_pck_discard(dstpck);
 		} else {
@@ -467,6 +471,12 @@ static GF_FilterArgs ResamplerArgs[] =
 	{ OFFS(osr), "desired sample rate of output audio (0 for auto)", GF_PROP_UINT, "0", NULL, 0},
 	{ OFFS(osfmt), "desired sample format of output audio (`none` for auto)", GF_PROP_PCMFMT, "none", NULL, 0},
 	{ OFFS(olayout), "desired CICP layout of output audio (null for auto)", GF_PROP_CICP_LAYOUT, NULL, NULL, 0},
+	{ OFFS(mode), "sample rate conversion mode\n"
+	"- lin: linear interpolation\n"
+	"- low: 16-tap polyphase windowed-sinc filter\n"
+	"- med: 32-tap polyphase windowed-sinc filter\n"
+	"- high: 64-tap polyphase windowed-sinc filter", GF_PROP_UINT, "med", "lin|low|med|high", GF_FS_ARG_HINT_ADVANCED},
+	{ OFFS(maxlat), "maximum delay in milliseconds introduced by polyphase filters, filter length is reduced if needed (0 means no limit)", GF_PROP_UINT, "0", NULL, GF_FS_ARG_HINT_EXPERT},
 	{0}
 };
 
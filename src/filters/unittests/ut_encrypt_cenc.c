@@ -0,0 +1,201 @@
+#include "tests.h"
+#include <gpac/filters.h>
+
+#if !defined(GPAC_DISABLE_CRYPTO) && !defined(GPAC_DISABLE_CECRYPT)
+
+#define UTE_NB_SAMPLES	100
+#define UTE_MAX_SIZE	3000
+//key roll period in samples, not aligned on the worker batch size
+#define UTE_KEY_ROLL	7
+
+static const char *ute_drm =
+	"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+	"<GPACDRM type=\"CENC AES-CTR\">\n"
+	"<CrypTrack IsEncrypted=\"1\" IV_size=\"8\" first_IV=\"0x0a610676cb88f302\" saiSavedBox=\"senc\" keyRoll=\"roll=7\">\n"
+	"<key KID=\"0x279926496a7f5d25da69f2b3b2799a7f\" value=\"0xcc00000000000000000000000000000c\"/>\n"
+	"<key KID=\"0x676cb88f302d10227992649885984045\" value=\"0x6faa6bbc6c4e3db4a7e5d8b15cd4db23\"/>\n"
+	"</CrypTrack>\n"
+	"</GPACDRM>\n";
+
+typedef struct
+{
+	u8 *data;
+	u32 size;
+	bin128 KID;
+} UTESample;
+
+static UTESample ute_src[UTE_NB_SAMPLES];
+static UTESample *ute_dst;
+static u32 ute_nb_recv;
+static GF_FilterPid *ute_opid;
+static Bool ute_playing;
+
+//sends the whole stream in one call so that the encryptor gets several packets per PID
+static GF_Err ute_src_process(GF_Filter *filter)
+{
+	u32 i;
+	if (!ute_opid) {
+		ute_opid = gf_filter_pid_new(filter);
+		if (!ute_opid) return GF_OUT_OF_MEM;
+		gf_filter_pid_set_property(ute_opid, GF_PROP_PID_STREAM_TYPE, &PROP_UINT(GF_STREAM_VISUAL));
+		gf_filter_pid_set_property(ute_opid, GF_PROP_PID_CODECID, &PROP_UINT(GF_4CC('u','t','e','1')));
+		gf_filter_pid_set_property(ute_opid, GF_PROP_PID_TIMESCALE, &PROP_UINT(1000));
+		gf_filter_pid_set_property(ute_opid, GF_PROP_PID_WIDTH, &PROP_UINT(320));
+		gf_filter_pid_set_property(ute_opid, GF_PROP_PID_HEIGHT, &PROP_UINT(240));
+	}
+	//wait for the PID to be connected
+	if (!gf_filter_pid_is_playing(ute_opid)) {
+		gf_filter_ask_rt_reschedule(filter, 1000);
+		return GF_OK;
+	}
+
+	for (i=0; i<UTE_NB_SAMPLES; i++) {
+		u8 *output;
+		GF_FilterPacket *pck = gf_filter_pck_new_alloc(ute_opid, ute_src[i].size, &output);
+		if (!pck) return GF_OUT_OF_MEM;
+		memcpy(output, ute_src[i].data, ute_src[i].size);
+		gf_filter_pck_set_cts(pck, i*40);
+		gf_filter_pck_set_sap(pck, (i%10) ? GF_FILTER_SAP_NONE : GF_FILTER_SAP_1);
+		gf_filter_pck_send(pck);
+	}
+	gf_filter_pid_set_eos(ute_opid);
+	return GF_EOS;
+}
+
+static GF_Err ute_sink_configure(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
+{
+	GF_FilterEvent evt;
+	//reconfigured on key changes
+	if (is_remove || ute_playing) return GF_OK;
+	GF_FEVT_INIT(evt, GF_FEVT_PLAY, pid);
+	gf_filter_pid_send_event(pid, &evt);
+	ute_playing = GF_TRUE;
+	return GF_OK;
+}
+
+//keeps payload and KID signaled on the PID when each packet is received
+static GF_Err ute_sink_process(GF_Filter *filter)
+{
+	GF_FilterPid *pid = gf_filter_get_ipid(filter, 0);
+	while (1) {
+		u32 size;
+		const u8 *data;
+		const GF_PropertyValue *p;
+		GF_FilterPacket *pck = gf_filter_pid_get_packet(pid);
+		if (!pck) {
+			if (gf_filter_pid_is_eos(pid)) return GF_EOS;
+			break;
+		}
+		data = gf_filter_pck_get_data(pck, &size);
+		p = gf_filter_pid_get_property(pid, GF_PROP_PID_CENC_KEY_INFO);
+		if ((ute_nb_recv<UTE_NB_SAMPLES) && data && p && (p->value.data.size>=20)) {
+			UTESample *s = &ute_dst[ute_nb_recv];
+			s->data = gf_malloc(size);
+			memcpy(s->data, data, size);
+			s->size = size;
+			memcpy(s->KID, p->value.data.ptr+4, 16);
+		}
+		ute_nb_recv++;
+		gf_filter_pid_drop_packet(pid);
+	}
+	return GF_OK;
+}
+
+static GF_Err ute_encrypt(const char *drm, u32 nbth, UTESample *dst)
+{
+	GF_Err e;
+	char szArgs[GF_MAX_PATH+50];
+	GF_Filter *f_src, *f_enc, *f_sink;
+	GF_FilterSession *fs = gf_fs_new_defaults(0);
+	if (!fs) return GF_OUT_OF_MEM;
+	ute_opid = NULL;
+	ute_playing = GF_FALSE;
+	ute_dst = dst;
+	ute_nb_recv = 0;
+
+	f_src = gf_fs_new_filter(fs, "ute_src", 0, &e);
+	if (f_src) e = gf_filter_set_process_ckb(f_src, ute_src_process);
+
+	snprintf(szArgs, sizeof(szArgs), "cecrypt:cfile=%s:nbth=%d", drm, nbth);
+	f_enc = !e ? gf_fs_load_filter(fs, szArgs, &e) : NULL;
+	if (f_enc) e = gf_filter_set_source(f_enc, f_src, NULL);
+
+	f_sink = !e ? gf_fs_new_filter(fs, "ute_sink", 0, &e) : NULL;
+	if (f_sink) e = gf_filter_push_caps(f_sink, GF_PROP_PID_STREAM_TYPE, &PROP_UINT(GF_STREAM_ENCRYPTED), NULL, GF_CAPS_INPUT, 0);
+	if (!e && f_sink) e = gf_filter_set_configure_ckb(f_sink, ute_sink_configure);
+	if (!e && f_sink) e = gf_filter_set_process_ckb(f_sink, ute_sink_process);
+	if (!e && f_sink) e = gf_filter_set_source(f_sink, f_enc, NULL);
+
+	if (!e) {
+		gf_filter_post_process_task(f_src);
+		e = gf_fs_run(fs);
+	}
+	if (e>GF_OK) e = GF_OK;
+	if (!e) e = gf_fs_get_last_connect_error(fs);
+	if (!e) e = gf_fs_get_last_process_error(fs);
+	gf_fs_del(fs);
+	if (!e && (ute_nb_recv != UTE_NB_SAMPLES)) e = GF_IO_ERR;
+	return e;
+}
+
+static void ute_reset(UTESample *samples)
+{
+	u32 i;
+	for (i=0; i<UTE_NB_SAMPLES; i++) {
+		if (samples[i].data) gf_free(samples[i].data);
+	}
+	memset(samples, 0, sizeof(UTESample)*UTE_NB_SAMPLES);
+}
+
+unittest(cenc_encrypt_threaded_key_roll)
+{
+	u32 i, j;
+	FILE *f;
+	bin128 kids[2];
+	char szDRM[GF_MAX_PATH];
+	UTESample *ref, *mt;
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	snprintf(szDRM, GF_MAX_PATH, "%s/ut_cenc_drm.xml", gf_get_default_cache_directory());
+	f = gf_fopen(szDRM, "w");
+	assert_not_null(f);
+	if (!f) {
+		gf_sys_close();
+		return;
+	}
+	gf_fputs(ute_drm, f);
+	gf_fclose(f);
+	assert_equal(gf_bin128_parse("0x279926496a7f5d25da69f2b3b2799a7f", kids[0]), GF_OK);
+	assert_equal(gf_bin128_parse("0x676cb88f302d10227992649885984045", kids[1]), GF_OK);
+
+	for (i=0; i<UTE_NB_SAMPLES; i++) {
+		ute_src[i].size = 1 + gf_rand() % UTE_MAX_SIZE;
+		ute_src[i].data = gf_malloc(ute_src[i].size);
+		for (j=0; j<ute_src[i].size; j++) ute_src[i].data[j] = gf_rand();
+	}
+	GF_SAFE_ALLOC_N(ref, UTE_NB_SAMPLES, UTESample);
+	GF_SAFE_ALLOC_N(mt, UTE_NB_SAMPLES, UTESample);
+
+	assert_equal(ute_encrypt(szDRM, 0, ref), GF_OK);
+	//key changes while packets are pending in the worker batch must not change the key info of these packets
+	assert_equal(ute_encrypt(szDRM, 3, mt), GF_OK);
+
+	for (i=0; i<UTE_NB_SAMPLES; i++) {
+		assert_equal(ref[i].size, ute_src[i].size);
+		assert_equal_mem(ref[i].KID, kids[(i / UTE_KEY_ROLL) % 2], 16);
+		assert_equal_mem(mt[i].KID, ref[i].KID, 16);
+		assert_equal(mt[i].size, ref[i].size);
+		if (mt[i].data && ref[i].data && (mt[i].size==ref[i].size))
+			assert_equal_mem(mt[i].data, ref[i].data, ref[i].size);
+	}
+
+	ute_reset(ref);
+	ute_reset(mt);
+	ute_reset(ute_src);
+	gf_free(ref);
+	gf_free(mt);
+	gf_file_delete(szDRM);
+	gf_sys_close();
+}
+
+#endif
@@ -0,0 +1,102 @@
+#include "tests.h"
+#include "../evg_rescale.c"
+
+#ifndef GPAC_DISABLE_EVG
+
+//not exported by libgpac and not used by the separable scaler
+u32 gf_evg_stencil_get_pixel_fast(GF_EVGStencil *st, s32 x, s32 y) { return 0; }
+u64 gf_evg_stencil_get_pixel_wide_fast(GF_EVGStencil *st, s32 x, s32 y) { return 0; }
+
+//source and destination sizes, covering upscale, downscale, SIMD tails and windows clamped to the source
+static const u32 ute_sizes[][2] = {
+	{1920, 1280}, {1280, 1920}, {640, 333}, {333, 640}, {77, 31}, {31, 77}, {16, 8}, {5, 11}, {3, 2}
+};
+
+static void ute_hscale_ref(const u8 *src, Bool is_10bit, s32 *dst, u32 dst_w, EVGSFilter *f, u32 shift)
+{
+	u32 i, k;
+	for (i=0; i<dst_w; i++) {
+		s32 acc = 0;
+		for (k=0; k<f->taps; k++) {
+			s32 s = is_10bit ? ((const u16 *) src)[f->pos[i]+k] : src[f->pos[i]+k];
+			acc += s * f->coefs[i*f->taps + k];
+		}
+		dst[i] = (acc + (1 << (shift-1))) >> shift;
+	}
+}
+
+static u32 ute_vscale_ref(const s16 *tmp, u32 width, u32 i, const s16 *c, u32 taps, Bool is_10bit, u32 shift)
+{
+	u32 k;
+	s32 acc = 1 << (shift-1);
+	for (k=0; k<taps; k++) acc += tmp[k*width + i] * c[k];
+	acc >>= shift;
+	if (acc < 0) return 0;
+	if (acc > (is_10bit ? 1023 : 255)) return is_10bit ? 1023 : 255;
+	return acc;
+}
+
+unittest(evg_rescale_simd_exact)
+{
+	u32 n, algo, bits, i, j;
+	gf_sys_init(GF_MemTrackerNone, NULL);
+
+	for (n=0; n<GF_ARRAY_LENGTH(ute_sizes); n++) {
+	for (algo=EVGS_ALGO_BICUBIC; algo<=EVGS_ALGO_LANCZOS; algo++) {
+	for (bits=8; bits<=10; bits+=2) {
+		EVGSFilter fh, fv;
+		Bool is_10bit = (bits>8) ? GF_TRUE : GF_FALSE;
+		u32 src_w = ute_sizes[n][0], dst_w = ute_sizes[n][1];
+		u32 h_shift = EVGS_COEF_BITS - (is_10bit ? 4 : 6);
+		u32 v_shift = EVGS_COEF_BITS + (is_10bit ? 4 : 6);
+		u8 *src = gf_malloc(2*src_w);
+		s16 *out_simd = gf_malloc(sizeof(s16)*dst_w);
+		s16 *out_c = gf_malloc(sizeof(s16)*dst_w);
+		s32 *out_ref = gf_malloc(sizeof(s32)*dst_w);
+		s16 *rows;
+		u8 *dst;
+
+		for (i=0; i<src_w; i++) {
+			if (is_10bit) ((u16 *) src)[i] = gf_rand() & 0x3FF;
+			else src[i] = gf_rand() & 0xFF;
+		}
+		//horizontal pass, with and without SIMD
+		memset(&fh, 0, sizeof(EVGSFilter));
+		assert_equal(evgs_filter_setup(&fh, algo, src_w, dst_w, 8), GF_OK);
+		evgs_hscale(src, is_10bit, out_simd, dst_w, &fh, h_shift);
+		fh.simd = GF_FALSE;
+		evgs_hscale(src, is_10bit, out_c, dst_w, &fh, h_shift);
+		ute_hscale_ref(src, is_10bit, out_ref, dst_w, &fh, h_shift);
+		assert_equal_mem(out_simd, out_c, sizeof(s16)*dst_w);
+		for (i=0; i<dst_w; i++) assert_equal(out_c[i], out_ref[i]);
+
+		//vertical pass, rows of intermediate values including ringing below 0 and above max
+		memset(&fv, 0, sizeof(EVGSFilter));
+		assert_equal(evgs_filter_setup(&fv, algo, src_w, dst_w, 1), GF_OK);
+		rows = gf_malloc(sizeof(s16) * fv.taps * dst_w);
+		dst = gf_malloc(2*dst_w);
+		for (i=0; i<fv.taps*dst_w; i++)
+			rows[i] = (s16) ((s32) (gf_rand() % 20000) - 2000);
+		for (j=0; j<dst_w; j++) {
+			const s16 *c = fv.coefs + j*fv.taps;
+			evgs_vscale(rows, dst_w, c, fv.taps, dst, is_10bit, v_shift);
+			for (i=0; i<dst_w; i++) {
+				u32 v = is_10bit ? ((u16 *) dst)[i] : dst[i];
+				assert_equal(v, ute_vscale_ref(rows, dst_w, i, c, fv.taps, is_10bit, v_shift));
+			}
+		}
+		evgs_filter_reset(&fh);
+		evgs_filter_reset(&fv);
+		gf_free(src);
+		gf_free(out_simd);
+		gf_free(out_c);
+		gf_free(out_ref);
+		gf_free(rows);
+		gf_free(dst);
+	}
+	}
+	}
+	gf_sys_close();
+}
+
+#endif //GPAC_DISABLE_EVG
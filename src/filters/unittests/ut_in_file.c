@@ -0,0 +1,188 @@
+#include "tests.h"
+#include "../in_file.c"
+
+#if !defined(GPAC_DISABLE_FIN) && defined(GPAC_HAS_FD) && !defined(WIN32)
+
+#define UTI_BLOCK	4096
+#define UTI_NB_BLOCKS	64
+#define UTI_NBRA	4
+//first seek once the window is fully open, inside the block of the packet being processed
+#define UTI_SEEK_BLOCK	16
+//second seek back to the start of the file, whose blocks were reused since
+#define UTI_SEEK_BACK	100
+
+enum
+{
+	UTI_SEQ = 0,
+	UTI_SEEK_HIT,
+	UTI_SEEK_MISS,
+	UTI_DONE
+};
+
+static u8 *uti_data;
+static GF_Filter *uti_fin;
+static GF_FilterPacket *uti_held;
+static u32 uti_state;
+static u64 uti_target, uti_last_end;
+static Bool uti_playing, uti_data_ok, uti_eos;
+static const u8 *uti_block_ptrs[UTI_NB_BLOCKS];
+static u32 uti_nb_block_ptrs;
+
+static GF_Err uti_sink_configure(GF_Filter *filter, GF_FilterPid *pid, Bool is_remove)
+{
+	GF_FilterEvent evt;
+	if (is_remove || uti_playing) return GF_OK;
+	GF_FEVT_INIT(evt, GF_FEVT_PLAY, pid);
+	gf_filter_pid_send_event(pid, &evt);
+	uti_playing = GF_TRUE;
+	return GF_OK;
+}
+
+static void uti_seek(GF_FilterPid *pid, u64 offset)
+{
+	GF_FilterEvent evt;
+	GF_FEVT_INIT(evt, GF_FEVT_SOURCE_SEEK, pid);
+	evt.seek.start_offset = offset;
+	gf_filter_pid_send_event(pid, &evt);
+	uti_target = offset;
+}
+
+static GF_Err uti_sink_process(GF_Filter *filter)
+{
+	GF_FilterPid *pid = gf_filter_get_ipid(filter, 0);
+	GF_FileInCtx *ctx = gf_filter_get_udta(uti_fin);
+	while (1) {
+		u32 i, size;
+		u64 offset;
+		const u8 *data;
+		GF_FilterPacket *pck = gf_filter_pid_get_packet(pid);
+		if (!pck) {
+			if (gf_filter_pid_is_eos(pid)) {
+				//window grows back after the sparse seek
+				assert_equal(ctx->ra_win, UTI_NBRA);
+				uti_eos = GF_TRUE;
+				return GF_EOS;
+			}
+			break;
+		}
+		data = gf_filter_pck_get_data(pck, &size);
+		offset = gf_filter_pck_get_byte_offset(pck);
+		if (!data || (offset + size > UTI_BLOCK*UTI_NB_BLOCKS) || memcmp(data, uti_data + offset, size))
+			uti_data_ok = GF_FALSE;
+		uti_last_end = offset + size;
+		//count the distinct read-ahead buffers used
+		for (i=0; i<ctx->nb_blocks; i++) {
+			u32 j;
+			FileInBlock *b = &ctx->blocks[i];
+			if (!b->data || (data < b->data) || (data >= b->data + b->alloc_size)) continue;
+			for (j=0; j<uti_nb_block_ptrs; j++) {
+				if (uti_block_ptrs[j]==b->data) break;
+			}
+			if ((j==uti_nb_block_ptrs) && (j<UTI_NB_BLOCKS)) uti_block_ptrs[uti_nb_block_ptrs++] = b->data;
+			break;
+		}
+
+		switch (uti_state) {
+		case UTI_SEQ:
+			if (offset < UTI_SEEK_BLOCK*UTI_BLOCK) break;
+			//window doubled by each block consumed in sequence, up to nbra
+			assert_equal(ctx->ra_win, UTI_NBRA);
+			assert_equal(ctx->nb_seeks, 0);
+			//keep the block in use so that it cannot be reused before the seek
+			uti_held = pck;
+			gf_filter_pck_ref(&uti_held);
+			uti_seek(pid, offset + 100);
+			uti_state = UTI_SEEK_HIT;
+			break;
+		case UTI_SEEK_HIT:
+			//packets sent before the seek was processed are still received
+			if (offset != uti_target) break;
+			assert_equal(ctx->nb_seeks, 1);
+			assert_equal(ctx->nb_seek_hits, 1);
+			assert_equal(ctx->ra_win, UTI_NBRA);
+			gf_filter_pck_unref(uti_held);
+			uti_held = NULL;
+			uti_seek(pid, UTI_SEEK_BACK);
+			uti_state = UTI_SEEK_MISS;
+			break;
+		case UTI_SEEK_MISS:
+			if (offset != uti_target) break;
+			assert_equal(ctx->nb_seeks, 2);
+			assert_equal(ctx->nb_seek_hits, 1);
+			//restarted with a single block, doubled by the dispatch of this packet
+			assert_true(ctx->ra_win <= 2);
+			uti_state = UTI_DONE;
+			break;
+		}
+		gf_filter_pid_drop_packet(pid);
+	}
+	return GF_OK;
+}
+
+static void uti_read(const char *name, const char *async)
+{
+	GF_Err e;
+	GF_Filter *f_sink;
+	char szArgs[GF_MAX_PATH+100];
+	GF_FilterSession *fs = gf_fs_new_defaults(0);
+	assert_not_null(fs);
+	if (!fs) return;
+	uti_state = UTI_SEQ;
+	uti_playing = GF_FALSE;
+	uti_data_ok = GF_TRUE;
+	uti_eos = GF_FALSE;
+	uti_held = NULL;
+	uti_last_end = 0;
+	uti_nb_block_ptrs = 0;
+
+	snprintf(szArgs, sizeof(szArgs), "fin:src=%s:async=%s:block_size=%d:nbra=%d", name, async, UTI_BLOCK, UTI_NBRA);
+	uti_fin = gf_fs_load_filter(fs, szArgs, &e);
+	f_sink = uti_fin ? gf_fs_new_filter(fs, "uti_sink", 0, &e) : NULL;
+	if (f_sink) e = gf_filter_push_caps(f_sink, GF_PROP_PID_STREAM_TYPE, &PROP_UINT(GF_STREAM_FILE), NULL, GF_CAPS_INPUT, 0);
+	if (!e && f_sink) e = gf_filter_set_configure_ckb(f_sink, uti_sink_configure);
+	if (!e && f_sink) e = gf_filter_set_process_ckb(f_sink, uti_sink_process);
+	if (!e && f_sink) e = gf_filter_set_source(f_sink, uti_fin, NULL);
+	assert_equal(e, GF_OK);
+	if (!e) {
+		e = gf_fs_run(fs);
+		if (e>GF_OK) e = GF_OK;
+		assert_equal(e, GF_OK);
+		assert_equal(gf_fs_get_last_connect_error(fs), GF_OK);
+		assert_equal(gf_fs_get_last_process_error(fs), GF_OK);
+	}
+	if (uti_held) gf_filter_pck_unref(uti_held);
+	gf_fs_del(fs);
+
+	assert_true(uti_eos);
+	assert_equal(uti_state, UTI_DONE);
+	assert_true(uti_data_ok);
+	assert_equal(uti_last_end, UTI_BLOCK*UTI_NB_BLOCKS);
+	//the whole file went through a few read-ahead buffers
+	assert_greater(uti_nb_block_ptrs, 1);
+	assert_true(uti_nb_block_ptrs <= UTI_NBRA+2);
+}
+
+unittest(fin_read_ahead)
+{
+	u32 i;
+	FILE *f;
+	char szName[GF_MAX_PATH];
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	uti_data = gf_malloc(UTI_BLOCK*UTI_NB_BLOCKS);
+	for (i=0; i<UTI_BLOCK*UTI_NB_BLOCKS; i++) uti_data[i] = gf_rand();
+	snprintf(szName, GF_MAX_PATH, "%s/ut_fin_ra.bin", gf_get_default_cache_directory());
+	f = gf_fopen(szName, "wb");
+	assert_not_null(f);
+	if (f) {
+		gf_fwrite(uti_data, UTI_BLOCK*UTI_NB_BLOCKS, f);
+		gf_fclose(f);
+		uti_read(szName, "thread");
+		uti_read(szName, "uring");
+		gf_file_delete(szName);
+	}
+	gf_free(uti_data);
+	gf_sys_close();
+}
+
+#endif
@@ -0,0 +1,115 @@
+#include "tests.h"
+#include <gpac/filters.h>
+
+#if defined(GPAC_HAS_FD) && !defined(WIN32)
+
+#define UTO_NB_PCK	60
+//packets above 64k are written from the packet memory, smaller ones through staging buffers
+#define UTO_MAX_SIZE	200000
+
+static u8 *uto_data;
+static u32 uto_sizes[UTO_NB_PCK];
+static GF_FilterPid *uto_opid;
+
+static GF_Err uto_src_process(GF_Filter *filter)
+{
+	u32 i, pos=0;
+	if (!uto_opid) {
+		uto_opid = gf_filter_pid_new(filter);
+		if (!uto_opid) return GF_OUT_OF_MEM;
+		gf_filter_pid_set_property(uto_opid, GF_PROP_PID_STREAM_TYPE, &PROP_UINT(GF_STREAM_FILE));
+		gf_filter_pid_set_property(uto_opid, GF_PROP_PID_FILE_EXT, &PROP_STRING("bin"));
+	}
+	//wait for the PID to be connected
+	if (!gf_filter_pid_is_playing(uto_opid)) {
+		gf_filter_ask_rt_reschedule(filter, 1000);
+		return GF_OK;
+	}
+
+	for (i=0; i<UTO_NB_PCK; i++) {
+		u8 *output;
+		GF_FilterPacket *pck = gf_filter_pck_new_alloc(uto_opid, uto_sizes[i], &output);
+		if (!pck) return GF_OUT_OF_MEM;
+		memcpy(output, uto_data + pos, uto_sizes[i]);
+		pos += uto_sizes[i];
+		gf_filter_pck_set_framing(pck, i ? GF_FALSE : GF_TRUE, (i+1<UTO_NB_PCK) ? GF_FALSE : GF_TRUE);
+		gf_filter_pck_send(pck);
+	}
+	gf_filter_pid_set_eos(uto_opid);
+	return GF_EOS;
+}
+
+static GF_Err uto_write(const char *dst, const char *opts)
+{
+	GF_Err e;
+	char szArgs[GF_MAX_PATH+100];
+	GF_Filter *f_src, *f_out;
+	GF_FilterSession *fs = gf_fs_new_defaults(0);
+	if (!fs) return GF_OUT_OF_MEM;
+	uto_opid = NULL;
+
+	f_src = gf_fs_new_filter(fs, "uto_src", 0, &e);
+	if (f_src) e = gf_filter_set_process_ckb(f_src, uto_src_process);
+
+	snprintf(szArgs, sizeof(szArgs), "fout:dst=%s%s", dst, opts);
+	f_out = !e ? gf_fs_load_filter(fs, szArgs, &e) : NULL;
+	if (f_out) e = gf_filter_set_source(f_out, f_src, NULL);
+
+	if (!e) {
+		gf_filter_post_process_task(f_src);
+		e = gf_fs_run(fs);
+	}
+	if (e>GF_OK) e = GF_OK;
+	if (!e) e = gf_fs_get_last_connect_error(fs);
+	if (!e) e = gf_fs_get_last_process_error(fs);
+	gf_fs_del(fs);
+	return e;
+}
+
+static Bool uto_same_file(const char *name, const u8 *ref, u64 size)
+{
+	u8 *data;
+	u32 data_size;
+	Bool same = GF_FALSE;
+	if (gf_file_load_data(name, &data, &data_size) != GF_OK) return GF_FALSE;
+	if ((data_size==size) && !memcmp(data, ref, data_size)) same = GF_TRUE;
+	gf_free(data);
+	return same;
+}
+
+unittest(fout_async_exact)
+{
+	u32 i, j;
+	u64 total=0;
+	char szSync[GF_MAX_PATH], szAsync[GF_MAX_PATH];
+	//background writes through the I/O thread and io_uring, with several staging buffer sizes and direct I/O
+	static const char *opts[] = {
+		":async=thread", ":async=uring", ":async=thread:dbuf=4096", ":async=uring:dbuf=20000",
+		":async=thread:direct", ":async=uring:direct:dbuf=8192", ":async=thread:fsync:maxaio=100000"
+	};
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	for (i=0; i<UTO_NB_PCK; i++) {
+		uto_sizes[i] = 1 + gf_rand() % ((i%3) ? 5000 : UTO_MAX_SIZE);
+		total += uto_sizes[i];
+	}
+	uto_data = gf_malloc((size_t) total);
+	for (i=0; i<total; i++) uto_data[i] = gf_rand();
+
+	snprintf(szSync, GF_MAX_PATH, "%s/ut_fout_sync.bin", gf_get_default_cache_directory());
+	snprintf(szAsync, GF_MAX_PATH, "%s/ut_fout_async.bin", gf_get_default_cache_directory());
+	assert_equal(uto_write(szSync, ""), GF_OK);
+	assert_true(uto_same_file(szSync, uto_data, total));
+
+	for (j=0; j<GF_ARRAY_LENGTH(opts); j++) {
+		assert_equal(uto_write(szAsync, opts[j]), GF_OK);
+		assert_true(uto_same_file(szAsync, uto_data, total));
+		gf_file_delete(szAsync);
+	}
+
+	gf_file_delete(szSync);
+	gf_free(uto_data);
+	gf_sys_close();
+}
+
+#endif //GPAC_HAS_FD && !WIN32
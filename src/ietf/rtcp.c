@@ -463,6 +463,9 @@ GF_Err gf_rtp_send_bye(GF_RTPChannel *ch)
 	u8 *report_buf;
 	GF_Err e = GF_OK;
 
+	//send pending RTP packets before leaving
+	gf_rtp_flush_send_batch(ch);
+
 	bs = gf_bs_new(NULL, 0, GF_BITSTREAM_WRITE);
 
 	/*k were received/sent send the RR/SR - note we don't wait for next Repor and force its emission now*/
@@ -557,6 +560,24 @@ GF_Err gf_rtp_send_rtcp_report(GF_RTPChannel *ch)
 	return e;
 }
 
+GF_EXPORT
+GF_Err gf_rtp_send_rtcp_sr(GF_RTPChannel *ch, u32 rtp_ts, u32 ntp_sec, u32 ntp_frac)
+{
+	GF_Err e;
+	if (!ch || !ntp_sec) return GF_BAD_PARAM;
+	//the report time becomes the reference for RTP time extrapolation
+	ch->last_pck_ts = rtp_ts;
+	ch->last_pck_ntp_sec = ntp_sec;
+	ch->last_pck_ntp_frac = ntp_frac;
+	ch->forced_ntp_sec = ntp_sec;
+	ch->forced_ntp_frac = ntp_frac;
+	ch->next_report_time = 0;
+	e = gf_rtp_send_rtcp_report(ch);
+	ch->forced_ntp_sec = 0;
+	ch->forced_ntp_frac = 0;
+	return e;
+}
+
 #if 0 //unused
 
 enum
@@ -62,6 +62,12 @@ void gf_rtp_del(GF_RTPChannel *ch)
 	if (ch->net_info.Profile) gf_free(ch->net_info.Profile);
 	if (ch->po) gf_rtp_reorderer_del(ch->po);
 	if (ch->send_buffer) gf_free(ch->send_buffer);
+	if (ch->batch_buf) gf_free(ch->batch_buf);
+	if (ch->batch_ptrs) gf_free((void *) ch->batch_ptrs);
+	if (ch->batch_sizes) gf_free(ch->batch_sizes);
+	if (ch->rx_buf) gf_free(ch->rx_buf);
+	if (ch->rx_sizes) gf_free(ch->rx_sizes);
+	if (ch->rx_ntps) gf_free(ch->rx_ntps);
 
 	if (ch->CName) gf_free(ch->CName);
 	if (ch->s_name) gf_free(ch->s_name);
@@ -342,7 +348,13 @@ GF_Err gf_rtp_initialize(GF_RTPChannel *ch, u32 UDPBufferSize, Bool IsSource, u3
 u32 gf_rtp_channel_time(GF_RTPChannel *ch)
 {
 	u32 sec, frac, res;
-	gf_net_get_ntp(&sec, &frac);
+	//use kernel reception time of the packet if known
+	if (ch->rx_ntp) {
+		sec = (u32) (ch->rx_ntp >> 32);
+		frac = (u32) (ch->rx_ntp & 0xFFFFFFFFUL);
+	} else {
+		gf_net_get_ntp(&sec, &frac);
+	}
 	res = ( (u32) ( (frac>>26)*ch->TimeScale) ) >> 6;
 	res += ch->TimeScale*(sec - ch->ntp_init);
 	return (u32) res;
@@ -413,7 +425,24 @@ u32 gf_rtp_read_rtp(GF_RTPChannel *ch, u8 *buffer, u32 buffer_size)
 	//only if the socket exist (otherwise RTSP interleaved channel)
 	if (!ch || !ch->rtp) return 0;
 
-	if (ch->no_select) {
+	ch->rx_ntp = 0;
+	if (ch->rx_max) {
+		res = 0;
+		e = GF_OK;
+		//fetch all pending datagrams
+		if (ch->rx_idx == ch->rx_nb) {
+			ch->rx_idx = ch->rx_nb = 0;
+			if (ch->no_select || (gf_sk_receive(ch->rtp, NULL, 0, NULL)==GF_OK))
+				e = gf_sk_receive_batch(ch->rtp, ch->rx_buf, GF_SK_BATCH_SLOT_SIZE, ch->rx_max, ch->rx_sizes, ch->rx_ntps, &ch->rx_nb);
+		}
+		if (ch->rx_idx < ch->rx_nb) {
+			res = ch->rx_sizes[ch->rx_idx];
+			if (res > buffer_size) res = buffer_size;
+			memcpy(buffer, ch->rx_buf + ch->rx_idx * GF_SK_BATCH_SLOT_SIZE, res);
+			ch->rx_ntp = ch->rx_ntps[ch->rx_idx];
+			ch->rx_idx++;
+		}
+	} else if (ch->no_select) {
 		e = gf_sk_receive_no_select(ch->rtp, buffer, buffer_size, &res);
 	} else {
 		e = gf_sk_receive(ch->rtp, buffer, buffer_size, &res);
@@ -652,12 +681,77 @@ Double gf_rtp_get_current_time(GF_RTPChannel *ch)
 
 
 
+GF_EXPORT
+GF_Err gf_rtp_set_recv_batch(GF_RTPChannel *ch, u32 nb_packets)
+{
+	if (!ch) return GF_BAD_PARAM;
+	if (nb_packets<2) nb_packets = 0;
+	if (ch->rx_max == nb_packets) return GF_OK;
+	//pending packets are lost
+	ch->rx_idx = ch->rx_nb = 0;
+	ch->rx_max = 0;
+	if (!nb_packets) return GF_OK;
+
+	ch->rx_buf = gf_realloc(ch->rx_buf, nb_packets * GF_SK_BATCH_SLOT_SIZE);
+	ch->rx_sizes = gf_realloc(ch->rx_sizes, nb_packets * sizeof(u32));
+	ch->rx_ntps = gf_realloc(ch->rx_ntps, nb_packets * sizeof(u64));
+	if (!ch->rx_buf || !ch->rx_sizes || !ch->rx_ntps) return GF_OUT_OF_MEM;
+	ch->rx_max = nb_packets;
+	return GF_OK;
+}
+
+GF_EXPORT
+u32 gf_rtp_read_pending(GF_RTPChannel *ch)
+{
+	if (!ch) return 0;
+	return ch->rx_nb - ch->rx_idx;
+}
+
+GF_EXPORT
+GF_Err gf_rtp_set_send_batch(GF_RTPChannel *ch, u32 nb_packets)
+{
+	GF_Err e;
+	if (!ch) return GF_BAD_PARAM;
+	e = gf_rtp_flush_send_batch(ch);
+	ch->batch_max = (nb_packets>1) ? nb_packets : 0;
+	//slots are (re)allocated at next send
+	ch->batch_slot_size = 0;
+	return e;
+}
+
+GF_EXPORT
+GF_Err gf_rtp_flush_send_batch(GF_RTPChannel *ch)
+{
+	GF_Err e;
+	if (!ch || !ch->nb_batch) return GF_OK;
+	e = gf_sk_send_batch(ch->rtp, ch->batch_ptrs, ch->batch_sizes, ch->nb_batch, NULL);
+	ch->nb_batch = 0;
+	return e;
+}
+
+static u8 *gf_rtp_get_batch_slot(GF_RTPChannel *ch)
+{
+	if (ch->batch_slot_size != ch->send_buffer_size) {
+		gf_rtp_flush_send_batch(ch);
+		ch->batch_buf = gf_realloc(ch->batch_buf, ch->batch_max * ch->send_buffer_size);
+		ch->batch_ptrs = gf_realloc((void *) ch->batch_ptrs, ch->batch_max * sizeof(u8 *));
+		ch->batch_sizes = gf_realloc(ch->batch_sizes, ch->batch_max * sizeof(u32));
+		if (!ch->batch_buf || !ch->batch_ptrs || !ch->batch_sizes) {
+			ch->batch_max = 0;
+			return NULL;
+		}
+		ch->batch_slot_size = ch->send_buffer_size;
+	}
+	return ch->batch_buf + ch->nb_batch * ch->batch_slot_size;
+}
+
 GF_EXPORT
 GF_Err gf_rtp_send_packet(GF_RTPChannel *ch, GF_RTPHeader *rtp_hdr, u8 *pck, u32 pck_size, Bool fast_send)
 {
 	GF_Err e;
 	u32 i, Start;
 	char *hdr = NULL;
+	u8 *slot = NULL;
 
 	if (!ch || !rtp_hdr
 	        || !ch->send_buffer
@@ -669,7 +763,13 @@ GF_Err gf_rtp_send_packet(GF_RTPChannel *ch, GF_RTPHeader *rtp_hdr, u8 *pck, u32
 	if (12 + pck_size + 4*rtp_hdr->CSRCCount > ch->send_buffer_size)
 		return GF_IO_ERR;
 
-	if (fast_send) {
+	//batched send, format packet in next slot
+	if (ch->batch_max && !ch->send_interleave && ch->rtp)
+		slot = gf_rtp_get_batch_slot(ch);
+
+	if (slot) {
+		gf_bs_reassign_buffer(ch->bs_w, slot, ch->batch_slot_size);
+	} else if (fast_send) {
 		hdr = pck - 12;
 		gf_bs_reassign_buffer(ch->bs_w, hdr, 12);
 	} else {
@@ -700,6 +800,15 @@ GF_Err gf_rtp_send_packet(GF_RTPChannel *ch, GF_RTPHeader *rtp_hdr, u8 *pck, u32
 			e = ch->send_interleave(ch->interleave_cbk1, ch->interleave_cbk2, GF_FALSE, ch->send_buffer, Start + pck_size);
 		}
 	}
+	else if (slot) {
+		memcpy(slot + Start, pck, pck_size);
+		ch->batch_ptrs[ch->nb_batch] = slot;
+		ch->batch_sizes[ch->nb_batch] = Start + pck_size;
+		ch->nb_batch++;
+		e = GF_OK;
+		if (ch->nb_batch == ch->batch_max)
+			e = gf_rtp_flush_send_batch(ch);
+	}
 	//copy payload
 	else if (fast_send) {
 		e = gf_sk_send(ch->rtp, hdr, pck_size+12);
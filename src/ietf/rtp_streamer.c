@@ -52,6 +52,9 @@ struct __rtp_streamer
 
 	const char *netcap_id;
 	GF_Err last_err;
+
+	gf_rtp_packet_callback on_packet;
+	void *on_packet_udta;
 };
 
 
@@ -64,7 +67,13 @@ static void rtp_stream_on_new_packet(void *cbk, GF_RTPHeader *header)
 static void rtp_stream_on_packet_done(void *cbk, GF_RTPHeader *header)
 {
 	GF_RTPStreamer *rtp = (GF_RTPStreamer*)cbk;
-	GF_Err e = gf_rtp_send_packet(rtp->channel, header, rtp->buffer+12, rtp->payload_len, GF_TRUE);
+	GF_Err e = GF_OK;
+	//forward before sending, the header area of the buffer is overwritten by the send
+	if (rtp->on_packet && rtp->on_packet(rtp->on_packet_udta, header, rtp->buffer+12, rtp->payload_len)) {
+		rtp->payload_len = 0;
+		return;
+	}
+	e = gf_rtp_send_packet(rtp->channel, header, rtp->buffer+12, rtp->payload_len, GF_TRUE);
 
 #ifndef GPAC_DISABLE_LOG
 	if (e) {
@@ -101,28 +110,51 @@ static void rtp_stream_on_data(void *cbk, u8 *data, u32 data_size, Bool is_head)
 }
 
 
-GF_Err gf_rtp_streamer_init_rtsp(GF_RTPStreamer *rtp, u32 path_mtu, GF_RTSPTransport *tr, const char *ifce_addr)
+static GF_Err rtp_stream_setup_rtsp_channel(GF_RTPChannel *ch, u32 path_mtu, GF_RTSPTransport *tr, const char *ifce_addr)
 {
-	GF_Err res;
-
-	if (!rtp->channel) {
-		rtp->channel = gf_rtp_new_ex(rtp->netcap_id);
-		if (!rtp->channel) return GF_OUT_OF_MEM;
-		rtp->channel->TimeScale = rtp->packetizer->sl_config.timestampResolution;
-	}
-	res = gf_rtp_setup_transport(rtp->channel, tr, tr->destination);
+	GF_Err res = gf_rtp_setup_transport(ch, tr, tr->destination);
 	if (res !=0) {
 		GF_LOG(GF_LOG_ERROR, GF_LOG_RTP, ("Cannot setup RTP transport info: %s\n", gf_error_to_string(res) ));
 		return res;
 	}
 
-	res = gf_rtp_initialize(rtp->channel, 0, GF_TRUE, path_mtu, 0, 0, (char *)ifce_addr);
+	res = gf_rtp_initialize(ch, 0, GF_TRUE, path_mtu, 0, 0, (char *)ifce_addr);
 	if (res !=0) {
 		GF_LOG(GF_LOG_ERROR, GF_LOG_RTP, ("Cannot initialize RTP sockets: %s\n", gf_error_to_string(res) ));
 		return res;
 	}
 	return GF_OK;
 }
+
+GF_Err gf_rtp_streamer_init_rtsp(GF_RTPStreamer *rtp, u32 path_mtu, GF_RTSPTransport *tr, const char *ifce_addr)
+{
+	if (!rtp->channel) {
+		rtp->channel = gf_rtp_new_ex(rtp->netcap_id);
+		if (!rtp->channel) return GF_OUT_OF_MEM;
+		rtp->channel->TimeScale = rtp->packetizer->sl_config.timestampResolution;
+	}
+	return rtp_stream_setup_rtsp_channel(rtp->channel, path_mtu, tr, ifce_addr);
+}
+
+GF_EXPORT
+GF_RTPChannel *gf_rtp_streamer_new_channel(GF_RTPStreamer *rtp, u32 path_mtu, GF_RTSPTransport *tr, const char *ifce_addr, GF_Err *e)
+{
+	GF_Err res;
+	GF_RTPChannel *ch = gf_rtp_new_ex(rtp->netcap_id);
+	if (!ch) {
+		if (e) *e = GF_OUT_OF_MEM;
+		return NULL;
+	}
+	ch->TimeScale = rtp->packetizer->sl_config.timestampResolution;
+	res = rtp_stream_setup_rtsp_channel(ch, path_mtu, tr, ifce_addr);
+	if (e) *e = res;
+	if (res) {
+		gf_rtp_del(ch);
+		return NULL;
+	}
+	return ch;
+}
+
 static GF_Err rtp_stream_init_channel(GF_RTPStreamer *rtp, u32 path_mtu, const char * dest, int port, int ttl, const char *ifce_addr, const char *netcap_id)
 {
 	GF_RTSPTransport tr;
@@ -879,6 +911,30 @@ void gf_rtp_streamer_disable_auto_rtcp(GF_RTPStreamer *streamer)
 	streamer->channel->no_auto_rtcp = GF_TRUE;
 }
 
+GF_EXPORT
+GF_Err gf_rtp_streamer_set_send_batch(GF_RTPStreamer *streamer, u32 nb_packets)
+{
+	if (!streamer || !streamer->channel) return GF_BAD_PARAM;
+	return gf_rtp_set_send_batch(streamer->channel, nb_packets);
+}
+
+GF_EXPORT
+GF_Err gf_rtp_streamer_flush(GF_RTPStreamer *streamer)
+{
+	if (streamer && streamer->on_packet)
+		streamer->on_packet(streamer->on_packet_udta, NULL, NULL, 0);
+	if (!streamer || !streamer->channel) return GF_OK;
+	return gf_rtp_flush_send_batch(streamer->channel);
+}
+
+GF_EXPORT
+void gf_rtp_streamer_set_packet_callback(GF_RTPStreamer *streamer, gf_rtp_packet_callback on_packet, void *udta)
+{
+	if (!streamer) return;
+	streamer->on_packet = on_packet;
+	streamer->on_packet_udta = udta;
+}
+
 GF_EXPORT
 GF_Err gf_rtp_streamer_send_rtcp(GF_RTPStreamer *streamer, Bool force_ts, u32 rtp_ts, u32 force_ntp_type, u32 ntp_sec, u32 ntp_frac)
 {
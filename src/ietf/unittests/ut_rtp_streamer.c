@@ -0,0 +1,173 @@
+#include "tests.h"
+#include <gpac/rtp_streamer.h>
+#include <gpac/constants.h>
+#include <gpac/network.h>
+
+#if !defined(GPAC_DISABLE_STREAMING) && !defined(GPAC_DISABLE_NETWORK)
+
+#define UTR_PORT	18000
+#define UTR_AU_SIZE	20000
+#define UTR_MTU	1400
+
+//forwarding of packets to other channels, as done by rtspout shared sessions
+typedef struct
+{
+	GF_RTPChannel *ch[100];
+	u32 nb_ch;
+	u16 sn_offset;
+	u32 ts_offset;
+	Bool mute;
+	u32 nb_pck, nb_flush;
+	u16 first_sn;
+} UTRFanout;
+
+static Bool utr_on_packet(void *udta, GF_RTPHeader *hdr, u8 *payload, u32 payload_size)
+{
+	u32 i;
+	UTRFanout *fo = (UTRFanout *) udta;
+	if (!hdr) {
+		fo->nb_flush++;
+		for (i=0; i<fo->nb_ch; i++) gf_rtp_flush_send_batch(fo->ch[i]);
+		return fo->mute;
+	}
+	if (!fo->nb_pck) fo->first_sn = hdr->SequenceNumber;
+	fo->nb_pck++;
+	for (i=0; i<fo->nb_ch; i++) {
+		GF_RTPHeader a_hdr = *hdr;
+		a_hdr.SequenceNumber += fo->sn_offset;
+		a_hdr.TimeStamp += fo->ts_offset;
+		gf_rtp_send_packet(fo->ch[i], &a_hdr, payload, payload_size, GF_TRUE);
+	}
+	return fo->mute;
+}
+
+static GF_RTPStreamer *utr_new_streamer(u16 port)
+{
+	return gf_rtp_streamer_new(GF_STREAM_AUDIO, GF_CODECID_MPEG_AUDIO, 90000, "127.0.0.1", port, UTR_MTU, 1, NULL,
+		0, NULL, 0, 96, 44100, 2, GF_FALSE, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, GF_FALSE);
+}
+
+static GF_RTPChannel *utr_new_channel(GF_RTPStreamer *rtp, u16 port, u32 ssrc)
+{
+	GF_RTSPTransport tr;
+	memset(&tr, 0, sizeof(GF_RTSPTransport));
+	tr.IsUnicast = GF_TRUE;
+	tr.Profile = "RTP/AVP";
+	tr.destination = "127.0.0.1";
+	tr.source = "0.0.0.0";
+	tr.SSRC = ssrc;
+	tr.is_sender = GF_TRUE;
+	tr.port_first = port+10;
+	tr.port_last = port+11;
+	tr.client_port_first = port;
+	tr.client_port_last = port+1;
+	return gf_rtp_streamer_new_channel(rtp, UTR_MTU, &tr, NULL, NULL);
+}
+
+static GF_Socket *utr_receiver(u16 port)
+{
+	GF_Socket *sk = gf_sk_new(GF_SOCK_TYPE_UDP);
+	if (!sk) return NULL;
+	if (gf_sk_bind(sk, NULL, port, NULL, 0, GF_SOCK_REUSE_PORT) != GF_OK) {
+		gf_sk_del(sk);
+		return NULL;
+	}
+	gf_sk_set_buffer_size(sk, GF_FALSE, 4*1024*1024);
+	return sk;
+}
+
+static u32 utr_read(GF_Socket *sk, u8 *buf, u32 size)
+{
+	u32 read=0, retry=0;
+	while (retry<200) {
+		GF_Err e = gf_sk_receive(sk, buf, size, &read);
+		if (e != GF_IP_NETWORK_EMPTY) break;
+		gf_sleep(1);
+		retry++;
+	}
+	return read;
+}
+
+unittest(rtp_streamer_packet_callback)
+{
+	u32 i, nb_ok=0;
+	u32 ntp_sec, ntp_frac;
+	u8 au[UTR_AU_SIZE], buf[2000];
+	UTRFanout fo;
+	u16 port = UTR_PORT + 2 * (gf_rand() % 500);
+	GF_Socket *rx_own, *rx_fwd, *rx_rtcp;
+	GF_RTPStreamer *rtp;
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	memset(&fo, 0, sizeof(UTRFanout));
+	rx_own = utr_receiver(port);
+	rx_fwd = utr_receiver(port+100);
+	rx_rtcp = utr_receiver(port+101);
+	rtp = utr_new_streamer(port);
+	assert_not_null(rx_own);
+	assert_not_null(rx_fwd);
+	assert_not_null(rx_rtcp);
+	assert_not_null(rtp);
+	if (!rx_own || !rx_fwd || !rx_rtcp || !rtp) {
+		gf_sys_close();
+		return;
+	}
+	for (i=0; i<UTR_AU_SIZE; i++) au[i] = (u8) gf_rand();
+
+	fo.ch[0] = utr_new_channel(rtp, port+100, 0x12345678);
+	assert_not_null(fo.ch[0]);
+	fo.nb_ch = 1;
+	fo.sn_offset = 1000;
+	fo.ts_offset = 90000;
+	gf_rtp_streamer_set_packet_callback(rtp, utr_on_packet, &fo);
+
+	//sender report of the forwarded channel before its first packet, with its own SSRC and timestamps
+	gf_net_get_ntp(&ntp_sec, &ntp_frac);
+	assert_equal(gf_rtp_send_rtcp_sr(fo.ch[0], 90000, ntp_sec, ntp_frac), GF_OK);
+	assert_greater(utr_read(rx_rtcp, buf, 2000), 28);
+	assert_equal(buf[1], 200);
+	assert_equal(GF_4CC(buf[4], buf[5], buf[6], buf[7]), 0x12345678);
+	assert_equal(GF_4CC(buf[8], buf[9], buf[10], buf[11]), ntp_sec);
+	assert_equal(GF_4CC(buf[16], buf[17], buf[18], buf[19]), 90000);
+
+	//streamer channel muted, packets only forwarded
+	fo.mute = GF_TRUE;
+	assert_equal(gf_rtp_streamer_send_au(rtp, au, UTR_AU_SIZE, 0, 0, GF_TRUE), GF_OK);
+	assert_equal(gf_rtp_streamer_flush(rtp), GF_OK);
+	assert_greater(fo.nb_pck, 10);
+	assert_equal(fo.nb_flush, 1);
+	for (i=0; i<fo.nb_pck; i++) {
+		u32 size = utr_read(rx_fwd, buf, 2000);
+		u16 sn = ((u16) buf[2]<<8) | buf[3];
+		u32 ts = GF_4CC(buf[4], buf[5], buf[6], buf[7]);
+		u32 ssrc = GF_4CC(buf[8], buf[9], buf[10], buf[11]);
+		if ((size>12) && (buf[0]==0x80) && (sn == (u16) (fo.first_sn + i + 1000)) && (ts==90000) && (ssrc==0x12345678))
+			nb_ok++;
+	}
+	assert_equal(nb_ok, fo.nb_pck);
+	assert_equal(utr_read(rx_own, buf, 2000), 0);
+
+	//both channels
+	fo.mute = GF_FALSE;
+	fo.nb_pck = 0;
+	assert_equal(gf_rtp_streamer_send_au(rtp, au, UTR_AU_SIZE, 3000, 3000, GF_TRUE), GF_OK);
+	nb_ok=0;
+	for (i=0; i<fo.nb_pck; i++) {
+		u32 s1 = utr_read(rx_own, buf, 2000);
+		u8 buf2[2000];
+		u32 s2 = utr_read(rx_fwd, buf2, 2000);
+		//same payload, different header
+		if (s1 && (s1==s2) && !memcmp(buf+12, buf2+12, s1-12) && memcmp(buf+8, buf2+8, 4))
+			nb_ok++;
+	}
+	assert_equal(nb_ok, fo.nb_pck);
+
+	gf_rtp_streamer_del(rtp);
+	gf_rtp_del(fo.ch[0]);
+	gf_sk_del(rx_own);
+	gf_sk_del(rx_fwd);
+	gf_sk_del(rx_rtcp);
+	gf_sys_close();
+}
+
+#endif //!GPAC_DISABLE_STREAMING && !GPAC_DISABLE_NETWORK
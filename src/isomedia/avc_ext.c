@@ -444,6 +444,31 @@ static void nalu_merge_ps(GF_BitStream *ps_bs, Bool rewrite_start_codes, u32 nal
 	}
 }
 
+//checks if gf_isom_nalu_sample_rewrite may modify the sample payload, in which case the sample data cannot point to read-only memory
+Bool gf_isom_nalu_sample_rewrite_needed(GF_MediaBox *mdia, GF_MPEGVisualSampleEntryBox *entry)
+{
+	u32 track_num;
+	GF_TrackReferenceTypeBox *scal = NULL;
+	GF_ISOFile *file = mdia->mediaTrack->moov->mov;
+
+	if (mdia->mediaTrack->extractor_mode & (GF_ISOM_NALU_EXTRACT_INBAND_PS_FLAG|GF_ISOM_NALU_EXTRACT_ANNEXB_FLAG))
+		return GF_TRUE;
+	//inspect mode without parameter set or start code rewrite leaves the payload untouched
+	if ((mdia->mediaTrack->extractor_mode&0x0000FFFF) == GF_ISOM_NALU_EXTRACT_INSPECT)
+		return GF_FALSE;
+
+	if (!entry || entry->svc_config || entry->mvc_config || entry->lhvc_config)
+		return GF_TRUE;
+
+	Track_FindRef(mdia->mediaTrack, GF_ISOM_REF_SCAL, &scal);
+	if (scal) return GF_TRUE;
+
+	track_num = 1 + gf_list_find(mdia->mediaTrack->moov->trackList, mdia->mediaTrack);
+	if (gf_isom_get_reference_count(file, track_num, GF_ISOM_REF_SABT) > 0) return GF_TRUE;
+	if (gf_isom_get_reference_count(file, track_num, GF_ISOM_REF_TBAS) > 0) return GF_TRUE;
+	return GF_FALSE;
+}
+
 GF_Err gf_isom_nalu_sample_rewrite(GF_MediaBox *mdia, GF_ISOSample *sample, u32 sampleNumber, GF_MPEGVisualSampleEntryBox *entry)
 {
 	Bool is_hevc = GF_FALSE;
@@ -390,6 +390,7 @@ void ctts_box_del(GF_Box *s)
 {
 	GF_CompositionOffsetBox *ptr = (GF_CompositionOffsetBox *)s;
 	if (ptr->entries) gf_free(ptr->entries);
+	stbl_index_del(&ptr->r_index);
 	gf_free(ptr);
 }
 
@@ -5557,6 +5558,7 @@ void stsc_box_del(GF_Box *s)
 	GF_SampleToChunkBox *ptr = (GF_SampleToChunkBox *)s;
 	if (ptr == NULL) return;
 	if (ptr->entries) gf_free(ptr->entries);
+	stbl_index_del(&ptr->r_index);
 	gf_free(ptr);
 }
 
@@ -6114,6 +6116,7 @@ void stts_box_del(GF_Box *s)
 {
 	GF_TimeToSampleBox *ptr = (GF_TimeToSampleBox *)s;
 	if (ptr->entries) gf_free(ptr->entries);
+	stbl_index_del(&ptr->r_index);
 	gf_free(ptr);
 }
 
@@ -352,6 +352,9 @@ GF_DataMap *gf_isom_fdm_new_temp(const char *sPath)
 
 	tmp->type = GF_ISOM_DATA_FILE;
 	tmp->mode = GF_ISOM_DATA_MAP_WRITE;
+#ifdef GPAC_HAS_FD
+	tmp->fd = -1;
+#endif
 
 	if (!sPath) {
 		tmp->stream = gf_file_temp(&tmp->temp_file);
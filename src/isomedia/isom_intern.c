@@ -377,6 +377,9 @@ static GF_Err gf_isom_parse_movie_boxes_internal(GF_ISOFile *mov, u32 *boxType,
 	while (gf_isom_datamap_top_level_box_avail(mov->movieFileMap)) {
 		*bytesMissing = 0;
 #ifndef	GPAC_DISABLE_ISOM_FRAGMENTS
+		//lazy mode, only load the requested fragment range
+		if (mov->lazy_parse_end && (gf_bs_get_position(mov->movieFileMap->bs) >= mov->lazy_parse_end))
+			break;
 		mov->current_top_box_start = gf_bs_get_position(mov->movieFileMap->bs) + mov->bytes_removed;
 		GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[iso file] Parsing a top-level box at position %d\n", mov->current_top_box_start));
 #endif
@@ -462,8 +465,15 @@ static GF_Err gf_isom_parse_movie_boxes_internal(GF_ISOFile *mov, u32 *boxType,
 				u32 k;
 				for (k=0; k<gf_list_count(mov->moov->trackList); k++) {
 					GF_TrackBox *trak = (GF_TrackBox *)gf_list_get(mov->moov->trackList, k);
-					if (trak->Media->information->sampleTable->sampleGroups) {
-						convert_compact_sample_groups(trak->Media->information->sampleTable->child_boxes, trak->Media->information->sampleTable->sampleGroups);
+					GF_SampleTableBox *stbl = trak->Media->information->sampleTable;
+					if (stbl->sampleGroups) {
+						convert_compact_sample_groups(stbl->child_boxes, stbl->sampleGroups);
+					}
+					//tables are only appended to in read mode, index them for random access
+					if ((mov->openMode == GF_ISOM_OPEN_READ) || (mov->openMode == GF_ISOM_OPEN_READ_DUMP)) {
+						if (stbl->TimeToSample) stbl->TimeToSample->r_index.enabled = GF_TRUE;
+						if (stbl->CompositionOffset) stbl->CompositionOffset->r_index.enabled = GF_TRUE;
+						if (stbl->SampleToChunk) stbl->SampleToChunk->r_index.enabled = GF_TRUE;
 					}
 				}
 			}
@@ -666,6 +676,11 @@ static GF_Err gf_isom_parse_movie_boxes_internal(GF_ISOFile *mov, u32 *boxType,
 			if (!mov->moov) {
 				GF_LOG(mov->moof ? GF_LOG_DEBUG : GF_LOG_WARNING, GF_LOG_CONTAINER, ("[iso file] Movie fragment but no moov (yet) - possibly broken parsing!\n"));
 			}
+			//lazy mode, index fragments from here and stop parsing, fragments are merged on demand
+			if ((mov->lazy_frags==1) && mov->moov) {
+				gf_isom_box_del(a);
+				return gf_isom_lazy_index_fragments(mov);
+			}
 			if (mov->single_moof_mode) {
 				mov->single_moof_state++;
 				if (mov->single_moof_state > 1) {
@@ -1124,6 +1139,8 @@ void gf_isom_delete_movie(GF_ISOFile *mov)
 
 	if (mov->main_sidx)
 		gf_isom_box_del((GF_Box*)mov->main_sidx);
+	if (mov->frag_ranges)
+		gf_free(mov->frag_ranges);
 
 	if (mov->block_buffer)
 		gf_free(mov->block_buffer);
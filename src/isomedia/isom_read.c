@@ -514,6 +514,349 @@ GF_Err gf_isom_load_fragments(GF_ISOFile *movie, u64 start_range, u64 end_range,
 	return gf_isom_parse_movie_boxes(movie, NULL, BytesMissing, GF_TRUE);
 }
 
+#ifndef	GPAC_DISABLE_ISOM_FRAGMENTS
+
+GF_Err gf_isom_parse_root_box(GF_Box **outBox, GF_BitStream *bs, u32 *boxType, u64 *bytesExpected, Bool progressive_mode);
+
+static GF_Err isom_lazy_add_range(GF_ISOFile *mov, u64 start, Double time)
+{
+	GF_ISOFragmentRange *range;
+	if (mov->nb_frag_ranges == mov->alloc_frag_ranges) {
+		mov->alloc_frag_ranges = mov->alloc_frag_ranges ? 2*mov->alloc_frag_ranges : 64;
+		range = gf_realloc(mov->frag_ranges, sizeof(GF_ISOFragmentRange) * mov->alloc_frag_ranges);
+		if (!range) {
+			mov->alloc_frag_ranges = mov->nb_frag_ranges;
+			return GF_OUT_OF_MEM;
+		}
+		mov->frag_ranges = range;
+	}
+	if (mov->nb_frag_ranges)
+		mov->frag_ranges[mov->nb_frag_ranges-1].end = start;
+	range = &mov->frag_ranges[mov->nb_frag_ranges];
+	mov->nb_frag_ranges++;
+	range->start = start;
+	range->end = 0;
+	range->time = time;
+	return GF_OK;
+}
+
+//parses moof at given offset and gets decode time of its first fragment and end time of this fragment, in seconds
+static Bool isom_lazy_probe_moof(GF_ISOFile *mov, u64 offset, Double *start, Double *end)
+{
+	u32 i=0;
+	u64 missing;
+	GF_Box *a = NULL;
+	GF_TrackFragmentBox *traf;
+	Bool found = GF_FALSE;
+	GF_BitStream *bs = mov->movieFileMap->bs;
+
+	gf_bs_seek(bs, offset);
+	if ((gf_isom_parse_root_box(&a, bs, NULL, &missing, GF_FALSE) != GF_OK) || !a) {
+		if (a) gf_isom_box_del(a);
+		return GF_FALSE;
+	}
+	if (a->type != GF_ISOM_BOX_TYPE_MOOF) {
+		gf_isom_box_del(a);
+		return GF_FALSE;
+	}
+	while ((traf = (GF_TrackFragmentBox *) gf_list_enum(((GF_MovieFragmentBox *)a)->TrackList, &i))) {
+		u32 j=0, def_dur=0;
+		u64 dur=0;
+		GF_TrackFragmentRunBox *trun;
+		GF_TrackBox *trak;
+		if (!traf->tfhd || !traf->tfdt) continue;
+		trak = gf_isom_get_track_from_id(mov->moov, traf->tfhd->trackID);
+		if (!trak || !trak->Media->mediaHeader->timeScale) continue;
+
+		if (traf->tfhd->flags & GF_ISOM_TRAF_SAMPLE_DUR) {
+			def_dur = traf->tfhd->def_sample_duration;
+		} else {
+			GF_TrackExtendsBox *trex = GetTrex(mov->moov, traf->tfhd->trackID);
+			if (trex) def_dur = trex->def_sample_duration;
+		}
+		while ((trun = (GF_TrackFragmentRunBox *) gf_list_enum(traf->TrackRuns, &j))) {
+			u32 k;
+			for (k=0; k<trun->sample_count; k++) {
+				if ((trun->flags & GF_ISOM_TRUN_DURATION) && (k<trun->nb_samples))
+					dur += trun->samples[k].Duration;
+				else
+					dur += def_dur;
+			}
+		}
+		*start = (Double) traf->tfdt->baseMediaDecodeTime;
+		*start /= trak->Media->mediaHeader->timeScale;
+		if (end) {
+			*end = (Double) (traf->tfdt->baseMediaDecodeTime + dur);
+			*end /= trak->Media->mediaHeader->timeScale;
+		}
+		found = GF_TRUE;
+		break;
+	}
+	gf_isom_box_del(a);
+	return found;
+}
+
+//index from a single-level sidx referencing all fragments
+static Bool isom_lazy_index_sidx(GF_ISOFile *mov, u64 first_moof, u64 file_size)
+{
+	u32 i;
+	u64 offset, time;
+	GF_SegmentIndexBox *sidx = mov->main_sidx;
+	if (!sidx || !sidx->timescale || !sidx->nb_refs) return GF_FALSE;
+
+	offset = mov->main_sidx_end_pos + sidx->first_offset;
+	if (offset > first_moof) return GF_FALSE;
+	for (i=0; i<sidx->nb_refs; i++) {
+		if (sidx->refs[i].reference_type) return GF_FALSE;
+	}
+	time = sidx->earliest_presentation_time;
+	for (i=0; i<sidx->nb_refs; i++) {
+		if (isom_lazy_add_range(mov, i ? offset : first_moof, ((Double) time) / sidx->timescale))
+			return GF_FALSE;
+		offset += sidx->refs[i].reference_size;
+		time += sidx->refs[i].subsegment_duration;
+	}
+	if (offset > file_size) return GF_FALSE;
+	mov->frag_ranges[mov->nb_frag_ranges-1].end = offset;
+	mov->lazy_duration = ((Double) (time - sidx->earliest_presentation_time)) / sidx->timescale;
+	return GF_TRUE;
+}
+
+//index from the tfra of the first track listed in mfra
+static Bool isom_lazy_index_mfra(GF_ISOFile *mov, u64 first_moof, u64 file_size)
+{
+	u32 i, size;
+	u64 mfra_start, missing;
+	GF_Box *a = NULL;
+	GF_TrackBox *trak;
+	GF_TrackFragmentRandomAccessBox *tfra;
+	Bool res = GF_FALSE;
+	GF_BitStream *bs = mov->movieFileMap->bs;
+
+	if (file_size < first_moof + 16) return GF_FALSE;
+	gf_bs_seek(bs, file_size - 16);
+	if ((gf_bs_read_u32(bs) != 16) || (gf_bs_read_u32(bs) != GF_ISOM_BOX_TYPE_MFRO))
+		return GF_FALSE;
+	gf_bs_read_u32(bs);
+	size = gf_bs_read_u32(bs);
+	if ((size < 16) || (size > file_size - first_moof)) return GF_FALSE;
+	mfra_start = file_size - size;
+
+	gf_bs_seek(bs, mfra_start);
+	if ((gf_isom_parse_root_box(&a, bs, NULL, &missing, GF_FALSE) != GF_OK) || !a || (a->type != GF_ISOM_BOX_TYPE_MFRA))
+		goto exit;
+
+	tfra = gf_list_get(((GF_MovieFragmentRandomAccessBox *)a)->tfra_list, 0);
+	trak = tfra ? gf_isom_get_track_from_id(mov->moov, tfra->track_id) : NULL;
+	if (!trak || !tfra->nb_entries || !trak->Media->mediaHeader->timeScale)
+		goto exit;
+
+	for (i=0; i<tfra->nb_entries; i++) {
+		GF_RandomAccessEntry *ent = &tfra->entries[i];
+		Double time = (Double) ent->time;
+		time /= trak->Media->mediaHeader->timeScale;
+		if ((ent->moof_offset < first_moof) || (ent->moof_offset >= mfra_start))
+			goto exit;
+		//several entries may point to the same fragment
+		if (mov->nb_frag_ranges) {
+			if (ent->moof_offset <= mov->frag_ranges[mov->nb_frag_ranges-1].start) continue;
+			if (isom_lazy_add_range(mov, ent->moof_offset, time)) goto exit;
+		}
+		//first range always starts at first moof
+		else if (isom_lazy_add_range(mov, first_moof, (ent->moof_offset==first_moof) ? time : -1)) {
+			goto exit;
+		}
+	}
+	mov->frag_ranges[mov->nb_frag_ranges-1].end = mfra_start;
+	res = GF_TRUE;
+
+exit:
+	if (a) gf_isom_box_del(a);
+	return res;
+}
+
+//index from top-level box headers, one range per moof
+static Bool isom_lazy_index_scan(GF_ISOFile *mov, u64 first_moof, u64 file_size)
+{
+	u64 pos = first_moof;
+	GF_BitStream *bs = mov->movieFileMap->bs;
+
+	while (pos + 8 <= file_size) {
+		u64 size;
+		u32 type;
+		gf_bs_seek(bs, pos);
+		size = gf_bs_read_u32(bs);
+		type = gf_bs_read_u32(bs);
+		if (size==1) {
+			if (pos + 16 > file_size) break;
+			size = gf_bs_read_u64(bs);
+		} else if (!size) {
+			size = file_size - pos;
+		}
+		if ((size<8) || (pos + size > file_size)) break;
+
+		if (type==GF_ISOM_BOX_TYPE_MOOF) {
+			if (isom_lazy_add_range(mov, pos, -1)) return GF_FALSE;
+		}
+		pos += size;
+	}
+	if (!mov->nb_frag_ranges) return GF_FALSE;
+	mov->frag_ranges[mov->nb_frag_ranges-1].end = pos;
+	return GF_TRUE;
+}
+
+GF_Err gf_isom_lazy_index_fragments(GF_ISOFile *mov)
+{
+	u64 first_moof = mov->current_top_box_start;
+	u64 file_size = gf_bs_get_size(mov->movieFileMap->bs);
+	const char *src = "sidx";
+
+	if (!mov->moov || !mov->moov->mvex) return GF_ISOM_INVALID_FILE;
+	mov->lazy_frags = 2;
+	mov->nb_frag_ranges = 0;
+	mov->lazy_duration = 0;
+	if (!isom_lazy_index_sidx(mov, first_moof, file_size)) {
+		src = "mfra";
+		mov->nb_frag_ranges = 0;
+		if (!isom_lazy_index_mfra(mov, first_moof, file_size)) {
+			src = "box scan";
+			mov->nb_frag_ranges = 0;
+			isom_lazy_index_scan(mov, first_moof, file_size);
+		}
+	}
+	if (!mov->nb_frag_ranges) return GF_ISOM_INVALID_FILE;
+
+	if (!mov->lazy_duration) {
+		Double start, end;
+		if (mov->moov->mvex->mehd && mov->moov->mvex->mehd->fragment_duration && mov->moov->mvhd->timeScale) {
+			mov->lazy_duration = (Double) mov->moov->mvex->mehd->fragment_duration;
+			mov->lazy_duration /= mov->moov->mvhd->timeScale;
+		}
+		//end time of last fragment
+		else if (isom_lazy_probe_moof(mov, mov->frag_ranges[mov->nb_frag_ranges-1].start, &start, &end)) {
+			mov->lazy_duration = end;
+		}
+	}
+	mov->next_frag_range = 0;
+	GF_LOG(GF_LOG_INFO, GF_LOG_CONTAINER, ("[iso file] Indexed %d fragment ranges from %s, duration %g\n", mov->nb_frag_ranges, src, mov->lazy_duration));
+	return GF_OK;
+}
+
+static GF_Err isom_lazy_load_range(GF_ISOFile *mov, u32 idx)
+{
+	GF_Err e;
+	u64 missing = 0;
+	GF_ISOFragmentRange *range = &mov->frag_ranges[idx];
+
+	mov->current_top_box_start = range->start;
+	mov->lazy_parse_end = range->end;
+	e = gf_isom_parse_movie_boxes(mov, NULL, &missing, GF_TRUE);
+	mov->lazy_parse_end = 0;
+	mov->next_frag_range = idx+1;
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_CONTAINER, ("[iso file] Loaded fragment range %d/%d ("LLU"-"LLU"): %s\n", idx+1, mov->nb_frag_ranges, range->start, range->end, gf_error_to_string(e)));
+	//truncated last fragment
+	if (e==GF_ISOM_INCOMPLETE_FILE) return GF_OK;
+	return e;
+}
+
+//gets decode time of range, probing its first moof if needed
+static Double isom_lazy_range_time(GF_ISOFile *mov, u32 idx)
+{
+	GF_ISOFragmentRange *range = &mov->frag_ranges[idx];
+	if (range->time == -1) {
+		if (!isom_lazy_probe_moof(mov, range->start, &range->time, NULL))
+			range->time = -2;
+	}
+	return range->time;
+}
+
+GF_EXPORT
+GF_Err gf_isom_open_lazy(const char *fileName, GF_ISOFile **isom_file)
+{
+	GF_Err e;
+	u64 missing = 0;
+	GF_ISOFile *movie;
+
+	if (!isom_file) return GF_BAD_PARAM;
+	*isom_file = NULL;
+
+	movie = gf_isom_new_movie();
+	if (!movie) return GF_OUT_OF_MEM;
+
+	movie->fileName = gf_strdup(fileName);
+	movie->openMode = GF_ISOM_OPEN_READ;
+	movie->lazy_frags = 1;
+
+	e = gf_isom_datamap_new(fileName, NULL, GF_ISOM_DATA_MAP_READ, &movie->movieFileMap);
+	if (!e) {
+		e = gf_isom_parse_movie_boxes(movie, NULL, &missing, GF_TRUE);
+		if ((e == GF_ISOM_INCOMPLETE_FILE) && movie->moov) e = GF_OK;
+	}
+	//not fragmented, the file is fully loaded
+	if (!e && (movie->lazy_frags == 1)) {
+		movie->lazy_frags = 0;
+	}
+	else if (!e) {
+		e = isom_lazy_load_range(movie, 0);
+	}
+	if (e) {
+		gf_isom_delete_movie(movie);
+		return e;
+	}
+	*isom_file = movie;
+	return GF_OK;
+}
+
+GF_EXPORT
+u32 gf_isom_get_lazy_fragments(GF_ISOFile *movie, u32 *next_range, Double *next_time, Double *duration)
+{
+	if (!movie || (movie->lazy_frags != 2)) return 0;
+	if (next_range) *next_range = movie->next_frag_range;
+	if (next_time) {
+		*next_time = -1;
+		if (movie->next_frag_range < movie->nb_frag_ranges) {
+			*next_time = isom_lazy_range_time(movie, movie->next_frag_range);
+			if (*next_time < 0) *next_time = -1;
+		}
+	}
+	if (duration) *duration = movie->lazy_duration;
+	return movie->nb_frag_ranges;
+}
+
+GF_EXPORT
+GF_Err gf_isom_lazy_load_next(GF_ISOFile *movie)
+{
+	if (!movie || (movie->lazy_frags != 2)) return GF_BAD_PARAM;
+	if (movie->next_frag_range >= movie->nb_frag_ranges) return GF_EOS;
+	return isom_lazy_load_range(movie, movie->next_frag_range);
+}
+
+GF_EXPORT
+GF_Err gf_isom_lazy_seek(GF_ISOFile *movie, Double start_time)
+{
+	u32 lo, hi;
+	if (!movie || (movie->lazy_frags != 2)) return GF_BAD_PARAM;
+
+	//find last range starting before start_time
+	lo = 0;
+	hi = movie->nb_frag_ranges;
+	while (hi - lo > 1) {
+		u32 mid = (lo + hi) / 2;
+		Double time = isom_lazy_range_time(movie, mid);
+		if (time < -1) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_CONTAINER, ("[iso file] No decode time for fragment range %d, seeking from first fragment\n", mid+1));
+			lo = 0;
+			break;
+		}
+		if (time <= start_time) lo = mid;
+		else hi = mid;
+	}
+	gf_isom_reset_tables(movie, GF_TRUE);
+	return isom_lazy_load_range(movie, lo);
+}
+
+#endif //GPAC_DISABLE_ISOM_FRAGMENTS
+
 
 /**************************************************************
 					File Reading
@@ -3202,6 +3545,10 @@ GF_Err gf_isom_purge_samples(GF_ISOFile *the_file, u32 trackNumber, u32 nb_sampl
 	stbl_RemoveChunk(stbl, 1, nb_samples);
 	stbl_RemoveRedundant(stbl, 1, nb_samples);
 	stbl_RemoveRAPs(stbl, nb_samples);
+	//sample numbers and times of the remaining entries changed
+	stbl_index_reset(&stbl->TimeToSample->r_index);
+	stbl_index_reset(&stbl->SampleToChunk->r_index);
+	if (stbl->CompositionOffset) stbl_index_reset(&stbl->CompositionOffset->r_index);
 
 	//purge saiz and saio
 	if (trak->sample_encryption && trak->sample_encryption->cenc_saiz) {
@@ -3272,6 +3619,7 @@ static void gf_isom_recreate_tables(GF_TrackBox *trak)
 		stbl->CompositionOffset->r_currentEntryIndex = 0;
 		stbl->CompositionOffset->r_FirstSampleInEntry = 0;
 		stbl->CompositionOffset->max_cts_delta = 0;
+		stbl_index_reset(&stbl->CompositionOffset->r_index);
 	}
 
 	if (stbl->DegradationPriority) {
@@ -3299,6 +3647,7 @@ static void gf_isom_recreate_tables(GF_TrackBox *trak)
 		stbl->SampleToChunk->ghostNumber = 0;
 		stbl->SampleToChunk->w_lastSampleNumber = 0;
 		stbl->SampleToChunk->w_lastChunkNumber = 0;
+		stbl_index_reset(&stbl->SampleToChunk->r_index);
 	}
 
 	if (stbl->ShadowSync) {
@@ -3317,6 +3666,7 @@ static void gf_isom_recreate_tables(GF_TrackBox *trak)
 		stbl->TimeToSample->r_FirstSampleInEntry = 0;
 		stbl->TimeToSample->r_currentEntryIndex = 0;
 		stbl->TimeToSample->r_CurrentDTS = 0;
+		stbl_index_reset(&stbl->TimeToSample->r_index);
 	}
 
 	gf_isom_box_array_del_parent(&stbl->child_boxes, stbl->sai_offsets);
@@ -6502,6 +6852,17 @@ GF_Err gf_isom_set_sample_alloc(GF_ISOFile *the_file, u32 trackNumber, 	u8 *(*sa
 	return GF_OK;
 }
 
+//sets a memory mapping of the current movie file, samples read through the sample alloc callback will point to this mapping when possible
+//the mapping is attached to the movie file map and is forgotten when segments are released or a new movie file map is used
+GF_Err gf_isom_set_sample_map(GF_ISOFile *the_file, u8 *map, u64 map_size)
+{
+	if (!the_file || !the_file->movieFileMap) return GF_BAD_PARAM;
+	if (the_file->openMode != GF_ISOM_OPEN_READ) return GF_NOT_SUPPORTED;
+	the_file->movieFileMap->sample_map = map_size ? map : NULL;
+	the_file->movieFileMap->sample_map_size = map ? map_size : 0;
+	return GF_OK;
+}
+
 s32 gf_isom_get_min_negative_cts_offset(GF_ISOFile *the_file, u32 trackNumber, GF_ISOMMinNegCtsQuery query_mode)
 {
 	GF_TrackBox *trak;
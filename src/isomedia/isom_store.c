@@ -100,6 +100,8 @@ typedef struct
 	u32 alloc_size;
 	GF_ISOFile *movie;
 	u64 total_samples, nb_done;
+	//native file being rewritten in place, NULL otherwise
+	FILE *stream;
 } MovieWriter;
 
 void CleanWriters(GF_List *writers)
@@ -2173,16 +2175,41 @@ static GF_Err inplace_shift_moov_meta_offsets(GF_ISOFile *movie, u32 shift_offse
 	return GF_OK;
 }
 
+//I/O block size when media data has to be copied through memory
+#define ISOM_SHIFT_BLOCK_SIZE	0x400000
+//minimum media data size for which mdat is realigned on file system blocks to avoid copying
+#define ISOM_SHIFT_INSERT_MIN	0x1000000
+//minimum shift for kernel copy, below this the number of copy calls gets too high
+#define ISOM_SHIFT_KCOPY_MIN	0x10000
+
+static u64 inplace_align_shift(u64 shift, u32 fs_block)
+{
+	if (!fs_block || !(shift % fs_block)) return shift;
+	return shift + fs_block - (shift % fs_block);
+}
+
 static GF_Err inplace_shift_mdat(MovieWriter *mw, u64 *shift_offset, GF_BitStream *bs, Bool moov_first)
 {
 	GF_Err e;
-	u8 data[1024];
 	GF_ISOFile *movie = mw->movie;
 	u64 moov_size = 0;
 	u64 meta_size = 0;
-	u64 cur_r, cur_w, byte_offset, orig_offset;
+	u64 cur_r, cur_w, byte_offset, orig_offset, insert_offset=0, clock;
+	u32 fs_block = 0;
+	const char *method = "block insertion";
 
 	orig_offset = gf_bs_get_position(bs);
+	byte_offset = movie->first_data_toplevel_offset;
+
+	//large mdat after moov on a native file: try to insert file system blocks in front of mdat rather than moving data
+	//the shift is then rounded to the block size, extra bytes going in the free box after moov
+	if (moov_first && mw->stream && (gf_bs_get_size(bs) >= byte_offset + ISOM_SHIFT_INSERT_MIN)) {
+		fs_block = gf_file_block_size(mw->stream);
+		if (fs_block) {
+			insert_offset = byte_offset - (byte_offset % fs_block);
+			*shift_offset = inplace_align_shift(*shift_offset, fs_block);
+		}
+	}
 
 	if (moov_first) {
 		if (movie->meta) {
@@ -2218,6 +2245,7 @@ static GF_Err inplace_shift_mdat(MovieWriter *mw, u64 *shift_offset, GF_BitStrea
 		}
 
 		if (reshift) {
+			reshift = (u32) (inplace_align_shift(*shift_offset + reshift, fs_block) - *shift_offset);
 			e = inplace_shift_moov_meta_offsets(movie, reshift);
 			if (e) return e;
 			*shift_offset += reshift;
@@ -2225,44 +2253,109 @@ static GF_Err inplace_shift_mdat(MovieWriter *mw, u64 *shift_offset, GF_BitStrea
 	}
 
 	//move data
-
-	gf_bs_seek(bs, gf_bs_get_size(bs));
-	cur_r = gf_bs_get_position(bs);
-	write_blank_data(bs, (u32) *shift_offset);
-	cur_w = gf_bs_get_position(bs);
-
-	byte_offset = movie->first_data_toplevel_offset;
-
+	cur_r = gf_bs_get_size(bs);
 	mw->total_samples = cur_r - byte_offset;
 	mw->nb_done = 0;
 	muxer_report_progress(mw);
+	clock = gf_sys_clock_high_res();
 
-	while (cur_r > byte_offset) {
-		u32 nb_write;
-		u32 move_bytes = 1024;
-		if (cur_r - byte_offset < move_bytes)
-			move_bytes = (u32) (cur_r - byte_offset);
-
-		gf_bs_seek(bs, cur_r - move_bytes);
-		nb_write = (u32) gf_bs_read_data(bs, data, move_bytes);
-		if (nb_write!=move_bytes) {
-			GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[Isom] Read error, got %d bytes but had %d to read\n", nb_write, move_bytes));
-			return GF_IO_ERR;
+	if (fs_block) {
+		u32 nb_keep = 0;
+		//the insertion block may start with boxes we already wrote, restore them after insertion
+		if (insert_offset < orig_offset) {
+			nb_keep = (u32) (orig_offset - insert_offset);
+			if (nb_keep > mw->alloc_size) {
+				mw->buffer = (char*)gf_realloc(mw->buffer, nb_keep);
+				if (!mw->buffer) return GF_OUT_OF_MEM;
+				mw->alloc_size = nb_keep;
+			}
+			gf_bs_seek(bs, insert_offset);
+			if (gf_bs_read_data(bs, mw->buffer, nb_keep) != nb_keep) return GF_IO_ERR;
 		}
+		gf_bs_flush(bs);
+		e = gf_file_insert_range(mw->stream, insert_offset, *shift_offset);
+		if (e && (e!=GF_NOT_SUPPORTED)) return e;
+		//the bitstream size is not updated, but we only write before mdat from now on
+		if (!e) {
+			if (nb_keep) {
+				gf_bs_seek(bs, insert_offset);
+				if (gf_bs_write_data(bs, mw->buffer, nb_keep) != nb_keep) return GF_IO_ERR;
+			}
+			goto exit;
+		}
+	}
 
-		gf_bs_seek(bs, cur_w - move_bytes);
-		nb_write = (u32) gf_bs_write_data(bs, data, move_bytes);
+	gf_bs_seek(bs, cur_r);
+	write_blank_data(bs, (u32) *shift_offset);
+	cur_w = gf_bs_get_position(bs);
 
-		if (nb_write!=move_bytes) {
-			GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[ISOM] Write error, wrote %d bytes but had %d to write\n", nb_write, move_bytes));
-			return GF_IO_ERR;
+	//copy in kernel space, from the end of the file
+	if (mw->stream && (*shift_offset >= ISOM_SHIFT_KCOPY_MIN)) {
+		method = "kernel copy";
+		gf_bs_flush(bs);
+		while (cur_r > byte_offset) {
+			u64 move_bytes = 16*ISOM_SHIFT_BLOCK_SIZE;
+			if (cur_r - byte_offset < move_bytes)
+				move_bytes = cur_r - byte_offset;
+
+			e = gf_file_copy_range(mw->stream, cur_r - move_bytes, cur_w - move_bytes, move_bytes);
+			if (e==GF_NOT_SUPPORTED) break;
+			if (e) return e;
+			cur_r -= move_bytes;
+			cur_w -= move_bytes;
+
+			mw->nb_done += move_bytes;
+			muxer_report_progress(mw);
+		}
+	}
+
+	//copy through memory from the end of the file, reads aligned on the I/O block size
+	if (cur_r > byte_offset) {
+		u32 bk_size = ISOM_SHIFT_BLOCK_SIZE;
+		method = "copy";
+		if (cur_r - byte_offset < bk_size)
+			bk_size = (u32) (cur_r - byte_offset);
+		if (bk_size > mw->alloc_size) {
+			mw->buffer = (char*)gf_realloc(mw->buffer, bk_size);
+			if (!mw->buffer) return GF_OUT_OF_MEM;
+			mw->alloc_size = bk_size;
+		}
+		while (cur_r > byte_offset) {
+			u32 nb_write;
+			u32 move_bytes = (u32) (cur_r % ISOM_SHIFT_BLOCK_SIZE);
+			if (!move_bytes || (move_bytes > bk_size))
+				move_bytes = bk_size;
+			if (cur_r - byte_offset < move_bytes)
+				move_bytes = (u32) (cur_r - byte_offset);
+
+			gf_bs_seek(bs, cur_r - move_bytes);
+			nb_write = (u32) gf_bs_read_data(bs, mw->buffer, move_bytes);
+			if (nb_write!=move_bytes) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[Isom] Read error, got %d bytes but had %d to read\n", nb_write, move_bytes));
+				return GF_IO_ERR;
+			}
+
+			gf_bs_seek(bs, cur_w - move_bytes);
+			nb_write = (u32) gf_bs_write_data(bs, mw->buffer, move_bytes);
+
+			if (nb_write!=move_bytes) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_CONTAINER, ("[ISOM] Write error, wrote %d bytes but had %d to write\n", nb_write, move_bytes));
+				return GF_IO_ERR;
+			}
+			cur_r -= move_bytes;
+			cur_w -= move_bytes;
+
+			mw->nb_done += move_bytes;
+			muxer_report_progress(mw);
 		}
-		cur_r -= move_bytes;
-		cur_w -= move_bytes;
+	}
 
-		mw->nb_done += move_bytes;
+exit:
+	if (mw->nb_done < mw->total_samples) {
+		mw->nb_done = mw->total_samples;
 		muxer_report_progress(mw);
 	}
+	GF_LOG(GF_LOG_INFO, GF_LOG_CONTAINER, ("[Isom] Shifted "LLU" bytes of media data by "LLU" bytes using %s in "LLU" us\n", mw->total_samples, *shift_offset, method, gf_sys_clock_high_res() - clock));
 	gf_bs_seek(bs, orig_offset);
 
 	return GF_OK;
@@ -2686,6 +2779,7 @@ GF_Err WriteToFile(GF_ISOFile *movie, Bool for_fragments)
 				return GF_IO_ERR;
 			bs = gf_bs_from_file(stream, GF_BITSTREAM_WRITE);
 			gf_bs_seek(bs, 0);
+			mw.stream = stream;
 		} else {
 			if (!strcmp(movie->finalName, "std"))
 				is_stdout = GF_TRUE;
@@ -468,6 +468,43 @@ Bool Media_IsSampleSyncShadow(GF_ShadowSyncBox *stsh, u32 sampleNumber)
 	return 0;
 }
 
+static Bool Media_IsMappedData(GF_MediaBox *mdia, u8 *data)
+{
+	GF_DataMap *dmap = mdia->information->dataHandler;
+	if (!dmap || !dmap->sample_map) return GF_FALSE;
+	if ((data >= dmap->sample_map) && (data < dmap->sample_map + dmap->sample_map_size)) return GF_TRUE;
+	return GF_FALSE;
+}
+
+//check if the sample payload can be used directly from the file mapping
+//samples needing padding or rewriting after read (OD, NALU with PS/start codes insertion, streaming text) are always copied
+static Bool Media_CanMapSample(GF_MediaBox *mdia, GF_SampleEntryBox *entry, u32 dataRefIndex, u64 offset, u32 data_size)
+{
+	GF_DataEntryBox *ent;
+	GF_ISOFile *mov = mdia->mediaTrack->moov->mov;
+	GF_DataMap *dmap = mdia->information->dataHandler;
+
+	if (!dmap || !dmap->sample_map) return GF_FALSE;
+	if (mdia->mediaTrack->padding_bytes) return GF_FALSE;
+	if (offset + data_size > dmap->sample_map_size) return GF_FALSE;
+	if (mov->read_byte_offset || mov->bytes_removed) return GF_FALSE;
+
+	ent = (GF_DataEntryBox*)gf_list_get(mdia->information->dataInformation->dref->child_boxes, dataRefIndex - 1);
+	if (!ent || !(ent->flags&1)) return GF_FALSE;
+
+	if (mdia->handler->handlerType == GF_ISOM_MEDIA_OD) return GF_FALSE;
+	if (gf_isom_is_nalu_based_entry(mdia, entry)) {
+		if (gf_isom_is_encrypted_entry(entry->type)) return GF_TRUE;
+		return gf_isom_nalu_sample_rewrite_needed(mdia, (GF_MPEGVisualSampleEntryBox *)entry) ? GF_FALSE : GF_TRUE;
+	}
+	if (mov->convert_streaming_text
+		&& ((mdia->handler->handlerType == GF_ISOM_MEDIA_TEXT) || (mdia->handler->handlerType == GF_ISOM_MEDIA_SCENE) || (mdia->handler->handlerType == GF_ISOM_MEDIA_SUBT))
+	) {
+		return GF_FALSE;
+	}
+	return GF_TRUE;
+}
+
 GF_Err Media_GetSample(GF_MediaBox *mdia, u32 sampleNumber, GF_ISOSample **samp, u32 *sIDX, Bool no_data, u64 *out_offset, Bool ext_realloc)
 {
 	GF_Err e;
@@ -565,7 +602,8 @@ GF_Err Media_GetSample(GF_MediaBox *mdia, u32 sampleNumber, GF_ISOSample **samp,
 	if (no_data) {
 		(*samp)->dataLength = data_size;
 		if ( ((*samp)->dataLength != 0) && mdia->mediaTrack->pack_num_samples) {
-			u32 idx_in_chunk = sampleNumber - mdia->information->sampleTable->SampleToChunk->firstSampleInCurrentChunk;
+			//one entry per sample (unpacked table), stsc cache is not used
+			u32 idx_in_chunk = (mdia->information->sampleTable->SampleToChunk->nb_entries == mdia->information->sampleTable->SampleSize->sampleCount) ? 0 : sampleNumber - mdia->information->sampleTable->SampleToChunk->firstSampleInCurrentChunk;
 			u32 left_in_chunk = stsc_entry->samplesPerChunk - idx_in_chunk;
 			if (left_in_chunk > mdia->mediaTrack->pack_num_samples)
 				left_in_chunk = mdia->mediaTrack->pack_num_samples;
@@ -609,57 +647,69 @@ GF_Err Media_GetSample(GF_MediaBox *mdia, u32 sampleNumber, GF_ISOSample **samp,
 	if (data_size != 0) {
 		GF_BlobRangeStatus range_status;
 		if (mdia->mediaTrack->pack_num_samples) {
-			u32 idx_in_chunk = sampleNumber - mdia->information->sampleTable->SampleToChunk->firstSampleInCurrentChunk;
+			//one entry per sample (unpacked table), stsc cache is not used
+			u32 idx_in_chunk = (mdia->information->sampleTable->SampleToChunk->nb_entries == mdia->information->sampleTable->SampleSize->sampleCount) ? 0 : sampleNumber - mdia->information->sampleTable->SampleToChunk->firstSampleInCurrentChunk;
 			u32 left_in_chunk = stsc_entry->samplesPerChunk - idx_in_chunk;
 			if (left_in_chunk > mdia->mediaTrack->pack_num_samples)
 				left_in_chunk = mdia->mediaTrack->pack_num_samples;
 			data_size *= left_in_chunk;
 			(*samp)->nb_pack = left_in_chunk;
 		}
-		if (! (*samp)->data)
+		//sample data was pointing to the file mapping, do not reuse it
+		if ((*samp)->data && Media_IsMappedData(mdia, (*samp)->data)) {
+			(*samp)->data = NULL;
 			(*samp)->alloc_size = 0;
+		}
+		if (ext_realloc && Media_CanMapSample(mdia, entry, dataRefIndex, offset, data_size)) {
+			//sample data points to the file mapping, no allocation nor copy
+			(*samp)->data = mdia->information->dataHandler->sample_map + offset;
+			(*samp)->dataLength = data_size;
+		} else {
+			if (! (*samp)->data)
+				(*samp)->alloc_size = 0;
 
-		/*and finally get the data, include padding if needed*/
-		if ((*samp)->alloc_size) {
-			if ((*samp)->alloc_size < data_size + mdia->mediaTrack->padding_bytes) {
-				(*samp)->data = (char *) gf_realloc((*samp)->data, sizeof(char) * ( data_size + mdia->mediaTrack->padding_bytes) );
-				if (! (*samp)->data) return GF_OUT_OF_MEM;
+			/*and finally get the data, include padding if needed*/
+			if ((*samp)->alloc_size) {
+				if ((*samp)->alloc_size < data_size + mdia->mediaTrack->padding_bytes) {
+					(*samp)->data = (char *) gf_realloc((*samp)->data, sizeof(char) * ( data_size + mdia->mediaTrack->padding_bytes) );
+					if (! (*samp)->data) return GF_OUT_OF_MEM;
 
-				(*samp)->alloc_size = data_size + mdia->mediaTrack->padding_bytes;
-			}
-		} else {
-			if (ext_realloc) {
-				(*samp)->data = mdia->mediaTrack->sample_alloc_cbk(data_size + mdia->mediaTrack->padding_bytes, mdia->mediaTrack->sample_alloc_udta);
+					(*samp)->alloc_size = data_size + mdia->mediaTrack->padding_bytes;
+				}
 			} else {
-				(*samp)->data = (u8 *) gf_malloc(data_size + mdia->mediaTrack->padding_bytes);
+				if (ext_realloc) {
+					(*samp)->data = mdia->mediaTrack->sample_alloc_cbk(data_size + mdia->mediaTrack->padding_bytes, mdia->mediaTrack->sample_alloc_udta);
+				} else {
+					(*samp)->data = (u8 *) gf_malloc(data_size + mdia->mediaTrack->padding_bytes);
+				}
+				if (! (*samp)->data) return GF_OUT_OF_MEM;
 			}
-			if (! (*samp)->data) return GF_OUT_OF_MEM;
-		}
-		(*samp)->dataLength = data_size;
-		if (mdia->mediaTrack->padding_bytes)
-			memset((*samp)->data + data_size, 0, sizeof(char) * mdia->mediaTrack->padding_bytes);
-
-		//check if we can get the sample (make sure we have enougth data...)
-		new_size = gf_bs_get_size(mdia->information->dataHandler->bs);
-		if (offset + data_size > new_size) {
-			//always refresh the size to avoid wrong info on http/ftp
-			new_size = gf_bs_get_refreshed_size(mdia->information->dataHandler->bs);
+			(*samp)->dataLength = data_size;
+			if (mdia->mediaTrack->padding_bytes)
+				memset((*samp)->data + data_size, 0, sizeof(char) * mdia->mediaTrack->padding_bytes);
+
+			//check if we can get the sample (make sure we have enougth data...)
+			new_size = gf_bs_get_size(mdia->information->dataHandler->bs);
 			if (offset + data_size > new_size) {
-				mdia->BytesMissing = offset + data_size - new_size;
-				return GF_ISOM_INCOMPLETE_FILE;
+				//always refresh the size to avoid wrong info on http/ftp
+				new_size = gf_bs_get_refreshed_size(mdia->information->dataHandler->bs);
+				if (offset + data_size > new_size) {
+					mdia->BytesMissing = offset + data_size - new_size;
+					return GF_ISOM_INCOMPLETE_FILE;
+				}
 			}
-		}
-		bytesRead = gf_isom_datamap_get_data(mdia->information->dataHandler, (*samp)->data, (*samp)->dataLength, offset, &range_status);
-		//if bytesRead != sampleSize, we have an IO err
-		if (bytesRead < data_size) {
-			if (range_status == GF_BLOB_RANGE_IN_TRANSFER) {
-				mdia->BytesMissing = (*samp)->dataLength;
-				return GF_ISOM_INCOMPLETE_FILE;
+			bytesRead = gf_isom_datamap_get_data(mdia->information->dataHandler, (*samp)->data, (*samp)->dataLength, offset, &range_status);
+			//if bytesRead != sampleSize, we have an IO err
+			if (bytesRead < data_size) {
+				if (range_status == GF_BLOB_RANGE_IN_TRANSFER) {
+					mdia->BytesMissing = (*samp)->dataLength;
+					return GF_ISOM_INCOMPLETE_FILE;
+				}
+				return GF_IO_ERR;
+			}
+			if (range_status == GF_BLOB_RANGE_CORRUPTED) {
+				(*samp)->corrupted = 1;
 			}
-			return GF_IO_ERR;
-		}
-		if (range_status == GF_BLOB_RANGE_CORRUPTED) {
-			(*samp)->corrupted = 1;
 		}
 		mdia->BytesMissing = 0;
 	} else {
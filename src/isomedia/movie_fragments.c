@@ -3439,6 +3439,7 @@ GF_Err gf_isom_set_traf_base_media_decode_time(GF_ISOFile *movie, GF_ISOTrackID
 	return GF_OK;
 }
 
+GF_EXPORT
 GF_Err gf_isom_enable_mfra(GF_ISOFile *file)
 {
 	if (!file) return GF_BAD_PARAM;
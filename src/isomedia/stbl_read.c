@@ -27,6 +27,146 @@
 
 #ifndef GPAC_DISABLE_ISOM
 
+void stbl_index_reset(GF_SampleTableIndex *idx)
+{
+	idx->nb_points = 0;
+}
+
+void stbl_index_del(GF_SampleTableIndex *idx)
+{
+	if (idx->samples) gf_free(idx->samples);
+	if (idx->times) gf_free(idx->times);
+	memset(idx, 0, sizeof(GF_SampleTableIndex));
+}
+
+static Bool stbl_index_push(GF_SampleTableIndex *idx, u64 sample, u64 time, Bool has_time)
+{
+	//sample numbers are 32 bits, don't index beyond
+	if (sample > 0xFFFFFFFFUL) {
+		idx->enabled = GF_FALSE;
+		return GF_FALSE;
+	}
+	if (idx->nb_points == idx->alloc_points) {
+		u32 *samples;
+		u32 alloc_points = idx->alloc_points ? 2*idx->alloc_points : 64;
+		samples = gf_realloc(idx->samples, sizeof(u32) * alloc_points);
+		if (samples) idx->samples = samples;
+		if (samples && has_time) {
+			u64 *times = gf_realloc(idx->times, sizeof(u64) * alloc_points);
+			if (times) idx->times = times;
+			else samples = NULL;
+		}
+		if (!samples) {
+			//no index, linear scan
+			stbl_index_del(idx);
+			return GF_FALSE;
+		}
+		idx->alloc_points = alloc_points;
+	}
+	idx->samples[idx->nb_points] = (u32) sample;
+	if (has_time) idx->times[idx->nb_points] = time;
+	idx->nb_points++;
+	return GF_TRUE;
+}
+
+//check if the index can be used for a table of nb_entries, resetting it if the table was shrunk
+static Bool stbl_index_check(GF_SampleTableIndex *idx, u32 nb_entries)
+{
+	if (!idx->enabled || (nb_entries < GF_ISOM_STBL_INDEX_MIN_ENTRIES)) return GF_FALSE;
+	if (idx->nb_points && ((idx->nb_points-1) * GF_ISOM_STBL_INDEX_STRIDE >= nb_entries))
+		stbl_index_reset(idx);
+	return GF_TRUE;
+}
+
+//get the last checkpoint located after entry cur_entry and before the target sample (or strictly before the target time)
+//returns -1 if none
+static s32 stbl_index_find(GF_SampleTableIndex *idx, u32 cur_entry, u32 sampleNumber, u64 time, Bool use_time)
+{
+	u32 lo, hi;
+	lo = cur_entry / GF_ISOM_STBL_INDEX_STRIDE + 1;
+	if (lo >= idx->nb_points) return -1;
+
+#define IDX_BEFORE(_p)	(use_time ? (idx->times[_p] < time) : (idx->samples[_p] <= sampleNumber))
+	//next checkpoint already past target, typical for sequential access
+	if (!IDX_BEFORE(lo)) return -1;
+	hi = idx->nb_points - 1;
+	while (lo < hi) {
+		u32 mid = (lo + hi + 1) / 2;
+		if (IDX_BEFORE(mid)) lo = mid;
+		else hi = mid - 1;
+	}
+#undef IDX_BEFORE
+	return (s32) lo;
+}
+
+//checkpoints are only added for entries before the last one, which may still be modified when appending fragments
+static void stts_index_update(GF_TimeToSampleBox *stts)
+{
+	u32 i, j;
+	u64 sample, time;
+	GF_SampleTableIndex *idx = &stts->r_index;
+
+	if (!idx->nb_points && !stbl_index_push(idx, 1, 0, GF_TRUE)) return;
+	i = (idx->nb_points-1) * GF_ISOM_STBL_INDEX_STRIDE;
+	sample = idx->samples[idx->nb_points-1];
+	time = idx->times[idx->nb_points-1];
+	while (i + GF_ISOM_STBL_INDEX_STRIDE < stts->nb_entries) {
+		for (j=i; j<i+GF_ISOM_STBL_INDEX_STRIDE; j++) {
+			sample += stts->entries[j].sampleCount;
+			time += (u64) stts->entries[j].sampleCount * stts->entries[j].sampleDelta;
+		}
+		if (!stbl_index_push(idx, sample, time, GF_TRUE)) return;
+		i += GF_ISOM_STBL_INDEX_STRIDE;
+	}
+}
+
+static void ctts_index_update(GF_CompositionOffsetBox *ctts)
+{
+	u32 i, j;
+	u64 sample;
+	GF_SampleTableIndex *idx = &ctts->r_index;
+
+	if (!idx->nb_points && !stbl_index_push(idx, 1, 0, GF_FALSE)) return;
+	i = (idx->nb_points-1) * GF_ISOM_STBL_INDEX_STRIDE;
+	sample = idx->samples[idx->nb_points-1];
+	while (i + GF_ISOM_STBL_INDEX_STRIDE < ctts->nb_entries) {
+		for (j=i; j<i+GF_ISOM_STBL_INDEX_STRIDE; j++)
+			sample += ctts->entries[j].sampleCount;
+		if (!stbl_index_push(idx, sample, 0, GF_FALSE)) return;
+		i += GF_ISOM_STBL_INDEX_STRIDE;
+	}
+}
+
+static void stsc_index_update(GF_SampleToChunkBox *stsc)
+{
+	u32 i, j;
+	u64 sample;
+	GF_SampleTableIndex *idx = &stsc->r_index;
+
+	if (!idx->nb_points && !stbl_index_push(idx, 1, 0, GF_FALSE)) return;
+	i = (idx->nb_points-1) * GF_ISOM_STBL_INDEX_STRIDE;
+	sample = idx->samples[idx->nb_points-1];
+	while (i + GF_ISOM_STBL_INDEX_STRIDE < stsc->nb_entries) {
+		for (j=i; j<i+GF_ISOM_STBL_INDEX_STRIDE; j++) {
+			GF_StscEntry *ent = &stsc->entries[j];
+			u32 ghost;
+			//same as GetGhostNum for an entry which is not the last one
+			if (ent->nextChunk)
+				ghost = (ent->nextChunk > ent->firstChunk) ? (ent->nextChunk - ent->firstChunk) : 1;
+			else
+				ghost = stsc->entries[j+1].firstChunk - ent->firstChunk;
+			//broken table, let the linear scan report it
+			if (!ghost) {
+				idx->enabled = GF_FALSE;
+				return;
+			}
+			sample += (u64) ghost * ent->samplesPerChunk;
+		}
+		if (!stbl_index_push(idx, sample, 0, GF_FALSE)) return;
+		i += GF_ISOM_STBL_INDEX_STRIDE;
+	}
+}
+
 //Get the sample number
 GF_Err stbl_findEntryForTime(GF_SampleTableBox *stbl, u64 DTS, u8 useCTS, u32 *sampleNumber, u32 *prevSampleNumber)
 {
@@ -59,6 +199,17 @@ GF_Err stbl_findEntryForTime(GF_SampleTableBox *stbl, u64 DTS, u8 useCTS, u32 *s
 		stbl->TimeToSample->r_currentEntryIndex = 0;
 	}
 
+	if (stbl_index_check(&stbl->TimeToSample->r_index, stbl->TimeToSample->nb_entries)) {
+		s32 p;
+		stts_index_update(stbl->TimeToSample);
+		p = stbl_index_find(&stbl->TimeToSample->r_index, i, 0, DTS, GF_TRUE);
+		if (p>=0) {
+			i = stbl->TimeToSample->r_currentEntryIndex = p * GF_ISOM_STBL_INDEX_STRIDE;
+			curDTS = stbl->TimeToSample->r_CurrentDTS = stbl->TimeToSample->r_index.times[p];
+			curSampNum = stbl->TimeToSample->r_FirstSampleInEntry = stbl->TimeToSample->r_index.samples[p];
+		}
+	}
+
 #if 0
 	//we need to validate our cache if we are using CTS because of B-frames and co...
 	if (i && useCTS) {
@@ -162,6 +313,15 @@ GF_Err stbl_GetSampleCTS(GF_CompositionOffsetBox *ctts, u32 SampleNumber, s32 *C
 		ctts->r_currentEntryIndex = 0;
 		i = 0;
 	}
+	if (stbl_index_check(&ctts->r_index, ctts->nb_entries)) {
+		s32 p;
+		ctts_index_update(ctts);
+		p = stbl_index_find(&ctts->r_index, i, SampleNumber, 0, GF_FALSE);
+		if (p>=0) {
+			i = ctts->r_currentEntryIndex = p * GF_ISOM_STBL_INDEX_STRIDE;
+			ctts->r_FirstSampleInEntry = ctts->r_index.samples[p];
+		}
+	}
 	for (; i< ctts->nb_entries; i++) {
 		if (SampleNumber < ctts->r_FirstSampleInEntry + ctts->entries[i].sampleCount) break;
 		//update our cache
@@ -202,6 +362,16 @@ GF_Err stbl_GetSampleDTS_and_Duration(GF_TimeToSampleBox *stts, u32 SampleNumber
 		stts->r_FirstSampleInEntry = 1;
 		stts->r_CurrentDTS = 0;
 	}
+	if (stbl_index_check(&stts->r_index, count)) {
+		s32 p;
+		stts_index_update(stts);
+		p = stbl_index_find(&stts->r_index, i, SampleNumber, 0, GF_FALSE);
+		if (p>=0) {
+			i = stts->r_currentEntryIndex = p * GF_ISOM_STBL_INDEX_STRIDE;
+			stts->r_FirstSampleInEntry = stts->r_index.samples[p];
+			stts->r_CurrentDTS = stts->r_index.times[p];
+		}
+	}
 
 	for (; i < count; i++) {
 		ent = &stts->entries[i];
@@ -453,6 +623,20 @@ GF_Err stbl_GetSampleInfos(GF_SampleTableBox *stbl, u32 sampleNumber, u64 *offse
 		GetGhostNum(ent, 0, stbl->SampleToChunk->nb_entries, stbl);
 		k = stbl->SampleToChunk->currentChunk;
 	}
+	//jump to the closest indexed entry, starting from its first chunk
+	if (stbl_index_check(&stbl->SampleToChunk->r_index, stbl->SampleToChunk->nb_entries)) {
+		s32 p;
+		stsc_index_update(stbl->SampleToChunk);
+		p = stbl_index_find(&stbl->SampleToChunk->r_index, i, sampleNumber, 0, GF_FALSE);
+		if (p>=0) {
+			i = stbl->SampleToChunk->currentIndex = p * GF_ISOM_STBL_INDEX_STRIDE;
+			stbl->SampleToChunk->firstSampleInCurrentChunk = stbl->SampleToChunk->r_index.samples[p];
+			stbl->SampleToChunk->currentChunk = 1;
+			ent = &stbl->SampleToChunk->entries[i];
+			GetGhostNum(ent, i, stbl->SampleToChunk->nb_entries, stbl);
+			k = 1;
+		}
+	}
 
 	//first get the chunk
 	for (; i < stbl->SampleToChunk->nb_entries; i++) {
@@ -0,0 +1,124 @@
+#include "tests.h"
+#include <gpac/isomedia.h>
+
+#if !defined(GPAC_DISABLE_ISOM) && !defined(GPAC_DISABLE_ISOM_WRITE) && !defined(GPAC_DISABLE_ISOM_FRAGMENTS)
+
+#define UTL_NB_FRAGS	20
+#define UTL_FRAG_SAMPLES	50
+//sample duration in ms, one fragment every 2s
+#define UTL_SAMPLE_DUR	40
+
+//one track, one fragment per moof with tfdt, no sidx, with or without mfra
+static Bool utl_create(const char *name, Bool use_mfra)
+{
+	u32 i, j, track, di;
+	u8 data[256];
+	GF_Err e = GF_OK;
+	GF_GenericSampleDescription udesc;
+	GF_ISOSample *samp;
+	GF_ISOFile *file = gf_isom_open(name, GF_ISOM_OPEN_WRITE, NULL);
+	if (!file) return GF_FALSE;
+	track = gf_isom_new_track(file, 1, GF_ISOM_MEDIA_VISUAL, 1000);
+	gf_isom_set_track_enabled(file, track, GF_TRUE);
+	memset(&udesc, 0, sizeof(GF_GenericSampleDescription));
+	udesc.codec_tag = GF_4CC('u','t','l','1');
+	gf_isom_new_generic_sample_description(file, track, NULL, NULL, &udesc, &di);
+	gf_isom_setup_track_fragment(file, 1, di, UTL_SAMPLE_DUR, 0, 0, 0, 0, GF_FALSE);
+	gf_isom_finalize_for_fragment(file, 0, GF_TRUE);
+	if (use_mfra) gf_isom_enable_mfra(file);
+
+	samp = gf_isom_sample_new();
+	samp->data = data;
+	for (i=0; i<UTL_NB_FRAGS; i++) {
+		e |= gf_isom_start_fragment(file, GF_ISOM_FRAG_MOOF_FIRST);
+		e |= gf_isom_set_traf_base_media_decode_time(file, 1, samp->DTS);
+		for (j=0; j<UTL_FRAG_SAMPLES; j++) {
+			samp->IsRAP = j ? RAP_NO : RAP;
+			samp->dataLength = 1 + gf_rand() % 256;
+			memset(data, i*UTL_FRAG_SAMPLES + j, samp->dataLength);
+			e |= gf_isom_fragment_add_sample(file, 1, samp, di, UTL_SAMPLE_DUR, 0, 0, GF_FALSE);
+			samp->DTS += UTL_SAMPLE_DUR;
+		}
+	}
+	samp->data = NULL;
+	gf_isom_sample_del(&samp);
+	e |= gf_isom_close(file);
+	return (e==GF_OK) ? GF_TRUE : GF_FALSE;
+}
+
+static Bool utl_same_sample(GF_ISOFile *ref, u32 ref_num, GF_ISOFile *file, u32 sample_num)
+{
+	u32 di1, di2;
+	Bool same = GF_FALSE;
+	GF_ISOSample *s1 = gf_isom_get_sample(ref, 1, ref_num, &di1);
+	GF_ISOSample *s2 = gf_isom_get_sample(file, 1, sample_num, &di2);
+	if (s1 && s2 && (di1==di2) && (s1->DTS==s2->DTS) && (s1->IsRAP==s2->IsRAP)
+		&& (s1->dataLength==s2->dataLength) && !memcmp(s1->data, s2->data, s1->dataLength))
+		same = GF_TRUE;
+	if (s1) gf_isom_sample_del(&s1);
+	if (s2) gf_isom_sample_del(&s2);
+	return same;
+}
+
+static void utl_check(Bool use_mfra)
+{
+	u32 i, next_range;
+	Double next_time, dur;
+	char szName[GF_MAX_PATH];
+	GF_ISOFile *ref, *file;
+
+	snprintf(szName, GF_MAX_PATH, "%s/ut_isom_lazy.mp4", gf_get_default_cache_directory());
+	assert_true(utl_create(szName, use_mfra));
+	ref = gf_isom_open(szName, GF_ISOM_OPEN_READ, NULL);
+	assert_not_null(ref);
+	assert_equal(gf_isom_get_sample_count(ref, 1), UTL_NB_FRAGS*UTL_FRAG_SAMPLES);
+
+	assert_equal(gf_isom_open_lazy(szName, &file), GF_OK);
+	assert_equal(gf_isom_get_lazy_fragments(file, &next_range, &next_time, &dur), UTL_NB_FRAGS);
+	//only the first fragment is loaded
+	assert_equal(next_range, 1);
+	assert_equal(next_time, (Double) UTL_FRAG_SAMPLES*UTL_SAMPLE_DUR / 1000);
+	assert_equal(dur, (Double) UTL_NB_FRAGS*UTL_FRAG_SAMPLES*UTL_SAMPLE_DUR / 1000);
+	assert_equal(gf_isom_get_sample_count(file, 1), UTL_FRAG_SAMPLES);
+
+	//on-demand loading appends to sample tables
+	for (i=1; i<UTL_NB_FRAGS; i++) {
+		assert_equal(gf_isom_lazy_load_next(file), GF_OK);
+	}
+	assert_equal(gf_isom_lazy_load_next(file), GF_EOS);
+	assert_equal(gf_isom_get_sample_count(file, 1), UTL_NB_FRAGS*UTL_FRAG_SAMPLES);
+	for (i=1; i<=UTL_NB_FRAGS*UTL_FRAG_SAMPLES; i++)
+		assert_true(utl_same_sample(ref, i, file, i));
+
+	//seek in the middle of fragment 9, tables restart at the fragment start
+	assert_equal(gf_isom_lazy_seek(file, 17.0), GF_OK);
+	assert_equal(gf_isom_get_sample_count(file, 1), UTL_FRAG_SAMPLES);
+	for (i=1; i<=UTL_FRAG_SAMPLES; i++)
+		assert_true(utl_same_sample(ref, 8*UTL_FRAG_SAMPLES + i, file, i));
+	assert_equal(gf_isom_lazy_load_next(file), GF_OK);
+	assert_equal(gf_isom_get_sample_count(file, 1), 2*UTL_FRAG_SAMPLES);
+	for (i=1; i<=2*UTL_FRAG_SAMPLES; i++)
+		assert_true(utl_same_sample(ref, 8*UTL_FRAG_SAMPLES + i, file, i));
+
+	//seek back before start and past end
+	assert_equal(gf_isom_lazy_seek(file, 0), GF_OK);
+	assert_true(utl_same_sample(ref, 1, file, 1));
+	assert_equal(gf_isom_lazy_seek(file, 1000.0), GF_OK);
+	assert_true(utl_same_sample(ref, (UTL_NB_FRAGS-1)*UTL_FRAG_SAMPLES + 1, file, 1));
+	assert_equal(gf_isom_lazy_load_next(file), GF_EOS);
+
+	gf_isom_close(ref);
+	gf_isom_close(file);
+	gf_file_delete(szName);
+}
+
+unittest(isom_lazy_fragments)
+{
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	//index from box scan, then from mfra
+	utl_check(GF_FALSE);
+	utl_check(GF_TRUE);
+	gf_sys_close();
+}
+
+#endif
@@ -0,0 +1,98 @@
+#include "tests.h"
+#include <gpac/isomedia.h>
+
+#if !defined(GPAC_DISABLE_ISOM) && !defined(GPAC_DISABLE_ISOM_WRITE)
+
+#define UTS_NB_SAMPLES	20000
+
+static void uts_on_progress(const void *cbck, const char *title, u64 done, u64 total) { }
+
+//one track with varying durations, CTS offsets and sample descriptions so that stts, ctts and stsc have many entries
+static Bool uts_create(const char *name)
+{
+	u32 i, track, di, di2, cur_di=1;
+	u8 data[100];
+	GF_Err e;
+	GF_GenericSampleDescription udesc;
+	GF_ISOSample *samp;
+	GF_ISOFile *file = gf_isom_open(name, GF_ISOM_WRITE_EDIT, NULL);
+	if (!file) return GF_FALSE;
+	track = gf_isom_new_track(file, 1, GF_ISOM_MEDIA_VISUAL, 1000);
+	memset(&udesc, 0, sizeof(GF_GenericSampleDescription));
+	udesc.codec_tag = GF_4CC('u','t','s','1');
+	gf_isom_new_generic_sample_description(file, track, NULL, NULL, &udesc, &di);
+	udesc.codec_tag = GF_4CC('u','t','s','2');
+	gf_isom_new_generic_sample_description(file, track, NULL, NULL, &udesc, &di2);
+
+	memset(data, 0x55, 100);
+	samp = gf_isom_sample_new();
+	samp->data = data;
+	samp->IsRAP = RAP;
+	for (i=0; i<UTS_NB_SAMPLES; i++) {
+		if (!(gf_rand() % 4)) cur_di = (cur_di==di) ? di2 : di;
+		samp->dataLength = 1 + gf_rand() % 100;
+		samp->CTS_Offset = gf_rand() % 4;
+		gf_isom_add_sample(file, track, cur_di, samp);
+		samp->DTS += 1 + gf_rand() % 4;
+	}
+	samp->data = NULL;
+	gf_isom_sample_del(&samp);
+	gf_set_progress_callback(NULL, uts_on_progress);
+	e = gf_isom_close(file);
+	gf_set_progress_callback(NULL, NULL);
+	return (e==GF_OK) ? GF_TRUE : GF_FALSE;
+}
+
+static Bool uts_same_info(GF_ISOFile *f1, GF_ISOFile *f2, u32 sample_num)
+{
+	u32 di1, di2;
+	u64 offset1, offset2;
+	Bool same = GF_FALSE;
+	GF_ISOSample *s1 = gf_isom_get_sample_info(f1, 1, sample_num, &di1, &offset1);
+	GF_ISOSample *s2 = gf_isom_get_sample_info(f2, 1, sample_num, &di2, &offset2);
+	if (s1 && s2 && (di1==di2) && (offset1==offset2) && (s1->DTS==s2->DTS) && (s1->CTS_Offset==s2->CTS_Offset) && (s1->dataLength==s2->dataLength))
+		same = GF_TRUE;
+	if (s1) gf_isom_sample_del(&s1);
+	if (s2) gf_isom_sample_del(&s2);
+	return same;
+}
+
+unittest(isom_stbl_index)
+{
+	u32 i;
+	char szName[GF_MAX_PATH];
+	GF_ISOFile *ref, *file;
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	snprintf(szName, GF_MAX_PATH, "%s/ut_stbl.mp4", gf_get_default_cache_directory());
+	assert_true(uts_create(szName));
+	//tables are not indexed in edit mode
+	ref = gf_isom_open(szName, GF_ISOM_OPEN_READ_EDIT, NULL);
+	file = gf_isom_open(szName, GF_ISOM_OPEN_READ, NULL);
+	assert_not_null(ref);
+	assert_not_null(file);
+	assert_equal(gf_isom_get_sample_count(file, 1), UTS_NB_SAMPLES);
+
+	//sequential, random, then backward access
+	for (i=1; i<=UTS_NB_SAMPLES; i++)
+		assert_true(uts_same_info(ref, file, i));
+	for (i=0; i<UTS_NB_SAMPLES; i++)
+		assert_true(uts_same_info(ref, file, 1 + gf_rand() % UTS_NB_SAMPLES));
+	for (i=UTS_NB_SAMPLES; i>7; i-=7)
+		assert_true(uts_same_info(ref, file, i));
+
+	//lookup by time, exact or not
+	for (i=0; i<1000; i++) {
+		u32 sn1, sn2, di;
+		u64 dts = gf_rand() % (UTS_NB_SAMPLES * 3);
+		assert_equal(gf_isom_get_sample_for_media_time(ref, 1, dts, &di, GF_ISOM_SEARCH_BACKWARD, NULL, &sn1, NULL), GF_OK);
+		assert_equal(gf_isom_get_sample_for_media_time(file, 1, dts, &di, GF_ISOM_SEARCH_BACKWARD, NULL, &sn2, NULL), GF_OK);
+		assert_equal(sn1, sn2);
+	}
+	gf_isom_close(ref);
+	gf_isom_close(file);
+	gf_file_delete(szName);
+	gf_sys_close();
+}
+
+#endif
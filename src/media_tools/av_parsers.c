@@ -4755,43 +4755,12 @@ const char *gf_avc_hevc_get_chroma_format_name(u8 chroma_format)
 
 u32 gf_bs_read_ue_log_idx3(GF_BitStream *bs, const char *fname, s32 idx1, s32 idx2, s32 idx3)
 {
-	u32 val=0, code;
-	s32 nb_lead = -1;
-	u32 bits = 0;
-	for (code=0; !code; nb_lead++) {
-		if (nb_lead>=32) {
-			break;
-		}
-		code = gf_bs_read_int(bs, 1);
-		bits++;
-	}
-
-	if (nb_lead>=32) {
-		if (gf_bs_is_overflow(bs)<2) {
-			//gf_bs_read_int keeps returning 0 on EOS, so if no more bits available, rbsp was truncated otherwise code is broken in rbsp)
-			//we only test once nb_lead>=32 to avoid testing at each bit read
-			if (!gf_bs_available(bs)) {
-				GF_LOG(GF_LOG_ERROR, GF_LOG_CODING, ("[Core] exp-golomb read failed, not enough bits in bitstream !\n"));
-			} else {
-				GF_LOG(GF_LOG_ERROR, GF_LOG_CODING, ("[Core] corrupted exp-golomb code, %d leading zeros, max 31 allowed !\n", nb_lead));
-			}
-			gf_bs_mark_overflow(bs, GF_FALSE);
-		}
-		return 0;
-	}
-
-	if (nb_lead) {
-		u32 leads=1;
-		val = gf_bs_read_int(bs, nb_lead);
-		leads <<= nb_lead;
-		leads -= 1;
-		val += leads;
-//		val += (1 << nb_lead) - 1;
-		bits += nb_lead;
-	}
-
+	u32 val = gf_bs_read_ue(bs);
 	if (fname) {
-		gf_bs_log_idx(bs, bits, fname, val, idx1, idx2, idx3);
+		//number of leading zeros of the code
+		u32 nb_lead = 0;
+		while (((u64) val + 1) >> (nb_lead+1)) nb_lead++;
+		gf_bs_log_idx(bs, 2*nb_lead+1, fname, val, idx1, idx2, idx3);
 	}
 	return val;
 }
@@ -4800,19 +4769,6 @@ u32 gf_bs_read_ue_log_idx3(GF_BitStream *bs, const char *fname, s32 idx1, s32 id
 #define gf_bs_read_ue_log_idx(_bs, _fname, _idx) gf_bs_read_ue_log_idx3(_bs, _fname, (s32) _idx, -1, -1)
 #define gf_bs_read_ue_log(_bs, _fname) gf_bs_read_ue_log_idx3(_bs, _fname, -1, -1, -1)
 
-
-u32 gf_bs_read_ue(GF_BitStream *bs)
-{
-	return gf_bs_read_ue_log(bs, NULL);
-}
-
-s32 gf_bs_read_se(GF_BitStream *bs)
-{
-	u32 v = gf_bs_read_ue(bs);
-	if ((v & 0x1) == 0) return (s32)(0 - (v >> 1));
-	return (v + 1) >> 1;
-}
-
 s32 gf_bs_read_se_log_idx2(GF_BitStream *bs, const char *fname, s32 idx1, s32 idx2)
 {
 	s32 res = gf_bs_read_se(bs);
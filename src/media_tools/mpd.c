@@ -1152,6 +1152,137 @@ void gf_mpd_segment_base_free(void *_item)
 	gf_free(ptr);
 }
 
+//rendered text cache for manifest elements (S entries, m3u8 segments) which are unchanged from one manifest update to the next
+typedef struct
+{
+	//element key, text of an element is only a function of its key and of the cache context
+	u64 time, dur;
+	u32 num, flags;
+	//start and end offset of element in text
+	u32 start, end;
+} GF_MPD_PrintCacheEntry;
+
+struct __gf_mpd_print_cache
+{
+	//current and previous generation of rendered text and elements
+	FILE *text, *prev_text;
+	GF_MPD_PrintCacheEntry *entries, *prev_entries;
+	u32 nb_entries, nb_alloc, nb_prev, nb_prev_alloc;
+	//position in previous generation
+	u32 prev_idx;
+	//rendering context (indentation, base URL, ...), the cache is invalidated when it changes
+	s32 indent;
+	u32 ctx;
+};
+
+static void gf_mpd_print_cache_del(GF_MPD_PrintCache *cache)
+{
+	if (!cache) return;
+	if (cache->text) gf_fclose(cache->text);
+	if (cache->prev_text) gf_fclose(cache->prev_text);
+	if (cache->entries) gf_free(cache->entries);
+	if (cache->prev_entries) gf_free(cache->prev_entries);
+	gf_free(cache);
+}
+
+//starts a new rendering pass, elements rendered in the previous pass become the reuse candidates
+static GF_MPD_PrintCache *gf_mpd_print_cache_begin(GF_MPD_PrintCache **p_cache, s32 indent, u32 ctx)
+{
+	FILE *f;
+	GF_MPD_PrintCacheEntry *ents;
+	u32 nb_alloc;
+	GF_MPD_PrintCache *cache = *p_cache;
+	if (!cache) {
+		GF_SAFEALLOC(cache, GF_MPD_PrintCache);
+		if (!cache) return NULL;
+		cache->text = gf_file_mem_new();
+		cache->prev_text = gf_file_mem_new();
+		if (!cache->text || !cache->prev_text) {
+			gf_mpd_print_cache_del(cache);
+			return NULL;
+		}
+		cache->indent = indent;
+		cache->ctx = ctx;
+		*p_cache = cache;
+	}
+	f = cache->prev_text;
+	cache->prev_text = cache->text;
+	cache->text = f;
+	gf_file_mem_reset(cache->text);
+
+	ents = cache->prev_entries;
+	nb_alloc = cache->nb_prev_alloc;
+	cache->prev_entries = cache->entries;
+	cache->nb_prev_alloc = cache->nb_alloc;
+	cache->nb_prev = cache->nb_entries;
+	cache->entries = ents;
+	cache->nb_alloc = nb_alloc;
+	cache->nb_entries = 0;
+	cache->prev_idx = 0;
+
+	if ((cache->indent != indent) || (cache->ctx != ctx)) {
+		cache->nb_prev = 0;
+		cache->indent = indent;
+		cache->ctx = ctx;
+	}
+	return cache;
+}
+
+//registers element rendered in cache->text from offset start
+static void gf_mpd_print_cache_add(GF_MPD_PrintCache *cache, u32 start, u64 time, u64 dur, u32 num, u32 flags)
+{
+	GF_MPD_PrintCacheEntry *ent;
+	if (cache->nb_entries == cache->nb_alloc) {
+		cache->nb_alloc = cache->nb_alloc ? 2*cache->nb_alloc : 64;
+		ent = gf_realloc(cache->entries, sizeof(GF_MPD_PrintCacheEntry) * cache->nb_alloc);
+		if (!ent) {
+			cache->nb_alloc = cache->nb_entries;
+			return;
+		}
+		cache->entries = ent;
+	}
+	ent = &cache->entries[cache->nb_entries];
+	cache->nb_entries++;
+	ent->time = time;
+	ent->dur = dur;
+	ent->num = num;
+	ent->flags = flags;
+	ent->start = start;
+	ent->end = (u32) gf_ftell(cache->text);
+}
+
+//copies text of element from previous pass if found, return GF_FALSE if element must be rendered in cache->text
+static Bool gf_mpd_print_cache_reuse(GF_MPD_PrintCache *cache, u64 time, u64 dur, u32 num, u32 flags)
+{
+	u8 *data;
+	u32 start, size;
+	GF_MPD_PrintCacheEntry *ent;
+
+	//elements are rendered in increasing time order
+	while ((cache->prev_idx < cache->nb_prev) && (cache->prev_entries[cache->prev_idx].time < time))
+		cache->prev_idx++;
+	if (cache->prev_idx >= cache->nb_prev) return GF_FALSE;
+
+	ent = &cache->prev_entries[cache->prev_idx];
+	if ((ent->time != time) || (ent->dur != dur) || (ent->num != num) || (ent->flags != flags))
+		return GF_FALSE;
+
+	data = gf_file_mem_get_data(cache->prev_text, &size);
+	if (!data || (ent->end > size) || (ent->end < ent->start)) return GF_FALSE;
+	start = (u32) gf_ftell(cache->text);
+	gf_fwrite(data + ent->start, ent->end - ent->start, cache->text);
+	cache->prev_idx++;
+	gf_mpd_print_cache_add(cache, start, time, dur, num, flags);
+	return GF_TRUE;
+}
+
+static void gf_mpd_print_cache_flush(GF_MPD_PrintCache *cache, FILE *out)
+{
+	u32 size;
+	u8 *data = gf_file_mem_get_data(cache->text, &size);
+	if (data) gf_fwrite(data, size, out);
+}
+
 void gf_mpd_segment_entry_free(void *_item)
 {
 	gf_free(_item);
@@ -1160,6 +1291,7 @@ void gf_mpd_segment_timeline_free(void *_item)
 {
 	GF_MPD_SegmentTimeline *ptr = (GF_MPD_SegmentTimeline *)_item;
 	gf_mpd_del_list(ptr->entries, gf_mpd_segment_entry_free, 0);
+	gf_mpd_print_cache_del(ptr->print_cache);
 	gf_free(ptr);
 }
 
@@ -1309,6 +1441,7 @@ void gf_mpd_representation_free(void *_item)
 	}
 	if (ptr->m3u8_var_name) gf_free(ptr->m3u8_var_name);
 	if (ptr->m3u8_var_file) gf_fclose(ptr->m3u8_var_file);
+	gf_mpd_print_cache_del(ptr->m3u8_cache);
 	if (ptr->res_url) gf_free(ptr->res_url);
 	gf_free(ptr);
 }
@@ -2778,10 +2911,36 @@ static void gf_mpd_print_segment_base(FILE *out, GF_MPD_SegmentBase *s, s32 inde
 	gf_mpd_lf(out, indent);
 }
 
+//number of S entries above which rendered S elements are cached
+#define MPD_TIMELINE_CACHE_MIN	16
+
+static void gf_mpd_print_segment_timeline_entry(FILE *out, GF_MPD_PrintCache *cache, s32 indent, u64 start_time, Bool show_time, u32 duration, u32 rcount)
+{
+	u32 start=0;
+	if (cache) {
+		if (gf_mpd_print_cache_reuse(cache, start_time, duration, rcount, show_time))
+			return;
+		start = (u32) gf_ftell(cache->text);
+		out = cache->text;
+	}
+	gf_mpd_nl(out, indent+1);
+	gf_fprintf(out, "<S");
+	if (show_time) gf_fprintf(out, " t=\""LLD"\"", start_time);
+	if (duration) gf_fprintf(out, " d=\"%d\"", duration);
+	if (rcount) gf_fprintf(out, " r=\"%d\"", rcount);
+	gf_fprintf(out, "/>");
+	gf_mpd_lf(out, indent);
+
+	if (cache)
+		gf_mpd_print_cache_add(cache, start, start_time, duration, rcount, show_time);
+}
+
 static void gf_mpd_print_segment_timeline(FILE *out, GF_MPD_SegmentTimeline *tl, s32 indent, u32 tsb_first_entry)
 {
 	u32 i, count, rcount;
-	u64 start_time=0;
+	u64 start_time=0, s_time;
+	Bool s_show_time;
+	GF_MPD_PrintCache *cache = NULL;
 	GF_MPD_SegmentTimelineEntry *se, *prev;
 
 	gf_mpd_nl(out, indent);
@@ -2792,10 +2951,12 @@ static void gf_mpd_print_segment_timeline(FILE *out, GF_MPD_SegmentTimeline *tl,
 	count = gf_list_count(tl->entries);
 	if (!prev) goto done_tl;
 
-	gf_mpd_nl(out, indent+1);
-	gf_fprintf(out, "<S");
-	gf_fprintf(out, " t=\""LLD"\"", prev->start_time);
-	if (prev->duration) gf_fprintf(out, " d=\"%d\"", prev->duration);
+	//live timelines are rewritten at each manifest update, mostly with the same S elements
+	if (tl->print_cache || (count - tsb_first_entry > MPD_TIMELINE_CACHE_MIN))
+		cache = gf_mpd_print_cache_begin(&tl->print_cache, indent, 0);
+
+	s_time = prev->start_time;
+	s_show_time = GF_TRUE;
 	rcount = prev->repeat_count;
 	start_time = prev->start_time + (prev->repeat_count+1) * prev->duration;
 
@@ -2803,17 +2964,14 @@ static void gf_mpd_print_segment_timeline(FILE *out, GF_MPD_SegmentTimeline *tl,
 		se = gf_list_get(tl->entries, i);
 		//close entry
 		if ((se->start_time != start_time) || (prev->duration!=se->duration)) {
-			if (rcount) gf_fprintf(out, " r=\"%d\"", rcount);
-			gf_fprintf(out, "/>");
-			gf_mpd_lf(out, indent);
+			gf_mpd_print_segment_timeline_entry(out, cache, indent, s_time, s_show_time, prev->duration, rcount);
 			//start new one
-			gf_mpd_nl(out, indent+1);
-			gf_fprintf(out, "<S");
+			s_show_time = GF_FALSE;
 			if (se->start_time != start_time) {
-				gf_fprintf(out, " t=\""LLD"\"", se->start_time);
+				s_show_time = GF_TRUE;
 				start_time = se->start_time;
 			}
-			if (se->duration) gf_fprintf(out, " d=\"%d\"", se->duration);
+			s_time = start_time;
 			rcount=0;
 		} else {
 			rcount++;
@@ -2823,10 +2981,9 @@ static void gf_mpd_print_segment_timeline(FILE *out, GF_MPD_SegmentTimeline *tl,
 		prev = se;
 	}
 	//close last entry
-	if (rcount) gf_fprintf(out, " r=\"%d\"", rcount);
-	gf_fprintf(out, "/>");
-	gf_mpd_lf(out, indent);
-
+	gf_mpd_print_segment_timeline_entry(out, cache, indent, s_time, s_show_time, prev->duration, rcount);
+	if (cache)
+		gf_mpd_print_cache_flush(cache, out);
 
 done_tl:
 	gf_mpd_nl(out, indent);
@@ -3763,6 +3920,7 @@ static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period
 	char *force_url=NULL;
 	const char *last_kms = NULL;
 	Bool close_file = GF_FALSE;
+	GF_MPD_PrintCache *cache = NULL;
 
 	if (!strcmp(m3u8_name, "std")) out = stdout;
 	else if (mpd->create_m3u8_files) {
@@ -3770,7 +3928,8 @@ static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period
 		if (!out) return GF_IO_ERR;
 		close_file = GF_TRUE;
 	} else {
-		out = gf_file_temp(NULL);
+		out = gf_file_mem_new();
+		if (!out) return GF_OUT_OF_MEM;
 		if (rep->m3u8_var_file) gf_fclose(rep->m3u8_var_file);
 		rep->m3u8_var_file = out;
 	}
@@ -3826,11 +3985,43 @@ static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period
 			}
 		}
 
+		//segment entries of live playlists are mostly the same from one update to the next
+		if ((mpd->type == GF_MPD_TYPE_DYNAMIC) && !rep->crypto_type) {
+			u32 ctx = rep->timescale;
+			if (force_base_url) ctx ^= gf_crc_32(force_base_url, (u32) strlen(force_base_url));
+			cache = gf_mpd_print_cache_begin(&rep->m3u8_cache, 0, ctx);
+		}
+
 		for (i=rep->tsb_first_entry; i<count; i++) {
 			Double dur;
 			sctx = gf_list_get(rep->state_seg_list, i);
 			gf_assert(sctx->filename);
 
+			if (cache) {
+				//LL-HLS parts are listed for the last segments and change at each update, stop caching
+				if (sctx->llhls_mode && (i+4>=count)) {
+					gf_mpd_print_cache_flush(cache, out);
+					cache = NULL;
+				} else {
+					u32 start;
+					if (gf_mpd_print_cache_reuse(cache, sctx->time, sctx->dur, sctx->seg_num, 0))
+						continue;
+					start = (u32) gf_ftell(cache->text);
+					dur = (Double) sctx->dur;
+					dur /= rep->timescale;
+					gf_fprintf(cache->text, "#EXTINF:%g,\n", dur);
+					if (force_base_url)
+						force_url = gf_url_concatenate(force_base_url, sctx->filename);
+					gf_fprintf(cache->text, "%s\n", force_url ? force_url : sctx->filename);
+					if (force_url) {
+						gf_free(force_url);
+						force_url = NULL;
+					}
+					gf_mpd_print_cache_add(cache, start, sctx->time, sctx->dur, sctx->seg_num, 0);
+					continue;
+				}
+			}
+
 			hls_insert_crypt_info(out, rep, sctx, &last_kms);
 
 			u64 next_br_start_plus_one=0;
@@ -3936,7 +4127,7 @@ static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period
 								gf_dynstrcat(&par_url, "../", NULL);
 								gf_dynstrcat(&par_url, o_name, NULL);
 							}
-							fprintf(out, "#EXT-X-RENDITION-REPORT:URI=\"%s\",LAST-MSN=%d,LAST-PART=%d\n", par_url ? par_url : o_name, o_sctx->seg_num, o_sctx->nb_frags);
+							gf_fprintf(out, "#EXT-X-RENDITION-REPORT:URI=\"%s\",LAST-MSN=%d,LAST-PART=%d\n", par_url ? par_url : o_name, o_sctx->seg_num, o_sctx->nb_frags);
 							if (par_url) gf_free(par_url);
 						}
 					}
@@ -3960,6 +4151,8 @@ static GF_Err gf_mpd_write_m3u8_playlist(const GF_MPD *mpd, const GF_MPD_Period
 				force_url = NULL;
 			}
 		}
+		if (cache)
+			gf_mpd_print_cache_flush(cache, out);
 	}
 	//byte-range in single file
 	else {
@@ -151,6 +151,13 @@ typedef struct
 	void *udta;
 } GF_LCTObject;
 
+//entry of the object index of a service, several entries may point to the same object (flute LL chunks)
+typedef struct
+{
+	u32 tsi, toi;
+	GF_LCTObject *obj;
+} GF_LCTObjectIndexEntry;
+
 typedef struct
 {
 	GF_Socket *sock;
@@ -168,7 +175,7 @@ typedef enum
 	GF_ROUTE_TUNE_SLS_ONLY,
 } GF_ROUTETuneMode;
 
-typedef GF_Err (*gf_service_process)(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, GF_ROUTESession *route_sess);
+typedef GF_Err (*gf_service_process)(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, GF_ROUTESession *route_sess, u8 *data, u32 nb_read);
 struct __route_service
 {
 	u32 service_id;
@@ -179,6 +186,9 @@ struct __route_service
 	u32 secondary_sockets;
 	GF_List *objects;
 	GF_LCTObject *last_active_obj;
+	//open-addressing hash index of objects by TSI/TOI, size is a power of 2
+	GF_LCTObjectIndexEntry *obj_index;
+	u32 obj_index_size, obj_index_count;
 	u32 nb_media_streams;
 	//number of active session running on main socket
 	u32 nb_active;
@@ -212,6 +222,10 @@ struct __gf_routedmx {
 	GF_Socket *atsc_sock;
 	u8 *buffer;
 	u32 buffer_size;
+	//batched reception, datagrams are received in consecutive slots of rx_slot_size bytes
+	u8 *rx_buf;
+	u32 *rx_sizes;
+	u32 rx_batch, rx_slot_size;
 	u8 *unz_buffer;
 	u32 unz_buffer_size;
 
@@ -247,8 +261,8 @@ struct __gf_routedmx {
 	Bool dvb_mabr;
 };
 
-static GF_Err dmx_process_service_route(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, GF_ROUTESession *route_sess);
-static GF_Err dmx_process_service_dvb_flute(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, GF_ROUTESession *route_sess);
+static GF_Err dmx_process_service_route(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, GF_ROUTESession *route_sess, u8 *data, u32 nb_read);
+static GF_Err dmx_process_service_dvb_flute(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, GF_ROUTESession *route_sess, u8 *data, u32 nb_read);
 
 
 static void gf_route_static_files_del(GF_List *files)
@@ -303,6 +317,7 @@ static void gf_route_service_del(GF_ROUTEDmx *routedmx, GF_ROUTEService *s)
 		gf_route_lct_obj_del(o);
 	}
 	gf_list_del(s->objects);
+	if (s->obj_index) gf_free(s->obj_index);
 
 	while (gf_list_count(s->route_sessions)) {
 		GF_ROUTESession *rsess = gf_list_pop_back(s->route_sessions);
@@ -321,6 +336,8 @@ void gf_route_dmx_del(GF_ROUTEDmx *routedmx)
 	if (!routedmx) return;
 
 	if (routedmx->buffer) gf_free(routedmx->buffer);
+	if (routedmx->rx_buf) gf_free(routedmx->rx_buf);
+	if (routedmx->rx_sizes) gf_free(routedmx->rx_sizes);
 	if (routedmx->unz_buffer) gf_free(routedmx->unz_buffer);
 	if (routedmx->atsc_sock) gf_sk_del(routedmx->atsc_sock);
     if (routedmx->dom) gf_xml_dom_del(routedmx->dom);
@@ -643,6 +660,22 @@ GF_Err gf_route_set_reorder(GF_ROUTEDmx *routedmx, Bool force_reorder, u32 timeo
 	return GF_OK;
 }
 
+GF_EXPORT
+GF_Err gf_route_set_recv_batch(GF_ROUTEDmx *routedmx, u32 nb_packets)
+{
+	if (!routedmx) return GF_BAD_PARAM;
+	if (nb_packets<2) nb_packets = 0;
+	routedmx->rx_batch = 0;
+	if (!nb_packets) return GF_OK;
+	//buffer may be reallocated when processing signaling, use a fixed slot size
+	routedmx->rx_slot_size = routedmx->buffer_size;
+	routedmx->rx_buf = gf_realloc(routedmx->rx_buf, nb_packets * routedmx->rx_slot_size);
+	routedmx->rx_sizes = gf_realloc(routedmx->rx_sizes, nb_packets * sizeof(u32));
+	if (!routedmx->rx_buf || !routedmx->rx_sizes) return GF_OUT_OF_MEM;
+	routedmx->rx_batch = nb_packets;
+	return GF_OK;
+}
+
 GF_EXPORT
 GF_Err gf_route_set_allow_progressive_dispatch(GF_ROUTEDmx *routedmx, Bool allow_progressive)
 {
@@ -770,6 +803,134 @@ static const char *get_lct_obj_status_name(GF_LCTObjectStatus status)
 }
 #endif // GPAC_DISABLE_LOG
 
+static GFINLINE u32 gf_route_obj_hash(u32 tsi, u32 toi)
+{
+	u32 h = (tsi * 0x9E3779B1) ^ toi;
+	h ^= h >> 16;
+	h *= 0x85EBCA6B;
+	h ^= h >> 13;
+	return h;
+}
+
+static GF_LCTObject *gf_route_obj_index_find(GF_ROUTEService *s, u32 tsi, u32 toi)
+{
+	u32 mask, idx;
+	if (!s->obj_index_count) return NULL;
+	mask = s->obj_index_size - 1;
+	idx = gf_route_obj_hash(tsi, toi) & mask;
+	while (s->obj_index[idx].obj) {
+		if ((s->obj_index[idx].tsi==tsi) && (s->obj_index[idx].toi==toi))
+			return s->obj_index[idx].obj;
+		idx = (idx+1) & mask;
+	}
+	return NULL;
+}
+
+static GF_Err gf_route_obj_index_add(GF_ROUTEService *s, u32 tsi, u32 toi, GF_LCTObject *obj)
+{
+	u32 mask, idx;
+	//keep load factor below 1/2
+	if (2*(s->obj_index_count+1) > s->obj_index_size) {
+		u32 i, old_size = s->obj_index_size;
+		GF_LCTObjectIndexEntry *old = s->obj_index;
+		s->obj_index_size = old_size ? 2*old_size : 64;
+		s->obj_index = gf_malloc(sizeof(GF_LCTObjectIndexEntry) * s->obj_index_size);
+		if (!s->obj_index) {
+			s->obj_index = old;
+			s->obj_index_size = old_size;
+			return GF_OUT_OF_MEM;
+		}
+		memset(s->obj_index, 0, sizeof(GF_LCTObjectIndexEntry) * s->obj_index_size);
+		mask = s->obj_index_size - 1;
+		for (i=0; i<old_size; i++) {
+			if (!old[i].obj) continue;
+			idx = gf_route_obj_hash(old[i].tsi, old[i].toi) & mask;
+			while (s->obj_index[idx].obj) idx = (idx+1) & mask;
+			s->obj_index[idx] = old[i];
+		}
+		if (old) gf_free(old);
+	}
+	mask = s->obj_index_size - 1;
+	idx = gf_route_obj_hash(tsi, toi) & mask;
+	while (s->obj_index[idx].obj) {
+		if ((s->obj_index[idx].obj==obj) && (s->obj_index[idx].tsi==tsi) && (s->obj_index[idx].toi==toi))
+			return GF_OK;
+		idx = (idx+1) & mask;
+	}
+	s->obj_index[idx].tsi = tsi;
+	s->obj_index[idx].toi = toi;
+	s->obj_index[idx].obj = obj;
+	s->obj_index_count++;
+	return GF_OK;
+}
+
+static void gf_route_obj_index_rem(GF_ROUTEService *s, u32 tsi, u32 toi, GF_LCTObject *obj)
+{
+	u32 mask, idx, next;
+	if (!s->obj_index_count) return;
+	mask = s->obj_index_size - 1;
+	idx = gf_route_obj_hash(tsi, toi) & mask;
+	while (1) {
+		if (!s->obj_index[idx].obj) return;
+		if ((s->obj_index[idx].obj==obj) && (s->obj_index[idx].tsi==tsi) && (s->obj_index[idx].toi==toi))
+			break;
+		idx = (idx+1) & mask;
+	}
+	s->obj_index_count--;
+	//backward shift deletion: move up following entries of the cluster which are not at their home slot
+	next = idx;
+	while (1) {
+		u32 home;
+		next = (next+1) & mask;
+		if (!s->obj_index[next].obj) break;
+		home = gf_route_obj_hash(s->obj_index[next].tsi, s->obj_index[next].toi) & mask;
+		//entry can move to idx only if its home slot is not in ]idx, next]
+		if (((next > idx) && ((home <= idx) || (home > next)))
+			|| ((next < idx) && ((home <= idx) && (home > next)))
+		) {
+			s->obj_index[idx] = s->obj_index[next];
+			idx = next;
+		}
+	}
+	s->obj_index[idx].obj = NULL;
+}
+
+//index object and its flute LL chunks
+static void gf_route_obj_index_add_obj(GF_ROUTEService *s, GF_LCTObject *obj)
+{
+	u32 i;
+	gf_route_obj_index_add(s, obj->tsi, obj->toi, obj);
+	for (i=0; i<obj->ll_maps_count; i++) {
+		if (obj->ll_map[i].toi != obj->toi)
+			gf_route_obj_index_add(s, obj->tsi, obj->ll_map[i].toi, obj);
+	}
+}
+
+static void gf_route_obj_index_rem_obj(GF_ROUTEService *s, GF_LCTObject *obj)
+{
+	u32 i;
+	gf_route_obj_index_rem(s, obj->tsi, obj->toi, obj);
+	for (i=0; i<obj->ll_maps_count; i++) {
+		if (obj->ll_map[i].toi != obj->toi)
+			gf_route_obj_index_rem(s, obj->tsi, obj->ll_map[i].toi, obj);
+	}
+}
+
+//get an object from the reservoir, preferably with a payload large enough for size bytes
+static GF_LCTObject *gf_route_obj_from_reservoir(GF_ROUTEDmx *routedmx, u32 size)
+{
+	u32 i = gf_list_count(routedmx->object_reservoir);
+	while (i) {
+		GF_LCTObject *obj = gf_list_get(routedmx->object_reservoir, i-1);
+		if (obj->alloc_size >= size) {
+			gf_list_rem(routedmx->object_reservoir, i-1);
+			return obj;
+		}
+		i--;
+	}
+	return gf_list_pop_back(routedmx->object_reservoir);
+}
+
 static void gf_route_obj_to_reservoir(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, GF_LCTObject *obj)
 {
 	assert (obj->status != GF_LCT_OBJ_RECEPTION);
@@ -786,6 +947,7 @@ static void gf_route_obj_to_reservoir(GF_ROUTEDmx *routedmx, GF_ROUTEService *s,
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_ROUTE, ("[%s] Moving object tsi %u toi %u to reservoir (status %s)\n", s->log_name, obj->tsi, obj->toi, get_lct_obj_status_name(obj->status) ));
 
 	if (s->last_active_obj==obj) s->last_active_obj = NULL;
+	gf_route_obj_index_rem_obj(s, obj);
 	obj->closed_flag = 0;
 	obj->force_keep = 0;
 	obj->nb_bytes = 0;
@@ -988,7 +1150,9 @@ static GF_Err gf_route_dmx_process_dvb_flute_signaling(GF_ROUTEDmx *routedmx, GF
 			obj = gf_list_get(s->objects, i);
 			if ((obj->toi==toi) && (obj->tsi==tsi)) break;
 			if ((obj->tsi==tsi) && obj->rlct_file && !strcmp(obj->rlct_file->filename, content_location)) {
+				gf_route_obj_index_rem(s, obj->tsi, obj->toi, obj);
 				obj->toi = toi;
+				gf_route_obj_index_add(s, obj->tsi, obj->toi, obj);
 				break;
 			}
 			obj=NULL;
@@ -1045,6 +1209,7 @@ static GF_Err gf_route_dmx_process_dvb_flute_signaling(GF_ROUTEDmx *routedmx, GF
 				obj->ll_maps_count++;
 				if (obj->rlct_file) obj->rlct_file->can_remove = GF_FALSE;
 				ll_map->toi = toi;
+				gf_route_obj_index_add(s, tsi, toi, obj);
 				ll_map->offset = ll_offset;
 				ll_map->length = content_length;
 				ll_map->flute_symbol_size = flute_symbol_size;
@@ -1166,6 +1331,7 @@ static GF_Err gf_route_dmx_process_dvb_flute_signaling(GF_ROUTEDmx *routedmx, GF
 		if (query_sep) query_sep[0] = 0;
 		else if (frag_sep) frag_sep[0] = 0;
 		gf_list_add(s->objects, obj);
+		gf_route_obj_index_add_obj(s, obj);
 	}
 	return GF_OK;
 }
@@ -1466,6 +1632,23 @@ static GF_Err gf_route_service_flush_object(GF_ROUTEService *s, GF_LCTObject *ob
 	return GF_EOS;
 }
 
+//binary search in received fragments, returns index of first fragment whose end (or start if use_start is set) is at or after offset
+//(strictly after for start), nb_frags if none
+static u32 gf_route_obj_frag_search(GF_LCTObject *obj, u32 offset, Bool use_start)
+{
+	u32 lo = 0, hi = obj->nb_frags;
+	//in-order reception, new data is after the last fragment
+	if (hi && (obj->frags[hi-1].offset + obj->frags[hi-1].size < offset))
+		return hi;
+	while (lo < hi) {
+		u32 mid = (lo + hi) / 2;
+		Bool after = use_start ? (obj->frags[mid].offset > offset) : (obj->frags[mid].offset + obj->frags[mid].size >= offset);
+		if (after) hi = mid;
+		else lo = mid+1;
+	}
+	return lo;
+}
+
 static GF_Err gf_route_service_gather_object(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, u32 tsi, u32 toi, u32 start_offset, char *data, u32 size, u32 total_len, Bool close_flag, Bool in_order, GF_ROUTELCTChannel *rlct, GF_LCTObject **gather_obj, s32 flute_esi, u32 fdt_symbol_length)
 {
 	Bool done;
@@ -1526,40 +1709,43 @@ static GF_Err gf_route_service_gather_object(GF_ROUTEDmx *routedmx, GF_ROUTEServ
 	}
 
 	if (!obj || (obj->tsi!=tsi) || (obj->toi!=toi) || obj->ll_maps_count) {
-		count = gf_list_count(s->objects);
-		for (i=0; i<count; i++) {
-			obj = gf_list_get(s->objects, i);
-
-			if (obj->ll_maps_count && (obj->tsi==tsi)) {
-				for (j=0;j<obj->ll_maps_count;j++) {
-					if (obj->ll_map[j].toi == toi) {
-						ll_map = &obj->ll_map[j];
-						break;
-					}
+		//TOI is either the object TOI or the TOI of one of its flute LL chunks
+		obj = gf_route_obj_index_find(s, tsi, toi);
+		if (obj && obj->ll_maps_count) {
+			for (j=0;j<obj->ll_maps_count;j++) {
+				if (obj->ll_map[j].toi == toi) {
+					ll_map = &obj->ll_map[j];
+					break;
 				}
-				if (ll_map) break;
 			}
-			if ((obj->toi == toi) && (obj->tsi==tsi)) break;
-
-			if (!tsi && !obj->tsi && ((obj->toi&0xFFFFFF00) == (toi&0xFFFFFF00)) ) {
-				//change in version of bundle but same other flags: reuse this one
-				obj->nb_frags = obj->nb_recv_frags = 0;
-				obj->nb_bytes = obj->nb_recv_bytes = 0;
-				obj->total_length = total_len;
-				if (obj->total_length>obj->alloc_size) {
-					gf_mx_p(routedmx->blob_mx);
-					obj->payload = gf_realloc(obj->payload, obj->total_length+1);
-					obj->alloc_size = obj->total_length;
-					obj->blob.size = obj->total_length;
-					obj->blob.data = obj->payload;
-					gf_mx_v(routedmx->blob_mx);
+		}
+		//signaling objects on TSI 0 are few, look for a previous version of the bundle
+		if (!obj && !tsi) {
+			count = gf_list_count(s->objects);
+			for (i=0; i<count; i++) {
+				obj = gf_list_get(s->objects, i);
+				if (!obj->tsi && ((obj->toi&0xFFFFFF00) == (toi&0xFFFFFF00)) ) {
+					//change in version of bundle but same other flags: reuse this one
+					obj->nb_frags = obj->nb_recv_frags = 0;
+					obj->nb_bytes = obj->nb_recv_bytes = 0;
+					obj->total_length = total_len;
+					if (obj->total_length>obj->alloc_size) {
+						gf_mx_p(routedmx->blob_mx);
+						obj->payload = gf_realloc(obj->payload, obj->total_length+1);
+						obj->alloc_size = obj->total_length;
+						obj->blob.size = obj->total_length;
+						obj->blob.data = obj->payload;
+						gf_mx_v(routedmx->blob_mx);
+					}
+					gf_route_obj_index_rem(s, obj->tsi, obj->toi, obj);
+					obj->toi = toi;
+					gf_route_obj_index_add(s, obj->tsi, obj->toi, obj);
+					obj->rlct = rlct;
+					obj->status = GF_LCT_OBJ_INIT;
+					break;
 				}
-				obj->toi = toi;
-				obj->rlct = rlct;
-				obj->status = GF_LCT_OBJ_INIT;
-				break;
+				obj = NULL;
 			}
-			obj = NULL;
 		}
 	}
 	if ((s->protocol==GF_SERVICE_DVB_FLUTE) && !fdt_symbol_length) {
@@ -1581,7 +1767,7 @@ static GF_Err gf_route_service_gather_object(GF_ROUTEDmx *routedmx, GF_ROUTEServ
 	}
 
 	if (!obj) {
-		obj = gf_list_pop_back(routedmx->object_reservoir);
+		obj = gf_route_obj_from_reservoir(routedmx, total_len);
 		if (!obj) {
 			GF_SAFEALLOC(obj, GF_LCTObject);
 			if (!obj) {
@@ -1631,6 +1817,7 @@ static GF_Err gf_route_service_gather_object(GF_ROUTEDmx *routedmx, GF_ROUTEServ
 		}
 		obj->start_time_ms = gf_sys_clock();
 		gf_list_add(s->objects, obj);
+		gf_route_obj_index_add_obj(s, obj);
 	} else if (!obj->total_length && total_len) {
 		GF_LOG(GF_LOG_INFO, GF_LOG_ROUTE, ("[%s] Object TSI %u TOI %u was started without total-length assigned, assigning to %u\n", s->log_name, tsi, toi, total_len));
 		// Check if there are no fragments in the object that extend beyond the total length
@@ -1770,23 +1957,10 @@ static GF_Err gf_route_service_gather_object(GF_ROUTEDmx *routedmx, GF_ROUTEServ
     }
 	obj->nb_recv_bytes += size;
 
-	int start_frag = -1;
-	int end_frag = -1;
-	for (i=0; (i < obj->nb_frags) && (start_frag==-1 || end_frag==-1); i++) {
-		if((start_frag == -1) && (start_offset <= obj->frags[i].offset + obj->frags[i].size)) {
-			start_frag = i;
-		}
-
-		if((end_frag == -1) && (start_offset + size < obj->frags[i].offset)) {
-			end_frag = i;
-		}
-	}
-	if(start_frag == -1) {
-		start_frag = obj->nb_frags;
-	}
-	if(end_frag == -1) {
-		end_frag = obj->nb_frags;
-	}
+	//fragments are sorted and disjoint: first fragment ending at or after start_offset,
+	//and first fragment starting strictly after the end of the received data
+	int start_frag = gf_route_obj_frag_search(obj, start_offset, GF_FALSE);
+	int end_frag = gf_route_obj_frag_search(obj, start_offset + size, GF_TRUE);
 
 	if (start_frag == end_frag) {
 		// insert new fragment between two already received fragments or at the end
@@ -2543,10 +2717,10 @@ static GF_Err gf_route_dmx_process_service_signaling(GF_ROUTEDmx *routedmx, GF_R
 
 #define GF_ROUTE_MAX_SIZE 0x40000000
 
-static GF_Err dmx_process_service_route(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, GF_ROUTESession *route_sess)
+static GF_Err dmx_process_service_route(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, GF_ROUTESession *route_sess, u8 *data, u32 nb_read)
 {
 	GF_Err e;
-	u32 nb_read, v, C, psi, S, O, H, /*Res, A,*/ B, hdr_len, cp, cc, tsi, toi, pos;
+	u32 v, C, psi, S, O, H, /*Res, A,*/ B, hdr_len, cp, cc, tsi, toi, pos;
 	u32 /*a_G=0, a_U=0,*/ a_S=0, a_M=0/*, a_A=0, a_H=0, a_D=0*/;
 	u64 tol_size=0;
 	Bool in_order = GF_TRUE;
@@ -2554,21 +2728,7 @@ static GF_Err dmx_process_service_route(GF_ROUTEDmx *routedmx, GF_ROUTEService *
 	GF_ROUTELCTChannel *rlct=NULL;
 	GF_LCTObject *gather_object=NULL;
 
-	if (route_sess) {
-		e = gf_sk_receive_no_select(route_sess->sock, routedmx->buffer, routedmx->buffer_size, &nb_read);
-	} else {
-		e = gf_sk_receive_no_select(s->sock, routedmx->buffer, routedmx->buffer_size, &nb_read);
-	}
-
-	if (e != GF_OK) return e;
-	gf_assert(nb_read);
-
-	routedmx->nb_packets++;
-	routedmx->total_bytes_recv += nb_read;
-	routedmx->last_pck_time = gf_sys_clock_high_res();
-	if (!routedmx->first_pck_time) routedmx->first_pck_time = routedmx->last_pck_time;
-
-	e = gf_bs_reassign_buffer(routedmx->bs, routedmx->buffer, nb_read);
+	e = gf_bs_reassign_buffer(routedmx->bs, data, nb_read);
 	if (e != GF_OK) return e;
 
 	//parse LCT header
@@ -2756,7 +2916,7 @@ static GF_Err dmx_process_service_route(GF_ROUTEDmx *routedmx, GF_ROUTEService *
 	}
 	pos = (u32) gf_bs_get_position(routedmx->bs);
 
-	e = gf_route_service_gather_object(routedmx, s, tsi, toi, start_offset, routedmx->buffer + pos, nb_read-pos, (u32) tol_size, B, in_order, rlct, &gather_object, -1, 0);
+	e = gf_route_service_gather_object(routedmx, s, tsi, toi, start_offset, data + pos, nb_read-pos, (u32) tol_size, B, in_order, rlct, &gather_object, -1, 0);
 
 	if (e==GF_EOS) {
 		if (!tsi) {
@@ -2786,11 +2946,11 @@ static GF_Err dmx_process_service_route(GF_ROUTEDmx *routedmx, GF_ROUTEService *
 	return GF_OK;
 }
 
-static GF_Err dmx_process_service_dvb_flute(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, GF_ROUTESession *route_sess)
+static GF_Err dmx_process_service_dvb_flute(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, GF_ROUTESession *route_sess, u8 *data, u32 nb_read)
 {
 	GF_Err e;
 	u32 fdt_symbol_length=0;
-	u32 nb_read, cp , v, C, psi, S, O, H, /*Res, A,*/ B, hdr_len, cc, tsi, toi, pos;
+	u32 cp , v, C, psi, S, O, H, /*Res, A,*/ B, hdr_len, cc, tsi, toi, pos;
 	u32 /*a_G=0, a_U=0,*/ a_S=0, a_M=0/*, a_A=0, a_H=0, a_D=0*/;
 	u64 transfert_length=0;
 	u32 start_offset=0;
@@ -2798,21 +2958,7 @@ static GF_Err dmx_process_service_dvb_flute(GF_ROUTEDmx *routedmx, GF_ROUTEServi
 	GF_LCTObject *gather_object=NULL;
 	u32 /*SBN,*/ESI; //Source Block Length  | Encoding Symbol  
 
-	if (route_sess) {
-		e = gf_sk_receive_no_select(route_sess->sock, routedmx->buffer, routedmx->buffer_size, &nb_read);
-	} else {
-		e = gf_sk_receive_no_select(s->sock, routedmx->buffer, routedmx->buffer_size, &nb_read);
-	}
-
-	if (e != GF_OK) return e;
-	gf_assert(nb_read);
-
-	routedmx->nb_packets++;
-	routedmx->total_bytes_recv += nb_read;
-	routedmx->last_pck_time = gf_sys_clock_high_res();
-	if (!routedmx->first_pck_time) routedmx->first_pck_time = routedmx->last_pck_time;
-
-	e = gf_bs_reassign_buffer(routedmx->bs, routedmx->buffer, nb_read);
+	e = gf_bs_reassign_buffer(routedmx->bs, data, nb_read);
 	if (e != GF_OK) return e;
 
 	//parse LCT header
@@ -2939,7 +3085,7 @@ static GF_Err dmx_process_service_dvb_flute(GF_ROUTEDmx *routedmx, GF_ROUTEServi
 		}
 	}
 
-	e = gf_route_service_gather_object(routedmx, s, tsi, toi, start_offset, routedmx->buffer + pos, nb_read-pos, (u32) transfert_length, B, GF_FALSE, rlct, &gather_object, ESI, fdt_symbol_length);
+	e = gf_route_service_gather_object(routedmx, s, tsi, toi, start_offset, data + pos, nb_read-pos, (u32) transfert_length, B, GF_FALSE, rlct, &gather_object, ESI, fdt_symbol_length);
 
 	start_offset += (nb_read ) * ESI; 
 	
@@ -2971,6 +3117,44 @@ static GF_Err dmx_process_service_dvb_flute(GF_ROUTEDmx *routedmx, GF_ROUTEServi
 	return GF_OK;
 }
 
+static void dmx_update_rx_stats(GF_ROUTEDmx *routedmx, u32 nb_read)
+{
+	routedmx->nb_packets++;
+	routedmx->total_bytes_recv += nb_read;
+	routedmx->last_pck_time = gf_sys_clock_high_res();
+	if (!routedmx->first_pck_time) routedmx->first_pck_time = routedmx->last_pck_time;
+}
+
+//read pending datagrams on service or session socket and process them
+static GF_Err dmx_process_service_socket(GF_ROUTEDmx *routedmx, GF_ROUTEService *s, GF_ROUTESession *route_sess)
+{
+	GF_Err e;
+	u32 i, nb_read=0;
+	GF_Socket *sock = route_sess ? route_sess->sock : s->sock;
+
+	if (routedmx->rx_batch) {
+		GF_Err res = GF_OK;
+		u32 nb_pck=0;
+		e = gf_sk_receive_batch(sock, routedmx->rx_buf, routedmx->rx_slot_size, routedmx->rx_batch, routedmx->rx_sizes, NULL, &nb_pck);
+		if (e != GF_OK) return e;
+		//process all received datagrams, report the first error
+		for (i=0; i<nb_pck; i++) {
+			nb_read = routedmx->rx_sizes[i];
+			if (!nb_read) continue;
+			dmx_update_rx_stats(routedmx, nb_read);
+			e = s->process_service(routedmx, s, route_sess, routedmx->rx_buf + i*routedmx->rx_slot_size, nb_read);
+			if (e && !res) res = e;
+		}
+		return res;
+	}
+
+	e = gf_sk_receive_no_select(sock, routedmx->buffer, routedmx->buffer_size, &nb_read);
+	if (e != GF_OK) return e;
+	gf_assert(nb_read);
+	dmx_update_rx_stats(routedmx, nb_read);
+	return s->process_service(routedmx, s, route_sess, routedmx->buffer, nb_read);
+}
+
 static GF_Err gf_route_dmx_process_lls(GF_ROUTEDmx *routedmx)
 {
 	u32 read;
@@ -2984,10 +3168,7 @@ static GF_Err gf_route_dmx_process_lls(GF_ROUTEDmx *routedmx)
 	if (e)
 		return e;
 
-	routedmx->nb_packets++;
-	routedmx->total_bytes_recv += read;
-	routedmx->last_pck_time = gf_sys_clock_high_res();
-	if (!routedmx->first_pck_time) routedmx->first_pck_time = routedmx->last_pck_time;
+	dmx_update_rx_stats(routedmx, read);
 
 	lls_table_id = routedmx->buffer[0];
 	lls_group_id = routedmx->buffer[1];
@@ -3104,7 +3285,7 @@ GF_Err gf_route_dmx_process(GF_ROUTEDmx *routedmx)
 				continue;
 		}
 		if (gf_sk_group_sock_is_set(routedmx->active_sockets, s->sock, GF_SK_SELECT_READ)) {
-			e = s->process_service(routedmx, s, NULL);
+			e = dmx_process_service_socket(routedmx, s, NULL);
 			if (e) return e;
 		}
 		if (s->tune_mode!=GF_ROUTE_TUNE_ON) continue;
@@ -3114,7 +3295,7 @@ GF_Err gf_route_dmx_process(GF_ROUTEDmx *routedmx)
 		j=0;
 		while ((rsess = (GF_ROUTESession *)gf_list_enum(s->route_sessions, &j) )) {
 			if (gf_sk_group_sock_is_set(routedmx->active_sockets, rsess->sock, GF_SK_SELECT_READ)) {
-				e = s->process_service(routedmx, s, rsess);
+				e = dmx_process_service_socket(routedmx, s, rsess);
 				if (e) return e;
 			}
 		}
@@ -3390,12 +3571,8 @@ GF_Err gf_routedmx_patch_frag_info(GF_ROUTEDmx *routedmx, u32 service_id, GF_ROU
 		s = NULL;
 	}
 	if (!s) return GF_BAD_PARAM;
-	i=0;
-	while ((obj = gf_list_enum(s->objects, &i))) {
-		if ((obj->tsi == finfo->tsi) && (obj->toi == finfo->toi))
-			break;
-	}
-	if (!obj) return GF_BAD_PARAM;
+	obj = gf_route_obj_index_find(s, finfo->tsi, finfo->toi);
+	if (!obj || (obj->toi != finfo->toi)) return GF_BAD_PARAM;
 	gf_mx_p(obj->blob.mx);
 
 	for (i=0; i<obj->nb_frags; i++) {
@@ -0,0 +1,142 @@
+#include "tests.h"
+#include <gpac/mpegts.h>
+#include <gpac/constants.h>
+
+#ifndef GPAC_DISABLE_MPEG2TS_MUX
+
+#define UTM_NB_AU	250
+#define UTM_AU_SIZE	20000
+
+typedef struct
+{
+	GF_ESInterface esi;
+	u8 *data;
+	u32 au_num, nb_au, au_size;
+} UTMStream;
+
+//dispatch one AU per flush request, one SAP every 25 AUs
+static GF_Err utm_input_ctrl(GF_ESInterface *ifce, u32 act_type, void *param)
+{
+	GF_ESIPacket es_pck;
+	UTMStream *st = (UTMStream *) ifce->input_udta;
+	if (act_type != GF_ESI_INPUT_DATA_FLUSH) return GF_OK;
+	if (st->au_num == st->nb_au) {
+		ifce->caps |= GF_ESI_STREAM_IS_OVER;
+		return GF_OK;
+	}
+	memset(&es_pck, 0, sizeof(GF_ESIPacket));
+	es_pck.flags = GF_ESI_DATA_AU_START | GF_ESI_DATA_AU_END | GF_ESI_DATA_HAS_CTS;
+	es_pck.sap_type = (st->au_num % 25) ? 0 : 1;
+	es_pck.cts = es_pck.dts = (u64) st->au_num * ifce->timescale / 25;
+	es_pck.duration = ifce->timescale / 25;
+	//varying AU sizes to exercise PES padding
+	es_pck.data_len = st->au_size - (st->au_num * 97) % (st->au_size/2);
+	es_pck.data = st->data;
+	st->au_num++;
+	ifce->output_ctrl(ifce, GF_ESI_OUTPUT_DATA_DISPATCH, &es_pck);
+	return GF_OK;
+}
+
+static void utm_stream_init(UTMStream *st, u32 stream_id, u32 stream_type, u32 codecid, u32 au_size, u8 *data)
+{
+	memset(st, 0, sizeof(UTMStream));
+	st->esi.stream_id = stream_id;
+	st->esi.stream_type = stream_type;
+	st->esi.codecid = codecid;
+	st->esi.timescale = 90000;
+	st->esi.bit_rate = au_size * 8 * 25;
+	st->esi.input_ctrl = utm_input_ctrl;
+	st->esi.input_udta = st;
+	st->nb_au = UTM_NB_AU;
+	st->au_size = au_size;
+	st->data = data;
+}
+
+//video and audio program muxed VBR or at fixed rate
+static GF_M2TS_Mux *utm_mux_new(UTMStream *video, UTMStream *audio, u32 mux_rate, u8 *data)
+{
+	GF_M2TS_Mux_Program *prog;
+	GF_M2TS_Mux *mux = gf_m2ts_mux_new(mux_rate, GF_M2TS_PSI_DEFAULT_REFRESH_RATE, GF_FALSE);
+	if (!mux) return NULL;
+	gf_m2ts_mux_set_initial_pcr(mux, 1000000);
+	//100ms PCR offset so that PES are not late at fixed rate
+	prog = gf_m2ts_mux_program_add(mux, 1, 100, GF_M2TS_PSI_DEFAULT_REFRESH_RATE, 9000, GF_M2TS_MPEG4_SIGNALING_NONE, 0, GF_FALSE, 0);
+	utm_stream_init(video, 1, GF_STREAM_VISUAL, GF_CODECID_MPEG2_MAIN, UTM_AU_SIZE, data);
+	utm_stream_init(audio, 2, GF_STREAM_AUDIO, GF_CODECID_MPEG_AUDIO, 400, data);
+	gf_m2ts_program_stream_add(prog, &video->esi, 101, GF_TRUE, GF_FALSE, GF_FALSE);
+	gf_m2ts_program_stream_add(prog, &audio->esi, 102, GF_FALSE, GF_FALSE, GF_FALSE);
+	mux->ref_pid = 101;
+	gf_m2ts_mux_update_config(mux, GF_TRUE);
+	return mux;
+}
+
+//mux to end of stream, one packet at a time if max_pck is 0, return output size
+static u32 utm_run(u32 mux_rate, u32 max_pck, u8 *data, u8 **out, u32 *nb_sap)
+{
+	u32 size=0, alloc=0, usec;
+	GF_M2TSMuxState status;
+	UTMStream video, audio;
+	GF_M2TS_Mux *mux = utm_mux_new(&video, &audio, mux_rate, data);
+	*out = NULL;
+	*nb_sap = 0;
+	if (!mux) return 0;
+
+	while (1) {
+		u32 nb_pck;
+		if (alloc < size + 188*(max_pck+1)) {
+			alloc += 188*10000;
+			*out = gf_realloc(*out, alloc);
+		}
+		if (!max_pck) {
+			const u8 *pck = gf_m2ts_mux_process(mux, &status, &usec);
+			nb_pck = pck ? 1 : 0;
+			if (pck) memcpy(*out + size, pck, 188);
+		} else {
+			nb_pck = gf_m2ts_mux_process_batch(mux, *out + size, max_pck, 0, &status, &usec);
+			assert_less_equal(nb_pck, max_pck);
+		}
+		if (nb_pck && mux->sap_inserted) (*nb_sap)++;
+		size += 188*nb_pck;
+		if ((status==GF_M2TS_STATE_EOS) || (!nb_pck && (status!=GF_M2TS_STATE_DATA)))
+			break;
+		//padding in fixed rate mode, stop after the last AU
+		if ((status==GF_M2TS_STATE_PADDING) && (video.esi.caps & GF_ESI_STREAM_IS_OVER) && (audio.esi.caps & GF_ESI_STREAM_IS_OVER))
+			break;
+	}
+	gf_m2ts_mux_del(mux);
+	return size;
+}
+
+unittest(m2ts_mux_batch)
+{
+	u32 i, j, nb_sap_ref, nb_sap;
+	u32 rates[] = {0, 10000000};
+	u32 batch_sizes[] = {1, 7, 200};
+	u32 log_level = gf_log_get_tool_level(GF_LOG_CONTAINER);
+	u8 *data = gf_malloc(UTM_AU_SIZE);
+	for (i=0; i<UTM_AU_SIZE; i++) data[i] = (u8) (i*13);
+	//late PES warnings are expected with synthetic input
+	gf_log_set_tool_level(GF_LOG_CONTAINER, GF_LOG_ERROR);
+
+	for (i=0; i<GF_ARRAY_LENGTH(rates); i++) {
+		u8 *ref;
+		u32 ref_size = utm_run(rates[i], 0, data, &ref, &nb_sap_ref);
+		assert_greater(ref_size, UTM_NB_AU*UTM_AU_SIZE/2);
+		assert_equal(nb_sap_ref, UTM_NB_AU/25);
+
+		//batches produce the same multiplex and report every SAP
+		for (j=0; j<GF_ARRAY_LENGTH(batch_sizes); j++) {
+			u8 *out;
+			u32 size = utm_run(rates[i], batch_sizes[j], data, &out, &nb_sap);
+			assert_equal(size, ref_size);
+			if (size==ref_size) assert_equal_mem(out, ref, size);
+			assert_equal(nb_sap, nb_sap_ref);
+			gf_free(out);
+		}
+		gf_free(ref);
+	}
+	gf_free(data);
+	gf_log_set_tool_level(GF_LOG_CONTAINER, log_level);
+}
+
+#endif //GPAC_DISABLE_MPEG2TS_MUX
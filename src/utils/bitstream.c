@@ -554,10 +554,94 @@ u8 gf_bs_read_bit(GF_BitStream *bs)
 #endif
 }
 
+/*memory read fast path: the next 64 bits are fetched in a single big-endian load of the 8 bytes following the current byte*/
+static GFINLINE u64 gf_bs_load_be64(const u8 *ptr)
+{
+	u64 v;
+	memcpy(&v, ptr, 8);
+#ifndef GPAC_BIG_ENDIAN
+#if defined(__GNUC__)
+	v = __builtin_bswap64(v);
+#elif defined(_MSC_VER)
+	v = _byteswap_uint64(v);
+#else
+	v = ((v & 0x00000000000000FFULL) << 56) | ((v & 0x000000000000FF00ULL) << 40)
+		| ((v & 0x0000000000FF0000ULL) << 24) | ((v & 0x00000000FF000000ULL) << 8)
+		| ((v >> 8) & 0x00000000FF000000ULL) | ((v >> 24) & 0x0000000000FF0000ULL)
+		| ((v >> 40) & 0x000000000000FF00ULL) | ((v >> 56) & 0x00000000000000FFULL);
+#endif
+#endif
+	return v;
+}
+
+static GFINLINE u32 gf_bs_clz64(u64 v)
+{
+#if defined(__GNUC__)
+	return (u32) __builtin_clzll(v);
+#else
+	u32 n = 0;
+	if (!(v & 0xFFFFFFFF00000000ULL)) { n += 32; v <<= 32; }
+	if (!(v & 0xFFFF000000000000ULL)) { n += 16; v <<= 16; }
+	if (!(v & 0xFF00000000000000ULL)) { n += 8; v <<= 8; }
+	if (!(v & 0xF000000000000000ULL)) { n += 4; v <<= 4; }
+	if (!(v & 0xC000000000000000ULL)) { n += 2; v <<= 2; }
+	if (!(v & 0x8000000000000000ULL)) { n += 1; }
+	return n;
+#endif
+}
+
+/*gets the next 64 bits left-aligned in win, returns GF_FALSE if not in memory read mode or less than 8 bytes are left*/
+static GFINLINE Bool gf_bs_fast_window(GF_BitStream *bs, u64 *win)
+{
+	u32 rem;
+	if (bs->bsmode != GF_BITSTREAM_READ) return GF_FALSE;
+	if (bs->position + 8 > bs->size) return GF_FALSE;
+	//remaining bits of current byte are left-aligned in the low byte of current
+	rem = 8 - bs->nbBits;
+	*win = gf_bs_load_be64((const u8 *) bs->original + bs->position);
+	if (rem) *win = ((u64) (bs->current & 0xFF) << 56) | (*win >> rem);
+	return GF_TRUE;
+}
+
+/*consumes nBits (1 to 64) of the window, returns GF_FALSE if a byte to load may be an emulation prevention byte, in which case the state is unchanged*/
+static GFINLINE Bool gf_bs_fast_skip(GF_BitStream *bs, u32 nBits)
+{
+	u32 i, nb_bytes, last_bits, rem = 8 - bs->nbBits;
+	const u8 *ptr;
+	if (nBits <= rem) {
+		bs->nbBits += nBits;
+		bs->current <<= nBits;
+		bs->total_bits_read += nBits;
+		return GF_TRUE;
+	}
+	nb_bytes = (nBits - rem + 7) / 8;
+	last_bits = nBits - rem - 8*(nb_bytes-1);
+	ptr = (const u8 *) bs->original + bs->position;
+	if (bs->remove_emul_prevention_byte) {
+		u32 nb_zeros = bs->nb_zeros;
+		for (i=0; i<nb_bytes; i++) {
+			//let the byte reader check the 0x000003 pattern
+			if (ptr[i]==0x03) return GF_FALSE;
+			if (!ptr[i]) nb_zeros++;
+			else nb_zeros = 0;
+		}
+		bs->nb_zeros = nb_zeros;
+	}
+	bs->position += nb_bytes;
+	bs->current = ((u32) ptr[nb_bytes-1]) << last_bits;
+	bs->nbBits = last_bits;
+	bs->total_bits_read += nBits;
+	return GF_TRUE;
+}
+
 GF_EXPORT
 u32 gf_bs_read_int(GF_BitStream *bs, u32 nBits)
 {
 	u32 ret;
+	u64 win;
+	if (nBits && (nBits<=32) && gf_bs_fast_window(bs, &win) && gf_bs_fast_skip(bs, nBits)) {
+		return (u32) (win >> (64 - nBits));
+	}
 	bs->total_bits_read+= nBits;
 
 #ifndef NO_OPTS
@@ -744,6 +828,10 @@ u64 gf_bs_read_long_int(GF_BitStream *bs, u32 nBits)
 		}
 		ret = gf_bs_read_long_int(bs, 64);
 	} else {
+		u64 win;
+		if (nBits && gf_bs_fast_window(bs, &win) && gf_bs_fast_skip(bs, nBits)) {
+			return win >> (64 - nBits);
+		}
 		while (nBits-- > 0) {
 			ret <<= 1;
 			ret |= gf_bs_read_bit(bs);
@@ -752,6 +840,62 @@ u64 gf_bs_read_long_int(GF_BitStream *bs, u32 nBits)
 	return ret;
 }
 
+GF_EXPORT
+u32 gf_bs_read_ue(GF_BitStream *bs)
+{
+	u32 val=0, code;
+	s32 nb_lead = -1;
+	u64 win;
+
+	if (gf_bs_fast_window(bs, &win) && win) {
+		u32 nb_bits = gf_bs_clz64(win);
+		//leading zeros, marker bit and as many bits as leading zeros
+		if (nb_bits<32) {
+			nb_bits = 2*nb_bits + 1;
+			if (gf_bs_fast_skip(bs, nb_bits))
+				return (u32) ((win >> (64 - nb_bits)) - 1);
+		}
+	}
+
+	for (code=0; !code; nb_lead++) {
+		if (nb_lead>=32) {
+			break;
+		}
+		code = gf_bs_read_int(bs, 1);
+	}
+
+	if (nb_lead>=32) {
+		if (gf_bs_is_overflow(bs)<2) {
+			//gf_bs_read_int keeps returning 0 on EOS, so if no more bits available, rbsp was truncated otherwise code is broken in rbsp)
+			//we only test once nb_lead>=32 to avoid testing at each bit read
+			if (!gf_bs_available(bs)) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_CODING, ("[Core] exp-golomb read failed, not enough bits in bitstream !\n"));
+			} else {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_CODING, ("[Core] corrupted exp-golomb code, %d leading zeros, max 31 allowed !\n", nb_lead));
+			}
+			gf_bs_mark_overflow(bs, GF_FALSE);
+		}
+		return 0;
+	}
+
+	if (nb_lead) {
+		u32 leads=1;
+		val = gf_bs_read_int(bs, nb_lead);
+		leads <<= nb_lead;
+		leads -= 1;
+		val += leads;
+	}
+	return val;
+}
+
+GF_EXPORT
+s32 gf_bs_read_se(GF_BitStream *bs)
+{
+	u32 v = gf_bs_read_ue(bs);
+	if ((v & 0x1) == 0) return (s32)(0 - (v >> 1));
+	return (v + 1) >> 1;
+}
+
 
 GF_EXPORT
 Float gf_bs_read_float(GF_BitStream *bs)
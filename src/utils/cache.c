@@ -171,6 +171,25 @@ struct __DownloadedCacheEntryStruct
     GF_Blob cache_blob;
     GF_Blob *external_blob;
     Bool persistent;
+	/*content pushed by another module through gf_dm_add_cache_entry*/
+	Bool pushed;
+
+	/*index this entry belongs to, hash of its URL key, next entry in hash bucket and LRU neighbours*/
+	GF_CacheIndex index;
+	u32 key_hash;
+	DownloadedCacheEntry hash_next;
+	DownloadedCacheEntry lru_prev, lru_next;
+	/*accounted memory and disk size*/
+	u64 mem_size, disk_size;
+};
+
+struct __CacheIndexStruct
+{
+	DownloadedCacheEntry *buckets;
+	u32 nb_buckets, nb_entries;
+	/*most recently used first*/
+	DownloadedCacheEntry lru_head, lru_tail;
+	u64 mem_size, disk_size;
 };
 
 Bool gf_cache_entry_persistent(const DownloadedCacheEntry entry)
@@ -761,6 +780,8 @@ GF_Err gf_cache_delete_entry ( const DownloadedCacheEntry entry )
 	if ( !entry )
 		return GF_OK;
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_CACHE, ("[CACHE] gf_cache_delete_entry:%d, entry=%p, url=%s\n", __LINE__, entry, entry->url));
+	if (entry->index)
+		gf_cache_index_remove(entry->index, entry);
 	if (entry->writeFilePtr) {
 		/** Cache should have been close before, abornormal situation */
 		GF_LOG(GF_LOG_WARNING, GF_LOG_CACHE, ("[CACHE] gf_cache_delete_entry:%d, entry=%p, cache has not been closed properly\n", __LINE__, entry));
@@ -1042,6 +1063,7 @@ Bool gf_cache_is_deleted(const DownloadedCacheEntry entry)
 Bool gf_cache_set_content(const DownloadedCacheEntry entry, GF_Blob *blob, Bool copy, GF_Mutex *mx)
 {
 	if (!entry || !entry->memory_stored) return GF_FALSE;
+	entry->pushed = GF_TRUE;
 
     if (!blob) {
         entry->flags = DELETED;
@@ -1112,4 +1134,217 @@ Bool gf_cache_set_content(const DownloadedCacheEntry entry, GF_Blob *blob, Bool
     return GF_TRUE;
 }
 
+/*multicast entries are matched on the path following the first component after the host*/
+static const char *cache_index_key(const char *url)
+{
+	if (!strncmp(url, "http://gmcast/", 14)) {
+		const char *sep = strchr(url+14, '/');
+		if (sep) return sep;
+	}
+	return url;
+}
+
+static u32 cache_index_hash(const char *url)
+{
+	const char *key = cache_index_key(url);
+	return gf_crc_32((u8 *) key, (u32) strlen(key));
+}
+
+GF_CacheIndex gf_cache_index_new()
+{
+	GF_CacheIndex idx;
+	GF_SAFEALLOC(idx, struct __CacheIndexStruct);
+	if (!idx) return NULL;
+	idx->nb_buckets = 64;
+	idx->buckets = gf_malloc(sizeof(DownloadedCacheEntry) * idx->nb_buckets);
+	if (!idx->buckets) {
+		gf_free(idx);
+		return NULL;
+	}
+	memset(idx->buckets, 0, sizeof(DownloadedCacheEntry) * idx->nb_buckets);
+	return idx;
+}
+
+void gf_cache_index_del(GF_CacheIndex idx)
+{
+	if (!idx) return;
+	while (idx->lru_head)
+		gf_cache_index_remove(idx, idx->lru_head);
+	gf_free(idx->buckets);
+	gf_free(idx);
+}
+
+//append to bucket so that entries with identical URLs keep their insertion order
+static void cache_index_bucket_add(GF_CacheIndex idx, DownloadedCacheEntry entry)
+{
+	DownloadedCacheEntry *link = &idx->buckets[entry->key_hash % idx->nb_buckets];
+	while (*link)
+		link = &(*link)->hash_next;
+	*link = entry;
+	entry->hash_next = NULL;
+}
+
+static void cache_index_lru_unlink(GF_CacheIndex idx, DownloadedCacheEntry entry)
+{
+	if (entry->lru_prev) entry->lru_prev->lru_next = entry->lru_next;
+	else idx->lru_head = entry->lru_next;
+	if (entry->lru_next) entry->lru_next->lru_prev = entry->lru_prev;
+	else idx->lru_tail = entry->lru_prev;
+	entry->lru_prev = entry->lru_next = NULL;
+}
+
+static void cache_index_lru_push(GF_CacheIndex idx, DownloadedCacheEntry entry)
+{
+	entry->lru_prev = NULL;
+	entry->lru_next = idx->lru_head;
+	if (idx->lru_head) idx->lru_head->lru_prev = entry;
+	else idx->lru_tail = entry;
+	idx->lru_head = entry;
+}
+
+GF_Err gf_cache_index_add(GF_CacheIndex idx, DownloadedCacheEntry entry)
+{
+	if (!idx || !entry || entry->index) return GF_BAD_PARAM;
+
+	if (idx->nb_entries >= 2*idx->nb_buckets) {
+		u32 i, nb_buckets = idx->nb_buckets;
+		DownloadedCacheEntry *buckets = idx->buckets;
+		idx->buckets = gf_malloc(sizeof(DownloadedCacheEntry) * 2 * nb_buckets);
+		if (!idx->buckets) {
+			idx->buckets = buckets;
+		} else {
+			memset(idx->buckets, 0, sizeof(DownloadedCacheEntry) * 2 * nb_buckets);
+			idx->nb_buckets = 2*nb_buckets;
+			for (i=0; i<nb_buckets; i++) {
+				DownloadedCacheEntry e = buckets[i];
+				while (e) {
+					DownloadedCacheEntry next = e->hash_next;
+					cache_index_bucket_add(idx, e);
+					e = next;
+				}
+			}
+			gf_free(buckets);
+		}
+	}
+	entry->index = idx;
+	entry->key_hash = cache_index_hash(entry->url);
+	cache_index_bucket_add(idx, entry);
+	cache_index_lru_push(idx, entry);
+	idx->nb_entries++;
+	gf_cache_index_update_size(idx, entry);
+	return GF_OK;
+}
+
+Bool gf_cache_index_remove(GF_CacheIndex idx, DownloadedCacheEntry entry)
+{
+	DownloadedCacheEntry *link;
+	if (!idx || !entry || (entry->index != idx)) return GF_FALSE;
+	link = &idx->buckets[entry->key_hash % idx->nb_buckets];
+	while (*link && (*link != entry))
+		link = &(*link)->hash_next;
+	if (*link) *link = entry->hash_next;
+	cache_index_lru_unlink(idx, entry);
+	idx->mem_size -= entry->mem_size;
+	idx->disk_size -= entry->disk_size;
+	entry->mem_size = entry->disk_size = 0;
+	entry->hash_next = NULL;
+	entry->index = NULL;
+	idx->nb_entries--;
+	return GF_TRUE;
+}
+
+DownloadedCacheEntry gf_cache_index_find(GF_CacheIndex idx, const char *url, Bool mcast_match, Bool check_range, u64 start_range, u64 end_range)
+{
+	u32 hash;
+	DownloadedCacheEntry e;
+	if (!idx || !url) return NULL;
+	hash = cache_index_hash(url);
+	e = idx->buckets[hash % idx->nb_buckets];
+	for (; e; e = e->hash_next) {
+		if (e->key_hash != hash) continue;
+		if (mcast_match && !strncmp(e->url, "http://gmcast/", 14)) {
+			const char *key = cache_index_key(e->url);
+			if ((key == e->url) || strcmp(key, cache_index_key(url)))
+				continue;
+		} else if (strcmp(e->url, url)) continue;
+
+		if (check_range) {
+			if (e->range_start != start_range) continue;
+			if (e->range_end != end_range) continue;
+		}
+		//most recently used
+		cache_index_lru_unlink(idx, e);
+		cache_index_lru_push(idx, e);
+		return e;
+	}
+	return NULL;
+}
+
+u32 gf_cache_index_count(GF_CacheIndex idx)
+{
+	return idx ? idx->nb_entries : 0;
+}
+
+DownloadedCacheEntry gf_cache_index_get_oldest(GF_CacheIndex idx)
+{
+	return idx ? idx->lru_tail : NULL;
+}
+
+void gf_cache_index_update_size(GF_CacheIndex idx, DownloadedCacheEntry entry)
+{
+	if (!idx || !entry || (entry->index != idx)) return;
+	idx->mem_size -= entry->mem_size;
+	idx->disk_size -= entry->disk_size;
+	entry->mem_size = entry->disk_size = 0;
+	if (entry->memory_stored) {
+		//external blobs are owned by their producer
+		entry->mem_size = entry->mem_allocated;
+	} else if (entry->file_exists) {
+		entry->disk_size = MAX(entry->written_in_cache, entry->cacheSize);
+	}
+	idx->mem_size += entry->mem_size;
+	idx->disk_size += entry->disk_size;
+}
+
+void gf_cache_index_get_size(GF_CacheIndex idx, u64 *mem_size, u64 *disk_size)
+{
+	if (mem_size) *mem_size = idx ? idx->mem_size : 0;
+	if (disk_size) *disk_size = idx ? idx->disk_size : 0;
+}
+
+static Bool cache_entry_can_evict(DownloadedCacheEntry e)
+{
+	if (e->persistent || e->write_session || gf_list_count(e->sessions)) return GF_FALSE;
+	if (gf_cache_is_in_progress(e)) return GF_FALSE;
+	//pushed content is released by its producer by marking it as deleted
+	if (e->pushed && !gf_cache_is_deleted(e)) return GF_FALSE;
+	return GF_TRUE;
+}
+
+u32 gf_cache_index_evict(GF_CacheIndex idx, u64 max_mem_size, u64 max_disk_size)
+{
+	u32 nb_evicted = 0;
+	DownloadedCacheEntry e;
+	if (!idx) return 0;
+	e = idx->lru_tail;
+	while (e) {
+		DownloadedCacheEntry prev = e->lru_prev;
+		Bool evict = GF_FALSE;
+		if (e->mem_size && max_mem_size && (idx->mem_size > max_mem_size)) evict = GF_TRUE;
+		else if (e->disk_size && max_disk_size && (idx->disk_size > max_disk_size)) evict = GF_TRUE;
+
+		if (evict && cache_entry_can_evict(e)) {
+			GF_LOG(GF_LOG_DEBUG, GF_LOG_CACHE, ("[CACHE] Evicting %s\n", e->url));
+			gf_cache_index_remove(idx, e);
+			gf_cache_entry_set_delete_files_when_deleted(e);
+			gf_cache_delete_entry(e);
+			nb_evicted++;
+		}
+		if ((!max_mem_size || (idx->mem_size <= max_mem_size)) && (!max_disk_size || (idx->disk_size <= max_disk_size)))
+			break;
+		e = prev;
+	}
+	return nb_evicted;
+}
+
 #endif //GPAC_DISABLE_NETWORK
@@ -27,6 +27,7 @@
 #include <gpac/tools.h>
 #include <gpac/constants.h>
 #include <gpac/color.h>
+#include <gpac/thread.h>
 
 #ifndef GPAC_DISABLE_COMPOSITOR
 
@@ -80,6 +81,667 @@ static void yuv2rgb_init(void)
 	}
 }
 
+/* SIMD kernels
+
+The scalar load_line / copy_row / merge_row functions are the reference implementation. Kernels below process the
+largest possible part of a row and return the number of pixels processed, the scalar code handles the remaining ones.
+Kernels shall be bit-exact with the scalar code.
+Kernels are chosen once, at first use, depending on CPU features, and can be disabled using -no-simd
+*/
+
+//intrinsic code segfaults on 32 bit, need to check why
+#if defined(GPAC_64_BITS)
+# if defined(WIN32) && !defined(__GNUC__)
+#  include <intrin.h>
+#  define GPAC_HAS_SSE2
+# else
+#  ifdef __SSE2__
+#   include <emmintrin.h>
+#   define GPAC_HAS_SSE2
+#  endif
+# endif
+#endif
+
+//AVX2 kernels are compiled regardless of build flags and enabled if supported by the CPU
+#if defined(GPAC_HAS_SSE2) && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)) && !defined(GPAC_CONFIG_EMSCRIPTEN)
+# include <immintrin.h>
+# define GPAC_HAS_AVX2_DISPATCH
+# if defined(__GNUC__) || defined(__clang__)
+#  define COLOR_AVX2	__attribute__((target("avx2")))
+# else
+#  define COLOR_AVX2
+# endif
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+# include <arm_neon.h>
+# define GPAC_HAS_NEON
+#endif
+
+enum
+{
+	//destination byte order r,g,b,0xFF
+	COLOR_ROW_RGBX=0,
+	//destination byte order b,g,r,0xFF
+	COLOR_ROW_BGRX,
+	//destination byte order 0xFF,r,g,b
+	COLOR_ROW_ARGB,
+	//destination byte order r,g,b,a
+	COLOR_ROW_RGBA,
+	//destination byte order b,g,r,a
+	COLOR_ROW_BGRA,
+};
+
+typedef struct
+{
+	//YUV row with horizontally subsampled chroma to RGBA, chroma of pixel x is at u[(x/2)*uv_step]
+	u32 (*yuv_to_rgba)(u8 *dst, const u8 *y, const u8 *u, const u8 *v, u32 uv_step, u32 width);
+	//same for 10 bit planar YUV, chroma of pixel x is at u[x/2]
+	u32 (*yuv10_to_rgba)(u8 *dst, const u16 *y, const u16 *u, const u16 *v, u32 width);
+	//RGBA to RGBX, BGRX or ARGB without stretch, pixels with 0 alpha are not written
+	u32 (*copy_rgba)(const u8 *src, u8 *dst, u32 width, u32 mode);
+	//RGBA blending on RGBX, BGRX, RGBA or BGRA without stretch
+	u32 (*merge_rgba)(const u8 *src, u8 *dst, u32 width, u8 alpha, u32 mode);
+} ColorKernels;
+
+static ColorKernels color_kernels;
+//set once kernels are selected, only the first caller of color_kernels_setup selects them
+static volatile u32 color_kernels_ready = 0;
+static volatile u32 color_kernels_claim = 0;
+
+#define COL_PAIR(_a, _b)	((s32) ( ((u32) (u16) (s16) (_b) << 16) | (u16) (s16) (_a) ))
+
+#ifdef GPAC_HAS_SSE2
+
+//converts 8 pixels, y, u and v are 16 bit with offsets removed and chroma duplicated
+static GFINLINE void color_sse2_yuv_to_rgba8(u8 *dst, __m128i y, __m128i u, __m128i v)
+{
+	const __m128i c_yv_r = _mm_set1_epi32(COL_PAIR(FIX_OUT(1.164), FIX_OUT(1.596)));
+	const __m128i c_yu_g = _mm_set1_epi32(COL_PAIR(FIX_OUT(1.164), -FIX_OUT(0.391)));
+	const __m128i c_v_g = _mm_set1_epi32(COL_PAIR(-FIX_OUT(0.813), 0));
+	const __m128i c_yu_b = _mm_set1_epi32(COL_PAIR(FIX_OUT(1.164), FIX_OUT(2.018)));
+	const __m128i zero = _mm_setzero_si128();
+	__m128i yu_lo = _mm_unpacklo_epi16(y, u);
+	__m128i yu_hi = _mm_unpackhi_epi16(y, u);
+	__m128i yv_lo = _mm_unpacklo_epi16(y, v);
+	__m128i yv_hi = _mm_unpackhi_epi16(y, v);
+	__m128i v_lo = _mm_unpacklo_epi16(v, zero);
+	__m128i v_hi = _mm_unpackhi_epi16(v, zero);
+	__m128i r, g, b, rg, ba;
+
+	r = _mm_packs_epi32(
+		_mm_srai_epi32(_mm_madd_epi16(yv_lo, c_yv_r), SCALEBITS_OUT),
+		_mm_srai_epi32(_mm_madd_epi16(yv_hi, c_yv_r), SCALEBITS_OUT));
+	g = _mm_packs_epi32(
+		_mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(yu_lo, c_yu_g), _mm_madd_epi16(v_lo, c_v_g)), SCALEBITS_OUT),
+		_mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(yu_hi, c_yu_g), _mm_madd_epi16(v_hi, c_v_g)), SCALEBITS_OUT));
+	b = _mm_packs_epi32(
+		_mm_srai_epi32(_mm_madd_epi16(yu_lo, c_yu_b), SCALEBITS_OUT),
+		_mm_srai_epi32(_mm_madd_epi16(yu_hi, c_yu_b), SCALEBITS_OUT));
+
+	rg = _mm_packus_epi16(r, g);
+	ba = _mm_packus_epi16(b, _mm_set1_epi16(0xFF));
+	rg = _mm_unpacklo_epi8(rg, _mm_srli_si128(rg, 8));
+	ba = _mm_unpacklo_epi8(ba, _mm_srli_si128(ba, 8));
+	_mm_storeu_si128((__m128i *) dst, _mm_unpacklo_epi16(rg, ba));
+	_mm_storeu_si128((__m128i *) (dst+16), _mm_unpackhi_epi16(rg, ba));
+}
+
+static u32 color_sse2_yuv_to_rgba(u8 *dst, const u8 *y, const u8 *u, const u8 *v, u32 uv_step, u32 width)
+{
+	u32 i;
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i off_y = _mm_set1_epi16(16);
+	const __m128i off_uv = _mm_set1_epi16(128);
+	const u8 *uv = (u<v) ? u : v;
+
+	width &= ~7;
+	for (i=0; i<width; i+=8) {
+		__m128i vy, vu, vv;
+		vy = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (y+i)), zero), off_y);
+		if (uv_step==1) {
+			s32 cu, cv;
+			memcpy(&cu, u + i/2, 4);
+			memcpy(&cv, v + i/2, 4);
+			vu = _mm_cvtsi32_si128(cu);
+			vv = _mm_cvtsi32_si128(cv);
+			vu = _mm_unpacklo_epi8(_mm_unpacklo_epi8(vu, vu), zero);
+			vv = _mm_unpacklo_epi8(_mm_unpacklo_epi8(vv, vv), zero);
+		} else {
+			//4 interleaved chroma pairs
+			__m128i c = _mm_loadl_epi64((const __m128i *) (uv+i));
+			__m128i c_lo = _mm_and_si128(c, _mm_set1_epi16(0xFF));
+			__m128i c_hi = _mm_srli_epi16(c, 8);
+			c_lo = _mm_unpacklo_epi16(c_lo, c_lo);
+			c_hi = _mm_unpacklo_epi16(c_hi, c_hi);
+			vu = (u<v) ? c_lo : c_hi;
+			vv = (u<v) ? c_hi : c_lo;
+		}
+		color_sse2_yuv_to_rgba8(dst + 4*i, vy, _mm_sub_epi16(vu, off_uv), _mm_sub_epi16(vv, off_uv));
+	}
+	return width;
+}
+
+static u32 color_sse2_yuv10_to_rgba(u8 *dst, const u16 *y, const u16 *u, const u16 *v, u32 width)
+{
+	u32 i;
+	const __m128i off_y = _mm_set1_epi16(16);
+	const __m128i off_uv = _mm_set1_epi16(128);
+
+	width &= ~7;
+	for (i=0; i<width; i+=8) {
+		__m128i vy, vu, vv;
+		vy = _mm_sub_epi16(_mm_srli_epi16(_mm_loadu_si128((const __m128i *) (y+i)), 2), off_y);
+		vu = _mm_srli_epi16(_mm_loadl_epi64((const __m128i *) (u+i/2)), 2);
+		vv = _mm_srli_epi16(_mm_loadl_epi64((const __m128i *) (v+i/2)), 2);
+		vu = _mm_sub_epi16(_mm_unpacklo_epi16(vu, vu), off_uv);
+		vv = _mm_sub_epi16(_mm_unpacklo_epi16(vv, vv), off_uv);
+		color_sse2_yuv_to_rgba8(dst + 4*i, vy, vu, vv);
+	}
+	return width;
+}
+
+//swizzle 4 RGBA pixels
+static GFINLINE __m128i color_sse2_swizzle(__m128i p, u32 mode)
+{
+	const __m128i mask = _mm_set1_epi32(0xFF);
+	switch (mode) {
+	case COLOR_ROW_BGRX:
+		p = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(_mm_and_si128(p, mask), 16), _mm_and_si128(p, _mm_set1_epi32(0xFF00))),
+			_mm_and_si128(_mm_srli_epi32(p, 16), mask));
+		return _mm_or_si128(p, _mm_set1_epi32(0xFF000000));
+	case COLOR_ROW_ARGB:
+		return _mm_or_si128(_mm_slli_epi32(p, 8), mask);
+	default:
+		return _mm_or_si128(p, _mm_set1_epi32(0xFF000000));
+	}
+}
+
+static u32 color_sse2_copy_rgba(const u8 *src, u8 *dst, u32 width, u32 mode)
+{
+	u32 i;
+	const __m128i amask = _mm_set1_epi32(0xFF000000);
+	const __m128i zero = _mm_setzero_si128();
+
+	width &= ~3;
+	for (i=0; i<4*width; i+=16) {
+		__m128i p = _mm_loadu_si128((const __m128i *) (src+i));
+		__m128i transp = _mm_cmpeq_epi32(_mm_and_si128(p, amask), zero);
+		p = color_sse2_swizzle(p, mode);
+		//only read destination if needed, it may be in video memory
+		if (_mm_movemask_epi8(transp)) {
+			__m128i d = _mm_loadu_si128((const __m128i *) (dst+i));
+			p = _mm_or_si128(_mm_andnot_si128(transp, p), _mm_and_si128(transp, d));
+		}
+		_mm_storeu_si128((__m128i *) (dst+i), p);
+	}
+	return width;
+}
+
+//blend 2 pixels, s and d are 16 bit components in destination order with alpha last
+static GFINLINE __m128i color_sse2_blend2(__m128i s, __m128i d, __m128i alpha, u32 mode)
+{
+	const __m128i one = _mm_set1_epi16(1);
+	const __m128i amask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+	__m128i a, a1, diff, res, zmask;
+
+	//a = mul255(src_a, alpha)
+	a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, 0xFF), 0xFF);
+	a = _mm_srli_epi16(_mm_mullo_epi16(_mm_add_epi16(a, one), alpha), 8);
+	a1 = _mm_add_epi16(a, one);
+	//mul255(a, s - d) + d, product does not fit on 16 bits
+	diff = _mm_sub_epi16(s, d);
+	res = _mm_or_si128(_mm_slli_epi16(_mm_mulhi_epi16(a1, diff), 8), _mm_srli_epi16(_mm_mullo_epi16(a1, diff), 8));
+	res = _mm_add_epi16(res, d);
+
+	if ((mode==COLOR_ROW_RGBA) || (mode==COLOR_ROW_BGRA)) {
+		//mul255(a, a) + mul255(0xFF-a, 0xFF)
+		__m128i res_a = _mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(a1, a), 8),
+			_mm_srli_epi16(_mm_mullo_epi16(_mm_sub_epi16(_mm_set1_epi16(256), a), _mm_set1_epi16(0xFF)), 8));
+		__m128i src_a = _mm_or_si128(_mm_andnot_si128(amask, s), _mm_and_si128(amask, a));
+		res = _mm_or_si128(_mm_andnot_si128(amask, res), _mm_and_si128(amask, res_a));
+		//transparent destination, copy source
+		zmask = _mm_cmpeq_epi16(_mm_shufflehi_epi16(_mm_shufflelo_epi16(d, 0xFF), 0xFF), _mm_setzero_si128());
+		res = _mm_or_si128(_mm_andnot_si128(zmask, res), _mm_and_si128(zmask, src_a));
+	} else {
+		res = _mm_or_si128(res, _mm_and_si128(amask, _mm_set1_epi16(0xFF)));
+	}
+	//transparent source, keep destination
+	zmask = _mm_cmpeq_epi16(a, _mm_setzero_si128());
+	return _mm_or_si128(_mm_andnot_si128(zmask, res), _mm_and_si128(zmask, d));
+}
+
+static u32 color_sse2_merge_rgba(const u8 *src, u8 *dst, u32 width, u8 alpha, u32 mode)
+{
+	u32 i;
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i valpha = _mm_set1_epi16(alpha);
+	Bool swap = ((mode==COLOR_ROW_BGRX) || (mode==COLOR_ROW_BGRA)) ? GF_TRUE : GF_FALSE;
+
+	width &= ~3;
+	for (i=0; i<4*width; i+=16) {
+		__m128i s = _mm_loadu_si128((const __m128i *) (src+i));
+		__m128i d = _mm_loadu_si128((const __m128i *) (dst+i));
+		__m128i s_lo = _mm_unpacklo_epi8(s, zero);
+		__m128i s_hi = _mm_unpackhi_epi8(s, zero);
+		if (swap) {
+			s_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_lo, _MM_SHUFFLE(3,0,1,2)), _MM_SHUFFLE(3,0,1,2));
+			s_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_hi, _MM_SHUFFLE(3,0,1,2)), _MM_SHUFFLE(3,0,1,2));
+		}
+		s_lo = color_sse2_blend2(s_lo, _mm_unpacklo_epi8(d, zero), valpha, mode);
+		s_hi = color_sse2_blend2(s_hi, _mm_unpackhi_epi8(d, zero), valpha, mode);
+		_mm_storeu_si128((__m128i *) (dst+i), _mm_packus_epi16(s_lo, s_hi));
+	}
+	return width;
+}
+
+#endif //GPAC_HAS_SSE2
+
+#ifdef GPAC_HAS_AVX2_DISPATCH
+
+static Bool color_cpu_has_avx2(void)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") ? GF_TRUE : GF_FALSE;
+#else
+	int info[4];
+	__cpuid(info, 1);
+	//OSXSAVE and AVX, and OS saves YMM registers
+	if ((info[2] & (3<<27)) != (3<<27)) return GF_FALSE;
+	if ((_xgetbv(0) & 6) != 6) return GF_FALSE;
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1<<5)) ? GF_TRUE : GF_FALSE;
+#endif
+}
+
+//converts 16 pixels, same as SSE2 version
+COLOR_AVX2
+static GFINLINE void color_avx2_yuv_to_rgba16(u8 *dst, __m256i y, __m256i u, __m256i v)
+{
+	const __m256i c_yv_r = _mm256_set1_epi32(COL_PAIR(FIX_OUT(1.164), FIX_OUT(1.596)));
+	const __m256i c_yu_g = _mm256_set1_epi32(COL_PAIR(FIX_OUT(1.164), -FIX_OUT(0.391)));
+	const __m256i c_v_g = _mm256_set1_epi32(COL_PAIR(-FIX_OUT(0.813), 0));
+	const __m256i c_yu_b = _mm256_set1_epi32(COL_PAIR(FIX_OUT(1.164), FIX_OUT(2.018)));
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i yu_lo = _mm256_unpacklo_epi16(y, u);
+	__m256i yu_hi = _mm256_unpackhi_epi16(y, u);
+	__m256i yv_lo = _mm256_unpacklo_epi16(y, v);
+	__m256i yv_hi = _mm256_unpackhi_epi16(y, v);
+	__m256i v_lo = _mm256_unpacklo_epi16(v, zero);
+	__m256i v_hi = _mm256_unpackhi_epi16(v, zero);
+	__m256i r, g, b, rg, ba, p0, p1;
+
+	//unpack and pack operate on 128 bit lanes, pixel order is restored by packs
+	r = _mm256_packs_epi32(
+		_mm256_srai_epi32(_mm256_madd_epi16(yv_lo, c_yv_r), SCALEBITS_OUT),
+		_mm256_srai_epi32(_mm256_madd_epi16(yv_hi, c_yv_r), SCALEBITS_OUT));
+	g = _mm256_packs_epi32(
+		_mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(yu_lo, c_yu_g), _mm256_madd_epi16(v_lo, c_v_g)), SCALEBITS_OUT),
+		_mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(yu_hi, c_yu_g), _mm256_madd_epi16(v_hi, c_v_g)), SCALEBITS_OUT));
+	b = _mm256_packs_epi32(
+		_mm256_srai_epi32(_mm256_madd_epi16(yu_lo, c_yu_b), SCALEBITS_OUT),
+		_mm256_srai_epi32(_mm256_madd_epi16(yu_hi, c_yu_b), SCALEBITS_OUT));
+
+	rg = _mm256_packus_epi16(r, g);
+	ba = _mm256_packus_epi16(b, _mm256_set1_epi16(0xFF));
+	rg = _mm256_unpacklo_epi8(rg, _mm256_srli_si256(rg, 8));
+	ba = _mm256_unpacklo_epi8(ba, _mm256_srli_si256(ba, 8));
+	p0 = _mm256_unpacklo_epi16(rg, ba);
+	p1 = _mm256_unpackhi_epi16(rg, ba);
+	_mm256_storeu_si256((__m256i *) dst, _mm256_permute2x128_si256(p0, p1, 0x20));
+	_mm256_storeu_si256((__m256i *) (dst+32), _mm256_permute2x128_si256(p0, p1, 0x31));
+}
+
+//duplicate 8 16-bit values
+COLOR_AVX2
+static GFINLINE __m256i color_avx2_dup16(__m128i c)
+{
+	__m256i w = _mm256_cvtepu16_epi32(c);
+	return _mm256_or_si256(w, _mm256_slli_epi32(w, 16));
+}
+
+COLOR_AVX2
+static u32 color_avx2_yuv_to_rgba(u8 *dst, const u8 *y, const u8 *u, const u8 *v, u32 uv_step, u32 width)
+{
+	u32 i;
+	const __m256i off_y = _mm256_set1_epi16(16);
+	const __m256i off_uv = _mm256_set1_epi16(128);
+	const u8 *uv = (u<v) ? u : v;
+
+	width &= ~15;
+	for (i=0; i<width; i+=16) {
+		__m256i vy, vu, vv;
+		vy = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) (y+i))), off_y);
+		if (uv_step==1) {
+			__m128i cu = _mm_loadl_epi64((const __m128i *) (u + i/2));
+			__m128i cv = _mm_loadl_epi64((const __m128i *) (v + i/2));
+			vu = _mm256_cvtepu8_epi16(_mm_unpacklo_epi8(cu, cu));
+			vv = _mm256_cvtepu8_epi16(_mm_unpacklo_epi8(cv, cv));
+		} else {
+			//8 interleaved chroma pairs
+			__m128i c = _mm_loadu_si128((const __m128i *) (uv+i));
+			__m256i c_lo = color_avx2_dup16(_mm_and_si128(c, _mm_set1_epi16(0xFF)));
+			__m256i c_hi = color_avx2_dup16(_mm_srli_epi16(c, 8));
+			vu = (u<v) ? c_lo : c_hi;
+			vv = (u<v) ? c_hi : c_lo;
+		}
+		color_avx2_yuv_to_rgba16(dst + 4*i, vy, _mm256_sub_epi16(vu, off_uv), _mm256_sub_epi16(vv, off_uv));
+	}
+	return width;
+}
+
+COLOR_AVX2
+static u32 color_avx2_yuv10_to_rgba(u8 *dst, const u16 *y, const u16 *u, const u16 *v, u32 width)
+{
+	u32 i;
+	const __m256i off_y = _mm256_set1_epi16(16);
+	const __m256i off_uv = _mm256_set1_epi16(128);
+
+	width &= ~15;
+	for (i=0; i<width; i+=16) {
+		__m256i vy, vu, vv;
+		vy = _mm256_sub_epi16(_mm256_srli_epi16(_mm256_loadu_si256((const __m256i *) (y+i)), 2), off_y);
+		vu = color_avx2_dup16(_mm_srli_epi16(_mm_loadu_si128((const __m128i *) (u+i/2)), 2));
+		vv = color_avx2_dup16(_mm_srli_epi16(_mm_loadu_si128((const __m128i *) (v+i/2)), 2));
+		color_avx2_yuv_to_rgba16(dst + 4*i, vy, _mm256_sub_epi16(vu, off_uv), _mm256_sub_epi16(vv, off_uv));
+	}
+	return width;
+}
+
+COLOR_AVX2
+static u32 color_avx2_copy_rgba(const u8 *src, u8 *dst, u32 width, u32 mode)
+{
+	u32 i;
+	const __m256i mask = _mm256_set1_epi32(0xFF);
+	const __m256i amask = _mm256_set1_epi32(0xFF000000);
+	const __m256i zero = _mm256_setzero_si256();
+
+	width &= ~7;
+	for (i=0; i<4*width; i+=32) {
+		__m256i p = _mm256_loadu_si256((const __m256i *) (src+i));
+		__m256i transp = _mm256_cmpeq_epi32(_mm256_and_si256(p, amask), zero);
+		switch (mode) {
+		case COLOR_ROW_BGRX:
+			p = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(p, mask), 16), _mm256_and_si256(p, _mm256_set1_epi32(0xFF00))),
+				_mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(p, 16), mask), amask));
+			break;
+		case COLOR_ROW_ARGB:
+			p = _mm256_or_si256(_mm256_slli_epi32(p, 8), mask);
+			break;
+		default:
+			p = _mm256_or_si256(p, amask);
+			break;
+		}
+		//only read destination if needed, it may be in video memory
+		if (_mm256_movemask_epi8(transp)) {
+			__m256i d = _mm256_loadu_si256((const __m256i *) (dst+i));
+			p = _mm256_blendv_epi8(p, d, transp);
+		}
+		_mm256_storeu_si256((__m256i *) (dst+i), p);
+	}
+	return width;
+}
+
+//blend 4 pixels, same as SSE2 version
+COLOR_AVX2
+static GFINLINE __m256i color_avx2_blend4(__m256i s, __m256i d, __m256i alpha, u32 mode)
+{
+	const __m256i one = _mm256_set1_epi16(1);
+	const __m256i amask = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+	__m256i a, a1, diff, res;
+
+	a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, 0xFF), 0xFF);
+	a = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_add_epi16(a, one), alpha), 8);
+	a1 = _mm256_add_epi16(a, one);
+	diff = _mm256_sub_epi16(s, d);
+	res = _mm256_or_si256(_mm256_slli_epi16(_mm256_mulhi_epi16(a1, diff), 8), _mm256_srli_epi16(_mm256_mullo_epi16(a1, diff), 8));
+	res = _mm256_add_epi16(res, d);
+
+	if ((mode==COLOR_ROW_RGBA) || (mode==COLOR_ROW_BGRA)) {
+		__m256i res_a = _mm256_add_epi16(_mm256_srli_epi16(_mm256_mullo_epi16(a1, a), 8),
+			_mm256_srli_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(_mm256_set1_epi16(256), a), _mm256_set1_epi16(0xFF)), 8));
+		__m256i src_a = _mm256_blendv_epi8(s, a, amask);
+		res = _mm256_blendv_epi8(res, res_a, amask);
+		res = _mm256_blendv_epi8(res, src_a, _mm256_cmpeq_epi16(_mm256_shufflehi_epi16(_mm256_shufflelo_epi16(d, 0xFF), 0xFF), _mm256_setzero_si256()));
+	} else {
+		res = _mm256_or_si256(res, _mm256_and_si256(amask, _mm256_set1_epi16(0xFF)));
+	}
+	return _mm256_blendv_epi8(res, d, _mm256_cmpeq_epi16(a, _mm256_setzero_si256()));
+}
+
+COLOR_AVX2
+static u32 color_avx2_merge_rgba(const u8 *src, u8 *dst, u32 width, u8 alpha, u32 mode)
+{
+	u32 i;
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i valpha = _mm256_set1_epi16(alpha);
+	Bool swap = ((mode==COLOR_ROW_BGRX) || (mode==COLOR_ROW_BGRA)) ? GF_TRUE : GF_FALSE;
+
+	width &= ~7;
+	for (i=0; i<4*width; i+=32) {
+		__m256i s = _mm256_loadu_si256((const __m256i *) (src+i));
+		__m256i d = _mm256_loadu_si256((const __m256i *) (dst+i));
+		__m256i s_lo = _mm256_unpacklo_epi8(s, zero);
+		__m256i s_hi = _mm256_unpackhi_epi8(s, zero);
+		if (swap) {
+			s_lo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_lo, _MM_SHUFFLE(3,0,1,2)), _MM_SHUFFLE(3,0,1,2));
+			s_hi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_hi, _MM_SHUFFLE(3,0,1,2)), _MM_SHUFFLE(3,0,1,2));
+		}
+		s_lo = color_avx2_blend4(s_lo, _mm256_unpacklo_epi8(d, zero), valpha, mode);
+		s_hi = color_avx2_blend4(s_hi, _mm256_unpackhi_epi8(d, zero), valpha, mode);
+		_mm256_storeu_si256((__m256i *) (dst+i), _mm256_packus_epi16(s_lo, s_hi));
+	}
+	return width;
+}
+
+#endif //GPAC_HAS_AVX2_DISPATCH
+
+#ifdef GPAC_HAS_NEON
+
+//converts 8 pixels, y, u and v are 16 bit with offsets removed and chroma duplicated
+static GFINLINE void color_neon_yuv_to_rgba8(u8 *dst, int16x8_t y, int16x8_t u, int16x8_t v)
+{
+	uint8x8x4_t px;
+	int32x4_t r_lo, r_hi, g_lo, g_hi, b_lo, b_hi;
+	int16x4_t y_lo = vget_low_s16(y), y_hi = vget_high_s16(y);
+	int16x4_t u_lo = vget_low_s16(u), u_hi = vget_high_s16(u);
+	int16x4_t v_lo = vget_low_s16(v), v_hi = vget_high_s16(v);
+
+	r_lo = vmlal_n_s16(vmull_n_s16(y_lo, FIX_OUT(1.164)), v_lo, FIX_OUT(1.596));
+	r_hi = vmlal_n_s16(vmull_n_s16(y_hi, FIX_OUT(1.164)), v_hi, FIX_OUT(1.596));
+	g_lo = vmlsl_n_s16(vmlsl_n_s16(vmull_n_s16(y_lo, FIX_OUT(1.164)), u_lo, FIX_OUT(0.391)), v_lo, FIX_OUT(0.813));
+	g_hi = vmlsl_n_s16(vmlsl_n_s16(vmull_n_s16(y_hi, FIX_OUT(1.164)), u_hi, FIX_OUT(0.391)), v_hi, FIX_OUT(0.813));
+	b_lo = vmlal_n_s16(vmull_n_s16(y_lo, FIX_OUT(1.164)), u_lo, FIX_OUT(2.018));
+	b_hi = vmlal_n_s16(vmull_n_s16(y_hi, FIX_OUT(1.164)), u_hi, FIX_OUT(2.018));
+
+	px.val[0] = vqmovun_s16(vcombine_s16(vshrn_n_s32(r_lo, SCALEBITS_OUT), vshrn_n_s32(r_hi, SCALEBITS_OUT)));
+	px.val[1] = vqmovun_s16(vcombine_s16(vshrn_n_s32(g_lo, SCALEBITS_OUT), vshrn_n_s32(g_hi, SCALEBITS_OUT)));
+	px.val[2] = vqmovun_s16(vcombine_s16(vshrn_n_s32(b_lo, SCALEBITS_OUT), vshrn_n_s32(b_hi, SCALEBITS_OUT)));
+	px.val[3] = vdup_n_u8(0xFF);
+	vst4_u8(dst, px);
+}
+
+static u32 color_neon_yuv_to_rgba(u8 *dst, const u8 *y, const u8 *u, const u8 *v, u32 uv_step, u32 width)
+{
+	u32 i;
+	const u8 *uv = (u<v) ? u : v;
+
+	width &= ~7;
+	for (i=0; i<width; i+=8) {
+		uint8x8_t cu, cv;
+		int16x8_t vy = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(y+i), vdup_n_u8(16)));
+		if (uv_step==1) {
+			u32 c;
+			memcpy(&c, u + i/2, 4);
+			cu = vreinterpret_u8_u32(vdup_n_u32(c));
+			memcpy(&c, v + i/2, 4);
+			cv = vreinterpret_u8_u32(vdup_n_u32(c));
+		} else {
+			//4 interleaved chroma pairs
+			uint8x8x2_t c = vuzp_u8(vld1_u8(uv+i), vdup_n_u8(0));
+			cu = (u<v) ? c.val[0] : c.val[1];
+			cv = (u<v) ? c.val[1] : c.val[0];
+		}
+		cu = vzip_u8(cu, cu).val[0];
+		cv = vzip_u8(cv, cv).val[0];
+		color_neon_yuv_to_rgba8(dst + 4*i, vy,
+			vreinterpretq_s16_u16(vsubl_u8(cu, vdup_n_u8(128))),
+			vreinterpretq_s16_u16(vsubl_u8(cv, vdup_n_u8(128))));
+	}
+	return width;
+}
+
+static u32 color_neon_yuv10_to_rgba(u8 *dst, const u16 *y, const u16 *u, const u16 *v, u32 width)
+{
+	u32 i;
+	width &= ~7;
+	for (i=0; i<width; i+=8) {
+		uint16x4x2_t cu, cv;
+		int16x8_t vy = vsubq_s16(vreinterpretq_s16_u16(vshrq_n_u16(vld1q_u16(y+i), 2)), vdupq_n_s16(16));
+		uint16x4_t c = vshr_n_u16(vld1_u16(u+i/2), 2);
+		cu = vzip_u16(c, c);
+		c = vshr_n_u16(vld1_u16(v+i/2), 2);
+		cv = vzip_u16(c, c);
+		color_neon_yuv_to_rgba8(dst + 4*i, vy,
+			vsubq_s16(vreinterpretq_s16_u16(vcombine_u16(cu.val[0], cu.val[1])), vdupq_n_s16(128)),
+			vsubq_s16(vreinterpretq_s16_u16(vcombine_u16(cv.val[0], cv.val[1])), vdupq_n_s16(128)));
+	}
+	return width;
+}
+
+static u32 color_neon_copy_rgba(const u8 *src, u8 *dst, u32 width, u32 mode)
+{
+	u32 i;
+	width &= ~7;
+	for (i=0; i<4*width; i+=32) {
+		uint8x8x4_t s = vld4_u8(src+i);
+		uint8x8x4_t o;
+		uint8x8_t transp = vceq_u8(s.val[3], vdup_n_u8(0));
+		switch (mode) {
+		case COLOR_ROW_BGRX:
+			o.val[0] = s.val[2];
+			o.val[1] = s.val[1];
+			o.val[2] = s.val[0];
+			o.val[3] = vdup_n_u8(0xFF);
+			break;
+		case COLOR_ROW_ARGB:
+			o.val[0] = vdup_n_u8(0xFF);
+			o.val[1] = s.val[0];
+			o.val[2] = s.val[1];
+			o.val[3] = s.val[2];
+			break;
+		default:
+			o.val[0] = s.val[0];
+			o.val[1] = s.val[1];
+			o.val[2] = s.val[2];
+			o.val[3] = vdup_n_u8(0xFF);
+			break;
+		}
+		//only read destination if needed, it may be in video memory
+		if (vget_lane_u64(vreinterpret_u64_u8(transp), 0)) {
+			u32 k;
+			uint8x8x4_t d = vld4_u8(dst+i);
+			for (k=0; k<4; k++)
+				o.val[k] = vbsl_u8(transp, d.val[k], o.val[k]);
+		}
+		vst4_u8(dst+i, o);
+	}
+	return width;
+}
+
+//mul255(a, s - d) + d
+static GFINLINE uint8x8_t color_neon_blend(int16x8_t a1, uint8x8_t s, uint8x8_t d)
+{
+	int16x8_t diff = vreinterpretq_s16_u16(vsubl_u8(s, d));
+	int32x4_t lo = vmull_s16(vget_low_s16(a1), vget_low_s16(diff));
+	int32x4_t hi = vmull_s16(vget_high_s16(a1), vget_high_s16(diff));
+	int16x8_t res = vcombine_s16(vshrn_n_s32(lo, 8), vshrn_n_s32(hi, 8));
+	return vmovn_u16(vreinterpretq_u16_s16(vaddq_s16(res, vreinterpretq_s16_u16(vmovl_u8(d)))));
+}
+
+static u32 color_neon_merge_rgba(const u8 *src, u8 *dst, u32 width, u8 alpha, u32 mode)
+{
+	u32 i, k;
+	Bool swap = ((mode==COLOR_ROW_BGRX) || (mode==COLOR_ROW_BGRA)) ? GF_TRUE : GF_FALSE;
+	Bool has_alpha = ((mode==COLOR_ROW_RGBA) || (mode==COLOR_ROW_BGRA)) ? GF_TRUE : GF_FALSE;
+
+	width &= ~7;
+	for (i=0; i<4*width; i+=32) {
+		uint8x8x4_t s = vld4_u8(src+i);
+		uint8x8x4_t d = vld4_u8(dst+i);
+		uint8x8x4_t o;
+		uint8x8_t a8, transp;
+		uint16x8_t a = vshrq_n_u16(vmulq_u16(vaddw_u8(vdupq_n_u16(1), s.val[3]), vdupq_n_u16(alpha)), 8);
+		int16x8_t a1 = vreinterpretq_s16_u16(vaddq_u16(a, vdupq_n_u16(1)));
+		a8 = vmovn_u16(a);
+		if (swap) {
+			uint8x8_t t = s.val[0];
+			s.val[0] = s.val[2];
+			s.val[2] = t;
+		}
+		for (k=0; k<3; k++)
+			o.val[k] = color_neon_blend(a1, s.val[k], d.val[k]);
+
+		if (has_alpha) {
+			//mul255(a, a) + mul255(0xFF-a, 0xFF)
+			uint16x8_t res_a = vaddq_u16(vshrq_n_u16(vmulq_u16(vreinterpretq_u16_s16(a1), a), 8),
+				vshrq_n_u16(vmulq_u16(vsubq_u16(vdupq_n_u16(256), a), vdupq_n_u16(0xFF)), 8));
+			uint8x8_t dz = vceq_u8(d.val[3], vdup_n_u8(0));
+			o.val[3] = vmovn_u16(res_a);
+			//transparent destination, copy source
+			s.val[3] = a8;
+			for (k=0; k<4; k++)
+				o.val[k] = vbsl_u8(dz, s.val[k], o.val[k]);
+		} else {
+			o.val[3] = vdup_n_u8(0xFF);
+		}
+		//transparent source, keep destination
+		transp = vceq_u8(a8, vdup_n_u8(0));
+		for (k=0; k<4; k++)
+			o.val[k] = vbsl_u8(transp, d.val[k], o.val[k]);
+		vst4_u8(dst+i, o);
+	}
+	return width;
+}
+
+#endif //GPAC_HAS_NEON
+
+/*kernels are selected once, at first use*/
+static void color_kernels_setup(void)
+{
+	if (color_kernels_ready) return;
+	if (safe_int_inc(&color_kernels_claim) != 1) {
+		//selected by another thread
+		while (!color_kernels_ready) gf_sleep(0);
+		return;
+	}
+	if (!gf_opts_get_bool("core", "no-simd")) {
+#if defined(GPAC_HAS_NEON)
+		color_kernels.yuv_to_rgba = color_neon_yuv_to_rgba;
+		color_kernels.yuv10_to_rgba = color_neon_yuv10_to_rgba;
+		color_kernels.copy_rgba = color_neon_copy_rgba;
+		color_kernels.merge_rgba = color_neon_merge_rgba;
+#elif defined(GPAC_HAS_SSE2)
+		color_kernels.yuv_to_rgba = color_sse2_yuv_to_rgba;
+		color_kernels.yuv10_to_rgba = color_sse2_yuv10_to_rgba;
+		color_kernels.copy_rgba = color_sse2_copy_rgba;
+		color_kernels.merge_rgba = color_sse2_merge_rgba;
+#ifdef GPAC_HAS_AVX2_DISPATCH
+		if (color_cpu_has_avx2()) {
+			color_kernels.yuv_to_rgba = color_avx2_yuv_to_rgba;
+			color_kernels.yuv10_to_rgba = color_avx2_yuv10_to_rgba;
+			color_kernels.copy_rgba = color_avx2_copy_rgba;
+			color_kernels.merge_rgba = color_avx2_merge_rgba;
+			GF_LOG(GF_LOG_DEBUG, GF_LOG_CORE, ("[Color] Using AVX2 pixel conversion\n"));
+		}
+#endif
+#endif
+	}
+	safe_int_inc(&color_kernels_ready);
+}
+
+
 static void yuv_load_lines_planar(unsigned char *dst, s32 dststride, unsigned char *y_src, unsigned char *u_src, unsigned char * v_src, s32 y_stride, s32 uv_stride, s32 width, Bool dst_yuv)
 {
 	u32 hw, x;
@@ -113,7 +775,17 @@ static void yuv_load_lines_planar(unsigned char *dst, s32 dststride, unsigned ch
 		}
 		return;
 	}
-	for (x = 0; x < hw; x++) {
+	x = 0;
+	if (color_kernels.yuv_to_rgba) {
+		u32 done = color_kernels.yuv_to_rgba(dst, y_src, u_src, v_src, 1, width);
+		color_kernels.yuv_to_rgba(dst2, y_src2, u_src, v_src, 1, width);
+		dst += 4*done;
+		dst2 += 4*done;
+		y_src += done;
+		y_src2 += done;
+		x = done/2;
+	}
+	for (; x < hw; x++) {
 		s32 u, v;
 		s32 b_u, g_uv, r_v, rgb_y;
 
@@ -197,7 +869,21 @@ static void yuv422_load_lines_planar(unsigned char *dst, s32 dststride, unsigned
 		return;
 	}
 
-	for (x = 0; x < hw; x++) {
+	x = 0;
+	if (color_kernels.yuv_to_rgba) {
+		u32 done = color_kernels.yuv_to_rgba(dst, y_src, u_src, v_src, 1, width);
+		color_kernels.yuv_to_rgba(dst2, y_src2, u_src2, v_src2, 1, width);
+		dst += 4*done;
+		dst2 += 4*done;
+		y_src += done;
+		y_src2 += done;
+		u_src += done/2;
+		v_src += done/2;
+		u_src2 += done/2;
+		v_src2 += done/2;
+		x = done/2;
+	}
+	for (; x < hw; x++) {
 		s32 b_u, g_uv, r_v, rgb_y;
 
 		b_u = B_U[*u_src];
@@ -393,7 +1079,17 @@ static void yuv_10_load_lines_planar(unsigned char *dst, s32 dststride, unsigned
 		}
 		return;
 	}
-	for (x = 0; x < hw; x++) {
+	x = 0;
+	if (color_kernels.yuv10_to_rgba) {
+		u32 done = color_kernels.yuv10_to_rgba(dst, y_src, u_src, v_src, width);
+		color_kernels.yuv10_to_rgba(dst2, y_src2, u_src, v_src, width);
+		dst += 4*done;
+		dst2 += 4*done;
+		y_src += done;
+		y_src2 += done;
+		x = done/2;
+	}
+	for (; x < hw; x++) {
 		s32 u, v;
 		s32 b_u, g_uv, r_v, rgb_y;
 
@@ -480,7 +1176,21 @@ static void yuv422_10_load_lines_planar(unsigned char *dst, s32 dststride, unsig
 		}
 		return;
 	}
-	for (x = 0; x < hw; x++) {
+	x = 0;
+	if (color_kernels.yuv10_to_rgba) {
+		u32 done = color_kernels.yuv10_to_rgba(dst, y_src, u_src, v_src, width);
+		color_kernels.yuv10_to_rgba(dst2, y_src2, u_src2, v_src2, width);
+		dst += 4*done;
+		dst2 += 4*done;
+		y_src += done;
+		y_src2 += done;
+		u_src += done/2;
+		v_src += done/2;
+		u_src2 += done/2;
+		v_src2 += done/2;
+		x = done/2;
+	}
+	for (; x < hw; x++) {
 		s32 b_u, g_uv, r_v, rgb_y;
 
 		b_u = B_U[*u_src >> 2];
@@ -890,6 +1600,13 @@ static void copy_row_bgrx(u8 *src, u32 src_w, u8 *dst, u32 dst_w, s32 h_inc, s32
 	u8 a=0, r=0, g=0, b=0;
 	s32 pos = 0x10000L;
 
+	//no stretch, use SIMD kernel for the bulk of the row
+	if (color_kernels.copy_rgba && (h_inc==0x10000L) && (x_pitch==4)) {
+		u32 done = color_kernels.copy_rgba(src, dst, dst_w, COLOR_ROW_BGRX);
+		src += 4*done;
+		dst += 4*done;
+		dst_w -= done;
+	}
 	while (dst_w) {
 		while ( pos >= 0x10000L ) {
 			r = *src++;
@@ -916,6 +1633,12 @@ static void copy_row_argb(u8 *src, u32 src_w, u8 *dst, u32 dst_w, s32 h_inc, s32
 	u8 a=0, r=0, g=0, b=0;
 	s32 pos = 0x10000L;
 
+	if (color_kernels.copy_rgba && (h_inc==0x10000L) && (x_pitch==4)) {
+		u32 done = color_kernels.copy_rgba(src, dst, dst_w, COLOR_ROW_ARGB);
+		src += 4*done;
+		dst += 4*done;
+		dst_w -= done;
+	}
 	while (dst_w) {
 		while ( pos >= 0x10000L ) {
 			r = *src++;
@@ -941,6 +1664,12 @@ static void copy_row_rgbx(u8 *src, u32 src_w, u8 *dst, u32 dst_w, s32 h_inc, s32
 	u8 a=0, r=0, g=0, b=0;
 	s32 pos = 0x10000L;
 
+	if (color_kernels.copy_rgba && (h_inc==0x10000L) && (x_pitch==4)) {
+		u32 done = color_kernels.copy_rgba(src, dst, dst_w, COLOR_ROW_RGBX);
+		src += 4*done;
+		dst += 4*done;
+		dst_w -= done;
+	}
 	while ( dst_w) {
 		while ( pos >= 0x10000L ) {
 			r = *src++;
@@ -1191,6 +1920,12 @@ static void merge_row_bgrx(u8 *src, u32 src_w, u8 *dst, u32 dst_w, s32 h_inc, s3
 	s32 pos;
 
 	pos = 0x10000;
+	if (color_kernels.merge_rgba && (h_inc==0x10000L) && (x_pitch==4)) {
+		u32 done = color_kernels.merge_rgba(src, dst, dst_w, alpha, COLOR_ROW_BGRX);
+		src += 4*done;
+		dst += 4*done;
+		dst_w -= done;
+	}
 	while (dst_w) {
 		while ( pos >= 0x10000L ) {
 			r = *src++;
@@ -1227,6 +1962,12 @@ static void merge_row_rgbx(u8 *src, u32 src_w, u8 *dst, u32 dst_w, s32 h_inc, s3
 	s32 pos;
 
 	pos = 0x10000;
+	if (color_kernels.merge_rgba && (h_inc==0x10000L) && (x_pitch==4)) {
+		u32 done = color_kernels.merge_rgba(src, dst, dst_w, alpha, COLOR_ROW_RGBX);
+		src += 4*done;
+		dst += 4*done;
+		dst_w -= done;
+	}
 	while (dst_w) {
 		while ( pos >= 0x10000L ) {
 			r = *src++;
@@ -1262,6 +2003,12 @@ static void merge_row_bgra(u8 *src, u32 src_w, u8 *dst, u32 dst_w, s32 h_inc, s3
 	s32 pos;
 
 	pos = 0x10000;
+	if (color_kernels.merge_rgba && (h_inc==0x10000L) && (x_pitch==4)) {
+		u32 done = color_kernels.merge_rgba(src, dst, dst_w, alpha, COLOR_ROW_BGRA);
+		src += 4*done;
+		dst += 4*done;
+		dst_w -= done;
+	}
 	while (dst_w) {
 		while ( pos >= 0x10000L ) {
 			r = *src++;
@@ -1346,6 +2093,12 @@ static void merge_row_rgba(u8 *src, u32 src_w, u8 *dst, u32 dst_w, s32 h_inc, s3
 	u32 _a, _r, _g, _b, a=0, r=0, g=0, b=0;
 	s32 pos;
 	pos = 0x10000;
+	if (color_kernels.merge_rgba && (h_inc==0x10000L) && (x_pitch==4)) {
+		u32 done = color_kernels.merge_rgba(src, dst, dst_w, alpha, COLOR_ROW_RGBA);
+		src += 4*done;
+		dst += 4*done;
+		dst_w -= done;
+	}
 	while (dst_w) {
 		while ( pos >= 0x10000L ) {
 			r = *src++;
@@ -1740,7 +2493,17 @@ static void gf_yuv_load_lines_nv12_nv21(unsigned char *dst, s32 dststride, unsig
 		}
 		return;
 	}
-	for (x = 0; x < hw; x++) {
+	x = 0;
+	if (color_kernels.yuv_to_rgba) {
+		u32 done = color_kernels.yuv_to_rgba(dst, y_src, u_src, v_src, 2, width);
+		color_kernels.yuv_to_rgba(dst2, y_src2, u_src, v_src, 2, width);
+		dst += 4*done;
+		dst2 += 4*done;
+		y_src += done;
+		y_src2 += done;
+		x = done/2;
+	}
+	for (; x < hw; x++) {
 		s32 u, v;
 		s32 b_u, g_uv, r_v, rgb_y;
 
@@ -1850,6 +2613,8 @@ GF_Err gf_stretch_bits(GF_VideoSurface *dst, GF_VideoSurface *src, GF_Window *ds
 	copy_row_proto copy_row = NULL;
 	load_line_proto load_line = NULL;
 
+	color_kernels_setup();
+
 	if (cmat && (cmat->m[15] || cmat->m[16] || cmat->m[17] || (cmat->m[18]!=FIX_ONE) || cmat->m[19] )) has_alpha = GF_TRUE;
 	else if (key && (key->alpha<0xFF)) has_alpha = GF_TRUE;
 
@@ -2541,20 +3306,6 @@ void gf_cmx_apply_fixed(GF_ColorMatrix *_this, Fixed *a, Fixed *r, Fixed *g, Fix
 
 #ifndef GPAC_DISABLE_COMPOSITOR
 
-
-//intrinsic code segfaults on 32 bit, need to check why
-#if defined(GPAC_64_BITS)
-# if defined(WIN32) && !defined(__GNUC__)
-#  include <intrin.h>
-#  define GPAC_HAS_SSE2
-# else
-#  ifdef __SSE2__
-#   include <emmintrin.h>
-#   define GPAC_HAS_SSE2
-#  endif
-# endif
-#endif
-
 #ifdef GPAC_HAS_SSE2
 
 static GF_Err color_write_yv12_10_to_yuv_intrin(GF_VideoSurface *vs_dst, unsigned char *pY, unsigned char *pU, unsigned char*pV, u32 src_stride, u32 src_width, u32 src_height, const GF_Window *_src_wnd, Bool swap_uv)
@@ -110,6 +110,7 @@ static GF_Err gf_dm_read_data(GF_DownloadSession *sess, char *data, u32 data_siz
 
 static void gf_dm_connect(GF_DownloadSession *sess);
 GF_Err gf_dm_sess_send(GF_DownloadSession *sess, u8 *data, u32 size);
+GF_Err gf_dm_sess_send_file(GF_DownloadSession *sess, FILE *file, u64 offset, u32 size, u32 *written);
 GF_Err gf_dm_sess_flush_async(GF_DownloadSession *sess, Bool no_select);
 
 /*internal flags*/
@@ -317,7 +318,10 @@ struct __gf_download_manager
 
 	GF_List *skip_proxy_servers;
 	GF_List *credentials;
-	GF_List *cache_entries;
+	GF_CacheIndex cache_entries;
+	//memory budget of cache entries, disk budget is max_cache_size
+	u64 max_cache_mem_size;
+	u64 cache_hits, cache_misses, cache_evictions;
 	/* FIXME : should be placed in DownloadedCacheEntry maybe... */
 	GF_List *partial_downloads;
 #ifdef GPAC_HAS_SSL
@@ -1754,34 +1758,26 @@ static Bool gf_dm_can_handle_url(GF_DownloadManager *dm, const char *url)
  */
 DownloadedCacheEntry gf_dm_find_cached_entry_by_url(GF_DownloadSession * sess)
 {
-	u32 i, count;
+	DownloadedCacheEntry e;
 	gf_assert( sess && sess->dm && sess->dm->cache_entries );
 	gf_mx_p( sess->dm->cache_mx );
-	count = gf_list_count(sess->dm->cache_entries);
-	for (i = 0 ; i < count; i++) {
-		const char * url;
-		DownloadedCacheEntry e = (DownloadedCacheEntry)gf_list_get(sess->dm->cache_entries, i);
-		gf_assert(e);
-		url = gf_cache_get_url(e);
-		gf_assert( url );
-
-		if (!strncmp(url, "http://gmcast/", 14)) {
-			char *sep_1 = strchr(url+14, '/');
-			char *sep_2 = strchr(sess->orig_url+14, '/');
-			if (!sep_1 || !sep_2 || strcmp(sep_1, sep_2))
-				continue;
-		} else if (strcmp(url, sess->orig_url)) continue;
+	e = gf_cache_index_find(sess->dm->cache_entries, sess->orig_url, GF_TRUE, !sess->is_range_continuation, sess->range_start, sess->range_end);
+	if (e) sess->dm->cache_hits++;
+	else sess->dm->cache_misses++;
+	gf_mx_v( sess->dm->cache_mx );
+	return e;
+}
 
-		if (! sess->is_range_continuation) {
-			if (sess->range_start != gf_cache_get_start_range(e)) continue;
-			if (sess->range_end != gf_cache_get_end_range(e)) continue;
-		}
-		/*OK that's ours*/
-		gf_mx_v( sess->dm->cache_mx );
-		return e;
+//destroys least recently used entries not in use once over budget - the cache mutex SHALL be grabbed before calling this
+static void gf_dm_cache_evict(GF_DownloadManager *dm)
+{
+	u32 nb_evicted;
+	if (!dm->max_cache_mem_size && !dm->max_cache_size) return;
+	nb_evicted = gf_cache_index_evict(dm->cache_entries, dm->max_cache_mem_size, dm->max_cache_size);
+	if (nb_evicted) {
+		dm->cache_evictions += nb_evicted;
+		GF_LOG(GF_LOG_DEBUG, GF_LOG_CACHE, ("[CACHE] Evicted %d entries, %d entries left\n", nb_evicted, gf_cache_index_count(dm->cache_entries)));
 	}
-	gf_mx_v( sess->dm->cache_mx );
-	return NULL;
 }
 
 /**
@@ -1811,6 +1807,13 @@ void gf_cache_set_downtime(const DownloadedCacheEntry entry, u32 download_time_m
  */
 static void gf_dm_remove_cache_entry_from_session(GF_DownloadSession * sess) {
 	if (sess && sess->cache_entry) {
+		//evict before detaching, so that the entry of this session is kept
+		if (sess->dm) {
+			gf_mx_p( sess->dm->cache_mx );
+			gf_cache_index_update_size(sess->dm->cache_entries, sess->cache_entry);
+			gf_dm_cache_evict(sess->dm);
+			gf_mx_v( sess->dm->cache_mx );
+		}
 		gf_cache_remove_session_from_cache_entry(sess->cache_entry, sess);
 		if (sess->dm
 		        /*JLF - not sure what the rationale of this test is, and it prevents cleanup of cache entry
@@ -1819,17 +1822,10 @@ static void gf_dm_remove_cache_entry_from_session(GF_DownloadSession * sess) {
 
 		        && (0 == gf_cache_get_sessions_count_for_cache_entry(sess->cache_entry)))
 		{
-			u32 i, count;
 			gf_mx_p( sess->dm->cache_mx );
-			count = gf_list_count( sess->dm->cache_entries );
-			for (i = 0; i < count; i++) {
-				DownloadedCacheEntry ex = (DownloadedCacheEntry)gf_list_get(sess->dm->cache_entries, i);
-				if (ex == sess->cache_entry) {
-					gf_list_rem(sess->dm->cache_entries, i);
-					gf_cache_delete_entry( sess->cache_entry );
-					sess->cache_entry = NULL;
-					break;
-				}
+			if (gf_cache_index_remove(sess->dm->cache_entries, sess->cache_entry)) {
+				gf_cache_delete_entry( sess->cache_entry );
+				sess->cache_entry = NULL;
 			}
 			gf_mx_v( sess->dm->cache_mx );
 		}
@@ -1852,7 +1848,10 @@ static void gf_dm_sess_notify_state(GF_DownloadSession *sess, GF_NetIOStatus dnl
 static void gf_dm_configure_cache(GF_DownloadSession *sess)
 {
 	DownloadedCacheEntry entry;
+	GF_Mutex *cache_mx = sess->dm ? sess->dm->cache_mx : NULL;
 	GF_LOG(GF_LOG_DEBUG, GF_LOG_CACHE, ("[Downloader] gf_dm_configure_cache(%p), cached=%s URL=%s\n", sess, (sess->flags & GF_NETIO_SESSION_NOT_CACHED) ? "no" : "yes", sess->orig_url ));
+	//prevent eviction of the previous and new entries of the session until the session is attached
+	gf_mx_p( cache_mx );
 	gf_dm_remove_cache_entry_from_session(sess);
 	//session is not cached and we don't cache the first URL
 	if ((sess->flags & GF_NETIO_SESSION_NOT_CACHED) && !(sess->flags & GF_NETIO_SESSION_KEEP_FIRST_CACHE))  {
@@ -1861,6 +1860,7 @@ static void gf_dm_configure_cache(GF_DownloadSession *sess)
 			gf_cache_close_write_cache(sess->cache_entry, sess, GF_FALSE);
 
 		sess->cache_entry = NULL;
+		gf_mx_v( cache_mx );
 	} else {
 		Bool found = GF_FALSE;
 		u32 i, count;
@@ -1869,6 +1869,7 @@ static void gf_dm_configure_cache(GF_DownloadSession *sess)
 			if (sess->local_cache_only) {
 				sess->cache_entry = NULL;
 				SET_LAST_ERR(GF_URL_ERROR)
+				gf_mx_v( cache_mx );
 				return;
 			}
 			/* We found the existing session */
@@ -1886,10 +1887,8 @@ static void gf_dm_configure_cache(GF_DownloadSession *sess)
 					gf_cache_entry_set_delete_files_when_deleted(sess->cache_entry);
 
 				if (!gf_cache_entry_persistent(sess->cache_entry) && !gf_cache_get_sessions_count_for_cache_entry(sess->cache_entry)) {
-					gf_mx_p( sess->dm->cache_mx );
 					/* No session attached anymore... we can delete it */
-					gf_list_del_item(sess->dm->cache_entries, sess->cache_entry);
-					gf_mx_v( sess->dm->cache_mx );
+					gf_cache_index_remove(sess->dm->cache_entries, sess->cache_entry);
 					gf_cache_delete_entry(sess->cache_entry);
 				}
 				sess->cache_entry = NULL;
@@ -1897,11 +1896,10 @@ static void gf_dm_configure_cache(GF_DownloadSession *sess)
 			entry = gf_cache_create_entry(sess->dm, sess->dm->cache_directory, sess->orig_url, sess->range_start, sess->range_end, (sess->flags&GF_NETIO_SESSION_MEMORY_CACHE) ? GF_TRUE : GF_FALSE, sess->dm->cache_mx);
 			if (!entry) {
 				SET_LAST_ERR(GF_OUT_OF_MEM)
+				gf_mx_v( cache_mx );
 				return;
 			}
-			gf_mx_p( sess->dm->cache_mx );
-			gf_list_add(sess->dm->cache_entries, entry);
-			gf_mx_v( sess->dm->cache_mx );
+			gf_cache_index_add(sess->dm->cache_entries, entry);
 			sess->is_range_continuation = GF_FALSE;
 		}
 		sess->cache_entry = entry;
@@ -1935,6 +1933,7 @@ static void gf_dm_configure_cache(GF_DownloadSession *sess)
 				gf_cache_entry_set_persistent(sess->cache_entry);
 			}
 		}
+		gf_mx_v( cache_mx );
 
 		if ( (sess->allow_direct_reuse || sess->dm->allow_offline_cache) && !gf_cache_check_if_cache_file_is_corrupted(sess->cache_entry)
 		) {
@@ -1950,8 +1949,8 @@ static void gf_dm_configure_cache(GF_DownloadSession *sess)
 void gf_dm_delete_cached_file_entry(const GF_DownloadManager * dm,  const char * url)
 {
 	GF_Err e;
-	u32 count, i;
 	char * realURL;
+	DownloadedCacheEntry cache_ent;
 	GF_URL_Info info;
 	if (!url || !dm)
 		return;
@@ -1966,26 +1965,19 @@ void gf_dm_delete_cached_file_entry(const GF_DownloadManager * dm,  const char *
 	realURL = gf_strdup(info.canonicalRepresentation);
 	gf_dm_url_info_del(&info);
 	gf_assert( realURL );
-	count = gf_list_count(dm->cache_entries);
-	for (i = 0 ; i < count; i++) {
-		const char * e_url;
-		DownloadedCacheEntry cache_ent = (DownloadedCacheEntry)gf_list_get(dm->cache_entries, i);
-		gf_assert(cache_ent);
-		e_url = gf_cache_get_url(cache_ent);
-		gf_assert( e_url );
-		if (!strcmp(e_url, realURL)) {
-			/* We found the existing session */
-			gf_cache_entry_set_delete_files_when_deleted(cache_ent);
-			if (0 == gf_cache_get_sessions_count_for_cache_entry( cache_ent )) {
-				/* No session attached anymore... we can delete it */
-				gf_list_rem(dm->cache_entries, i);
-				gf_cache_delete_entry(cache_ent);
-			}
-			/* If deleted or not, we don't search further */
-			gf_mx_v( dm->cache_mx );
-			gf_free(realURL);
-			return;
-		}
+	cache_ent = gf_cache_index_find(dm->cache_entries, realURL, GF_FALSE, GF_FALSE, 0, 0);
+	if (cache_ent) {
+		/* We found the existing session */
+		gf_cache_entry_set_delete_files_when_deleted(cache_ent);
+		if (0 == gf_cache_get_sessions_count_for_cache_entry( cache_ent )) {
+			/* No session attached anymore... we can delete it */
+			gf_cache_index_remove(dm->cache_entries, cache_ent);
+			gf_cache_delete_entry(cache_ent);
+		}
+		/* If deleted or not, we don't search further */
+		gf_mx_v( dm->cache_mx );
+		gf_free(realURL);
+		return;
 	}
 	/* If we are heren it means we did not found this URL in cache */
 	gf_mx_v( dm->cache_mx );
@@ -3987,7 +3979,7 @@ GF_DownloadManager *gf_dm_new(GF_FilterSession *fsess)
 		return NULL;
 	}
 	dm->sessions = gf_list_new();
-	dm->cache_entries = gf_list_new();
+	dm->cache_entries = gf_cache_index_new();
 	dm->credentials = gf_list_new();
 	dm->skip_proxy_servers = gf_list_new();
 	dm->partial_downloads = gf_list_new();
@@ -4063,6 +4055,7 @@ retry_cache:
 			gf_dm_clean_cache(dm);
 		}
 	}
+	dm->max_cache_mem_size = gf_opts_get_int("core", "cache-mem");
 	dm->allow_broken_certificate = gf_opts_get_bool("core", "broken-cert");
 
 	gf_mx_v( dm->cache_mx );
@@ -4132,14 +4125,15 @@ void gf_dm_del(GF_DownloadManager *dm)
 	{
 		/* Deletes DownloadedCacheEntry and associated files if required */
 		Bool delete_my_files = gf_dm_needs_to_delete_cache(dm);
-		while (gf_list_count(dm->cache_entries)) {
-			const DownloadedCacheEntry entry = (const DownloadedCacheEntry)gf_list_get( dm->cache_entries, 0);
-			gf_list_rem( dm->cache_entries, 0);
+		GF_LOG(GF_LOG_INFO, GF_LOG_CACHE, ("[CACHE] "LLU" hits "LLU" misses "LLU" evictions\n", dm->cache_hits, dm->cache_misses, dm->cache_evictions));
+		while (gf_cache_index_count(dm->cache_entries)) {
+			const DownloadedCacheEntry entry = gf_cache_index_get_oldest(dm->cache_entries);
+			gf_cache_index_remove(dm->cache_entries, entry);
 			if (delete_my_files)
 				gf_cache_entry_set_delete_files_when_deleted(entry);
 			gf_cache_delete_entry(entry);
 		}
-		gf_list_del( dm->cache_entries );
+		gf_cache_index_del( dm->cache_entries );
 		dm->cache_entries = NULL;
 	}
 
@@ -6927,36 +6921,19 @@ GF_Err gf_dm_set_localcache_provider(GF_DownloadManager *dm, Bool (*local_cache_
 GF_EXPORT
 DownloadedCacheEntry gf_dm_add_cache_entry(GF_DownloadManager *dm, const char *szURL, GF_Blob *blob, u64 start_range, u64 end_range, const char *mime, Bool clone_memory, u32 download_time_ms)
 {
-	u32 i, count;
 	DownloadedCacheEntry the_entry = NULL;
 
 	gf_mx_p(dm->cache_mx );
 	if (blob)
 		GF_LOG(GF_LOG_INFO, GF_LOG_CACHE, ("[HTTP] Pushing %s to cache "LLU" bytes (done %s)\n", szURL, blob->size, (blob->flags & GF_BLOB_IN_TRANSFER) ? "no" : "yes"));
-	count = gf_list_count(dm->cache_entries);
-	for (i = 0 ; i < count; i++) {
-		const char * url;
-		DownloadedCacheEntry e = (DownloadedCacheEntry)gf_list_get(dm->cache_entries, i);
-		gf_assert(e);
-		url = gf_cache_get_url(e);
-		gf_assert( url );
-		if (strcmp(url, szURL)) continue;
-
-		if (end_range) {
-			if (start_range != gf_cache_get_start_range(e)) continue;
-			if (end_range != gf_cache_get_end_range(e)) continue;
-		}
-		/*OK that's ours*/
-		the_entry = e;
-		break;
-	}
+	the_entry = gf_cache_index_find(dm->cache_entries, szURL, GF_FALSE, end_range ? GF_TRUE : GF_FALSE, start_range, end_range);
 	if (!the_entry) {
 		the_entry = gf_cache_create_entry(dm, "", szURL, 0, 0, GF_TRUE, dm->cache_mx);
 		if (!the_entry) {
 			gf_mx_v(dm->cache_mx );
 			return NULL;
 		}
-		gf_list_add(dm->cache_entries, the_entry);
+		gf_cache_index_add(dm->cache_entries, the_entry);
 	}
 
 	gf_cache_set_mime(the_entry, mime);
@@ -6965,10 +6942,27 @@ DownloadedCacheEntry gf_dm_add_cache_entry(GF_DownloadManager *dm, const char *s
 
 	gf_cache_set_content(the_entry, blob, clone_memory ? GF_TRUE : GF_FALSE, dm->cache_mx);
 	gf_cache_set_downtime(the_entry, download_time_ms);
+	gf_cache_index_update_size(dm->cache_entries, the_entry);
+	//pushed entries are only evicted once deleted, so the returned entry is kept
+	if (blob) gf_dm_cache_evict(dm);
 	gf_mx_v(dm->cache_mx );
 	return the_entry;
 }
 
+GF_EXPORT
+GF_Err gf_dm_get_cache_stats(GF_DownloadManager *dm, GF_DownloadCacheStats *stats)
+{
+	if (!dm || !stats) return GF_BAD_PARAM;
+	gf_mx_p(dm->cache_mx);
+	stats->hits = dm->cache_hits;
+	stats->misses = dm->cache_misses;
+	stats->evictions = dm->cache_evictions;
+	stats->nb_entries = gf_cache_index_count(dm->cache_entries);
+	gf_cache_index_get_size(dm->cache_entries, &stats->mem_size, &stats->disk_size);
+	gf_mx_v(dm->cache_mx);
+	return GF_OK;
+}
+
 GF_EXPORT
 GF_Err gf_dm_force_headers(GF_DownloadManager *dm, const DownloadedCacheEntry entry, const char *headers)
 {
@@ -7147,6 +7141,30 @@ GF_Err gf_dm_sess_send(GF_DownloadSession *sess, u8 *data, u32 size)
 	return e;
 }
 
+//zero-copy send of a file range for plain HTTP/1.1 sessions, GF_NOT_SUPPORTED if the caller must use gf_dm_sess_send
+GF_EXPORT
+GF_Err gf_dm_sess_send_file(GF_DownloadSession *sess, FILE *file, u64 offset, u32 size, u32 *written)
+{
+	GF_Err e;
+	*written = 0;
+	if (!sess->sock) return GF_NOT_SUPPORTED;
+#ifdef GPAC_HAS_HTTP2
+	if (sess->h2_sess) return GF_NOT_SUPPORTED;
+#endif
+#ifdef GPAC_HAS_SSL
+	if (sess->ssl) return GF_NOT_SUPPORTED;
+#endif
+	//pending async data must go first
+	if (sess->async_buf_size) return GF_IP_NETWORK_EMPTY;
+
+	e = gf_sk_send_file(sess->sock, file, offset, size, written);
+	if (e==GF_IP_CONNECTION_CLOSED) {
+		sess_connection_closed(sess);
+		sess->status = GF_NETIO_STATE_ERROR;
+	}
+	return e;
+}
+
 void gf_dm_sess_flush_h2(GF_DownloadSession *sess)
 {
 #ifdef GPAC_HAS_HTTP2
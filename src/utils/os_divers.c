@@ -943,6 +943,8 @@ char gf_prog_lf = '\r';
 
 #ifndef GPAC_DISABLE_NETWORK
 extern Bool gpac_use_poll;
+extern Bool gpac_use_epoll;
+extern Bool gpac_use_gso;
 #endif
 
 GF_EXPORT
@@ -957,6 +959,8 @@ GF_Err gf_sys_set_args(s32 argc, const char **argv)
 
 #ifndef GPAC_DISABLE_NETWORK
 		gpac_use_poll = GF_TRUE;
+		gpac_use_epoll = GF_TRUE;
+		gpac_use_gso = GF_TRUE;
 #endif
 		for (i=1; i<argc; i++) {
 			Bool consumed;
@@ -1028,6 +1032,14 @@ GF_Err gf_sys_set_args(s32 argc, const char **argv)
 			} else if (!stricmp(arg, "-no-poll")) {
 #ifndef GPAC_DISABLE_NETWORK
 				gpac_use_poll = bool_value;
+#endif
+			} else if (!stricmp(arg, "-no-epoll")) {
+#ifndef GPAC_DISABLE_NETWORK
+				gpac_use_epoll = bool_value ? GF_FALSE : GF_TRUE;
+#endif
+			} else if (!stricmp(arg, "-no-gso")) {
+#ifndef GPAC_DISABLE_NETWORK
+				gpac_use_gso = bool_value ? GF_FALSE : GF_TRUE;
 #endif
 			}
 #if !defined(GPAC_DISABLE_NETCAP)
@@ -3208,6 +3220,80 @@ GF_Err gf_file_load_data(const char *file_name, u8 **out_data, u32 *out_size)
 	return e;
 }
 
+#if !defined(WIN32) && !defined(GPAC_CONFIG_EMSCRIPTEN)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#elif defined(WIN32)
+#include <gpac/utf.h>
+#endif
+
+GF_EXPORT
+u8 *gf_file_mmap(const char *file_name, u64 *out_size)
+{
+	u8 *data = NULL;
+	u64 size = 0;
+	if (out_size) *out_size = 0;
+	if (!file_name || !out_size) return NULL;
+	//no mapping of wrapped IOs
+	if (!strncmp(file_name, "gfio://", 7) || !strncmp(file_name, "gmem://", 7))
+		return NULL;
+
+#if defined(WIN32)
+	{
+		LARGE_INTEGER fsize;
+		HANDLE hfile, hmap;
+		wchar_t *wname = gf_utf8_to_wcs(file_name);
+		if (!wname) return NULL;
+		hfile = CreateFileW(wname, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		gf_free(wname);
+		if (hfile == INVALID_HANDLE_VALUE) return NULL;
+		if (!GetFileSizeEx(hfile, &fsize) || !fsize.QuadPart || ((sizeof(SIZE_T)<8) && (fsize.QuadPart >= 0x7FFFFFFF))) {
+			CloseHandle(hfile);
+			return NULL;
+		}
+		size = (u64) fsize.QuadPart;
+		hmap = CreateFileMapping(hfile, NULL, PAGE_READONLY, 0, 0, NULL);
+		CloseHandle(hfile);
+		if (!hmap) return NULL;
+		data = (u8 *) MapViewOfFile(hmap, FILE_MAP_READ, 0, 0, (SIZE_T) size);
+		CloseHandle(hmap);
+	}
+#elif !defined(GPAC_CONFIG_EMSCRIPTEN)
+	{
+		struct stat st;
+		void *ptr;
+		int fd = open(file_name, O_RDONLY);
+		if (fd<0) return NULL;
+		if (fstat(fd, &st) || (st.st_size<=0) || ((sizeof(size_t)<8) && (st.st_size >= 0x7FFFFFFF))) {
+			close(fd);
+			return NULL;
+		}
+		size = (u64) st.st_size;
+		//read-only mapping: callers must copy the data before modifying it
+		ptr = mmap(NULL, (size_t) size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if (ptr == MAP_FAILED) return NULL;
+		data = (u8 *) ptr;
+	}
+#endif
+	if (!data) return NULL;
+	GF_LOG(GF_LOG_DEBUG, GF_LOG_CORE, ("[Core] Mapped file %s ("LLU" bytes)\n", file_name, size));
+	*out_size = size;
+	return data;
+}
+
+GF_EXPORT
+void gf_file_munmap(u8 *data, u64 size)
+{
+	if (!data) return;
+#if defined(WIN32)
+	UnmapViewOfFile(data);
+#elif !defined(GPAC_CONFIG_EMSCRIPTEN)
+	munmap(data, (size_t) size);
+#endif
+}
+
 #ifndef WIN32
 #include <unistd.h>
 GF_EXPORT
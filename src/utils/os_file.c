@@ -23,6 +23,11 @@
  *
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+//for fallocate
+#define _GNU_SOURCE
+#endif
+
 #include <gpac/tools.h>
 #include <gpac/utf.h>
 
@@ -46,6 +51,12 @@
 #include <dirent.h>
 #include <sys/time.h>
 
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <linux/falloc.h>
+#endif
+
 #ifndef __BEOS__
 #include <errno.h>
 #endif
@@ -1471,6 +1482,152 @@ GF_FileIO *gf_fileio_from_mem(const char *URL, const u8 *data, u32 size)
 }
 
 
+typedef struct
+{
+	u8 *data;
+	u32 size, alloc, pos;
+} GF_FileIOMem;
+
+static GF_FileIO *gfio_mem_open(GF_FileIO *fileio_ref, const char *url, const char *mode, GF_Err *out_error)
+{
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio_ref);
+	*out_error = GF_OK;
+	if (!strcmp(mode, "close")) {
+		if (mem->data) gf_free(mem->data);
+		gf_free(mem);
+		gf_fileio_del(fileio_ref);
+		return NULL;
+	}
+	*out_error = GF_NOT_SUPPORTED;
+	return NULL;
+}
+static GF_Err gfio_mem_seek(GF_FileIO *fileio, u64 offset, s32 whence)
+{
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio);
+	if (whence==SEEK_END) offset += mem->size;
+	else if (whence==SEEK_CUR) offset += mem->pos;
+	if (offset > mem->size) return GF_BAD_PARAM;
+	mem->pos = (u32) offset;
+	return GF_OK;
+}
+static u32 gfio_mem_read(GF_FileIO *fileio, u8 *buffer, u32 bytes)
+{
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio);
+	if (bytes + mem->pos > mem->size)
+		bytes = mem->size - mem->pos;
+	if (bytes) {
+		memcpy(buffer, mem->data+mem->pos, bytes);
+		mem->pos += bytes;
+	}
+	return bytes;
+}
+static GF_Err gfio_mem_realloc(GF_FileIOMem *mem, u32 size)
+{
+	u8 *data;
+	u32 alloc = mem->alloc ? mem->alloc : 1024;
+	if (size <= mem->alloc) return GF_OK;
+	while (alloc < size) alloc *= 2;
+	//keep current content on failure
+	data = gf_realloc(mem->data, alloc);
+	if (!data) return GF_OUT_OF_MEM;
+	mem->data = data;
+	mem->alloc = alloc;
+	return GF_OK;
+}
+static u32 gfio_mem_write(GF_FileIO *fileio, u8 *buffer, u32 bytes)
+{
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio);
+	//flush
+	if (!bytes) return 0;
+	if (gfio_mem_realloc(mem, mem->pos + bytes)) return 0;
+	memcpy(mem->data+mem->pos, buffer, bytes);
+	mem->pos += bytes;
+	if (mem->pos > mem->size) mem->size = mem->pos;
+	return bytes;
+}
+static s64 gfio_mem_tell(GF_FileIO *fileio)
+{
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio);
+	return (s64) mem->pos;
+}
+static Bool gfio_mem_eof(GF_FileIO *fileio)
+{
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio);
+	return (mem->pos==mem->size) ? GF_TRUE : GF_FALSE;
+}
+static int gfio_mem_printf(GF_FileIO *fileio, const char *format, va_list args)
+{
+	va_list args_copy;
+	s32 len;
+	GF_FileIOMem *mem = gf_fileio_get_udta(fileio);
+
+	//format in place when appending, the terminating 0 is written in the spare allocated space
+	va_copy(args_copy, args);
+	if (mem->pos==mem->size)
+		len = vsnprintf(mem->data ? (char *) mem->data+mem->pos : NULL, mem->alloc - mem->pos, format, args_copy);
+	else
+		len = vsnprintf(NULL, 0, format, args_copy);
+	va_end(args_copy);
+	if (len<=0) return len;
+
+	if ((mem->pos==mem->size) && (mem->pos + len < mem->alloc)) {
+		mem->pos += len;
+		mem->size = mem->pos;
+		return len;
+	}
+	if (gfio_mem_realloc(mem, mem->size + len + 1)) return -1;
+	if (mem->pos==mem->size) {
+		vsnprintf((char *) mem->data+mem->pos, len+1, format, args);
+		mem->pos += len;
+		mem->size = mem->pos;
+	} else {
+		//overwrite in the middle of the file, format at the end and move
+		vsnprintf((char *) mem->data+mem->size, len+1, format, args);
+		memmove(mem->data+mem->pos, mem->data+mem->size, len);
+		mem->pos += len;
+		if (mem->pos > mem->size) mem->size = mem->pos;
+	}
+	return len;
+}
+
+GF_EXPORT
+FILE *gf_file_mem_new()
+{
+	GF_FileIO *gfio;
+	GF_FileIOMem *mem;
+	GF_SAFEALLOC(mem, GF_FileIOMem);
+	if (!mem) return NULL;
+	gfio = gf_fileio_new(NULL, mem, gfio_mem_open, gfio_mem_seek, gfio_mem_read, gfio_mem_write, gfio_mem_tell, gfio_mem_eof, gfio_mem_printf);
+	if (!gfio) {
+		gf_free(mem);
+		return NULL;
+	}
+	return (FILE *) gfio;
+}
+
+static GF_FileIOMem *gf_file_mem_get(FILE *file)
+{
+	if (!gf_fileio_check(file) || (((GF_FileIO *)file)->open != gfio_mem_open))
+		return NULL;
+	return gf_fileio_get_udta((GF_FileIO *)file);
+}
+
+GF_EXPORT
+u8 *gf_file_mem_get_data(FILE *file, u32 *size)
+{
+	GF_FileIOMem *mem = gf_file_mem_get(file);
+	if (size) *size = mem ? mem->size : 0;
+	if (!mem || !mem->size) return NULL;
+	return mem->data;
+}
+
+GF_EXPORT
+void gf_file_mem_reset(FILE *file)
+{
+	GF_FileIOMem *mem = gf_file_mem_get(file);
+	if (mem) mem->size = mem->pos = 0;
+}
+
 #ifdef GPAC_CONFIG_EMSCRIPTEN
 static u32 mainloop_th_id = 0;
 void gf_set_mainloop_thread(u32 thread_id)
@@ -1834,6 +1991,583 @@ u64 gf_fsize(FILE *fp)
 	return size;
 }
 
+GF_EXPORT
+u32 gf_file_block_size(FILE *fp)
+{
+#if defined(__linux__)
+	struct stat st;
+	if (!fp || gf_fileio_check(fp)) return 0;
+	if ((fileno(fp)<0) || fstat(fileno(fp), &st)) return 0;
+	if (!S_ISREG(st.st_mode)) return 0;
+	return (u32) st.st_blksize;
+#else
+	return 0;
+#endif
+}
+
+GF_EXPORT
+GF_Err gf_file_insert_range(FILE *fp, u64 offset, u64 size)
+{
+#if defined(__linux__) && defined(FALLOC_FL_INSERT_RANGE)
+	int fd;
+	if (!fp || gf_fileio_check(fp)) return GF_NOT_SUPPORTED;
+	fd = fileno(fp);
+	if (fd<0) return GF_NOT_SUPPORTED;
+	if (!size) return GF_OK;
+	fflush(fp);
+	if (fallocate(fd, FALLOC_FL_INSERT_RANGE, (off_t) offset, (off_t) size) == 0)
+		return GF_OK;
+	//not supported by the file system or not block-aligned
+	if ((errno==EOPNOTSUPP) || (errno==ENOSYS) || (errno==EINVAL))
+		return GF_NOT_SUPPORTED;
+	GF_LOG(GF_LOG_ERROR, GF_LOG_CORE, ("[Core] Failed to insert "LLU" bytes at offset "LLU": %s\n", size, offset, strerror(errno)));
+	return GF_IO_ERR;
+#else
+	return GF_NOT_SUPPORTED;
+#endif
+}
+
+#ifdef GPAC_HAS_FD
+GF_EXPORT
+GF_Err gf_fd_copy_range(int fd, u64 src_offset, u64 dst_offset, u64 size)
+{
+#if defined(__linux__) && defined(SYS_copy_file_range)
+	u64 dist, done=0;
+	Bool copied=GF_FALSE;
+	if (fd<0) return GF_NOT_SUPPORTED;
+	if ((src_offset==dst_offset) || !size) return GF_OK;
+
+	//source and destination cannot overlap within a single call, copy by pieces of at most the copy distance
+	//starting from the end when moving data towards the end of the file
+	dist = (dst_offset > src_offset) ? (dst_offset - src_offset) : (src_offset - dst_offset);
+	if (dist > 0x40000000) dist = 0x40000000;
+	while (done < size) {
+		s64 off_in, off_out;
+		u64 len = MIN(dist, size - done);
+		if (dst_offset > src_offset) {
+			off_in = src_offset + size - done - len;
+			off_out = dst_offset + size - done - len;
+		} else {
+			off_in = src_offset + done;
+			off_out = dst_offset + done;
+		}
+		done += len;
+		while (len) {
+			s64 res = syscall(SYS_copy_file_range, fd, &off_in, fd, &off_out, (size_t) len, 0);
+			if (res<=0) {
+				if (!res) return GF_IO_ERR;
+				//nothing copied yet and not supported by the kernel or file system, let the caller copy
+				if (!copied && ((errno==ENOSYS) || (errno==EXDEV) || (errno==EINVAL) || (errno==EOPNOTSUPP)))
+					return GF_NOT_SUPPORTED;
+				GF_LOG(GF_LOG_ERROR, GF_LOG_CORE, ("[Core] Failed to copy "LLU" bytes from offset "LLU" to "LLU": %s\n", len, (u64) off_in, (u64) off_out, strerror(errno)));
+				return GF_IO_ERR;
+			}
+			len -= (u64) res;
+			copied = GF_TRUE;
+		}
+	}
+	return GF_OK;
+#else
+	return GF_NOT_SUPPORTED;
+#endif
+}
+#endif
+
+GF_EXPORT
+GF_Err gf_file_copy_range(FILE *fp, u64 src_offset, u64 dst_offset, u64 size)
+{
+#ifdef GPAC_HAS_FD
+	if (!fp || gf_fileio_check(fp)) return GF_NOT_SUPPORTED;
+	fflush(fp);
+	return gf_fd_copy_range(fileno(fp), src_offset, dst_offset, size);
+#else
+	return GF_NOT_SUPPORTED;
+#endif
+}
+
+#if defined(GPAC_HAS_FD) && !defined(WIN32)
+#define GF_AIO_FD
+
+#if defined(__linux__) && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <sys/mman.h>
+#include <linux/io_uring.h>
+//read, write and close operations appeared together with this feature flag (Linux 5.6)
+#ifdef IORING_FEAT_RW_CUR_POS
+#define GF_AIO_URING
+#endif
+#endif
+#endif
+
+#endif //GPAC_HAS_FD && !WIN32
+
+enum
+{
+	GF_AIO_READ = 0,
+	GF_AIO_WRITE,
+	GF_AIO_SYNC,
+	GF_AIO_CLOSE,
+};
+
+typedef struct
+{
+	u32 type;
+	s32 fd;
+	u8 *buf;
+	u32 size, done;
+	u64 offset;
+	void *udta;
+	s32 res;
+} GF_AIOReq;
+
+struct __gf_file_aio
+{
+	u32 depth;
+	GF_AIOReq *reqs;
+	//free slots (stack, caller thread only) and completed slots (FIFO, shared with the I/O thread)
+	u32 *free_slots, nb_free;
+	u32 *done_slots, done_first, nb_done;
+	//submitted and not yet collected
+	u32 nb_pending;
+	const char *backend;
+#ifdef GF_AIO_URING
+	s32 ring_fd;
+	u8 *sq_ring, *cq_ring;
+	size_t sq_ring_size, cq_ring_size, sqes_size;
+	struct io_uring_sqe *sqes;
+	struct io_uring_cqe *cqes;
+	u32 *sq_tail, *sq_array, sq_mask;
+	u32 *cq_head, *cq_tail, cq_mask;
+#endif
+#ifndef GPAC_DISABLE_THREADS
+	GF_Thread *th;
+	GF_Mutex *mx;
+	GF_Semaphore *todo_sem, *done_sem;
+	u32 *todo_slots, todo_first, nb_todo;
+	Bool th_exit;
+#endif
+};
+
+#ifdef GF_AIO_FD
+static void aio_push_done(GF_FileAIO *aio, u32 slot)
+{
+	aio->done_slots[(aio->done_first + aio->nb_done) % aio->depth] = slot;
+	aio->nb_done++;
+}
+
+//blocking execution, used by the I/O thread and when no thread is available
+static void aio_exec(GF_AIOReq *req)
+{
+	req->res = 0;
+	switch (req->type) {
+	case GF_AIO_READ:
+	case GF_AIO_WRITE:
+		while (req->done < req->size) {
+			ssize_t res;
+			if (req->type==GF_AIO_READ)
+				res = pread(req->fd, req->buf + req->done, req->size - req->done, (off_t) (req->offset + req->done));
+			else
+				res = pwrite(req->fd, req->buf + req->done, req->size - req->done, (off_t) (req->offset + req->done));
+			if (res<0) {
+				if (errno==EINTR) continue;
+				req->res = -errno;
+				return;
+			}
+			if (!res) break;
+			req->done += (u32) res;
+		}
+		req->res = (s32) req->done;
+		break;
+	case GF_AIO_SYNC:
+#if defined(__APPLE__)
+		if (fsync(req->fd)) req->res = -errno;
+#else
+		if (fdatasync(req->fd)) req->res = -errno;
+#endif
+		break;
+	case GF_AIO_CLOSE:
+		if (close(req->fd)) req->res = -errno;
+		break;
+	}
+}
+#endif
+
+#ifdef GF_AIO_URING
+static s32 aio_uring_enter(GF_FileAIO *aio, u32 to_submit, u32 min_complete)
+{
+	s32 res;
+	do {
+		res = (s32) syscall(__NR_io_uring_enter, aio->ring_fd, to_submit, min_complete, min_complete ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+	} while ((res<0) && (errno==EINTR));
+	return res;
+}
+
+static void aio_uring_queue(GF_FileAIO *aio, u32 slot)
+{
+	GF_AIOReq *req = &aio->reqs[slot];
+	u32 tail = *aio->sq_tail;
+	u32 idx = tail & aio->sq_mask;
+	struct io_uring_sqe *sqe = &aio->sqes[idx];
+
+	memset(sqe, 0, sizeof(struct io_uring_sqe));
+	sqe->fd = req->fd;
+	sqe->user_data = slot;
+	switch (req->type) {
+	case GF_AIO_READ:
+	case GF_AIO_WRITE:
+		sqe->opcode = (req->type==GF_AIO_READ) ? IORING_OP_READ : IORING_OP_WRITE;
+		sqe->addr = (u64) (uintptr_t) (req->buf + req->done);
+		sqe->len = req->size - req->done;
+		sqe->off = req->offset + req->done;
+		break;
+	case GF_AIO_SYNC:
+		sqe->opcode = IORING_OP_FSYNC;
+		sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+		sqe->flags = IOSQE_IO_DRAIN;
+		break;
+	case GF_AIO_CLOSE:
+		sqe->opcode = IORING_OP_CLOSE;
+		sqe->flags = IOSQE_IO_DRAIN;
+		break;
+	}
+	aio->sq_array[idx] = idx;
+	__atomic_store_n(aio->sq_tail, tail+1, __ATOMIC_RELEASE);
+}
+
+static void aio_uring_reap(GF_FileAIO *aio)
+{
+	u32 nb_requeue = 0;
+	u32 head = *aio->cq_head;
+	u32 tail = __atomic_load_n(aio->cq_tail, __ATOMIC_ACQUIRE);
+
+	while (head != tail) {
+		struct io_uring_cqe *cqe = &aio->cqes[head & aio->cq_mask];
+		u32 slot = (u32) cqe->user_data;
+		GF_AIOReq *req = &aio->reqs[slot];
+		s32 res = cqe->res;
+		head++;
+		if ((req->type==GF_AIO_READ) || (req->type==GF_AIO_WRITE)) {
+			if (res>0) {
+				req->done += (u32) res;
+				//partial read or write, queue the remaining range
+				if (req->done < req->size) {
+					aio_uring_queue(aio, slot);
+					nb_requeue++;
+					continue;
+				}
+			}
+			if (res>=0) res = (s32) req->done;
+		}
+		req->res = res;
+		aio_push_done(aio, slot);
+	}
+	__atomic_store_n(aio->cq_head, head, __ATOMIC_RELEASE);
+	if (nb_requeue)
+		aio_uring_enter(aio, nb_requeue, 0);
+}
+
+static void aio_uring_del(GF_FileAIO *aio)
+{
+	if (aio->sqes) munmap(aio->sqes, aio->sqes_size);
+	if (aio->cq_ring && (aio->cq_ring != aio->sq_ring)) munmap(aio->cq_ring, aio->cq_ring_size);
+	if (aio->sq_ring) munmap(aio->sq_ring, aio->sq_ring_size);
+	if (aio->ring_fd>=0) close(aio->ring_fd);
+	aio->sqes = NULL;
+	aio->sq_ring = aio->cq_ring = NULL;
+	aio->ring_fd = -1;
+}
+
+static Bool aio_uring_setup(GF_FileAIO *aio)
+{
+	void *ptr;
+	struct io_uring_params p;
+	memset(&p, 0, sizeof(struct io_uring_params));
+	aio->ring_fd = (s32) syscall(__NR_io_uring_setup, aio->depth, &p);
+	if (aio->ring_fd<0) {
+		GF_LOG(GF_LOG_INFO, GF_LOG_CORE, ("[Core] io_uring not available (%s), using I/O thread\n", strerror(errno)));
+		return GF_FALSE;
+	}
+	if (!(p.features & IORING_FEAT_RW_CUR_POS)) goto err;
+
+	aio->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(u32);
+	aio->cq_ring_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+	if (p.features & IORING_FEAT_SINGLE_MMAP) {
+		aio->sq_ring_size = aio->cq_ring_size = MAX(aio->sq_ring_size, aio->cq_ring_size);
+	}
+	ptr = mmap(NULL, aio->sq_ring_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, aio->ring_fd, IORING_OFF_SQ_RING);
+	if (ptr==MAP_FAILED) goto err;
+	aio->sq_ring = ptr;
+	if (p.features & IORING_FEAT_SINGLE_MMAP) {
+		aio->cq_ring = aio->sq_ring;
+	} else {
+		ptr = mmap(NULL, aio->cq_ring_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, aio->ring_fd, IORING_OFF_CQ_RING);
+		if (ptr==MAP_FAILED) goto err;
+		aio->cq_ring = ptr;
+	}
+	aio->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+	ptr = mmap(NULL, aio->sqes_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, aio->ring_fd, IORING_OFF_SQES);
+	if (ptr==MAP_FAILED) goto err;
+	aio->sqes = ptr;
+
+	aio->sq_tail = (u32 *) (aio->sq_ring + p.sq_off.tail);
+	aio->sq_mask = *(u32 *) (aio->sq_ring + p.sq_off.ring_mask);
+	aio->sq_array = (u32 *) (aio->sq_ring + p.sq_off.array);
+	aio->cq_head = (u32 *) (aio->cq_ring + p.cq_off.head);
+	aio->cq_tail = (u32 *) (aio->cq_ring + p.cq_off.tail);
+	aio->cq_mask = *(u32 *) (aio->cq_ring + p.cq_off.ring_mask);
+	aio->cqes = (struct io_uring_cqe *) (aio->cq_ring + p.cq_off.cqes);
+	aio->backend = "io_uring";
+	return GF_TRUE;
+
+err:
+	GF_LOG(GF_LOG_INFO, GF_LOG_CORE, ("[Core] io_uring setup failed, using I/O thread\n"));
+	aio_uring_del(aio);
+	return GF_FALSE;
+}
+#endif //GF_AIO_URING
+
+#if defined(GF_AIO_FD) && !defined(GPAC_DISABLE_THREADS)
+static u32 aio_thread_proc(void *par)
+{
+	GF_FileAIO *aio = (GF_FileAIO *) par;
+	while (1) {
+		u32 slot;
+		gf_sema_wait(aio->todo_sem);
+		gf_mx_p(aio->mx);
+		if (!aio->nb_todo) {
+			Bool done = aio->th_exit;
+			gf_mx_v(aio->mx);
+			if (done) break;
+			continue;
+		}
+		slot = aio->todo_slots[aio->todo_first];
+		aio->todo_first = (aio->todo_first + 1) % aio->depth;
+		aio->nb_todo--;
+		gf_mx_v(aio->mx);
+
+		aio_exec(&aio->reqs[slot]);
+
+		gf_mx_p(aio->mx);
+		aio_push_done(aio, slot);
+		gf_mx_v(aio->mx);
+		gf_sema_notify(aio->done_sem, 1);
+	}
+	return 0;
+}
+#endif
+
+GF_EXPORT
+GF_FileAIO *gf_file_aio_new(u32 queue_depth, Bool force_thread)
+{
+#ifdef GF_AIO_FD
+	u32 i;
+	GF_FileAIO *aio;
+	if (!queue_depth) queue_depth = 32;
+	GF_SAFEALLOC(aio, GF_FileAIO);
+	if (!aio) return NULL;
+	aio->depth = queue_depth;
+	aio->reqs = gf_malloc(sizeof(GF_AIOReq) * queue_depth);
+	aio->free_slots = gf_malloc(sizeof(u32) * queue_depth);
+	aio->done_slots = gf_malloc(sizeof(u32) * queue_depth);
+	if (!aio->reqs || !aio->free_slots || !aio->done_slots) {
+		gf_file_aio_del(aio);
+		return NULL;
+	}
+	for (i=0; i<queue_depth; i++)
+		aio->free_slots[i] = queue_depth - 1 - i;
+	aio->nb_free = queue_depth;
+	aio->backend = "sync";
+
+#ifdef GF_AIO_URING
+	aio->ring_fd = -1;
+	if (!force_thread && aio_uring_setup(aio))
+		return aio;
+#endif
+
+#ifndef GPAC_DISABLE_THREADS
+	aio->todo_slots = gf_malloc(sizeof(u32) * queue_depth);
+	aio->mx = gf_mx_new("FileAIO");
+	aio->todo_sem = gf_sema_new(GF_INT_MAX, 0);
+	aio->done_sem = gf_sema_new(GF_INT_MAX, 0);
+	aio->th = gf_th_new("FileAIO");
+	if (!aio->todo_slots || !aio->mx || !aio->todo_sem || !aio->done_sem || !aio->th
+		|| (gf_th_run(aio->th, aio_thread_proc, aio) != GF_OK)
+	) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_CORE, ("[Core] Failed to create I/O thread, file operations will be synchronous\n"));
+		if (aio->th) gf_th_del(aio->th);
+		aio->th = NULL;
+	} else {
+		aio->backend = "thread";
+	}
+#endif
+	return aio;
+#else
+	return NULL;
+#endif
+}
+
+GF_EXPORT
+void gf_file_aio_del(GF_FileAIO *aio)
+{
+	void *udta;
+	s32 res;
+	if (!aio) return;
+	while (gf_file_aio_get_done(aio, GF_TRUE, &udta, &res)) {}
+
+#ifdef GF_AIO_URING
+	aio_uring_del(aio);
+#endif
+#if defined(GF_AIO_FD) && !defined(GPAC_DISABLE_THREADS)
+	if (aio->th) {
+		gf_mx_p(aio->mx);
+		aio->th_exit = GF_TRUE;
+		gf_mx_v(aio->mx);
+		gf_sema_notify(aio->todo_sem, 1);
+		gf_th_stop(aio->th);
+		gf_th_del(aio->th);
+	}
+	if (aio->mx) gf_mx_del(aio->mx);
+	if (aio->todo_sem) gf_sema_del(aio->todo_sem);
+	if (aio->done_sem) gf_sema_del(aio->done_sem);
+	if (aio->todo_slots) gf_free(aio->todo_slots);
+#endif
+	if (aio->reqs) gf_free(aio->reqs);
+	if (aio->free_slots) gf_free(aio->free_slots);
+	if (aio->done_slots) gf_free(aio->done_slots);
+	gf_free(aio);
+}
+
+GF_EXPORT
+const char *gf_file_aio_backend(GF_FileAIO *aio)
+{
+	return aio ? aio->backend : NULL;
+}
+
+static GF_Err aio_submit(GF_FileAIO *aio, u32 type, s32 fd, u8 *buf, u32 size, u64 offset, void *udta)
+{
+#ifdef GF_AIO_FD
+	u32 slot;
+	GF_AIOReq *req;
+	if (!aio || (fd<0)) return GF_BAD_PARAM;
+	if (!aio->nb_free) return GF_BUFFER_TOO_SMALL;
+
+	aio->nb_free--;
+	slot = aio->free_slots[aio->nb_free];
+	req = &aio->reqs[slot];
+	req->type = type;
+	req->fd = fd;
+	req->buf = buf;
+	req->size = size;
+	req->done = 0;
+	req->offset = offset;
+	req->udta = udta;
+	req->res = 0;
+	aio->nb_pending++;
+
+#ifdef GF_AIO_URING
+	if (aio->ring_fd>=0) {
+		aio_uring_queue(aio, slot);
+		if (aio_uring_enter(aio, 1, 0) == 1)
+			return GF_OK;
+		//not consumed by the kernel, run it here
+		GF_LOG(GF_LOG_WARNING, GF_LOG_CORE, ("[Core] io_uring submission failed: %s\n", strerror(errno)));
+		__atomic_store_n(aio->sq_tail, *aio->sq_tail - 1, __ATOMIC_RELEASE);
+		aio_exec(req);
+		aio_push_done(aio, slot);
+		return GF_OK;
+	}
+#endif
+#ifndef GPAC_DISABLE_THREADS
+	if (aio->th) {
+		gf_mx_p(aio->mx);
+		aio->todo_slots[(aio->todo_first + aio->nb_todo) % aio->depth] = slot;
+		aio->nb_todo++;
+		gf_mx_v(aio->mx);
+		gf_sema_notify(aio->todo_sem, 1);
+		return GF_OK;
+	}
+#endif
+	aio_exec(req);
+	aio_push_done(aio, slot);
+	return GF_OK;
+#else
+	return GF_NOT_SUPPORTED;
+#endif
+}
+
+GF_EXPORT
+GF_Err gf_file_aio_write(GF_FileAIO *aio, s32 fd, const u8 *buf, u32 size, u64 offset, void *udta)
+{
+	return aio_submit(aio, GF_AIO_WRITE, fd, (u8 *) buf, size, offset, udta);
+}
+
+GF_EXPORT
+GF_Err gf_file_aio_read(GF_FileAIO *aio, s32 fd, u8 *buf, u32 size, u64 offset, void *udta)
+{
+	return aio_submit(aio, GF_AIO_READ, fd, buf, size, offset, udta);
+}
+
+GF_EXPORT
+GF_Err gf_file_aio_sync(GF_FileAIO *aio, s32 fd, void *udta)
+{
+	return aio_submit(aio, GF_AIO_SYNC, fd, NULL, 0, 0, udta);
+}
+
+GF_EXPORT
+GF_Err gf_file_aio_close(GF_FileAIO *aio, s32 fd, void *udta)
+{
+	return aio_submit(aio, GF_AIO_CLOSE, fd, NULL, 0, 0, udta);
+}
+
+GF_EXPORT
+Bool gf_file_aio_get_done(GF_FileAIO *aio, Bool wait, void **udta, s32 *res)
+{
+	u32 slot;
+	if (!aio || !aio->nb_pending) return GF_FALSE;
+
+#ifdef GF_AIO_URING
+	if (aio->ring_fd>=0) {
+		aio_uring_reap(aio);
+		while (!aio->nb_done) {
+			if (!wait) return GF_FALSE;
+			if (aio_uring_enter(aio, 0, 1) < 0) {
+				GF_LOG(GF_LOG_ERROR, GF_LOG_CORE, ("[Core] io_uring wait failed: %s\n", strerror(errno)));
+				return GF_FALSE;
+			}
+			aio_uring_reap(aio);
+		}
+	}
+#endif
+#if defined(GF_AIO_FD) && !defined(GPAC_DISABLE_THREADS)
+	if (aio->th) {
+		//one semaphore count per completion
+		if (wait) gf_sema_wait(aio->done_sem);
+		else if (!gf_sema_wait_for(aio->done_sem, 0)) return GF_FALSE;
+		gf_mx_p(aio->mx);
+	}
+#endif
+	gf_assert(aio->nb_done);
+	slot = aio->done_slots[aio->done_first];
+	aio->done_first = (aio->done_first + 1) % aio->depth;
+	aio->nb_done--;
+#if defined(GF_AIO_FD) && !defined(GPAC_DISABLE_THREADS)
+	if (aio->th) gf_mx_v(aio->mx);
+#endif
+
+	if (udta) *udta = aio->reqs[slot].udta;
+	if (res) *res = aio->reqs[slot].res;
+	aio->free_slots[aio->nb_free] = slot;
+	aio->nb_free++;
+	aio->nb_pending--;
+	return GF_TRUE;
+}
+
+GF_EXPORT
+u32 gf_file_aio_pending(GF_FileAIO *aio)
+{
+	return aio ? aio->nb_pending : 0;
+}
+
 /**
   * Returns a pointer to the start of a filepath basename
  **/
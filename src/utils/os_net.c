@@ -23,6 +23,11 @@
  *
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+//for sendmmsg
+#define _GNU_SOURCE
+#endif
+
 #include <gpac/network.h>
 
 #ifndef GPAC_DISABLE_NETWORK
@@ -155,6 +160,18 @@ typedef s32 SOCKET;
 
 #endif
 
+#ifdef GPAC_HAS_EPOLL
+#include <sys/epoll.h>
+#endif
+
+#ifdef GPAC_HAS_SENDFILE
+#include <sys/sendfile.h>
+#endif
+
+#ifdef GPAC_HAS_SENDMMSG
+#include <netinet/udp.h>
+#endif
+
 #endif /*WIN32||_WIN32_WCE*/
 
 #ifdef GPAC_BUILD_FOR_WINXP
@@ -385,6 +402,10 @@ enum
 	GF_SOCK_HAS_PEER = 1<<14,
 	GF_SOCK_IS_UN = 1<<15,
 	GF_SOCK_HAS_CONNECT = 1<<16,
+	/*UDP segmentation offload failed on this socket*/
+	GF_SOCK_NO_GSO = 1<<17,
+	/*kernel reception timestamps requested on this socket*/
+	GF_SOCK_HAS_RX_TS = 1<<18,
 };
 
 #ifndef GPAC_DISABLE_NETCAP
@@ -426,6 +447,17 @@ struct __tag_socket
 #ifdef GPAC_HAS_POLL
 	u32 poll_idx;
 #endif
+#ifdef GPAC_HAS_EPOLL
+	//events set by last epoll wait of the group owning the socket
+	u32 ep_revents;
+	//events the socket is registered for in the epoll instance of its group
+	u32 ep_armed;
+	//1-based index in the group poll set of sockets which could not be added to epoll, 0 if none
+	u32 ep_fb_idx;
+	//no output pending, socket is not polled for write
+	Bool ep_no_write;
+#endif
+	void *udta;
 
 #ifndef GPAC_DISABLE_NETCAP
 	NetCapInfo *cap_info;
@@ -2679,6 +2711,7 @@ GF_Err gf_sk_bind(GF_Socket *sock, const char *ifce_ip_or_name, u16 port, const
 }
 
 Bool gpac_use_poll=GF_TRUE;
+Bool gpac_use_epoll=GF_TRUE;
 
 static GF_Err poll_select(GF_Socket *sock, GF_SockSelectMode mode, u32 usec, Bool force_select)
 {
@@ -2832,6 +2865,383 @@ GF_Err gf_sk_send_ex(GF_Socket *sock, const u8 *buffer, u32 length, u32 *written
 	return GF_OK;
 }
 
+GF_EXPORT
+GF_Err gf_sk_send_file(GF_Socket *sock, FILE *file, u64 offset, u32 length, u32 *written)
+{
+#ifdef GPAC_HAS_SENDFILE
+	u32 count;
+	ssize_t res;
+	off_t pos;
+	int fd;
+
+	if (written) *written = 0;
+	if (!sock || !sock->socket || !file)
+		return GF_BAD_PARAM;
+	//only for connected TCP sockets, gfio-wrapped files use the regular send path
+	if (!(sock->flags & GF_SOCK_IS_TCP) || (sock->flags & GF_SOCK_HAS_PEER) || gf_fileio_check(file))
+		return GF_NOT_SUPPORTED;
+#ifndef GPAC_DISABLE_NETCAP
+	//captured or replayed sockets go through the netcap send path
+	if (sock->cap_info)
+		return GF_NOT_SUPPORTED;
+#endif
+	fd = fileno(file);
+	if (fd<0) return GF_NOT_SUPPORTED;
+
+	if (! (sock->flags & GF_SOCK_NON_BLOCKING)) {
+		GF_Err e = poll_select(sock, GF_SK_SELECT_WRITE, sock->usec_wait, GF_FALSE);
+		if (e) return e;
+	}
+
+	pos = (off_t) offset;
+	count = 0;
+	while (count < length) {
+		res = sendfile(sock->socket, fd, &pos, length - count);
+		if (res<0) {
+			switch (LASTSOCKERROR) {
+			case EAGAIN:
+				return count ? GF_OK : GF_IP_NETWORK_EMPTY;
+			case EINTR:
+				continue;
+			case ENOTCONN:
+			case ECONNRESET:
+			case EPIPE:
+				GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[socket] sendfile failure: %s\n", gf_errno_str(LASTSOCKERROR)));
+				return GF_IP_CONNECTION_CLOSED;
+			//file or socket type not supported by sendfile, caller shall use regular send
+			case EINVAL:
+			case ENOSYS:
+			case EOPNOTSUPP:
+				if (!count) return GF_NOT_SUPPORTED;
+				return GF_OK;
+			default:
+				GF_LOG(GF_LOG_ERROR, GF_LOG_NETWORK, ("[socket] sendfile failure: %s\n", gf_errno_str(LASTSOCKERROR)));
+				return GF_IP_NETWORK_FAILURE;
+			}
+		}
+		//end of file reached (file truncated or still being written)
+		if (!res) break;
+		count += (u32) res;
+		if (written) *written += (u32) res;
+	}
+	return GF_OK;
+#else
+	if (written) *written = 0;
+	return GF_NOT_SUPPORTED;
+#endif
+}
+
+Bool gpac_use_gso=GF_TRUE;
+
+#ifdef GPAC_HAS_SENDMMSG
+
+//max number of datagrams per sendmmsg call
+#define SK_BATCH_MAX	64
+//max number of segments and payload size in a single UDP GSO send
+#define SK_GSO_MAX_SEGS	64
+#define SK_GSO_MAX_SIZE	65000
+
+static GF_Err sk_batch_error(u32 err)
+{
+	switch (err) {
+	case EAGAIN:
+		return GF_IP_NETWORK_EMPTY;
+	case ENOTCONN:
+	case ECONNRESET:
+	case EPIPE:
+		return GF_IP_CONNECTION_CLOSED;
+	case ENOBUFS:
+		return GF_BUFFER_TOO_SMALL;
+	default:
+		GF_LOG(GF_LOG_ERROR, GF_LOG_NETWORK, ("[socket] batch send failure: %s\n", gf_errno_str(err)));
+		return GF_IP_NETWORK_FAILURE;
+	}
+}
+
+//get number of datagrams starting at buffers[0] that can be sent as a single GSO buffer:
+//contiguous in memory, all of the same size except the last one which may be smaller
+static u32 sk_batch_gso_count(const u8 **buffers, const u32 *sizes, u32 nb_buffers)
+{
+	u32 i, seg_size = sizes[0];
+	u32 tot_size = seg_size;
+	for (i=1; i<nb_buffers; i++) {
+		if (i==SK_GSO_MAX_SEGS) break;
+		if (buffers[i] != buffers[i-1] + sizes[i-1]) break;
+		if (sizes[i] > seg_size) break;
+		if (tot_size + sizes[i] > SK_GSO_MAX_SIZE) break;
+		tot_size += sizes[i];
+		//short segment, must be the last one
+		if (sizes[i] < seg_size) return i+1;
+	}
+	return i;
+}
+
+#ifdef UDP_SEGMENT
+static GF_Err sk_send_gso(GF_Socket *sock, const u8 *buffer, u32 seg_size, u32 tot_size)
+{
+	struct msghdr msg;
+	struct iovec iov;
+	struct cmsghdr *cm;
+	char ctrl[CMSG_SPACE(sizeof(u16))];
+	ssize_t res;
+
+	memset(&msg, 0, sizeof(struct msghdr));
+	memset(ctrl, 0, sizeof(ctrl));
+	iov.iov_base = (void *) buffer;
+	iov.iov_len = tot_size;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	if (sock->flags & GF_SOCK_HAS_PEER) {
+		msg.msg_name = &sock->dest_addr;
+		msg.msg_namelen = sock->dest_addr_len;
+	}
+	msg.msg_control = ctrl;
+	msg.msg_controllen = sizeof(ctrl);
+	cm = CMSG_FIRSTHDR(&msg);
+	cm->cmsg_level = IPPROTO_UDP;
+	cm->cmsg_type = UDP_SEGMENT;
+	cm->cmsg_len = CMSG_LEN(sizeof(u16));
+	*((u16 *) CMSG_DATA(cm)) = (u16) seg_size;
+
+	res = sendmsg(sock->socket, &msg, MSG_NOSIGNAL);
+	if (res<0) {
+		u32 err = LASTSOCKERROR;
+		//no GSO support for this socket or device, do not try again
+		if ((err==EIO) || (err==EINVAL) || (err==ENOPROTOOPT) || (err==EOPNOTSUPP)) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[socket] UDP segmentation offload not available (%s), using sendmmsg\n", gf_errno_str(err)));
+			sock->flags |= GF_SOCK_NO_GSO;
+			return GF_NOT_SUPPORTED;
+		}
+		return sk_batch_error(err);
+	}
+	return GF_OK;
+}
+#endif
+
+#endif //GPAC_HAS_SENDMMSG
+
+GF_EXPORT
+GF_Err gf_sk_send_batch(GF_Socket *sock, const u8 **buffers, const u32 *sizes, u32 nb_buffers, u32 *nb_sent)
+{
+	u32 i;
+	GF_Err e;
+	if (nb_sent) *nb_sent = 0;
+	if (!sock || !sock->socket || !buffers || !sizes)
+		return GF_BAD_PARAM;
+	if (!nb_buffers) return GF_OK;
+
+#ifdef GPAC_HAS_SENDMMSG
+	if (!(sock->flags & GF_SOCK_IS_TCP)
+#ifndef GPAC_DISABLE_NETCAP
+		&& !sock->cap_info
+#endif
+	) {
+		struct mmsghdr msgs[SK_BATCH_MAX];
+		struct iovec iovs[SK_BATCH_MAX];
+		u32 done = 0;
+
+		if (! (sock->flags & GF_SOCK_NON_BLOCKING)) {
+			e = poll_select(sock, GF_SK_SELECT_WRITE, sock->usec_wait, GF_FALSE);
+			if (e) return e;
+		}
+		while (done < nb_buffers) {
+			s32 res;
+			u32 count = nb_buffers - done;
+
+#ifdef UDP_SEGMENT
+			if (gpac_use_gso && !(sock->flags & GF_SOCK_NO_GSO) && (count>1)) {
+				u32 nb_segs = sk_batch_gso_count(buffers+done, sizes+done, count);
+				if (nb_segs>1) {
+					u32 tot_size = (u32) (buffers[done+nb_segs-1] + sizes[done+nb_segs-1] - buffers[done]);
+					e = sk_send_gso(sock, buffers[done], sizes[done], tot_size);
+					if (!e) {
+						done += nb_segs;
+						if (nb_sent) *nb_sent = done;
+						continue;
+					}
+					if (e != GF_NOT_SUPPORTED)
+						return e;
+				}
+			}
+#endif
+			if (count > SK_BATCH_MAX) count = SK_BATCH_MAX;
+			memset(msgs, 0, sizeof(struct mmsghdr)*count);
+			for (i=0; i<count; i++) {
+				iovs[i].iov_base = (void *) buffers[done+i];
+				iovs[i].iov_len = sizes[done+i];
+				msgs[i].msg_hdr.msg_iov = &iovs[i];
+				msgs[i].msg_hdr.msg_iovlen = 1;
+				if (sock->flags & GF_SOCK_HAS_PEER) {
+					msgs[i].msg_hdr.msg_name = &sock->dest_addr;
+					msgs[i].msg_hdr.msg_namelen = sock->dest_addr_len;
+				}
+			}
+			res = sendmmsg(sock->socket, msgs, count, MSG_NOSIGNAL);
+			if (res<0) {
+				if (LASTSOCKERROR==EINTR) continue;
+				return sk_batch_error(LASTSOCKERROR);
+			}
+			done += (u32) res;
+			if (nb_sent) *nb_sent = done;
+		}
+		return GF_OK;
+	}
+#endif
+
+	//no batch support, one send per datagram
+	for (i=0; i<nb_buffers; i++) {
+		e = gf_sk_send_ex(sock, buffers[i], sizes[i], NULL);
+		if (e) return e;
+		if (nb_sent) *nb_sent = i+1;
+	}
+	return GF_OK;
+}
+
+#ifdef GPAC_HAS_SENDMMSG
+//convert kernel reception time to NTP, using current NTP and system time to apply any NTP shift
+static u64 sk_rx_time_to_ntp(struct timespec *ts, u64 ntp_now, struct timeval *now)
+{
+	s64 diff_us = (s64) (now->tv_sec - ts->tv_sec) * 1000000 + (s64) now->tv_usec - (s64) (ts->tv_nsec/1000);
+	if (diff_us<0) diff_us = 0;
+	return ntp_now - (((u64) diff_us << 32) / 1000000);
+}
+#endif
+
+GF_EXPORT
+GF_Err gf_sk_receive_batch(GF_Socket *sock, u8 *buffer, u32 slot_size, u32 nb_slots, u32 *sizes, u64 *timestamps, u32 *nb_read)
+{
+	u32 i;
+	GF_Err e;
+	if (nb_read) *nb_read = 0;
+	if (!sock || !buffer || !slot_size || !nb_slots || !sizes || !nb_read)
+		return GF_BAD_PARAM;
+
+#ifdef GPAC_HAS_SENDMMSG
+	if (sock->socket && !(sock->flags & GF_SOCK_IS_TCP)
+#ifndef GPAC_DISABLE_NETCAP
+		&& !sock->cap_info
+#endif
+	) {
+		struct mmsghdr msgs[SK_BATCH_MAX];
+		struct iovec iovs[SK_BATCH_MAX];
+		char ctrl[SK_BATCH_MAX][CMSG_SPACE(sizeof(struct timespec))];
+		struct timeval now;
+		u64 ntp_now=0;
+		s32 res;
+
+		if (nb_slots > SK_BATCH_MAX) nb_slots = SK_BATCH_MAX;
+		//request kernel reception timestamps once
+		if (timestamps && !(sock->flags & GF_SOCK_HAS_RX_TS)) {
+#ifdef SO_TIMESTAMPNS
+			int on = 1;
+			if (setsockopt(sock->socket, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(int)) < 0) {
+				GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[socket] Kernel reception timestamps not available: %s\n", gf_errno_str(LASTSOCKERROR)));
+			}
+#endif
+			sock->flags |= GF_SOCK_HAS_RX_TS;
+		}
+
+		memset(msgs, 0, sizeof(struct mmsghdr)*nb_slots);
+		for (i=0; i<nb_slots; i++) {
+			iovs[i].iov_base = buffer + i*slot_size;
+			iovs[i].iov_len = slot_size;
+			msgs[i].msg_hdr.msg_iov = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+			if (timestamps) {
+				msgs[i].msg_hdr.msg_control = ctrl[i];
+				msgs[i].msg_hdr.msg_controllen = sizeof(ctrl[i]);
+			}
+			//last sender address is kept, as with gf_sk_receive
+			if (sock->flags & GF_SOCK_HAS_PEER) {
+				msgs[i].msg_hdr.msg_name = &sock->dest_addr;
+				msgs[i].msg_hdr.msg_namelen = sizeof(sock->dest_addr);
+			}
+		}
+		do {
+			res = recvmmsg(sock->socket, msgs, nb_slots, MSG_DONTWAIT, NULL);
+		} while ((res<0) && (LASTSOCKERROR==EINTR));
+
+		if (res<0) {
+			u32 err = LASTSOCKERROR;
+			if (err==EWOULDBLOCK) return GF_IP_NETWORK_EMPTY;
+			return sk_batch_error(err);
+		}
+		if (!res) return GF_IP_NETWORK_EMPTY;
+
+		if (timestamps) {
+			gettimeofday(&now, NULL);
+			ntp_now = gf_net_get_ntp_ts();
+		}
+		for (i=0; i<(u32) res; i++) {
+			sizes[i] = msgs[i].msg_len;
+			if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+				GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] Datagram larger than %u bytes, truncated\n", slot_size));
+			}
+			if (sock->flags & GF_SOCK_HAS_PEER)
+				sock->dest_addr_len = msgs[i].msg_hdr.msg_namelen;
+
+			if (timestamps) {
+				struct cmsghdr *cm;
+				timestamps[i] = ntp_now;
+				for (cm = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cm; cm = CMSG_NXTHDR(&msgs[i].msg_hdr, cm)) {
+#ifdef SCM_TIMESTAMPNS
+					if ((cm->cmsg_level==SOL_SOCKET) && (cm->cmsg_type==SCM_TIMESTAMPNS)) {
+						struct timespec ts;
+						memcpy(&ts, CMSG_DATA(cm), sizeof(struct timespec));
+						timestamps[i] = sk_rx_time_to_ntp(&ts, ntp_now, &now);
+					}
+#endif
+				}
+			}
+		}
+		*nb_read = (u32) res;
+		return GF_OK;
+	}
+#endif
+
+	//no batch support, one receive per datagram
+	for (i=0; i<nb_slots; i++) {
+		u32 read = 0;
+		e = gf_sk_receive_no_select(sock, buffer + i*slot_size, slot_size, &read);
+		if (e || !read) {
+			if (i) break;
+			return e ? e : GF_IP_NETWORK_EMPTY;
+		}
+		sizes[i] = read;
+		if (timestamps) timestamps[i] = gf_net_get_ntp_ts();
+		*nb_read = i+1;
+		//netcap replay, only deliver one packet at a time
+#ifndef GPAC_DISABLE_NETCAP
+		if (sock->cap_info) break;
+#endif
+	}
+	return GF_OK;
+}
+
+GF_EXPORT
+GF_Err gf_sk_set_pacing_rate(GF_Socket *sock, u64 rate)
+{
+	if (!sock || !sock->socket) return GF_BAD_PARAM;
+#ifdef SO_MAX_PACING_RATE
+	//in bytes per second, ~0 disables pacing
+	u64 bytes_per_sec = rate ? (rate/8) : (u64) -1;
+	int res;
+	if (bytes_per_sec > 0xFFFFFFFF) {
+		res = setsockopt(sock->socket, SOL_SOCKET, SO_MAX_PACING_RATE, &bytes_per_sec, sizeof(u64));
+	} else {
+		u32 val = (u32) bytes_per_sec;
+		res = setsockopt(sock->socket, SOL_SOCKET, SO_MAX_PACING_RATE, &val, sizeof(u32));
+	}
+	if (res<0) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] Failed to set pacing rate: %s\n", gf_errno_str(LASTSOCKERROR)));
+		return GF_NOT_SUPPORTED;
+	}
+	return GF_OK;
+#else
+	return GF_NOT_SUPPORTED;
+#endif
+}
+
 GF_EXPORT
 GF_Err gf_sk_send(GF_Socket *sock, const u8 *buffer, u32 length)
 {
@@ -3539,12 +3949,118 @@ struct __tag_sock_group
 	GF_POLLFD *fds;
 #endif
 
+#ifdef GPAC_HAS_EPOLL
+	//epoll instance, -1 if not used (disabled or failure)
+	s32 epfd;
+	u32 ep_mask;
+	//events of last wait, only the first nb_ready are valid
+	struct epoll_event *ep_events;
+	u32 nb_ready, ep_alloc;
+	//sockets rejected by epoll, polled along with the epoll descriptor in the first entry
+	GF_POLLFD *ep_fb;
+	GF_Socket **ep_fb_socks;
+	u32 nb_ep_fb, alloc_ep_fb;
+#endif
+
 #ifndef GPAC_DISABLE_NETCAP
 	u32 nb_nfs;
 	u32 nb_socks;
 #endif
 };
 
+#ifdef GPAC_HAS_EPOLL
+static void sk_group_epoll_disable(GF_SockGroup *sg)
+{
+	u32 i, count;
+	if (sg->epfd<0) return;
+	close(sg->epfd);
+	sg->epfd = -1;
+	sg->nb_ready = 0;
+	count = gf_list_count(sg->sockets);
+	for (i=0; i<count; i++) {
+		GF_Socket *sk = gf_list_get(sg->sockets, i);
+		sk->ep_revents = 0;
+		sk->ep_armed = 0;
+		sk->ep_fb_idx = 0;
+	}
+	sg->nb_ep_fb = 0;
+	GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] epoll failure (%s), using poll/select for socket group\n", gf_errno_str(LASTSOCKERROR) ));
+}
+
+//events a socket is polled for given the group select mode
+static u32 sk_group_epoll_mask(GF_SockGroup *sg, GF_Socket *sk)
+{
+	u32 mask = sg->ep_mask;
+	if (sk->ep_no_write) mask &= ~EPOLLOUT;
+	return mask;
+}
+
+//update events of a socket registered in epoll, only issuing a syscall if they changed
+static void sk_group_epoll_update(GF_SockGroup *sg, GF_Socket *sk)
+{
+	struct epoll_event ev;
+	u32 mask = sk_group_epoll_mask(sg, sk);
+
+	if (sk->ep_fb_idx) {
+		sg->ep_fb[sk->ep_fb_idx-1].events = (mask & EPOLLIN) ? POLLIN : 0;
+		if (mask & EPOLLOUT) sg->ep_fb[sk->ep_fb_idx-1].events |= POLLOUT;
+		return;
+	}
+	if (sk->ep_armed == mask) return;
+	memset(&ev, 0, sizeof(ev));
+	ev.events = mask;
+	ev.data.ptr = sk;
+	if (epoll_ctl(sg->epfd, EPOLL_CTL_MOD, sk->socket, &ev) < 0) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] cannot modify epoll events: %s\n", gf_errno_str(LASTSOCKERROR) ));
+		return;
+	}
+	sk->ep_armed = mask;
+}
+
+//socket cannot be added to epoll, poll it separately
+static Bool sk_group_epoll_fallback(GF_SockGroup *sg, GF_Socket *sk)
+{
+	if (sg->nb_ep_fb + 2 > sg->alloc_ep_fb) {
+		u32 nb_alloc = sg->nb_ep_fb + 2;
+		GF_POLLFD *fds = gf_realloc(sg->ep_fb, sizeof(GF_POLLFD) * nb_alloc);
+		if (!fds) return GF_FALSE;
+		sg->ep_fb = fds;
+		GF_Socket **socks = gf_realloc(sg->ep_fb_socks, sizeof(GF_Socket *) * nb_alloc);
+		if (!socks) return GF_FALSE;
+		sg->ep_fb_socks = socks;
+		sg->alloc_ep_fb = nb_alloc;
+	}
+	if (!sg->nb_ep_fb) {
+		sg->ep_fb[0].fd = sg->epfd;
+		sg->ep_fb[0].events = POLLIN;
+		sg->ep_fb[0].revents = 0;
+		sg->ep_fb_socks[0] = NULL;
+		sg->nb_ep_fb = 1;
+	}
+	sg->ep_fb[sg->nb_ep_fb].fd = sk->socket;
+	sg->ep_fb[sg->nb_ep_fb].revents = 0;
+	sg->ep_fb_socks[sg->nb_ep_fb] = sk;
+	sg->nb_ep_fb++;
+	sk->ep_fb_idx = sg->nb_ep_fb;
+	sk_group_epoll_update(sg, sk);
+	return GF_TRUE;
+}
+
+static void sk_group_epoll_fallback_remove(GF_SockGroup *sg, GF_Socket *sk)
+{
+	u32 i, idx = sk->ep_fb_idx - 1;
+	sk->ep_fb_idx = 0;
+	memmove(&sg->ep_fb[idx], &sg->ep_fb[idx+1], sizeof(GF_POLLFD) * (sg->nb_ep_fb-idx-1));
+	memmove(&sg->ep_fb_socks[idx], &sg->ep_fb_socks[idx+1], sizeof(GF_Socket *) * (sg->nb_ep_fb-idx-1));
+	sg->nb_ep_fb--;
+	for (i=idx; i<sg->nb_ep_fb; i++)
+		sg->ep_fb_socks[i]->ep_fb_idx = i+1;
+	//only the epoll descriptor left
+	if (sg->nb_ep_fb==1) sg->nb_ep_fb = 0;
+}
+#endif
+
+GF_EXPORT
 GF_SockGroup *gf_sk_group_new()
 {
 	GF_SockGroup *tmp;
@@ -3555,19 +4071,37 @@ GF_SockGroup *gf_sk_group_new()
 
 #ifdef GPAC_HAS_POLL
 	tmp->last_mask = POLLIN;
+#endif
+#ifdef GPAC_HAS_EPOLL
+	tmp->epfd = -1;
+	if (gpac_use_poll && gpac_use_epoll) {
+		tmp->epfd = epoll_create1(EPOLL_CLOEXEC);
+		if (tmp->epfd<0) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] cannot create epoll instance: %s\n", gf_errno_str(LASTSOCKERROR) ));
+		}
+		tmp->ep_mask = EPOLLIN;
+	}
 #endif
 	return tmp;
 }
 
+GF_EXPORT
 void gf_sk_group_del(GF_SockGroup *sg)
 {
 	gf_list_del(sg->sockets);
 #ifdef GPAC_HAS_POLL
 	if (sg->fds) gf_free(sg->fds);
+#endif
+#ifdef GPAC_HAS_EPOLL
+	if (sg->epfd>=0) close(sg->epfd);
+	if (sg->ep_events) gf_free(sg->ep_events);
+	if (sg->ep_fb) gf_free(sg->ep_fb);
+	if (sg->ep_fb_socks) gf_free(sg->ep_fb_socks);
 #endif
 	gf_free(sg);
 }
 
+GF_EXPORT
 void gf_sk_group_register(GF_SockGroup *sg, GF_Socket *sk)
 {
 	if (!sg || !sk) return;
@@ -3585,6 +4119,33 @@ void gf_sk_group_register(GF_SockGroup *sg, GF_Socket *sk)
 	}
 #endif
 
+#ifdef GPAC_HAS_EPOLL
+	if (sg->epfd>=0) {
+		struct epoll_event ev;
+		u32 count = gf_list_count(sg->sockets);
+		sk->ep_revents = 0;
+		sk->ep_fb_idx = 0;
+		sk->ep_no_write = GF_FALSE;
+		if (count > sg->ep_alloc) {
+			struct epoll_event *events = gf_realloc(sg->ep_events, sizeof(struct epoll_event) * count);
+			if (events) {
+				sg->ep_events = events;
+				sg->ep_alloc = count;
+			}
+		}
+		memset(&ev, 0, sizeof(ev));
+		ev.events = sk->ep_armed = sk_group_epoll_mask(sg, sk);
+		ev.data.ptr = sk;
+		if (epoll_ctl(sg->epfd, EPOLL_CTL_ADD, sk->socket, &ev) < 0) {
+			GF_LOG(GF_LOG_INFO, GF_LOG_NETWORK, ("[socket] cannot add socket to epoll (%s), polling it separately\n", gf_errno_str(LASTSOCKERROR) ));
+			sk->ep_armed = 0;
+			//only this socket is polled without epoll
+			if (!sk_group_epoll_fallback(sg, sk))
+				sk_group_epoll_disable(sg);
+		}
+	}
+#endif
+
 #ifdef GPAC_HAS_POLL
 	if (!sg->fds && !gpac_use_poll)
 		return;
@@ -3602,13 +4163,14 @@ void gf_sk_group_register(GF_SockGroup *sg, GF_Socket *sk)
 #endif
 }
 
+GF_EXPORT
 void gf_sk_group_unregister(GF_SockGroup *sg, GF_Socket *sk)
 {
 	if (!sg || !sk) return;
 	s32 pidx = gf_list_del_item(sg->sockets, sk);
 
 #ifndef GPAC_DISABLE_NETCAP
-	if (sk->cap_info && sk->cap_info->nf->read_socks) {
+	if (sk->cap_info && sk->cap_info->nf && sk->cap_info->nf->read_socks) {
 		if (sg->nb_nfs && (pidx>=0))
 			sg->nb_nfs--;
 		sg->nb_socks = gf_list_count(sg->sockets);
@@ -3624,6 +4186,26 @@ void gf_sk_group_unregister(GF_SockGroup *sg, GF_Socket *sk)
 	}
 #endif
 
+#ifdef GPAC_HAS_EPOLL
+	if ((sg->epfd>=0) && (pidx>=0)) {
+		u32 i;
+		struct epoll_event ev;
+		memset(&ev, 0, sizeof(ev));
+		if (sk->ep_fb_idx) {
+			sk_group_epoll_fallback_remove(sg, sk);
+		} else {
+			//socket may already be closed, ignore errors
+			epoll_ctl(sg->epfd, EPOLL_CTL_DEL, sk->socket, &ev);
+		}
+		sk->ep_armed = 0;
+		//remove from pending events of last wait
+		for (i=0; i<sg->nb_ready; i++) {
+			if (sg->ep_events[i].data.ptr == sk) sg->ep_events[i].data.ptr = NULL;
+		}
+		sk->ep_revents = 0;
+	}
+#endif
+
 	if (!gf_list_count(sg->sockets)) {
 		gf_list_del(sg->sockets);
 		sg->sockets = NULL;
@@ -3654,6 +4236,7 @@ void gf_sk_group_unregister(GF_SockGroup *sg, GF_Socket *sk)
 #endif
 }
 
+GF_EXPORT
 GF_Err gf_sk_group_select(GF_SockGroup *sg, u32 usec_wait, GF_SockSelectMode mode)
 {
 	s32 ready;
@@ -3704,6 +4287,79 @@ GF_Err gf_sk_group_select(GF_SockGroup *sg, u32 usec_wait, GF_SockSelectMode mod
 	}
 #endif
 
+#ifdef GPAC_HAS_EPOLL
+	if (sg->epfd>=0) {
+		s32 res;
+		u32 mask;
+		if (mode == GF_SK_SELECT_BOTH) mask = EPOLLIN | EPOLLOUT;
+		else if (mode == GF_SK_SELECT_READ) mask = EPOLLIN;
+		else mask = EPOLLOUT;
+		//level-triggered: unlike edge-triggered, sockets not drained until EAGAIN by the caller (partial reads, TLS, ...) are reported again
+		//writable sockets only wake the wait while their owner has output pending, cf gf_sk_group_set_write_pending
+		if (sg->ep_mask != mask) {
+			sg->ep_mask = mask;
+			//only sockets whose events change are modified
+			i=0;
+			while ((sock = gf_list_enum(sg->sockets, &i))) {
+#ifndef GPAC_DISABLE_NETCAP
+				if (sock->cap_info) continue;
+#endif
+				sk_group_epoll_update(sg, sock);
+			}
+		}
+		if (sg->epfd>=0) {
+			u32 nb_fb_ready = 0;
+			//round up so that sub-millisecond waits do not turn into busy loops
+			s32 ms_wait = (s32) ((usec_wait+999)/1000);
+			//reset events of previous wait
+			for (i=0; i<sg->nb_ready; i++) {
+				sock = sg->ep_events[i].data.ptr;
+				if (sock) sock->ep_revents = 0;
+			}
+			sg->nb_ready = 0;
+			for (i=1; i<sg->nb_ep_fb; i++)
+				sg->ep_fb[i].revents = 0;
+
+			if (!sg->ep_alloc && !sg->nb_ep_fb)
+				return GF_IP_NETWORK_EMPTY;
+
+			//some sockets are not in epoll, wait on them and on the epoll descriptor
+			if (sg->nb_ep_fb) {
+				res = poll(sg->ep_fb, sg->nb_ep_fb, ms_wait);
+				if (res>0) {
+					nb_fb_ready = res;
+					res = 0;
+					if (sg->ep_fb[0].revents & POLLIN) {
+						nb_fb_ready--;
+						if (sg->ep_alloc)
+							res = epoll_wait(sg->epfd, sg->ep_events, sg->ep_alloc, 0);
+					}
+				}
+			} else {
+				res = epoll_wait(sg->epfd, sg->ep_events, sg->ep_alloc, ms_wait);
+			}
+			if (res<0) {
+				switch (LASTSOCKERROR) {
+				case EAGAIN:
+				case EINTR:
+					return GF_IP_NETWORK_EMPTY;
+				default:
+					GF_LOG(GF_LOG_WARNING, GF_LOG_NETWORK, ("[socket] cannot epoll: %s\n", gf_errno_str(LASTSOCKERROR) ));
+					return GF_IP_NETWORK_FAILURE;
+				}
+			}
+			sg->nb_ready = (u32) res;
+			for (i=0; i<sg->nb_ready; i++) {
+				sock = sg->ep_events[i].data.ptr;
+				sock->ep_revents = sg->ep_events[i].events;
+			}
+			if (!res && !nb_fb_ready)
+				return GF_IP_NETWORK_EMPTY;
+			return GF_OK;
+		}
+	}
+#endif
+
 #ifdef GPAC_HAS_POLL
 	if (sg->fds) {
 		u32 mask = 0;
@@ -3717,7 +4373,7 @@ GF_Err gf_sk_group_select(GF_SockGroup *sg, u32 usec_wait, GF_SockSelectMode mod
 				gf_assert(sg->fds[i].fd != 0);
 			}
 		}
-		int res = poll(sg->fds, sg->nb_fds, usec_wait/1000);
+		int res = poll(sg->fds, sg->nb_fds, (usec_wait+999)/1000);
 		if (res<0) {
 			switch (LASTSOCKERROR) {
 			case EAGAIN:
@@ -3789,6 +4445,7 @@ GF_Err gf_sk_group_select(GF_SockGroup *sg, u32 usec_wait, GF_SockSelectMode mod
 	return GF_OK;
 }
 
+GF_EXPORT
 Bool gf_sk_group_sock_is_set(GF_SockGroup *sg, GF_Socket *sk, GF_SockSelectMode mode)
 {
 	if (!sg || !sk) return GF_FALSE;
@@ -3806,6 +4463,29 @@ Bool gf_sk_group_sock_is_set(GF_SockGroup *sg, GF_Socket *sk, GF_SockSelectMode
 	}
 #endif
 
+#ifdef GPAC_HAS_EPOLL
+	if (sg->epfd>=0) {
+		if (sk->ep_fb_idx) {
+			GF_POLLFD *pfd = &sg->ep_fb[sk->ep_fb_idx-1];
+			if (pfd->revents & (POLLHUP|POLLERR))
+				return GF_TRUE;
+			if ((mode!=GF_SK_SELECT_WRITE) && (pfd->revents & POLLIN))
+				return GF_TRUE;
+			if ((mode!=GF_SK_SELECT_READ) && (pfd->revents & POLLOUT))
+				return GF_TRUE;
+			return GF_FALSE;
+		}
+		//disconnected, consider ready to read/write
+		if (sk->ep_revents & (EPOLLHUP|EPOLLERR))
+			return GF_TRUE;
+		if ((mode!=GF_SK_SELECT_WRITE) && (sk->ep_revents & EPOLLIN))
+			return GF_TRUE;
+		if ((mode!=GF_SK_SELECT_READ) && (sk->ep_revents & EPOLLOUT))
+			return GF_TRUE;
+		return GF_FALSE;
+	}
+#endif
+
 #ifdef GPAC_HAS_POLL
 	if (sg->fds && sk->poll_idx) {
 		GF_POLLFD *pfd = &sg->fds[sk->poll_idx-1];
@@ -3833,6 +4513,69 @@ Bool gf_sk_group_sock_is_set(GF_SockGroup *sg, GF_Socket *sk, GF_SockSelectMode
 	return GF_FALSE;
 }
 
+GF_EXPORT
+GF_Socket *gf_sk_group_enum_ready(GF_SockGroup *sg, u32 *idx, GF_SockSelectMode mode)
+{
+	GF_Socket *sk;
+	if (!sg || !idx) return NULL;
+
+#ifdef GPAC_HAS_EPOLL
+	//only sockets signaled by the last wait are browsed
+	if ((sg->epfd>=0)
+#ifndef GPAC_DISABLE_NETCAP
+		&& !sg->nb_nfs
+#endif
+	) {
+		while (*idx < sg->nb_ready) {
+			sk = sg->ep_events[*idx].data.ptr;
+			(*idx)++;
+			if (sk && gf_sk_group_sock_is_set(sg, sk, mode))
+				return sk;
+		}
+		//then sockets polled outside of epoll
+		while (*idx < sg->nb_ready + sg->nb_ep_fb) {
+			u32 fb_idx = *idx - sg->nb_ready;
+			(*idx)++;
+			if (!fb_idx) continue;
+			sk = sg->ep_fb_socks[fb_idx];
+			if (gf_sk_group_sock_is_set(sg, sk, mode))
+				return sk;
+		}
+		return NULL;
+	}
+#endif
+	while ((sk = gf_list_get(sg->sockets, *idx))) {
+		(*idx)++;
+		if (gf_sk_group_sock_is_set(sg, sk, mode))
+			return sk;
+	}
+	return NULL;
+}
+
+GF_EXPORT
+void gf_sk_group_set_write_pending(GF_SockGroup *sg, GF_Socket *sk, Bool write_pending)
+{
+	if (!sg || !sk) return;
+#ifdef GPAC_HAS_EPOLL
+	if (sk->ep_no_write == !write_pending) return;
+	sk->ep_no_write = !write_pending;
+	if ((sg->epfd<0) || (!sk->ep_armed && !sk->ep_fb_idx)) return;
+	sk_group_epoll_update(sg, sk);
+#endif
+}
+
+GF_EXPORT
+void gf_sk_set_udta(GF_Socket *sk, void *udta)
+{
+	if (sk) sk->udta = udta;
+}
+
+GF_EXPORT
+void *gf_sk_get_udta(GF_Socket *sk)
+{
+	return sk ? sk->udta : NULL;
+}
+
 //fetch nb bytes on a socket and fill the buffer from startFrom
 //length is the allocated size of the receiving buffer
 //BytesRead is the number of bytes read from the network
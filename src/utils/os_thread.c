@@ -23,6 +23,11 @@
  *
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+//for CPU_SET and pthread_setaffinity_np
+#define _GNU_SOURCE
+#endif
+
 #ifdef GPAC_CONFIG_ANDROID
 #include <jni.h>
 #endif
@@ -475,6 +480,91 @@ void gf_th_set_priority(GF_Thread *t, s32 priority)
 #endif
 }
 
+GF_EXPORT
+GF_Err gf_th_set_affinity(GF_Thread *t, const u32 *cpus, u32 nb_cpus)
+{
+#if defined(WIN32) && !defined(_WIN32_WCE)
+	u32 i;
+	DWORD_PTR mask = 0;
+	if (!cpus || !nb_cpus) return GF_BAD_PARAM;
+	for (i=0; i<nb_cpus; i++) {
+		if (cpus[i] < 8*sizeof(DWORD_PTR)) mask |= ((DWORD_PTR)1) << cpus[i];
+	}
+	if (!mask) return GF_BAD_PARAM;
+	if (!SetThreadAffinityMask(t ? t->threadH : GetCurrentThread(), mask)) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_MUTEX, ("[Thread %s] Couldn't set CPU affinity, error %d\n", gf_th_log_name(t), GetLastError()));
+		return GF_IO_ERR;
+	}
+	return GF_OK;
+#elif defined(__linux__) && !defined(GPAC_CONFIG_ANDROID) && !defined(GPAC_CONFIG_EMSCRIPTEN)
+	u32 i;
+	int res;
+	cpu_set_t set;
+	if (!cpus || !nb_cpus) return GF_BAD_PARAM;
+	CPU_ZERO(&set);
+	for (i=0; i<nb_cpus; i++) {
+		if (cpus[i] < CPU_SETSIZE) CPU_SET(cpus[i], &set);
+	}
+	res = pthread_setaffinity_np(t ? t->threadH : pthread_self(), sizeof(cpu_set_t), &set);
+	if (res) {
+		GF_LOG(GF_LOG_WARNING, GF_LOG_MUTEX, ("[Thread %s] Couldn't set CPU affinity, error %d\n", gf_th_log_name(t), res));
+		return GF_IO_ERR;
+	}
+	return GF_OK;
+#else
+	return GF_NOT_SUPPORTED;
+#endif
+}
+
+GF_EXPORT
+u32 gf_th_parse_cpu_list(const char *list, u32 *cpus, u32 max_cpus)
+{
+	u32 nb_cpus = 0;
+	u32 nb_cores = 0;
+	GF_SystemRTInfo rti;
+	memset(&rti, 0, sizeof(GF_SystemRTInfo));
+	if (gf_sys_get_rti(0, &rti, 0)) nb_cores = rti.nb_cores;
+	if (!nb_cores) nb_cores = MAX(max_cpus, 1);
+
+	while (list && list[0]) {
+		u32 first, last;
+		int nb = sscanf(list, "%u-%u", &first, &last);
+		if (nb<=0) break;
+		if (nb==1) last = first;
+		//ranges are clamped to existing cores, so that huge ranges neither loop forever nor inflate the count
+		if (last<first) {
+			GF_LOG(GF_LOG_WARNING, GF_LOG_MUTEX, ("[Thread] Invalid CPU range %u-%u, ignoring\n", first, last));
+		} else if (first<nb_cores) {
+			if (last>=nb_cores) last = nb_cores-1;
+			for (; first<=last; first++) {
+				if (cpus && (nb_cpus<max_cpus)) cpus[nb_cpus] = first;
+				nb_cpus++;
+			}
+		}
+		list = strchr(list, ',');
+		if (list) list++;
+	}
+	return nb_cpus;
+}
+
+GF_EXPORT
+u32 gf_th_get_numa_cpus(u32 node_idx, u32 *cpus, u32 max_cpus)
+{
+#if defined(__linux__) && !defined(GPAC_CONFIG_ANDROID) && !defined(GPAC_CONFIG_EMSCRIPTEN)
+	char szPath[GF_MAX_PATH], szList[1024];
+	FILE *f;
+	sprintf(szPath, "/sys/devices/system/node/node%u/cpulist", node_idx);
+	f = gf_fopen(szPath, "r");
+	if (!f) return 0;
+	szList[0] = 0;
+	if (!gf_fgets(szList, 1023, f)) szList[0] = 0;
+	gf_fclose(f);
+	return gf_th_parse_cpu_list(szList, cpus, max_cpus);
+#else
+	return 0;
+#endif
+}
+
 GF_EXPORT
 u32 gf_th_status(GF_Thread *t)
 {
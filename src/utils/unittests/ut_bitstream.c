@@ -0,0 +1,119 @@
+#include <gpac/bitstream.h>
+#include "tests.h"
+
+//bit-by-bit reference reader, with the same emulation prevention byte removal rules as the bitstream
+typedef struct
+{
+	const u8 *data;
+	u32 size, pos, cur, nb_bits, nb_zeros, nb_removed;
+	Bool emul;
+} RefBS;
+
+static u32 ref_read_bit(RefBS *r)
+{
+	if (!r->nb_bits) {
+		u8 res = r->data[r->pos++];
+		if (r->emul) {
+			if ((r->nb_zeros==2) && (res==0x03) && (r->pos<r->size) && (r->data[r->pos]<0x04)) {
+				r->nb_zeros = 0;
+				r->nb_removed++;
+				res = r->data[r->pos++];
+			}
+			if (!res) r->nb_zeros++;
+			else r->nb_zeros = 0;
+		}
+		r->cur = res;
+		r->nb_bits = 8;
+	}
+	r->nb_bits--;
+	return (r->cur >> r->nb_bits) & 1;
+}
+
+static u64 ref_read_int(RefBS *r, u32 nb_bits)
+{
+	u64 v = 0;
+	while (nb_bits--) v = (v<<1) | ref_read_bit(r);
+	return v;
+}
+
+static u32 ref_read_ue(RefBS *r)
+{
+	u32 nb_lead = 0;
+	while (!ref_read_bit(r)) {
+		nb_lead++;
+		//corrupted code, 0 is returned after reading 33 bits
+		if (nb_lead==32) {
+			ref_read_bit(r);
+			return 0;
+		}
+	}
+	return (u32) ((1ULL<<nb_lead) - 1 + ref_read_int(r, nb_lead));
+}
+
+static void check_bs_reads(Bool emul)
+{
+	u32 i, nb_zeros=0, nb_ok=0, nb_ops=0;
+	u8 data[4096];
+	RefBS r;
+	GF_BitStream *bs;
+
+	//lots of zeros and 0x03 to trigger emulation prevention
+	srand(12);
+	for (i=0; i<sizeof(data); i++) {
+		u32 t = rand() % 6;
+		if ((nb_zeros<2) && (t<2)) data[i] = 0;
+		else if (t==2) data[i] = 0x03;
+		else data[i] = 1 + rand() % 127;
+		nb_zeros = data[i] ? 0 : nb_zeros+1;
+	}
+	memset(&r, 0, sizeof(RefBS));
+	r.data = data;
+	r.size = sizeof(data);
+	r.emul = emul;
+	bs = gf_bs_new(data, sizeof(data), GF_BITSTREAM_READ);
+	gf_bs_enable_emulation_byte_removal(bs, emul);
+
+	//stay away from end of stream
+	while (r.pos + 32 < r.size) {
+		u32 op = rand() % 5;
+		u32 nb_bits = 1 + rand() % 32;
+		nb_ops++;
+		switch (op) {
+		case 0:
+			if (gf_bs_read_int(bs, nb_bits) == (u32) ref_read_int(&r, nb_bits)) nb_ok++;
+			break;
+		case 1:
+			nb_bits += 32;
+			if (gf_bs_read_long_int(bs, nb_bits) == ref_read_int(&r, nb_bits)) nb_ok++;
+			break;
+		case 2:
+			if (gf_bs_read_ue(bs) == ref_read_ue(&r)) nb_ok++;
+			break;
+		case 3:
+		{
+			u32 v = ref_read_ue(&r);
+			s32 sv = (v & 0x1) ? (s32) ((v + 1) >> 1) : -(s32) (v >> 1);
+			if (gf_bs_read_se(bs) == sv) nb_ok++;
+		}
+			break;
+		default:
+			if (gf_bs_read_int(bs, 1) == ref_read_bit(&r)) nb_ok++;
+			break;
+		}
+		if (gf_bs_get_position(bs) != r.pos) break;
+	}
+	assert_equal(nb_ok, nb_ops);
+	assert_equal(gf_bs_get_position(bs), r.pos);
+	assert_equal(gf_bs_get_bit_position(bs), 8 - r.nb_bits);
+	assert_equal(gf_bs_get_emulation_byte_removed(bs), r.nb_removed);
+	if (emul) assert_greater(r.nb_removed, 0);
+	gf_bs_del(bs);
+}
+
+unittest(bs_read_exact)
+{
+	//corrupted exp-golomb codes are expected
+	gf_log_set_tool_level(GF_LOG_CODING, GF_LOG_QUIET);
+	check_bs_reads(GF_FALSE);
+	check_bs_reads(GF_TRUE);
+}
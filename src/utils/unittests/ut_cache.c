@@ -0,0 +1,68 @@
+#include "tests.h"
+#include <gpac/download.h>
+
+#ifndef GPAC_DISABLE_NETWORK
+
+#define UTD_NB	1000
+#define UTD_SIZE	1000
+#define UTD_MEM	65536
+
+static DownloadedCacheEntry utd_push(GF_DownloadManager *dm, u32 idx, u64 start, u64 end, u8 *data)
+{
+	GF_Blob blob;
+	char szURL[100];
+	memset(&blob, 0, sizeof(GF_Blob));
+	blob.data = data;
+	blob.size = UTD_SIZE;
+	snprintf(szURL, 100, "http://gpac.io/ut/seg_%u.m4s", idx);
+	return gf_dm_add_cache_entry(dm, szURL, data ? &blob : NULL, start, end, "video/mp4", GF_TRUE, 0);
+}
+
+unittest(dm_cache_index)
+{
+	u32 i;
+	u8 data[UTD_SIZE];
+	DownloadedCacheEntry entries[UTD_NB], e1, e2;
+	GF_DownloadCacheStats stats;
+	GF_DownloadManager *dm;
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	gf_opts_set_key("temp", "cache-mem", "65536");
+	dm = gf_dm_new(NULL);
+	assert_not_null(dm);
+	memset(data, 0x55, UTD_SIZE);
+
+	for (i=0; i<UTD_NB; i++) {
+		entries[i] = utd_push(dm, i, 0, 0, data);
+		assert_not_null(entries[i]);
+	}
+	//same URL maps to the same entry, ranges are distinct entries
+	for (i=0; i<UTD_NB; i++)
+		assert_equal(utd_push(dm, i, 0, 0, data), entries[i]);
+	e1 = utd_push(dm, 0, 0, 499, data);
+	e2 = utd_push(dm, 0, 500, 999, data);
+	assert_true((e1 != e2) && (e1 != entries[0]));
+	assert_equal(utd_push(dm, 0, 500, 999, data), e2);
+
+	//pushed entries are never evicted until marked as deleted
+	assert_equal(gf_dm_get_cache_stats(dm, &stats), GF_OK);
+	assert_equal(stats.nb_entries, UTD_NB+2);
+	assert_equal(stats.evictions, 0);
+	assert_greater_equal(stats.mem_size, UTD_NB*UTD_SIZE);
+
+	for (i=0; i<UTD_NB-10; i++)
+		utd_push(dm, i, 0, 0, NULL);
+	utd_push(dm, UTD_NB, 0, 0, data);
+	assert_equal(gf_dm_get_cache_stats(dm, &stats), GF_OK);
+	assert_greater(stats.evictions, 0);
+	assert_less_equal(stats.mem_size, UTD_MEM);
+	assert_equal(stats.nb_entries + stats.evictions, UTD_NB+3);
+	for (i=UTD_NB-10; i<UTD_NB; i++)
+		assert_equal(utd_push(dm, i, 0, 0, data), entries[i]);
+
+	gf_dm_del(dm);
+	gf_opts_set_key("temp", "cache-mem", NULL);
+	gf_sys_close();
+}
+
+#endif //GPAC_DISABLE_NETWORK
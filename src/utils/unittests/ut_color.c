@@ -0,0 +1,130 @@
+#include "tests.h"
+#include "../color.c"
+
+#ifndef GPAC_DISABLE_COMPOSITOR
+
+//odd width to exercise scalar tail after SIMD kernels
+#define UTC_W	75
+#define UTC_H	36
+
+typedef struct
+{
+	u32 pfmt;
+	u32 bpp;
+	Bool is_10bit;
+} UTCFormat;
+
+static const UTCFormat utc_src_fmts[] =
+{
+	{GF_PIXEL_YUV, 1, GF_FALSE},
+	{GF_PIXEL_NV12, 1, GF_FALSE},
+	{GF_PIXEL_NV21, 1, GF_FALSE},
+	{GF_PIXEL_YUV422, 1, GF_FALSE},
+	{GF_PIXEL_YUV_10, 2, GF_TRUE},
+	{GF_PIXEL_YUV422_10, 2, GF_TRUE},
+	{GF_PIXEL_RGBA, 4, GF_FALSE},
+	{GF_PIXEL_RGBX, 4, GF_FALSE},
+};
+static const u32 utc_dst_fmts[] = {GF_PIXEL_RGBX, GF_PIXEL_BGRX, GF_PIXEL_RGBA, GF_PIXEL_BGRA, GF_PIXEL_ARGB, GF_PIXEL_RGBD, GF_PIXEL_RGB};
+
+static void utc_fill(u8 *data, u32 size, Bool is_10bit)
+{
+	u32 i;
+	if (is_10bit) {
+		for (i=0; i<size/2; i++) ((u16 *) data)[i] = gf_rand() % 1024;
+	} else {
+		for (i=0; i<size; i++) data[i] = gf_rand();
+	}
+}
+
+//source surface with even width, as used by gf_stretch_bits for YUV
+static void utc_source(GF_VideoSurface *src, u32 pfmt, u32 w, u32 h, Bool is_10bit)
+{
+	u32 size=0, stride=0;
+	memset(src, 0, sizeof(GF_VideoSurface));
+	gf_pixel_get_size_info(pfmt, w, h, &size, &stride, NULL, NULL, NULL);
+	src->width = w;
+	src->height = h;
+	src->pitch_y = stride;
+	src->pixel_format = pfmt;
+	src->video_buffer = gf_malloc(size);
+	utc_fill(src->video_buffer, size, is_10bit);
+	//mix of transparent, opaque and random alpha for RGBA
+	if (pfmt==GF_PIXEL_RGBA) {
+		u32 i;
+		for (i=0; i<w*h; i++) {
+			u32 r = gf_rand() % 4;
+			if (r==0) src->video_buffer[4*i+3] = 0;
+			else if (r==1) src->video_buffer[4*i+3] = 0xFF;
+		}
+	}
+}
+
+//convert with and without SIMD kernels, return GF_TRUE if results are identical
+static Bool utc_compare(GF_VideoSurface *src, u32 dst_fmt, u8 alpha, GF_Window *dst_wnd, u8 *init)
+{
+	u32 size=0, stride=0;
+	Bool same;
+	u8 *ref;
+	ColorKernels kernels = color_kernels;
+	GF_VideoSurface dst;
+	memset(&dst, 0, sizeof(GF_VideoSurface));
+	gf_pixel_get_size_info(dst_fmt, src->width, src->height, &size, &stride, NULL, NULL, NULL);
+	dst.width = src->width;
+	dst.height = src->height;
+	dst.pitch_y = stride;
+	dst.pixel_format = dst_fmt;
+	ref = gf_malloc(size);
+
+	memcpy(ref, init, size);
+	dst.video_buffer = ref;
+	memset(&color_kernels, 0, sizeof(ColorKernels));
+	gf_stretch_bits(&dst, src, dst_wnd, NULL, alpha, GF_FALSE, NULL, NULL);
+	color_kernels = kernels;
+
+	dst.video_buffer = gf_malloc(size);
+	memcpy(dst.video_buffer, init, size);
+	gf_stretch_bits(&dst, src, dst_wnd, NULL, alpha, GF_FALSE, NULL, NULL);
+
+	same = memcmp(ref, dst.video_buffer, size) ? GF_FALSE : GF_TRUE;
+	gf_free(ref);
+	gf_free(dst.video_buffer);
+	return same;
+}
+
+unittest(color_stretch_simd_exact)
+{
+	u32 i, j, k;
+	u8 *init;
+	GF_Window dst_wnd;
+	const u8 alphas[] = {0xFF, 0x80, 0x01};
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	color_kernels_setup();
+	//destination content, including transparent pixels for RGBA/BGRA
+	init = gf_malloc(4*(UTC_W+1)*UTC_H);
+	for (i=0; i<4*(UTC_W+1)*UTC_H; i++) init[i] = (i%7) ? gf_rand() : 0;
+
+	for (i=0; i<GF_ARRAY_LENGTH(utc_src_fmts); i++) {
+		GF_VideoSurface src;
+		const UTCFormat *sf = &utc_src_fmts[i];
+		utc_source(&src, sf->pfmt, (sf->bpp==4) ? UTC_W : UTC_W+1, UTC_H, sf->is_10bit);
+		for (j=0; j<GF_ARRAY_LENGTH(utc_dst_fmts); j++) {
+			for (k=0; k<GF_ARRAY_LENGTH(alphas); k++) {
+				//no stretch
+				assert_true(utc_compare(&src, utc_dst_fmts[j], alphas[k], NULL, init));
+				//stretch, scalar path only but must still be identical
+				dst_wnd.x = 1;
+				dst_wnd.y = 2;
+				dst_wnd.w = UTC_W/2;
+				dst_wnd.h = UTC_H-2;
+				assert_true(utc_compare(&src, utc_dst_fmts[j], alphas[k], &dst_wnd, init));
+			}
+		}
+		gf_free(src.video_buffer);
+	}
+	gf_free(init);
+	gf_sys_close();
+}
+
+#endif //GPAC_DISABLE_COMPOSITOR
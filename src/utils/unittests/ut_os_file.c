@@ -0,0 +1,285 @@
+#include "tests.h"
+#include <gpac/tools.h>
+
+#define UTF_SIZE	(1<<20)
+
+static FILE *utf_create(u8 *data, u32 size)
+{
+	FILE *f = gf_file_temp(NULL);
+	if (!f) return NULL;
+	gf_fwrite(data, size, f);
+	gf_fflush(f);
+	return f;
+}
+
+static Bool utf_check(FILE *f, u8 *ref, u32 size)
+{
+	Bool same;
+	u8 *data = gf_malloc(size);
+	gf_fseek(f, 0, SEEK_SET);
+	same = (gf_fread(data, size, f) == size) ? GF_TRUE : GF_FALSE;
+	if (same && memcmp(data, ref, size)) same = GF_FALSE;
+	gf_free(data);
+	return same;
+}
+
+unittest(os_file_copy_range)
+{
+	u32 i;
+	u8 *data, *ref;
+	//overlapping forward and backward moves, non-overlapping and tiny distances
+	const s32 moves[][3] = {
+		{1000, 5000, UTF_SIZE-5000},
+		{5000, 1000, UTF_SIZE-5000},
+		{0, UTF_SIZE/2, UTF_SIZE/2},
+		{3, 10, 200000},
+		{20, 0, UTF_SIZE-20},
+	};
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	data = gf_malloc(UTF_SIZE);
+	ref = gf_malloc(UTF_SIZE);
+	for (i=0; i<UTF_SIZE; i++) data[i] = gf_rand();
+
+	for (i=0; i<GF_ARRAY_LENGTH(moves); i++) {
+		GF_Err e;
+		FILE *f = utf_create(data, UTF_SIZE);
+		assert_not_null(f);
+		e = gf_file_copy_range(f, moves[i][0], moves[i][1], moves[i][2]);
+		//not supported on this platform, nothing must have changed
+		if (e==GF_NOT_SUPPORTED) {
+			assert_true(utf_check(f, data, UTF_SIZE));
+		} else {
+			assert_equal(e, GF_OK);
+			memcpy(ref, data, UTF_SIZE);
+			memmove(ref + moves[i][1], ref + moves[i][0], moves[i][2]);
+			assert_true(utf_check(f, ref, UTF_SIZE));
+		}
+		gf_fclose(f);
+	}
+	gf_free(data);
+	gf_free(ref);
+	gf_sys_close();
+}
+
+unittest(os_file_insert_range)
+{
+	u32 i, blk, size;
+	GF_Err e;
+	u8 *data, *ref;
+	FILE *f;
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	data = gf_malloc(UTF_SIZE);
+	for (i=0; i<UTF_SIZE; i++) data[i] = gf_rand();
+	f = utf_create(data, UTF_SIZE);
+	assert_not_null(f);
+
+	blk = gf_file_block_size(f);
+	if (!blk || (blk > UTF_SIZE/4)) {
+		assert_equal(gf_file_insert_range(f, 0, 4096), GF_NOT_SUPPORTED);
+	} else {
+		e = gf_file_insert_range(f, 2*blk, 3*blk);
+		if (e==GF_NOT_SUPPORTED) {
+			assert_true(utf_check(f, data, UTF_SIZE));
+		} else {
+			assert_equal(e, GF_OK);
+			size = UTF_SIZE + 3*blk;
+			assert_equal(gf_fsize(f), size);
+			ref = gf_malloc(size);
+			memcpy(ref, data, 2*blk);
+			memset(ref + 2*blk, 0, 3*blk);
+			memcpy(ref + 5*blk, data + 2*blk, UTF_SIZE - 2*blk);
+			assert_true(utf_check(f, ref, size));
+			gf_free(ref);
+		}
+	}
+	gf_fclose(f);
+	gf_free(data);
+	gf_sys_close();
+}
+
+#define UTF_MMAP_NAME	"ut_os_file_mmap.bin"
+
+unittest(os_file_mmap)
+{
+	u32 i;
+	u64 size;
+	u8 *data, *map;
+	FILE *f;
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	data = gf_malloc(UTF_SIZE);
+	for (i=0; i<UTF_SIZE; i++) data[i] = gf_rand();
+	f = gf_fopen(UTF_MMAP_NAME, "wb");
+	assert_not_null(f);
+	gf_fwrite(data, UTF_SIZE, f);
+	gf_fclose(f);
+
+	map = gf_file_mmap(UTF_MMAP_NAME, &size);
+	//mapping may not be supported on this platform
+	if (map) {
+		assert_equal(size, UTF_SIZE);
+		assert_equal_mem(map, data, UTF_SIZE);
+		gf_file_munmap(map, size);
+	} else {
+		assert_equal(size, 0);
+	}
+
+	//empty files, missing files and wrapped IOs are never mapped
+	f = gf_fopen(UTF_MMAP_NAME, "wb");
+	assert_not_null(f);
+	gf_fclose(f);
+	assert_true(gf_file_mmap(UTF_MMAP_NAME, &size) == NULL);
+	assert_equal(size, 0);
+	gf_file_delete(UTF_MMAP_NAME);
+	assert_true(gf_file_mmap(UTF_MMAP_NAME, &size) == NULL);
+	assert_true(gf_file_mmap("gmem://@0x0", &size) == NULL);
+	assert_true(gf_file_mmap(NULL, &size) == NULL);
+
+	gf_free(data);
+	gf_sys_close();
+}
+
+unittest(os_file_mem)
+{
+	u32 i, size;
+	u8 *data, buf[16];
+	char szLine[32];
+	FILE *f;
+
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	f = gf_file_mem_new();
+	assert_not_null(f);
+	assert_true(gf_file_mem_get_data(f, &size) == NULL);
+	assert_equal(size, 0);
+
+	//append past the initial allocation, formatting in place then growing
+	assert_equal(gf_fwrite("head", 4, f), 4);
+	for (i=0; i<1000; i++) {
+		assert_equal(gf_fprintf(f, "%04u\n", i), 5);
+	}
+	assert_equal(gf_ftell(f), 5004);
+	assert_true(gf_feof(f));
+	data = gf_file_mem_get_data(f, &size);
+	assert_not_null(data);
+	assert_equal(size, 5004);
+	assert_equal_mem(data, "head0000\n", 9);
+	for (i=0; i<1000; i++) {
+		sprintf(szLine, "%04u\n", i);
+		assert_equal_mem(data + 4 + 5*i, szLine, 5);
+	}
+
+	//overwrite in the middle, size unchanged
+	assert_equal(gf_fseek(f, 4, SEEK_SET), 0);
+	assert_equal(gf_fprintf(f, "%s", "ABCDE"), 5);
+	assert_equal(gf_fwrite("xy", 2, f), 2);
+	assert_equal(gf_ftell(f), 11);
+	assert_false(gf_feof(f));
+	assert_equal(gf_fseek(f, 0, SEEK_SET), 0);
+	assert_equal(gf_fread(buf, 16, f), 16);
+	assert_equal_mem(buf, "headABCDExy01\n00", 16);
+	data = gf_file_mem_get_data(f, &size);
+	assert_equal(size, 5004);
+
+	//overwrite crossing the end extends the file
+	assert_equal(gf_fseek(f, -2, SEEK_END), 0);
+	assert_equal(gf_fprintf(f, "%s", "tail"), 4);
+	data = gf_file_mem_get_data(f, &size);
+	assert_equal(size, 5006);
+	assert_equal_mem(data + 5000, "99tail", 6);
+	assert_true(gf_fseek(f, 1, SEEK_END) != 0);
+
+	//reset keeps the file usable
+	gf_file_mem_reset(f);
+	assert_true(gf_file_mem_get_data(f, &size) == NULL);
+	assert_equal(size, 0);
+	assert_equal(gf_fprintf(f, "%s", "new"), 3);
+	data = gf_file_mem_get_data(f, &size);
+	assert_equal(size, 3);
+	assert_equal_mem(data, "new", 3);
+	assert_equal(gf_fread(buf, 1, f), 0);
+
+	//only memory files expose their data
+	assert_true(gf_file_mem_get_data(NULL, &size) == NULL);
+	assert_equal(gf_fclose(f), 0);
+	gf_sys_close();
+}
+
+#if defined(GPAC_HAS_FD) && !defined(WIN32)
+#include <unistd.h>
+
+#define UTF_AIO_BLOCK	16384
+#define UTF_AIO_NB_BLOCKS	64
+
+//descriptor owned by the engine, closed asynchronously
+static s32 utf_aio_fd(FILE *f)
+{
+	return f ? dup(fileno(f)) : -1;
+}
+
+static void utf_aio_check(Bool force_thread)
+{
+	u32 i, nb_done=0;
+	s32 fd, res;
+	void *udta;
+	u8 *data, *read_back;
+	FILE *f = gf_file_temp(NULL);
+	GF_FileAIO *aio = gf_file_aio_new(UTF_AIO_NB_BLOCKS, force_thread);
+	assert_not_null(aio);
+	fd = utf_aio_fd(f);
+	assert_true(fd>=0);
+	if (!aio || (fd<0)) {
+		if (f) gf_fclose(f);
+		gf_file_aio_del(aio);
+		return;
+	}
+	data = gf_malloc(UTF_AIO_BLOCK * UTF_AIO_NB_BLOCKS);
+	read_back = gf_malloc(UTF_AIO_BLOCK * UTF_AIO_NB_BLOCKS);
+	for (i=0; i<UTF_AIO_BLOCK * UTF_AIO_NB_BLOCKS; i++) data[i] = gf_rand();
+
+	//blocks submitted in reverse order, queue full after that
+	for (i=UTF_AIO_NB_BLOCKS; i>0; i--) {
+		assert_equal(gf_file_aio_write(aio, fd, data + (i-1)*UTF_AIO_BLOCK, UTF_AIO_BLOCK, (i-1)*UTF_AIO_BLOCK, &data[i-1]), GF_OK);
+	}
+	assert_equal(gf_file_aio_pending(aio), UTF_AIO_NB_BLOCKS);
+	assert_equal(gf_file_aio_sync(aio, fd, NULL), GF_BUFFER_TOO_SMALL);
+	while (gf_file_aio_get_done(aio, GF_TRUE, &udta, &res)) {
+		if ((res==UTF_AIO_BLOCK) && udta) nb_done++;
+	}
+	assert_equal(nb_done, UTF_AIO_NB_BLOCKS);
+	assert_equal(gf_file_aio_pending(aio), 0);
+
+	//sync, then read back with a last read past the end of file
+	assert_equal(gf_file_aio_sync(aio, fd, NULL), GF_OK);
+	for (i=0; i<4; i++) {
+		u32 size = UTF_AIO_BLOCK * UTF_AIO_NB_BLOCKS / 4;
+		assert_equal(gf_file_aio_read(aio, fd, read_back + i*size, (i==3) ? 2*size : size, i*size, NULL), GF_OK);
+	}
+	nb_done = 0;
+	while (gf_file_aio_get_done(aio, GF_TRUE, &udta, &res)) {
+		if (res == UTF_AIO_BLOCK * UTF_AIO_NB_BLOCKS / 4) nb_done++;
+	}
+	assert_equal(nb_done, 4);
+	assert_equal_mem(read_back, data, UTF_AIO_BLOCK * UTF_AIO_NB_BLOCKS);
+
+	assert_equal(gf_file_aio_close(aio, fd, NULL), GF_OK);
+	assert_true(gf_file_aio_get_done(aio, GF_TRUE, &udta, &res));
+	assert_equal(res, 0);
+	assert_true(!gf_file_aio_get_done(aio, GF_FALSE, &udta, &res));
+
+	gf_file_aio_del(aio);
+	gf_fclose(f);
+	gf_free(data);
+	gf_free(read_back);
+}
+
+unittest(os_file_aio)
+{
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	utf_aio_check(GF_FALSE);
+	utf_aio_check(GF_TRUE);
+	gf_sys_close();
+}
+
+#endif //GPAC_HAS_FD && !WIN32
@@ -0,0 +1,248 @@
+#include "tests.h"
+#include <gpac/network.h>
+
+#include <stdio.h>
+
+#ifndef GPAC_DISABLE_NETWORK
+
+#define UTN_PORT	16384
+#define UTN_DGRAM_SIZE	1316
+//datagrams sent per benchmark run
+#define UTN_NB_BENCH	(1<<17)
+
+static GF_Socket *utn_sender(u16 port)
+{
+	GF_Socket *sk = gf_sk_new(GF_SOCK_TYPE_UDP);
+	if (!sk) return NULL;
+	if (gf_sk_bind(sk, NULL, port, "127.0.0.1", port, GF_SOCK_REUSE_PORT | GF_SOCK_FAKE_BIND) != GF_OK) {
+		gf_sk_del(sk);
+		return NULL;
+	}
+	return sk;
+}
+
+static GF_Socket *utn_receiver(u16 port)
+{
+	GF_Socket *sk = gf_sk_new(GF_SOCK_TYPE_UDP);
+	if (!sk) return NULL;
+	if (gf_sk_bind(sk, NULL, port, NULL, 0, GF_SOCK_REUSE_PORT) != GF_OK) {
+		gf_sk_del(sk);
+		return NULL;
+	}
+	gf_sk_set_buffer_size(sk, GF_FALSE, 4*1024*1024);
+	return sk;
+}
+
+unittest(sk_send_batch)
+{
+	u32 i, nb_sent, nb_ok=0;
+	u8 *data, rbuf[2000];
+	const u8 *ptrs[40];
+	u32 sizes[40];
+	u16 port = UTN_PORT + gf_rand() % 1000;
+	GF_Socket *rx = utn_receiver(port);
+	GF_Socket *tx = utn_sender(port);
+	assert_not_null(rx);
+	assert_not_null(tx);
+	if (!rx || !tx) return;
+
+	data = gf_malloc(40*UTN_DGRAM_SIZE);
+	for (i=0; i<40*UTN_DGRAM_SIZE; i++) data[i] = (u8) (i*7 + i/UTN_DGRAM_SIZE);
+	//30 contiguous datagrams of the same size (GSO candidates) ending with a short one
+	for (i=0; i<30; i++) {
+		ptrs[i] = data + i*UTN_DGRAM_SIZE;
+		sizes[i] = (i==29) ? 100 : UTN_DGRAM_SIZE;
+	}
+	//10 scattered datagrams of various sizes
+	for (i=30; i<40; i++) {
+		ptrs[i] = data + (69-i)*UTN_DGRAM_SIZE;
+		sizes[i] = 1 + i*31;
+	}
+	assert_equal(gf_sk_send_batch(tx, ptrs, sizes, 40, &nb_sent), GF_OK);
+	assert_equal(nb_sent, 40);
+
+	//loopback keeps datagram boundaries and order
+	for (i=0; i<40; i++) {
+		u32 read=0, retry=0;
+		while (retry<1000) {
+			GF_Err e = gf_sk_receive(rx, rbuf, 2000, &read);
+			if (e != GF_IP_NETWORK_EMPTY) break;
+			retry++;
+		}
+		if ((read==sizes[i]) && !memcmp(rbuf, ptrs[i], read))
+			nb_ok++;
+	}
+	assert_equal(nb_ok, 40);
+
+	gf_free(data);
+	gf_sk_del(tx);
+	gf_sk_del(rx);
+}
+
+unittest(sk_receive_batch)
+{
+	u32 i, nb_sent, nb_read=0, nb_ok=0, retry=0;
+	u8 *data, *rbuf;
+	const u8 *ptrs[40];
+	u32 sizes[40], rsizes[40];
+	u64 ntps[40], ntp_now;
+	u16 port = UTN_PORT + 2000 + gf_rand() % 1000;
+	GF_Socket *rx = utn_receiver(port);
+	GF_Socket *tx = utn_sender(port);
+	assert_not_null(rx);
+	assert_not_null(tx);
+	if (!rx || !tx) return;
+
+	data = gf_malloc(40*UTN_DGRAM_SIZE);
+	rbuf = gf_malloc(40*GF_SK_BATCH_SLOT_SIZE);
+	for (i=0; i<40*UTN_DGRAM_SIZE; i++) data[i] = (u8) (i*3 + i/UTN_DGRAM_SIZE);
+	for (i=0; i<40; i++) {
+		ptrs[i] = data + i*UTN_DGRAM_SIZE;
+		sizes[i] = 1 + (i*37) % UTN_DGRAM_SIZE;
+	}
+	ntp_now = gf_net_get_ntp_ts();
+	assert_equal(gf_sk_send_batch(tx, ptrs, sizes, 40, &nb_sent), GF_OK);
+
+	//may take several calls, one call returns at most 64 datagrams
+	while ((nb_read<40) && (retry<1000)) {
+		u32 nb=0;
+		GF_Err e = gf_sk_receive_batch(rx, rbuf + nb_read*GF_SK_BATCH_SLOT_SIZE, GF_SK_BATCH_SLOT_SIZE, 40-nb_read, rsizes+nb_read, ntps+nb_read, &nb);
+		if (e==GF_IP_NETWORK_EMPTY) {
+			retry++;
+			gf_sleep(1);
+			continue;
+		}
+		if (e) break;
+		nb_read += nb;
+	}
+	assert_equal(nb_read, 40);
+	for (i=0; i<nb_read; i++) {
+		//reception time within a few seconds of emission
+		s32 diff = gf_net_ntp_diff_ms(ntps[i], ntp_now);
+		if ((rsizes[i]==sizes[i]) && !memcmp(rbuf + i*GF_SK_BATCH_SLOT_SIZE, ptrs[i], sizes[i]) && (diff>=-1) && (diff<5000))
+			nb_ok++;
+	}
+	assert_equal(nb_ok, 40);
+
+	gf_free(data);
+	gf_free(rbuf);
+	gf_sk_del(tx);
+	gf_sk_del(rx);
+}
+
+unittest(sk_group_enum_ready)
+{
+	u32 i, idx, retry=0;
+	GF_Socket *sk, *found=NULL;
+	u16 port = UTN_PORT + 4000 + gf_rand() % 1000;
+	GF_Socket *rx[4], *tx;
+	GF_SockGroup *sg = gf_sk_group_new();
+	assert_not_null(sg);
+	for (i=0; i<4; i++) {
+		rx[i] = utn_receiver(port+i);
+		assert_not_null(rx[i]);
+		if (!rx[i]) return;
+		gf_sk_set_udta(rx[i], &rx[i]);
+		gf_sk_group_register(sg, rx[i]);
+		//no output on these sockets
+		gf_sk_group_set_write_pending(sg, rx[i], GF_FALSE);
+	}
+	tx = utn_sender(port+2);
+	assert_not_null(tx);
+	if (!tx) return;
+	assert_equal(gf_sk_send(tx, (u8 *) "ready", 5), GF_OK);
+
+	//only the socket with pending data is enumerated
+	while (retry<1000) {
+		GF_Err e = gf_sk_group_select(sg, 1000, GF_SK_SELECT_READ);
+		if (e==GF_OK) break;
+		retry++;
+	}
+	idx = 0;
+	while ((sk = gf_sk_group_enum_ready(sg, &idx, GF_SK_SELECT_READ))) {
+		assert_true(!found);
+		found = sk;
+	}
+	assert_true(found == rx[2]);
+	assert_true(gf_sk_get_udta(found) == &rx[2]);
+	assert_true(gf_sk_group_sock_is_set(sg, rx[2], GF_SK_SELECT_READ));
+	assert_false(gf_sk_group_sock_is_set(sg, rx[1], GF_SK_SELECT_READ));
+
+	//unregistered sockets are no longer enumerated
+	gf_sk_group_unregister(sg, rx[2]);
+	gf_sk_group_select(sg, 1000, GF_SK_SELECT_READ);
+	idx = 0;
+	assert_true(gf_sk_group_enum_ready(sg, &idx, GF_SK_SELECT_READ) == NULL);
+
+	gf_sk_del(tx);
+	for (i=0; i<4; i++) {
+		gf_sk_group_unregister(sg, rx[i]);
+		gf_sk_del(rx[i]);
+	}
+	gf_sk_group_del(sg);
+}
+
+//send UTN_NB_BENCH datagrams, return number of datagrams per second
+static u64 utn_bench(u32 mode, u32 batch)
+{
+	u32 i, j;
+	u64 start, dur;
+	u8 *data;
+	const u8 **ptrs;
+	u32 *sizes;
+	u16 port = UTN_PORT + 1000 + gf_rand() % 1000;
+	//receiver is never read, datagrams are dropped once its buffer is full
+	GF_Socket *rx = utn_receiver(port);
+	GF_Socket *tx = utn_sender(port);
+	if (!rx || !tx) {
+		if (rx) gf_sk_del(rx);
+		if (tx) gf_sk_del(tx);
+		return 0;
+	}
+	data = gf_malloc(batch*UTN_DGRAM_SIZE*2);
+	memset(data, 0x47, batch*UTN_DGRAM_SIZE*2);
+	ptrs = gf_malloc(sizeof(u8*)*batch);
+	sizes = gf_malloc(sizeof(u32)*batch);
+	for (i=0; i<batch; i++) {
+		//mode 1: one datagram every two slots, no GSO - mode 2: contiguous datagrams
+		ptrs[i] = data + i*UTN_DGRAM_SIZE*((mode==1) ? 2 : 1);
+		sizes[i] = UTN_DGRAM_SIZE;
+	}
+
+	start = gf_sys_clock_high_res();
+	for (i=0; i<UTN_NB_BENCH; i+=batch) {
+		if (!mode) {
+			for (j=0; j<batch; j++)
+				gf_sk_send(tx, ptrs[j], sizes[j]);
+		} else {
+			gf_sk_send_batch(tx, ptrs, sizes, batch, NULL);
+		}
+	}
+	dur = gf_sys_clock_high_res() - start;
+
+	gf_free(data);
+	gf_free((void *) ptrs);
+	gf_free(sizes);
+	gf_sk_del(tx);
+	gf_sk_del(rx);
+	if (!dur) dur = 1;
+	return (u64) UTN_NB_BENCH * 1000000 / dur;
+}
+
+//loopback send rate of gf_sk_send versus gf_sk_send_batch, without GSO (non-contiguous datagrams) and with GSO
+unittest(sk_send_batch_bench)
+{
+	u32 batch;
+	printf("\nbatch\tgf_sk_send (pps)\tbatch (pps)\tbatch+GSO (pps)\n");
+	for (batch=8; batch<=64; batch*=2) {
+		u64 pps_send = utn_bench(0, batch);
+		u64 pps_mmsg = utn_bench(1, batch);
+		u64 pps_gso = utn_bench(2, batch);
+		assert_true(pps_send);
+		assert_true(pps_mmsg);
+		assert_true(pps_gso);
+		printf("%u\t"LLU"\t\t"LLU"\t\t"LLU"\n", batch, pps_send, pps_mmsg, pps_gso);
+	}
+}
+
+#endif //GPAC_DISABLE_NETWORK
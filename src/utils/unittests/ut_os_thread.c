@@ -0,0 +1,27 @@
+#include "tests.h"
+#include <gpac/thread.h>
+
+#ifndef GPAC_DISABLE_THREADS
+
+unittest(th_parse_cpu_list)
+{
+	u32 cpus[4];
+	GF_SystemRTInfo rti;
+	gf_sys_init(GF_MemTrackerNone, NULL);
+	memset(&rti, 0, sizeof(GF_SystemRTInfo));
+	assert_true(gf_sys_get_rti(0, &rti, 0));
+
+	assert_equal(gf_th_parse_cpu_list("0", cpus, 4), 1);
+	assert_equal(cpus[0], 0);
+	//count is returned even when the list is larger than the array
+	assert_equal(gf_th_parse_cpu_list("0-1000", NULL, 0), rti.nb_cores);
+	assert_equal(gf_th_parse_cpu_list("0-4294967295", NULL, 0), rti.nb_cores);
+	assert_equal(gf_th_parse_cpu_list("4000000000-4294967295", NULL, 0), 0);
+	//reversed ranges are ignored, next entries still parsed
+	assert_equal(gf_th_parse_cpu_list("3-1,0", cpus, 4), 1);
+	assert_equal(cpus[0], 0);
+	assert_equal(gf_th_parse_cpu_list("", cpus, 4), 0);
+	gf_sys_close();
+}
+
+#endif